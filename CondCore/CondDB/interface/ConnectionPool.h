@@ -24,6 +24,8 @@ namespace cond {
 namespace cond {
 
   namespace persistency {
+    class PayloadCache;
+
     // 
     enum DbAuthenticationSystem { UndefinedAuthentication=0,CondDbKey, CoralXMLFile };
 
@@ -39,6 +41,11 @@ namespace cond {
       void setFrontierSecurity( const std::string& signature );
       void setLogging( bool flag );   
       bool isLoggingEnabled() const;
+      // directory of the node-local payload cache; empty to disable it
+      void setPayloadCacheDirectory( const std::string& directory );
+      const std::string& payloadCacheDirectory() const { return m_payloadCacheDirectory; }
+      // null if the payload cache is disabled
+      std::shared_ptr<PayloadCache> payloadCache() const { return m_payloadCache; }
       void setParameters( const edm::ParameterSet& connectionPset );
       void configure();
       Session createSession( const std::string& connectionString, bool writeCapable = false );
@@ -64,6 +71,8 @@ namespace cond {
       // this one has to be moved!
       cond::CoralServiceManager* m_pluginManager = nullptr; 
       std::map<std::string,int> m_dbTypes;
+      std::string m_payloadCacheDirectory = std::string( "" );
+      std::shared_ptr<PayloadCache> m_payloadCache;
     };
   }
 }
@@ -32,6 +32,11 @@ namespace cond {
 	super::invalidateCache();
       }
 
+      // the keyed payloads are loaded with the payload, through the IOVs of the keys
+      bool prefetch( Session& ) override {
+	return false;
+      }
+
       void loadMore(CondGetter const & getter) override{
       	m_keyList.init(getter.get(m_name));
       }
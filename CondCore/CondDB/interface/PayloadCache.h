@@ -0,0 +1,73 @@
+#ifndef CondCore_CondDB_PayloadCache_h
+#define CondCore_CondDB_PayloadCache_h
+
+#include "CondCore/CondDB/interface/Binary.h"
+#include "CondCore/CondDB/interface/Types.h"
+//
+#include <atomic>
+#include <string>
+
+namespace cond {
+
+  namespace persistency {
+
+    // environment variable providing the cache directory when none is configured
+    static constexpr const char* const COND_PAYLOAD_CACHE = "COND_PAYLOAD_CACHE";
+
+    // hash of a payload as stored in the PAYLOAD table, the key of the cache
+    cond::Hash makeHash( const std::string& objectType, const cond::Binary& data );
+
+    /** \class PayloadCache
+     *
+     * Node-local store of the payload blobs, keyed by payload hash, shared by the processes
+     * of the same user configured with the same directory: a payload fetched by one job is
+     * written to a file of the directory and read back by the next jobs, which skip the
+     * database query. Each job copies the payloads it reads into its own memory; with the
+     * directory on a tmpfs (e.g. /dev/shm) the reads do not touch the disk.
+     *
+     * The directory and the files are private to the user. The files are written under a
+     * temporary name and renamed when complete, so that concurrent jobs never read a partial
+     * payload; a file with inconsistent sizes, or whose content does not match its hash, is
+     * removed and the payload is fetched from the database. A payload is not stored if that
+     * would leave less than 10% of the filesystem free. There is no eviction: the directory is
+     * meant to be cleaned by the node (or to vanish at reboot, for tmpfs).
+     */
+    class PayloadCache {
+    public:
+      struct Stats {
+	unsigned long long hits;
+	unsigned long long misses;
+	unsigned long long stores;
+	unsigned long long bytesRead;
+	unsigned long long bytesStored;
+      };
+
+    public:
+      explicit PayloadCache( const std::string& directory );
+
+      const std::string& directory() const { return m_directory; }
+
+      // fills the payload data if the hash is in the cache and the data match it; counts a hit or a miss
+      bool get( const cond::Hash& payloadHash, std::string& payloadType, cond::Binary& payloadData, cond::Binary& streamerInfoData );
+
+      // stores the payload data, unless already there; returns false if it could not be written
+      bool put( const cond::Hash& payloadHash, const std::string& payloadType, const cond::Binary& payloadData, const cond::Binary& streamerInfoData );
+
+      Stats stats() const;
+
+    private:
+      std::string fileName( const cond::Hash& payloadHash ) const;
+
+    private:
+      std::string m_directory;
+      std::atomic<unsigned long long> m_hits;
+      std::atomic<unsigned long long> m_misses;
+      std::atomic<unsigned long long> m_stores;
+      std::atomic<unsigned long long> m_bytesRead;
+      std::atomic<unsigned long long> m_bytesStored;
+    };
+
+  }
+}
+
+#endif
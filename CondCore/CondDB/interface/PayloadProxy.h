@@ -38,6 +38,12 @@ namespace cond {
       virtual void make()=0;
       
       virtual void invalidateCache()=0;
+
+      // loads the payload of the current IOV, if not loaded yet, reading it with the
+      // given session (transaction already started) instead of the one of the proxy:
+      // used to fetch and deserialize the payloads of several proxies concurrently.
+      // Returns true if the payload has been loaded.
+      virtual bool prefetch( Session& session )=0;
       
       // current cached object token
       const Hash& payloadId() const { return m_currentIov.payloadId;}
@@ -112,6 +118,14 @@ namespace cond {
 	m_requests.clear();
       }
 
+      bool prefetch( Session& session ) override {
+	if( !isValid() || m_currentIov.payloadId == m_currentPayloadId ) return false;
+	m_data = session.fetchPayload<DataT>( m_currentIov.payloadId );
+	m_currentPayloadId = m_currentIov.payloadId;
+	m_requests.push_back( m_currentIov );
+	return true;
+      }
+
     protected:
       void loadPayload() override {
 	if( m_currentIov.payloadId.empty() ){
@@ -6,6 +6,7 @@ CondDB = cms.PSet(
         authenticationSystem = cms.untracked.int32(0),
         security = cms.untracked.string(''),
         messageLevel = cms.untracked.int32(0),
+        payloadCacheDirectory = cms.untracked.string(''),
     ),
     connect = cms.string(''), 
 )
@@ -5,6 +5,7 @@
 //
 #include "CondCore/CondDB/interface/CoralServiceManager.h"
 #include "CondCore/CondDB/interface/Auth.h"
+#include "CondCore/CondDB/interface/PayloadCache.h"
 // CMSSW includes
 #include "FWCore/ParameterSet/interface/ParameterSet.h"
 // coral includes
@@ -47,6 +48,10 @@ namespace cond {
       m_loggingEnabled = flag;
     }
     
+    void ConnectionPool::setPayloadCacheDirectory( const std::string& directory ){
+      m_payloadCacheDirectory = directory;
+    }
+    
     void ConnectionPool::setParameters( const edm::ParameterSet& connectionPset ){
       //set the connection parameters from a ParameterSet
       //if a parameter is not defined, keep the values already set in the data members
@@ -74,6 +79,7 @@ namespace cond {
       }
       setMessageVerbosity( level );
       setLogging( connectionPset.getUntrackedParameter<bool>( "logging", m_loggingEnabled ) );
+      setPayloadCacheDirectory( connectionPset.getUntrackedParameter<std::string>( "payloadCacheDirectory", m_payloadCacheDirectory ) );
     }
 
     bool ConnectionPool::isLoggingEnabled() const {
@@ -127,6 +133,18 @@ namespace cond {
       }
       
       coralConfig.setAuthenticationService( authServiceName );
+
+      // payload cache
+      std::string cacheDirectory = m_payloadCacheDirectory;
+      if( cacheDirectory.empty() ){
+	const char* cacheEnv = ::getenv( COND_PAYLOAD_CACHE );
+	if( cacheEnv ) cacheDirectory = cacheEnv;
+      }
+      if( cacheDirectory.empty() ){
+	m_payloadCache.reset();
+      } else if( !m_payloadCache || m_payloadCache->directory() != cacheDirectory ){
+	m_payloadCache = std::make_shared<PayloadCache>( cacheDirectory );
+      }
     }
     
     void ConnectionPool::configure() {
@@ -156,7 +174,10 @@ namespace cond {
                                            const std::string& transactionId, 
                                            bool writeCapable ){
       std::shared_ptr<coral::ISessionProxy> coralSession = createCoralSession( connectionString, transactionId, writeCapable );
-      return Session( std::make_shared<SessionImpl>( coralSession, connectionString ));
+      auto sessionImpl = std::make_shared<SessionImpl>( coralSession, connectionString );
+      // the cache is only used by the read-only sessions
+      if( !writeCapable ) sessionImpl->payloadCache = m_payloadCache;
+      return Session( sessionImpl );
     }
 
     Session ConnectionPool::createSession( const std::string& connectionString, bool writeCapable ){
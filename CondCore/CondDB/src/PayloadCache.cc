@@ -0,0 +1,169 @@
+#include "CondCore/CondDB/interface/PayloadCache.h"
+#include "CondCore/CondDB/interface/Exception.h"
+//
+#include <cctype>
+#include <cerrno>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <sstream>
+#include <thread>
+#include <vector>
+//
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/statvfs.h>
+#include <unistd.h>
+
+namespace cond {
+
+  namespace persistency {
+
+    namespace {
+
+      // file layout: header, then payload type, payload data and streamer info
+      constexpr char MAGIC[8] = { 'C','O','N','D','P','L','C','1' };
+      struct Header {
+	char magic[8];
+	uint64_t typeSize;
+	uint64_t dataSize;
+	uint64_t streamerInfoSize;
+      };
+
+      bool writeAll( int fd, const void* buffer, size_t size ){
+	const char* p = static_cast<const char*>( buffer );
+	while( size > 0 ){
+	  ssize_t n = ::write( fd, p, size );
+	  if( n < 0 ) return false;
+	  p += n;
+	  size -= n;
+	}
+	return true;
+      }
+
+      // the hash is used as file name
+      bool validHash( const cond::Hash& payloadHash ){
+	if( payloadHash.empty() ) return false;
+	for( char c : payloadHash ) if( !::isalnum( (unsigned char)c ) ) return false;
+	return true;
+      }
+
+      bool enoughSpace( const std::string& directory, size_t size ){
+	struct statvfs fs;
+	if( ::statvfs( directory.c_str(), &fs ) != 0 ) return false;
+	unsigned long long available = (unsigned long long)fs.f_bavail*fs.f_frsize;
+	unsigned long long total = (unsigned long long)fs.f_blocks*fs.f_frsize;
+	return available > size + total/10;
+      }
+    }
+
+    PayloadCache::PayloadCache( const std::string& directory ):
+      m_directory( directory ),
+      m_hits( 0 ),
+      m_misses( 0 ),
+      m_stores( 0 ),
+      m_bytesRead( 0 ),
+      m_bytesStored( 0 ){
+      if( ::mkdir( m_directory.c_str(), 0700 ) != 0 && errno != EEXIST )
+	throwException( "Can't create the payload cache directory \""+m_directory+"\": "+std::strerror( errno ),
+			"PayloadCache::PayloadCache" );
+    }
+
+    std::string PayloadCache::fileName( const cond::Hash& payloadHash ) const {
+      return m_directory+"/"+payloadHash+".payload";
+    }
+
+    bool PayloadCache::get( const cond::Hash& payloadHash, std::string& payloadType, cond::Binary& payloadData, cond::Binary& streamerInfoData ){
+      bool found = false;
+      bool corrupted = false;
+      int fd = validHash( payloadHash ) ? ::open( fileName( payloadHash ).c_str(), O_RDONLY ) : -1;
+      if( fd >= 0 ){
+	struct stat st;
+	if( ::fstat( fd, &st ) == 0 ){
+	  size_t fileSize = st.st_size;
+	  void* map = fileSize >= sizeof(Header) ? ::mmap( nullptr, fileSize, PROT_READ, MAP_SHARED, fd, 0 ) : MAP_FAILED;
+	  if( map != MAP_FAILED ){
+	    const char* p = static_cast<const char*>( map );
+	    Header header;
+	    ::memcpy( &header, p, sizeof(Header) );
+	    p += sizeof(Header);
+	    // each size is checked against the bytes left, so that a corrupted header can't overflow
+	    uint64_t remaining = fileSize-sizeof(Header);
+	    bool valid = ::memcmp( header.magic, MAGIC, sizeof(MAGIC) ) == 0 && header.typeSize <= remaining;
+	    if( valid ){
+	      remaining -= header.typeSize;
+	      valid = header.dataSize <= remaining;
+	    }
+	    if( valid ){
+	      remaining -= header.dataSize;
+	      valid = header.streamerInfoSize == remaining;
+	    }
+	    if( valid ){
+	      payloadType.assign( p, header.typeSize );
+	      p += header.typeSize;
+	      payloadData = cond::Binary( p, header.dataSize );
+	      p += header.dataSize;
+	      streamerInfoData = cond::Binary( p, header.streamerInfoSize );
+	      // the content must match the hash it is stored under
+	      valid = makeHash( payloadType, payloadData ) == payloadHash;
+	    }
+	    if( valid ){
+	      m_bytesRead += fileSize;
+	      found = true;
+	    } else {
+	      corrupted = true;
+	    }
+	    ::munmap( map, fileSize );
+	  } else if( fileSize < sizeof(Header) ){
+	    corrupted = true;
+	  }
+	}
+	::close( fd );
+      }
+      // a corrupted file is not trusted: it is removed, and the payload is fetched from the database and stored again
+      if( corrupted ) ::unlink( fileName( payloadHash ).c_str() );
+      if( found ) ++m_hits; else ++m_misses;
+      return found;
+    }
+
+    bool PayloadCache::put( const cond::Hash& payloadHash, const std::string& payloadType, const cond::Binary& payloadData, const cond::Binary& streamerInfoData ){
+      if( !validHash( payloadHash ) ) return false;
+      std::string target = fileName( payloadHash );
+      if( ::access( target.c_str(), F_OK ) == 0 ) return true;
+      Header header;
+      ::memcpy( header.magic, MAGIC, sizeof(MAGIC) );
+      header.typeSize = payloadType.size();
+      header.dataSize = payloadData.size();
+      header.streamerInfoSize = streamerInfoData.size();
+      size_t fileSize = sizeof(Header)+header.typeSize+header.dataSize+header.streamerInfoSize;
+      if( !enoughSpace( m_directory, fileSize ) ) return false;
+
+      // unique among the processes and the threads of the node
+      std::stringstream tmpName;
+      tmpName << target << ".tmp." << ::getpid() << "." << std::this_thread::get_id();
+      std::string tmp = tmpName.str();
+      int fd = ::open( tmp.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0600 );
+      if( fd < 0 ) return false;
+      bool ok = writeAll( fd, &header, sizeof(Header) ) &&
+	writeAll( fd, payloadType.data(), header.typeSize ) &&
+	writeAll( fd, payloadData.data(), header.dataSize ) &&
+	writeAll( fd, streamerInfoData.data(), header.streamerInfoSize );
+      ok = ( ::close( fd ) == 0 ) && ok;
+      // the rename is atomic: the other processes see either no file or the complete one
+      if( ok ) ok = ( ::rename( tmp.c_str(), target.c_str() ) == 0 );
+      if( !ok ) {
+	::unlink( tmp.c_str() );
+	return false;
+      }
+      ++m_stores;
+      m_bytesStored += fileSize;
+      return true;
+    }
+
+    PayloadCache::Stats PayloadCache::stats() const {
+      return Stats{ m_hits.load(), m_misses.load(), m_stores.load(), m_bytesRead.load(), m_bytesStored.load() };
+    }
+
+  }
+}
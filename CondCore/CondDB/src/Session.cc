@@ -1,4 +1,5 @@
 #include "CondCore/CondDB/interface/Session.h"
+#include "CondCore/CondDB/interface/PayloadCache.h"
 #include "SessionImpl.h"
 //
 
@@ -203,8 +204,11 @@ namespace cond {
 				    std::string& payloadType, 
 				    cond::Binary& payloadData,
 				    cond::Binary& streamerInfoData ){
+      if( m_session->payloadCache && m_session->payloadCache->get( payloadHash, payloadType, payloadData, streamerInfoData ) ) return true;
       m_session->openIovDb();
-      return m_session->iovSchema().payloadTable().select( payloadHash, payloadType, payloadData, streamerInfoData );
+      bool found = m_session->iovSchema().payloadTable().select( payloadHash, payloadType, payloadData, streamerInfoData );
+      if( found && m_session->payloadCache ) m_session->payloadCache->put( payloadHash, payloadType, payloadData, streamerInfoData );
+      return found;
     }
 
     RunInfoProxy Session::getRunInfo( cond::Time_t start, cond::Time_t end ){
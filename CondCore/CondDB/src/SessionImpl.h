@@ -21,6 +21,8 @@ namespace cond {
 
   namespace persistency {
 
+    class PayloadCache;
+
     class ITransaction {
     public:
       virtual ~ITransaction(){}
@@ -70,6 +72,8 @@ namespace cond {
       std::unique_ptr<IIOVSchema> iovSchemaHandle; 
       std::unique_ptr<IGTSchema> gtSchemaHandle; 
       std::unique_ptr<IRunInfoSchema> runInfoSchemaHandle; 
+      // node-local store of the payloads, shared by the sessions of the connection pool
+      std::shared_ptr<PayloadCache> payloadCache;
     };
 
   }
@@ -0,0 +1,120 @@
+#include "CondCore/CondDB/interface/PayloadCache.h"
+//
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <sys/stat.h>
+#include <unistd.h>
+
+using namespace cond::persistency;
+
+namespace {
+  bool sameData( const cond::Binary& a, const cond::Binary& b ){
+    return a.size() == b.size() && ::memcmp( a.data(), b.data(), a.size() ) == 0;
+  }
+}
+
+int run( const std::string& directory ){
+  int ret = 0;
+  std::string type( "MyTestData" );
+  std::string data( "some payload data\0with a null inside", 36 );
+  std::string streamerInfo( "streamer info" );
+  cond::Binary payloadData;
+  payloadData.copy( data );
+  cond::Binary streamerInfoData;
+  streamerInfoData.copy( streamerInfo );
+  cond::Hash hash = makeHash( type, payloadData );
+
+  PayloadCache cache( directory );
+  struct stat st;
+  if( ::stat( directory.c_str(), &st ) != 0 || ( st.st_mode & 0777 ) != 0700 ){
+    std::cout <<"ERROR: cache directory not private to the user"<<std::endl;
+    ret = 1;
+  }
+  std::string readType;
+  cond::Binary readData;
+  cond::Binary readStreamerInfo;
+  if( cache.get( hash, readType, readData, readStreamerInfo ) ){
+    std::cout <<"ERROR: payload found in an empty cache"<<std::endl;
+    ret = 1;
+  }
+  if( !cache.put( hash, type, payloadData, streamerInfoData ) ){
+    std::cout <<"ERROR: payload not stored"<<std::endl;
+    ret = 1;
+  }
+  // another process reading the same directory
+  PayloadCache otherCache( directory );
+  if( !otherCache.get( hash, readType, readData, readStreamerInfo ) ){
+    std::cout <<"ERROR: stored payload not found"<<std::endl;
+    ret = 1;
+  } else if( readType != type || !sameData( readData, payloadData ) || !sameData( readStreamerInfo, streamerInfoData ) ){
+    std::cout <<"ERROR: payload read from the cache differs from the stored one"<<std::endl;
+    ret = 1;
+  }
+  if( ::stat( (directory+"/"+hash+".payload").c_str(), &st ) != 0 || ( st.st_mode & 0777 ) != 0600 ){
+    std::cout <<"ERROR: cached payload not private to the user"<<std::endl;
+    ret = 1;
+  }
+  // payload stored under the hash of another one: not trusted
+  cond::Hash otherHash = makeHash( "MyOtherTestData", payloadData );
+  if( !cache.put( otherHash, type, payloadData, streamerInfoData ) ){
+    std::cout <<"ERROR: payload not stored"<<std::endl;
+    ret = 1;
+  }
+  if( otherCache.get( otherHash, readType, readData, readStreamerInfo ) ){
+    std::cout <<"ERROR: payload not matching its hash returned"<<std::endl;
+    ret = 1;
+  }
+  if( ::access( (directory+"/"+otherHash+".payload").c_str(), F_OK ) == 0 ){
+    std::cout <<"ERROR: payload not matching its hash not removed"<<std::endl;
+    ret = 1;
+  }
+  // truncated file: not trusted
+  {
+    std::ofstream corrupted( directory+"/"+hash+".payload", std::ios::binary | std::ios::trunc );
+    corrupted << "CONDPLC1 truncated";
+  }
+  if( otherCache.get( hash, readType, readData, readStreamerInfo ) ){
+    std::cout <<"ERROR: truncated payload returned"<<std::endl;
+    ret = 1;
+  }
+  // header with sizes overflowing the file size: not trusted
+  {
+    std::string header( "CONDPLC1", 8 );
+    uint64_t sizes[3] = { 2, ~uint64_t(0), 1 };
+    header.append( reinterpret_cast<const char*>( sizes ), sizeof(sizes) );
+    std::ofstream corrupted( directory+"/"+hash+".payload", std::ios::binary | std::ios::trunc );
+    corrupted << header << "ab";
+  }
+  if( otherCache.get( hash, readType, readData, readStreamerInfo ) ){
+    std::cout <<"ERROR: payload with overflowing sizes returned"<<std::endl;
+    ret = 1;
+  }
+  // invalid hash
+  if( cache.put( "../escape", type, payloadData, streamerInfoData ) ){
+    std::cout <<"ERROR: payload with invalid hash stored"<<std::endl;
+    ret = 1;
+  }
+  PayloadCache::Stats stats = otherCache.stats();
+  std::cout <<"Cache hits: "<<stats.hits<<" misses: "<<stats.misses<<std::endl;
+  if( stats.hits != 1 || stats.misses != 3 || cache.stats().stores != 2 ){
+    std::cout <<"ERROR: wrong cache statistics"<<std::endl;
+    ret = 1;
+  }
+  ::unlink( (directory+"/"+hash+".payload").c_str() );
+  ::rmdir( directory.c_str() );
+  return ret;
+}
+
+int main (int argc, char** argv)
+{
+  char tmpl[] = "/tmp/testPayloadCacheXXXXXX";
+  const char* directory = ::mkdtemp( tmpl );
+  if( !directory ) return 1;
+  int ret = run( directory );
+  if( ret == 0 ) std::cout <<"## PayloadCache test OK"<<std::endl;
+  return ret;
+}
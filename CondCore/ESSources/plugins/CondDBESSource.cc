@@ -22,12 +22,17 @@
 #include "CondCore/ESSources/interface/DataProxy.h"
 
 #include "CondCore/CondDB/interface/PayloadProxy.h"
+#include "CondCore/CondDB/interface/PayloadCache.h"
 #include "FWCore/ParameterSet/interface/ParameterSet.h"
 #include "FWCore/MessageLogger/interface/MessageLogger.h"
 #include <exception>
 
+#include <algorithm>
+#include <chrono>
 #include <iomanip>
 
+#include "tbb/task_group.h"
+
 namespace {
   /* utility ot build the name of the plugin corresponding to a given record
      se ESSources
@@ -96,6 +101,9 @@ namespace {
  *  DBParameters: configuration set of the connection
  *  globaltag: The GlobalTag
  *  toGet: list of record label tag connection-string to add/overwrite the content of the global-tag
+ *  prefetchPayloads: if true, at the first setIntervalFor load the payloads valid for that time of all the records
+ *                    (or only of prefetchRecords, if not empty) at once, fetching and deserializing them in parallel
+ *  prefetchConcurrency: number of sessions (and tasks) used for the prefetch, for each connection string
  */
 CondDBESSource::CondDBESSource( const edm::ParameterSet& iConfig ) :
   m_connection(), 
@@ -103,7 +111,10 @@ CondDBESSource::CondDBESSource( const edm::ParameterSet& iConfig ) :
   m_lastRun(0),  // for the stat
   m_lastLumi(0),  // for the stat
   m_policy( NOREFRESH ),
-  m_doDump( iConfig.getUntrackedParameter<bool>( "DumpStat", false ) )
+  m_doDump( iConfig.getUntrackedParameter<bool>( "DumpStat", false ) ),
+  m_prefetch( iConfig.getUntrackedParameter<bool>( "prefetchPayloads", false ) ),
+  m_prefetchConcurrency( std::max( iConfig.getUntrackedParameter<unsigned int>( "prefetchConcurrency", 4 ), 1U ) ),
+  m_prefetchDone( false )
 {
   if( iConfig.getUntrackedParameter<bool>( "RefreshAlways", false ) ) {
     m_policy = REFRESH_ALWAYS;
@@ -118,6 +129,15 @@ CondDBESSource::CondDBESSource( const edm::ParameterSet& iConfig ) :
     m_policy = RECONNECT_EACH_RUN;
   }
 
+  if( m_prefetch && m_policy != NOREFRESH ) {
+    // a refresh reloads the tags, dropping the payloads already loaded
+    edm::LogWarning( "CondDBESSource" ) << "Payload prefetching is not supported together with the refresh or reconnect options and has been disabled"
+					<< "; from CondDBESSource::CondDBESSource";
+    m_prefetch = false;
+  }
+  for( auto const& record : iConfig.getUntrackedParameter<std::vector<std::string> >( "prefetchRecords", std::vector<std::string>() ) )
+    m_prefetchRecords.insert( record );
+
   Stats s = {0,0,0,0,0,0,0,0};
   m_stats = s;	
 
@@ -293,6 +313,14 @@ void CondDBESSource::fillList(const std::string & stringList, std::vector<std::s
 }
 
 CondDBESSource::~CondDBESSource() {
+  if( m_connection.payloadCache() ) {
+    auto cacheStats = m_connection.payloadCache()->stats();
+    edm::LogInfo( "CondDBESSource" ) << "Payload cache in \"" << m_connection.payloadCache()->directory() << "\": "
+				     << cacheStats.hits << " hits (" << cacheStats.bytesRead << " bytes), "
+				     << cacheStats.misses << " misses, "
+				     << cacheStats.stores << " payloads stored (" << cacheStats.bytesStored << " bytes)"
+				     << "; from CondDBESSource::~CondDBESSource";
+  }
   //dump info FIXME: find a more suitable place...
   if (m_doDump) {
     std::cout << "CondDBESSource Statistics" << std::endl
@@ -345,6 +373,8 @@ CondDBESSource::setIntervalFor( const edm::eventsetup::EventSetupRecordKey& iKey
       m_stats.nLumi++;
     }
     //}
+
+  if( m_prefetch && !m_prefetchDone ) prefetchPayloads( iTime );
  
   bool doRefresh = false;
   if( m_policy == REFRESH_EACH_RUN || m_policy == RECONNECT_EACH_RUN ) {
@@ -528,6 +558,92 @@ CondDBESSource::setIntervalFor( const edm::eventsetup::EventSetupRecordKey& iKey
 }
   
 
+//
+// load at once the payloads valid at iTime: the IOVs are looked up one after the other,
+// then the payloads of each connection are shared among a few new sessions, each used
+// by a task to fetch and deserialize its payloads. The failures are only logged: the
+// payload is then loaded, and the error reported, when the record is asked for.
+//
+void
+CondDBESSource::prefetchPayloads( const edm::IOVSyncValue& iTime ) {
+  m_prefetchDone = true;
+  auto start = std::chrono::steady_clock::now();
+
+  std::map<std::string, std::vector<cond::persistency::BasePayloadProxy*> > toLoad;
+  unsigned int nProxies = 0;
+  for( auto const& p : m_proxies ) {
+    if( !m_prefetchRecords.empty() && m_prefetchRecords.find( p.first ) == m_prefetchRecords.end() ) continue;
+    auto proxy = p.second->proxy();
+    cond::Time_t abtime = cond::time::fromIOVSyncValue( iTime, proxy->timeType() );
+    if( 0 == abtime ) continue;
+    try {
+      proxy->setIntervalFor( abtime );
+    } catch( const std::exception& e ) {
+      edm::LogInfo( "CondDBESSource" ) << "IOV lookup failed for record \"" << p.first << "\" and label \"" << p.second->label()
+				       << "\": " << e.what() << "; from CondDBESSource::prefetchPayloads";
+      continue;
+    }
+    if( proxy->isValid() ) {
+      toLoad[ p.second->connString() ].push_back( proxy.get() );
+      ++nProxies;
+    }
+  }
+
+  struct Chunk {
+    std::string connectionString;
+    cond::persistency::Session session;
+    std::vector<cond::persistency::BasePayloadProxy*> proxies;
+    unsigned int nLoaded;
+  };
+  // round robin, to share the large payloads (usually of the same tags) among the tasks
+  std::vector<Chunk> chunks;
+  for( auto const& c : toLoad ) {
+    size_t nChunks = std::min<size_t>( m_prefetchConcurrency, c.second.size() );
+    try {
+      for( size_t i = 0; i < nChunks; ++i ) {
+	Chunk chunk{ c.first, m_connection.createReadOnlySession( c.first, "" ), {}, 0 };
+	for( size_t j = i; j < c.second.size(); j += nChunks ) chunk.proxies.push_back( c.second[j] );
+	chunks.push_back( std::move( chunk ) );
+      }
+    } catch( const std::exception& e ) {
+      edm::LogInfo( "CondDBESSource" ) << "Could not open the sessions to \"" << c.first
+				       << "\" for prefetching the payloads: " << e.what() << "; from CondDBESSource::prefetchPayloads";
+    }
+  }
+
+  tbb::task_group group;
+  for( auto& chunk : chunks ) {
+    group.run( [&chunk]() {
+	try {
+	  chunk.session.transaction().start( true );
+	  for( auto proxy : chunk.proxies ) {
+	    try {
+	      if( proxy->prefetch( chunk.session ) ) ++chunk.nLoaded;
+	    } catch( const std::exception& e ) {
+	      edm::LogInfo( "CondDBESSource" ) << "Payload prefetch from \"" << chunk.connectionString << "\" failed: " << e.what()
+					       << "; from CondDBESSource::prefetchPayloads";
+	    }
+	  }
+	  chunk.session.transaction().commit();
+	} catch( const std::exception& e ) {
+	  edm::LogInfo( "CondDBESSource" ) << "Payload prefetch from \"" << chunk.connectionString << "\" failed: " << e.what()
+					   << "; from CondDBESSource::prefetchPayloads";
+	}
+      } );
+  }
+  group.wait();
+
+  unsigned int nLoaded = 0;
+  for( auto const& chunk : chunks ) nLoaded += chunk.nLoaded;
+  chunks.clear();
+  std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+  edm::LogInfo( "CondDBESSource" ) << "Prefetched " << nLoaded << " payloads of " << nProxies << " valid IOVs for "
+				   << iTime.eventID() << ", timestamp: " << iTime.time().value()
+				   << " with " << m_prefetchConcurrency << " session(s) per connection in " << elapsed.count() << " s"
+				   << "; from CondDBESSource::prefetchPayloads";
+}
+
+
 //required by EventSetup System
 void 
 CondDBESSource::registerProxies(const edm::eventsetup::EventSetupRecordKey& iRecordKey , KeyedProxies& aProxyList) {
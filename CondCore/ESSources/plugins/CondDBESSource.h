@@ -87,8 +87,17 @@ class CondDBESSource : public edm::eventsetup::DataProxyProvider,
   
   bool m_doDump;
 
+  // load all the payloads valid for the first synchronization value at once,
+  // in concurrent tasks, before serving the first record
+  bool m_prefetch;
+  unsigned int m_prefetchConcurrency;
+  std::set<std::string> m_prefetchRecords;
+  bool m_prefetchDone;
+
  private:
 
+  void prefetchPayloads( const edm::IOVSyncValue& iTime );
+
   void fillList(const std::string & pfn, std::vector<std::string> & pfnList, const unsigned int listSize, const std::string & type);
 
   void fillTagCollectionFromGT(const std::string & connectionString,
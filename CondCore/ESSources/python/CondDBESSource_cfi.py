@@ -17,4 +17,7 @@ GlobalTag = cms.ESSource( "PoolDBESSource",
                           RefreshOpenIOVs  = cms.untracked.bool( False ),
                           pfnPostfix       = cms.untracked.string( '' ),
                           pfnPrefix        = cms.untracked.string( '' ),
+                          prefetchPayloads = cms.untracked.bool( False ),
+                          prefetchConcurrency = cms.untracked.uint32( 4 ),
+                          prefetchRecords  = cms.untracked.vstring(),
                           )
@@ -0,0 +1,25 @@
+#!/bin/sh
+# Loads all the records of a GlobalTag lazily, then with the payloads of the
+# first IOV prefetched, and compares the two jobs: the data gotten must be
+# the same, the job times are printed
+#   prefetch_from_gt.sh [GlobalTag] [connection string] [concurrency]
+
+function die { echo $1: status $2 ;  exit $2; }
+
+GT=${1:-102X_dataRun2_v3}
+CONNECT=${2:-frontier://FrontierProd/CMS_CONDITIONS}
+CONCURRENCY=${3:-4}
+CFG=${CMSSW_BASE}/src/CondCore/ESSources/test/python/prefetch_from_gt_cfg.py
+
+cmsRun ${CFG} globalTag=${GT} connect=${CONNECT} prefetch=False verbose=True > prefetch_lazy.log 2>&1 || die 'Failed loading the GlobalTag lazily, see prefetch_lazy.log' $?
+cmsRun ${CFG} globalTag=${GT} connect=${CONNECT} prefetch=True concurrency=${CONCURRENCY} verbose=True > prefetch_parallel.log 2>&1 || die 'Failed loading the GlobalTag with prefetching, see prefetch_parallel.log' $?
+
+grep "got data of type" prefetch_lazy.log | sort > prefetch_lazy.data
+grep "got data of type" prefetch_parallel.log | sort > prefetch_parallel.data
+[ -s prefetch_lazy.data ] || die 'No data gotten from the GlobalTag' 1
+diff prefetch_lazy.data prefetch_parallel.data > /dev/null || die 'Different data gotten with and without prefetching' $?
+
+echo "$(wc -l < prefetch_lazy.data) data items gotten from ${GT}"
+grep "Prefetched" prefetch_parallel.log
+printf "%-12s %s\n" lazy "$(grep -- '- Total job:' prefetch_lazy.log | head -1)"
+printf "%-12s %s\n" prefetch "$(grep -- '- Total job:' prefetch_parallel.log | head -1)"
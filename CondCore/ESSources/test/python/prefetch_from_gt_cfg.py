@@ -0,0 +1,96 @@
+# Loads all the records of a GlobalTag, with or without prefetching the payloads
+# of the first IOV in parallel: compare the startup time of
+#   cmsRun prefetch_from_gt_cfg.py prefetch=False
+#   cmsRun prefetch_from_gt_cfg.py prefetch=True concurrency=8
+# The payloads can be read from a local copy of the GlobalTag, e.g.
+#   conddb --yes copy <GlobalTag> --destdb gt.db
+#   cmsRun prefetch_from_gt_cfg.py connect=sqlite_file:gt.db
+# prefetch_from_gt.sh runs both and checks that they get the same data.
+import FWCore.ParameterSet.Config as cms
+import FWCore.ParameterSet.VarParsing as VarParsing
+
+options = VarParsing.VarParsing()
+options.register('runNumber',
+                 4294967294, #default value
+                 VarParsing.VarParsing.multiplicity.singleton,
+                 VarParsing.VarParsing.varType.int,
+                 "Run number; default gives latest IOV")
+options.register('globalTag',
+                 '102X_dataRun2_v3', #default value
+                 VarParsing.VarParsing.multiplicity.singleton,
+                 VarParsing.VarParsing.varType.string,
+                 "GlobalTag")
+options.register('connect',
+                 'frontier://FrontierProd/CMS_CONDITIONS', #default value
+                 VarParsing.VarParsing.multiplicity.singleton,
+                 VarParsing.VarParsing.varType.string,
+                 "Connection string of the GlobalTag (e.g. sqlite_file:gt.db)")
+options.register('prefetch',
+                 True, #default value
+                 VarParsing.VarParsing.multiplicity.singleton,
+                 VarParsing.VarParsing.varType.bool,
+                 "Prefetch the payloads of the first IOV in parallel")
+options.register('concurrency',
+                 4, #default value
+                 VarParsing.VarParsing.multiplicity.singleton,
+                 VarParsing.VarParsing.varType.int,
+                 "Number of sessions used for the prefetch")
+options.register('numThreads',
+                 4, #default value
+                 VarParsing.VarParsing.multiplicity.singleton,
+                 VarParsing.VarParsing.varType.int,
+                 "Number of threads")
+options.register('verbose',
+                 False, #default value
+                 VarParsing.VarParsing.multiplicity.singleton,
+                 VarParsing.VarParsing.varType.bool,
+                 "Print each data item gotten")
+options.parseArguments()
+
+process = cms.Process("TEST")
+
+process.options = cms.untracked.PSet(
+    numberOfThreads = cms.untracked.uint32(options.numThreads)
+)
+
+process.MessageLogger = cms.Service("MessageLogger",
+    destinations = cms.untracked.vstring('cout'),
+    categories = cms.untracked.vstring('CondDBESSource'),
+    cout = cms.untracked.PSet(
+        threshold = cms.untracked.string('INFO'),
+        INFO = cms.untracked.PSet(limit = cms.untracked.int32(0)),
+        CondDBESSource = cms.untracked.PSet(limit = cms.untracked.int32(-1))
+    )
+)
+
+process.Timing = cms.Service("Timing",
+    summaryOnly = cms.untracked.bool(True)
+)
+
+CondDBSetup = cms.PSet( DBParameters = cms.PSet(
+                                                messageLevel = cms.untracked.int32(0),
+                                                )
+                        )
+
+process.GlobalTag = cms.ESSource("PoolDBESSource",
+                                 CondDBSetup,
+                                 connect = cms.string(options.connect),
+                                 globaltag = cms.string(options.globalTag),
+                                 DumpStat = cms.untracked.bool(False),
+                                 prefetchPayloads = cms.untracked.bool(options.prefetch),
+                                 prefetchConcurrency = cms.untracked.uint32(options.concurrency)
+                                 )
+
+process.source = cms.Source("EmptyIOVSource",
+                            lastValue = cms.uint64(options.runNumber),
+                            timetype = cms.string('runnumber'),
+                            firstValue = cms.uint64(options.runNumber),
+                            interval = cms.uint64(1)
+                            )
+
+process.get = cms.EDAnalyzer("EventSetupRecordDataGetter",
+                             toGet =  cms.VPSet(),
+                             verbose = cms.untracked.bool(options.verbose)
+                             )
+
+process.p = cms.Path(process.get)
@@ -0,0 +1,72 @@
+
+#ifndef EGAMMAOBJECTS_GBRForestCompiled
+#define EGAMMAOBJECTS_GBRForestCompiled
+
+//////////////////////////////////////////////////////////////////////////
+//                                                                      //
+// GBRForestCompiled                                                    //
+//                                                                      //
+// Transient, evaluation-only representation of a GBRForest in which   //
+// all trees are flattened into one contiguous node array, each tree    //
+// stored in breadth-first order.  Terminal nodes are kept in the same  //
+// array as self-looping nodes so that a block of candidates can be     //
+// walked through a tree in lockstep for a fixed number of steps (the   //
+// tree depth) without per-candidate branching.                         //
+//                                                                      //
+// Responses are accumulated in the same order and precision as         //
+// GBRForest::GetResponse, so results are bitwise identical.            //
+//                                                                      //
+// Not persistent: build it once from the conditions payload (e.g. in   //
+// a GlobalCache or ES producer) and share it between streams.          //
+//                                                                      //
+//////////////////////////////////////////////////////////////////////////
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+class GBRForest;
+class GBRTree;
+
+class GBRForestCompiled {
+
+  public:
+
+    //number of candidates walked through a tree in lockstep
+    static constexpr unsigned int kBlockSize = 8;
+
+    struct Node {
+      float cutVal;       //+inf for terminal nodes, so that they loop onto themselves
+      float response;     //only meaningful for terminal nodes
+      unsigned int cutIndex;
+      int left;           //absolute index in the node array
+      int right;
+    };
+
+    GBRForestCompiled() : fInitialResponse(0.) {}
+    explicit GBRForestCompiled(const GBRForest &forest);
+
+    //single-candidate evaluation, same semantics as GBRForest::GetResponse
+    double GetResponse(const float* vector) const;
+    double GetGradBoostClassifier(const float* vector) const;
+
+    //batch evaluation of nvectors candidates; candidate i reads its inputs
+    //from vectors + i*stride and its response is written to responses[i]
+    void GetResponse(const float* vectors, std::size_t nvectors, std::size_t stride, double* responses) const;
+    void GetGradBoostClassifier(const float* vectors, std::size_t nvectors, std::size_t stride, double* responses) const;
+
+    std::size_t NTrees() const { return fRoots.size(); }
+    const std::vector<Node> &Nodes() const { return fNodes; }
+
+  private:
+    void AddTree(const GBRTree &tree);
+    void EvaluateBlock(const float* vectors, unsigned int n, std::size_t stride, double* responses) const;
+
+    double fInitialResponse;
+    std::vector<Node> fNodes;
+    std::vector<int> fRoots;
+    std::vector<unsigned int> fDepths;
+
+};
+
+#endif
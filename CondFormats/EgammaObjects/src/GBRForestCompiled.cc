@@ -0,0 +1,145 @@
+#include "CondFormats/EgammaObjects/interface/GBRForestCompiled.h"
+#include "CondFormats/EgammaObjects/interface/GBRForest.h"
+
+#include <algorithm>
+#include <cmath>
+#include <deque>
+#include <limits>
+
+//_______________________________________________________________________
+GBRForestCompiled::GBRForestCompiled(const GBRForest &forest) :
+  fInitialResponse(forest.InitialResponse())
+{
+  std::size_t nnodes = 0;
+  for (const GBRTree &tree : forest.Trees()) {
+    nnodes += tree.CutIndices().size() + tree.Responses().size();
+  }
+  fNodes.reserve(nnodes);
+  fRoots.reserve(forest.Trees().size());
+  fDepths.reserve(forest.Trees().size());
+
+  for (const GBRTree &tree : forest.Trees()) {
+    AddTree(tree);
+  }
+}
+
+//_______________________________________________________________________
+void GBRForestCompiled::AddTree(const GBRTree &tree) {
+
+  //GBRTree child references: positive values are intermediate nodes,
+  //zero or negative values are terminal nodes (index -ref in Responses())
+  struct Pending {
+    int ref;
+    int slot;
+    unsigned int depth;
+  };
+
+  const int root = fNodes.size();
+  fRoots.push_back(root);
+
+  unsigned int depth = 0;
+  std::deque<Pending> queue;
+  fNodes.emplace_back();
+  queue.push_back({0, root, 0});
+
+  //breadth-first: the slot of every node is reserved when its parent is
+  //visited, so siblings are adjacent and each level is contiguous
+  while (!queue.empty()) {
+    const Pending p = queue.front();
+    queue.pop_front();
+
+    Node &node = fNodes[p.slot];
+    if (p.ref > 0 || p.slot == root) {
+      node.cutVal = tree.CutVals()[p.ref];
+      node.response = 0.f;
+      node.cutIndex = tree.CutIndices()[p.ref];
+
+      const int children[2] = { tree.LeftIndices()[p.ref], tree.RightIndices()[p.ref] };
+      int slots[2];
+      for (unsigned int i = 0; i < 2; ++i) {
+        slots[i] = fNodes.size();
+        fNodes.emplace_back();
+        queue.push_back({children[i], slots[i], p.depth + 1});
+      }
+      //fNodes may have been reallocated above
+      fNodes[p.slot].left = slots[0];
+      fNodes[p.slot].right = slots[1];
+    }
+    else {
+      node.cutVal = std::numeric_limits<float>::infinity();
+      node.response = tree.Responses()[-p.ref];
+      node.cutIndex = 0;
+      node.left = p.slot;
+      node.right = p.slot;
+      depth = std::max(depth, p.depth);
+    }
+  }
+
+  fDepths.push_back(depth);
+}
+
+//_______________________________________________________________________
+double GBRForestCompiled::GetResponse(const float* vector) const {
+  double response = fInitialResponse;
+  for (int root : fRoots) {
+    int index = root;
+    const Node *node = &fNodes[index];
+    while (node->left != index) {
+      index = vector[node->cutIndex] > node->cutVal ? node->right : node->left;
+      node = &fNodes[index];
+    }
+    response += node->response;
+  }
+  return response;
+}
+
+//_______________________________________________________________________
+double GBRForestCompiled::GetGradBoostClassifier(const float* vector) const {
+  double response = GetResponse(vector);
+  return 2.0/(1.0+exp(-2.0*response))-1; //MVA output between -1 and 1
+}
+
+//_______________________________________________________________________
+void GBRForestCompiled::EvaluateBlock(const float* vectors, unsigned int n, std::size_t stride, double* responses) const {
+
+  for (unsigned int j = 0; j < n; ++j) {
+    responses[j] = fInitialResponse;
+  }
+
+  int index[kBlockSize];
+  for (std::size_t itree = 0; itree < fRoots.size(); ++itree) {
+    for (unsigned int j = 0; j < n; ++j) {
+      index[j] = fRoots[itree];
+    }
+    //terminal nodes loop onto themselves, so all lanes can take exactly
+    //'depth' steps and the inner loop is a branch-free compare-and-select
+    for (unsigned int d = 0; d < fDepths[itree]; ++d) {
+      for (unsigned int j = 0; j < n; ++j) {
+        const Node &node = fNodes[index[j]];
+        index[j] = vectors[j*stride + node.cutIndex] > node.cutVal ? node.right : node.left;
+      }
+    }
+    for (unsigned int j = 0; j < n; ++j) {
+      responses[j] += fNodes[index[j]].response;
+    }
+  }
+}
+
+//_______________________________________________________________________
+void GBRForestCompiled::GetResponse(const float* vectors, std::size_t nvectors, std::size_t stride, double* responses) const {
+  std::size_t i = 0;
+  for (; i + kBlockSize <= nvectors; i += kBlockSize) {
+    EvaluateBlock(vectors + i*stride, kBlockSize, stride, responses + i);
+  }
+  if (i < nvectors) {
+    EvaluateBlock(vectors + i*stride, nvectors - i, stride, responses + i);
+  }
+}
+
+//_______________________________________________________________________
+void GBRForestCompiled::GetGradBoostClassifier(const float* vectors, std::size_t nvectors, std::size_t stride, double* responses) const {
+  GetResponse(vectors, nvectors, stride, responses);
+  for (std::size_t i = 0; i < nvectors; ++i) {
+    responses[i] = 2.0/(1.0+exp(-2.0*responses[i]))-1;
+  }
+}
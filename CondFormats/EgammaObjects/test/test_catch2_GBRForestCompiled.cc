@@ -0,0 +1,94 @@
+#include "CondFormats/EgammaObjects/interface/GBRForest.h"
+#include "CondFormats/EgammaObjects/interface/GBRForestCompiled.h"
+
+#include "catch.hpp"
+
+#include <cstring>
+#include <limits>
+#include <random>
+
+namespace {
+  //random binary tree in the GBRTree encoding
+  void addRandomNode(GBRTree& tree, std::mt19937& rng, unsigned int depth, unsigned int nvars) {
+    std::uniform_real_distribution<float> val(-1.f, 1.f);
+    const int idx = tree.CutIndices().size();
+    tree.CutIndices().push_back(rng() % nvars);
+    tree.CutVals().push_back(val(rng));
+    tree.LeftIndices().push_back(0);
+    tree.RightIndices().push_back(0);
+
+    for (int side = 0; side < 2; ++side) {
+      const bool terminal = depth == 0 || rng() % 4 == 0;
+      const int ref = terminal ? -int(tree.Responses().size()) : int(tree.CutIndices().size());
+      if (side == 0)
+        tree.LeftIndices()[idx] = ref;
+      else
+        tree.RightIndices()[idx] = ref;
+      if (terminal)
+        tree.Responses().push_back(val(rng));
+      else
+        addRandomNode(tree, rng, depth - 1, nvars);
+    }
+  }
+
+  GBRForest makeForest(unsigned int ntrees, unsigned int nvars) {
+    std::mt19937 rng(42);
+    GBRForest forest;
+    forest.SetInitialResponse(0.25);
+    for (unsigned int i = 0; i < ntrees; ++i) {
+      GBRTree tree;
+      addRandomNode(tree, rng, 1 + rng() % 8, nvars);
+      forest.Trees().push_back(tree);
+    }
+    //root-is-terminal special case as produced by GBRTree(TMVA::DecisionTree*)
+    GBRTree stump;
+    stump.CutIndices().push_back(0);
+    stump.CutVals().push_back(0);
+    stump.LeftIndices().push_back(0);
+    stump.RightIndices().push_back(0);
+    stump.Responses().push_back(0.125f);
+    forest.Trees().push_back(stump);
+    return forest;
+  }
+
+  bool bitwiseEqual(double a, double b) { return std::memcmp(&a, &b, sizeof(double)) == 0; }
+}  // namespace
+
+static constexpr auto s_tag = "[GBRForestCompiled]";
+TEST_CASE("Compiled forest matches GBRForest", s_tag) {
+  constexpr unsigned int nvars = 7;
+  constexpr unsigned int ncands = 1003;  //not a multiple of the block size
+  const GBRForest forest = makeForest(200, nvars);
+  const GBRForestCompiled compiled(forest);
+
+  REQUIRE(compiled.NTrees() == forest.Trees().size());
+
+  std::mt19937 rng(7);
+  std::uniform_real_distribution<float> val(-1.2f, 1.2f);
+  std::vector<float> inputs(ncands * nvars);
+  for (auto& x : inputs)
+    x = val(rng);
+  //exact cut values, infinities and NaN must take the same branches
+  inputs[0] = forest.Trees()[0].CutVals()[0];
+  inputs[nvars] = std::numeric_limits<float>::infinity();
+  inputs[2 * nvars] = std::numeric_limits<float>::quiet_NaN();
+
+  SECTION("single candidate") {
+    for (unsigned int i = 0; i < ncands; ++i) {
+      REQUIRE(bitwiseEqual(compiled.GetResponse(&inputs[i * nvars]), forest.GetResponse(&inputs[i * nvars])));
+    }
+  }
+
+  SECTION("batch") {
+    std::vector<double> responses(ncands);
+    compiled.GetResponse(inputs.data(), ncands, nvars, responses.data());
+    for (unsigned int i = 0; i < ncands; ++i) {
+      REQUIRE(bitwiseEqual(responses[i], forest.GetResponse(&inputs[i * nvars])));
+    }
+
+    compiled.GetGradBoostClassifier(inputs.data(), ncands, nvars, responses.data());
+    for (unsigned int i = 0; i < ncands; ++i) {
+      REQUIRE(bitwiseEqual(responses[i], forest.GetGradBoostClassifier(&inputs[i * nvars])));
+    }
+  }
+}
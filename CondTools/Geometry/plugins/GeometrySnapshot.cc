@@ -0,0 +1,162 @@
+#include "GeometrySnapshot.h"
+
+#include "FWCore/Utilities/interface/Exception.h"
+
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace geometrysnapshot {
+
+  namespace {
+    constexpr char magic[8] = {'C', 'M', 'S', 'G', 'E', 'O', 'S', 'N'};
+
+    struct Header {
+      char magic[8];
+      uint32_t version;
+      uint32_t nEntries;
+      uint64_t labelOffset;
+      uint64_t labelSize;
+    };
+
+    struct Block {
+      uint64_t offset;
+      uint64_t size;
+    };
+
+    struct EntryHeader {
+      Block record;
+      Block type;
+      Block data;
+      Block streamerInfo;
+    };
+
+    uint64_t aligned(uint64_t offset) { return (offset + 7) & ~uint64_t(7); }
+  }  // namespace
+
+  void Writer::add(const std::string& record,
+                   const std::string& type,
+                   const cond::Binary& data,
+                   const cond::Binary& streamerInfo) {
+    entries_.push_back(Entry{record, type, data, streamerInfo});
+  }
+
+  void Writer::write(const std::string& fileName, const std::string& label) const {
+    // layout of the data blocks, after the header and the entry table
+    std::vector<std::pair<const void*, uint64_t>> blocks;
+    std::vector<EntryHeader> table(entries_.size());
+    uint64_t offset = sizeof(Header) + table.size() * sizeof(EntryHeader);
+    auto place = [&](const void* data, uint64_t size) {
+      offset = aligned(offset);
+      Block block{offset, size};
+      blocks.emplace_back(data, size);
+      offset += size;
+      return block;
+    };
+    Header header;
+    std::memcpy(header.magic, magic, sizeof(magic));
+    header.version = formatVersion;
+    header.nEntries = entries_.size();
+    Block labelBlock = place(label.data(), label.size());
+    header.labelOffset = labelBlock.offset;
+    header.labelSize = labelBlock.size;
+    for (unsigned int i = 0; i < entries_.size(); ++i) {
+      const Entry& entry = entries_[i];
+      table[i].record = place(entry.record.data(), entry.record.size());
+      table[i].type = place(entry.type.data(), entry.type.size());
+      table[i].data = place(entry.data.data(), entry.data.size());
+      table[i].streamerInfo = place(entry.streamerInfo.data(), entry.streamerInfo.size());
+    }
+
+    // written under a temporary name, so that a job never maps a partial snapshot
+    const std::string tmpName = fileName + ".tmp";
+    std::ofstream file(tmpName, std::ios::binary | std::ios::trunc);
+    file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    file.write(reinterpret_cast<const char*>(table.data()), table.size() * sizeof(EntryHeader));
+    uint64_t position = sizeof(Header) + table.size() * sizeof(EntryHeader);
+    const char padding[8] = {0, 0, 0, 0, 0, 0, 0, 0};
+    for (auto const& block : blocks) {
+      file.write(padding, aligned(position) - position);
+      position = aligned(position);
+      file.write(static_cast<const char*>(block.first), block.second);
+      position += block.second;
+    }
+    file.close();
+    if (!file || std::rename(tmpName.c_str(), fileName.c_str()) != 0) {
+      std::remove(tmpName.c_str());
+      throw cms::Exception("GeometrySnapshot") << "Could not write the geometry snapshot " << fileName;
+    }
+  }
+
+  Reader::Reader(const std::string& fileName) : fileName_(fileName), map_(nullptr), size_(0) {
+    int fd = ::open(fileName.c_str(), O_RDONLY);
+    if (fd < 0)
+      throw cms::Exception("GeometrySnapshot")
+          << "Could not open the geometry snapshot " << fileName << ": " << std::strerror(errno);
+    struct stat st;
+    if (::fstat(fd, &st) == 0 && size_t(st.st_size) >= sizeof(Header)) {
+      size_ = st.st_size;
+      map_ = ::mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd, 0);
+      if (map_ == MAP_FAILED)
+        map_ = nullptr;
+    }
+    ::close(fd);
+    if (!map_)
+      throw cms::Exception("GeometrySnapshot") << "Could not map the geometry snapshot " << fileName;
+
+    const char* base = static_cast<const char*>(map_);
+    Header header;
+    std::memcpy(&header, base, sizeof(header));
+    if (std::memcmp(header.magic, magic, sizeof(magic)) != 0) {
+      ::munmap(map_, size_);
+      throw cms::Exception("GeometrySnapshot") << fileName << " is not a geometry snapshot";
+    }
+    if (header.version != formatVersion) {
+      ::munmap(map_, size_);
+      throw cms::Exception("GeometrySnapshot")
+          << "The geometry snapshot " << fileName << " has format version " << header.version
+          << ", this release reads version " << formatVersion << ": the snapshot must be written again";
+    }
+    auto inFile = [&](const Block& block) { return block.offset <= size_ && block.size <= size_ - block.offset; };
+    bool ok = sizeof(Header) + uint64_t(header.nEntries) * sizeof(EntryHeader) <= size_ &&
+              inFile(Block{header.labelOffset, header.labelSize});
+    if (ok) {
+      label_.assign(base + header.labelOffset, header.labelSize);
+      for (uint32_t i = 0; ok && i < header.nEntries; ++i) {
+        EntryHeader table;
+        std::memcpy(&table, base + sizeof(Header) + i * sizeof(EntryHeader), sizeof(table));
+        ok = inFile(table.record) && inFile(table.type) && inFile(table.data) && inFile(table.streamerInfo);
+        if (ok)
+          entries_.push_back(Entry{std::string(base + table.record.offset, table.record.size),
+                                   std::string(base + table.type.offset, table.type.size),
+                                   base + table.data.offset,
+                                   table.data.size,
+                                   base + table.streamerInfo.offset,
+                                   table.streamerInfo.size});
+      }
+    }
+    if (!ok) {
+      ::munmap(map_, size_);
+      throw cms::Exception("GeometrySnapshot") << "The geometry snapshot " << fileName << " is truncated or corrupted";
+    }
+  }
+
+  Reader::~Reader() {
+    if (map_)
+      ::munmap(map_, size_);
+  }
+
+  const Reader::Entry* Reader::find(const std::string& record) const {
+    for (auto const& entry : entries_)
+      if (entry.record == record)
+        return &entry;
+    return nullptr;
+  }
+
+}  // namespace geometrysnapshot
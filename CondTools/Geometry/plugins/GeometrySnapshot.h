@@ -0,0 +1,135 @@
+#ifndef CondTools_Geometry_GeometrySnapshot_h
+#define CondTools_Geometry_GeometrySnapshot_h
+
+/*
+ * Geometry snapshot: a single binary file holding the reco geometry payloads
+ * (the same ones read from the conditions database with GeometryRecoDB_cff),
+ * serialized as in the database. It is written once by GeometrySnapshotWriter
+ * and memory mapped by GeometrySnapshotESSource, which deserializes the payloads
+ * directly from the mapped file: the reco geometries are then built by the usual
+ * "from DB" ESProducers, without parsing the XML geometry description.
+ *
+ * Layout (native byte order, all offsets from the start of the file):
+ *   header:  magic "CMSGEOSN", uint32 format version, uint32 number of entries,
+ *            uint64 offset and size of the label (free text: release, geometry)
+ *   entries: uint64 offset and size of record name, payload type, payload data
+ *            and streamer info
+ *   data:    the strings and the blobs, each aligned to 8 bytes
+ */
+
+#include "CondCore/CondDB/interface/Binary.h"
+
+#include "CondFormats/GeometryObjects/interface/CSCRecoDigiParameters.h"
+#include "CondFormats/GeometryObjects/interface/HcalParameters.h"
+#include "CondFormats/GeometryObjects/interface/PCaloGeometry.h"
+#include "CondFormats/GeometryObjects/interface/PGeometricDet.h"
+#include "CondFormats/GeometryObjects/interface/PGeometricDetExtra.h"
+#include "CondFormats/GeometryObjects/interface/PHGCalParameters.h"
+#include "CondFormats/GeometryObjects/interface/PTrackerParameters.h"
+#include "CondFormats/GeometryObjects/interface/RecoIdealGeometry.h"
+
+#include "Geometry/Records/interface/CSCRecoDigiParametersRcd.h"
+#include "Geometry/Records/interface/CSCRecoGeometryRcd.h"
+#include "Geometry/Records/interface/DTRecoGeometryRcd.h"
+#include "Geometry/Records/interface/GEMRecoGeometryRcd.h"
+#include "Geometry/Records/interface/HcalParametersRcd.h"
+#include "Geometry/Records/interface/IdealGeometryRecord.h"
+#include "Geometry/Records/interface/ME0RecoGeometryRcd.h"
+#include "Geometry/Records/interface/PCaloTowerRcd.h"
+#include "Geometry/Records/interface/PCastorRcd.h"
+#include "Geometry/Records/interface/PEcalBarrelRcd.h"
+#include "Geometry/Records/interface/PEcalEndcapRcd.h"
+#include "Geometry/Records/interface/PEcalPreshowerRcd.h"
+#include "Geometry/Records/interface/PGeometricDetExtraRcd.h"
+#include "Geometry/Records/interface/PHcalRcd.h"
+#include "Geometry/Records/interface/PHGCalParametersRcd.h"
+#include "Geometry/Records/interface/PTrackerParametersRcd.h"
+#include "Geometry/Records/interface/PZdcRcd.h"
+#include "Geometry/Records/interface/RPCRecoGeometryRcd.h"
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace geometrysnapshot {
+
+  constexpr uint32_t formatVersion = 1;
+
+  template <typename R, typename P>
+  struct Payload {
+    typedef R Record;
+    typedef P Type;
+  };
+
+  // the payloads that can be stored in a snapshot; f is called with a Payload<Record, Type>
+  template <typename F>
+  void forEachPayload(F&& f) {
+    f(Payload<IdealGeometryRecord, PGeometricDet>());
+    f(Payload<PGeometricDetExtraRcd, PGeometricDetExtra>());
+    f(Payload<PTrackerParametersRcd, PTrackerParameters>());
+    f(Payload<PEcalBarrelRcd, PCaloGeometry>());
+    f(Payload<PEcalEndcapRcd, PCaloGeometry>());
+    f(Payload<PEcalPreshowerRcd, PCaloGeometry>());
+    f(Payload<PHcalRcd, PCaloGeometry>());
+    f(Payload<HcalParametersRcd, HcalParameters>());
+    f(Payload<PCaloTowerRcd, PCaloGeometry>());
+    f(Payload<PZdcRcd, PCaloGeometry>());
+    f(Payload<PCastorRcd, PCaloGeometry>());
+    f(Payload<CSCRecoGeometryRcd, RecoIdealGeometry>());
+    f(Payload<CSCRecoDigiParametersRcd, CSCRecoDigiParameters>());
+    f(Payload<DTRecoGeometryRcd, RecoIdealGeometry>());
+    f(Payload<RPCRecoGeometryRcd, RecoIdealGeometry>());
+    f(Payload<GEMRecoGeometryRcd, RecoIdealGeometry>());
+    f(Payload<ME0RecoGeometryRcd, RecoIdealGeometry>());
+    f(Payload<PHGCalParametersRcd, PHGCalParameters>());
+  }
+
+  class Writer {
+  public:
+    void add(const std::string& record, const std::string& type, const cond::Binary& data, const cond::Binary& streamerInfo);
+    // throws cms::Exception if the file cannot be written
+    void write(const std::string& fileName, const std::string& label) const;
+
+  private:
+    struct Entry {
+      std::string record;
+      std::string type;
+      cond::Binary data;
+      cond::Binary streamerInfo;
+    };
+    std::vector<Entry> entries_;
+  };
+
+  class Reader {
+  public:
+    struct Entry {
+      std::string record;
+      std::string type;
+      const char* data;
+      size_t dataSize;
+      const char* streamerInfo;
+      size_t streamerInfoSize;
+    };
+
+    // maps the file; throws cms::Exception if it cannot be read or has another format version
+    explicit Reader(const std::string& fileName);
+    ~Reader();
+    Reader(const Reader&) = delete;
+    Reader& operator=(const Reader&) = delete;
+
+    const std::string& label() const { return label_; }
+    const std::vector<Entry>& entries() const { return entries_; }
+    // nullptr if the record is not in the snapshot
+    const Entry* find(const std::string& record) const;
+
+  private:
+    std::string fileName_;
+    void* map_;
+    size_t size_;
+    std::string label_;
+    std::vector<Entry> entries_;
+  };
+
+}  // namespace geometrysnapshot
+
+#endif
@@ -0,0 +1,120 @@
+#include "FWCore/Framework/interface/ESProducer.h"
+#include "FWCore/Framework/interface/EventSetupRecordIntervalFinder.h"
+#include "FWCore/Framework/interface/SourceFactory.h"
+#include "FWCore/MessageLogger/interface/MessageLogger.h"
+#include "FWCore/ParameterSet/interface/ConfigurationDescriptions.h"
+#include "FWCore/ParameterSet/interface/ParameterSet.h"
+#include "FWCore/ParameterSet/interface/ParameterSetDescription.h"
+#include "FWCore/Utilities/interface/Exception.h"
+#include "CondCore/CondDB/interface/Serialization.h"
+
+#include "GeometrySnapshot.h"
+
+#include <chrono>
+#include <memory>
+#include <istream>
+#include <streambuf>
+
+namespace {
+  // read-only stream buffer over the bytes of a payload in the mapped file;
+  // the get area is never written to, so the const_cast is safe
+  class MappedBuffer : public std::streambuf
+  {
+  public:
+    MappedBuffer( const char* data, size_t size )
+    {
+      char* begin = const_cast<char*>( data );
+      setg( begin, begin, begin + size );
+    }
+  };
+}
+
+/*
+ * Provides the reco geometry payloads from a geometry snapshot file written
+ * by GeometrySnapshotWriter, for all the records found in the file, with an
+ * infinite IOV. It replaces the XML geometry description (or the conditions
+ * database) in jobs which only need the reco geometry: the payloads are
+ * deserialized directly from the memory mapped file and the reco geometries
+ * are built from them by the same ESProducers as for the geometry from DB
+ * (Configuration/Geometry/python/GeometryRecoDB_cff.py).
+ */
+class GeometrySnapshotESSource : public edm::ESProducer, public edm::EventSetupRecordIntervalFinder
+{
+public:
+  GeometrySnapshotESSource( const edm::ParameterSet& );
+
+  static void fillDescriptions( edm::ConfigurationDescriptions& );
+
+protected:
+  void setIntervalFor( const edm::eventsetup::EventSetupRecordKey&, const edm::IOVSyncValue&, edm::ValidityInterval& ) override;
+
+private:
+  template <typename R, typename P>
+  std::unique_ptr<P> produce( const R& );
+
+  template <typename R, typename P>
+  void registerPayload();
+
+  std::unique_ptr<const geometrysnapshot::Reader> m_reader;
+};
+
+GeometrySnapshotESSource::GeometrySnapshotESSource( const edm::ParameterSet& iConfig )
+{
+  const std::string fileName = iConfig.getUntrackedParameter<std::string>( "fileName" );
+  m_reader = std::make_unique<geometrysnapshot::Reader>( fileName );
+  edm::LogInfo( "GeometrySnapshotESSource" ) << "Geometry snapshot " << fileName << " (" << m_reader->label() << "), "
+					     << m_reader->entries().size() << " payloads";
+  geometrysnapshot::forEachPayload( [&]( auto payload ) {
+      typedef decltype( payload ) Payload;
+      this->registerPayload<typename Payload::Record, typename Payload::Type>();
+    });
+}
+
+void
+GeometrySnapshotESSource::fillDescriptions( edm::ConfigurationDescriptions& descriptions )
+{
+  edm::ParameterSetDescription desc;
+  desc.addUntracked<std::string>( "fileName" )->setComment( "Geometry snapshot written by GeometrySnapshotWriter." );
+  descriptions.add( "geometrySnapshotESSource", desc );
+}
+
+template <typename R, typename P>
+void
+GeometrySnapshotESSource::registerPayload()
+{
+  if( !m_reader->find( edm::eventsetup::EventSetupRecordKey::makeKey<R>().name()))
+    return;
+  setWhatProduced( this, &GeometrySnapshotESSource::produce<R, P> );
+  findingRecord<R>();
+}
+
+template <typename R, typename P>
+std::unique_ptr<P>
+GeometrySnapshotESSource::produce( const R& )
+{
+  auto start = std::chrono::steady_clock::now();
+  const geometrysnapshot::Reader::Entry* entry = m_reader->find( edm::eventsetup::EventSetupRecordKey::makeKey<R>().name());
+  std::unique_ptr<P> payload( cond::createPayload<P>( entry->type ));
+  // read in place from the mapped file, without copying the data in a cond::Binary
+  MappedBuffer dataBuf( entry->data, entry->dataSize );
+  std::istream dataStream( &dataBuf );
+  try {
+    cond::CondInputArchive ia( dataStream );
+    ia >> ( *payload );
+  } catch( const std::exception& e ) {
+    throw cms::Exception( "GeometrySnapshot" ) << "Could not read the " << entry->type << " payload of " << entry->record
+					       << " from the geometry snapshot: " << e.what()
+					       << ". The snapshot was written with: " << std::string( entry->streamerInfo, entry->streamerInfoSize );
+  }
+  edm::LogInfo( "GeometrySnapshotESSource" ) << entry->record << " read in "
+					     << std::chrono::duration<double, std::milli>( std::chrono::steady_clock::now() - start ).count() << " ms";
+  return payload;
+}
+
+void
+GeometrySnapshotESSource::setIntervalFor( const edm::eventsetup::EventSetupRecordKey&, const edm::IOVSyncValue&, edm::ValidityInterval& oValidity )
+{
+  oValidity = edm::ValidityInterval( edm::IOVSyncValue::beginOfTime(), edm::IOVSyncValue::endOfTime());
+}
+
+DEFINE_FWK_EVENTSETUP_SOURCE( GeometrySnapshotESSource );
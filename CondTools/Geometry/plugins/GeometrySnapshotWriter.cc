@@ -0,0 +1,82 @@
+#include "FWCore/Framework/interface/one/EDAnalyzer.h"
+#include "FWCore/Framework/interface/EventSetup.h"
+#include "FWCore/Framework/interface/ESHandle.h"
+#include "FWCore/Framework/interface/MakerMacros.h"
+#include "FWCore/ParameterSet/interface/ParameterSet.h"
+#include "FWCore/MessageLogger/interface/MessageLogger.h"
+#include "FWCore/Utilities/interface/Exception.h"
+#include "CondCore/CondDB/interface/Serialization.h"
+#include "CondCore/CondDB/interface/Utils.h"
+
+#include "GeometrySnapshot.h"
+
+/*
+ * Writes the reco geometry payloads available in the EventSetup (typically
+ * read from the conditions database or from the sqlite file written by
+ * geometrywriter.py) to a geometry snapshot file, to be read by
+ * GeometrySnapshotESSource. The payloads not found in the EventSetup are
+ * skipped.
+ */
+class GeometrySnapshotWriter : public edm::one::EDAnalyzer<edm::one::WatchRuns>
+{
+public:
+
+  GeometrySnapshotWriter( const edm::ParameterSet& iConfig )
+    : m_fileName( iConfig.getUntrackedParameter<std::string>( "fileName" ) ),
+      m_label( iConfig.getUntrackedParameter<std::string>( "label", "" ) ),
+      m_done( false )
+  {}
+
+  void beginRun( edm::Run const&, edm::EventSetup const& ) override;
+  void analyze( edm::Event const&, edm::EventSetup const& ) override {}
+  void endRun( edm::Run const&, edm::EventSetup const& ) override {}
+
+private:
+  template <typename R, typename P>
+  void addPayload( edm::EventSetup const& es, geometrysnapshot::Writer& writer );
+
+  std::string m_fileName;
+  std::string m_label;
+  bool m_done;
+};
+
+template <typename R, typename P>
+void
+GeometrySnapshotWriter::addPayload( edm::EventSetup const& es, geometrysnapshot::Writer& writer )
+{
+  const std::string record = edm::eventsetup::EventSetupRecordKey::makeKey<R>().name();
+  auto rec = es.tryToGet<R>();
+  if( !rec ) {
+    edm::LogInfo( "GeometrySnapshotWriter" ) << record << " not in the EventSetup, skipped";
+    return;
+  }
+  edm::ESHandle<P> payload;
+  try {
+    rec->get( payload );
+  } catch( cms::Exception const& ) {
+    edm::LogInfo( "GeometrySnapshotWriter" ) << "No payload in " << record << ", skipped";
+    return;
+  }
+  const std::string type = cond::demangledName( typeid( P ));
+  auto data = cond::serialize( *payload );
+  writer.add( record, type, data.first, data.second );
+  edm::LogInfo( "GeometrySnapshotWriter" ) << record << ": " << type << ", " << data.first.size() << " bytes";
+}
+
+void
+GeometrySnapshotWriter::beginRun( edm::Run const&, edm::EventSetup const& es )
+{
+  // the geometry does not change from run to run
+  if( m_done )
+    return;
+  geometrysnapshot::Writer writer;
+  geometrysnapshot::forEachPayload( [&]( auto payload ) {
+      typedef decltype( payload ) Payload;
+      this->addPayload<typename Payload::Record, typename Payload::Type>( es, writer );
+    });
+  writer.write( m_fileName, m_label );
+  edm::LogInfo( "GeometrySnapshotWriter" ) << "Geometry snapshot written to " << m_fileName;
+  m_done = true;
+}
+
+DEFINE_FWK_MODULE( GeometrySnapshotWriter );
@@ -0,0 +1,128 @@
+#include "FWCore/Framework/interface/one/EDAnalyzer.h"
+#include "FWCore/Framework/interface/EventSetup.h"
+#include "FWCore/Framework/interface/ESHandle.h"
+#include "FWCore/Framework/interface/MakerMacros.h"
+#include "FWCore/ParameterSet/interface/ParameterSet.h"
+#include "FWCore/MessageLogger/interface/MessageLogger.h"
+#include "FWCore/Utilities/interface/Exception.h"
+
+#include "Geometry/CaloGeometry/interface/CaloGeometry.h"
+#include "Geometry/CSCGeometry/interface/CSCGeometry.h"
+#include "Geometry/DTGeometry/interface/DTGeometry.h"
+#include "Geometry/RPCGeometry/interface/RPCGeometry.h"
+#include "Geometry/TrackerGeometryBuilder/interface/TrackerGeometry.h"
+#include "Geometry/Records/interface/CaloGeometryRecord.h"
+#include "Geometry/Records/interface/MuonGeometryRecord.h"
+#include "Geometry/Records/interface/TrackerDigiGeometryRecord.h"
+
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <string>
+
+/*
+ * Dumps the positions and orientations of the tracker and muon dets and the
+ * positions of the calorimeter cells, with a fixed precision, to compare the
+ * reco geometries built from different sources (XML geometry description,
+ * conditions database, geometry snapshot): the dumps of two jobs using the
+ * same geometry must be identical (see validateGeometrySnapshot.sh).
+ */
+namespace {
+
+  class RecoGeometryDump : public edm::one::EDAnalyzer<edm::one::WatchRuns>
+  {
+  public:
+
+    RecoGeometryDump( edm::ParameterSet const& iConfig )
+      : m_fileName( iConfig.getUntrackedParameter<std::string>( "fileName" )),
+	m_precision( iConfig.getUntrackedParameter<unsigned int>( "precision", 4 )),
+	m_done( false )
+    {}
+
+    void beginRun( edm::Run const&, edm::EventSetup const& ) override;
+    void analyze( edm::Event const&, edm::EventSetup const& ) override {}
+    void endRun( edm::Run const&, edm::EventSetup const& ) override {}
+
+  private:
+    template <typename Geometry>
+    void dumpDets( std::ostream& out, const char* name, const Geometry& geometry ) const;
+    void dumpCalo( std::ostream& out, const CaloGeometry& geometry ) const;
+    std::string format( double value ) const;
+
+    std::string m_fileName;
+    unsigned int m_precision;
+    bool m_done;
+  };
+}
+
+std::string
+RecoGeometryDump::format( double value ) const
+{
+  char buffer[64];
+  std::snprintf( buffer, sizeof( buffer ), "%.*f", m_precision, value );
+  // do not tell -0 from 0
+  std::string s( buffer );
+  if( s.find_first_not_of( "-0." ) == std::string::npos )
+    s = s.substr( s[0] == '-' ? 1 : 0 );
+  return s;
+}
+
+template <typename Geometry>
+void
+RecoGeometryDump::dumpDets( std::ostream& out, const char* name, const Geometry& geometry ) const
+{
+  out << name << " " << geometry.dets().size() << "\n";
+  for( auto det : geometry.dets()) {
+    const auto& pos = det->position();
+    const auto& rot = det->rotation();
+    out << det->geographicalId().rawId() << " " << format( pos.x()) << " " << format( pos.y()) << " " << format( pos.z())
+	<< " " << format( rot.xx()) << " " << format( rot.xy()) << " " << format( rot.xz())
+	<< " " << format( rot.yx()) << " " << format( rot.yy()) << " " << format( rot.yz())
+	<< " " << format( rot.zx()) << " " << format( rot.zy()) << " " << format( rot.zz()) << "\n";
+  }
+}
+
+void
+RecoGeometryDump::dumpCalo( std::ostream& out, const CaloGeometry& geometry ) const
+{
+  const std::vector<DetId> ids = geometry.getValidDetIds();
+  std::vector<GlobalPoint> positions;
+  geometry.getPositions( ids, positions );
+  out << "CALO " << ids.size() << "\n";
+  for( size_t i = 0; i < ids.size(); ++i )
+    out << ids[i].rawId() << " " << format( positions[i].x()) << " " << format( positions[i].y()) << " " << format( positions[i].z()) << "\n";
+}
+
+void
+RecoGeometryDump::beginRun( edm::Run const&, edm::EventSetup const& es )
+{
+  if( m_done )
+    return;
+  m_done = true;
+
+  // the first access builds the reco geometries: time it to compare the sources
+  auto start = std::chrono::steady_clock::now();
+  edm::ESHandle<TrackerGeometry> tracker;
+  es.get<TrackerDigiGeometryRecord>().get( tracker );
+  edm::ESHandle<CaloGeometry> calo;
+  es.get<CaloGeometryRecord>().get( calo );
+  edm::ESHandle<DTGeometry> dt;
+  es.get<MuonGeometryRecord>().get( dt );
+  edm::ESHandle<CSCGeometry> csc;
+  es.get<MuonGeometryRecord>().get( csc );
+  edm::ESHandle<RPCGeometry> rpc;
+  es.get<MuonGeometryRecord>().get( rpc );
+  edm::LogAbsolute( "RecoGeometryDump" ) << "Reco geometries built in "
+					  << std::chrono::duration<double>( std::chrono::steady_clock::now() - start ).count() << " s";
+
+  std::ofstream out( m_fileName );
+  dumpDets( out, "TRACKER", *tracker );
+  dumpCalo( out, *calo );
+  dumpDets( out, "DT", *dt );
+  dumpDets( out, "CSC", *csc );
+  dumpDets( out, "RPC", *rpc );
+  if( !out )
+    throw cms::Exception( "RecoGeometryDump" ) << "Could not write " << m_fileName;
+}
+
+DEFINE_FWK_MODULE( RecoGeometryDump );
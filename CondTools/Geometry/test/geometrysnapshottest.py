@@ -0,0 +1,65 @@
+import FWCore.ParameterSet.Config as cms
+from Configuration.AlCa.autoCond import autoCond
+import FWCore.ParameterSet.VarParsing as VarParsing
+
+# Builds the reco geometries from the XML geometry description, from the
+# conditions database or from a geometry snapshot and dumps them with
+# RecoGeometryDump, to compare the sources (see validateGeometrySnapshot.sh)
+
+options = VarParsing.VarParsing()
+options.register('source',
+                 'snapshot',
+                 VarParsing.VarParsing.multiplicity.singleton,
+                 VarParsing.VarParsing.varType.string,
+                 "Source of the geometry: xml, db or snapshot")
+options.register('xmlGeometry',
+                 'Configuration.Geometry.GeometryExtended2018Reco_cff',
+                 VarParsing.VarParsing.multiplicity.singleton,
+                 VarParsing.VarParsing.varType.string,
+                 "Reco geometry configuration used with source=xml")
+options.register('globalTag',
+                 'run2_mc',
+                 VarParsing.VarParsing.multiplicity.singleton,
+                 VarParsing.VarParsing.varType.string,
+                 "Global tag, or key of autoCond, used with source=db")
+options.register('snapshot',
+                 'geometry.snapshot',
+                 VarParsing.VarParsing.multiplicity.singleton,
+                 VarParsing.VarParsing.varType.string,
+                 "Geometry snapshot used with source=snapshot")
+options.register('dumpFile',
+                 'geometry.dump',
+                 VarParsing.VarParsing.multiplicity.singleton,
+                 VarParsing.VarParsing.varType.string,
+                 "Output of RecoGeometryDump")
+options.parseArguments()
+
+process = cms.Process("GeometrySnapshotTest")
+
+if options.source == 'xml':
+    process.load(options.xmlGeometry)
+elif options.source == 'db':
+    process.load('Configuration.StandardSequences.GeometryDB_cff')
+    process.load('Configuration.StandardSequences.FrontierConditions_GlobalTag_cff')
+    process.GlobalTag.globaltag = autoCond.get(options.globalTag, options.globalTag)
+elif options.source == 'snapshot':
+    process.load('Configuration.Geometry.GeometryRecoDB_cff')
+    process.GeometrySnapshotESSource = cms.ESSource("GeometrySnapshotESSource",
+                                                    fileName = cms.untracked.string(options.snapshot)
+                                                    )
+else:
+    raise ValueError("unknown geometry source " + options.source)
+
+process.source = cms.Source("EmptySource")
+
+process.MessageLogger = cms.Service("MessageLogger")
+
+process.RecoGeometryDump = cms.EDAnalyzer("RecoGeometryDump",
+                                          fileName = cms.untracked.string(options.dumpFile)
+                                          )
+
+process.maxEvents = cms.untracked.PSet(
+    input = cms.untracked.int32(1)
+    )
+
+process.p1 = cms.Path(process.RecoGeometryDump)
@@ -0,0 +1,50 @@
+import FWCore.ParameterSet.Config as cms
+from Configuration.AlCa.autoCond import autoCond
+import FWCore.ParameterSet.VarParsing as VarParsing
+
+# Writes the reco geometry payloads of a global tag (or, with toGet, of the
+# sqlite file written by geometrywriter.py) to a geometry snapshot file
+
+options = VarParsing.VarParsing()
+options.register('globalTag',
+                 'run2_mc',
+                 VarParsing.VarParsing.multiplicity.singleton,
+                 VarParsing.VarParsing.varType.string,
+                 "Global tag, or key of autoCond")
+options.register('fileName',
+                 'geometry.snapshot',
+                 VarParsing.VarParsing.multiplicity.singleton,
+                 VarParsing.VarParsing.varType.string,
+                 "Geometry snapshot to write")
+options.parseArguments()
+
+process = cms.Process("GeometrySnapshotWriter")
+process.load('Configuration.StandardSequences.FrontierConditions_GlobalTag_cff')
+process.GlobalTag.globaltag = autoCond.get(options.globalTag, options.globalTag)
+
+process.source = cms.Source("EmptyIOVSource",
+                            lastValue = cms.uint64(1),
+                            timetype = cms.string('runnumber'),
+                            firstValue = cms.uint64(1),
+                            interval = cms.uint64(1)
+                            )
+
+process.MessageLogger = cms.Service("MessageLogger",
+                                    destinations = cms.untracked.vstring('cout'),
+                                    categories = cms.untracked.vstring('GeometrySnapshotWriter'),
+                                    cout = cms.untracked.PSet(threshold = cms.untracked.string('INFO'),
+                                                              INFO = cms.untracked.PSet(limit = cms.untracked.int32(0)),
+                                                              GeometrySnapshotWriter = cms.untracked.PSet(limit = cms.untracked.int32(-1))
+                                                              )
+                                    )
+
+process.GeometrySnapshotWriter = cms.EDAnalyzer("GeometrySnapshotWriter",
+                                                fileName = cms.untracked.string(options.fileName),
+                                                label = cms.untracked.string(process.GlobalTag.globaltag.value())
+                                                )
+
+process.maxEvents = cms.untracked.PSet(
+    input = cms.untracked.int32(1)
+    )
+
+process.p1 = cms.Path(process.GeometrySnapshotWriter)
@@ -0,0 +1,17 @@
+#!/bin/bash
+
+# Compares the reco geometries built from the XML geometry description and
+# from a geometry snapshot written from the global tag of the same geometry.
+# Usage: validateGeometrySnapshot.sh [globalTag] [xmlGeometry]
+
+function die { echo $1: status $2 ; exit $2; }
+
+GT=${1:-run2_mc}
+XML=${2:-Configuration.Geometry.GeometryExtended2018Reco_cff}
+TEST_DIR=${CMSSW_BASE}/src/CondTools/Geometry/test
+
+cmsRun ${TEST_DIR}/geometrysnapshotwriter.py globalTag=${GT} fileName=geometry.snapshot || die "snapshot writer" $?
+( time cmsRun ${TEST_DIR}/geometrysnapshottest.py source=xml xmlGeometry=${XML} dumpFile=geometry_xml.dump ) || die "xml geometry" $?
+( time cmsRun ${TEST_DIR}/geometrysnapshottest.py source=snapshot snapshot=geometry.snapshot dumpFile=geometry_snapshot.dump ) || die "snapshot geometry" $?
+diff -q geometry_xml.dump geometry_snapshot.dump || die "the geometries differ, see diff geometry_xml.dump geometry_snapshot.dump" 1
+echo "the geometries are identical"
@@ -0,0 +1,112 @@
+#ifndef DataFormats_DetId_DetIdIndexMap_h
+#define DataFormats_DetId_DetIdIndexMap_h
+
+#include "DataFormats/DetId/interface/DetId.h"
+
+#include <cstdint>
+#include <vector>
+
+/** \class DetIdIndexMap
+
+Map from the raw DetIds of a geometry to dense indices (e.g. the position
+of the corresponding det in a vector), for the per-hit lookups done
+everywhere in the reconstruction. The map is a flat open-addressing hash
+table with linear probing, kept at most half full: a lookup is a multiply,
+a shift and (on average) less than two contiguous 8-byte reads, without
+the node allocations and pointer chasing of a std::unordered_map.
+
+The null DetId cannot be inserted; the first index inserted for a DetId
+is kept.
+*/
+class DetIdIndexMap {
+public:
+  static constexpr uint32_t invalidIndex = ~uint32_t(0);
+
+  DetIdIndexMap() : shift_(32), size_(0) {}
+
+  /// add (id, index); returns false if the id is null or already in the map
+  bool insert(DetId id, uint32_t index) {
+    if (id.rawId() == 0)
+      return false;
+    if (2 * (size_ + 1) > table_.size())
+      rehash(table_.empty() ? 64 : 2 * table_.size());
+    Entry& entry = table_[probe(id.rawId())];
+    if (entry.rawId == id.rawId())
+      return false;
+    entry.rawId = id.rawId();
+    entry.index = index;
+    ++size_;
+    return true;
+  }
+
+  /// index of id, or invalidIndex if not in the map
+  uint32_t find(DetId id) const {
+    if (size_ == 0)
+      return invalidIndex;
+    return table_[probe(id.rawId())].index;
+  }
+
+  /// indices of the ids in [first, last), stored from out on
+  void find(const DetId* first, const DetId* last, uint32_t* out) const {
+    for (; first != last; ++first, ++out)
+      *out = find(*first);
+  }
+
+  bool contains(DetId id) const { return find(id) != invalidIndex; }
+
+  size_t size() const { return size_; }
+  bool empty() const { return size_ == 0; }
+
+  void clear() {
+    table_.clear();
+    table_.shrink_to_fit();
+    shift_ = 32;
+    size_ = 0;
+  }
+
+  /// release the memory not needed by the current number of entries
+  void shrink_to_fit() {
+    size_t capacity = 64;
+    while (capacity < 2 * size_)
+      capacity *= 2;
+    if (capacity < table_.size())
+      rehash(capacity);
+  }
+
+private:
+  struct Entry {
+    uint32_t rawId = 0;
+    uint32_t index = invalidIndex;
+  };
+
+  // Fibonacci hashing: the upper bits of the product depend on all the bits
+  // of the id, which are filled from the top by the subdetector fields
+  uint32_t slot(uint32_t rawId) const { return uint32_t(rawId * 2654435769u) >> shift_; }
+
+  // slot holding rawId, or the empty slot where it would be inserted
+  size_t probe(uint32_t rawId) const {
+    const size_t mask = table_.size() - 1;
+    size_t i = slot(rawId);
+    while (table_[i].rawId != rawId && table_[i].rawId != 0)
+      i = (i + 1) & mask;
+    return i;
+  }
+
+  void rehash(size_t capacity) {
+    std::vector<Entry> old;
+    old.swap(table_);
+    table_.resize(capacity);
+    shift_ = 32;
+    for (size_t c = capacity; c > 1; c /= 2)
+      --shift_;
+    for (auto const& entry : old)
+      if (entry.rawId != 0)
+        table_[probe(entry.rawId)] = entry;
+  }
+
+  std::vector<Entry> table_;
+  uint32_t shift_;
+  size_t size_;
+};
+
+#endif
@@ -0,0 +1,81 @@
+// Checks DetIdIndexMap against std::unordered_map and compares their lookup
+// throughput, on ids laid out as the tracker ones (detector, subdetector and
+// hierarchical fields packed from the top bits)
+#include "DataFormats/DetId/interface/DetIdIndexMap.h"
+
+#include <algorithm>
+#include <cassert>
+#include <chrono>
+#include <iostream>
+#include <random>
+#include <unordered_map>
+#include <vector>
+
+namespace {
+  std::vector<DetId> trackerLikeIds() {
+    std::vector<DetId> ids;
+    for (uint32_t subdet = 1; subdet <= 6; ++subdet)
+      for (uint32_t layer = 1; layer <= 10; ++layer)
+        for (uint32_t ladder = 1; ladder <= 20; ++ladder)
+          for (uint32_t module = 1; module <= 14; ++module)
+            ids.emplace_back((uint32_t(DetId::Tracker) << DetId::kDetOffset) | (subdet << DetId::kSubdetOffset) |
+                             (layer << 20) | (ladder << 12) | (module << 2) | (module % 3));
+    return ids;
+  }
+
+  template <typename F>
+  double time(F f) {
+    auto start = std::chrono::steady_clock::now();
+    f();
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+  }
+}  // namespace
+
+int main() {
+  std::vector<DetId> ids = trackerLikeIds();
+  DetIdIndexMap index;
+  std::unordered_map<unsigned int, unsigned int> map;
+  for (unsigned int i = 0; i < ids.size(); ++i) {
+    bool inserted = index.insert(ids[i], i);
+    assert(inserted);
+    map.emplace(ids[i].rawId(), i);
+  }
+  assert(!index.insert(ids[0], 42));
+  assert(!index.insert(DetId(), 0));
+  assert(index.size() == ids.size());
+  index.shrink_to_fit();
+  for (unsigned int i = 0; i < ids.size(); ++i)
+    assert(index.find(ids[i]) == i);
+  assert(index.find(DetId()) == DetIdIndexMap::invalidIndex);
+  assert(index.find(DetId(ids.back().rawId() + 1)) == DetIdIndexMap::invalidIndex);
+
+  // hits in random modules
+  std::mt19937 rng(1234);
+  std::uniform_int_distribution<unsigned int> pick(0, ids.size() - 1);
+  std::vector<DetId> lookups(4000000);
+  for (auto& id : lookups)
+    id = ids[pick(rng)];
+  std::vector<uint32_t> results(lookups.size());
+
+  unsigned long long sumMap = 0, sumIndex = 0, sumBulk = 0;
+  double tMap = time([&] {
+    for (auto id : lookups)
+      sumMap += map.find(id.rawId())->second;
+  });
+  double tIndex = time([&] {
+    for (auto id : lookups)
+      sumIndex += index.find(id);
+  });
+  double tBulk = time([&] {
+    index.find(lookups.data(), lookups.data() + lookups.size(), results.data());
+    for (auto r : results)
+      sumBulk += r;
+  });
+  assert(sumMap == sumIndex && sumMap == sumBulk);
+
+  std::cout << ids.size() << " ids, " << lookups.size() << " lookups\n"
+            << "  std::unordered_map: " << 1e9 * tMap / lookups.size() << " ns per lookup\n"
+            << "  DetIdIndexMap:      " << 1e9 * tIndex / lookups.size() << " ns per lookup\n"
+            << "  DetIdIndexMap bulk: " << 1e9 * tBulk / lookups.size() << " ns per lookup" << std::endl;
+  return 0;
+}
@@ -8,6 +8,12 @@
  *  lenght of the data is a multiple of the S-Link64 word lenght (8 byte).
  *  The FED data should include the standard FED header and trailer.
  *
+ *  The data can also reference an external buffer, e.g. the input buffer
+ *  the event was read into, kept alive by a shared holder: copies of the
+ *  FEDRawData share the buffer, which is copied into an owned one only if
+ *  the data are modified (non-const data() or resize()). Only the owned
+ *  buffer is persistent, see FEDRawDataCollectionStreamer.
+ *
  *  \author G. Bruno - CERN, EP Division
  *  \author S. Argiro - CERN and INFN - 
  *                      Refactoring and Modifications to fit into CMSSW
@@ -16,6 +22,7 @@
 
 #include <vector>
 #include <cstddef>
+#include <memory>
 
 class FEDRawData {
 
@@ -31,9 +38,15 @@ class FEDRawData {
   /// word (8 bytes)
   FEDRawData(size_t newsize);
 
+  /// Ctor referencing newsize bytes at data, which must stay valid as long
+  /// as holder is alive. The size must be a multiple of 8 bytes.
+  FEDRawData(std::shared_ptr<const void> holder, const unsigned char * data, size_t newsize);
+
   /// Copy constructor
   FEDRawData(const FEDRawData &);
 
+  FEDRawData & operator=(const FEDRawData &) = default;
+
   /// Dtor
   ~FEDRawData();
 
@@ -41,20 +54,31 @@ class FEDRawData {
   const unsigned char * data() const;
 
   /// Return a pointer to the beginning of the data buffer
+  /// (referenced data are copied first)
   unsigned char * data();
 
   /// Lenght of the data buffer in bytes
-  size_t size() const {return data_.size();}
+  size_t size() const {return reference_ ? referenceSize_ : data_.size();}
     
   /// Resize to the specified size in bytes. It is required that 
   /// the size is a multiple of the size of a FED word (8 bytes)
   void resize(size_t newsize);
 
+  /// True if the data reference an external buffer
+  bool isReference() const {return bool(reference_);}
+
+  /// Copy referenced data into the owned buffer and release the reference
+  void ownData();
+
  private:
 
 
   Data data_;
 
+  // transient, shares the ownership of the external buffer
+  std::shared_ptr<const unsigned char> reference_;
+  size_t referenceSize_ = 0;
+
 };
 
 #endif
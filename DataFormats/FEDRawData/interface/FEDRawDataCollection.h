@@ -30,6 +30,12 @@ class FEDRawDataCollection : public edm::DoNotRecordParents {
 
   FEDRawDataCollection(const FEDRawDataCollection &);
 
+  /// true if the data of any FED reference an external buffer
+  bool hasReferences() const;
+
+  /// copy the referenced data of all FEDs into owned buffers
+  void ownData();
+
   void swap(FEDRawDataCollection & other) {
     data_.swap(other.data_);
   }
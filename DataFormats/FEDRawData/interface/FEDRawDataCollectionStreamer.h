@@ -0,0 +1,33 @@
+#ifndef FEDRawData_FEDRawDataCollectionStreamer_h
+#define FEDRawData_FEDRawDataCollectionStreamer_h
+
+/** \class FEDRawDataCollectionStreamer
+ *  ROOT streamer of FEDRawDataCollection: the FEDRawData referencing an
+ *  external buffer are written as owned data, so that the persistent
+ *  format does not depend on how the data were filled. Reading is the
+ *  default one.
+ *
+ *  It has to be installed (setFEDRawDataCollectionStreamerInTClass) by the
+ *  producers of referenced data before the first event is written.
+ */
+
+#include "TClassStreamer.h"
+#include "TClassRef.h"
+
+class TBuffer;
+
+class FEDRawDataCollectionStreamer : public TClassStreamer {
+ public:
+  explicit FEDRawDataCollectionStreamer() : cl_("FEDRawDataCollection") {}
+
+  void operator() (TBuffer &R__b, void *objp) override;
+
+  TClassStreamer* Generate() const override;
+
+ private:
+  TClassRef cl_;
+};
+
+void setFEDRawDataCollectionStreamerInTClass();
+
+#endif
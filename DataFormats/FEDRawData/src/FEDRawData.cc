@@ -19,19 +19,36 @@ FEDRawData::FEDRawData(size_t newsize):data_(newsize){
   if (newsize%8!=0) throw cms::Exception("DataCorrupt") << "FEDRawData::resize: " << newsize << " is not a multiple of 8 bytes." << endl;
 }
 
-FEDRawData::FEDRawData(const FEDRawData &in) : data_(in.data_)
+FEDRawData::FEDRawData(std::shared_ptr<const void> holder, const unsigned char * data, size_t newsize):
+  reference_(holder, data), referenceSize_(newsize) {
+  if (newsize%8!=0) throw cms::Exception("DataCorrupt") << "FEDRawData::FEDRawData: " << newsize << " is not a multiple of 8 bytes." << endl;
+}
+
+FEDRawData::FEDRawData(const FEDRawData &in) : data_(in.data_), reference_(in.reference_), referenceSize_(in.referenceSize_)
 {
 }
 FEDRawData::~FEDRawData()
 {
 }
-const unsigned char * FEDRawData::data()const {return &data_[0];}
+const unsigned char * FEDRawData::data()const {return reference_ ? reference_.get() : &data_[0];}
+
+unsigned char * FEDRawData::data() {
+  ownData();
+  return &data_[0];
+}
 
-unsigned char * FEDRawData::data() {return &data_[0];}
+void FEDRawData::ownData() {
+  if (!reference_) return;
+  data_.assign(reference_.get(), reference_.get() + referenceSize_);
+  reference_.reset();
+  referenceSize_ = 0;
+}
 
 void FEDRawData::resize(size_t newsize) {
   if (size()==newsize) return;
 
+  ownData();
+
   data_.resize(newsize);
 
   if (newsize%8!=0) throw cms::Exception("DataCorrupt") << "FEDRawData::resize: " << newsize << " is not a multiple of 8 bytes." << endl;
@@ -33,3 +33,18 @@ const FEDRawData&   FEDRawDataCollection::FEDData(int fedid) const {
 FEDRawData&   FEDRawDataCollection::FEDData(int fedid) {
   return data_[fedid];
 }
+
+
+bool FEDRawDataCollection::hasReferences() const {
+  for (const FEDRawData& fed : data_) {
+    if (fed.isReference()) return true;
+  }
+  return false;
+}
+
+
+void FEDRawDataCollection::ownData() {
+  for (FEDRawData& fed : data_) {
+    fed.ownData();
+  }
+}
@@ -0,0 +1,40 @@
+/** \file
+ *  implementation of FEDRawDataCollectionStreamer
+ */
+
+#include "DataFormats/FEDRawData/interface/FEDRawDataCollectionStreamer.h"
+#include "DataFormats/FEDRawData/interface/FEDRawDataCollection.h"
+
+#include "TBuffer.h"
+#include "TClass.h"
+
+#include <mutex>
+
+void FEDRawDataCollectionStreamer::operator()(TBuffer &R__b, void *objp) {
+  if (R__b.IsReading()) {
+    cl_->ReadBuffer(R__b, objp);
+    return;
+  }
+  const FEDRawDataCollection* collection = static_cast<const FEDRawDataCollection*>(objp);
+  if (!collection->hasReferences()) {
+    cl_->WriteBuffer(R__b, objp);
+    return;
+  }
+  FEDRawDataCollection owned(*collection);
+  owned.ownData();
+  cl_->WriteBuffer(R__b, &owned);
+}
+
+TClassStreamer* FEDRawDataCollectionStreamer::Generate() const {
+  return new FEDRawDataCollectionStreamer(*this);
+}
+
+void setFEDRawDataCollectionStreamerInTClass() {
+  static std::once_flag once;
+  std::call_once(once, []() {
+    TClass *cl = TClass::GetClass("FEDRawDataCollection");
+    if (cl->GetStreamer() == nullptr) {
+      cl->AdoptStreamer(new FEDRawDataCollectionStreamer());
+    }
+  });
+}
@@ -0,0 +1,128 @@
+/** \file
+ *
+ *  Modules for the FEDRawDataCollection write/read round trip:
+ *  ReferencedFEDRawDataProducer fills the FEDs with a known pattern, either
+ *  owned or referencing one shared buffer, and FEDRawDataRoundTripAnalyzer
+ *  checks the pattern of the collection read back.
+ */
+
+#include "FWCore/Framework/interface/MakerMacros.h"
+#include "FWCore/Framework/interface/global/EDProducer.h"
+#include "FWCore/Framework/interface/global/EDAnalyzer.h"
+#include "FWCore/Framework/interface/Event.h"
+#include "FWCore/ParameterSet/interface/ParameterSet.h"
+#include "FWCore/Utilities/interface/Exception.h"
+#include "DataFormats/FEDRawData/interface/FEDRawDataCollection.h"
+#include "DataFormats/FEDRawData/interface/FEDRawDataCollectionStreamer.h"
+#include "DataFormats/FEDRawData/interface/FEDNumbering.h"
+
+#include <algorithm>
+#include <memory>
+#include <vector>
+
+namespace test {
+
+  namespace {
+    // size in bytes and content of the data of a FED in an event
+    size_t patternSize(unsigned int fed, unsigned long long event) {
+      return 8*(1 + (fed + event) % 64);
+    }
+
+    unsigned char patternByte(unsigned int fed, unsigned long long event, size_t i) {
+      return static_cast<unsigned char>(fed*31 + event*7 + i);
+    }
+  }
+
+  class ReferencedFEDRawDataProducer : public edm::global::EDProducer<> {
+  public:
+    explicit ReferencedFEDRawDataProducer(const edm::ParameterSet& pset) :
+      feds_(pset.getUntrackedParameter<std::vector<unsigned int> >("feds")),
+      reference_(pset.getUntrackedParameter<bool>("reference"))
+    {
+      if (reference_) setFEDRawDataCollectionStreamerInTClass();
+      produces<FEDRawDataCollection>();
+    }
+
+    void produce(edm::StreamID, edm::Event& e, const edm::EventSetup&) const override {
+      const unsigned long long event = e.id().event();
+      auto collection = std::make_unique<FEDRawDataCollection>();
+
+      // all the FEDs of the event in one buffer, as in an input chunk
+      size_t total = 0;
+      for (auto fed : feds_) total += patternSize(fed, event);
+      auto buffer = std::make_shared<std::vector<unsigned char> >(total);
+
+      size_t offset = 0;
+      for (auto fed : feds_) {
+        const size_t size = patternSize(fed, event);
+        unsigned char* data = buffer->data() + offset;
+        for (size_t i = 0; i < size; ++i) data[i] = patternByte(fed, event, i);
+        if (reference_) {
+          collection->FEDData(fed) = FEDRawData(buffer, data, size);
+        } else {
+          FEDRawData& owned = collection->FEDData(fed);
+          owned.resize(size);
+          std::copy(data, data + size, owned.data());
+        }
+        offset += size;
+      }
+
+      if (reference_ && !feds_.empty() && !collection->hasReferences())
+        throw cms::Exception("FEDRawDataRoundTrip") << "the produced FEDRawData do not reference the buffer";
+
+      e.put(std::move(collection));
+    }
+
+  private:
+    const std::vector<unsigned int> feds_;
+    const bool reference_;
+  };
+
+  class FEDRawDataRoundTripAnalyzer : public edm::global::EDAnalyzer<> {
+  public:
+    explicit FEDRawDataRoundTripAnalyzer(const edm::ParameterSet& pset) :
+      feds_(pset.getUntrackedParameter<std::vector<unsigned int> >("feds")),
+      token_(consumes<FEDRawDataCollection>(pset.getUntrackedParameter<edm::InputTag>("src")))
+    {}
+
+    void analyze(edm::StreamID, const edm::Event& e, const edm::EventSetup&) const override {
+      const unsigned long long event = e.id().event();
+      edm::Handle<FEDRawDataCollection> collection;
+      e.getByToken(token_, collection);
+
+      if (collection->hasReferences())
+        throw cms::Exception("FEDRawDataRoundTrip") << "FEDRawData read back still reference a buffer";
+
+      std::vector<bool> expected(FEDNumbering::lastFEDId() + 1, false);
+      for (auto fed : feds_) expected[fed] = true;
+
+      for (int fed = 0; fed <= FEDNumbering::lastFEDId(); ++fed) {
+        const FEDRawData& data = collection->FEDData(fed);
+        if (!expected[fed]) {
+          if (data.size() != 0)
+            throw cms::Exception("FEDRawDataRoundTrip") << "event " << event << ": unexpected data in FED " << fed;
+          continue;
+        }
+        const size_t size = patternSize(fed, event);
+        if (data.size() != size)
+          throw cms::Exception("FEDRawDataRoundTrip") << "event " << event << " FED " << fed
+                                                      << ": size " << data.size() << ", expected " << size;
+        for (size_t i = 0; i < size; ++i) {
+          if (data.data()[i] != patternByte(fed, event, i))
+            throw cms::Exception("FEDRawDataRoundTrip") << "event " << event << " FED " << fed
+                                                        << ": wrong content at byte " << i;
+        }
+      }
+    }
+
+  private:
+    const std::vector<unsigned int> feds_;
+    const edm::EDGetTokenT<FEDRawDataCollection> token_;
+  };
+
+}
+
+using test::ReferencedFEDRawDataProducer;
+using test::FEDRawDataRoundTripAnalyzer;
+DEFINE_FWK_MODULE(ReferencedFEDRawDataProducer);
+DEFINE_FWK_MODULE(FEDRawDataRoundTripAnalyzer);
@@ -0,0 +1,21 @@
+# Reads back the file of FEDRawDataRoundTrip_write_cfg.py and checks the
+# content of every FED.
+import FWCore.ParameterSet.Config as cms
+from FWCore.ParameterSet.VarParsing import VarParsing
+
+options = VarParsing('analysis')
+options.inputFiles = 'file:FEDRawDataRoundTrip.root'
+options.parseArguments()
+
+process = cms.Process("READ")
+
+process.source = cms.Source("PoolSource",
+    fileNames = cms.untracked.vstring(options.inputFiles)
+)
+
+process.check = cms.EDAnalyzer("FEDRawDataRoundTripAnalyzer",
+    feds = cms.untracked.vuint32(0, 1, 2, 600, 601, 1023, 1024, 1353),
+    src = cms.untracked.InputTag("rawDataCollector")
+)
+
+process.p = cms.Path(process.check)
@@ -0,0 +1,30 @@
+# Writes FEDRawDataCollections with a known pattern through PoolOutputModule.
+# With reference=True the FEDRawData reference one shared buffer per event,
+# as FedRawDataInputSource does with zeroCopyFEDRawData.
+import FWCore.ParameterSet.Config as cms
+from FWCore.ParameterSet.VarParsing import VarParsing
+
+options = VarParsing('analysis')
+options.register('reference', True, VarParsing.multiplicity.singleton, VarParsing.varType.bool,
+                 "reference a shared buffer instead of owning the data")
+options.outputFile = 'FEDRawDataRoundTrip.root'
+options.maxEvents = 20
+options.parseArguments()
+
+process = cms.Process("WRITE")
+
+process.source = cms.Source("EmptySource")
+process.maxEvents = cms.untracked.PSet(input = cms.untracked.int32(options.maxEvents))
+
+process.rawDataCollector = cms.EDProducer("ReferencedFEDRawDataProducer",
+    feds = cms.untracked.vuint32(0, 1, 2, 600, 601, 1023, 1024, 1353),
+    reference = cms.untracked.bool(options.reference)
+)
+
+process.out = cms.OutputModule("PoolOutputModule",
+    fileName = cms.untracked.string(options.outputFile),
+    outputCommands = cms.untracked.vstring('drop *', 'keep FEDRawDataCollection_*_*_*')
+)
+
+process.p = cms.Path(process.rawDataCollector)
+process.e = cms.EndPath(process.out)
@@ -8,8 +8,10 @@
 
 #include <cppunit/extensions/HelperMacros.h>
 #include <DataFormats/FEDRawData/interface/FEDRawData.h>
+#include <FWCore/Utilities/interface/Exception.h>
 
 #include <iostream>
+#include <memory>
 
 class testFEDRawData: public CppUnit::TestFixture {
 
@@ -17,6 +19,7 @@ class testFEDRawData: public CppUnit::TestFixture {
 
   CPPUNIT_TEST(testCtor);
   CPPUNIT_TEST(testdata);
+  CPPUNIT_TEST(testReference);
  
   CPPUNIT_TEST_SUITE_END();
 
@@ -27,6 +30,7 @@ public:
   void tearDown(){}  
   void testCtor();
   void testdata(); 
+  void testReference();
  
 }; 
 
@@ -56,5 +60,40 @@ void testFEDRawData::testdata(){
   CPPUNIT_ASSERT(buf[47] == 'c');
 }
 
+void testFEDRawData::testReference(){
+  std::shared_ptr<unsigned char> buffer(new unsigned char[64], std::default_delete<unsigned char[]>());
+  for (int i=0; i<64; ++i) buffer.get()[i] = i;
+  std::weak_ptr<unsigned char> alive(buffer);
+
+  FEDRawData f(buffer, buffer.get()+16, 32);
+  CPPUNIT_ASSERT(f.isReference());
+  CPPUNIT_ASSERT(f.size()==size_t(32));
+  const FEDRawData& cf = f;
+  CPPUNIT_ASSERT(cf.data()==buffer.get()+16);
+
+  // copies share the buffer, which lives as long as any of them
+  FEDRawData f2(f);
+  CPPUNIT_ASSERT(f2.isReference());
+  buffer.reset();
+  CPPUNIT_ASSERT(!alive.expired());
+  CPPUNIT_ASSERT(cf.data()[0]==16);
+
+  // writing copies the data
+  f.data()[0] = 'a';
+  CPPUNIT_ASSERT(!f.isReference());
+  CPPUNIT_ASSERT(f.size()==size_t(32));
+  CPPUNIT_ASSERT(cf.data()[0]=='a');
+  CPPUNIT_ASSERT(cf.data()[31]==47);
+  const FEDRawData& cf2 = f2;
+  CPPUNIT_ASSERT(cf2.data()[0]==16);
+
+  f2.resize(48);
+  CPPUNIT_ASSERT(!f2.isReference());
+  CPPUNIT_ASSERT(f2.size()==size_t(48));
+  CPPUNIT_ASSERT(cf2.data()[31]==47);
+  CPPUNIT_ASSERT(alive.expired());
+
+  CPPUNIT_ASSERT_THROW(FEDRawData(alive.lock(), nullptr, 12), cms::Exception);
+}
 
 #include <Utilities/Testing/interface/CppUnit_testdriver.icpp>
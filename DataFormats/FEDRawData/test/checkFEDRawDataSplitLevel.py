@@ -0,0 +1,25 @@
+#!/usr/bin/env python
+# Compares the FEDRawDataCollection branches of two files: the split level
+# and the list of sub-branches must be the same.
+import sys
+import ROOT
+
+def branches(fileName):
+    f = ROOT.TFile.Open(fileName)
+    tree = f.Get("Events")
+    result = {}
+    for b in tree.GetListOfBranches():
+        if b.GetName().startswith("FEDRawDataCollection_"):
+            result[b.GetName()] = (b.GetSplitLevel(), sorted(s.GetName() for s in b.GetListOfBranches()))
+    f.Close()
+    return result
+
+reference, owned = branches(sys.argv[1]), branches(sys.argv[2])
+if not owned:
+    print("no FEDRawDataCollection branch in %s" % sys.argv[2])
+    sys.exit(1)
+if reference != owned:
+    print("FEDRawDataCollection branches differ:\n  %s: %s\n  %s: %s" % (sys.argv[1], reference, sys.argv[2], owned))
+    sys.exit(1)
+for name, (split, sub) in sorted(owned.items()):
+    print("%s: split level %d, %d sub-branches" % (name, split, len(sub)))
@@ -0,0 +1,9 @@
+#!/bin/sh
+
+function die { echo $1: status $2 ;  exit $2; }
+
+cmsRun ${LOCAL_TEST_DIR}/FEDRawDataRoundTrip_write_cfg.py reference=True outputFile=FEDRawDataRoundTrip_reference.root || die 'Failed writing referenced FEDRawData' $?
+cmsRun ${LOCAL_TEST_DIR}/FEDRawDataRoundTrip_write_cfg.py reference=False outputFile=FEDRawDataRoundTrip_owned.root || die 'Failed writing owned FEDRawData' $?
+cmsRun ${LOCAL_TEST_DIR}/FEDRawDataRoundTrip_read_cfg.py inputFiles=file:FEDRawDataRoundTrip_reference.root || die 'Failed reading referenced FEDRawData' $?
+cmsRun ${LOCAL_TEST_DIR}/FEDRawDataRoundTrip_read_cfg.py inputFiles=file:FEDRawDataRoundTrip_owned.root || die 'Failed reading owned FEDRawData' $?
+python ${LOCAL_TEST_DIR}/checkFEDRawDataSplitLevel.py FEDRawDataRoundTrip_reference.root FEDRawDataRoundTrip_owned.root || die 'FEDRawDataCollection branch layout changed' $?
@@ -6,6 +6,7 @@
 #include "Geometry/Records/interface/IdealGeometryRecord.h"
 #include "DD4hep/Detector.h"
 
+#include <chrono>
 #include <memory>
 #include <string>
 
@@ -43,7 +44,10 @@ DDCMSDetector::analyze( const edm::Event&, const edm::EventSetup& )
   std::string name( "DD4hep_CompactLoader" );
 
   const char* files[] = { m_confGeomXMLFiles.c_str(), nullptr };
+  auto start = std::chrono::steady_clock::now();
   description.apply( name.c_str(), 2, (char**)files );
+  std::cout << "Geometry built in "
+	    << std::chrono::duration<double>( std::chrono::steady_clock::now() - start ).count() << " s\n";
 
   for( const auto& it : m_files )
     std::cout << it << std::endl;
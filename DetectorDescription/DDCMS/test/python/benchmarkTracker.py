@@ -0,0 +1,32 @@
+import FWCore.ParameterSet.Config as cms
+import FWCore.ParameterSet.VarParsing as VarParsing
+
+# Startup benchmark of the DD4hep geometry construction:
+#   cmsRun benchmarkTracker.py confGeomXMLFiles=DetectorDescription/DDCMS/data/cms-tracker.xml
+# DDCMSDetector prints the time to build the geometry
+
+options = VarParsing.VarParsing()
+options.register('confGeomXMLFiles',
+                 'DetectorDescription/DDCMS/data/cms-tracker.xml',
+                 VarParsing.VarParsing.multiplicity.singleton,
+                 VarParsing.VarParsing.varType.string,
+                 "DD4hep geometry description")
+options.parseArguments()
+
+process = cms.Process("DDCMSBenchmark")
+
+process.source = cms.Source("EmptySource")
+process.maxEvents = cms.untracked.PSet(
+    input = cms.untracked.int32(1)
+    )
+
+process.Timing = cms.Service("Timing",
+                             summaryOnly = cms.untracked.bool(True)
+                             )
+
+process.test = cms.EDAnalyzer("DDCMSDetector",
+                              geomXMLFiles = cms.vstring(),
+                              confGeomXMLFiles = cms.string(options.confGeomXMLFiles)
+                              )
+
+process.p = cms.Path(process.test)
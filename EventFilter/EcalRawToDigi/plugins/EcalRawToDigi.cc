@@ -12,6 +12,8 @@
 #include "CondFormats/EcalObjects/interface/EcalChannelStatus.h"
 #include "CondFormats/DataRecord/interface/EcalChannelStatusRcd.h"
 
+#include <algorithm>
+
 #include "FWCore/ParameterSet/interface/ConfigurationDescriptions.h"
 #include "FWCore/ParameterSet/interface/ParameterSetDescription.h"
 
@@ -65,9 +67,8 @@ EcalRawToDigi::EcalRawToDigi(edm::ParameterSet const& conf):
 
 
 
-  myMap_(nullptr),
-  
-  theUnpacker_(nullptr)
+  // number of blocks of FEDs unpacked concurrently
+  numberOfUnpackers_(std::max(1u, conf.getUntrackedParameter<unsigned int>("numberOfParallelUnpackers",1)))
 
 {
   
@@ -160,14 +161,25 @@ EcalRawToDigi::EcalRawToDigi(edm::ParameterSet const& conf):
       fedsToken_=consumes<EcalListOfFEDS>(fedsLabel);
   }
 
+  // Build the electronics mappers and the DCC data unpackers, one for each
+  // block of FEDs that can be unpacked concurrently
+  fedUnpacker_ = std::make_unique<evf::ParallelFEDUnpacker<Fragment> >(numberOfUnpackers_, [this]() { return makeFragment(); });
+   
+}
+
+
+std::unique_ptr<EcalRawToDigi::Fragment> EcalRawToDigi::makeFragment() const
+{
+  auto fragment = std::make_unique<Fragment>();
+
   // Build a new Electronics mapper and parse default map file
-  myMap_ = new EcalElectronicsMapper(numbXtalTSamples_,numbTriggerTSamples_);
+  fragment->mapper = std::make_unique<EcalElectronicsMapper>(numbXtalTSamples_,numbTriggerTSamples_);
 
   // in case of external  tsext file (deprecated by HLT environment) 
   //  bool readResult = myMap_->readDCCMapFile(conf.getParameter<std::string>("DCCMapFile",""));
 
   // use two arrays from cfg to establish DCCId:FedId. If they are empy, than use hard coded correspondence 
-  bool readResult = myMap_->makeMapFromVectors(orderedFedUnpackList_, orderedDCCIdList_);
+  bool readResult = fragment->mapper->makeMapFromVectors(orderedFedUnpackList_, orderedDCCIdList_);
   // myMap::makeMapFromVectors() returns "true" always
   // need to be fixed?
 
@@ -179,9 +191,89 @@ EcalRawToDigi::EcalRawToDigi(edm::ParameterSet const& conf):
     //   <<conf.getParameter<std::string>("DCCMapFile");
   }
   
-  // Build a new ECAL DCC data unpacker
-  theUnpacker_ = new DCCDataUnpacker(myMap_,headerUnpacking_,srpUnpacking_,tccUnpacking_,feUnpacking_,memUnpacking_,syncCheck_,feIdCheck_,forceToKeepFRdata_);
-   
+  // Build a new ECAL DCC data unpacker, filling the collections of the fragment
+  fragment->unpacker = std::make_unique<DCCDataUnpacker>(fragment->mapper.get(),headerUnpacking_,srpUnpacking_,tccUnpacking_,feUnpacking_,memUnpacking_,syncCheck_,feIdCheck_,forceToKeepFRdata_);
+  fragment->clear();
+  fragment->unpacker->setEBDigisCollection(&fragment->digisEB);
+  fragment->unpacker->setEEDigisCollection(&fragment->digisEE);
+  fragment->unpacker->setDccHeadersCollection(&fragment->dccHeaders);
+  fragment->unpacker->setInvalidGainsCollection(&fragment->invalidGains);
+  fragment->unpacker->setInvalidGainsSwitchCollection(&fragment->invalidGainsSwitch);
+  fragment->unpacker->setInvalidChIdsCollection(&fragment->invalidChIds);
+  fragment->unpacker->setInvalidEEGainsCollection(&fragment->invalidEEGains);
+  fragment->unpacker->setInvalidEEGainsSwitchCollection(&fragment->invalidEEGainsSwitch);
+  fragment->unpacker->setInvalidEEChIdsCollection(&fragment->invalidEEChIds);
+  fragment->unpacker->setEBSrFlagsCollection(&fragment->ebSrFlags);
+  fragment->unpacker->setEESrFlagsCollection(&fragment->eeSrFlags);
+  fragment->unpacker->setEcalTpsCollection(&fragment->ecalTps);
+  fragment->unpacker->setEcalPSsCollection(&fragment->ecalPSs);
+  fragment->unpacker->setInvalidTTIdsCollection(&fragment->invalidTTIds);
+  fragment->unpacker->setInvalidZSXtalIdsCollection(&fragment->invalidZSXtalIds);
+  fragment->unpacker->setInvalidBlockLengthsCollection(&fragment->invalidBlockLengths);
+  fragment->unpacker->setPnDiodeDigisCollection(&fragment->pnDiodeDigis);
+  fragment->unpacker->setInvalidMemTtIdsCollection(&fragment->invalidMemTtIds);
+  fragment->unpacker->setInvalidMemBlockSizesCollection(&fragment->invalidMemBlockSizes);
+  fragment->unpacker->setInvalidMemChIdsCollection(&fragment->invalidMemChIds);
+  fragment->unpacker->setInvalidMemGainsCollection(&fragment->invalidMemGains);
+
+  return fragment;
+}
+
+
+void EcalRawToDigi::Fragment::clear()
+{
+  digisEB = std::make_unique<EBDigiCollection>();
+  digisEE = std::make_unique<EEDigiCollection>();
+  dccHeaders = std::make_unique<EcalRawDataCollection>();
+  invalidGains = std::make_unique<EBDetIdCollection>();
+  invalidGainsSwitch = std::make_unique<EBDetIdCollection>();
+  invalidChIds = std::make_unique<EBDetIdCollection>();
+  invalidEEGains = std::make_unique<EEDetIdCollection>();
+  invalidEEGainsSwitch = std::make_unique<EEDetIdCollection>();
+  invalidEEChIds = std::make_unique<EEDetIdCollection>();
+  ebSrFlags = std::make_unique<EBSrFlagCollection>();
+  eeSrFlags = std::make_unique<EESrFlagCollection>();
+  ecalTps = std::make_unique<EcalTrigPrimDigiCollection>();
+  ecalPSs = std::make_unique<EcalPSInputDigiCollection>();
+  invalidTTIds = std::make_unique<EcalElectronicsIdCollection>();
+  invalidZSXtalIds = std::make_unique<EcalElectronicsIdCollection>();
+  invalidBlockLengths = std::make_unique<EcalElectronicsIdCollection>();
+  pnDiodeDigis = std::make_unique<EcalPnDiodeDigiCollection>();
+  invalidMemTtIds = std::make_unique<EcalElectronicsIdCollection>();
+  invalidMemBlockSizes = std::make_unique<EcalElectronicsIdCollection>();
+  invalidMemChIds = std::make_unique<EcalElectronicsIdCollection>();
+  invalidMemGains = std::make_unique<EcalElectronicsIdCollection>();
+}
+
+
+namespace {
+
+  // append the collection of a fragment to the event product, taking it as
+  // it is if the product is still empty
+  template <typename T>
+  void mergeCollection(std::unique_ptr<T>& product, std::unique_ptr<T>& fragment)
+  {
+    if (product->empty()) {
+      std::swap(product, fragment);
+      return;
+    }
+    for (auto const& item : *fragment) product->push_back(item);
+  }
+
+  template <typename T>
+  void mergeDigis(std::unique_ptr<T>& product, std::unique_ptr<T>& fragment)
+  {
+    if (product->empty()) {
+      std::swap(product, fragment);
+      return;
+    }
+    product->reserve(product->size() + fragment->size());
+    for (size_t i = 0; i < fragment->size(); ++i) {
+      edm::DataFrame df = (*fragment)[i];
+      product->push_back(df.id(), df.begin());
+    }
+  }
+
 }
 
 
@@ -278,6 +370,7 @@ void EcalRawToDigi::fillDescriptions(edm::ConfigurationDescriptions& description
   desc.add<bool>("forceToKeepFRData",false);
   desc.add<bool>("headerUnpacking",true);
   desc.add<bool>("memUnpacking",true);
+  desc.addUntracked<unsigned int>("numberOfParallelUnpackers",1);
   descriptions.add("ecalRawToDigi",desc);
 }
 
@@ -287,13 +380,14 @@ void EcalRawToDigi::beginRun(const edm::Run&, const edm::EventSetup& es)
   // channel status database
   edm::ESHandle<EcalChannelStatusMap> pChStatus;
   es.get<EcalChannelStatusRcd>().get(pChStatus);
-  theUnpacker_->setChannelStatusDB(pChStatus.product());
+  for (unsigned int i=0; i<fedUnpacker_->numberOfFragments(); i++)
+    fedUnpacker_->fragment(i).unpacker->setChannelStatusDB(pChStatus.product());
   
   // uncomment following line to print list of crystals with bad status
   //edm::ESHandle<EcalElectronicsMapping> pEcalMapping;
   //es.get<EcalMappingRcd>().get(pEcalMapping);
   //const EcalElectronicsMapping* mapping = pEcalMapping.product();
-  //printStatusRecords(theUnpacker_, mapping);
+  //printStatusRecords(fedUnpacker_->fragment(0).unpacker.get(), mapping);
 }
 
 
@@ -308,7 +402,8 @@ void EcalRawToDigi::produce(edm::Event& e, const edm::EventSetup& es)
    watcher_.check(es);
    edm::ESHandle< EcalElectronicsMapping > ecalmapping;
    es.get< EcalMappingRcd >().get(ecalmapping);
-   myMap_ -> setEcalElectronicsMapping(ecalmapping.product());
+   for (unsigned int i=0; i<fedUnpacker_->numberOfFragments(); i++)
+     fedUnpacker_->fragment(i).mapper -> setEcalElectronicsMapping(ecalmapping.product());
    
    first_ = false;
 
@@ -317,9 +412,12 @@ void EcalRawToDigi::produce(edm::Event& e, const edm::EventSetup& es)
     if ( watcher_.check(es) ) {    
       edm::ESHandle< EcalElectronicsMapping > ecalmapping;
       es.get< EcalMappingRcd >().get(ecalmapping);
-      myMap_ -> deletePointers();
-      myMap_ -> resetPointers();
-      myMap_ -> setEcalElectronicsMapping(ecalmapping.product());
+      for (unsigned int i=0; i<fedUnpacker_->numberOfFragments(); i++) {
+        EcalElectronicsMapper* mapper = fedUnpacker_->fragment(i).mapper.get();
+        mapper -> deletePointers();
+        mapper -> resetPointers();
+        mapper -> setEcalElectronicsMapping(ecalmapping.product());
+      }
     }
 
   }
@@ -345,130 +443,141 @@ void EcalRawToDigi::produce(edm::Event& e, const edm::EventSetup& es)
   // create the collection of Ecal Digis
   auto productDigisEB = std::make_unique<EBDigiCollection>();
   productDigisEB->reserve(1700);
-  theUnpacker_->setEBDigisCollection(&productDigisEB);
   
   // create the collection of Ecal Digis
   auto productDigisEE = std::make_unique<EEDigiCollection>();
-  theUnpacker_->setEEDigisCollection(&productDigisEE);
   
   // create the collection for headers
   auto productDccHeaders = std::make_unique<EcalRawDataCollection>();
-  theUnpacker_->setDccHeadersCollection(&productDccHeaders); 
 
   // create the collection for invalid gains
   auto productInvalidGains = std::make_unique<EBDetIdCollection>();
-  theUnpacker_->setInvalidGainsCollection(&productInvalidGains); 
 
   // create the collection for invalid gain Switch
   auto productInvalidGainsSwitch = std::make_unique<EBDetIdCollection>();
-  theUnpacker_->setInvalidGainsSwitchCollection(&productInvalidGainsSwitch);
    
   // create the collection for invalid chids
   auto productInvalidChIds = std::make_unique<EBDetIdCollection>();
-  theUnpacker_->setInvalidChIdsCollection(&productInvalidChIds);
   
   ///////////////// make EEDetIdCollections for these ones
     
   // create the collection for invalid gains
   auto productInvalidEEGains = std::make_unique<EEDetIdCollection>();
-  theUnpacker_->setInvalidEEGainsCollection(&productInvalidEEGains); 
     
   // create the collection for invalid gain Switch
   auto productInvalidEEGainsSwitch = std::make_unique<EEDetIdCollection>();
-  theUnpacker_->setInvalidEEGainsSwitchCollection(&productInvalidEEGainsSwitch);
     
   // create the collection for invalid chids
   auto productInvalidEEChIds = std::make_unique<EEDetIdCollection>();
-  theUnpacker_->setInvalidEEChIdsCollection(&productInvalidEEChIds);
 
   ///////////////// make EEDetIdCollections for these ones    
 
   // create the collection for EB srflags       
   auto productEBSrFlags = std::make_unique<EBSrFlagCollection>();
-  theUnpacker_->setEBSrFlagsCollection(&productEBSrFlags);
   
   // create the collection for EB srflags       
   auto productEESrFlags = std::make_unique<EESrFlagCollection>();
-  theUnpacker_->setEESrFlagsCollection(&productEESrFlags);
 
   // create the collection for ecal trigger primitives
   auto productEcalTps = std::make_unique<EcalTrigPrimDigiCollection>();
-  theUnpacker_->setEcalTpsCollection(&productEcalTps);
   /////////////////////// collections for problems pertaining towers are already EE+EB communal
 
   // create the collection for ecal trigger primitives
   auto productEcalPSs = std::make_unique<EcalPSInputDigiCollection>();
-  theUnpacker_->setEcalPSsCollection(&productEcalPSs);
   /////////////////////// collections for problems pertaining towers are already EE+EB communal
 
   // create the collection for invalid TTIds
   auto productInvalidTTIds = std::make_unique<EcalElectronicsIdCollection>();
-  theUnpacker_->setInvalidTTIdsCollection(&productInvalidTTIds);
  
    // create the collection for invalid TTIds
   auto productInvalidZSXtalIds = std::make_unique<EcalElectronicsIdCollection>();
-  theUnpacker_->setInvalidZSXtalIdsCollection(&productInvalidZSXtalIds);
 
 
  
   // create the collection for invalid BlockLengths
   auto productInvalidBlockLengths = std::make_unique<EcalElectronicsIdCollection>();
-  theUnpacker_->setInvalidBlockLengthsCollection(&productInvalidBlockLengths);
 
   // MEMs Collections
   // create the collection for the Pn Diode Digis
   auto productPnDiodeDigis = std::make_unique<EcalPnDiodeDigiCollection>();
-  theUnpacker_->setPnDiodeDigisCollection(&productPnDiodeDigis);
 
   // create the collection for invalid Mem Tt id 
   auto productInvalidMemTtIds = std::make_unique<EcalElectronicsIdCollection>();
-  theUnpacker_->setInvalidMemTtIdsCollection(& productInvalidMemTtIds);
   
   // create the collection for invalid Mem Block Size 
   auto productInvalidMemBlockSizes = std::make_unique<EcalElectronicsIdCollection>();
-  theUnpacker_->setInvalidMemBlockSizesCollection(& productInvalidMemBlockSizes);
   
   // create the collection for invalid Mem Block Size 
   auto productInvalidMemChIds = std::make_unique<EcalElectronicsIdCollection>();
-  theUnpacker_->setInvalidMemChIdsCollection(& productInvalidMemChIds);
  
   // create the collection for invalid Mem Gain Errors 
   auto productInvalidMemGains = std::make_unique<EcalElectronicsIdCollection>();
-  theUnpacker_->setInvalidMemGainsCollection(& productInvalidMemGains); 
   //  double TIME_START = clock(); 
   
 
   // Step C: unpack all requested FEDs    
+  std::vector<int> feds;
+  feds.reserve(fedUnpackList_.size());
   for (std::vector<int>::const_iterator i=fedUnpackList_.begin(); i!=fedUnpackList_.end(); i++) {
 
     if (REGIONAL_) {
       std::vector<int>::const_iterator fed_it = find(FEDS_to_unpack.begin(), FEDS_to_unpack.end(), *i);
       if (fed_it == FEDS_to_unpack.end()) continue;
     }
+    feds.push_back(*i);
+  }
+
+  // the FEDs are unpacked in blocks, each one into its own fragment, and the
+  // fragments are appended to the products in the order of the FED list
+  auto unpackFED = [&rawdata](int fed, Fragment& fragment) {
 
-  
     // get fed raw data and SM id
-    const FEDRawData& fedData = rawdata->FEDData(*i);
+    const FEDRawData& fedData = rawdata->FEDData(fed);
     const size_t length = fedData.size();
 
     LogDebug("EcalRawToDigi") << "raw data length: " << length ;
     //if data size is not null interpret data
     if ( length >= EMPTYEVENTSIZE ){
       
-      if(myMap_->setActiveDCC(*i)){
+      if(fragment.mapper->setActiveDCC(fed)){
 
-        const int smId = myMap_->getActiveSM();
-        LogDebug("EcalRawToDigi") << "Getting FED = " << *i <<"(SM = "<<smId<<")"<<" data size is: " << length;
+        const int smId = fragment.mapper->getActiveSM();
+        LogDebug("EcalRawToDigi") << "Getting FED = " << fed <<"(SM = "<<smId<<")"<<" data size is: " << length;
 
         const uint64_t* data = (uint64_t*) fedData.data();
-        theUnpacker_->unpack(data, length, smId, *i);
+        fragment.unpacker->unpack(data, length, smId, fed);
 
-        LogDebug("EcalRawToDigi") <<" in EE :"<<productDigisEE->size()
-                                  <<" in EB :"<<productDigisEB->size();
+        LogDebug("EcalRawToDigi") <<" in EE :"<<fragment.digisEE->size()
+                                  <<" in EB :"<<fragment.digisEB->size();
       }
     }
-    
-  }// loop on FEDs
+  };
+
+  auto mergeFragment = [&](Fragment& fragment) {
+    mergeDigis(productDigisEB, fragment.digisEB);
+    mergeDigis(productDigisEE, fragment.digisEE);
+    mergeCollection(productDccHeaders, fragment.dccHeaders);
+    mergeCollection(productInvalidGains, fragment.invalidGains);
+    mergeCollection(productInvalidGainsSwitch, fragment.invalidGainsSwitch);
+    mergeCollection(productInvalidChIds, fragment.invalidChIds);
+    mergeCollection(productInvalidEEGains, fragment.invalidEEGains);
+    mergeCollection(productInvalidEEGainsSwitch, fragment.invalidEEGainsSwitch);
+    mergeCollection(productInvalidEEChIds, fragment.invalidEEChIds);
+    mergeCollection(productEBSrFlags, fragment.ebSrFlags);
+    mergeCollection(productEESrFlags, fragment.eeSrFlags);
+    mergeCollection(productEcalTps, fragment.ecalTps);
+    mergeCollection(productEcalPSs, fragment.ecalPSs);
+    mergeCollection(productInvalidTTIds, fragment.invalidTTIds);
+    mergeCollection(productInvalidZSXtalIds, fragment.invalidZSXtalIds);
+    mergeCollection(productInvalidBlockLengths, fragment.invalidBlockLengths);
+    mergeCollection(productPnDiodeDigis, fragment.pnDiodeDigis);
+    mergeCollection(productInvalidMemTtIds, fragment.invalidMemTtIds);
+    mergeCollection(productInvalidMemBlockSizes, fragment.invalidMemBlockSizes);
+    mergeCollection(productInvalidMemChIds, fragment.invalidMemChIds);
+    mergeCollection(productInvalidMemGains, fragment.invalidMemGains);
+  };
+
+  fedUnpacker_->run(feds, unpackFED, mergeFragment);
   
   //if(nevts_>1){   //NUNO
   //  double TIME_END = clock(); //NUNO
@@ -541,7 +650,6 @@ EcalRawToDigi::~EcalRawToDigi()
   
   
   
-  if(myMap_      ) delete myMap_;
-  if(theUnpacker_) delete theUnpacker_;
+  // the fragments own the mappers and the unpackers
   
 }
@@ -23,6 +23,7 @@
 #include <DataFormats/FEDRawData/interface/FEDRawDataCollection.h>
 #include <DataFormats/EcalDigi/interface/EcalDigiCollections.h>
 #include <DataFormats/EcalRawData/interface/EcalRawDataCollections.h>
+#include <DataFormats/EcalDetId/interface/EcalDetIdCollections.h>
 #include "Geometry/EcalMapping/interface/EcalMappingRcd.h"
 
 #include <DataFormats/Common/interface/Handle.h>
@@ -32,6 +33,8 @@
 #include <FWCore/ParameterSet/interface/ParameterSet.h>
 #include <FWCore/Framework/interface/ESWatcher.h>
 #include "DataFormats/EcalRawData/interface/EcalListOfFEDS.h"
+#include "EventFilter/Utilities/interface/ParallelFEDUnpacker.h"
+#include <memory>
 #include <sys/time.h>
 
 class EcalElectronicsMapper;
@@ -94,11 +97,45 @@ class EcalRawToDigi : public edm::stream::EDProducer<>{
   bool REGIONAL_ ;
     
 
-  //an electronics mapper class 
-  EcalElectronicsMapper * myMap_;
-  
-  //Ecal unpacker
-  DCCDataUnpacker * theUnpacker_;
+  // electronics mapper, unpacker and collections for a block of FEDs
+  struct Fragment {
+    //an electronics mapper class 
+    std::unique_ptr<EcalElectronicsMapper> mapper;
+    //Ecal unpacker
+    std::unique_ptr<DCCDataUnpacker> unpacker;
+
+    std::unique_ptr<EBDigiCollection> digisEB;
+    std::unique_ptr<EEDigiCollection> digisEE;
+    std::unique_ptr<EcalRawDataCollection> dccHeaders;
+    std::unique_ptr<EBDetIdCollection> invalidGains;
+    std::unique_ptr<EBDetIdCollection> invalidGainsSwitch;
+    std::unique_ptr<EBDetIdCollection> invalidChIds;
+    std::unique_ptr<EEDetIdCollection> invalidEEGains;
+    std::unique_ptr<EEDetIdCollection> invalidEEGainsSwitch;
+    std::unique_ptr<EEDetIdCollection> invalidEEChIds;
+    std::unique_ptr<EBSrFlagCollection> ebSrFlags;
+    std::unique_ptr<EESrFlagCollection> eeSrFlags;
+    std::unique_ptr<EcalTrigPrimDigiCollection> ecalTps;
+    std::unique_ptr<EcalPSInputDigiCollection> ecalPSs;
+    std::unique_ptr<EcalElectronicsIdCollection> invalidTTIds;
+    std::unique_ptr<EcalElectronicsIdCollection> invalidZSXtalIds;
+    std::unique_ptr<EcalElectronicsIdCollection> invalidBlockLengths;
+    std::unique_ptr<EcalPnDiodeDigiCollection> pnDiodeDigis;
+    std::unique_ptr<EcalElectronicsIdCollection> invalidMemTtIds;
+    std::unique_ptr<EcalElectronicsIdCollection> invalidMemBlockSizes;
+    std::unique_ptr<EcalElectronicsIdCollection> invalidMemChIds;
+    std::unique_ptr<EcalElectronicsIdCollection> invalidMemGains;
+
+    // new empty collections, the unpacker keeps pointing to them
+    void clear();
+  };
+
+  std::unique_ptr<Fragment> makeFragment() const;
+
+  // the FEDs are split in (at most) this number of blocks, unpacked concurrently
+  unsigned int numberOfUnpackers_;
+
+  std::unique_ptr<evf::ParallelFEDUnpacker<Fragment> > fedUnpacker_;
   
   unsigned int nevts_; // NA: for testing
   double  RUNNING_TIME_, SETUP_TIME_;
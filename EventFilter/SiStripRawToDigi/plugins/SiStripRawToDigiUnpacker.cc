@@ -38,6 +38,7 @@ namespace sistrip {
     extractCm_(false),
     doFullCorruptBufferChecks_(false),
     doAPVEmulatorCheck_(true),
+    parallelUnpacking_(false),
     errorThreshold_(errorThreshold),
     warnings_(sistrip::mlRawToDigi_, "[sistrip::RawToDigiUnpacker::createDigis]", edm::isDebugEnabled())
   {
@@ -124,455 +125,496 @@ namespace sistrip {
     // Flag for EventSummary update using DAQ register  
     bool first_fed = true;
   
-    // Retrieve FED ids from cabling map and iterate through 
-    std::vector<uint16_t>::const_iterator ifed = cabling.fedIds().begin();
-    for ( ; ifed != cabling.fedIds().end(); ifed++ ) {
+    // Unpack the FEDs from the cabling map into per-FED fragments, appended
+    // to the work vectors in the order of the cabling map. The FEDs can be
+    // unpacked concurrently unless the EventSummary is updated from the DAQ
+    // register of the first FED.
+    fedUnpacker_.run( cabling.fedIds(),
+                      [&]( uint16_t fed_id, FEDFragment& fragment ) { unpackFED( fed_id, cabling, buffers, summary, first_fed, fragment ); },
+                      [&]( FEDFragment& fragment ) { mergeFragment( fragment, detids ); },
+                      parallelUnpacking_ && !useDaqRegister_ );
 
-      // ignore trigger FED
-      if ( *ifed == triggerFedId_ ) { continue;  }
+    // bad channels warning
+    unsigned int detIdsSize = detids.size();
+    if ( edm::isDebugEnabled() && detIdsSize ) {
+      std::ostringstream ss;
+      ss << "[sistrip::RawToDigiUnpacker::" << __func__ << "]"
+         << " Problems were found in data and " << detIdsSize << " channels could not be unpacked. "
+         << "See output of FED Hardware monitoring for more information. ";
+      edm::LogWarning(sistrip::mlRawToDigi_) << ss.str();
+    }
+    if( (errorThreshold_ != 0) && (detIdsSize > errorThreshold_) ) {
+      edm::LogError("TooManyErrors") << "Total number of errors = " << detIdsSize;
+    }
+
+    // update DetSetVectors
+    update(scope_mode, virgin_raw, proc_raw, zero_suppr, cm_values);
+
+    // increment event counter
+    event_++;
+  
+    // no longer first event!
+    if ( first_ ) { first_ = false; }
+  
+    // final cleanup, just in case
+    cleanupWorkVectors();
+  }
+
+  void RawToDigiUnpacker::unpackFED( uint16_t fed_id, const SiStripFedCabling& cabling, const FEDRawDataCollection& buffers, SiStripEventSummary& summary, bool& first_fed, FEDFragment& fragment ) {
+
+    // ignore trigger FED
+    if ( fed_id == triggerFedId_ ) { return;  }
     
-      // Retrieve FED raw data for given FED 
-      const FEDRawData& input = buffers.FEDData( static_cast<int>(*ifed) );
+    // Retrieve FED raw data for given FED 
+    const FEDRawData& input = buffers.FEDData( static_cast<int>(fed_id) );
     
-      // Some debug on FED buffer size
-      if ( edm::isDebugEnabled() ) {
-	if ( first_ && input.data() ) {
-	  std::stringstream ss;
-	  ss << "[sistrip::RawToDigiUnpacker::" << __func__ << "]"
-	     << " Found FED id " 
-	     << std::setw(4) << std::setfill(' ') << *ifed 
-	     << " in FEDRawDataCollection"
-	     << " with non-zero pointer 0x" 
-	     << std::hex
-	     << std::setw(8) << std::setfill('0') 
-	     << reinterpret_cast<uint32_t*>( const_cast<uint8_t*>(input.data()))
-	     << std::dec
-	     << " and size " 
-	     << std::setw(5) << std::setfill(' ') << input.size()
-	     << " chars";
-	  LogTrace("SiStripRawToDigi") << ss.str();
-	}	
+    // Some debug on FED buffer size
+    if ( edm::isDebugEnabled() ) {
+      if ( first_ && input.data() ) {
+        std::stringstream ss;
+        ss << "[sistrip::RawToDigiUnpacker::" << __func__ << "]"
+           << " Found FED id " 
+           << std::setw(4) << std::setfill(' ') << fed_id 
+           << " in FEDRawDataCollection"
+           << " with non-zero pointer 0x" 
+           << std::hex
+           << std::setw(8) << std::setfill('0') 
+           << reinterpret_cast<uint32_t*>( const_cast<uint8_t*>(input.data()))
+           << std::dec
+           << " and size " 
+           << std::setw(5) << std::setfill(' ') << input.size()
+           << " chars";
+        LogTrace("SiStripRawToDigi") << ss.str();
+      }	
+    }
+    
+    // Dump of FEDRawData to stdout
+    if ( edm::isDebugEnabled() ) {
+      if ( fedBufferDumpFreq_ && !(event_%fedBufferDumpFreq_) ) {
+        std::stringstream ss;
+        dumpRawData( fed_id, input, ss );
+        edm::LogVerbatim(sistrip::mlRawToDigi_) << ss.str();
       }
+    }
     
-      // Dump of FEDRawData to stdout
-      if ( edm::isDebugEnabled() ) {
-	if ( fedBufferDumpFreq_ && !(event_%fedBufferDumpFreq_) ) {
-	  std::stringstream ss;
-	  dumpRawData( *ifed, input, ss );
-	  edm::LogVerbatim(sistrip::mlRawToDigi_) << ss.str();
-	}
+    // get the cabling connections for this FED
+    auto conns = cabling.fedConnections(fed_id);
+    
+    // Check on FEDRawData pointer
+    if ( !input.data() ) {
+      fragment.addWarning("NULL pointer to FEDRawData for FED", (boost::format("id %1%") % fed_id).str());
+      // Mark FED modules as bad
+      fragment.detids.reserve(fragment.detids.size()+conns.size());
+      std::vector<FedChannelConnection>::const_iterator iconn = conns.begin();
+      for ( ; iconn != conns.end(); iconn++ ) {
+        if ( !iconn->detId() || iconn->detId() == sistrip::invalid32_ ) continue;
+        fragment.detids.push_back(iconn->detId()); //@@ Possible multiple entries (ok for Giovanni)
       }
-      
-      // get the cabling connections for this FED
-      auto conns = cabling.fedConnections(*ifed);
+      return;
+    }	
     
-      // Check on FEDRawData pointer
-      if ( !input.data() ) {
-        warnings_.add("NULL pointer to FEDRawData for FED", (boost::format("id %1%") % *ifed).str());
-        // Mark FED modules as bad
-        detids.reserve(detids.size()+conns.size());
-        std::vector<FedChannelConnection>::const_iterator iconn = conns.begin();
-        for ( ; iconn != conns.end(); iconn++ ) {
-          if ( !iconn->detId() || iconn->detId() == sistrip::invalid32_ ) continue;
-          detids.push_back(iconn->detId()); //@@ Possible multiple entries (ok for Giovanni)
-        }
-	continue;
-      }	
+    // Check on FEDRawData size
+    if ( !input.size() ) {
+      fragment.addWarning("FEDRawData has zero size for FED", (boost::format("id %1%") % fed_id).str());
+      // Mark FED modules as bad
+      fragment.detids.reserve(fragment.detids.size()+conns.size());
+      std::vector<FedChannelConnection>::const_iterator iconn = conns.begin();
+      for ( ; iconn != conns.end(); iconn++ ) {
+        if ( !iconn->detId() || iconn->detId() == sistrip::invalid32_ ) continue;
+        fragment.detids.push_back(iconn->detId()); //@@ Possible multiple entries (ok for Giovanni)
+      }
+      return;
+    }
     
-      // Check on FEDRawData size
-      if ( !input.size() ) {
-        warnings_.add("FEDRawData has zero size for FED", (boost::format("id %1%") % *ifed).str());
-        // Mark FED modules as bad
-        detids.reserve(detids.size()+conns.size());
-        std::vector<FedChannelConnection>::const_iterator iconn = conns.begin();
-        for ( ; iconn != conns.end(); iconn++ ) {
-          if ( !iconn->detId() || iconn->detId() == sistrip::invalid32_ ) continue;
-          detids.push_back(iconn->detId()); //@@ Possible multiple entries (ok for Giovanni)
-        }
-        continue;
+    // construct FEDBuffer
+    std::auto_ptr<sistrip::FEDBuffer> buffer;
+    try {
+      buffer.reset(new sistrip::FEDBuffer(input.data(),input.size()));
+      buffer->setLegacyMode(legacy_);
+      if (!buffer->doChecks(true)) {
+        if (!unpackBadChannels_ || !buffer->checkNoFEOverflows() )
+          throw cms::Exception("FEDBuffer") << "FED Buffer check fails for FED ID " << fed_id << ".";
       }
-      
-      // construct FEDBuffer
-      std::auto_ptr<sistrip::FEDBuffer> buffer;
-      try {
-        buffer.reset(new sistrip::FEDBuffer(input.data(),input.size()));
-        buffer->setLegacyMode(legacy_);
-        if (!buffer->doChecks(true)) {
-          if (!unpackBadChannels_ || !buffer->checkNoFEOverflows() )
-            throw cms::Exception("FEDBuffer") << "FED Buffer check fails for FED ID " << *ifed << ".";
-        }
-        if (doFullCorruptBufferChecks_ && !buffer->doCorruptBufferChecks()) {
-          throw cms::Exception("FEDBuffer") << "FED corrupt buffer check fails for FED ID " << *ifed << ".";
-        }
+      if (doFullCorruptBufferChecks_ && !buffer->doCorruptBufferChecks()) {
+        throw cms::Exception("FEDBuffer") << "FED corrupt buffer check fails for FED ID " << fed_id << ".";
       }
-      catch (const cms::Exception& e) {
-        warnings_.add("Exception caught when creating FEDBuffer object for FED", (boost::format("id %1%: %2%") % *ifed % e.what()).str());
-        // FED buffer is bad and should not be unpacked. Skip this FED and mark all modules as bad. 
-        std::vector<FedChannelConnection>::const_iterator iconn = conns.begin();
-        for ( ; iconn != conns.end(); iconn++ ) {
-          if ( !iconn->detId() || iconn->detId() == sistrip::invalid32_ ) continue;
-          detids.push_back(iconn->detId()); //@@ Possible multiple entries (ok for Giovanni)
-        }
-        continue;
+    }
+    catch (const cms::Exception& e) {
+      fragment.addWarning("Exception caught when creating FEDBuffer object for FED", (boost::format("id %1%: %2%") % fed_id % e.what()).str());
+      // FED buffer is bad and should not be unpacked. Skip this FED and mark all modules as bad. 
+      std::vector<FedChannelConnection>::const_iterator iconn = conns.begin();
+      for ( ; iconn != conns.end(); iconn++ ) {
+        if ( !iconn->detId() || iconn->detId() == sistrip::invalid32_ ) continue;
+        fragment.detids.push_back(iconn->detId()); //@@ Possible multiple entries (ok for Giovanni)
       }
+      return;
+    }
 
-      // Check if EventSummary ("trigger FED info") needs updating
-      if ( first_fed && useDaqRegister_ ) { updateEventSummary( *buffer, summary ); first_fed = false; }
+    // Check if EventSummary ("trigger FED info") needs updating
+    if ( first_fed && useDaqRegister_ ) { updateEventSummary( *buffer, summary ); first_fed = false; }
     
-      // Check to see if EventSummary info is set
-      if ( !quiet_ && !summary.isSet() ) {
-        warnings_.add("EventSummary is not set correctly! Missing information from both \"trigger FED\" and \"DAQ registers\"!");
-      }
+    // Check to see if EventSummary info is set
+    if ( !quiet_ && !summary.isSet() ) {
+      fragment.addWarning("EventSummary is not set correctly! Missing information from both \"trigger FED\" and \"DAQ registers\"!");
+    }
     
-      // Check to see if event is to be analyzed according to EventSummary
-      if ( !summary.valid() ) { 
-	if ( edm::isDebugEnabled() ) {
-	  LogTrace("SiStripRawToDigi")
-	    << "[sistrip::RawToDigiUnpacker::" << __func__ << "]"
-	    << " EventSummary is not valid: skipping...";
-	}
-	continue; 
+    // Check to see if event is to be analyzed according to EventSummary
+    if ( !summary.valid() ) { 
+      if ( edm::isDebugEnabled() ) {
+        LogTrace("SiStripRawToDigi")
+          << "[sistrip::RawToDigiUnpacker::" << __func__ << "]"
+          << " EventSummary is not valid: skipping...";
       }
+      return; 
+    }
     
-      /// extract readout mode
-      sistrip::FEDReadoutMode mode = buffer->readoutMode();
-      sistrip::FEDLegacyReadoutMode lmode = (legacy_) ? buffer->legacyReadoutMode() : sistrip::READOUT_MODE_LEGACY_INVALID;
-
-      // Retrive run type
-      sistrip::RunType runType_ = summary.runType();
-      if( runType_ == sistrip::APV_LATENCY || runType_ == sistrip::FINE_DELAY ) { useFedKey_ = false; } 
+    /// extract readout mode
+    sistrip::FEDReadoutMode mode = buffer->readoutMode();
+    sistrip::FEDLegacyReadoutMode lmode = (legacy_) ? buffer->legacyReadoutMode() : sistrip::READOUT_MODE_LEGACY_INVALID;
+
+    // Retrive run type
+    sistrip::RunType runType_ = summary.runType();
+    if( runType_ == sistrip::APV_LATENCY || runType_ == sistrip::FINE_DELAY ) { fragment.disableFedKey = true; }
+    // (the run type is the same for all the FEDs, useFedKey_ is updated when the fragment is merged)
+    const bool useFedKey = useFedKey_ && !fragment.disableFedKey;
      
-      // Dump of FED buffer
-      if ( edm::isDebugEnabled() ) {
-	if ( fedEventDumpFreq_ && !(event_%fedEventDumpFreq_) ) {
-	  std::stringstream ss;
-	  buffer->dump( ss );
-	  edm::LogVerbatim(sistrip::mlRawToDigi_) << ss.str();
-	}
+    // Dump of FED buffer
+    if ( edm::isDebugEnabled() ) {
+      if ( fedEventDumpFreq_ && !(event_%fedEventDumpFreq_) ) {
+        std::stringstream ss;
+        buffer->dump( ss );
+        edm::LogVerbatim(sistrip::mlRawToDigi_) << ss.str();
       }
+    }
     
-      // Iterate through FED channels, extract payload and create Digis
-      std::vector<FedChannelConnection>::const_iterator iconn = conns.begin();
-      for ( ; iconn != conns.end(); iconn++ ) {
+    // Iterate through FED channels, extract payload and create Digis
+    std::vector<FedChannelConnection>::const_iterator iconn = conns.begin();
+    for ( ; iconn != conns.end(); iconn++ ) {
 
-	/// FED channel
-	uint16_t chan = iconn->fedCh();
+      /// FED channel
+      uint16_t chan = iconn->fedCh();
 
-	// Check if fed connection is valid
-	if ( !iconn->isConnected() ) { continue; }
-        
-        // Check DetId is valid (if to be used as key)
-	if ( !useFedKey_ && ( !iconn->detId() || iconn->detId() == sistrip::invalid32_ ) ) { continue; }
+      // Check if fed connection is valid
+      if ( !iconn->isConnected() ) { continue; }
       
-	// Check FED channel
-	if (!buffer->channelGood(iconn->fedCh(),doAPVEmulatorCheck_)) {
-          if (!unpackBadChannels_ || !(buffer->fePresent(iconn->fedCh()/FEDCH_PER_FEUNIT) && buffer->feEnabled(iconn->fedCh()/FEDCH_PER_FEUNIT)) ) {
-            detids.push_back(iconn->detId()); //@@ Possible multiple entries (ok for Giovanni)
-            continue;
-          }
-	}
+      // Check DetId is valid (if to be used as key)
+      if ( !useFedKey && ( !iconn->detId() || iconn->detId() == sistrip::invalid32_ ) ) { continue; }
+    
+      // Check FED channel
+      if (!buffer->channelGood(iconn->fedCh(),doAPVEmulatorCheck_)) {
+        if (!unpackBadChannels_ || !(buffer->fePresent(iconn->fedCh()/FEDCH_PER_FEUNIT) && buffer->feEnabled(iconn->fedCh()/FEDCH_PER_FEUNIT)) ) {
+          fragment.detids.push_back(iconn->detId()); //@@ Possible multiple entries (ok for Giovanni)
+          continue;
+        }
+      }
 
-	// Determine whether FED key is inferred from cabling or channel loop
-	uint32_t fed_key = ( summary.runType() == sistrip::FED_CABLING ) ? ( ( *ifed & sistrip::invalid_ ) << 16 ) | ( chan & sistrip::invalid_ ) : ( ( iconn->fedId() & sistrip::invalid_ ) << 16 ) | ( iconn->fedCh() & sistrip::invalid_ );
+      // Determine whether FED key is inferred from cabling or channel loop
+      uint32_t fed_key = ( summary.runType() == sistrip::FED_CABLING ) ? ( ( fed_id & sistrip::invalid_ ) << 16 ) | ( chan & sistrip::invalid_ ) : ( ( iconn->fedId() & sistrip::invalid_ ) << 16 ) | ( iconn->fedCh() & sistrip::invalid_ );
 
-	// Determine whether DetId or FED key should be used to index digi containers
-	uint32_t key = ( useFedKey_ || (!legacy_ && mode == sistrip::READOUT_MODE_SCOPE) || (legacy_ && lmode == sistrip::READOUT_MODE_LEGACY_SCOPE) ) ? fed_key : iconn->detId();
-      
-	// Determine APV std::pair number (needed only when using DetId)
-	uint16_t ipair = ( useFedKey_ || (!legacy_ && mode == sistrip::READOUT_MODE_SCOPE) || (legacy_ && lmode == sistrip::READOUT_MODE_LEGACY_SCOPE) ) ? 0 : iconn->apvPairNumber();
+      // Determine whether DetId or FED key should be used to index digi containers
+      uint32_t key = ( useFedKey || (!legacy_ && mode == sistrip::READOUT_MODE_SCOPE) || (legacy_ && lmode == sistrip::READOUT_MODE_LEGACY_SCOPE) ) ? fed_key : iconn->detId();
+    
+      // Determine APV std::pair number (needed only when using DetId)
+      uint16_t ipair = ( useFedKey || (!legacy_ && mode == sistrip::READOUT_MODE_SCOPE) || (legacy_ && lmode == sistrip::READOUT_MODE_LEGACY_SCOPE) ) ? 0 : iconn->apvPairNumber();
 
-	if ((!legacy_ && (mode == sistrip::READOUT_MODE_ZERO_SUPPRESSED || mode == sistrip::READOUT_MODE_ZERO_SUPPRESSED_FAKE))
-         || (legacy_ && (lmode == sistrip::READOUT_MODE_LEGACY_ZERO_SUPPRESSED_REAL || lmode == sistrip::READOUT_MODE_LEGACY_ZERO_SUPPRESSED_FAKE)) ) {
-	
-	  Registry regItem(key, 0, zs_work_digis_.size(), 0);
-	
-          try {
-	    /// create unpacker
-            /// unpack -> add check to make sure strip < nstrips && strip > last strip......
-            const uint8_t packet_code = buffer->packetCode(legacy_, iconn->fedCh());
-            switch (packet_code) {
-              case PACKET_CODE_ZERO_SUPPRESSED: {
+      if ((!legacy_ && (mode == sistrip::READOUT_MODE_ZERO_SUPPRESSED || mode == sistrip::READOUT_MODE_ZERO_SUPPRESSED_FAKE))
+       || (legacy_ && (lmode == sistrip::READOUT_MODE_LEGACY_ZERO_SUPPRESSED_REAL || lmode == sistrip::READOUT_MODE_LEGACY_ZERO_SUPPRESSED_FAKE)) ) {
+      
+        Registry regItem(key, 0, fragment.zs_digis.size(), 0);
+      
+        try {
+          /// create unpacker
+          /// unpack -> add check to make sure strip < nstrips && strip > last strip......
+          const uint8_t packet_code = buffer->packetCode(legacy_, iconn->fedCh());
+          switch (packet_code) {
+            case PACKET_CODE_ZERO_SUPPRESSED: {
+              sistrip::FEDZSChannelUnpacker unpacker = sistrip::FEDZSChannelUnpacker::zeroSuppressedModeUnpacker(buffer->channel(iconn->fedCh()));
+              while (unpacker.hasData()) {fragment.zs_digis.push_back(SiStripDigi(unpacker.sampleNumber()+ipair*256,unpacker.adc())); unpacker++;}
+              break; }
+            case PACKET_CODE_ZERO_SUPPRESSED10: {
+              sistrip::FEDBSChannelUnpacker unpacker = sistrip::FEDBSChannelUnpacker::zeroSuppressedModeUnpacker(buffer->channel(iconn->fedCh()), 10);
+              while (unpacker.hasData()) {fragment.zs_digis.push_back(SiStripDigi(unpacker.sampleNumber()+ipair*256,unpacker.adc())); unpacker++;}
+              break; }
+            case PACKET_CODE_ZERO_SUPPRESSED8_BOTBOT: {
+              sistrip::FEDBSChannelUnpacker unpacker = sistrip::FEDBSChannelUnpacker::zeroSuppressedModeUnpacker(buffer->channel(iconn->fedCh()), 8);
+              while (unpacker.hasData()) {fragment.zs_digis.push_back(SiStripDigi(unpacker.sampleNumber()+ipair*256,unpacker.adc()<<2)); unpacker++;}
+              break; }
+            case PACKET_CODE_ZERO_SUPPRESSED8_TOPBOT: {
+              sistrip::FEDBSChannelUnpacker unpacker = sistrip::FEDBSChannelUnpacker::zeroSuppressedModeUnpacker(buffer->channel(iconn->fedCh()), 8);
+              while (unpacker.hasData()) {fragment.zs_digis.push_back(SiStripDigi(unpacker.sampleNumber()+ipair*256,unpacker.adc()<<1)); unpacker++;}
+              break; }
+            default: {
+              fragment.addWarning((boost::format("Invalid packet code %1$#x for zero-suppressed data") % uint16_t(buffer->packetCode(legacy_, iconn->fedCh()))).str(), (boost::format("FED %1% channel %2%") % fed_id % iconn->fedCh()).str());
+              if ( packet_code == 0 ) {
+                // workaround for a pre-2015 bug in the packer: assume default ZS packing
                 sistrip::FEDZSChannelUnpacker unpacker = sistrip::FEDZSChannelUnpacker::zeroSuppressedModeUnpacker(buffer->channel(iconn->fedCh()));
-                while (unpacker.hasData()) {zs_work_digis_.push_back(SiStripDigi(unpacker.sampleNumber()+ipair*256,unpacker.adc())); unpacker++;}
-                break; }
-              case PACKET_CODE_ZERO_SUPPRESSED10: {
-                sistrip::FEDBSChannelUnpacker unpacker = sistrip::FEDBSChannelUnpacker::zeroSuppressedModeUnpacker(buffer->channel(iconn->fedCh()), 10);
-                while (unpacker.hasData()) {zs_work_digis_.push_back(SiStripDigi(unpacker.sampleNumber()+ipair*256,unpacker.adc())); unpacker++;}
-                break; }
-              case PACKET_CODE_ZERO_SUPPRESSED8_BOTBOT: {
-                sistrip::FEDBSChannelUnpacker unpacker = sistrip::FEDBSChannelUnpacker::zeroSuppressedModeUnpacker(buffer->channel(iconn->fedCh()), 8);
-                while (unpacker.hasData()) {zs_work_digis_.push_back(SiStripDigi(unpacker.sampleNumber()+ipair*256,unpacker.adc()<<2)); unpacker++;}
-                break; }
-              case PACKET_CODE_ZERO_SUPPRESSED8_TOPBOT: {
-                sistrip::FEDBSChannelUnpacker unpacker = sistrip::FEDBSChannelUnpacker::zeroSuppressedModeUnpacker(buffer->channel(iconn->fedCh()), 8);
-                while (unpacker.hasData()) {zs_work_digis_.push_back(SiStripDigi(unpacker.sampleNumber()+ipair*256,unpacker.adc()<<1)); unpacker++;}
-                break; }
-              default: {
-                warnings_.add((boost::format("Invalid packet code %1$#x for zero-suppressed data") % uint16_t(buffer->packetCode(legacy_, iconn->fedCh()))).str(), (boost::format("FED %1% channel %2%") % *ifed % iconn->fedCh()).str());
-                if ( packet_code == 0 ) {
-                  // workaround for a pre-2015 bug in the packer: assume default ZS packing
-                  sistrip::FEDZSChannelUnpacker unpacker = sistrip::FEDZSChannelUnpacker::zeroSuppressedModeUnpacker(buffer->channel(iconn->fedCh()));
-                  while (unpacker.hasData()) {zs_work_digis_.push_back(SiStripDigi(unpacker.sampleNumber()+ipair*256,unpacker.adc())); unpacker++;}
-                }
+                while (unpacker.hasData()) {fragment.zs_digis.push_back(SiStripDigi(unpacker.sampleNumber()+ipair*256,unpacker.adc())); unpacker++;}
               }
             }
-          } catch (const cms::Exception& e) {
-            warnings_.add("Clusters are not ordered", (boost::format("FED %1% channel %2% : %3%") % *ifed % iconn->fedCh() % e.what()).str());
-            detids.push_back(iconn->detId()); //@@ Possible multiple entries (ok for Giovanni)
-            continue;
           }
-          
-	  regItem.length = zs_work_digis_.size() - regItem.index;
-	  if (regItem.length > 0) {
-	    regItem.first = zs_work_digis_[regItem.index].strip();
-	    zs_work_registry_.push_back(regItem);
-	  }
+        } catch (const cms::Exception& e) {
+          fragment.addWarning("Clusters are not ordered", (boost::format("FED %1% channel %2% : %3%") % fed_id % iconn->fedCh() % e.what()).str());
+          fragment.detids.push_back(iconn->detId()); //@@ Possible multiple entries (ok for Giovanni)
+          continue;
+        }
+        
+        regItem.length = fragment.zs_digis.size() - regItem.index;
+        if (regItem.length > 0) {
+          regItem.first = fragment.zs_digis[regItem.index].strip();
+          fragment.zs_registry.push_back(regItem);
+        }
 
-	    
-	  // Common mode values
+          
+        // Common mode values
  	  if ( extractCm_ ) {
  	    try {
-	      Registry regItem2( key, 2*ipair, cm_work_digis_.size(), 2 );
-	      cm_work_digis_.push_back( SiStripRawDigi( buffer->channel(iconn->fedCh()).cmMedian(0) ) );
-	      cm_work_digis_.push_back( SiStripRawDigi( buffer->channel(iconn->fedCh()).cmMedian(1) ) );
-	      cm_work_registry_.push_back( regItem2 );
+            Registry regItem2( key, 2*ipair, fragment.cm_digis.size(), 2 );
+            fragment.cm_digis.push_back( SiStripRawDigi( buffer->channel(iconn->fedCh()).cmMedian(0) ) );
+            fragment.cm_digis.push_back( SiStripRawDigi( buffer->channel(iconn->fedCh()).cmMedian(1) ) );
+            fragment.cm_registry.push_back( regItem2 );
  	    } catch (const cms::Exception& e) {
-              warnings_.add("Problem extracting common modes", (boost::format("FED %1% channel %2%:\n %3%") % *ifed % iconn->fedCh() % e.what()).str());
+            fragment.addWarning("Problem extracting common modes", (boost::format("FED %1% channel %2%:\n %3%") % fed_id % iconn->fedCh() % e.what()).str());
  	    }
  	  }
-	  
-	}
+        
+      }
 
-	else if (!legacy_ && (mode==sistrip::READOUT_MODE_ZERO_SUPPRESSED_LITE10 || mode==sistrip::READOUT_MODE_ZERO_SUPPRESSED_LITE10_CMOVERRIDE)) { 
-
-	  Registry regItem(key, 0, zs_work_digis_.size(), 0);
-
-	  try {
-            /// create unpacker
-	    sistrip::FEDBSChannelUnpacker unpacker = sistrip::FEDBSChannelUnpacker::zeroSuppressedLiteModeUnpacker(buffer->channel(iconn->fedCh()), 10);
-	    
-	    /// unpack -> add check to make sure strip < nstrips && strip > last strip......
-	    while (unpacker.hasData()) {zs_work_digis_.push_back(SiStripDigi(unpacker.sampleNumber()+ipair*256,unpacker.adc()));unpacker++;}
-	  } catch (const cms::Exception& e) {
-            warnings_.add("Clusters are not ordered", (boost::format("FED %1% channel %2%: %3%") % *ifed % iconn->fedCh() % e.what()).str());
-            detids.push_back(iconn->detId()); //@@ Possible multiple entries (ok for Giovanni)
-            continue;
-          }  
-
-	  regItem.length = zs_work_digis_.size() - regItem.index;
-	  if (regItem.length > 0) {
-	    regItem.first = zs_work_digis_[regItem.index].strip();
-	    zs_work_registry_.push_back(regItem);
-	  }
+      else if (!legacy_ && (mode==sistrip::READOUT_MODE_ZERO_SUPPRESSED_LITE10 || mode==sistrip::READOUT_MODE_ZERO_SUPPRESSED_LITE10_CMOVERRIDE)) { 
+
+        Registry regItem(key, 0, fragment.zs_digis.size(), 0);
+
+        try {
+          /// create unpacker
+          sistrip::FEDBSChannelUnpacker unpacker = sistrip::FEDBSChannelUnpacker::zeroSuppressedLiteModeUnpacker(buffer->channel(iconn->fedCh()), 10);
           
+          /// unpack -> add check to make sure strip < nstrips && strip > last strip......
+          while (unpacker.hasData()) {fragment.zs_digis.push_back(SiStripDigi(unpacker.sampleNumber()+ipair*256,unpacker.adc()));unpacker++;}
+        } catch (const cms::Exception& e) {
+          fragment.addWarning("Clusters are not ordered", (boost::format("FED %1% channel %2%: %3%") % fed_id % iconn->fedCh() % e.what()).str());
+          fragment.detids.push_back(iconn->detId()); //@@ Possible multiple entries (ok for Giovanni)
+          continue;
+        }  
+
+        regItem.length = fragment.zs_digis.size() - regItem.index;
+        if (regItem.length > 0) {
+          regItem.first = fragment.zs_digis[regItem.index].strip();
+          fragment.zs_registry.push_back(regItem);
+        }
+        
 
-	} 
+      } 
 
-        else if ((!legacy_ &&
-                 (mode==sistrip::READOUT_MODE_ZERO_SUPPRESSED_LITE8  || mode==sistrip::READOUT_MODE_ZERO_SUPPRESSED_LITE8_CMOVERRIDE ||
-                  mode==sistrip::READOUT_MODE_ZERO_SUPPRESSED_LITE8_TOPBOT || mode==sistrip::READOUT_MODE_ZERO_SUPPRESSED_LITE8_TOPBOT_CMOVERRIDE ||
-                  mode==sistrip::READOUT_MODE_ZERO_SUPPRESSED_LITE8_BOTBOT || mode==sistrip::READOUT_MODE_ZERO_SUPPRESSED_LITE8_BOTBOT_CMOVERRIDE))
-             || (legacy_ && (lmode == sistrip::READOUT_MODE_LEGACY_ZERO_SUPPRESSED_LITE_REAL || lmode == sistrip::READOUT_MODE_LEGACY_ZERO_SUPPRESSED_LITE_FAKE))) {
+      else if ((!legacy_ &&
+               (mode==sistrip::READOUT_MODE_ZERO_SUPPRESSED_LITE8  || mode==sistrip::READOUT_MODE_ZERO_SUPPRESSED_LITE8_CMOVERRIDE ||
+                mode==sistrip::READOUT_MODE_ZERO_SUPPRESSED_LITE8_TOPBOT || mode==sistrip::READOUT_MODE_ZERO_SUPPRESSED_LITE8_TOPBOT_CMOVERRIDE ||
+                mode==sistrip::READOUT_MODE_ZERO_SUPPRESSED_LITE8_BOTBOT || mode==sistrip::READOUT_MODE_ZERO_SUPPRESSED_LITE8_BOTBOT_CMOVERRIDE))
+           || (legacy_ && (lmode == sistrip::READOUT_MODE_LEGACY_ZERO_SUPPRESSED_LITE_REAL || lmode == sistrip::READOUT_MODE_LEGACY_ZERO_SUPPRESSED_LITE_FAKE))) {
 
-      	  Registry regItem(key, 0, zs_work_digis_.size(), 0);
-	
-	  size_t bits_shift = 0;
-	  if (mode==sistrip::READOUT_MODE_ZERO_SUPPRESSED_LITE8_TOPBOT || mode==sistrip::READOUT_MODE_ZERO_SUPPRESSED_LITE8_TOPBOT_CMOVERRIDE) bits_shift = 1;
-	  if (mode==sistrip::READOUT_MODE_ZERO_SUPPRESSED_LITE8_BOTBOT || mode==sistrip::READOUT_MODE_ZERO_SUPPRESSED_LITE8_BOTBOT_CMOVERRIDE) bits_shift = 2;
-	  
-	  try {
-            /// create unpacker
-            sistrip::FEDZSChannelUnpacker unpacker = sistrip::FEDZSChannelUnpacker::zeroSuppressedLiteModeUnpacker(buffer->channel(iconn->fedCh()));
-	    	    
+    	  Registry regItem(key, 0, fragment.zs_digis.size(), 0);
+      
+        size_t bits_shift = 0;
+        if (mode==sistrip::READOUT_MODE_ZERO_SUPPRESSED_LITE8_TOPBOT || mode==sistrip::READOUT_MODE_ZERO_SUPPRESSED_LITE8_TOPBOT_CMOVERRIDE) bits_shift = 1;
+        if (mode==sistrip::READOUT_MODE_ZERO_SUPPRESSED_LITE8_BOTBOT || mode==sistrip::READOUT_MODE_ZERO_SUPPRESSED_LITE8_BOTBOT_CMOVERRIDE) bits_shift = 2;
+        
+        try {
+          /// create unpacker
+          sistrip::FEDZSChannelUnpacker unpacker = sistrip::FEDZSChannelUnpacker::zeroSuppressedLiteModeUnpacker(buffer->channel(iconn->fedCh()));
+          	    
     	    /// unpack -> add check to make sure strip < nstrips && strip > last strip......
-   	    while (unpacker.hasData()) {zs_work_digis_.push_back(SiStripDigi(unpacker.sampleNumber()+ipair*256,unpacker.adc()<<bits_shift));unpacker++;}
+   	    while (unpacker.hasData()) {fragment.zs_digis.push_back(SiStripDigi(unpacker.sampleNumber()+ipair*256,unpacker.adc()<<bits_shift));unpacker++;}
  	  } catch (const cms::Exception& e) {
-            warnings_.add("Clusters are not ordered", (boost::format("FED %1% channel %2%: %3%") % *ifed % iconn->fedCh() % e.what()).str());
-            detids.push_back(iconn->detId()); //@@ Possible multiple entries (ok for Giovanni)
-            continue;
-          }
-
-	  regItem.length = zs_work_digis_.size() - regItem.index;
-	  if (regItem.length > 0) {
-	    regItem.first = zs_work_digis_[regItem.index].strip();
-	    zs_work_registry_.push_back(regItem);
-	  }
+          fragment.addWarning("Clusters are not ordered", (boost::format("FED %1% channel %2%: %3%") % fed_id % iconn->fedCh() % e.what()).str());
+          fragment.detids.push_back(iconn->detId()); //@@ Possible multiple entries (ok for Giovanni)
+          continue;
+        }
 
+        regItem.length = fragment.zs_digis.size() - regItem.index;
+        if (regItem.length > 0) {
+          regItem.first = fragment.zs_digis[regItem.index].strip();
+          fragment.zs_registry.push_back(regItem);
         }
+
+      }
      
-	else if ((!legacy_ && mode == sistrip::READOUT_MODE_PREMIX_RAW)
-              || (legacy_ && lmode == sistrip::READOUT_MODE_LEGACY_PREMIX_RAW)
-                ) { 
+      else if ((!legacy_ && mode == sistrip::READOUT_MODE_PREMIX_RAW)
+            || (legacy_ && lmode == sistrip::READOUT_MODE_LEGACY_PREMIX_RAW)
+              ) { 
 
-	  Registry regItem(key, 0, zs_work_digis_.size(), 0);
-	
-	  try {
-
-            /// create unpacker
-	    sistrip::FEDZSChannelUnpacker unpacker = sistrip::FEDZSChannelUnpacker::preMixRawModeUnpacker(buffer->channel(iconn->fedCh()));
-	    
-	    /// unpack -> add check to make sure strip < nstrips && strip > last strip......
-	    while (unpacker.hasData()) {zs_work_digis_.push_back(SiStripDigi(unpacker.sampleNumber()+ipair*256,unpacker.adcPreMix()));unpacker++;}
-	  } catch (const cms::Exception& e) {
-            warnings_.add("Clusters are not ordered", (boost::format("FED %1% channel %2%: %3%") % *ifed % iconn->fedCh() % e.what()).str());
-            detids.push_back(iconn->detId()); //@@ Possible multiple entries (ok for Giovanni)
-            continue;
-          }  
-
-	  regItem.length = zs_work_digis_.size() - regItem.index;
-	  if (regItem.length > 0) {
-	    regItem.first = zs_work_digis_[regItem.index].strip();
-	    zs_work_registry_.push_back(regItem);
-	  }
+        Registry regItem(key, 0, fragment.zs_digis.size(), 0);
+      
+        try {
+
+          /// create unpacker
+          sistrip::FEDZSChannelUnpacker unpacker = sistrip::FEDZSChannelUnpacker::preMixRawModeUnpacker(buffer->channel(iconn->fedCh()));
           
+          /// unpack -> add check to make sure strip < nstrips && strip > last strip......
+          while (unpacker.hasData()) {fragment.zs_digis.push_back(SiStripDigi(unpacker.sampleNumber()+ipair*256,unpacker.adcPreMix()));unpacker++;}
+        } catch (const cms::Exception& e) {
+          fragment.addWarning("Clusters are not ordered", (boost::format("FED %1% channel %2%: %3%") % fed_id % iconn->fedCh() % e.what()).str());
+          fragment.detids.push_back(iconn->detId()); //@@ Possible multiple entries (ok for Giovanni)
+          continue;
+        }  
+
+        regItem.length = fragment.zs_digis.size() - regItem.index;
+        if (regItem.length > 0) {
+          regItem.first = fragment.zs_digis[regItem.index].strip();
+          fragment.zs_registry.push_back(regItem);
+        }
+        
 
-	} 
+      } 
      
-	else if ((!legacy_ && mode == sistrip::READOUT_MODE_VIRGIN_RAW)
-               || (legacy_ && (lmode == sistrip::READOUT_MODE_LEGACY_VIRGIN_RAW_REAL || lmode == sistrip::READOUT_MODE_LEGACY_VIRGIN_RAW_FAKE ))
-                ) {
+      else if ((!legacy_ && mode == sistrip::READOUT_MODE_VIRGIN_RAW)
+             || (legacy_ && (lmode == sistrip::READOUT_MODE_LEGACY_VIRGIN_RAW_REAL || lmode == sistrip::READOUT_MODE_LEGACY_VIRGIN_RAW_FAKE ))
+              ) {
 
-	  std::vector<uint16_t> samples; 
+        std::vector<uint16_t> samples; 
 
-	  /// create unpacker
-	  /// and unpack -> add check to make sure strip < nstrips && strip > last strip......
+        /// create unpacker
+        /// and unpack -> add check to make sure strip < nstrips && strip > last strip......
 
-          uint8_t packet_code = buffer->packetCode(legacy_);
-          if ( packet_code == PACKET_CODE_VIRGIN_RAW ) {
-            sistrip::FEDRawChannelUnpacker unpacker = sistrip::FEDRawChannelUnpacker::virginRawModeUnpacker(buffer->channel(iconn->fedCh()));
-	    while (unpacker.hasData()) {samples.push_back(unpacker.adc());unpacker++;}
+        uint8_t packet_code = buffer->packetCode(legacy_);
+        if ( packet_code == PACKET_CODE_VIRGIN_RAW ) {
+          sistrip::FEDRawChannelUnpacker unpacker = sistrip::FEDRawChannelUnpacker::virginRawModeUnpacker(buffer->channel(iconn->fedCh()));
+          while (unpacker.hasData()) {samples.push_back(unpacker.adc());unpacker++;}
+        }
+        else {
+          if ( packet_code == PACKET_CODE_VIRGIN_RAW10 ) {
+            sistrip::FEDBSChannelUnpacker unpacker = sistrip::FEDBSChannelUnpacker::virginRawModeUnpacker(buffer->channel(iconn->fedCh()), 10);
+            while (unpacker.hasData()) {samples.push_back(unpacker.adc());unpacker.sampleNumber();unpacker++;}
           }
-          else {
-            if ( packet_code == PACKET_CODE_VIRGIN_RAW10 ) {
-              sistrip::FEDBSChannelUnpacker unpacker = sistrip::FEDBSChannelUnpacker::virginRawModeUnpacker(buffer->channel(iconn->fedCh()), 10);
-              while (unpacker.hasData()) {samples.push_back(unpacker.adc());unpacker.sampleNumber();unpacker++;}
-            }
-            else if ( packet_code == PACKET_CODE_VIRGIN_RAW8_BOTBOT ) {
-              sistrip::FEDBSChannelUnpacker unpacker = sistrip::FEDBSChannelUnpacker::virginRawModeUnpacker(buffer->channel(iconn->fedCh()), 8);
-	      while (unpacker.hasData()) {samples.push_back(( unpacker.adc()<<2 ));unpacker++;}
-            }
-            else if ( packet_code == PACKET_CODE_VIRGIN_RAW8_TOPBOT ) {
-              sistrip::FEDBSChannelUnpacker unpacker = sistrip::FEDBSChannelUnpacker::virginRawModeUnpacker(buffer->channel(iconn->fedCh()), 8);
-	      while (unpacker.hasData()) {samples.push_back(( unpacker.adc()<<1 ));unpacker++;}
-            }
+          else if ( packet_code == PACKET_CODE_VIRGIN_RAW8_BOTBOT ) {
+            sistrip::FEDBSChannelUnpacker unpacker = sistrip::FEDBSChannelUnpacker::virginRawModeUnpacker(buffer->channel(iconn->fedCh()), 8);
+            while (unpacker.hasData()) {samples.push_back(( unpacker.adc()<<2 ));unpacker++;}
           }
-          if ( !samples.empty() ) { 
-            Registry regItem(key, 256*ipair, virgin_work_digis_.size(), samples.size());
-	    uint16_t physical;
-	    uint16_t readout; 
-	    for ( uint16_t i = 0, n = samples.size(); i < n; i++ ) {
-	      physical = i%128;
-	      readoutOrder( physical, readout );                 // convert index from physical to readout order
-	      (i/128) ? readout=readout*2+1 : readout=readout*2; // un-multiplex data
-	      virgin_work_digis_.push_back(  SiStripRawDigi( samples[readout] ) );
-	    }
-	    virgin_work_registry_.push_back( regItem );
-	  }
-	} 
+          else if ( packet_code == PACKET_CODE_VIRGIN_RAW8_TOPBOT ) {
+            sistrip::FEDBSChannelUnpacker unpacker = sistrip::FEDBSChannelUnpacker::virginRawModeUnpacker(buffer->channel(iconn->fedCh()), 8);
+            while (unpacker.hasData()) {samples.push_back(( unpacker.adc()<<1 ));unpacker++;}
+          }
+        }
+        if ( !samples.empty() ) { 
+          Registry regItem(key, 256*ipair, fragment.virgin_digis.size(), samples.size());
+          uint16_t physical;
+          uint16_t readout; 
+          for ( uint16_t i = 0, n = samples.size(); i < n; i++ ) {
+            physical = i%128;
+            readoutOrder( physical, readout );                 // convert index from physical to readout order
+            (i/128) ? readout=readout*2+1 : readout=readout*2; // un-multiplex data
+            fragment.virgin_digis.push_back(  SiStripRawDigi( samples[readout] ) );
+          }
+          fragment.virgin_registry.push_back( regItem );
+        }
+      } 
     
-	else if ((!legacy_ && mode == sistrip::READOUT_MODE_PROC_RAW)
-               || (legacy_ && (lmode == sistrip::READOUT_MODE_LEGACY_PROC_RAW_REAL || lmode == sistrip::READOUT_MODE_LEGACY_PROC_RAW_FAKE ))
-                ) {
-	
-	  std::vector<uint16_t> samples; 
-	
-	  /// create unpacker
-	  sistrip::FEDRawChannelUnpacker unpacker = sistrip::FEDRawChannelUnpacker::procRawModeUnpacker(buffer->channel(iconn->fedCh()));
-	
-	  /// unpack -> add check to make sure strip < nstrips && strip > last strip......
-	  while (unpacker.hasData()) {samples.push_back(unpacker.adc());unpacker++;}
-	
-	  if ( !samples.empty() ) { 
-	    Registry regItem(key, 256*ipair, proc_work_digis_.size(), samples.size());
-	    for ( uint16_t i = 0, n = samples.size(); i < n; i++ ) {
-	      proc_work_digis_.push_back(  SiStripRawDigi( samples[i] ) );
-	    }
-	    proc_work_registry_.push_back( regItem );
-	  }
-	} 
+      else if ((!legacy_ && mode == sistrip::READOUT_MODE_PROC_RAW)
+             || (legacy_ && (lmode == sistrip::READOUT_MODE_LEGACY_PROC_RAW_REAL || lmode == sistrip::READOUT_MODE_LEGACY_PROC_RAW_FAKE ))
+              ) {
+      
+        std::vector<uint16_t> samples; 
+      
+        /// create unpacker
+        sistrip::FEDRawChannelUnpacker unpacker = sistrip::FEDRawChannelUnpacker::procRawModeUnpacker(buffer->channel(iconn->fedCh()));
+      
+        /// unpack -> add check to make sure strip < nstrips && strip > last strip......
+        while (unpacker.hasData()) {samples.push_back(unpacker.adc());unpacker++;}
+      
+        if ( !samples.empty() ) { 
+          Registry regItem(key, 256*ipair, fragment.proc_digis.size(), samples.size());
+          for ( uint16_t i = 0, n = samples.size(); i < n; i++ ) {
+            fragment.proc_digis.push_back(  SiStripRawDigi( samples[i] ) );
+          }
+          fragment.proc_registry.push_back( regItem );
+        }
+      } 
 
-	else if ((!legacy_ && mode == sistrip::READOUT_MODE_SCOPE)
-               || (legacy_ && lmode == sistrip::READOUT_MODE_LEGACY_SCOPE)
-                ) {
-	
-	  std::vector<uint16_t> samples; 
-	
-	  /// create unpacker
-	  sistrip::FEDRawChannelUnpacker unpacker = sistrip::FEDRawChannelUnpacker::scopeModeUnpacker(buffer->channel(iconn->fedCh()));
+      else if ((!legacy_ && mode == sistrip::READOUT_MODE_SCOPE)
+             || (legacy_ && lmode == sistrip::READOUT_MODE_LEGACY_SCOPE)
+              ) {
+      
+        std::vector<uint16_t> samples; 
+      
+        /// create unpacker
+        sistrip::FEDRawChannelUnpacker unpacker = sistrip::FEDRawChannelUnpacker::scopeModeUnpacker(buffer->channel(iconn->fedCh()));
 
-	  /// unpack -> add check to make sure strip < nstrips && strip > last strip......
-	  while (unpacker.hasData()) {samples.push_back(unpacker.adc());unpacker++;}
-	
-	  if ( !samples.empty() ) { 
-	    Registry regItem(key, 0, scope_work_digis_.size(), samples.size());
-	    for ( uint16_t i = 0, n = samples.size(); i < n; i++ ) {
-	      scope_work_digis_.push_back(  SiStripRawDigi( samples[i] ) );
-	    }
-	    scope_work_registry_.push_back( regItem );
-	  }
-	} 
-	
-	else { // Unknown readout mode! => assume scope mode
+        /// unpack -> add check to make sure strip < nstrips && strip > last strip......
+        while (unpacker.hasData()) {samples.push_back(unpacker.adc());unpacker++;}
+      
+        if ( !samples.empty() ) { 
+          Registry regItem(key, 0, fragment.scope_digis.size(), samples.size());
+          for ( uint16_t i = 0, n = samples.size(); i < n; i++ ) {
+            fragment.scope_digis.push_back(  SiStripRawDigi( samples[i] ) );
+          }
+          fragment.scope_registry.push_back( regItem );
+        }
+      } 
+      
+      else { // Unknown readout mode! => assume scope mode
 
-          warnings_.add((boost::format("Unknown FED readout mode (%1%)! Assuming SCOPE MODE...") % mode).str());
+        fragment.addWarning((boost::format("Unknown FED readout mode (%1%)! Assuming SCOPE MODE...") % mode).str());
 
-	  std::vector<uint16_t> samples; 
-	
-	  /// create unpacker
-	  sistrip::FEDRawChannelUnpacker unpacker = sistrip::FEDRawChannelUnpacker::scopeModeUnpacker(buffer->channel(iconn->fedCh()));
-	
-	  /// unpack -> add check to make sure strip < nstrips && strip > last strip......
-	  while (unpacker.hasData()) {samples.push_back(unpacker.adc());unpacker++;}
-	
-	  if ( !samples.empty() ) { 
-	    Registry regItem(key, 0, scope_work_digis_.size(), samples.size());
-	    for ( uint16_t i = 0, n = samples.size(); i < n; i++ ) {
-	      scope_work_digis_.push_back(  SiStripRawDigi( samples[i] ) );
-	    }
-	    scope_work_registry_.push_back( regItem );
-	  
-	    if ( edm::isDebugEnabled() ) {
-	      std::stringstream ss;
-	      ss << "Extracted " << samples.size() 
-		 << " SCOPE MODE digis (samples[0] = " 
-		 << samples[0] 
-		 << ") from FED id/ch " 
-		 << iconn->fedId() 
-		 << "/" 
-		 << iconn->fedCh();
-	      LogTrace("SiStripRawToDigi") << ss.str();
-	    }
-	  } else {
-            warnings_.add("No SM digis found!");
+        std::vector<uint16_t> samples; 
+      
+        /// create unpacker
+        sistrip::FEDRawChannelUnpacker unpacker = sistrip::FEDRawChannelUnpacker::scopeModeUnpacker(buffer->channel(iconn->fedCh()));
+      
+        /// unpack -> add check to make sure strip < nstrips && strip > last strip......
+        while (unpacker.hasData()) {samples.push_back(unpacker.adc());unpacker++;}
+      
+        if ( !samples.empty() ) { 
+          Registry regItem(key, 0, fragment.scope_digis.size(), samples.size());
+          for ( uint16_t i = 0, n = samples.size(); i < n; i++ ) {
+            fragment.scope_digis.push_back(  SiStripRawDigi( samples[i] ) );
           }
-	}
-      } // channel loop
-    } // fed loop
+          fragment.scope_registry.push_back( regItem );
+        
+          if ( edm::isDebugEnabled() ) {
+            std::stringstream ss;
+            ss << "Extracted " << samples.size() 
+      	 << " SCOPE MODE digis (samples[0] = " 
+      	 << samples[0] 
+      	 << ") from FED id/ch " 
+      	 << iconn->fedId() 
+      	 << "/" 
+      	 << iconn->fedCh();
+            LogTrace("SiStripRawToDigi") << ss.str();
+          }
+        } else {
+          fragment.addWarning("No SM digis found!");
+        }
+      }
+    } // channel loop
+  }
 
-    // bad channels warning
-    unsigned int detIdsSize = detids.size();
-    if ( edm::isDebugEnabled() && detIdsSize ) {
-      std::ostringstream ss;
-      ss << "[sistrip::RawToDigiUnpacker::" << __func__ << "]"
-         << " Problems were found in data and " << detIdsSize << " channels could not be unpacked. "
-         << "See output of FED Hardware monitoring for more information. ";
-      edm::LogWarning(sistrip::mlRawToDigi_) << ss.str();
-    }
-    if( (errorThreshold_ != 0) && (detIdsSize > errorThreshold_) ) {
-      edm::LogError("TooManyErrors") << "Total number of errors = " << detIdsSize;
+  template <class T>
+  void RawToDigiUnpacker::appendWork( std::vector<Registry>& registry, std::vector<T>& digis, const std::vector<Registry>& fragment_registry, const std::vector<T>& fragment_digis ) {
+    const size_t offset = digis.size();
+    digis.insert( digis.end(), fragment_digis.begin(), fragment_digis.end() );
+    registry.reserve( registry.size() + fragment_registry.size() );
+    for ( const auto& regItem : fragment_registry ) {
+      registry.push_back( Registry( regItem.detid, regItem.first, regItem.index + offset, regItem.length ) );
     }
+  }
 
-    // update DetSetVectors
-    update(scope_mode, virgin_raw, proc_raw, zero_suppr, cm_values);
+  void RawToDigiUnpacker::mergeFragment( const FEDFragment& fragment, DetIdCollection& detids ) {
+    appendWork( zs_work_registry_, zs_work_digis_, fragment.zs_registry, fragment.zs_digis );
+    appendWork( virgin_work_registry_, virgin_work_digis_, fragment.virgin_registry, fragment.virgin_digis );
+    appendWork( proc_work_registry_, proc_work_digis_, fragment.proc_registry, fragment.proc_digis );
+    appendWork( scope_work_registry_, scope_work_digis_, fragment.scope_registry, fragment.scope_digis );
+    appendWork( cm_work_registry_, cm_work_digis_, fragment.cm_registry, fragment.cm_digis );
+    for ( uint32_t detid : fragment.detids ) { detids.push_back( detid ); }
+    for ( const auto& warning : fragment.warnings ) { warnings_.add( warning.first, warning.second ); }
+    if ( fragment.disableFedKey ) { useFedKey_ = false; }
+  }
 
-    // increment event counter
-    event_++;
-  
-    // no longer first event!
-    if ( first_ ) { first_ = false; }
-  
-    // final cleanup, just in case
-    cleanupWorkVectors();
+  void RawToDigiUnpacker::FEDFragment::clear() {
+    zs_registry.clear();      zs_digis.clear();
+    virgin_registry.clear();  virgin_digis.clear();
+    proc_registry.clear();    proc_digis.clear();
+    scope_registry.clear();   scope_digis.clear();
+    cm_registry.clear();      cm_digis.clear();
+    detids.clear();
+    warnings.clear();
+    disableFedKey = false;
   }
 
   void RawToDigiUnpacker::update( RawDigis& scope_mode, RawDigis& virgin_raw, RawDigis& proc_raw, Digis& zero_suppr, RawDigis& common_mode ) {
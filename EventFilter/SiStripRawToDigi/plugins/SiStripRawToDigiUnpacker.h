@@ -7,6 +7,7 @@
 #include "DataFormats/DetId/interface/DetIdCollection.h"
 #include "DataFormats/SiStripCommon/interface/SiStripConstants.h"
 #include "EventFilter/SiStripRawToDigi/interface/SiStripFEDBuffer.h"
+#include "EventFilter/Utilities/interface/ParallelFEDUnpacker.h"
 #include "boost/cstdint.hpp"
 #include <iostream>
 #include <string>
@@ -65,6 +66,9 @@ namespace sistrip {
 
     inline void legacy( bool );
 
+    /// unpacks the FEDs concurrently (unless the DAQ register is used)
+    inline void parallelUnpacking( bool );
+
     void printWarningSummary() const { warnings_.printSummary(); }
 
   private:
@@ -98,6 +102,15 @@ namespace sistrip {
     
     /// method to clear registries and digi collections
     void cleanupWorkVectors();
+
+    /// output of one FED, appended to the work vectors in the order of the cabling
+    struct FEDFragment;
+
+    /// unpacks one FED into its fragment
+    void unpackFED( uint16_t fed_id, const SiStripFedCabling&, const FEDRawDataCollection&, SiStripEventSummary&, bool& first_fed, FEDFragment& );
+
+    /// appends a fragment to the work vectors
+    void mergeFragment( const FEDFragment&, DetIdCollection& );
     
     /// private class to register start and end index of digis in a collection
     class Registry {
@@ -113,6 +126,21 @@ namespace sistrip {
       size_t index;
       uint16_t length;
     };
+
+    template <class T>
+    static void appendWork( std::vector<Registry>& registry, std::vector<T>& digis, const std::vector<Registry>& fragment_registry, const std::vector<T>& fragment_digis );
+
+    struct FEDFragment {
+      std::vector<Registry> zs_registry, virgin_registry, scope_registry, proc_registry, cm_registry;
+      std::vector<SiStripDigi> zs_digis;
+      std::vector<SiStripRawDigi> virgin_digis, scope_digis, proc_digis, cm_digis;
+      std::vector<uint32_t> detids;
+      /// warnings, added to the summary when the fragment is merged
+      std::vector<std::pair<std::string,std::string>> warnings;
+      bool disableFedKey = false;
+      void addWarning( const std::string& message, const std::string& details = "" ) { warnings.emplace_back(message, details); }
+      void clear();
+    };
     
     /// configurables
     int16_t headerBytes_;
@@ -133,6 +161,7 @@ namespace sistrip {
     bool doFullCorruptBufferChecks_;
     bool doAPVEmulatorCheck_;
     bool legacy_;
+    bool parallelUnpacking_;
     uint32_t errorThreshold_;
     
     /// registries
@@ -167,6 +196,8 @@ namespace sistrip {
       std::vector<std::pair<std::string,std::size_t>> m_warnings;
     };
     WarningSummary warnings_;
+
+    evf::ParallelFEDUnpacker<FEDFragment> fedUnpacker_;
   };
 }
 
@@ -205,6 +236,8 @@ void sistrip::RawToDigiUnpacker::doAPVEmulatorCheck( bool do_APVEmulator_check)
 
 void sistrip::RawToDigiUnpacker::legacy( bool legacy ) { legacy_ = legacy; }
 
+void sistrip::RawToDigiUnpacker::parallelUnpacking( bool parallel ) { parallelUnpacking_ = parallel; }
+
 #endif // EventFilter_SiStripRawToDigi_SiStripRawToDigiUnpacker_H
 
 
@@ -12,6 +12,7 @@ siStripDigis = cms.EDProducer(
     TriggerFedId      = cms.int32(0),
     #FedEventDumpFreq  = cms.untracked.int32(0),
     #FedBufferDumpFreq = cms.untracked.int32(0),
+    #ParallelUnpacking = cms.untracked.bool(False),
     UnpackCommonModeValues = cms.bool(False),
     DoAllCorruptBufferChecks = cms.bool(False),
     DoAPVEmulatorCheck = cms.bool(False),
@@ -61,6 +61,7 @@ private:
   evf::EvFDaqDirector::FileStatus nextEvent();
   evf::EvFDaqDirector::FileStatus getNextEvent();
   edm::Timestamp fillFEDRawDataCollection(FEDRawDataCollection&);
+  void releaseChunk(InputChunk*);
   void deleteFile(std::string const&);
   int grabNextJsonFile(boost::filesystem::path const&);
 
@@ -169,6 +170,12 @@ private:
   std::mutex mWakeup_;
   std::condition_variable cvWakeup_;
 
+  //variables for the zero-copy mode: the FEDRawData of an event contiguous
+  //in a chunk reference it, events across chunks are assembled in stitchBuffer_
+  bool zeroCopy_;
+  InputChunk *eventChunk_ = nullptr;
+  std::vector<unsigned char> stitchBuffer_;
+
   //variables for the single buffered mode
   bool singleBufferMode_;
   int fileDescriptor_ = -1;
@@ -190,6 +197,8 @@ struct InputChunk {
   unsigned int offset_;
   unsigned int fileIndex_;
   std::atomic<bool> readComplete_;
+  //the reader and the events referencing the chunk, freed when it drops to 0
+  std::atomic<unsigned int> users_;
 
   InputChunk(unsigned int index, uint32_t size): size_(size),index_(index) {
     buf_ = new unsigned char[size_];
@@ -200,6 +209,7 @@ struct InputChunk {
     usedSize_=toRead;
     fileIndex_=fileIndex;
     readComplete_=false;
+    users_=1;
   }
 
   ~InputChunk() {delete[] buf_;}
@@ -244,6 +254,7 @@ struct InputFile {
     return chunks_[chunkid]!=nullptr && chunks_[chunkid]->readComplete_;
   }
   bool advance(unsigned char* & dataPosition, const size_t size);
+  bool copyAndAdvance(unsigned char* destination, const size_t size);
   void moveToPreviousChunk(const size_t size, const size_t offset);
   void rewindChunk(const size_t size);
 };
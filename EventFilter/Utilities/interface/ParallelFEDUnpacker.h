@@ -0,0 +1,98 @@
+#ifndef EventFilter_Utilities_ParallelFEDUnpacker_h
+#define EventFilter_Utilities_ParallelFEDUnpacker_h
+
+/** \class evf::ParallelFEDUnpacker
+ *
+ * Helper for the RawToDigi producers, unpacking the FEDs of an event in
+ * concurrent TBB tasks. The FED list is split in contiguous blocks, each
+ * block is unpacked into its own output fragment and the fragments are
+ * then merged into the event products one after the other, in the order
+ * of the FED list, so that the products are the same as those of a
+ * sequential loop over the FEDs.
+ *
+ * A Fragment holds the output of a block (and, if needed, the unpacking
+ * state that cannot be shared between tasks) and provides clear(), which
+ * is called before a block is unpacked into it. The fragments are kept
+ * from one event to the next to reuse their memory.
+ *
+ * With maxFragments = 0 every FED has its own fragment, created on demand.
+ * Otherwise the FEDs are split in at most maxFragments blocks and the
+ * fragments are created in the constructor, so that the producer can
+ * configure them (fragment(i)) before the first event.
+ *
+ * The sequential mode unpacks and merges block by block using the first
+ * fragment only: it is meant for the configurations in which unpacking a
+ * FED depends on the FEDs unpacked before it.
+ */
+
+#include <algorithm>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <vector>
+
+#include "tbb/parallel_for.h"
+
+namespace evf {
+
+  template <typename Fragment>
+  class ParallelFEDUnpacker {
+  public:
+    typedef std::function<std::unique_ptr<Fragment>()> Factory;
+
+    explicit ParallelFEDUnpacker(unsigned int maxFragments = 0,
+                                 Factory factory = [] { return std::make_unique<Fragment>(); })
+        : maxFragments_(maxFragments), factory_(std::move(factory)) {
+      for (unsigned int i = 0; i < maxFragments_; ++i)
+        fragments_.emplace_back(factory_());
+    }
+
+    unsigned int maxFragments() const { return maxFragments_; }
+    unsigned int numberOfFragments() const { return fragments_.size(); }
+    Fragment& fragment(unsigned int i) { return *fragments_[i]; }
+    const Fragment& fragment(unsigned int i) const { return *fragments_[i]; }
+
+    /// Calls unpack(fedId, fragment) for every FED id of the (random access)
+    /// range fedIds, then merge(fragment) for every block, in order.
+    template <typename FEDIds, typename Unpack, typename Merge>
+    void run(const FEDIds& fedIds, Unpack const& unpack, Merge const& merge, bool parallel = true) {
+      const auto first = std::begin(fedIds);
+      const size_t nFeds = std::distance(first, std::end(fedIds));
+      if (nFeds == 0)
+        return;
+      const size_t nBlocks = maxFragments_ == 0 ? nFeds : std::min<size_t>(maxFragments_, nFeds);
+      auto unpackBlock = [&](size_t block, Fragment& fragment) {
+        fragment.clear();
+        for (size_t i = blockBegin(block, nBlocks, nFeds); i < blockBegin(block + 1, nBlocks, nFeds); ++i)
+          unpack(first[i], fragment);
+      };
+
+      while (fragments_.size() < (parallel ? nBlocks : 1))
+        fragments_.emplace_back(factory_());
+
+      if (parallel && nBlocks > 1) {
+        tbb::parallel_for(size_t(0), nBlocks, [&](size_t block) { unpackBlock(block, *fragments_[block]); });
+        for (size_t block = 0; block < nBlocks; ++block)
+          merge(*fragments_[block]);
+      } else {
+        for (size_t block = 0; block < nBlocks; ++block) {
+          unpackBlock(block, *fragments_[0]);
+          merge(*fragments_[0]);
+        }
+      }
+    }
+
+  private:
+    // blocks of (almost) the same number of FEDs, the first ones one FED larger
+    static size_t blockBegin(size_t block, size_t nBlocks, size_t nFeds) {
+      return block * (nFeds / nBlocks) + std::min(block, nFeds % nBlocks);
+    }
+
+    const unsigned int maxFragments_;
+    const Factory factory_;
+    std::vector<std::unique_ptr<Fragment>> fragments_;
+  };
+
+}  // namespace evf
+
+#endif  // EventFilter_Utilities_ParallelFEDUnpacker_h
@@ -21,6 +21,7 @@
 #include "DataFormats/FEDRawData/interface/FEDHeader.h"
 #include "DataFormats/FEDRawData/interface/FEDTrailer.h"
 #include "DataFormats/FEDRawData/interface/FEDRawDataCollection.h"
+#include "DataFormats/FEDRawData/interface/FEDRawDataCollectionStreamer.h"
 
 #include "DataFormats/TCDS/interface/TCDSRaw.h"
 
@@ -130,6 +131,14 @@ FedRawDataInputSource::FedRawDataInputSource(edm::ParameterSet const& pset,
   singleBufferMode_ = !(numBuffers_>1);
   readingFilesCount_=0;
 
+  //the single buffer is overwritten by the next read, its events are always copied
+  zeroCopy_ = pset.getUntrackedParameter<bool> ("zeroCopyFEDRawData", false) && !singleBufferMode_;
+  if (zeroCopy_) {
+    //referenced data are copied when the event is written
+    setFEDRawDataCollectionStreamerInTClass();
+    edm::LogInfo("FedRawDataInputSource") << "FEDRawData reference the input chunks until the events are processed";
+  }
+
   if (!crc32c_hw_test())
     edm::LogError("FedRawDataInputSource::FedRawDataInputSource") << "Intel crc32c checksum computation unavailable";
 
@@ -227,6 +236,7 @@ void FedRawDataInputSource::fillDescriptions(edm::ConfigurationDescriptions& des
   desc.addUntracked<bool> ("verifyAdler32", true)->setComment("Verify event Adler32 checksum with FRDv3 or v4");
   desc.addUntracked<bool> ("verifyChecksum", true)->setComment("Verify event CRC-32C checksum of FRDv5 or higher");
   desc.addUntracked<bool> ("useL1EventID", false)->setComment("Use L1 event ID from FED header if true or from TCDS FED if false");
+  desc.addUntracked<bool> ("zeroCopyFEDRawData", false)->setComment("FEDRawData reference the input buffers instead of copying them (requires numBuffers > 1, more buffers are needed since a buffer is reused only when its events are processed)");
   desc.addUntracked<bool> ("fileListMode", false)->setComment("Use fileNames parameter to directly specify raw files to open");
   desc.addUntracked<std::vector<std::string>> ("fileNames", std::vector<std::string>())->setComment("file list used when fileListMode is enabled");
   desc.setAllowAnything();
@@ -447,7 +457,7 @@ inline evf::EvFDaqDirector::FileStatus FedRawDataInputSource::getNextEvent()
   if (currentFile_->bufferPosition_==currentFile_->fileSize_) {
     readingFilesCount_--;
     //release last chunk (it is never released elsewhere)
-    freeChunks_.push(currentFile_->chunks_[currentFile_->currentChunk_]);
+    releaseChunk(currentFile_->chunks_[currentFile_->currentChunk_]);
     if (currentFile_->nEvents_>=0 && currentFile_->nEvents_!=int(currentFile_->nProcessed_))
     {
       throw cms::Exception("FedRawDataInputSource::getNextEvent")
@@ -544,6 +554,65 @@ inline evf::EvFDaqDirector::FileStatus FedRawDataInputSource::getNextEvent()
     //last chunk is released when this function is invoked next time
 
   }
+  //multibuffer mode, events are referenced in the chunks:
+  else if (zeroCopy_)
+  {
+    //wait for the current chunk to become added to the vector
+    if (fms_) fms_->setInState(evf::FastMonitoringThread::inWaitChunk);
+    while (!currentFile_->waitForChunk(currentFile_->currentChunk_)) {
+      usleep(10000);
+      if (setExceptionState_) threadError();
+    }
+    if (fms_) fms_->setInState(evf::FastMonitoringThread::inChunkReceived);
+
+    chunkIsFree_ = false;
+    const uint32_t headerSize = FRDHeaderVersionSize[detectedFRDversion_];
+    InputChunk *chunk = currentFile_->chunks_[currentFile_->currentChunk_];
+    const size_t currentLeft = chunk->size_ - currentFile_->chunkPosition_;
+    unsigned char *dataPosition = chunk->buf_ + currentFile_->chunkPosition_;
+
+    if (currentLeft >= headerSize && FRDEventMsgView(dataPosition).size() <= currentLeft) {
+      //everything is in a single chunk, only move pointers forward
+      event_.reset( new FRDEventMsgView(dataPosition) );
+      if (currentFile_->fileSize_ - currentFile_->bufferPosition_ < event_->size())
+      {
+        throw cms::Exception("FedRawDataInputSource::getNextEvent") <<
+          "Premature end of input file while reading event data";
+      }
+      bool chunkEnd = currentFile_->advance(dataPosition,event_->size());
+      assert(!chunkEnd);
+      eventChunk_ = chunk;
+    }
+    else {
+      //the event is at the chunk boundary: it is copied to a separate buffer,
+      //the chunk can not be modified while previous events reference it
+      stitchBuffer_.resize(headerSize);
+      bool chunkEnd = currentFile_->copyAndAdvance(stitchBuffer_.data(),headerSize);
+
+      event_.reset( new FRDEventMsgView(stitchBuffer_.data()) );
+      if (event_->size()>eventChunkSize_) {
+        throw cms::Exception("FedRawDataInputSource::getNextEvent")
+                << " event id:"<< event_->event()<< " lumi:" << event_->lumi()
+                << " run:" << event_->run() << " of size:" << event_->size()
+                << " bytes does not fit into a chunk of size:" << eventChunkSize_ << " bytes";
+      }
+
+      const uint32_t msgSize = event_->size()-headerSize;
+
+      if (currentFile_->fileSize_ - currentFile_->bufferPosition_ < msgSize)
+      {
+        throw cms::Exception("FedRawDataInputSource::getNextEvent") <<
+          "Premature end of input file while reading event data";
+      }
+      stitchBuffer_.resize(event_->size());
+      if (currentFile_->copyAndAdvance(stitchBuffer_.data()+headerSize,msgSize)) chunkEnd = true;
+      assert(chunkEnd);
+      event_.reset( new FRDEventMsgView(stitchBuffer_.data()) );
+      //previous chunk is released after reading the event
+      chunkIsFree_ = true;
+      eventChunk_ = nullptr;
+    }
+  }
   //multibuffer mode:
   else
   {
@@ -738,8 +807,9 @@ void FedRawDataInputSource::read(edm::EventPrincipal& eventPrincipal)
     }
 
   }
-  if (chunkIsFree_) freeChunks_.push(currentFile_->chunks_[currentFile_->currentChunk_-1]);
+  if (chunkIsFree_) releaseChunk(currentFile_->chunks_[currentFile_->currentChunk_-1]);
   chunkIsFree_=false;
+  eventChunk_=nullptr;
   if (fms_) fms_->setInState(evf::FastMonitoringThread::inNoRequest);
   return;
 }
@@ -757,6 +827,14 @@ edm::Timestamp FedRawDataInputSource::fillFEDRawDataCollection(FEDRawDataCollect
   unsigned char* event = (unsigned char*)event_->payload();
   GTPEventID_=0;
   tcds_pointer_ = nullptr;
+
+  //the chunk is reused when the last FEDRawData referencing it is deleted
+  std::shared_ptr<const void> chunkHolder;
+  if (eventChunk_) {
+    eventChunk_->users_++;
+    chunkHolder.reset(eventChunk_,[this](InputChunk* chunk) {releaseChunk(chunk);});
+  }
+
   while (eventSize > 0) {
     assert(eventSize>=FEDTrailer::length);
     eventSize -= FEDTrailer::length;
@@ -790,14 +868,26 @@ edm::Timestamp FedRawDataInputSource::fillFEDRawDataCollection(FEDRawDataCollect
       }
     }
     FEDRawData& fedData = rawData.FEDData(fedId);
-    fedData.resize(fedSize);
-    memcpy(fedData.data(), event + eventSize, fedSize);
+    if (chunkHolder) {
+      fedData = FEDRawData(chunkHolder, event + eventSize, fedSize);
+    }
+    else {
+      fedData.resize(fedSize);
+      memcpy(fedData.data(), event + eventSize, fedSize);
+    }
   }
   assert(eventSize == 0);
 
   return tstamp;
 }
 
+void FedRawDataInputSource::releaseChunk(InputChunk* chunk)
+{
+  //called by the source and, in the zero-copy mode, when an event is deleted
+  if (chunk->users_.fetch_sub(1)==1)
+    freeChunks_.push(chunk);
+}
+
 int FedRawDataInputSource::grabNextJsonFile(boost::filesystem::path const& jsonSourcePath)
 {
   std::string data;
@@ -1308,6 +1398,41 @@ inline bool InputFile::advance(unsigned char* & dataPosition, const size_t size)
   }
 }
 
+//copy data to the destination, continuing in the next chunk if needed;
+//the chunks are not modified
+inline bool InputFile::copyAndAdvance(unsigned char* destination, const size_t size)
+{
+  //wait for chunk
+  while (!waitForChunk(currentChunk_)) {
+    usleep(100000);
+    if (parent_->exceptionState()) parent_->threadError();
+  }
+
+  unsigned char *dataPosition = chunks_[currentChunk_]->buf_+ chunkPosition_;
+  size_t currentLeft = chunks_[currentChunk_]->size_ - chunkPosition_;
+
+  if (currentLeft < size) {
+
+    //we need next chunk
+    while (!waitForChunk(currentChunk_+1)) {
+      usleep(100000);
+      if (parent_->exceptionState()) parent_->threadError();
+    }
+    memcpy(destination, dataPosition, currentLeft);
+    memcpy(destination + currentLeft, chunks_[currentChunk_+1]->buf_, size - currentLeft);
+    bufferPosition_+=size;
+    chunkPosition_=size-currentLeft;
+    currentChunk_++;
+    return true;
+  }
+  else {
+    memcpy(destination, dataPosition, size);
+    chunkPosition_+=size;
+    bufferPosition_+=size;
+    return false;
+  }
+}
+
 inline void InputFile::moveToPreviousChunk(const size_t size, const size_t offset)
 {
   //this will fail in case of events that are too large
@@ -29,6 +29,18 @@ options.register ('numThreads',
                   VarParsing.VarParsing.varType.int,          # string, int, or float
                   "Number of CMSSW threads")
 
+options.register ('zeroCopy',
+                  False, # default value
+                  VarParsing.VarParsing.multiplicity.singleton,
+                  VarParsing.VarParsing.varType.bool,
+                  "FEDRawData reference the input buffers instead of copying them")
+
+options.register ('numBuffers',
+                  2, # default value
+                  VarParsing.VarParsing.multiplicity.singleton,
+                  VarParsing.VarParsing.varType.int,
+                  "Number of input buffers (more are needed with zeroCopy and many threads)")
+
 options.parseArguments()
 
 cmsswbase = os.path.expandvars("$CMSSW_BASE/")
@@ -91,10 +103,17 @@ process.source = cms.Source("FedRawDataInputSource",
     verifyChecksum = cms.untracked.bool(True),
     useL1EventID = cms.untracked.bool(True),
     eventChunkSize = cms.untracked.uint32(16),
-    numBuffers = cms.untracked.uint32(2),
-    eventChunkBlock = cms.untracked.uint32(1)
+    numBuffers = cms.untracked.uint32(options.numBuffers),
+    eventChunkBlock = cms.untracked.uint32(1),
+    zeroCopyFEDRawData = cms.untracked.bool(options.zeroCopy)
     )
 
+#events/s of the source with and without copies of the FED data, e.g.
+#  cmsRun startFU.py numThreads=8 numBuffers=8 zeroCopy=True
+process.Timing = cms.Service("Timing",
+    summaryOnly = cms.untracked.bool(True)
+)
+
 process.PrescaleService = cms.Service( "PrescaleService",
                                        forceDefault = cms.bool( False ),
                                        prescaleTable = cms.VPSet( 
@@ -35,6 +35,18 @@ namespace edm {
     template<typename T, typename Iterator>
     size_t loopSpecified(EventPrincipal& cache, size_t& fileNameHash, Iterator const& begin, Iterator const& end, T eventOperator);
 
+    /// Read one event of a random sequence using only the given engine: the
+    /// first event of a sequence (newSequence) is drawn at random, file first
+    /// and then entry, and the following ones are read after it in the same
+    /// file. Unlike loopOverEvents, the events do not depend on the events read
+    /// before the sequence, so several sources on the same files select the
+    /// same events for the same engine state.
+    bool readOneIndependentRandom(EventPrincipal& cache, size_t& fileNameHash, CLHEP::HepRandomEngine* engine, bool newSequence);
+
+    /// Estimate of the memory, in bytes, used by the products of an event
+    /// of the current file once read, 0 if unknown.
+    size_t averageEventSize() const;
+
     void dropUnwantedBranches(std::vector<std::string> const& wantedBranches);
     //
     /// Called at beginning of job
@@ -61,6 +73,8 @@ namespace edm {
       readOneSpecified(cache, fileNameHash, info);
     }
 
+    virtual bool readOneIndependentRandom_(EventPrincipal& cache, size_t& fileNameHash, CLHEP::HepRandomEngine*, bool newSequence) = 0;
+    virtual size_t averageEventSize_() const = 0;
     virtual void dropUnwantedBranches_(std::vector<std::string> const& wantedBranches) = 0;
     virtual void beginJob() = 0;
     virtual void endJob() = 0;
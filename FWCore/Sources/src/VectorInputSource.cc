@@ -15,6 +15,17 @@ namespace edm {
 
   VectorInputSource::~VectorInputSource() {}
 
+  bool
+  VectorInputSource::readOneIndependentRandom(EventPrincipal& cache, size_t& fileNameHash, CLHEP::HepRandomEngine* engine, bool newSequence) {
+    clearEventPrincipal(cache);
+    return this->readOneIndependentRandom_(cache, fileNameHash, engine, newSequence);
+  }
+
+  size_t
+  VectorInputSource::averageEventSize() const {
+    return this->averageEventSize_();
+  }
+
   void
   VectorInputSource::dropUnwantedBranches(std::vector<std::string> const& wantedBranches) {
     this->dropUnwantedBranches_(wantedBranches);
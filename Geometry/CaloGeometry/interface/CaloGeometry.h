@@ -34,6 +34,9 @@ class CaloGeometry
       /// Get the position of a given detector id
       GlobalPoint getPosition( const DetId& id ) const;
 
+      /// Get the positions of a set of detector ids at once, (0,0,0) for the ids not found
+      void getPositions( const std::vector<DetId>& ids, std::vector<GlobalPoint>& positions ) const;
+
       /// Get the cell geometry of a given detector id
       std::shared_ptr<const CaloCellGeometry> getGeometry( const DetId& id ) const;
 
@@ -8,6 +8,7 @@
 #include <atomic>
 #endif
 #include "DataFormats/DetId/interface/DetId.h"
+#include "DataFormats/DetId/interface/DetIdIndexMap.h"
 #include "DataFormats/GeometryVector/interface/GlobalPoint.h"
 #include "Geometry/CaloGeometry/interface/CaloCellGeometry.h"
 #include "DataFormats/Math/interface/deltaR.h"
@@ -136,9 +137,11 @@ private:
 #if !defined(__CINT__) && !defined(__MAKECINT__) && !defined(__REFLEX__)
   mutable std::atomic<std::vector<CCGFloat>*>  m_deltaPhi ;
   mutable std::atomic<std::vector<CCGFloat>*>  m_deltaEta ;
+  mutable std::atomic<DetIdIndexMap*>          m_validIdIndex ;
 #else
   mutable std::vector<CCGFloat>*  m_deltaPhi ;
   mutable std::vector<CCGFloat>*  m_deltaEta ;
+  mutable DetIdIndexMap*          m_validIdIndex ;
 #endif
 };
 
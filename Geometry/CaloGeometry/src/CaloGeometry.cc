@@ -81,6 +81,25 @@ CaloGeometry::getPosition( const DetId& id ) const {
   }
 }
 
+void
+CaloGeometry::getPositions( const std::vector<DetId>& ids, std::vector<GlobalPoint>& positions ) const {
+  positions.resize( ids.size() );
+  // the ids usually come grouped by subdetector: look up the subdetector geometry once per group
+  DetId::Detector lastDet = DetId::Detector(0);
+  int lastSubdet = -1;
+  const CaloSubdetectorGeometry* geom = nullptr;
+  for( unsigned int i ( 0 ) ; i != ids.size() ; ++i ) {
+    const DetId& id = ids[i];
+    if( id.det() != lastDet || id.subdetId() != lastSubdet ) {
+      lastDet = id.det();
+      lastSubdet = id.subdetId();
+      geom = getSubdetectorGeometry( id );
+    }
+    auto cell = geom ? geom->getGeometry( id ) : std::shared_ptr<const CaloCellGeometry>();
+    positions[i] = cell ? cell->getPosition() : notFound;
+  }
+}
+
 std::shared_ptr<const CaloCellGeometry>
 CaloGeometry::getGeometry( const DetId& id ) const {
   const CaloSubdetectorGeometry* geom = getSubdetectorGeometry(id);
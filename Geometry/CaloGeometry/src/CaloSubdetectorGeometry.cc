@@ -16,7 +16,8 @@ CaloSubdetectorGeometry::CaloSubdetectorGeometry() :
    m_parMgr ( nullptr ) ,
    m_cmgr   ( nullptr ) ,
    m_deltaPhi  (nullptr) ,
-   m_deltaEta  (nullptr)
+   m_deltaEta  (nullptr) ,
+   m_validIdIndex (nullptr)
 {}
 
 
@@ -26,6 +27,7 @@ CaloSubdetectorGeometry::~CaloSubdetectorGeometry()
    delete m_parMgr ; 
    if (m_deltaPhi) delete m_deltaPhi.load() ;
    if (m_deltaEta) delete m_deltaEta.load() ;
+   if (m_validIdIndex) delete m_validIdIndex.load() ;
 }
 
 void
@@ -50,7 +52,19 @@ CaloSubdetectorGeometry::getGeometry( const DetId& id ) const
 
 bool 
 CaloSubdetectorGeometry::present( const DetId& id ) const {
-  return std::find(m_validIds.begin(),m_validIds.end(),id)!=m_validIds.end();
+  // hash index of the valid ids, built at the first call
+  if(!m_validIdIndex.load(std::memory_order_acquire)) {
+    auto ptr = new DetIdIndexMap;
+    for( unsigned int i ( 0 ) ; i != m_validIds.size() ; ++i ) ptr->insert( m_validIds[i], i ) ;
+    DetIdIndexMap* expect = nullptr;
+    bool exchanged = m_validIdIndex.compare_exchange_strong(expect, ptr, std::memory_order_acq_rel);
+    if (!exchanged) delete ptr;
+  }
+  const DetIdIndexMap* index = m_validIdIndex.load(std::memory_order_acquire);
+  // cells added after the index was built (while filling the geometry), or duplicated ids
+  if( index->size() != m_validIds.size() )
+    return std::find(m_validIds.begin(),m_validIds.end(),id)!=m_validIds.end();
+  return index->contains( id );
 }
 
 DetId 
@@ -301,8 +315,9 @@ unsigned int CaloSubdetectorGeometry::sizeForDenseIndex(const DetId& id) const {
 
 std::shared_ptr<const CaloCellGeometry> 
 CaloSubdetectorGeometry::cellGeomPtr(uint32_t index) const {
-  // Default version
+  // Default version: the cells are owned by the geometry, and the pointer
+  // shares ownership with nothing (no control block allocated per call)
   auto ptr = getGeometryRawPtr(index);
-  static const auto do_not_delete = [](const void*){};
-  return ptr == nullptr ? nullptr : std::shared_ptr<const CaloCellGeometry>(ptr, do_not_delete);
+  static const std::shared_ptr<const CaloCellGeometry> no_owner;
+  return ptr == nullptr ? nullptr : std::shared_ptr<const CaloCellGeometry>(no_owner, ptr);
 }
@@ -1,6 +1,7 @@
 #ifndef Geometry_TrackingGeometryAligner_GeometryAligner_h
 #define Geometry_TrackingGeometryAligner_GeometryAligner_h
 
+#include <map>
 #include <vector>
 #include <algorithm>
 #include <iterator>
@@ -61,14 +62,19 @@ void GeometryAligner::applyAlignments( C* geometry,
   edm::LogInfo("Alignment") << "@SUB=GeometryAligner::applyAlignments" 
 			    << "Starting to apply alignments.";
 
+  // order the GeomDets by DetId
+  std::map<unsigned int, GeomDet const *> theMap;
+  for ( auto det : geometry->dets() )
+    theMap.emplace(det->geographicalId().rawId(), det);
+
   // Preliminary checks (or we can't loop!)
-  if ( alignments->m_align.size() != geometry->theMap.size() )
+  if ( alignments->m_align.size() != theMap.size() )
 	throw cms::Exception("GeometryMismatch") 
-	  << "Size mismatch between geometry (size=" << geometry->theMap.size() 
+	  << "Size mismatch between geometry (size=" << theMap.size() 
 	  << ") and alignments (size=" << alignments->m_align.size() << ")";
   if ( alignments->m_align.size() != alignmentErrors->m_alignError.size() )
 	throw cms::Exception("GeometryMismatch") 
-	  << "Size mismatch between geometry (size=" << geometry->theMap.size() 
+	  << "Size mismatch between geometry (size=" << theMap.size() 
 	  << ") and alignment errors (size=" << alignmentErrors->m_alignError.size() << ")";
 
   const AlignTransform::Translation &globalShift = globalCoordinates.translation();
@@ -79,9 +85,6 @@ void GeometryAligner::applyAlignments( C* geometry,
   std::vector<AlignTransform>::const_iterator iAlign = alignments->m_align.begin();
   std::vector<AlignTransformErrorExtended>::const_iterator 
 	iAlignError = alignmentErrors->m_alignError.begin();
-  //copy  geometry->theMap to a real map to order it....
-  std::map<unsigned int, GeomDet const *> theMap;
-  std::copy(geometry->theMap.begin(), geometry->theMap.end(), std::inserter(theMap,theMap.begin()));
   unsigned int nAPE = 0;
   for ( auto iPair = theMap.begin(); 
 	iPair != theMap.end(); ++iPair, ++iAlign, ++iAlignError )
@@ -131,9 +134,10 @@ void GeometryAligner::attachSurfaceDeformations( C* geometry,
   edm::LogInfo("Alignment") << "@SUB=GeometryAligner::attachSurfaceDeformations" 
 			    << "Starting to attach surface deformations.";
 
-  //copy geometry->theMapUnit to a real map to order it....
+  // order the GeomDetUnits by DetId
   std::map<unsigned int, GeomDetUnit const*> theMap;
-  std::copy(geometry->theMapUnit.begin(), geometry->theMapUnit.end(), std::inserter(theMap, theMap.begin()));
+  for ( auto det : geometry->detUnits() )
+    theMap.emplace(det->geographicalId().rawId(), det);
   
   unsigned int nSurfDef = 0;
   unsigned int itemIndex = 0;
@@ -4,6 +4,7 @@
 #include "Geometry/CommonDetUnit/interface/TrackingGeometry.h"
 #include "Geometry/CommonDetUnit/interface/GeomDetEnumerators.h"
 #include "Geometry/CommonDetUnit/interface/TrackerGeomDet.h"
+#include "DataFormats/DetId/interface/DetIdIndexMap.h"
 
 class GeometricDet;
 
@@ -64,6 +65,15 @@ public:
   const TrackerGeomDet*    idToDetUnit(DetId) const override;
   const TrackerGeomDet*    idToDet(DetId)     const override;
 
+  /// position of the GeomDetUnit in detUnits() (i.e. its index()), or DetIdIndexMap::invalidIndex
+  unsigned int detUnitIndex(DetId id) const { return theUnitIndex.find(id); }
+  /// position of the GeomDet in dets() (i.e. its gdetIndex()), or DetIdIndexMap::invalidIndex
+  unsigned int detIndex(DetId id) const { return theDetIndex.find(id); }
+
+  /// bulk versions of idToDetUnit and idToDet: nullptr for the ids not in the geometry
+  void idToDetUnits(const std::vector<DetId>& ids, std::vector<const TrackerGeomDet*>& dets) const;
+  void idToDets(const std::vector<DetId>& ids, std::vector<const TrackerGeomDet*>& dets) const;
+
   const GeomDetEnumerators::SubDetector geomDetSubDetector(int subdet) const;
   unsigned int numberOfLayers(int subdet) const;
   bool isThere(GeomDetEnumerators::SubDetector subdet) const;
@@ -104,8 +114,8 @@ private:
   DetContainer      theDets;      // owns *ONLY* the GeomDet * corresponding to GluedDets.
   DetIdContainer    theDetUnitIds;
   DetIdContainer    theDetIds; 
-  mapIdToDetUnit    theMapUnit; // does not own GeomDetUnit *
-  mapIdToDet        theMap;     // does not own GeomDet *
+  DetIdIndexMap     theUnitIndex; // DetId -> position in theDetUnits
+  DetIdIndexMap     theDetIndex;  // DetId -> position in theDets
 
   DetContainer      thePXBDets; // not owned: they're also in 'theDets'
   DetContainer      thePXFDets; // not owned: they're also in 'theDets'
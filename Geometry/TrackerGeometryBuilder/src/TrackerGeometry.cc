@@ -103,6 +103,8 @@ void TrackerGeometry::finalize() {
     theDets.shrink_to_fit();     // owns *ONLY* the GeomDet * corresponding to GluedDets.
     theDetUnitIds.shrink_to_fit();
     theDetIds.shrink_to_fit();
+    theUnitIndex.shrink_to_fit();
+    theDetIndex.shrink_to_fit();
   
     thePXBDets.shrink_to_fit(); // not owned: they're also in 'theDets'
     thePXFDets.shrink_to_fit(); // not owned: they're also in 'theDets'
@@ -120,7 +122,7 @@ void TrackerGeometry::addDetUnit(GeomDet const * p) {
   // set index
   const_cast<GeomDet *>(p)->setIndex(theDetUnits.size());
   theDetUnits.emplace_back(p);  // add to vector
-  theMapUnit.insert(std::make_pair(p->geographicalId().rawId(),p));
+  theUnitIndex.insert(p->geographicalId(),theDetUnits.size()-1);
 }
 
 void TrackerGeometry::addDetUnitId(DetId p){
@@ -131,7 +133,7 @@ void TrackerGeometry::addDet(GeomDet const * p) {
   // set index
   const_cast<GeomDet *>(p)->setGdetIndex(theDets.size());
   theDets.emplace_back(p);  // add to vector
-  theMap.insert(std::make_pair(p->geographicalId().rawId(),p));
+  theDetIndex.insert(p->geographicalId(),theDets.size()-1);
   DetId id(p->geographicalId());
   switch(id.subdetId()){
   case PixelSubdetector::PixelBarrel:
@@ -201,9 +203,9 @@ TrackerGeometry::detsTEC() const
 const TrackerGeomDet * 
 TrackerGeometry::idToDetUnit(DetId s)const
 {
-  mapIdToDetUnit::const_iterator p=theMapUnit.find(s.rawId());
-  if (p != theMapUnit.end()) {
-    return static_cast<const TrackerGeomDet *>(p->second);
+  unsigned int index = theUnitIndex.find(s);
+  if (index != DetIdIndexMap::invalidIndex) {
+    return static_cast<const TrackerGeomDet *>(theDetUnits[index]);
   } else {
     throw cms::Exception("WrongTrackerSubDet") << "Invalid DetID: no GeomDetUnit associated with raw ID "
 					       << s.rawId() << " of subdet ID " << s.subdetId();
@@ -213,15 +215,35 @@ TrackerGeometry::idToDetUnit(DetId s)const
 const TrackerGeomDet* 
 TrackerGeometry::idToDet(DetId s)const
 {
-  mapIdToDet::const_iterator p=theMap.find(s.rawId());
-  if (p != theMap.end()) {
-    return static_cast<const TrackerGeomDet *>(p->second);
+  unsigned int index = theDetIndex.find(s);
+  if (index != DetIdIndexMap::invalidIndex) {
+    return static_cast<const TrackerGeomDet *>(theDets[index]);
   } else {
     throw cms::Exception("WrongTrackerSubDet") << "Invalid DetID: no GeomDetUnit associated with raw ID "
 					       << s.rawId() << " of subdet ID " << s.subdetId();
   }
 }
 
+void
+TrackerGeometry::idToDetUnits(const std::vector<DetId>& ids, std::vector<const TrackerGeomDet*>& dets) const
+{
+  dets.resize(ids.size());
+  for (unsigned int i=0; i<ids.size(); ++i) {
+    unsigned int index = theUnitIndex.find(ids[i]);
+    dets[i] = index != DetIdIndexMap::invalidIndex ? static_cast<const TrackerGeomDet *>(theDetUnits[index]) : nullptr;
+  }
+}
+
+void
+TrackerGeometry::idToDets(const std::vector<DetId>& ids, std::vector<const TrackerGeomDet*>& dets) const
+{
+  dets.resize(ids.size());
+  for (unsigned int i=0; i<ids.size(); ++i) {
+    unsigned int index = theDetIndex.find(ids[i]);
+    dets[i] = index != DetIdIndexMap::invalidIndex ? static_cast<const TrackerGeomDet *>(theDets[index]) : nullptr;
+  }
+}
+
 const GeomDetEnumerators::SubDetector 
 TrackerGeometry::geomDetSubDetector(int subdet) const {
   if(subdet>=1 && subdet<=6) {
@@ -212,6 +212,8 @@ private:
     boost::chrono::high_resolution_clock::time_point time_real;
     uint64_t                                         allocated;
     uint64_t                                         deallocated;
+    uint64_t                                         allocations;
+    uint64_t                                         deallocations;
   };
 
   // highlight a group of modules
@@ -234,6 +236,8 @@ private:
     boost::chrono::nanoseconds time_real;
     uint64_t                   allocated;
     uint64_t                   deallocated;
+    uint64_t                   allocations;
+    uint64_t                   deallocations;
   };
 
   // atomic version of Resources
@@ -245,6 +249,7 @@ private:
 
     AtomicResources & operator=(AtomicResources const& other);
     AtomicResources & operator+=(AtomicResources const& other);
+    AtomicResources & operator+=(Resources const& other);
     AtomicResources operator+(AtomicResources const& other) const;
 
   public:
@@ -252,6 +257,8 @@ private:
     std::atomic<boost::chrono::nanoseconds::rep> time_real;
     std::atomic<uint64_t> allocated;
     std::atomic<uint64_t> deallocated;
+    std::atomic<uint64_t> allocations;
+    std::atomic<uint64_t> deallocations;
   };
 
   struct ResourcesPerModule {
@@ -316,6 +323,8 @@ private:
     double time_resolution;
     double memory_range;
     double memory_resolution;
+    double allocations_range;
+    double allocations_resolution;
   };
 
   // plots associated to each module or other element (path, process, etc)
@@ -337,6 +346,10 @@ private:
     ConcurrentMonitorElement allocated_byls_;       // TProfile
     ConcurrentMonitorElement deallocated_;          // TH1F
     ConcurrentMonitorElement deallocated_byls_;     // TProfile
+    ConcurrentMonitorElement allocations_;          // TH1F
+    ConcurrentMonitorElement allocations_byls_;     // TProfile
+    ConcurrentMonitorElement deallocations_;        // TH1F
+    ConcurrentMonitorElement deallocations_byls_;   // TProfile
   };
 
   // plots associated to each path or endpath
@@ -362,6 +375,25 @@ private:
     ConcurrentMonitorElement module_time_real_total_;       // TH1D
     ConcurrentMonitorElement module_allocated_total_;       // TH1D
     ConcurrentMonitorElement module_deallocated_total_;     // TH1D
+    ConcurrentMonitorElement module_allocations_total_;     // TH1D
+    ConcurrentMonitorElement module_deallocations_total_;   // TH1D
+  };
+
+  // plots associated to the lumi or run transitions of all the modules
+  class PlotsPerTransition {
+  public:
+    PlotsPerTransition();
+    void book(DQMStore::ConcurrentBooker &, std::string const& name, std::string const& title, ProcessCallGraph const&);
+    void fill(std::vector<AtomicResources> const&);
+
+  private:
+    // resources spent in each module in the transitions
+    ConcurrentMonitorElement module_time_thread_total_;     // TH1D
+    ConcurrentMonitorElement module_time_real_total_;       // TH1D
+    ConcurrentMonitorElement module_allocated_total_;       // TH1D
+    ConcurrentMonitorElement module_deallocated_total_;     // TH1D
+    ConcurrentMonitorElement module_allocations_total_;     // TH1D
+    ConcurrentMonitorElement module_deallocations_total_;   // TH1D
   };
 
   class PlotsPerProcess {
@@ -388,7 +420,7 @@ private:
         PlotRanges const&  module_ranges, unsigned int lumisections,
         bool bymodule, bool bypath, bool byls, bool transitions);
     void fill(ProcessCallGraph const&, ResourcesPerJob const&, unsigned int ls);
-    void fill_run(AtomicResources const&);
+    void fill_run(AtomicResources const&, std::vector<AtomicResources> const& lumi_modules, std::vector<AtomicResources> const& run_modules);
     void fill_lumi(AtomicResources const&, unsigned int lumisection);
 
   private:
@@ -399,6 +431,9 @@ private:
     // resources spent in the modules' lumi and run transitions
     PlotsPerElement              lumi_;
     PlotsPerElement              run_;
+    // resources spent in each module's lumi and run transitions, per run
+    PlotsPerTransition           lumi_modules_;
+    PlotsPerTransition           run_modules_;
     // resources spent in the highlighted modules
     std::vector<PlotsPerElement> highlight_;
     // resources spent in each module
@@ -420,11 +455,17 @@ private:
   // per-lumi and per-run information
   std::vector<AtomicResources>  lumi_transition_;               // resources spent in the modules' global and stream lumi transitions
   std::vector<AtomicResources>  run_transition_;                // resources spent in the modules' global and stream run transitions
+  std::vector<std::vector<AtomicResources>>
+                                lumi_transition_modules_;       // resources spent in each module's lumi transitions, per run
+  std::vector<std::vector<AtomicResources>>
+                                run_transition_modules_;        // resources spent in each module's run transitions, per run
   AtomicResources               overhead_;                      // resources spent outside of the modules' transitions
 
   // summary data
   ResourcesPerJob               job_summary_;                   // whole event time accounting per-job
   std::vector<ResourcesPerJob>  run_summary_;                   // whole event time accounting per-run
+  std::vector<AtomicResources>  lumi_transition_modules_summary_;       // resources spent in each module's lumi transitions, per-job
+  std::vector<AtomicResources>  run_transition_modules_summary_;        // resources spent in each module's run transitions, per-job
   std::mutex                    summary_mutex_;                 // synchronise access to the summary objects across different threads
 
   // per-thread quantities, lazily allocated
@@ -450,6 +491,13 @@ private:
   const bool                    print_run_summary_;             // print the time spent in each process, path and module for each run
   const bool                    print_job_summary_;             // print the time spent in each process, path and module for the whole job
 
+  // json configuration
+  const bool                    write_json_summary_;            // write the resources spent in each module for the whole job to a JSON file
+  const std::string             json_filename_;
+
+  // count the number of memory allocations and deallocations
+  bool                          enable_allocation_counters_;    // non const, depends on the availability of the jemalloc hooks
+
   // dqm configuration
   bool                          enable_dqm_;                    // non const, depends on the availability of the DQMStore
   const bool                    enable_dqm_bymodule_;
@@ -508,6 +556,12 @@ private:
   template <typename T>
   void printTransition(T& out, AtomicResources const& data, std::string const& label) const;
 
+  // write the resources spent in each module for the whole job in JSON format
+  void writeSummaryJSON(ResourcesPerJob const& data, std::string const& filename) const;
+
+  // account the resources spent by a module in a lumi or run transition
+  void accumulateTransition(edm::ModuleCallingContext const& mcc, AtomicResources & transition, std::vector<AtomicResources> & modules);
+
   // check if this is the first process being signalled
   bool isFirstSubprocess(edm::StreamContext const&);
   bool isFirstSubprocess(edm::GlobalContext const&);
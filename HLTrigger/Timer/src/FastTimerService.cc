@@ -1,5 +1,6 @@
 // C++ headers
 #include <cmath>
+#include <fstream>
 #include <limits>
 #include <iostream>
 #include <iomanip>
@@ -60,6 +61,19 @@ namespace {
   {
     return bytes / 1024;
   }
+
+  // quote a string for a JSON document
+  std::string json_string(std::string const& value)
+  {
+    std::string quoted = "\"";
+    for (char c: value) {
+      if (c == '"' or c == '\\')
+        quoted += '\\';
+      quoted += c;
+    }
+    quoted += '"';
+    return quoted;
+  }
 } // namespace
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -72,23 +86,29 @@ FastTimerService::Resources::Resources() :
   time_thread(boost::chrono::nanoseconds::zero()),
   time_real(boost::chrono::nanoseconds::zero()),
   allocated(0ul),
-  deallocated(0ul)
+  deallocated(0ul),
+  allocations(0ul),
+  deallocations(0ul)
 { }
 
 void
 FastTimerService::Resources::reset() {
-  time_thread = boost::chrono::nanoseconds::zero();
-  time_real   = boost::chrono::nanoseconds::zero();
-  allocated   = 0ul;
-  deallocated = 0ul;
+  time_thread   = boost::chrono::nanoseconds::zero();
+  time_real     = boost::chrono::nanoseconds::zero();
+  allocated     = 0ul;
+  deallocated   = 0ul;
+  allocations   = 0ul;
+  deallocations = 0ul;
 }
 
 FastTimerService::Resources &
 FastTimerService::Resources::operator+=(Resources const& other) {
-  time_thread += other.time_thread;
-  time_real   += other.time_real;
-  allocated   += other.allocated;
-  deallocated += other.deallocated;
+  time_thread   += other.time_thread;
+  time_real     += other.time_real;
+  allocated     += other.allocated;
+  deallocated   += other.deallocated;
+  allocations   += other.allocations;
+  deallocations += other.deallocations;
   return *this;
 }
 
@@ -108,39 +128,60 @@ FastTimerService::AtomicResources::AtomicResources() :
   time_thread(0ul),
   time_real(0ul),
   allocated(0ul),
-  deallocated(0ul)
+  deallocated(0ul),
+  allocations(0ul),
+  deallocations(0ul)
 { }
 
 FastTimerService::AtomicResources::AtomicResources(AtomicResources const& other) :
   time_thread(other.time_thread.load()),
   time_real(other.time_real.load()),
   allocated(other.allocated.load()),
-  deallocated(other.deallocated.load())
+  deallocated(other.deallocated.load()),
+  allocations(other.allocations.load()),
+  deallocations(other.deallocations.load())
 { }
 
 void
 FastTimerService::AtomicResources::reset() {
-  time_thread = 0ul;
-  time_real   = 0ul;
-  allocated   = 0ul;
-  deallocated = 0ul;
+  time_thread   = 0ul;
+  time_real     = 0ul;
+  allocated     = 0ul;
+  deallocated   = 0ul;
+  allocations   = 0ul;
+  deallocations = 0ul;
 }
 
 FastTimerService::AtomicResources &
 FastTimerService::AtomicResources::operator=(AtomicResources const& other) {
-  time_thread = other.time_thread.load();
-  time_real   = other.time_real.load();
-  allocated   = other.allocated.load();
-  deallocated = other.deallocated.load();
+  time_thread   = other.time_thread.load();
+  time_real     = other.time_real.load();
+  allocated     = other.allocated.load();
+  deallocated   = other.deallocated.load();
+  allocations   = other.allocations.load();
+  deallocations = other.deallocations.load();
   return *this;
 }
 
 FastTimerService::AtomicResources &
 FastTimerService::AtomicResources::operator+=(AtomicResources const& other) {
-  time_thread += other.time_thread.load();
-  time_real   += other.time_real.load();
-  allocated   += other.allocated.load();
-  deallocated += other.deallocated.load();
+  time_thread   += other.time_thread.load();
+  time_real     += other.time_real.load();
+  allocated     += other.allocated.load();
+  deallocated   += other.deallocated.load();
+  allocations   += other.allocations.load();
+  deallocations += other.deallocations.load();
+  return *this;
+}
+
+FastTimerService::AtomicResources &
+FastTimerService::AtomicResources::operator+=(Resources const& other) {
+  time_thread   += boost::chrono::duration_cast<boost::chrono::nanoseconds>(other.time_thread).count();
+  time_real     += boost::chrono::duration_cast<boost::chrono::nanoseconds>(other.time_real).count();
+  allocated     += other.allocated;
+  deallocated   += other.deallocated;
+  allocations   += other.allocations;
+  deallocations += other.deallocations;
   return *this;
 }
 
@@ -308,10 +349,12 @@ FastTimerService::Measurement::measure() {
   #ifdef DEBUG_THREAD_CONCURRENCY
   id = std::this_thread::get_id();
   #endif // DEBUG_THREAD_CONCURRENCY
-  time_thread = boost::chrono::thread_clock::now();
-  time_real   = boost::chrono::high_resolution_clock::now();
-  allocated   = memory_usage::allocated();
-  deallocated = memory_usage::deallocated();
+  time_thread   = boost::chrono::thread_clock::now();
+  time_real     = boost::chrono::high_resolution_clock::now();
+  allocated     = memory_usage::allocated();
+  deallocated   = memory_usage::deallocated();
+  allocations   = memory_usage::allocations();
+  deallocations = memory_usage::deallocations();
 }
 
 void
@@ -319,18 +362,24 @@ FastTimerService::Measurement::measure_and_store(Resources & store) {
   #ifdef DEBUG_THREAD_CONCURRENCY
   assert(std::this_thread::get_id() == id);
   #endif // DEBUG_THREAD_CONCURRENCY
-  auto new_time_thread = boost::chrono::thread_clock::now();
-  auto new_time_real   = boost::chrono::high_resolution_clock::now();
-  auto new_allocated   = memory_usage::allocated();
-  auto new_deallocated = memory_usage::deallocated();
-  store.time_thread = new_time_thread - time_thread;
-  store.time_real   = new_time_real   - time_real;
-  store.allocated   = new_allocated   - allocated;
-  store.deallocated = new_deallocated - deallocated;
-  time_thread = new_time_thread;
-  time_real   = new_time_real;
-  allocated   = new_allocated;
-  deallocated = new_deallocated;
+  auto new_time_thread   = boost::chrono::thread_clock::now();
+  auto new_time_real     = boost::chrono::high_resolution_clock::now();
+  auto new_allocated     = memory_usage::allocated();
+  auto new_deallocated   = memory_usage::deallocated();
+  auto new_allocations   = memory_usage::allocations();
+  auto new_deallocations = memory_usage::deallocations();
+  store.time_thread   = new_time_thread   - time_thread;
+  store.time_real     = new_time_real     - time_real;
+  store.allocated     = new_allocated     - allocated;
+  store.deallocated   = new_deallocated   - deallocated;
+  store.allocations   = new_allocations   - allocations;
+  store.deallocations = new_deallocations - deallocations;
+  time_thread   = new_time_thread;
+  time_real     = new_time_real;
+  allocated     = new_allocated;
+  deallocated   = new_deallocated;
+  allocations   = new_allocations;
+  deallocations = new_deallocations;
 }
 
 void
@@ -338,18 +387,24 @@ FastTimerService::Measurement::measure_and_accumulate(AtomicResources & store) {
   #ifdef DEBUG_THREAD_CONCURRENCY
   assert(std::this_thread::get_id() == id);
   #endif // DEBUG_THREAD_CONCURRENCY
-  auto new_time_thread = boost::chrono::thread_clock::now();
-  auto new_time_real   = boost::chrono::high_resolution_clock::now();
-  auto new_allocated   = memory_usage::allocated();
-  auto new_deallocated = memory_usage::deallocated();
-  store.time_thread += boost::chrono::duration_cast<boost::chrono::nanoseconds>(new_time_thread - time_thread).count();
-  store.time_real   += boost::chrono::duration_cast<boost::chrono::nanoseconds>(new_time_real   - time_real).count();
-  store.allocated   += new_allocated   - allocated;
-  store.deallocated += new_deallocated - deallocated;
-  time_thread = new_time_thread;
-  time_real   = new_time_real;
-  allocated   = new_allocated;
-  deallocated = new_deallocated;
+  auto new_time_thread   = boost::chrono::thread_clock::now();
+  auto new_time_real     = boost::chrono::high_resolution_clock::now();
+  auto new_allocated     = memory_usage::allocated();
+  auto new_deallocated   = memory_usage::deallocated();
+  auto new_allocations   = memory_usage::allocations();
+  auto new_deallocations = memory_usage::deallocations();
+  store.time_thread   += boost::chrono::duration_cast<boost::chrono::nanoseconds>(new_time_thread - time_thread).count();
+  store.time_real     += boost::chrono::duration_cast<boost::chrono::nanoseconds>(new_time_real   - time_real).count();
+  store.allocated     += new_allocated     - allocated;
+  store.deallocated   += new_deallocated   - deallocated;
+  store.allocations   += new_allocations   - allocations;
+  store.deallocations += new_deallocations - deallocations;
+  time_thread   = new_time_thread;
+  time_real     = new_time_real;
+  allocated     = new_allocated;
+  deallocated   = new_deallocated;
+  allocations   = new_allocations;
+  deallocations = new_deallocations;
 }
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -368,8 +423,10 @@ FastTimerService::PlotsPerElement::book(
 {
   int time_bins = (int) std::ceil(ranges.time_range   / ranges.time_resolution);
   int mem_bins  = (int) std::ceil(ranges.memory_range / ranges.memory_resolution);
+  int alloc_bins = (int) std::ceil(ranges.allocations_range / ranges.allocations_resolution);
   std::string y_title_ms = (boost::format("events / %.1f ms") % ranges.time_resolution).str();
   std::string y_title_kB = (boost::format("events / %.1f kB") % ranges.memory_resolution).str();
+  std::string y_title_n  = (boost::format("events / %.0f") % ranges.allocations_resolution).str();
 
   time_thread_ = booker.book1D(
       name + " time_thread",
@@ -402,6 +459,23 @@ FastTimerService::PlotsPerElement::book(
     deallocated_.setYTitle(y_title_kB.c_str());
   }
 
+  if (memory_usage::are_counters_enabled())
+  {
+    allocations_ = booker.book1D(
+        name + " allocations",
+        title + " memory allocations",
+        alloc_bins, 0., ranges.allocations_range);
+    allocations_.setXTitle("allocations");
+    allocations_.setYTitle(y_title_n.c_str());
+
+    deallocations_ = booker.book1D(
+        name + " deallocations",
+        title + " memory deallocations",
+        alloc_bins, 0., ranges.allocations_range);
+    deallocations_.setXTitle("deallocations");
+    deallocations_.setYTitle(y_title_n.c_str());
+  }
+
   if (not byls)
     return;
 
@@ -443,6 +517,27 @@ FastTimerService::PlotsPerElement::book(
     deallocated_byls_.setXTitle("lumisection");
     deallocated_byls_.setYTitle("memory [kB]");
   }
+
+  if (memory_usage::are_counters_enabled())
+  {
+    allocations_byls_ = booker.bookProfile(
+        name + " allocations_byls",
+        title + " memory allocations vs. lumisection",
+        lumisections, 0.5, lumisections + 0.5,
+        alloc_bins, 0., std::numeric_limits<double>::infinity(),
+        " ");
+    allocations_byls_.setXTitle("lumisection");
+    allocations_byls_.setYTitle("allocations");
+
+    deallocations_byls_ = booker.bookProfile(
+        name + " deallocations_byls",
+        title + " memory deallocations vs. lumisection",
+        lumisections, 0.5, lumisections + 0.5,
+        alloc_bins, 0., std::numeric_limits<double>::infinity(),
+        " ");
+    deallocations_byls_.setXTitle("lumisection");
+    deallocations_byls_.setYTitle("deallocations");
+  }
 }
 
 void
@@ -474,6 +569,18 @@ FastTimerService::PlotsPerElement::fill(Resources const& data, unsigned int lumi
 
   if (deallocated_byls_)
     deallocated_byls_.fill(lumisection, kB(data.deallocated));
+
+  if (allocations_)
+    allocations_.fill(data.allocations);
+
+  if (allocations_byls_)
+    allocations_byls_.fill(lumisection, data.allocations);
+
+  if (deallocations_)
+    deallocations_.fill(data.deallocations);
+
+  if (deallocations_byls_)
+    deallocations_byls_.fill(lumisection, data.deallocations);
 }
 
 void
@@ -505,6 +612,18 @@ FastTimerService::PlotsPerElement::fill(AtomicResources const& data, unsigned in
 
   if (deallocated_byls_)
     deallocated_byls_.fill(lumisection, kB(data.deallocated));
+
+  if (allocations_)
+    allocations_.fill(data.allocations);
+
+  if (allocations_byls_)
+    allocations_byls_.fill(lumisection, data.allocations);
+
+  if (deallocations_)
+    deallocations_.fill(data.deallocations);
+
+  if (deallocations_byls_)
+    deallocations_byls_.fill(lumisection, data.deallocations);
 }
 
 void
@@ -547,6 +666,22 @@ FastTimerService::PlotsPerElement::fill_fraction(Resources const& data, Resource
 
   if (deallocated_byls_)
     deallocated_byls_.fill(lumisection, total, fraction);
+
+  total     = data.allocations;
+  fraction  = (total > 0.) ? (part.allocations / total) : 0.;
+  if (allocations_)
+    allocations_.fill(total, fraction);
+
+  if (allocations_byls_)
+    allocations_byls_.fill(lumisection, total, fraction);
+
+  total     = data.deallocations;
+  fraction  = (total > 0.) ? (part.deallocations / total) : 0.;
+  if (deallocations_)
+    deallocations_.fill(total, fraction);
+
+  if (deallocations_byls_)
+    deallocations_byls_.fill(lumisection, total, fraction);
 }
 
 
@@ -598,6 +733,19 @@ FastTimerService::PlotsPerPath::book(
         bins, -0.5, bins - 0.5);
     module_deallocated_total_.setYTitle("memory [kB]");
   }
+  if (memory_usage::are_counters_enabled())
+  {
+    module_allocations_total_ = booker.book1DD(
+        "module_allocations_total",
+        "total memory allocations",
+        bins, -0.5, bins - 0.5);
+    module_allocations_total_.setYTitle("allocations");
+    module_deallocations_total_ = booker.book1DD(
+        "module_deallocations_total",
+        "total memory deallocations",
+        bins, -0.5, bins - 0.5);
+    module_deallocations_total_.setYTitle("deallocations");
+  }
   for (unsigned int bin: boost::irange(0u, bins)) {
     auto const& module = job[path.modules_and_dependencies_[bin]];
     std::string const& label = module.scheduled_ ? module.module_.moduleLabel() : module.module_.moduleLabel() + " (unscheduled)";
@@ -609,6 +757,11 @@ FastTimerService::PlotsPerPath::book(
       module_allocated_total_  .setBinLabel(bin + 1, label.c_str());
       module_deallocated_total_.setBinLabel(bin + 1, label.c_str());
     }
+    if (memory_usage::are_counters_enabled())
+    {
+      module_allocations_total_  .setBinLabel(bin + 1, label.c_str());
+      module_deallocations_total_.setBinLabel(bin + 1, label.c_str());
+    }
   }
   module_counter_.setBinLabel(bins + 1, "");
 
@@ -638,12 +791,108 @@ FastTimerService::PlotsPerPath::fill(ProcessCallGraph::PathType const& descripti
 
     if (module_deallocated_total_)
       module_deallocated_total_.fill(i, kB(module.total.deallocated));
+
+    if (module_allocations_total_)
+      module_allocations_total_.fill(i, module.total.allocations);
+
+    if (module_deallocations_total_)
+      module_deallocations_total_.fill(i, module.total.deallocations);
   }
   if (module_counter_ and path.status)
     module_counter_.fill(path.last);
 }
 
 
+FastTimerService::PlotsPerTransition::PlotsPerTransition()
+  = default;
+
+void
+FastTimerService::PlotsPerTransition::book(
+    DQMStore::ConcurrentBooker & booker,
+    std::string const& name,
+    std::string const& title,
+    ProcessCallGraph const& job)
+{
+  unsigned int bins = job.size();
+  module_time_thread_total_ = booker.book1DD(
+      name + " module_time_thread_total",
+      title + " total module time (cpu)",
+      bins, -0.5, bins - 0.5);
+  module_time_thread_total_.setYTitle("processing time [ms]");
+  module_time_real_total_ = booker.book1DD(
+      name + " module_time_real_total",
+      title + " total module time (real)",
+      bins, -0.5, bins - 0.5);
+  module_time_real_total_.setYTitle("processing time [ms]");
+  if (memory_usage::is_available())
+  {
+    module_allocated_total_ = booker.book1DD(
+        name + " module_allocated_total",
+        title + " total allocated memory",
+        bins, -0.5, bins - 0.5);
+    module_allocated_total_.setYTitle("memory [kB]");
+    module_deallocated_total_ = booker.book1DD(
+        name + " module_deallocated_total",
+        title + " total deallocated memory",
+        bins, -0.5, bins - 0.5);
+    module_deallocated_total_.setYTitle("memory [kB]");
+  }
+  if (memory_usage::are_counters_enabled())
+  {
+    module_allocations_total_ = booker.book1DD(
+        name + " module_allocations_total",
+        title + " total memory allocations",
+        bins, -0.5, bins - 0.5);
+    module_allocations_total_.setYTitle("allocations");
+    module_deallocations_total_ = booker.book1DD(
+        name + " module_deallocations_total",
+        title + " total memory deallocations",
+        bins, -0.5, bins - 0.5);
+    module_deallocations_total_.setYTitle("deallocations");
+  }
+  for (unsigned int bin: boost::irange(0u, bins)) {
+    std::string const& label = job.module(bin).moduleLabel();
+    module_time_thread_total_.setBinLabel(bin + 1, label.c_str());
+    module_time_real_total_  .setBinLabel(bin + 1, label.c_str());
+    if (memory_usage::is_available())
+    {
+      module_allocated_total_  .setBinLabel(bin + 1, label.c_str());
+      module_deallocated_total_.setBinLabel(bin + 1, label.c_str());
+    }
+    if (memory_usage::are_counters_enabled())
+    {
+      module_allocations_total_  .setBinLabel(bin + 1, label.c_str());
+      module_deallocations_total_.setBinLabel(bin + 1, label.c_str());
+    }
+  }
+}
+
+void
+FastTimerService::PlotsPerTransition::fill(std::vector<AtomicResources> const& modules)
+{
+  for (unsigned int i: boost::irange(0ul, modules.size())) {
+    auto const& module = modules[i];
+    if (module_time_thread_total_)
+      module_time_thread_total_.fill(i, ms(boost::chrono::nanoseconds(module.time_thread.load())));
+
+    if (module_time_real_total_)
+      module_time_real_total_.fill(i, ms(boost::chrono::nanoseconds(module.time_real.load())));
+
+    if (module_allocated_total_)
+      module_allocated_total_.fill(i, kB(module.allocated));
+
+    if (module_deallocated_total_)
+      module_deallocated_total_.fill(i, kB(module.deallocated));
+
+    if (module_allocations_total_)
+      module_allocations_total_.fill(i, module.allocations);
+
+    if (module_deallocations_total_)
+      module_deallocations_total_.fill(i, module.deallocations);
+  }
+}
+
+
 FastTimerService::PlotsPerProcess::PlotsPerProcess(ProcessCallGraph::ProcessType const& process) :
   event_(),
   paths_(process.paths_.size()),
@@ -771,6 +1020,13 @@ FastTimerService::PlotsPerJob::book(
         event_ranges,
         lumisections,
         false);
+
+    if (bymodule) {
+      booker.setCurrentFolder(basedir + "/transitions");
+      lumi_modules_.book(booker, "lumi", "LumiSection transitions", job);
+      run_modules_.book(booker, "run", "Run transitions", job);
+      booker.setCurrentFolder(basedir);
+    }
   }
 
   // plot the time spent in few given groups of modules
@@ -831,10 +1087,14 @@ FastTimerService::PlotsPerJob::fill(ProcessCallGraph const& job, ResourcesPerJob
 }
 
 void
-FastTimerService::PlotsPerJob::fill_run(AtomicResources const& data)
+FastTimerService::PlotsPerJob::fill_run(AtomicResources const& data, std::vector<AtomicResources> const& lumi_modules, std::vector<AtomicResources> const& run_modules)
 {
   // fill run transition plots
   run_.fill(data, 0);
+
+  // fill the modules' lumi and run transition plots
+  lumi_modules_.fill(lumi_modules);
+  run_modules_.fill(run_modules);
 }
 
 void
@@ -857,6 +1117,11 @@ FastTimerService::FastTimerService(const edm::ParameterSet & config, edm::Activi
   print_event_summary_(         config.getUntrackedParameter<bool>(     "printEventSummary"        ) ),
   print_run_summary_(           config.getUntrackedParameter<bool>(     "printRunSummary"          ) ),
   print_job_summary_(           config.getUntrackedParameter<bool>(     "printJobSummary"          ) ),
+  // json configuration
+  write_json_summary_(          config.getUntrackedParameter<bool>(     "writeJSONSummary"         ) ),
+  json_filename_(               config.getUntrackedParameter<std::string>( "jsonFileName"          ) ),
+  // allocation counters
+  enable_allocation_counters_(  config.getUntrackedParameter<bool>(     "enableAllocationCounters" ) ),
   // dqm configuration
   enable_dqm_(                  config.getUntrackedParameter<bool>(     "enableDQM"                ) ),
   enable_dqm_bymodule_(         config.getUntrackedParameter<bool>(     "enableDQMbyModule"        ) ),
@@ -864,24 +1129,36 @@ FastTimerService::FastTimerService(const edm::ParameterSet & config, edm::Activi
   enable_dqm_byls_(             config.getUntrackedParameter<bool>(     "enableDQMbyLumiSection"   ) ),
   enable_dqm_bynproc_(          config.getUntrackedParameter<bool>(     "enableDQMbyProcesses"     ) ),
   enable_dqm_transitions_(      config.getUntrackedParameter<bool>(     "enableDQMTransitions"     ) ),
-  dqm_event_ranges_(          { config.getUntrackedParameter<double>(   "dqmTimeRange"             ),              // ms
-                                config.getUntrackedParameter<double>(   "dqmTimeResolution"        ),              // ms
-                                config.getUntrackedParameter<double>(   "dqmMemoryRange"           ),              // kB
-                                config.getUntrackedParameter<double>(   "dqmMemoryResolution"      ) } ),          // kB
-  dqm_path_ranges_(           { config.getUntrackedParameter<double>(   "dqmPathTimeRange"         ),              // ms
-                                config.getUntrackedParameter<double>(   "dqmPathTimeResolution"    ),              // ms
-                                config.getUntrackedParameter<double>(   "dqmPathMemoryRange"       ),              // kB
-                                config.getUntrackedParameter<double>(   "dqmPathMemoryResolution"  ) } ),          // kB
-  dqm_module_ranges_(         { config.getUntrackedParameter<double>(   "dqmModuleTimeRange"       ),              // ms
-                                config.getUntrackedParameter<double>(   "dqmModuleTimeResolution"  ),              // ms
-                                config.getUntrackedParameter<double>(   "dqmModuleMemoryRange"     ),              // kB
-                                config.getUntrackedParameter<double>(   "dqmModuleMemoryResolution") } ),          // kB
+  dqm_event_ranges_(          { config.getUntrackedParameter<double>(   "dqmTimeRange"                   ),           // ms
+                                config.getUntrackedParameter<double>(   "dqmTimeResolution"              ),           // ms
+                                config.getUntrackedParameter<double>(   "dqmMemoryRange"                 ),           // kB
+                                config.getUntrackedParameter<double>(   "dqmMemoryResolution"            ),           // kB
+                                config.getUntrackedParameter<double>(   "dqmAllocationsRange"            ),
+                                config.getUntrackedParameter<double>(   "dqmAllocationsResolution"       ) } ),
+  dqm_path_ranges_(           { config.getUntrackedParameter<double>(   "dqmPathTimeRange"               ),           // ms
+                                config.getUntrackedParameter<double>(   "dqmPathTimeResolution"          ),           // ms
+                                config.getUntrackedParameter<double>(   "dqmPathMemoryRange"             ),           // kB
+                                config.getUntrackedParameter<double>(   "dqmPathMemoryResolution"        ),           // kB
+                                config.getUntrackedParameter<double>(   "dqmPathAllocationsRange"        ),
+                                config.getUntrackedParameter<double>(   "dqmPathAllocationsResolution"   ) } ),
+  dqm_module_ranges_(         { config.getUntrackedParameter<double>(   "dqmModuleTimeRange"             ),           // ms
+                                config.getUntrackedParameter<double>(   "dqmModuleTimeResolution"        ),           // ms
+                                config.getUntrackedParameter<double>(   "dqmModuleMemoryRange"           ),           // kB
+                                config.getUntrackedParameter<double>(   "dqmModuleMemoryResolution"      ),           // kB
+                                config.getUntrackedParameter<double>(   "dqmModuleAllocationsRange"      ),
+                                config.getUntrackedParameter<double>(   "dqmModuleAllocationsResolution" ) } ),
   dqm_lumisections_range_(      config.getUntrackedParameter<unsigned int>( "dqmLumiSectionsRange" ) ),
   dqm_path_(                    config.getUntrackedParameter<std::string>("dqmPath" ) ),
   // highlight configuration
   highlight_module_psets_(      config.getUntrackedParameter<std::vector<edm::ParameterSet>>("highlightModules") ),
   highlight_modules_(           highlight_module_psets_.size())         // filled in postBeginJob()
 {
+  // install the jemalloc hooks before any thread is measured
+  if (enable_allocation_counters_ and not memory_usage::enable_counters()) {
+    enable_allocation_counters_ = false;
+    edm::LogWarning("FastTimerService") << "The memory allocations cannot be counted, as the jemalloc hooks are not available.";
+  }
+
   // start observing when a thread enters or leaves the TBB global thread arena
   tbb::task_scheduler_observer::observe();
 
@@ -954,7 +1231,11 @@ FastTimerService::FastTimerService(const edm::ParameterSet & config, edm::Activi
 //registry.watchPostEventReadFromSource(    this, & FastTimerService::postEventReadFromSource );
 }
 
-FastTimerService::~FastTimerService() = default;
+FastTimerService::~FastTimerService()
+{
+  if (enable_allocation_counters_)
+    memory_usage::disable_counters();
+}
 
 double
 FastTimerService::queryModuleTime_(edm::StreamID sid, unsigned int id) const
@@ -1099,6 +1380,10 @@ FastTimerService::preGlobalBeginRun(edm::GlobalContext const& gc)
     subprocess_global_run_check_[index] = 0;
     run_transition_[index].reset();
     run_summary_[index].reset();
+    for (auto & module: lumi_transition_modules_[index])
+      module.reset();
+    for (auto & module: run_transition_modules_[index])
+      module.reset();
 
     // book the DQM plots
     if (enable_dqm_) {
@@ -1168,6 +1453,8 @@ FastTimerService::preallocate(edm::service::SystemBounds const& bounds)
   // allocate buffers to keep track of the resources spent in the lumi and run transitions
   lumi_transition_.resize(concurrent_lumis_);
   run_transition_.resize(concurrent_runs_);
+  lumi_transition_modules_.resize(concurrent_runs_);
+  run_transition_modules_.resize(concurrent_runs_);
 }
 
 void
@@ -1207,6 +1494,14 @@ FastTimerService::postBeginJob() {
   run_summary_.resize(concurrent_runs_, temp);
   job_summary_ = temp;
 
+  // allocate the resource counters for the lumi and run transitions of each module
+  for (auto & transition: lumi_transition_modules_)
+    transition.resize(modules);
+  for (auto & transition: run_transition_modules_)
+    transition.resize(modules);
+  lumi_transition_modules_summary_.resize(modules);
+  run_transition_modules_summary_.resize(modules);
+
   // check that the DQMStore service is available
   if (enable_dqm_ and not edm::Service<DQMStore>().isAvailable()) {
     // the DQMStore is not available, disable all DQM plots
@@ -1331,8 +1626,17 @@ FastTimerService::postGlobalEndRun(edm::GlobalContext const& gc)
   }
   printTransition(out, run_transition_[index], label);
 
+  // avoid concurrent access to the summary objects
+  {
+    std::lock_guard<std::mutex> guard(summary_mutex_);
+    for (unsigned int i: boost::irange(0ul, lumi_transition_modules_summary_.size()))
+      lumi_transition_modules_summary_[i] += lumi_transition_modules_[index][i];
+    for (unsigned int i: boost::irange(0ul, run_transition_modules_summary_.size()))
+      run_transition_modules_summary_[i] += run_transition_modules_[index][i];
+  }
+
   if (enable_dqm_transitions_) {
-    plots_->fill_run(run_transition_[index]);
+    plots_->fill_run(run_transition_[index], lumi_transition_modules_[index], run_transition_modules_[index]);
   }
 }
 
@@ -1367,6 +1671,9 @@ FastTimerService::postEndJob()
     edm::LogVerbatim out("FastReport");
     printSummary(out, job_summary_, "Job");
   }
+  if (write_json_summary_) {
+    writeSummaryJSON(job_summary_, json_filename_);
+  }
 }
 
 
@@ -1577,6 +1884,65 @@ void FastTimerService::printTransition(T& out, AtomicResources const& data, std:
   printEventLine(out, data, label);
 }
 
+void
+FastTimerService::writeSummaryJSON(ResourcesPerJob const& data, std::string const& filename) const
+{
+  std::ofstream out(filename);
+  if (not out) {
+    edm::LogWarning("FastTimerService") << "Could not write the resources summary to the JSON file " << filename;
+    return;
+  }
+
+  // the resources, in the same units as the text summary
+  auto resources = [&](boost::chrono::nanoseconds time_thread, boost::chrono::nanoseconds time_real,
+      uint64_t allocated, uint64_t deallocated, uint64_t allocations, uint64_t deallocations) {
+    out << boost::format("\"time_thread\": %.3f, \"time_real\": %.3f, \"mem_alloc\": %d, \"mem_free\": %d")
+      % ms(time_thread) % ms(time_real) % kB(allocated) % kB(deallocated);
+    if (enable_allocation_counters_)
+      out << boost::format(", \"allocations\": %d, \"deallocations\": %d") % allocations % deallocations;
+  };
+  auto event_resources = [&](Resources const& r) {
+    resources(r.time_thread, r.time_real, r.allocated, r.deallocated, r.allocations, r.deallocations);
+  };
+  auto transition_resources = [&](AtomicResources const& r) {
+    resources(boost::chrono::nanoseconds(r.time_thread.load()), boost::chrono::nanoseconds(r.time_real.load()),
+        r.allocated, r.deallocated, r.allocations, r.deallocations);
+  };
+
+  out << "{\n";
+  out << "  \"resources\": [\n";
+  out << "    { \"time_thread\": \"cpu time [ms]\" },\n";
+  out << "    { \"time_real\": \"real time [ms]\" },\n";
+  out << "    { \"mem_alloc\": \"allocated memory [kB]\" },\n";
+  out << "    { \"mem_free\": \"deallocated memory [kB]\" }";
+  if (enable_allocation_counters_) {
+    out << ",\n";
+    out << "    { \"allocations\": \"memory allocations\" },\n";
+    out << "    { \"deallocations\": \"memory deallocations\" }";
+  }
+  out << "\n  ],\n";
+  out << "  \"total\": { \"type\": \"Job\", \"label\": \"Job\", \"events\": " << data.events << ", ";
+  event_resources(data.total);
+  out << " },\n";
+  out << "  \"modules\": [";
+  for (unsigned int i: boost::irange(0u, callgraph_.size())) {
+    auto const& module_d = callgraph_.module(i);
+    auto const& module   = data.modules[i];
+    out << (i == 0 ? "\n" : ",\n");
+    out << "    { \"type\": " << json_string(module_d.moduleName())
+        << ", \"label\": " << json_string(module_d.moduleLabel())
+        << ", \"events\": " << module.events << ", ";
+    event_resources(module.total);
+    out << ",\n      \"transitions\": {\n        \"lumi\": { ";
+    transition_resources(lumi_transition_modules_summary_[i]);
+    out << " },\n        \"run\": { ";
+    transition_resources(run_transition_modules_summary_[i]);
+    out << " } } }";
+  }
+  out << "\n  ]\n";
+  out << "}\n";
+}
+
 // check if this is the first process being signalled
 bool
 FastTimerService::isFirstSubprocess(edm::StreamContext const& sc)
@@ -1783,7 +2149,7 @@ void
 FastTimerService::postModuleGlobalBeginRun(edm::GlobalContext const& gc, edm::ModuleCallingContext const& mcc)
 {
   auto index = gc.runIndex();
-  thread().measure_and_accumulate(run_transition_[index]);
+  accumulateTransition(mcc, run_transition_[index], run_transition_modules_[index]);
 }
 
 void
@@ -1796,7 +2162,7 @@ void
 FastTimerService::postModuleGlobalEndRun(edm::GlobalContext const& gc, edm::ModuleCallingContext const& mcc)
 {
   auto index = gc.runIndex();
-  thread().measure_and_accumulate(run_transition_[index]);
+  accumulateTransition(mcc, run_transition_[index], run_transition_modules_[index]);
 }
 
 void
@@ -1809,7 +2175,7 @@ void
 FastTimerService::postModuleGlobalBeginLumi(edm::GlobalContext const& gc, edm::ModuleCallingContext const& mcc)
 {
   auto index = gc.luminosityBlockIndex();
-  thread().measure_and_accumulate(lumi_transition_[index]);
+  accumulateTransition(mcc, lumi_transition_[index], lumi_transition_modules_[gc.runIndex()]);
 }
 
 void
@@ -1822,7 +2188,7 @@ void
 FastTimerService::postModuleGlobalEndLumi(edm::GlobalContext const& gc, edm::ModuleCallingContext const& mcc)
 {
   auto index = gc.luminosityBlockIndex();
-  thread().measure_and_accumulate(lumi_transition_[index]);
+  accumulateTransition(mcc, lumi_transition_[index], lumi_transition_modules_[gc.runIndex()]);
 }
 
 void
@@ -1835,7 +2201,7 @@ void
 FastTimerService::postModuleStreamBeginRun(edm::StreamContext const& sc, edm::ModuleCallingContext const& mcc)
 {
   auto index = sc.runIndex();
-  thread().measure_and_accumulate(run_transition_[index]);
+  accumulateTransition(mcc, run_transition_[index], run_transition_modules_[index]);
 }
 
 void
@@ -1848,7 +2214,7 @@ void
 FastTimerService::postModuleStreamEndRun(edm::StreamContext const& sc, edm::ModuleCallingContext const& mcc)
 {
   auto index = sc.runIndex();
-  thread().measure_and_accumulate(run_transition_[index]);
+  accumulateTransition(mcc, run_transition_[index], run_transition_modules_[index]);
 }
 
 void
@@ -1861,7 +2227,7 @@ void
 FastTimerService::postModuleStreamBeginLumi(edm::StreamContext const& sc, edm::ModuleCallingContext const& mcc)
 {
   auto index = sc.luminosityBlockIndex();
-  thread().measure_and_accumulate(lumi_transition_[index]);
+  accumulateTransition(mcc, lumi_transition_[index], lumi_transition_modules_[sc.runIndex()]);
 }
 
 void
@@ -1874,7 +2240,16 @@ void
 FastTimerService::postModuleStreamEndLumi(edm::StreamContext const& sc, edm::ModuleCallingContext const& mcc)
 {
   auto index = sc.luminosityBlockIndex();
-  thread().measure_and_accumulate(lumi_transition_[index]);
+  accumulateTransition(mcc, lumi_transition_[index], lumi_transition_modules_[sc.runIndex()]);
+}
+
+void
+FastTimerService::accumulateTransition(edm::ModuleCallingContext const& mcc, AtomicResources & transition, std::vector<AtomicResources> & modules)
+{
+  Resources data;
+  thread().measure_and_store(data);
+  transition += data;
+  modules[mcc.moduleDescription()->id()] += data;
 }
 
 void
@@ -1906,6 +2281,9 @@ FastTimerService::fillDescriptions(edm::ConfigurationDescriptions & descriptions
   desc.addUntracked<bool>(        "printEventSummary",        false);
   desc.addUntracked<bool>(        "printRunSummary",          true);
   desc.addUntracked<bool>(        "printJobSummary",          true);
+  desc.addUntracked<bool>(        "writeJSONSummary",         false);
+  desc.addUntracked<std::string>( "jsonFileName",             "resources.json");
+  desc.addUntracked<bool>(        "enableAllocationCounters", false);
   desc.addUntracked<bool>(        "enableDQM",                true);
   desc.addUntracked<bool>(        "enableDQMbyModule",        false);
   desc.addUntracked<bool>(        "enableDQMbyPath",          false);
@@ -1916,14 +2294,20 @@ FastTimerService::fillDescriptions(edm::ConfigurationDescriptions & descriptions
   desc.addUntracked<double>(      "dqmTimeResolution",           5. );   // ms
   desc.addUntracked<double>(      "dqmMemoryRange",        1000000. );   // kB
   desc.addUntracked<double>(      "dqmMemoryResolution",      5000. );   // kB
+  desc.addUntracked<double>(      "dqmAllocationsRange",    100000. );
+  desc.addUntracked<double>(      "dqmAllocationsResolution",  500. );
   desc.addUntracked<double>(      "dqmPathTimeRange",          100. );   // ms
   desc.addUntracked<double>(      "dqmPathTimeResolution",       0.5);   // ms
   desc.addUntracked<double>(      "dqmPathMemoryRange",    1000000. );   // kB
   desc.addUntracked<double>(      "dqmPathMemoryResolution",  5000. );   // kB
+  desc.addUntracked<double>(      "dqmPathAllocationsRange", 100000. );
+  desc.addUntracked<double>(      "dqmPathAllocationsResolution", 500. );
   desc.addUntracked<double>(      "dqmModuleTimeRange",         40. );   // ms
   desc.addUntracked<double>(      "dqmModuleTimeResolution",     0.2);   // ms
   desc.addUntracked<double>(      "dqmModuleMemoryRange",   100000. );   // kB
   desc.addUntracked<double>(      "dqmModuleMemoryResolution", 500. );   // kB
+  desc.addUntracked<double>(      "dqmModuleAllocationsRange", 10000. );
+  desc.addUntracked<double>(      "dqmModuleAllocationsResolution", 50. );
   desc.addUntracked<unsigned>(    "dqmLumiSectionsRange",     2500  );   // ~ 16 hours
   desc.addUntracked<std::string>( "dqmPath",                  "HLT/TimerService");
 
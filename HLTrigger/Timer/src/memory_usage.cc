@@ -7,6 +7,21 @@
 extern "C" {
   typedef
   int (*mallctl_t)(const char *name, void *oldp, size_t *oldlenp, void *newp, size_t newlen);
+
+  // see "experimental.hooks.install" in jemalloc 5.1 and later
+  typedef
+  void (*hook_alloc_t)(void *extra, int type, void *result, uintptr_t result_raw, uintptr_t args_raw[3]);
+  typedef
+  void (*hook_dalloc_t)(void *extra, int type, void *address, uintptr_t args_raw[3]);
+  typedef
+  void (*hook_expand_t)(void *extra, int type, void *address, size_t old_usize, size_t new_usize, uintptr_t result_raw, uintptr_t args_raw[4]);
+
+  typedef struct {
+    hook_alloc_t  alloc_hook;
+    hook_dalloc_t dalloc_hook;
+    hook_expand_t expand_hook;
+    void *        extra;
+  } hooks_t;
 }
 
 namespace {
@@ -21,6 +36,25 @@ namespace {
   mallctl_t mallctl = nullptr;
   const bool have_jemalloc_and_stats = initialise();
 
+  // these are updated from within the allocator: the initial-exec TLS model
+  // guarantees that accessing them does not allocate any memory
+  __attribute__((tls_model("initial-exec"))) thread_local uint64_t thread_allocations   = 0;
+  __attribute__((tls_model("initial-exec"))) thread_local uint64_t thread_deallocations = 0;
+
+  void * hooks_handle = nullptr;
+
+  void alloc_hook(void *, int, void * result, uintptr_t, uintptr_t *)
+  {
+    if (result != nullptr)
+      ++thread_allocations;
+  }
+
+  void dalloc_hook(void *, int, void * address, uintptr_t *)
+  {
+    if (address != nullptr)
+      ++thread_deallocations;
+  }
+
 
   bool initialise()
   {
@@ -77,3 +111,47 @@ uint64_t memory_usage::deallocated()
   return * thread_deallocated_p;
 }
 
+
+bool memory_usage::enable_counters()
+{
+  if (hooks_handle != nullptr)
+    return true;
+
+  if (mallctl == nullptr)
+    return false;
+
+  // in-place reallocations are not counted, as they do not allocate a new block
+  hooks_t hooks = { alloc_hook, dalloc_hook, nullptr, nullptr };
+  void * handle = nullptr;
+  size_t ptr_s = sizeof(void *);
+  if (mallctl("experimental.hooks.install", & handle, & ptr_s, & hooks, sizeof(hooks_t)) != 0)
+    // the hooks are not supported by this version of jemalloc
+    return false;
+
+  hooks_handle = handle;
+  return true;
+}
+
+void memory_usage::disable_counters()
+{
+  if (hooks_handle == nullptr)
+    return;
+
+  mallctl("experimental.hooks.remove", nullptr, nullptr, & hooks_handle, sizeof(void *));
+  hooks_handle = nullptr;
+}
+
+bool memory_usage::are_counters_enabled()
+{
+  return hooks_handle != nullptr;
+}
+
+uint64_t memory_usage::allocations()
+{
+  return thread_allocations;
+}
+
+uint64_t memory_usage::deallocations()
+{
+  return thread_deallocations;
+}
@@ -8,6 +8,13 @@ public:
   static bool     is_available();
   static uint64_t allocated();
   static uint64_t deallocated();
+
+  // number of allocations and deallocations, counted by jemalloc hooks once the counters are enabled
+  static bool     enable_counters();
+  static void     disable_counters();
+  static bool     are_counters_enabled();
+  static uint64_t allocations();
+  static uint64_t deallocations();
 };
 
 #endif // memory_usage_h
@@ -29,3 +29,7 @@ process.FastTimerService.enableDQM                = True
 process.FastTimerService.enableDQMbyModule        = True
 process.FastTimerService.enableDQMbyLumiSection   = True
 process.FastTimerService.enableDQMbyProcesses     = True
+process.FastTimerService.enableDQMTransitions     = True
+process.FastTimerService.enableAllocationCounters = True
+process.FastTimerService.writeJSONSummary         = True
+process.FastTimerService.jsonFileName             = 'resources.json'
@@ -63,6 +63,16 @@ namespace edm {
     fileSequence_->readOneSpecified(cache, fileNameHash, id);
   }
 
+  bool
+  EmbeddedRootSource::readOneIndependentRandom_(EventPrincipal& cache, size_t& fileNameHash, CLHEP::HepRandomEngine* engine, bool newSequence) {
+    return fileSequence_->readOneIndependentRandom(cache, fileNameHash, engine, newSequence);
+  }
+
+  size_t
+  EmbeddedRootSource::averageEventSize_() const {
+    return fileSequence_->averageEventSize();
+  }
+
   void
   EmbeddedRootSource::dropUnwantedBranches_(std::vector<std::string> const& wantedBranches) {
     std::vector<std::string> rules;
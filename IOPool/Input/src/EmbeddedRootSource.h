@@ -54,6 +54,8 @@ namespace edm {
     void endJob() override;
     bool readOneEvent(EventPrincipal& cache, size_t& fileNameHash, CLHEP::HepRandomEngine*, EventID const* id, bool recycleFiles) override;
     void readOneSpecified(EventPrincipal& cache, size_t& fileNameHash, SecondaryEventIDAndFileInfo const& id) override;
+    bool readOneIndependentRandom_(EventPrincipal& cache, size_t& fileNameHash, CLHEP::HepRandomEngine*, bool newSequence) override;
+    size_t averageEventSize_() const override;
     void dropUnwantedBranches_(std::vector<std::string> const& wantedBranches) override;
 
     RootServiceChecker rootServiceChecker_;
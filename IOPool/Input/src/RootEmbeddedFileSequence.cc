@@ -278,6 +278,22 @@ namespace edm {
     return true;
   }
 
+  bool
+  RootEmbeddedFileSequence::readOneIndependentRandom(EventPrincipal& cache, size_t& fileNameHash, CLHEP::HepRandomEngine* engine, bool newSequence) {
+    // A sequence starts from a random file and entry, as readOneRandom() does
+    // once a file is used up, so that its events depend only on the state of
+    // the engine at its start. The current file is kept open if it is drawn again.
+    if(newSequence) {
+      eventsRemainingInFile_ = 0;
+    }
+    return readOneRandom(cache, fileNameHash, engine, nullptr, false);
+  }
+
+  size_t
+  RootEmbeddedFileSequence::averageEventSize() const {
+    return rootFile() ? rootFile()->eventTree().averageEntrySize() : 0U;
+  }
+
   bool
   RootEmbeddedFileSequence::readOneRandomWithID(EventPrincipal& cache, size_t& fileNameHash, CLHEP::HepRandomEngine* engine, EventID const* idp, bool recycleFiles) {
     assert(engine);
@@ -48,6 +48,8 @@ namespace edm {
     bool readOneSequential(EventPrincipal& cache, size_t& fileNameHash, CLHEP::HepRandomEngine*, EventID const*, bool recycleFiles);
     bool readOneSequentialWithID(EventPrincipal& cache, size_t& fileNameHash, CLHEP::HepRandomEngine*, EventID const* id, bool);
     void readOneSpecified(EventPrincipal& cache, size_t& fileNameHash, SecondaryEventIDAndFileInfo const& id);
+    bool readOneIndependentRandom(EventPrincipal& cache, size_t& fileNameHash, CLHEP::HepRandomEngine*, bool newSequence);
+    size_t averageEventSize() const;
 
     static void fillDescription(ParameterSetDescription & desc);
   private:
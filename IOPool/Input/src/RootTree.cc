@@ -4,6 +4,8 @@
 #include "FWCore/Utilities/interface/Exception.h"
 #include "DataFormats/Provenance/interface/BranchDescription.h"
 #include "InputFile.h"
+#include "TBranch.h"
+#include "TObjArray.h"
 #include "TTree.h"
 #include "TTreeIndex.h"
 #include "TTreeCache.h"
@@ -46,6 +48,7 @@ namespace edm {
     triggerSet_(),
     entries_(tree_ ? tree_->GetEntries() : 0),
     entryNumber_(-1),
+    averageEntrySize_(-1),
     entryNumberForIndex_(new std::vector<EntryNumber>(nIndexes, IndexIntoFile::invalidEntry)),
     branchNames_(),
     branches_{},
@@ -151,6 +154,22 @@ namespace edm {
       branches_.insert(prod.branchID(), info);
   }
 
+  Long64_t
+  RootTree::averageEntrySize() const {
+    if(averageEntrySize_ < 0) {
+      Long64_t bytes = 0;
+      if(tree_ && entries_ > 0) {
+        TObjArray* branches = tree_->GetListOfBranches();
+        for(int i = 0; i < branches->GetEntriesFast(); ++i) {
+          bytes += static_cast<TBranch*>(branches->UncheckedAt(i))->GetTotBytes("*");
+        }
+        bytes /= entries_;
+      }
+      averageEntrySize_ = bytes;
+    }
+    return averageEntrySize_;
+  }
+
   void
   RootTree::dropBranch(std::string const& oldBranchName) {
       //use the translated branch name
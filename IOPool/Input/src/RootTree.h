@@ -131,6 +131,8 @@ namespace edm {
     EntryNumber const& entryNumber() const {return entryNumber_;}
     EntryNumber const& entryNumberForIndex(unsigned int index) const;
     EntryNumber const& entries() const {return entries_;}
+    // uncompressed size of the branches not dropped on input, per entry
+    Long64_t averageEntrySize() const;
     void setEntryNumber(EntryNumber theEntryNumber);
     void insertEntryForIndex(unsigned int index);
     std::vector<std::string> const& branchNames() const {return branchNames_;}
@@ -219,6 +221,7 @@ namespace edm {
     mutable std::unordered_set<TBranch*> triggerSet_;
     EntryNumber entries_;
     EntryNumber entryNumber_;
+    mutable Long64_t averageEntrySize_;
     std::unique_ptr<std::vector<EntryNumber> > entryNumberForIndex_;
     std::vector<std::string> branchNames_;
     BranchMap branches_;
@@ -0,0 +1,147 @@
+#ifndef L1Trigger_L1TGlobal_CompiledMenu_h
+#define L1Trigger_L1TGlobal_CompiledMenu_h
+
+/**
+ * \class CompiledMenu
+ *
+ *
+ * Description: L1 trigger menu compiled for the evaluation in the GTL.
+ *
+ * Implementation:
+ *    Built once per trigger menu (by GlobalBoard::compileMenu). Each condition
+ *    of each condition chip gets an integer index and its ConditionEvaluation
+ *    object, which is kept for the lifetime of the menu. The RPN vector of each
+ *    algorithm is translated to tokens referring to the conditions by index.
+ *
+ *    In each bunch crossing every condition is evaluated once and its result
+ *    is stored in a bit set; the algorithms are then evaluated on the bit set,
+ *    with the RPN stack held in the bits of a 64-bit word, without any look-up
+ *    by condition name.
+ *
+ */
+
+// system include files
+#include <cstdint>
+#include <iosfwd>
+#include <memory>
+#include <string>
+#include <vector>
+
+// user include files
+#include "DataFormats/L1TGlobal/interface/GlobalLogicParser.h"
+#include "DataFormats/L1TGlobal/interface/GlobalObjectMapFwd.h"
+
+#include "L1Trigger/L1TGlobal/interface/ConditionEvaluation.h"
+#include "L1Trigger/L1TGlobal/interface/TriggerMenuFwd.h"
+
+// forward declarations
+class TriggerMenu;
+
+namespace l1t {
+
+// class interface
+class CompiledMenu {
+
+public:
+
+    /// token of a compiled RPN vector: for OP_OPERAND, the index of the condition
+    struct Token {
+        GlobalLogicParser::OperationType operation;
+        unsigned int condition;
+    };
+
+    /// compiled algorithm
+    struct Algorithm {
+        std::string name;
+        int bitNumber;
+        const GlobalAlgorithm* algorithm;
+        std::vector<Token> rpn;
+        /// indices of the conditions, in the order of the operands of the logical expression
+        std::vector<unsigned int> operands;
+        /// object types of the operands found in the condition maps (for the object maps)
+        std::vector<L1TObjectTypeInCond> operandObjectTypes;
+    };
+
+    /// maximum depth of the RPN stack of an algorithm
+    static constexpr unsigned int maxStackDepth = 64;
+
+public:
+
+    CompiledMenu();
+
+    CompiledMenu(const CompiledMenu&) = delete;
+    CompiledMenu& operator=(const CompiledMenu&) = delete;
+
+public:
+
+    /// the menu compiled, nullptr before the first compilation
+    inline const TriggerMenu* menu() const {
+        return m_menu;
+    }
+
+    /// start the compilation of a menu, removing the previous one
+    void reset(const TriggerMenu* menu);
+
+    /// add the condition of a condition chip, with the object evaluating it
+    /// (nullptr if the condition is not evaluated); returns its index
+    unsigned int addCondition(const int chip, const std::string& name,
+            std::unique_ptr<ConditionEvaluation> evaluation);
+
+    /// compile the algorithms of the menu, once all the conditions are added;
+    /// throws cms::Exception for a condition not found or an invalid RPN vector
+    void compileAlgorithms(const AlgorithmMap& algorithmMap, const std::vector<ConditionMap>& conditionMap);
+
+    inline unsigned int numberOfConditions() const {
+        return m_conditionNames.size();
+    }
+
+    inline const std::string& conditionName(const unsigned int condition) const {
+        return m_conditionNames[condition];
+    }
+
+    inline ConditionEvaluation* conditionEvaluation(const unsigned int condition) const {
+        return m_conditionEvaluations[condition].get();
+    }
+
+    inline const std::vector<Algorithm>& algorithms() const {
+        return m_algorithms;
+    }
+
+    /// evaluate all the conditions for a bunch crossing, store the results in the bit set
+    void evaluateConditions(const int bxEval);
+
+    /// result of a condition in the last evaluation
+    inline bool conditionResult(const unsigned int condition) const {
+        return (m_conditionResults[condition / 64] >> (condition % 64)) & 1;
+    }
+
+    /// evaluate an algorithm on the condition results of the last evaluation
+    bool evaluateAlgorithm(const Algorithm& algorithm) const;
+
+    /// operand tokens and combinations of an algorithm, as in the object maps
+    void fillOperands(const Algorithm& algorithm,
+            std::vector<GlobalLogicParser::OperandToken>& operandTokenVector,
+            std::vector<CombinationsInCond>& combinationVector) const;
+
+    void print(std::ostream& myCout) const;
+
+private:
+
+    /// menu compiled
+    const TriggerMenu* m_menu;
+
+    /// conditions, per index
+    std::vector<int> m_conditionChips;
+    std::vector<std::string> m_conditionNames;
+    std::vector<std::unique_ptr<ConditionEvaluation> > m_conditionEvaluations;
+
+    /// bit set of the condition results
+    std::vector<uint64_t> m_conditionResults;
+
+    std::vector<Algorithm> m_algorithms;
+
+};
+
+}
+
+#endif
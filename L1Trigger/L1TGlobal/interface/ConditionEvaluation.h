@@ -69,8 +69,11 @@ public:
         return m_condLastResult;
     }
 
-    /// call evaluateCondition and save last result
+    /// call evaluateCondition and save last result; the combinations of the
+    /// previous evaluation are cleared first, as evaluateCondition can return
+    /// before clearing them
     inline void evaluateConditionStoreResult(const int bxEval) {
+        m_combinationsInCond.clear();
         m_condLastResult = evaluateCondition(bxEval);
     }
 
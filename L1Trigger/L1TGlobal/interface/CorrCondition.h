@@ -23,6 +23,7 @@
 //   base classes
 #include "L1Trigger/L1TGlobal/interface/ConditionEvaluation.h"
 #include "L1Trigger/L1TGlobal/interface/GlobalScales.h"
+#include "L1Trigger/L1TGlobal/interface/CorrLegObjects.h"
 
 // forward declarations
 class GlobalCondition;
@@ -130,6 +131,9 @@ private:
     
     const GlobalScales* m_gtScales;
 
+    /// quantities of the objects of the legs, refilled at each evaluation
+    mutable CorrLegObjects m_leg1Objects;
+
 
 /*   //BLW comment out for now
     /// number of bits for eta of calorimeter objects
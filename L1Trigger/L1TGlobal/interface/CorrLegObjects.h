@@ -0,0 +1,77 @@
+#ifndef L1Trigger_L1TGlobal_CorrLegObjects_h
+#define L1Trigger_L1TGlobal_CorrLegObjects_h
+
+/**
+ * \class CorrLegObjects
+ *
+ *
+ * Description: quantities of the objects of one leg of a correlation condition.
+ *
+ * Implementation:
+ *    Structure of arrays, one entry per combination of the leg, filled once per
+ *    evaluation of the condition before the loops over the object pairs, so that
+ *    the scale conversions and the LUT look-ups of an object are not repeated
+ *    for every object of the other legs.
+ *
+ */
+
+// system include files
+#include <vector>
+
+namespace l1t {
+
+struct CorrLegObjects
+{
+    /// index of the object in its collection
+    std::vector<int> index;
+
+    /// hardware quantities, after the conversion to the muon scales if required
+    std::vector<int> phiIndex;
+    std::vector<int> etaIndex;
+    std::vector<int> etIndex;
+    std::vector<int> chrg;
+
+    /// hardware quantities before the conversion, used for the overlap removal
+    std::vector<int> phiORIndex;
+    std::vector<int> etaORIndex;
+
+    /// physical quantities (centre of the bins)
+    std::vector<double> phiPhy;
+    std::vector<double> etaPhy;
+    std::vector<double> etPhy;
+
+    inline unsigned int size() const {
+        return index.size();
+    }
+
+    void clear() {
+        index.clear();
+        phiIndex.clear();
+        etaIndex.clear();
+        etIndex.clear();
+        chrg.clear();
+        phiORIndex.clear();
+        etaORIndex.clear();
+        phiPhy.clear();
+        etaPhy.clear();
+        etPhy.clear();
+    }
+
+    void push_back(int objIndex, int objPhiIndex, int objEtaIndex, int objEtIndex, int objChrg,
+                   int objPhiORIndex, int objEtaORIndex, double objPhiPhy, double objEtaPhy, double objEtPhy) {
+        index.push_back(objIndex);
+        phiIndex.push_back(objPhiIndex);
+        etaIndex.push_back(objEtaIndex);
+        etIndex.push_back(objEtIndex);
+        chrg.push_back(objChrg);
+        phiORIndex.push_back(objPhiORIndex);
+        etaORIndex.push_back(objEtaORIndex);
+        phiPhy.push_back(objPhiPhy);
+        etaPhy.push_back(objEtaPhy);
+        etPhy.push_back(objEtPhy);
+    }
+};
+
+}
+
+#endif
@@ -24,6 +24,7 @@
 //   base classes
 #include "L1Trigger/L1TGlobal/interface/ConditionEvaluation.h"
 #include "L1Trigger/L1TGlobal/interface/GlobalScales.h"
+#include "L1Trigger/L1TGlobal/interface/CorrLegObjects.h"
 
 // forward declarations
 class GlobalCondition;
@@ -133,6 +134,10 @@ private:
     
     const GlobalScales* m_gtScales;
 
+    /// quantities of the objects of the legs, refilled at each evaluation
+    mutable CorrLegObjects m_leg1Objects;
+    mutable CorrLegObjects m_leg2Objects;
+
 
 /*   //BLW comment out for now
     /// number of bits for eta of calorimeter objects
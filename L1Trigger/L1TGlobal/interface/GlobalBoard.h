@@ -20,7 +20,7 @@
 #include "FWCore/Utilities/interface/typedefs.h"
 #include "DataFormats/L1TGlobal/interface/GlobalObjectMapRecord.h"
 
-#include "L1Trigger/L1TGlobal/interface/AlgorithmEvaluation.h"
+#include "L1Trigger/L1TGlobal/interface/CompiledMenu.h"
 
 // Trigger Objects
 #include "DataFormats/L1Trigger/interface/EGamma.h"
@@ -88,6 +88,13 @@ public:
     void init(const int numberPhysTriggers, const int nrL1Mu, const int nrL1EG, const int nrL1Tau, const int nrL1Jet, 
 	      int bxFirst, int bxLast);
 
+    /// compile the trigger menu for runGTL: to be called when the menu changes
+    void compileMenu(const TriggerMenu* m_l1GtMenu,
+        const int nrL1Mu,
+        const int nrL1EG,
+        const int nrL1Tau,
+        const int nrL1Jet);
+
     /// run the uGT GTL (Conditions and Algorithms)
     void runGTL(edm::Event& iEvent, const edm::EventSetup& evSetup, const TriggerMenu* m_l1GtMenu,
         const bool produceL1GtObjectMapRecord,
@@ -251,8 +258,8 @@ private:
     
     GlobalAlgBlk m_uGtAlgBlk;
 
-    // cache  of maps
-    std::vector<AlgorithmEvaluation::ConditionEvaluationMap> m_conditionResultMaps;
+    // trigger menu compiled, with the conditions evaluated in each bx
+    CompiledMenu m_compiledMenu;
 
     /// prescale counters: NumberPhysTriggers counters per bunch cross in event
     std::vector<std::vector<int> > m_prescaleCounterAlgoTrig;
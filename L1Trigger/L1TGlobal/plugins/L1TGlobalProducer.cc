@@ -259,6 +259,9 @@ void L1TGlobalProducer::produce(edm::Event& iEvent, const edm::EventSetup& evSet
     unsigned long long l1GtParCacheID =
             evSetup.get<L1TGlobalParametersRcd>().cacheIdentifier();
 
+    // the menu is compiled again if the menu or the number of objects change
+    bool compileMenu = false;
+
     if (m_l1GtParCacheID != l1GtParCacheID) {
 
         edm::ESHandle< L1TGlobalParameters > l1GtStablePar;
@@ -293,6 +296,7 @@ void L1TGlobalProducer::produce(edm::Event& iEvent, const edm::EventSetup& evSet
 
         //
         m_l1GtParCacheID = l1GtParCacheID;
+        compileMenu = true;
 
     }
 
@@ -354,6 +358,12 @@ void L1TGlobalProducer::produce(edm::Event& iEvent, const edm::EventSetup& evSet
         if(m_printL1Menu) m_l1GtMenu->print(std::cout, printV);
 	
         m_l1GtMenuCacheID = l1GtMenuCacheID;
+        compileMenu = true;
+    }
+
+    // conditions and algorithms of the menu, evaluated by index in each bx
+    if (compileMenu) {
+        m_uGtBrd->compileMenu(m_l1GtMenu.get(), m_nrL1Mu, m_nrL1EG, m_nrL1Tau, m_nrL1Jet);
     }
 
 
@@ -0,0 +1,281 @@
+/**
+ * \class CompiledMenu
+ *
+ *
+ * Description: L1 trigger menu compiled for the evaluation in the GTL.
+ *
+ */
+
+// this class header
+#include "L1Trigger/L1TGlobal/interface/CompiledMenu.h"
+
+// system include files
+#include <algorithm>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <utility>
+
+// user include files
+#include "L1Trigger/L1TGlobal/interface/GlobalAlgorithm.h"
+#include "L1Trigger/L1TGlobal/interface/GlobalCondition.h"
+
+#include "FWCore/MessageLogger/interface/MessageLogger.h"
+#include "FWCore/Utilities/interface/Exception.h"
+
+// constructor
+l1t::CompiledMenu::CompiledMenu() :
+    m_menu(nullptr) {
+    // empty
+}
+
+// methods
+
+void l1t::CompiledMenu::reset(const TriggerMenu* menu) {
+    m_menu = menu;
+    m_conditionChips.clear();
+    m_conditionNames.clear();
+    m_conditionEvaluations.clear();
+    m_conditionResults.clear();
+    m_algorithms.clear();
+}
+
+unsigned int l1t::CompiledMenu::addCondition(const int chip, const std::string& name,
+        std::unique_ptr<ConditionEvaluation> evaluation) {
+
+    m_conditionChips.push_back(chip);
+    m_conditionNames.push_back(name);
+    m_conditionEvaluations.push_back(std::move(evaluation));
+    m_conditionResults.resize((m_conditionNames.size() + 63) / 64, 0);
+
+    return m_conditionNames.size() - 1;
+}
+
+void l1t::CompiledMenu::compileAlgorithms(const AlgorithmMap& algorithmMap,
+        const std::vector<ConditionMap>& conditionMap) {
+
+    // index of the evaluated conditions, per chip and name
+    std::map<std::pair<int, std::string>, unsigned int> conditionIndex;
+    for (unsigned int iCond = 0; iCond < m_conditionNames.size(); ++iCond) {
+        if (m_conditionEvaluations[iCond]) {
+            conditionIndex[std::make_pair(m_conditionChips[iCond], m_conditionNames[iCond])] = iCond;
+        }
+    }
+
+    m_algorithms.clear();
+    m_algorithms.reserve(algorithmMap.size());
+
+    for (CItAlgo itAlgo = algorithmMap.begin(); itAlgo != algorithmMap.end(); itAlgo++) {
+
+        const GlobalAlgorithm& gtAlgo = itAlgo->second;
+
+        Algorithm algorithm;
+        algorithm.name = itAlgo->first;
+        algorithm.bitNumber = gtAlgo.algoBitNumber();
+        algorithm.algorithm = &gtAlgo;
+
+        const std::vector<GlobalLogicParser::TokenRPN>& rpnVector = gtAlgo.algoRpnVector();
+        if (rpnVector.empty()) {
+            throw cms::Exception("FailModule")
+                << "\nEmpty RPN vector for the logical expression = "
+                << gtAlgo.algoLogicalExpression()
+                << std::endl;
+        }
+
+        // depth of the RPN stack, checked here once for all the evaluations
+        unsigned int stackDepth = 0;
+
+        for (std::vector<GlobalLogicParser::TokenRPN>::const_iterator it = rpnVector.begin();
+                it != rpnVector.end(); it++) {
+
+            Token token;
+            token.operation = it->operation;
+            token.condition = 0;
+
+            switch (it->operation) {
+                case GlobalLogicParser::OP_OPERAND: {
+                    auto itCond = conditionIndex.find(std::make_pair(gtAlgo.algoChipNumber(), it->operand));
+                    if (itCond == conditionIndex.end()) {
+                        // it should never be happen, all conditions are in the maps
+                        throw cms::Exception("FailModule")
+                            << "\nCondition " << (it->operand) << " not found in condition map"
+                            << std::endl;
+                    }
+                    token.condition = itCond->second;
+                    algorithm.operands.push_back(itCond->second);
+
+                    // object types, from the condition maps of all the chips
+                    int found = 0;
+                    L1TObjectTypeInCond otype;
+                    for (auto imap = conditionMap.begin(); imap != conditionMap.end(); imap++) {
+                        auto match = imap->find(it->operand);
+                        if (match != imap->end()) {
+                            found = 1;
+                            otype = match->second->objectType();
+                        }
+                    }
+                    if (!found) {
+                        edm::LogWarning("L1TGlobal") << "\n Failed to find match for operand token " << it->operand << "\n";
+                    } else {
+                        algorithm.operandObjectTypes.push_back(otype);
+                    }
+
+                    ++stackDepth;
+                }
+                    break;
+                case GlobalLogicParser::OP_NOT: {
+                    if (stackDepth < 1) {
+                        throw cms::Exception("FailModule")
+                            << "\nInvalid RPN vector for the logical expression = "
+                            << gtAlgo.algoLogicalExpression()
+                            << std::endl;
+                    }
+                }
+                    break;
+                case GlobalLogicParser::OP_OR:
+                case GlobalLogicParser::OP_AND: {
+                    if (stackDepth < 2) {
+                        throw cms::Exception("FailModule")
+                            << "\nInvalid RPN vector for the logical expression = "
+                            << gtAlgo.algoLogicalExpression()
+                            << std::endl;
+                    }
+                    --stackDepth;
+                }
+                    break;
+                default: {
+                    // ignored in the evaluation
+                    continue;
+                }
+                    break;
+            }
+
+            if (stackDepth > maxStackDepth) {
+                throw cms::Exception("FailModule")
+                    << "\nThe logical expression = " << gtAlgo.algoLogicalExpression()
+                    << " needs more than " << maxStackDepth << " intermediate results"
+                    << std::endl;
+            }
+
+            algorithm.rpn.push_back(token);
+        }
+
+        if (stackDepth == 0) {
+            throw cms::Exception("FailModule")
+                << "\nInvalid RPN vector for the logical expression = "
+                << gtAlgo.algoLogicalExpression()
+                << std::endl;
+        }
+
+        m_algorithms.push_back(std::move(algorithm));
+    }
+
+}
+
+void l1t::CompiledMenu::evaluateConditions(const int bxEval) {
+
+    std::fill(m_conditionResults.begin(), m_conditionResults.end(), 0);
+
+    const unsigned int nConditions = m_conditionEvaluations.size();
+    for (unsigned int iCond = 0; iCond < nConditions; ++iCond) {
+        ConditionEvaluation* evaluation = m_conditionEvaluations[iCond].get();
+        if (evaluation) {
+            evaluation->evaluateConditionStoreResult(bxEval);
+            if (evaluation->condLastResult()) {
+                m_conditionResults[iCond / 64] |= uint64_t(1) << (iCond % 64);
+            }
+        }
+    }
+
+}
+
+bool l1t::CompiledMenu::evaluateAlgorithm(const Algorithm& algorithm) const {
+
+    // the stack of the temporary results, the top is the lowest bit
+    uint64_t stack = 0;
+    uint64_t top;
+
+    for (std::vector<Token>::const_iterator it = algorithm.rpn.begin(); it != algorithm.rpn.end(); it++) {
+
+        switch (it->operation) {
+            case GlobalLogicParser::OP_OPERAND: {
+                stack = (stack << 1) | conditionResult(it->condition);
+            }
+                break;
+            case GlobalLogicParser::OP_NOT: {
+                stack ^= 1;
+            }
+                break;
+            case GlobalLogicParser::OP_OR: {
+                top = stack & 1;
+                stack >>= 1;
+                stack |= top;
+            }
+                break;
+            case GlobalLogicParser::OP_AND: {
+                top = stack & 1;
+                stack >>= 1;
+                stack &= ~uint64_t(1) | top;
+            }
+                break;
+            default: {
+                // not in a compiled RPN vector
+            }
+                break;
+        }
+    }
+
+    return stack & 1;
+}
+
+void l1t::CompiledMenu::fillOperands(const Algorithm& algorithm,
+        std::vector<GlobalLogicParser::OperandToken>& operandTokenVector,
+        std::vector<CombinationsInCond>& combinationVector) const {
+
+    operandTokenVector.clear();
+    operandTokenVector.reserve(algorithm.operands.size());
+    combinationVector.clear();
+    combinationVector.reserve(algorithm.operands.size());
+
+    // opNumber is the index of the condition in the logical expression
+    int opNumber = 0;
+    for (std::vector<unsigned int>::const_iterator it = algorithm.operands.begin();
+            it != algorithm.operands.end(); it++) {
+
+        GlobalLogicParser::OperandToken opToken;
+        opToken.tokenName = m_conditionNames[*it];
+        opToken.tokenNumber = opNumber;
+        opToken.tokenResult = conditionResult(*it);
+        operandTokenVector.push_back(opToken);
+        opNumber++;
+
+        combinationVector.push_back(m_conditionEvaluations[*it]->getCombinationsInCond());
+    }
+
+}
+
+// print the compiled menu
+void l1t::CompiledMenu::print(std::ostream& myCout) const {
+
+    myCout << std::endl;
+    myCout << "    Compiled menu: " << m_conditionNames.size() << " conditions, "
+           << m_algorithms.size() << " algorithms" << std::endl;
+
+    for (unsigned int iCond = 0; iCond < m_conditionNames.size(); ++iCond) {
+        myCout << "      " << std::setw(5) << iCond << "\t chip " << m_conditionChips[iCond] << "\t"
+               << std::setw(25) << m_conditionNames[iCond]
+               << (m_conditionEvaluations[iCond] ? "" : "\t (not evaluated)")
+               << std::endl;
+    }
+
+    for (std::vector<Algorithm>::const_iterator it = m_algorithms.begin(); it != m_algorithms.end(); it++) {
+        myCout << "      bit " << std::setw(4) << it->bitNumber << "\t" << it->name << "\t conditions";
+        for (std::vector<unsigned int>::const_iterator itOp = it->operands.begin();
+                itOp != it->operands.end(); itOp++) {
+            myCout << " " << *itOp;
+        }
+        myCout << std::endl;
+    }
+
+    myCout << std::endl;
+}
@@ -395,6 +395,292 @@ const bool l1t::CorrCondition::evaluateCondition(const int bxEval) const {
             << (cond1Comb.size()) << std::endl;
 
 
+    // quantities of the objects of the second leg, computed once for all the pairs
+    m_leg1Objects.clear();
+
+    for (std::vector<SingleCombInCond>::const_iterator it1Comb =
+            cond1Comb.begin(); it1Comb != cond1Comb.end(); it1Comb++) {
+
+        LogDebug("L1TGlobal") << "Looking at second Condition" << std::endl;
+        // Type1s: there is 1 object only, no need for a loop (*it1Comb)[0]
+        // ... but add protection to not crash
+        int obj1Index = -1;
+
+        if (!(*it1Comb).empty()) {
+            obj1Index = (*it1Comb)[0];
+        } else {
+            LogTrace("L1TGlobal")
+                    << "\n  SingleCombInCond (*it1Comb).size() "
+                    << ((*it1Comb).size()) << std::endl;
+            return false;
+        }
+
+        switch (cond1Categ) {
+            case CondMuon: {
+		   lutObj1 = "MU";
+               candMuVec = m_uGtB->getCandL1Mu();
+               phiIndex1 =  (candMuVec->at(cond1bx,obj1Index))->hwPhiAtVtx(); //(*candMuVec)[obj0Index]->phiIndex();
+               etaIndex1 =  (candMuVec->at(cond1bx,obj1Index))->hwEtaAtVtx();
+		   etIndex1  =  (candMuVec->at(cond1bx,obj1Index))->hwPt();
+		   chrg1     =  (candMuVec->at(cond1bx,obj1Index))->hwCharge();
+		   etaBin1 = etaIndex1;
+		   if(etaBin1<0) etaBin1 = m_gtScales->getMUScales().etaBins.size() + etaBin1;
+//		   LogDebug("L1TGlobal") << "Muon phi" << phiIndex1 << " eta " << etaIndex1 << " etaBin1 = " << etaBin1  << " et " << etIndex1 << std::endl;
+
+		   etBin1 = etIndex1;
+		   int ssize = m_gtScales->getMUScales().etBins.size();
+		   if (etBin1 >= ssize){
+		     LogTrace("L1TGlobal")
+		       << "muon2 hw et" << etBin1 << " out of scale range.  Setting to maximum.";
+		     etBin1 = ssize-1;
+		   }
+
+		   // Determine Floating Pt numbers for floating point caluclation
+		   std::pair<double, double> binEdges = m_gtScales->getMUScales().phiBins.at(phiIndex1);
+		   phi1Phy = 0.5*(binEdges.second + binEdges.first);
+		   binEdges = m_gtScales->getMUScales().etaBins.at(etaBin1);
+		   eta1Phy = 0.5*(binEdges.second + binEdges.first);
+		   binEdges = m_gtScales->getMUScales().etBins.at(etBin1);
+		   et1Phy = 0.5*(binEdges.second + binEdges.first);
+
+            }
+                break;
+            case CondCalo: {
+    	   switch(cndObjTypeVec[1]) {
+	             case gtEG: {
+			candCaloVec = m_uGtB->getCandL1EG();
+			phiIndex1 =  (candCaloVec->at(cond1bx,obj1Index))->hwPhi();
+			etaIndex1 =  (candCaloVec->at(cond1bx,obj1Index))->hwEta();
+			etIndex1  =  (candCaloVec->at(cond1bx,obj1Index))->hwPt();
+			etaBin1   =   etaIndex1;
+			if(etaBin1<0) etaBin1 = m_gtScales->getEGScales().etaBins.size() + etaBin1;
+
+			etBin1 = etIndex1;
+			int ssize = m_gtScales->getEGScales().etBins.size();
+			if (etBin1 >= ssize){
+			  LogTrace("L1TGlobal")
+			    << "EG1 hw et" << etBin1 << " out of scale range.  Setting to maximum.";
+			  etBin1 = ssize-1;
+			}
+
+			// Determine Floating Pt numbers for floating point caluclation
+		   	std::pair<double, double> binEdges = m_gtScales->getEGScales().phiBins.at(phiIndex1);
+		   	phi1Phy = 0.5*(binEdges.second + binEdges.first);
+			binEdges = m_gtScales->getEGScales().etaBins.at(etaBin1);
+			eta1Phy = 0.5*(binEdges.second + binEdges.first);
+			binEdges = m_gtScales->getEGScales().etBins.at(etBin1);
+			et1Phy = 0.5*(binEdges.second + binEdges.first);
+		    	lutObj1 = "EG";
+		     }
+		       break;
+		     case gtJet: {
+			candCaloVec = m_uGtB->getCandL1Jet();
+			phiIndex1 =  (candCaloVec->at(cond1bx,obj1Index))->hwPhi();
+			etaIndex1 =  (candCaloVec->at(cond1bx,obj1Index))->hwEta();
+			etIndex1  =  (candCaloVec->at(cond1bx,obj1Index))->hwPt();
+			etaBin1 = etaIndex1;
+			if(etaBin1<0) etaBin1 = m_gtScales->getJETScales().etaBins.size() + etaBin1;
+
+			etBin1 = etIndex1;
+			int ssize = m_gtScales->getJETScales().etBins.size();
+			assert(ssize);
+			if (etBin1 >= ssize){
+			  //edm::LogWarning("L1TGlobal")
+			  //<< "jet2 hw et" << etBin1 << " out of scale range.  Setting to maximum.";
+			  etBin1 = ssize-1;
+			}
+
+			// Determine Floating Pt numbers for floating point caluclation
+		   	std::pair<double, double> binEdges = m_gtScales->getJETScales().phiBins.at(phiIndex1);
+		   	phi1Phy = 0.5*(binEdges.second + binEdges.first);
+			binEdges = m_gtScales->getJETScales().etaBins.at(etaBin1);
+			eta1Phy = 0.5*(binEdges.second + binEdges.first);
+			//CRASHES HERE:
+			binEdges = m_gtScales->getJETScales().etBins.at(etBin1);
+			et1Phy = 0.5*(binEdges.second + binEdges.first);
+			lutObj1 = "JET";
+		     }
+		       break;
+		     case gtTau: {
+			candCaloVec = m_uGtB->getCandL1Tau();
+			phiIndex1 =  (candCaloVec->at(cond1bx,obj1Index))->hwPhi();
+			etaIndex1 =  (candCaloVec->at(cond1bx,obj1Index))->hwEta();
+			etIndex1  =  (candCaloVec->at(cond1bx,obj1Index))->hwPt();
+			etaBin1 = etaIndex1;
+			if(etaBin1<0) etaBin1 = m_gtScales->getTAUScales().etaBins.size() + etaBin1;
+
+			etBin1 = etIndex1;
+			int ssize = m_gtScales->getTAUScales().etBins.size();
+			if (etBin1 >= ssize){
+			  LogTrace("L1TGlobal")
+			    << "tau2 hw et" << etBin1 << " out of scale range.  Setting to maximum.";
+			  etBin1 = ssize-1;
+			}
+
+			// Determine Floating Pt numbers for floating point caluclation
+		   	std::pair<double, double> binEdges = m_gtScales->getTAUScales().phiBins.at(phiIndex1);
+		   	phi1Phy = 0.5*(binEdges.second + binEdges.first);
+			binEdges = m_gtScales->getTAUScales().etaBins.at(etaBin1);
+			eta1Phy = 0.5*(binEdges.second + binEdges.first);
+			binEdges = m_gtScales->getTAUScales().etBins.at(etBin1);
+			et1Phy = 0.5*(binEdges.second + binEdges.first);
+			lutObj1 = "TAU";
+		     }
+	               break;
+		     default: {
+		     }
+	           break;
+	           } //end switch on calo type.
+
+
+               //If needed convert calo scales to muon scales for comparison
+               if(convertCaloScales) {
+
+		     std::string lutName = lutObj1;
+		     lutName += "-MU";
+		     long long tst = m_gtScales->getLUT_CalMuEta(lutName,etaBin1);
+		     LogDebug("L1TGlobal") << lutName <<"  EtaCal = " << etaIndex1 << " EtaMu = " << tst << std::endl;
+		     etaIndex1 = tst;
+
+
+		     tst = m_gtScales->getLUT_CalMuPhi(lutName,phiIndex1);
+		     LogDebug("L1TGlobal") << lutName <<"  PhiCal = " << phiIndex1 << " PhiMu = " << tst << std::endl;
+		     phiIndex1 = tst;
+
+               }
+
+
+            }
+                break;
+            case CondEnergySum: {
+
+               LogDebug("L1TGlobal") << "Looking at second Condition as Energy Sum: " << cndObjTypeVec[1] << std::endl;
+
+		   //Stupid mapping between enum types for energy sums.
+		   l1t::EtSum::EtSumType type;
+		   switch( cndObjTypeVec[1] ){
+		   case gtETM:
+		     type = l1t::EtSum::EtSumType::kMissingEt;
+		     lutObj1 = "ETM";
+		     break;
+		   case gtETT:
+		     type = l1t::EtSum::EtSumType::kTotalEt;
+		     lutObj1 = "ETT";
+		     break;
+		   case gtETTem:
+		     type = l1t::EtSum::EtSumType::kTotalEtEm;
+		     lutObj1 = "ETTem";
+		     break;
+		   case gtHTM:
+		     type = l1t::EtSum::EtSumType::kMissingHt;
+		     lutObj1 = "HTM";
+		     break;
+		   case gtHTT:
+		     type = l1t::EtSum::EtSumType::kTotalHt;
+		     lutObj1 = "HTT";
+		     break;
+		   case gtETMHF:
+		     type = l1t::EtSum::EtSumType::kMissingEtHF;
+		     lutObj1 = "ETMHF";
+		     break;
+		   case gtMinBiasHFP0:
+		   case gtMinBiasHFM0:
+		   case gtMinBiasHFP1:
+		   case gtMinBiasHFM1:
+		     type = l1t::EtSum::EtSumType::kMinBiasHFP0;
+		     lutObj1 = "MinBias";
+		  break;
+		   default:
+		     edm::LogError("L1TGlobal")
+		       << "\n  Error: "
+		       << "Unmatched object type from template to EtSumType, cndObjTypeVec[1] = "
+		       << cndObjTypeVec[1]
+		       << std::endl;
+		     type = l1t::EtSum::EtSumType::kTotalEt;
+		     break;
+		   }
+
+
+		   candEtSumVec = m_uGtB->getCandL1EtSum();
+
+		   LogDebug("L1TGlobal") << "obj " << lutObj1 << " Vector Size " << candEtSumVec->size(cond1bx) << std::endl;
+               for( int iEtSum=0; iEtSum < (int)candEtSumVec->size(cond1bx); iEtSum++) {
+		     if( (candEtSumVec->at(cond1bx,iEtSum))->getType() == type ) {
+                   phiIndex1 =  (candEtSumVec->at(cond1bx,iEtSum))->hwPhi();
+                   etaIndex1 =  (candEtSumVec->at(cond1bx,iEtSum))->hwEta();
+		       etIndex1  =  (candEtSumVec->at(cond1bx,iEtSum))->hwPt();
+
+		       // Determine Floating Pt numbers for floating point caluclation
+
+		       if(cndObjTypeVec[1] == gtETM) {
+		         std::pair<double, double> binEdges = m_gtScales->getETMScales().phiBins.at(phiIndex1);
+			 phi1Phy = 0.5*(binEdges.second + binEdges.first);
+			 eta1Phy = 0.; //No Eta for Energy Sums
+
+			 etBin1 = etIndex1;
+			 int ssize = m_gtScales->getETMScales().etBins.size();
+			 assert(ssize > 0);
+			 if (etBin1 >= ssize){ etBin1 = ssize-1; }
+
+			 binEdges = m_gtScales->getETMScales().etBins.at(etBin1);
+			 et1Phy = 0.5*(binEdges.second + binEdges.first);
+		       } else if(cndObjTypeVec[1] == gtHTM) {
+		         std::pair<double, double> binEdges = m_gtScales->getHTMScales().phiBins.at(phiIndex1);
+			 phi1Phy = 0.5*(binEdges.second + binEdges.first);
+			 eta1Phy = 0.; //No Eta for Energy Sums
+
+			 etBin1 = etIndex1;
+			 int ssize = m_gtScales->getHTMScales().etBins.size();
+			 assert(ssize > 0);
+			 if (etBin1 >= ssize){ etBin1 = ssize-1; }
+
+			 binEdges = m_gtScales->getHTMScales().etBins.at(etBin1);
+			 et1Phy = 0.5*(binEdges.second + binEdges.first);
+		       } else if(cndObjTypeVec[1] == gtETMHF) {
+		         std::pair<double, double> binEdges = m_gtScales->getETMHFScales().phiBins.at(phiIndex1);
+			 phi1Phy = 0.5*(binEdges.second + binEdges.first);
+			 eta1Phy = 0.; //No Eta for Energy Sums
+
+			 etBin1 = etIndex1;
+			 int ssize = m_gtScales->getETMHFScales().etBins.size();
+			 assert(ssize > 0);
+			 if (etBin1 >= ssize){ etBin1 = ssize-1; }
+
+			 binEdges = m_gtScales->getETMHFScales().etBins.at(etBin1);
+			 et1Phy = 0.5*(binEdges.second + binEdges.first);
+		       }
+
+
+                   //If needed convert calo scales to muon scales for comparison (only phi for energy sums)
+                   if(convertCaloScales) {
+
+			 std::string lutName = lutObj1;
+			 lutName += "-MU";
+			 long long tst = m_gtScales->getLUT_CalMuPhi(lutName,phiIndex1);
+			 LogDebug("L1TGlobal") << lutName <<"  PhiCal = " << phiIndex1 << " PhiMu = " << tst << std::endl;
+			 phiIndex1 = tst;
+
+                   }
+
+
+                 } //check it is the EtSum we want
+               } // loop over Etsums
+
+            }
+                break;
+            default: {
+                // should not arrive here, there are no correlation conditions defined for this object
+		    LogDebug("L1TGlobal") << "Error could not find the Cond Category for Leg 0" << std::endl;
+                return false;
+            }
+                break;
+        } //end switch on second leg
+
+        m_leg1Objects.push_back(obj1Index, phiIndex1, etaIndex1, etIndex1, chrg1,
+                                phiIndex1, etaIndex1, phi1Phy, eta1Phy, et1Phy);
+    }
+
+
     // loop over all combinations which produced individually "true" as Type1s
     //
     // BLW: Optimization issue: potentially making the same comparison twice
@@ -684,23 +970,10 @@ const bool l1t::CorrCondition::evaluateCondition(const int bxEval) const {
                 break;
         } //end switch on first leg type
 
-// Now loop over the second leg to get its information
-        for (std::vector<SingleCombInCond>::const_iterator it1Comb =
-                cond1Comb.begin(); it1Comb != cond1Comb.end(); it1Comb++) {
-
-            LogDebug("L1TGlobal") << "Looking at second Condition" << std::endl;
-            // Type1s: there is 1 object only, no need for a loop (*it1Comb)[0]
-            // ... but add protection to not crash
-            int obj1Index = -1;
-
-            if (!(*it1Comb).empty()) {
-                obj1Index = (*it1Comb)[0];
-            } else {
-                LogTrace("L1TGlobal")
-                        << "\n  SingleCombInCond (*it1Comb).size() "
-                        << ((*it1Comb).size()) << std::endl;
-                return false;
-            }
+// Now loop over the second leg, with the quantities computed before the loop over the first leg
+        for (unsigned int i1 = 0; i1 < m_leg1Objects.size(); ++i1) {
+
+            int obj1Index = m_leg1Objects.index[i1];
 
 	    //If we are dealing with the same object type avoid the two legs
 	    // either being the same object
@@ -712,267 +985,17 @@ const bool l1t::CorrCondition::evaluateCondition(const int bxEval) const {
 	      continue;
 	    }
 
-            switch (cond1Categ) {
-                case CondMuon: {
-		   lutObj1 = "MU";
-                   candMuVec = m_uGtB->getCandL1Mu();
-                   phiIndex1 =  (candMuVec->at(cond1bx,obj1Index))->hwPhiAtVtx(); //(*candMuVec)[obj0Index]->phiIndex();
-                   etaIndex1 =  (candMuVec->at(cond1bx,obj1Index))->hwEtaAtVtx();
-		   etIndex1  =  (candMuVec->at(cond1bx,obj1Index))->hwPt();
-		   chrg1     =  (candMuVec->at(cond1bx,obj1Index))->hwCharge();
-		   etaBin1 = etaIndex1;
-		   if(etaBin1<0) etaBin1 = m_gtScales->getMUScales().etaBins.size() + etaBin1;
-//		   LogDebug("L1TGlobal") << "Muon phi" << phiIndex1 << " eta " << etaIndex1 << " etaBin1 = " << etaBin1  << " et " << etIndex1 << std::endl;
-
-		   etBin1 = etIndex1;
-		   int ssize = m_gtScales->getMUScales().etBins.size();
-		   if (etBin1 >= ssize){
-		     LogTrace("L1TGlobal")
-		       << "muon2 hw et" << etBin1 << " out of scale range.  Setting to maximum.";
-		     etBin1 = ssize-1;
-		   }
-
-		   // Determine Floating Pt numbers for floating point caluclation
-		   std::pair<double, double> binEdges = m_gtScales->getMUScales().phiBins.at(phiIndex1);
-		   phi1Phy = 0.5*(binEdges.second + binEdges.first);
-		   binEdges = m_gtScales->getMUScales().etaBins.at(etaBin1);
-		   eta1Phy = 0.5*(binEdges.second + binEdges.first);
-		   binEdges = m_gtScales->getMUScales().etBins.at(etBin1);
-		   et1Phy = 0.5*(binEdges.second + binEdges.first);
-
-                }
-                    break;
-                case CondCalo: {
-        	   switch(cndObjTypeVec[1]) {
-	             case gtEG: {
-			candCaloVec = m_uGtB->getCandL1EG();
-			phiIndex1 =  (candCaloVec->at(cond1bx,obj1Index))->hwPhi();
-			etaIndex1 =  (candCaloVec->at(cond1bx,obj1Index))->hwEta();
-			etIndex1  =  (candCaloVec->at(cond1bx,obj1Index))->hwPt();
-			etaBin1   =   etaIndex1;
-			if(etaBin1<0) etaBin1 = m_gtScales->getEGScales().etaBins.size() + etaBin1;
-
-			etBin1 = etIndex1;
-			int ssize = m_gtScales->getEGScales().etBins.size();
-			if (etBin1 >= ssize){
-			  LogTrace("L1TGlobal")
-			    << "EG1 hw et" << etBin1 << " out of scale range.  Setting to maximum.";
-			  etBin1 = ssize-1;
-			}
-
-			// Determine Floating Pt numbers for floating point caluclation
-		   	std::pair<double, double> binEdges = m_gtScales->getEGScales().phiBins.at(phiIndex1);
-		   	phi1Phy = 0.5*(binEdges.second + binEdges.first);
-			binEdges = m_gtScales->getEGScales().etaBins.at(etaBin1);
-			eta1Phy = 0.5*(binEdges.second + binEdges.first);
-			binEdges = m_gtScales->getEGScales().etBins.at(etBin1);
-			et1Phy = 0.5*(binEdges.second + binEdges.first);
-		    	lutObj1 = "EG";
-		     }
-		       break;
-		     case gtJet: {
-			candCaloVec = m_uGtB->getCandL1Jet();
-			phiIndex1 =  (candCaloVec->at(cond1bx,obj1Index))->hwPhi();
-			etaIndex1 =  (candCaloVec->at(cond1bx,obj1Index))->hwEta();
-			etIndex1  =  (candCaloVec->at(cond1bx,obj1Index))->hwPt();
-			etaBin1 = etaIndex1;
-			if(etaBin1<0) etaBin1 = m_gtScales->getJETScales().etaBins.size() + etaBin1;
-
-			etBin1 = etIndex1;
-			int ssize = m_gtScales->getJETScales().etBins.size();
-			assert(ssize);
-			if (etBin1 >= ssize){
-			  //edm::LogWarning("L1TGlobal")
-			  //<< "jet2 hw et" << etBin1 << " out of scale range.  Setting to maximum.";
-			  etBin1 = ssize-1;
-			}
-
-			// Determine Floating Pt numbers for floating point caluclation
-		   	std::pair<double, double> binEdges = m_gtScales->getJETScales().phiBins.at(phiIndex1);
-		   	phi1Phy = 0.5*(binEdges.second + binEdges.first);
-			binEdges = m_gtScales->getJETScales().etaBins.at(etaBin1);
-			eta1Phy = 0.5*(binEdges.second + binEdges.first);
-			//CRASHES HERE:
-			binEdges = m_gtScales->getJETScales().etBins.at(etBin1);
-			et1Phy = 0.5*(binEdges.second + binEdges.first);
-			lutObj1 = "JET";
-		     }
-		       break;
-		     case gtTau: {
-			candCaloVec = m_uGtB->getCandL1Tau();
-			phiIndex1 =  (candCaloVec->at(cond1bx,obj1Index))->hwPhi();
-			etaIndex1 =  (candCaloVec->at(cond1bx,obj1Index))->hwEta();
-			etIndex1  =  (candCaloVec->at(cond1bx,obj1Index))->hwPt();
-			etaBin1 = etaIndex1;
-			if(etaBin1<0) etaBin1 = m_gtScales->getTAUScales().etaBins.size() + etaBin1;
-
-			etBin1 = etIndex1;
-			int ssize = m_gtScales->getTAUScales().etBins.size();
-			if (etBin1 >= ssize){
-			  LogTrace("L1TGlobal")
-			    << "tau2 hw et" << etBin1 << " out of scale range.  Setting to maximum.";
-			  etBin1 = ssize-1;
-			}
+            phiIndex1 = m_leg1Objects.phiIndex[i1];
+            etaIndex1 = m_leg1Objects.etaIndex[i1];
+            etIndex1  = m_leg1Objects.etIndex[i1];
+            chrg1     = m_leg1Objects.chrg[i1];
+            phi1Phy   = m_leg1Objects.phiPhy[i1];
+            eta1Phy   = m_leg1Objects.etaPhy[i1];
+            et1Phy    = m_leg1Objects.etPhy[i1];
 
-			// Determine Floating Pt numbers for floating point caluclation
-		   	std::pair<double, double> binEdges = m_gtScales->getTAUScales().phiBins.at(phiIndex1);
-		   	phi1Phy = 0.5*(binEdges.second + binEdges.first);
-			binEdges = m_gtScales->getTAUScales().etaBins.at(etaBin1);
-			eta1Phy = 0.5*(binEdges.second + binEdges.first);
-			binEdges = m_gtScales->getTAUScales().etBins.at(etBin1);
-			et1Phy = 0.5*(binEdges.second + binEdges.first);
-			lutObj1 = "TAU";
-		     }
-	               break;
-		     default: {
-		     }
-	           break;
-	           } //end switch on calo type.
-
-
-                   //If needed convert calo scales to muon scales for comparison
-                   if(convertCaloScales) {
-
-		     std::string lutName = lutObj1;
-		     lutName += "-MU";
-		     long long tst = m_gtScales->getLUT_CalMuEta(lutName,etaBin1);
-		     LogDebug("L1TGlobal") << lutName <<"  EtaCal = " << etaIndex1 << " EtaMu = " << tst << std::endl;
-		     etaIndex1 = tst;
-
-
-		     tst = m_gtScales->getLUT_CalMuPhi(lutName,phiIndex1);
-		     LogDebug("L1TGlobal") << lutName <<"  PhiCal = " << phiIndex1 << " PhiMu = " << tst << std::endl;
-		     phiIndex1 = tst;
-
-                   }
-
-
-                }
-                    break;
-                case CondEnergySum: {
-
-                   LogDebug("L1TGlobal") << "Looking at second Condition as Energy Sum: " << cndObjTypeVec[1] << std::endl;
-                   etSumCond = true;
-
-		   //Stupid mapping between enum types for energy sums.
-		   l1t::EtSum::EtSumType type;
-		   switch( cndObjTypeVec[1] ){
-		   case gtETM:
-		     type = l1t::EtSum::EtSumType::kMissingEt;
-		     lutObj1 = "ETM";
-		     break;
-		   case gtETT:
-		     type = l1t::EtSum::EtSumType::kTotalEt;
-		     lutObj1 = "ETT";
-		     break;
-		   case gtETTem:
-		     type = l1t::EtSum::EtSumType::kTotalEtEm;
-		     lutObj1 = "ETTem";
-		     break;
-		   case gtHTM:
-		     type = l1t::EtSum::EtSumType::kMissingHt;
-		     lutObj1 = "HTM";
-		     break;
-		   case gtHTT:
-		     type = l1t::EtSum::EtSumType::kTotalHt;
-		     lutObj1 = "HTT";
-		     break;
-		   case gtETMHF:
-		     type = l1t::EtSum::EtSumType::kMissingEtHF;
-		     lutObj1 = "ETMHF";
-		     break;
-		   case gtMinBiasHFP0:
-		   case gtMinBiasHFM0:
-		   case gtMinBiasHFP1:
-		   case gtMinBiasHFM1:
-		     type = l1t::EtSum::EtSumType::kMinBiasHFP0;
-		     lutObj1 = "MinBias";
-		  break;
-		   default:
-		     edm::LogError("L1TGlobal")
-		       << "\n  Error: "
-		       << "Unmatched object type from template to EtSumType, cndObjTypeVec[1] = "
-		       << cndObjTypeVec[1]
-		       << std::endl;
-		     type = l1t::EtSum::EtSumType::kTotalEt;
-		     break;
-		   }
-
-
-		   candEtSumVec = m_uGtB->getCandL1EtSum();
-
-		   LogDebug("L1TGlobal") << "obj " << lutObj1 << " Vector Size " << candEtSumVec->size(cond1bx) << std::endl;
-                   for( int iEtSum=0; iEtSum < (int)candEtSumVec->size(cond1bx); iEtSum++) {
-		     if( (candEtSumVec->at(cond1bx,iEtSum))->getType() == type ) {
-                       phiIndex1 =  (candEtSumVec->at(cond1bx,iEtSum))->hwPhi();
-                       etaIndex1 =  (candEtSumVec->at(cond1bx,iEtSum))->hwEta();
-		       etIndex1  =  (candEtSumVec->at(cond1bx,iEtSum))->hwPt();
-
-		       // Determine Floating Pt numbers for floating point caluclation
-
-		       if(cndObjTypeVec[1] == gtETM) {
-		         std::pair<double, double> binEdges = m_gtScales->getETMScales().phiBins.at(phiIndex1);
-			 phi1Phy = 0.5*(binEdges.second + binEdges.first);
-			 eta1Phy = 0.; //No Eta for Energy Sums
-
-			 etBin1 = etIndex1;
-			 int ssize = m_gtScales->getETMScales().etBins.size();
-			 assert(ssize > 0);
-			 if (etBin1 >= ssize){ etBin1 = ssize-1; }
-
-			 binEdges = m_gtScales->getETMScales().etBins.at(etBin1);
-			 et1Phy = 0.5*(binEdges.second + binEdges.first);
-		       } else if(cndObjTypeVec[1] == gtHTM) {
-		         std::pair<double, double> binEdges = m_gtScales->getHTMScales().phiBins.at(phiIndex1);
-			 phi1Phy = 0.5*(binEdges.second + binEdges.first);
-			 eta1Phy = 0.; //No Eta for Energy Sums
-
-			 etBin1 = etIndex1;
-			 int ssize = m_gtScales->getHTMScales().etBins.size();
-			 assert(ssize > 0);
-			 if (etBin1 >= ssize){ etBin1 = ssize-1; }
-
-			 binEdges = m_gtScales->getHTMScales().etBins.at(etBin1);
-			 et1Phy = 0.5*(binEdges.second + binEdges.first);
-		       } else if(cndObjTypeVec[1] == gtETMHF) {
-		         std::pair<double, double> binEdges = m_gtScales->getETMHFScales().phiBins.at(phiIndex1);
-			 phi1Phy = 0.5*(binEdges.second + binEdges.first);
-			 eta1Phy = 0.; //No Eta for Energy Sums
-
-			 etBin1 = etIndex1;
-			 int ssize = m_gtScales->getETMHFScales().etBins.size();
-			 assert(ssize > 0);
-			 if (etBin1 >= ssize){ etBin1 = ssize-1; }
-
-			 binEdges = m_gtScales->getETMHFScales().etBins.at(etBin1);
-			 et1Phy = 0.5*(binEdges.second + binEdges.first);
-		       }
-
-
-                       //If needed convert calo scales to muon scales for comparison (only phi for energy sums)
-                       if(convertCaloScales) {
-
-			 std::string lutName = lutObj1;
-			 lutName += "-MU";
-			 long long tst = m_gtScales->getLUT_CalMuPhi(lutName,phiIndex1);
-			 LogDebug("L1TGlobal") << lutName <<"  PhiCal = " << phiIndex1 << " PhiMu = " << tst << std::endl;
-			 phiIndex1 = tst;
-
-                       }
-
-
-                     } //check it is the EtSum we want
-                   } // loop over Etsums
-
-                }
-                    break;
-                default: {
-                    // should not arrive here, there are no correlation conditions defined for this object
-		    LogDebug("L1TGlobal") << "Error could not find the Cond Category for Leg 0" << std::endl;
-                    return false;
-                }
-                    break;
-            } //end switch on second leg
+            if (cond1Categ == CondEnergySum) {
+                etSumCond = true;
+            }
 
             if (m_verbosity) {
                 LogDebug("L1TGlobal") << "    Correlation pair ["
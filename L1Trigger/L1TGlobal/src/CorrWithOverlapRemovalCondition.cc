@@ -290,257 +290,777 @@ const bool l1t::CorrWithOverlapRemovalCondition::evaluateCondition(const int bxE
     // second object
     reqObjResult = false;
 
-    switch (cond1Categ) {
-        case CondMuon: {
-            corrMuon = static_cast<const MuonTemplate*>(m_gtCond1);
-            MuCondition muCondition(corrMuon, m_uGtB,
-                    0,0); //BLW these are counts that don't seem to be used...perhaps remove
+      switch (cond1Categ) {
+          case CondMuon: {
+              corrMuon = static_cast<const MuonTemplate*>(m_gtCond1);
+              MuCondition muCondition(corrMuon, m_uGtB,
+                      0,0); //BLW these are counts that don't seem to be used...perhaps remove
 
-            muCondition.evaluateConditionStoreResult(bxEval);
-            reqObjResult = muCondition.condLastResult();
+              muCondition.evaluateConditionStoreResult(bxEval);
+              reqObjResult = muCondition.condLastResult();
 
-            cond1Comb = (muCondition.getCombinationsInCond());
-            cond1bx = bxEval + (corrMuon->condRelativeBx());
-            cndObjTypeVec[1] = (corrMuon->objectType())[0];
+              cond1Comb = (muCondition.getCombinationsInCond());
+              cond1bx = bxEval + (corrMuon->condRelativeBx());
+              cndObjTypeVec[1] = (corrMuon->objectType())[0];
 
-            if (m_verbosity) {
-                std::ostringstream myCout;
-                muCondition.print(myCout);
+              if (m_verbosity) {
+                  std::ostringstream myCout;
+                  muCondition.print(myCout);
 
-               LogDebug("L1TGlobal") << myCout.str() << std::endl;
-            }
+                 LogDebug("L1TGlobal") << myCout.str() << std::endl;
+              }
+          }
+              break;
+          case CondCalo: {
+              corrCalo = static_cast<const CaloTemplate*>(m_gtCond1);
+              CaloCondition caloCondition(corrCalo, m_uGtB,
+                      0, 0, 0, 0); //BLW these are counters that don't seem to be used...perhaps remove.
+
+              caloCondition.evaluateConditionStoreResult(bxEval);
+              reqObjResult = caloCondition.condLastResult();
+
+              cond1Comb = (caloCondition.getCombinationsInCond());
+              cond1bx = bxEval + (corrCalo->condRelativeBx());
+
+              cndObjTypeVec[1] = (corrCalo->objectType())[0];
+
+              if (m_verbosity ) {
+                  std::ostringstream myCout;
+                  caloCondition.print(myCout);
+
+                  LogDebug("L1TGlobal") << myCout.str() << std::endl;
+              }
+
+          }
+              break;
+          case CondEnergySum: {
+              corrEnergySum = static_cast<const EnergySumTemplate*>(m_gtCond1);
+
+              EnergySumCondition eSumCondition(corrEnergySum, m_uGtB);
+
+              eSumCondition.evaluateConditionStoreResult(bxEval);
+              reqObjResult = eSumCondition.condLastResult();
+
+              cond1Comb = (eSumCondition.getCombinationsInCond());
+              cond1bx = bxEval + (corrEnergySum->condRelativeBx());
+              cndObjTypeVec[1] = (corrEnergySum->objectType())[0];
+
+              if (m_verbosity) {
+                  std::ostringstream myCout;
+                  eSumCondition.print(myCout);
+
+                  LogDebug("L1TGlobal") << myCout.str() << std::endl;
+              }
+          }
+              break;
+          default: {
+              // should not arrive here, there are no correlation conditions defined for this object
+              return false;
+          }
+              break;
+      }
+
+      // return if second sub-condition is false
+      if (!reqObjResult) {
+          return false;
+      } else {
+          LogDebug("L1TGlobal") << "\n"
+                  << "    Both sub-conditions true for object requirements."
+                  << "    Evaluate correlation requirements.\n" << std::endl;
+
+      }
+
+      // third object (used for overlap removal)
+      reqObjResult = false;
+
+      switch (cond2Categ) {
+          case CondMuon: {
+              corrMuon = static_cast<const MuonTemplate*>(m_gtCond2);
+              MuCondition muCondition(corrMuon, m_uGtB,
+                      0,0); //BLW these are counts that don't seem to be used...perhaps remove
+
+              muCondition.evaluateConditionStoreResult(bxEval);
+              reqObjResult = muCondition.condLastResult();
+
+              cond2Comb = (muCondition.getCombinationsInCond());
+              cond2bx = bxEval + (corrMuon->condRelativeBx());
+              cndObjTypeVec[2] = (corrMuon->objectType())[0];
+
+              if (m_verbosity) {
+                  std::ostringstream myCout;
+                  muCondition.print(myCout);
+
+                 LogDebug("L1TGlobal") << myCout.str() << std::endl;
+              }
+          }
+              break;
+          case CondCalo: {
+              corrCalo = static_cast<const CaloTemplate*>(m_gtCond2);
+              CaloCondition caloCondition(corrCalo, m_uGtB,
+                      0, 0, 0, 0); //BLW these are counters that don't seem to be used...perhaps remove.
+
+              caloCondition.evaluateConditionStoreResult(bxEval);
+              reqObjResult = caloCondition.condLastResult();
+
+              cond2Comb = (caloCondition.getCombinationsInCond());
+              cond2bx = bxEval + (corrCalo->condRelativeBx());
+              cndObjTypeVec[2] = (corrCalo->objectType())[0];
+
+              if (m_verbosity ) {
+                  std::ostringstream myCout;
+                  caloCondition.print(myCout);
+
+                  LogDebug("L1TGlobal") << myCout.str() << std::endl;
+              }
+
+          }
+              break;
+          case CondEnergySum: {
+              corrEnergySum = static_cast<const EnergySumTemplate*>(m_gtCond2);
+
+              EnergySumCondition eSumCondition(corrEnergySum, m_uGtB);
+
+              eSumCondition.evaluateConditionStoreResult(bxEval);
+              reqObjResult = eSumCondition.condLastResult();
+
+              cond2Comb = (eSumCondition.getCombinationsInCond());
+              cond2bx = bxEval + (corrEnergySum->condRelativeBx());
+              cndObjTypeVec[2] = (corrEnergySum->objectType())[0];
+
+              if (m_verbosity) {
+                  std::ostringstream myCout;
+                  eSumCondition.print(myCout);
+
+                  LogDebug("L1TGlobal") << myCout.str() << std::endl;
+              }
+          }
+              break;
+          default: {
+              // should not arrive here, there are no correlation conditions defined for this object
+              return false;
+          }
+              break;
+      }
+
+      // if third sub-condition is false, effectively there will no overlap removal
+      if (!reqObjResult) {
+          LogDebug("L1TGlobal") << "\n"
+                  << "    Third sub-condtion false for object requirements."
+                  << "    Algorithm returning false.\n" << std::endl;
+	return false;
+      } else {
+          LogDebug("L1TGlobal") << "\n"
+                  << "    All three sub-conditions true for object requirements."
+                  << "    Evaluate correlation requirements and overlap removal.\n" << std::endl;
+
+      }
+
+      // since we have two good legs and overlap-removal let, get the correlation parameters
+      CorrelationWithOverlapRemovalTemplate::CorrelationWithOverlapRemovalParameter corrPar = *(m_gtCorrelationWithOverlapRemovalTemplate->correlationParameter());
+
+      // vector to store the indices of the calorimeter objects
+      // from the combination evaluated in the condition
+      SingleCombInCond objectsInComb;
+      objectsInComb.reserve(nObjInCond);
+
+      // clear the m_combinationsInCond vector
+      (combinationsInCond()).clear();
+
+      // pointers to objects
+      const BXVector<const l1t::Muon*>*        candMuVec    = nullptr;
+      const BXVector<const l1t::L1Candidate*>* candCaloVec  = nullptr;
+      const BXVector<const l1t::EtSum*>*       candEtSumVec = nullptr;
+
+      bool etSumCond = false;
+
+      // make the conversions of the indices, depending on the combination of objects involved
+      // (via pair index)
+
+      int phiIndex0  = 0;
+      int phiIndex1  = 0;
+      int phiORIndex0  = 0; // hold phi index transformed in case of need with overlap-removal
+      int phiORIndex1  = 0; // hold phi index transformed in case of need with overlap-removal
+      double phi0Phy = 0.;
+      double phi1Phy = 0.;
+
+      int etaIndex0  = 0;
+      int etaIndex1  = 0;
+      int etaORIndex0  = 0;
+      int etaORIndex1  = 0;
+      double eta0Phy = 0.;
+      double eta1Phy = 0.;
+      int etaBin0    = 0;
+      int etaBin1    = 0;
+
+      int etIndex0  = 0;
+      int etIndex1  = 0;
+      int etBin0    = 0;
+      int etBin1    = 0;
+      double et0Phy = 0.;
+      double et1Phy = 0.;
+
+      int chrg0 = -1;
+      int chrg1 = -1;
+
+      // make the conversions of the indices, depending on the combination of objects involved in overlap-removal
+      int phiIndex2  = 0;
+      int etaIndex2  = 0;
+      double phi2Phy = 0.;
+      double eta2Phy = 0.;
+      int etaBin2    = 0;
+      //int etIndex2  = 0;
+      //int etBin2    = 0;
+
+// Determine the number of phi bins to get cutoff at pi
+      int phiBound = 0;
+      if(cond0Categ == CondMuon || cond1Categ == CondMuon || cond2Categ == CondMuon) {
+        GlobalScales::ScaleParameters par = m_gtScales->getMUScales();
+        //phiBound = par.phiBins.size()/2;
+        phiBound = (int)((par.phiMax - par.phiMin)/par.phiStep)/2;
+      } else {
+        //Assumes all calorimeter objects are on same phi scale
+        GlobalScales::ScaleParameters par = m_gtScales->getEGScales();
+        //phiBound = par.phiBins.size()/2;
+        phiBound = (int)((par.phiMax - par.phiMin)/par.phiStep)/2;
+      }
+      LogDebug("L1TGlobal") << "Phi Bound = " << phiBound << std::endl;
+
+
+// Keep track of objects for LUTS
+      std::string lutObj0 = "NULL";
+      std::string lutObj1 = "NULL";
+      std::string lutObj2 = "NULL";
+
+
+      LogTrace("L1TGlobal")
+        << "  Sub-condition 0: std::vector<SingleCombInCond> size: "
+        << (cond0Comb.size()) << std::endl;
+      LogTrace("L1TGlobal")
+        << "  Sub-condition 1: std::vector<SingleCombInCond> size: "
+        << (cond1Comb.size()) << std::endl;
+      LogTrace("L1TGlobal")
+        << "  Sub-condition 2: std::vector<SingleCombInCond> size: "
+        << (cond2Comb.size()) << std::endl;
+
+
+      // quantities of the objects of the second and of the overlap-removal legs,
+      // computed once for all the pairs
+      m_leg1Objects.clear();
+
+      for (std::vector<SingleCombInCond>::const_iterator it1Comb = cond1Comb.begin(); it1Comb != cond1Comb.end(); it1Comb++) {
+
+        LogDebug("L1TGlobal") << "Looking at second Condition" << std::endl;
+        // Type1s: there is 1 object only, no need for a loop (*it1Comb)[0]
+        // ... but add protection to not crash
+        int obj1Index = -1;
+
+        if (!(*it1Comb).empty()) {
+          obj1Index = (*it1Comb)[0];
+        } else {
+          LogTrace("L1TGlobal")
+          << "\n  SingleCombInCond (*it1Comb).size() "
+          << ((*it1Comb).size()) << std::endl;
+          return false;
         }
-            break;
+
+      switch (cond1Categ) {
+        case CondMuon: {
+          lutObj1 = "MU";
+          candMuVec = m_uGtB->getCandL1Mu();
+          phiIndex1 =  (candMuVec->at(cond1bx,obj1Index))->hwPhi(); //(*candMuVec)[obj0Index]->phiIndex();
+          etaIndex1 =  (candMuVec->at(cond1bx,obj1Index))->hwEta();
+          etIndex1  =  (candMuVec->at(cond1bx,obj1Index))->hwPt();
+          chrg1     =  (candMuVec->at(cond1bx,obj1Index))->hwCharge();
+          etaBin1 = etaIndex1;
+          if(etaBin1<0) etaBin1 = m_gtScales->getMUScales().etaBins.size() + etaBin1;
+          //		   LogDebug("L1TGlobal") << "Muon phi" << phiIndex1 << " eta " << etaIndex1 << " etaBin1 = " << etaBin1  << " et " << etIndex1 << std::endl;
+          etBin1 = etIndex1;
+          int ssize = m_gtScales->getMUScales().etBins.size();
+
+          if (etBin1 >= ssize){
+            LogTrace("L1TGlobal")
+            << "muon2 hw et" << etBin1 << " out of scale range.  Setting to maximum.";
+            etBin1 = ssize-1;
+          }
+
+          // Determine Floating Pt numbers for floating point caluclation
+          std::pair<double, double> binEdges = m_gtScales->getMUScales().phiBins.at(phiIndex1);
+          phi1Phy = 0.5*(binEdges.second + binEdges.first);
+          binEdges = m_gtScales->getMUScales().etaBins.at(etaBin1);
+          eta1Phy = 0.5*(binEdges.second + binEdges.first);
+          binEdges = m_gtScales->getMUScales().etBins.at(etBin1);
+          et1Phy = 0.5*(binEdges.second + binEdges.first);
+
+        }
+          break;
+
         case CondCalo: {
-            corrCalo = static_cast<const CaloTemplate*>(m_gtCond1);
-            CaloCondition caloCondition(corrCalo, m_uGtB,
-                    0, 0, 0, 0); //BLW these are counters that don't seem to be used...perhaps remove.
 
-            caloCondition.evaluateConditionStoreResult(bxEval);
-            reqObjResult = caloCondition.condLastResult();
+          switch(cndObjTypeVec[1]) {
 
-            cond1Comb = (caloCondition.getCombinationsInCond());
-            cond1bx = bxEval + (corrCalo->condRelativeBx());
+            case gtEG: {
 
-            cndObjTypeVec[1] = (corrCalo->objectType())[0];
+              candCaloVec = m_uGtB->getCandL1EG();
+              phiIndex1 =  (candCaloVec->at(cond1bx,obj1Index))->hwPhi();
+              etaIndex1 =  (candCaloVec->at(cond1bx,obj1Index))->hwEta();
+              etIndex1  =  (candCaloVec->at(cond1bx,obj1Index))->hwPt();
+              etaBin1   =   etaIndex1;
+              if(etaBin1<0) etaBin1 = m_gtScales->getEGScales().etaBins.size() + etaBin1;
 
-            if (m_verbosity ) {
-                std::ostringstream myCout;
-                caloCondition.print(myCout);
+              etBin1 = etIndex1;
+              int ssize = m_gtScales->getEGScales().etBins.size();
+              if (etBin1 >= ssize){
+                LogTrace("L1TGlobal")
+                << "EG1 hw et" << etBin1 << " out of scale range.  Setting to maximum.";
+                etBin1 = ssize-1;
+              }
 
-                LogDebug("L1TGlobal") << myCout.str() << std::endl;
+              // Determine Floating Pt numbers for floating point caluclation
+              std::pair<double, double> binEdges = m_gtScales->getEGScales().phiBins.at(phiIndex1);
+              phi1Phy = 0.5*(binEdges.second + binEdges.first);
+              binEdges = m_gtScales->getEGScales().etaBins.at(etaBin1);
+              eta1Phy = 0.5*(binEdges.second + binEdges.first);
+              binEdges = m_gtScales->getEGScales().etBins.at(etBin1);
+              et1Phy = 0.5*(binEdges.second + binEdges.first);
+              lutObj1 = "EG";
             }
+              break;
 
-        }
-            break;
-        case CondEnergySum: {
-            corrEnergySum = static_cast<const EnergySumTemplate*>(m_gtCond1);
+            case gtJet: {
+              candCaloVec = m_uGtB->getCandL1Jet();
+              phiIndex1 =  (candCaloVec->at(cond1bx,obj1Index))->hwPhi();
+              etaIndex1 =  (candCaloVec->at(cond1bx,obj1Index))->hwEta();
+              etIndex1  =  (candCaloVec->at(cond1bx,obj1Index))->hwPt();
+              etaBin1 = etaIndex1;
+              if(etaBin1<0) etaBin1 = m_gtScales->getJETScales().etaBins.size() + etaBin1;
+              etBin1 = etIndex1;
+              int ssize = m_gtScales->getJETScales().etBins.size();
+              assert(ssize);
+              if (etBin1 >= ssize){
+                //edm::LogWarning("L1TGlobal")
+                //<< "jet2 hw et" << etBin1 << " out of scale range.  Setting to maximum.";
+                etBin1 = ssize-1;
+              }
 
-            EnergySumCondition eSumCondition(corrEnergySum, m_uGtB);
+              // Determine Floating Pt numbers for floating point caluclation
+              std::pair<double, double> binEdges = m_gtScales->getJETScales().phiBins.at(phiIndex1);
+              phi1Phy = 0.5*(binEdges.second + binEdges.first);
+              binEdges = m_gtScales->getJETScales().etaBins.at(etaBin1);
+              eta1Phy = 0.5*(binEdges.second + binEdges.first);
+
+              binEdges = m_gtScales->getJETScales().etBins.at(etBin1);
+              et1Phy = 0.5*(binEdges.second + binEdges.first);
+              lutObj1 = "JET";
+            }
+              break;
 
-            eSumCondition.evaluateConditionStoreResult(bxEval);
-            reqObjResult = eSumCondition.condLastResult();
+            case gtTau: {
+              candCaloVec = m_uGtB->getCandL1Tau();
+              phiIndex1 =  (candCaloVec->at(cond1bx,obj1Index))->hwPhi();
+              etaIndex1 =  (candCaloVec->at(cond1bx,obj1Index))->hwEta();
+              etIndex1  =  (candCaloVec->at(cond1bx,obj1Index))->hwPt();
+              etaBin1 = etaIndex1;
+              if(etaBin1<0) etaBin1 = m_gtScales->getTAUScales().etaBins.size() + etaBin1;
+              etBin1 = etIndex1;
+              int ssize = m_gtScales->getTAUScales().etBins.size();
+              if (etBin1 >= ssize){
+                LogTrace("L1TGlobal")
+                << "tau2 hw et" << etBin1 << " out of scale range.  Setting to maximum.";
+                etBin1 = ssize-1;
+              }
 
-            cond1Comb = (eSumCondition.getCombinationsInCond());
-            cond1bx = bxEval + (corrEnergySum->condRelativeBx());
-            cndObjTypeVec[1] = (corrEnergySum->objectType())[0];
+              // Determine Floating Pt numbers for floating point caluclation
+              std::pair<double, double> binEdges = m_gtScales->getTAUScales().phiBins.at(phiIndex1);
+              phi1Phy = 0.5*(binEdges.second + binEdges.first);
+              binEdges = m_gtScales->getTAUScales().etaBins.at(etaBin1);
+              eta1Phy = 0.5*(binEdges.second + binEdges.first);
+              binEdges = m_gtScales->getTAUScales().etBins.at(etBin1);
+              et1Phy = 0.5*(binEdges.second + binEdges.first);
+              lutObj1 = "TAU";
+            }
+              break;
+            default: {
+            }
+              break;
 
-            if (m_verbosity) {
-                std::ostringstream myCout;
-                eSumCondition.print(myCout);
+          } //end switch on calo type.
 
-                LogDebug("L1TGlobal") << myCout.str() << std::endl;
-            }
-        }
+
+          phiORIndex1 = phiIndex1;
+          etaORIndex1 = etaIndex1;
+
+          //If needed convert calo scales to muon scales for comparison
+          if(convertCaloScales) {
+
+            std::string lutName = lutObj1;
+            lutName += "-MU";
+            long long tst = m_gtScales->getLUT_CalMuEta(lutName,etaBin1);
+            LogDebug("L1TGlobal") << lutName <<"  EtaCal = " << etaIndex1 << " EtaMu = " << tst << std::endl;
+            etaIndex1 = tst;
+            tst = m_gtScales->getLUT_CalMuPhi(lutName,phiIndex1);
+            LogDebug("L1TGlobal") << lutName <<"  PhiCal = " << phiIndex1 << " PhiMu = " << tst << std::endl;
+            phiIndex1 = tst;
+
+          }
+
+          //If needed convert calo scales to muon scales for comparison
+          if(convertCaloScalesForOverlapRemovalFromLeg1) {
+            phiORIndex1 = phiIndex1;
+            etaORIndex1 = etaIndex1;
+
+          }
+
+
+        }  // end case CondCalo
+          break;
+        case CondEnergySum: {
+
+          LogDebug("L1TGlobal") << "Looking at second Condition as Energy Sum: " << cndObjTypeVec[1] << std::endl;
+
+          //Stupid mapping between enum types for energy sums.
+          l1t::EtSum::EtSumType type;
+
+          switch( cndObjTypeVec[1] ){
+          case gtETM:
+            type = l1t::EtSum::EtSumType::kMissingEt;
+            lutObj1 = "ETM";
+            break;
+          case gtETT:
+            type = l1t::EtSum::EtSumType::kTotalEt;
+            lutObj1 = "ETT";
+            break;
+          case gtETTem:
+            type = l1t::EtSum::EtSumType::kTotalEtEm;
+            lutObj1 = "ETTem";
+            break;
+          case gtHTM:
+            type = l1t::EtSum::EtSumType::kMissingHt;
+            lutObj1 = "HTM";
+            break;
+          case gtHTT:
+            type = l1t::EtSum::EtSumType::kTotalHt;
+            lutObj1 = "HTT";
+            break;
+          case gtETMHF:
+            type = l1t::EtSum::EtSumType::kMissingEtHF;
+            lutObj1 = "ETMHF";
+            break;
+          case gtMinBiasHFP0:
+          case gtMinBiasHFM0:
+          case gtMinBiasHFP1:
+          case gtMinBiasHFM1:
+            type = l1t::EtSum::EtSumType::kMinBiasHFP0;
+            lutObj1 = "MinBias";
+            break;
+          default:
+            edm::LogError("L1TGlobal")
+              << "\n  Error: "
+              << "Unmatched object type from template to EtSumType, cndObjTypeVec[1] = "
+              << cndObjTypeVec[1]
+              << std::endl;
+            type = l1t::EtSum::EtSumType::kTotalEt;
             break;
+          }
+
+          candEtSumVec = m_uGtB->getCandL1EtSum();
+
+          LogDebug("L1TGlobal") << "obj " << lutObj1 << " Vector Size " << candEtSumVec->size(cond1bx) << std::endl;
+          for( int iEtSum=0; iEtSum < (int)candEtSumVec->size(cond1bx); iEtSum++) {
+            if( (candEtSumVec->at(cond1bx,iEtSum))->getType() == type ) {
+              phiIndex1 =  (candEtSumVec->at(cond1bx,iEtSum))->hwPhi();
+              etaIndex1 =  (candEtSumVec->at(cond1bx,iEtSum))->hwEta();
+              etIndex1  =  (candEtSumVec->at(cond1bx,iEtSum))->hwPt();
+
+              // Determine Floating Pt numbers for floating point caluclation
+
+              if(cndObjTypeVec[1] == gtETM) {
+                std::pair<double, double> binEdges = m_gtScales->getETMScales().phiBins.at(phiIndex1);
+                phi1Phy = 0.5*(binEdges.second + binEdges.first);
+                eta1Phy = 0.; //No Eta for Energy Sums
+
+                etBin1 = etIndex1;
+                int ssize = m_gtScales->getETMScales().etBins.size();
+                assert(ssize > 0);
+                if (etBin1 >= ssize){ etBin1 = ssize-1; }
+
+                binEdges = m_gtScales->getETMScales().etBins.at(etBin1);
+                et1Phy = 0.5*(binEdges.second + binEdges.first);
+              } else if(cndObjTypeVec[1] == gtHTM) {
+                std::pair<double, double> binEdges = m_gtScales->getHTMScales().phiBins.at(phiIndex1);
+                phi1Phy = 0.5*(binEdges.second + binEdges.first);
+                eta1Phy = 0.; //No Eta for Energy Sums
+
+                etBin1 = etIndex1;
+                int ssize = m_gtScales->getHTMScales().etBins.size();
+                assert(ssize > 0);
+              if (etBin1 >= ssize){ etBin1 = ssize-1; }
+
+                binEdges = m_gtScales->getHTMScales().etBins.at(etBin1);
+                et1Phy = 0.5*(binEdges.second + binEdges.first);
+              } else if(cndObjTypeVec[1] == gtETMHF) {
+                std::pair<double, double> binEdges = m_gtScales->getETMHFScales().phiBins.at(phiIndex1);
+                phi1Phy = 0.5*(binEdges.second + binEdges.first);
+                eta1Phy = 0.; //No Eta for Energy Sums
+                etBin1 = etIndex1;
+                int ssize = m_gtScales->getETMHFScales().etBins.size();
+                assert(ssize > 0);
+                if (etBin1 >= ssize){ etBin1 = ssize-1; }
+                binEdges = m_gtScales->getETMHFScales().etBins.at(etBin1);
+                et1Phy = 0.5*(binEdges.second + binEdges.first);
+              }
+
+              phiORIndex1 = phiIndex1;
+              etaORIndex1 = etaIndex1;
+
+              //If needed convert calo scales to muon scales for comparison (only phi for energy sums)
+              if(convertCaloScales) {
+
+                std::string lutName = lutObj1;
+                lutName += "-MU";
+                long long tst = m_gtScales->getLUT_CalMuPhi(lutName,phiIndex1);
+                LogDebug("L1TGlobal") << lutName <<"  PhiCal = " << phiIndex1 << " PhiMu = " << tst << std::endl;
+                phiIndex1 = tst;
+
+              }
+
+              //If needed convert calo scales to muon scales for comparison (only phi for energy sums)
+              if(convertCaloScalesForOverlapRemovalFromLeg1) {
+                phiORIndex1 = phiIndex1;
+              }
+
+            } //check it is the EtSum we want
+          } // loop over Etsums
+
+        } // end case EnergySum
+          break;
         default: {
-            // should not arrive here, there are no correlation conditions defined for this object
-            return false;
+          // should not arrive here, there are no correlation conditions defined for this object
+          LogDebug("L1TGlobal") << "Error could not find the Cond Category for Leg 0" << std::endl;
+          return false;
         }
-            break;
+          break;
+      } //end switch on second leg
+
+      m_leg1Objects.push_back(obj1Index, phiIndex1, etaIndex1, etIndex1, chrg1,
+                              phiORIndex1, etaORIndex1, phi1Phy, eta1Phy, et1Phy);
     }
 
-    // return if second sub-condition is false
-    if (!reqObjResult) {
-        return false;
-    } else {
-        LogDebug("L1TGlobal") << "\n"
-                << "    Both sub-conditions true for object requirements."
-                << "    Evaluate correlation requirements.\n" << std::endl;
+    m_leg2Objects.clear();
 
-    }
+    for (std::vector<SingleCombInCond>::const_iterator it2Comb = cond2Comb.begin(); it2Comb != cond2Comb.end(); it2Comb++) {
 
-    // third object (used for overlap removal)
-    reqObjResult = false;
+      // Type1s: there is 1 object only, no need for a loop, index 0 should be OK in (*it2Comb)[0]
+      // ... but add protection to not crash
+      int obj2Index = -1;
 
-    switch (cond2Categ) {
-        case CondMuon: {
-            corrMuon = static_cast<const MuonTemplate*>(m_gtCond2);
-            MuCondition muCondition(corrMuon, m_uGtB,
-                    0,0); //BLW these are counts that don't seem to be used...perhaps remove
+      if (!(*it2Comb).empty()) {
+        obj2Index = (*it2Comb)[0];
+      } else {
+        LogTrace("L1TGlobal")
+        << "\n  SingleCombInCond (*it2Comb).size() "
+        << ((*it2Comb).size()) << std::endl;
+        return false;
+      }
 
-            muCondition.evaluateConditionStoreResult(bxEval);
-            reqObjResult = muCondition.condLastResult();
+      // Collect the information on the overlap-removal leg
+      switch (cond2Categ) {
 
-            cond2Comb = (muCondition.getCombinationsInCond());
-            cond2bx = bxEval + (corrMuon->condRelativeBx());
-            cndObjTypeVec[2] = (corrMuon->objectType())[0];
+        case CondMuon: {
 
-            if (m_verbosity) {
-                std::ostringstream myCout;
-                muCondition.print(myCout);
+          lutObj2 = "MU";
+          candMuVec = m_uGtB->getCandL1Mu();
+          phiIndex2 =  (candMuVec->at(cond2bx,obj2Index))->hwPhi(); //(*candMuVec)[obj2Index]->phiIndex();
+          etaIndex2 =  (candMuVec->at(cond2bx,obj2Index))->hwEta();
+          int etaBin2 = etaIndex2;
+          if(etaBin2<0) etaBin2 = m_gtScales->getMUScales().etaBins.size() + etaBin2; //twos complement
+          //LogDebug("L1TGlobal") << "Muon phi" << phiIndex2 << " eta " << etaIndex2 << " etaBin2 = " << etaBin2  << " et " << etIndex2 << std::endl;
 
-               LogDebug("L1TGlobal") << myCout.str() << std::endl;
-            }
+          // Determine Floating Pt numbers for floating point caluclation
+          std::pair<double, double> binEdges = m_gtScales->getMUScales().phiBins.at(phiIndex2);
+          phi2Phy = 0.5*(binEdges.second + binEdges.first);
+          binEdges = m_gtScales->getMUScales().etaBins.at(etaBin2);
+          eta2Phy = 0.5*(binEdges.second + binEdges.first);
+
+          LogDebug("L1TGlobal") << "Found all quantities for the muon 0" << std::endl;
         }
-            break;
+          break;
+
+        // Calorimeter Objects (EG, Jet, Tau)
         case CondCalo: {
-            corrCalo = static_cast<const CaloTemplate*>(m_gtCond2);
-            CaloCondition caloCondition(corrCalo, m_uGtB,
-                    0, 0, 0, 0); //BLW these are counters that don't seem to be used...perhaps remove.
 
-            caloCondition.evaluateConditionStoreResult(bxEval);
-            reqObjResult = caloCondition.condLastResult();
+          switch(cndObjTypeVec[2]) {
 
-            cond2Comb = (caloCondition.getCombinationsInCond());
-            cond2bx = bxEval + (corrCalo->condRelativeBx());
-            cndObjTypeVec[2] = (corrCalo->objectType())[0];
+            case gtEG: {
+              lutObj2 = "EG";
+              candCaloVec = m_uGtB->getCandL1EG();
+              phiIndex2 =  (candCaloVec->at(cond2bx,obj2Index))->hwPhi();
+              etaIndex2 =  (candCaloVec->at(cond2bx,obj2Index))->hwEta();
+              if(etaBin2<0) etaBin2 = m_gtScales->getEGScales().etaBins.size() + etaBin2;
+              //LogDebug("L1TGlobal") << "EG0 phi" << phiIndex2 << " eta " << etaIndex2 << " etaBin2 = " << etaBin2 << " et " << etIndex2 << std::endl;
 
-            if (m_verbosity ) {
-                std::ostringstream myCout;
-                caloCondition.print(myCout);
+              // Determine Floating Pt numbers for floating point caluclation
+              std::pair<double, double> binEdges = m_gtScales->getEGScales().phiBins.at(phiIndex2);
+              phi2Phy = 0.5*(binEdges.second + binEdges.first);
+              binEdges = m_gtScales->getEGScales().etaBins.at(etaBin2);
+              eta2Phy = 0.5*(binEdges.second + binEdges.first);
 
-                LogDebug("L1TGlobal") << myCout.str() << std::endl;
             }
+              break;
+            case gtJet: {
+              lutObj2 = "JET";
+              candCaloVec = m_uGtB->getCandL1Jet();
+              phiIndex2 =  (candCaloVec->at(cond2bx,obj2Index))->hwPhi();
+              etaIndex2 =  (candCaloVec->at(cond2bx,obj2Index))->hwEta();
+              etaBin2 = etaIndex2;
+              if(etaBin2<0) etaBin2 = m_gtScales->getJETScales().etaBins.size() + etaBin2;
 
-        }
-            break;
-        case CondEnergySum: {
-            corrEnergySum = static_cast<const EnergySumTemplate*>(m_gtCond2);
+              // Determine Floating Pt numbers for floating point caluclation
+              std::pair<double, double> binEdges = m_gtScales->getJETScales().phiBins.at(phiIndex2);
+              phi2Phy = 0.5*(binEdges.second + binEdges.first);
+              binEdges = m_gtScales->getJETScales().etaBins.at(etaBin2);
+              eta2Phy = 0.5*(binEdges.second + binEdges.first);
 
-            EnergySumCondition eSumCondition(corrEnergySum, m_uGtB);
+            }
+              break;
+            case gtTau: {
 
-            eSumCondition.evaluateConditionStoreResult(bxEval);
-            reqObjResult = eSumCondition.condLastResult();
+              candCaloVec = m_uGtB->getCandL1Tau();
+              phiIndex2 =  (candCaloVec->at(cond2bx,obj2Index))->hwPhi();
+              etaIndex2 =  (candCaloVec->at(cond2bx,obj2Index))->hwEta();
+              if(etaBin2<0) etaBin2 = m_gtScales->getTAUScales().etaBins.size() + etaBin2;
+
+              // Determine Floating Pt numbers for floating point caluclation
+              std::pair<double, double> binEdges = m_gtScales->getTAUScales().phiBins.at(phiIndex2);
+              phi2Phy = 0.5*(binEdges.second + binEdges.first);
+              binEdges = m_gtScales->getTAUScales().etaBins.at(etaBin2);
+              eta2Phy = 0.5*(binEdges.second + binEdges.first);
+              lutObj2 = "TAU";
+            }
+                break;
+            default: {
+            }
+              break;
 
-            cond2Comb = (eSumCondition.getCombinationsInCond());
-            cond2bx = bxEval + (corrEnergySum->condRelativeBx());
-            cndObjTypeVec[2] = (corrEnergySum->objectType())[0];
+          } //end switch on calo type.
 
-            if (m_verbosity) {
-                std::ostringstream myCout;
-                eSumCondition.print(myCout);
+          //If needed convert calo scales to muon scales for comparison
+          if(convertCaloScales) {
 
-                LogDebug("L1TGlobal") << myCout.str() << std::endl;
-            }
-        }
+          	  std::string lutName = lutObj2;
+          	  lutName += "-MU";
+          	  long long tst = m_gtScales->getLUT_CalMuEta(lutName,etaBin2);
+          	  LogDebug("L1TGlobal") << lutName <<"  EtaCal = " << etaIndex2 << " etaBin2 = " << etaBin2 << " EtaMu = " << tst << std::endl;
+          	  etaIndex2 = tst;
+
+          	  tst = m_gtScales->getLUT_CalMuPhi(lutName,phiIndex2);
+          	  LogDebug("L1TGlobal") << lutName <<"  PhiCal = " << phiIndex2 << " PhiMu = " << tst << std::endl;
+          	  phiIndex2 = tst;
+
+          }
+
+        } // end case CondCalo
+          break;
+
+        // Energy Sums
+        case CondEnergySum: {
+
+          //Stupid mapping between enum types for energy sums.
+          l1t::EtSum::EtSumType type;
+          switch( cndObjTypeVec[2] ){
+          case gtETM:
+            type = l1t::EtSum::EtSumType::kMissingEt;
+            lutObj2 = "ETM";
             break;
-        default: {
-            // should not arrive here, there are no correlation conditions defined for this object
-            return false;
-        }
+          case gtETT:
+            type = l1t::EtSum::EtSumType::kTotalEt;
+            lutObj2 = "ETT";
             break;
-    }
+          case gtETTem:
+            type = l1t::EtSum::EtSumType::kTotalEtEm;
+            lutObj2 = "ETTem"; //should this be just ETT (share LUTs?) Can't be used for CorrCond anyway since now directional information
+            break;
+          case gtHTM:
+            type = l1t::EtSum::EtSumType::kMissingHt;
+            lutObj2 = "HTM";
+            break;
+          case gtHTT:
+            type = l1t::EtSum::EtSumType::kTotalHt;
+            lutObj2 = "HTT";
+            break;
+          case gtETMHF:
+            type = l1t::EtSum::EtSumType::kMissingEtHF;
+            lutObj2 = "ETMHF";
+            break;
+          case gtMinBiasHFP0:
+          case gtMinBiasHFM0:
+          case gtMinBiasHFP1:
+          case gtMinBiasHFM1:
+            type = l1t::EtSum::EtSumType::kMinBiasHFP0;
+            lutObj2 = "MinBias"; //??Fix?? Not a valid LUT type Can't be used for CorrCond anyway since now directional information
+            break;
+          default:
+            edm::LogError("L1TGlobal")
+            << "\n  Error: "
+            << "Unmatched object type from template to EtSumType, cndObjTypeVec[2] = "
+            << cndObjTypeVec[2]
+            << std::endl;
+            type = l1t::EtSum::EtSumType::kTotalEt;
+            break;
+          }
 
-    // if third sub-condition is false, effectively there will no overlap removal
-    if (!reqObjResult) {
-        LogDebug("L1TGlobal") << "\n"
-                << "    Third sub-condtion false for object requirements."
-                << "    Algorithm returning false.\n" << std::endl;
-	return false;
-    } else {
-        LogDebug("L1TGlobal") << "\n"
-                << "    All three sub-conditions true for object requirements."
-                << "    Evaluate correlation requirements and overlap removal.\n" << std::endl;
+          candEtSumVec = m_uGtB->getCandL1EtSum();
 
-    }
+          for( int iEtSum=0; iEtSum < (int)candEtSumVec->size(cond2bx); iEtSum++) {
+            if( (candEtSumVec->at(cond2bx,iEtSum))->getType() == type ) {
+              phiIndex2 =  (candEtSumVec->at(cond2bx,iEtSum))->hwPhi();
+              etaIndex2 =  (candEtSumVec->at(cond2bx,iEtSum))->hwEta();
 
-    // since we have two good legs and overlap-removal let, get the correlation parameters
-    CorrelationWithOverlapRemovalTemplate::CorrelationWithOverlapRemovalParameter corrPar = *(m_gtCorrelationWithOverlapRemovalTemplate->correlationParameter());
-
-    // vector to store the indices of the calorimeter objects
-    // from the combination evaluated in the condition
-    SingleCombInCond objectsInComb;
-    objectsInComb.reserve(nObjInCond);
-
-    // clear the m_combinationsInCond vector
-    (combinationsInCond()).clear();
-
-    // pointers to objects
-    const BXVector<const l1t::Muon*>*        candMuVec    = nullptr;
-    const BXVector<const l1t::L1Candidate*>* candCaloVec  = nullptr;
-    const BXVector<const l1t::EtSum*>*       candEtSumVec = nullptr;
-
-    bool etSumCond = false;
-
-    // make the conversions of the indices, depending on the combination of objects involved
-    // (via pair index)
-
-    int phiIndex0  = 0;
-    int phiIndex1  = 0;
-    int phiORIndex0  = 0; // hold phi index transformed in case of need with overlap-removal
-    int phiORIndex1  = 0; // hold phi index transformed in case of need with overlap-removal
-    double phi0Phy = 0.;
-    double phi1Phy = 0.;
-
-    int etaIndex0  = 0;
-    int etaIndex1  = 0;
-    int etaORIndex0  = 0;
-    int etaORIndex1  = 0;
-    double eta0Phy = 0.;
-    double eta1Phy = 0.;
-    int etaBin0    = 0;
-    int etaBin1    = 0;
-
-    int etIndex0  = 0;
-    int etIndex1  = 0;
-    int etBin0    = 0;
-    int etBin1    = 0;
-    double et0Phy = 0.;
-    double et1Phy = 0.;
-
-    int chrg0 = -1;
-    int chrg1 = -1;
-
-    // make the conversions of the indices, depending on the combination of objects involved in overlap-removal
-    int phiIndex2  = 0;
-    int etaIndex2  = 0;
-    double phi2Phy = 0.;
-    double eta2Phy = 0.;
-    int etaBin2    = 0;
-    //int etIndex2  = 0;
-    //int etBin2    = 0;
+              //  Get the floating point numbers
+              if(cndObjTypeVec[2] == gtETM ) {
+                std::pair<double, double> binEdges = m_gtScales->getETMScales().phiBins.at(phiIndex2);
+                phi2Phy = 0.5*(binEdges.second + binEdges.first);
+                eta2Phy = 0.; //No Eta for Energy Sums
 
-// Determine the number of phi bins to get cutoff at pi
-    int phiBound = 0;
-    if(cond0Categ == CondMuon || cond1Categ == CondMuon || cond2Categ == CondMuon) {
-      GlobalScales::ScaleParameters par = m_gtScales->getMUScales();
-      //phiBound = par.phiBins.size()/2;
-      phiBound = (int)((par.phiMax - par.phiMin)/par.phiStep)/2;
-    } else {
-      //Assumes all calorimeter objects are on same phi scale
-      GlobalScales::ScaleParameters par = m_gtScales->getEGScales();
-      //phiBound = par.phiBins.size()/2;
-      phiBound = (int)((par.phiMax - par.phiMin)/par.phiStep)/2;
-    }
-    LogDebug("L1TGlobal") << "Phi Bound = " << phiBound << std::endl;
+              } else if (cndObjTypeVec[2] == gtHTM) {
+                std::pair<double, double> binEdges = m_gtScales->getHTMScales().phiBins.at(phiIndex2);
+                phi2Phy = 0.5*(binEdges.second + binEdges.first);
+                eta2Phy = 0.; //No Eta for Energy Sums
 
+              } else if (cndObjTypeVec[2] == gtETMHF) {
+                std::pair<double, double> binEdges = m_gtScales->getETMHFScales().phiBins.at(phiIndex2);
+                phi2Phy = 0.5*(binEdges.second + binEdges.first);
+                eta2Phy = 0.; //No Eta for Energy Sums
 
-// Keep track of objects for LUTS
-    std::string lutObj0 = "NULL";
-    std::string lutObj1 = "NULL";
-    std::string lutObj2 = "NULL";
+              }
+
+              //If needed convert calo scales to muon scales for comparison (only phi for energy sums)
+              if(convertCaloScales) {
 
+                std::string lutName = lutObj2;
+                lutName += "-MU";
+                long long tst = m_gtScales->getLUT_CalMuPhi(lutName,phiIndex2);
+                LogDebug("L1TGlobal") << lutName <<"  PhiCal = " << phiIndex2 << " PhiMu = " << tst << std::endl;
+                phiIndex2 = tst;
 
-    LogTrace("L1TGlobal")
-      << "  Sub-condition 0: std::vector<SingleCombInCond> size: "
-      << (cond0Comb.size()) << std::endl;
-    LogTrace("L1TGlobal")
-      << "  Sub-condition 1: std::vector<SingleCombInCond> size: "
-      << (cond1Comb.size()) << std::endl;
-    LogTrace("L1TGlobal")
-      << "  Sub-condition 2: std::vector<SingleCombInCond> size: "
-      << (cond2Comb.size()) << std::endl;
+              }
+
+            } //check it is the EtSum we want
+          } // loop over Etsums
+
+        }
+          break;
+
+        default: {
+          // should not arrive here, there are no correlation conditions defined for this object
+          LogDebug("L1TGlobal") << "Error could not find the Cond Category for Leg 3" << std::endl;
+          return false;
+        }
+          break;
+      } //end switch on overlap-removal leg type
+
+      m_leg2Objects.push_back(obj2Index, phiIndex2, etaIndex2, 0, 0,
+                              phiIndex2, etaIndex2, phi2Phy, eta2Phy, 0.);
+    }
 
 
     // ///////////////////////////////////////////////////////////////////////////////////////////
@@ -848,218 +1368,17 @@ const bool l1t::CorrWithOverlapRemovalCondition::evaluateCondition(const int bxE
         // ///////////////////////////////////////////////////////////////////////////////////////////
         // loop over overlap-removal leg combination which produced individually "true" as Type1s
         // ///////////////////////////////////////////////////////////////////////////////////////////
-        for (std::vector<SingleCombInCond>::const_iterator it2Comb = cond2Comb.begin(); it2Comb != cond2Comb.end() && overlapRemovalMatchLeg1 != 0x1; it2Comb++) {
+        for (unsigned int i2 = 0; i2 < m_leg2Objects.size() && overlapRemovalMatchLeg1 != 0x1; ++i2) {
 
-          // Type1s: there is 1 object only, no need for a loop, index 0 should be OK in (*it2Comb)[0]
-          // ... but add protection to not crash
-          int obj2Index = -1;
+          phiIndex2 = m_leg2Objects.phiIndex[i2];
+          etaIndex2 = m_leg2Objects.etaIndex[i2];
+          phi2Phy   = m_leg2Objects.phiPhy[i2];
+          eta2Phy   = m_leg2Objects.etaPhy[i2];
 
-          if (!(*it2Comb).empty()) {
-            obj2Index = (*it2Comb)[0];
-          } else {
-            LogTrace("L1TGlobal")
-            << "\n  SingleCombInCond (*it2Comb).size() "
-            << ((*it2Comb).size()) << std::endl;
-            return false;
+          if (cond2Categ == CondEnergySum) {
+            etSumCond = true;
           }
 
-          // Collect the information on the overlap-removal leg
-          switch (cond2Categ) {
-
-            case CondMuon: {
-
-              lutObj2 = "MU";
-              candMuVec = m_uGtB->getCandL1Mu();
-              phiIndex2 =  (candMuVec->at(cond2bx,obj2Index))->hwPhi(); //(*candMuVec)[obj2Index]->phiIndex();
-              etaIndex2 =  (candMuVec->at(cond2bx,obj2Index))->hwEta();
-              int etaBin2 = etaIndex2;
-              if(etaBin2<0) etaBin2 = m_gtScales->getMUScales().etaBins.size() + etaBin2; //twos complement
-              //LogDebug("L1TGlobal") << "Muon phi" << phiIndex2 << " eta " << etaIndex2 << " etaBin2 = " << etaBin2  << " et " << etIndex2 << std::endl;
-
-              // Determine Floating Pt numbers for floating point caluclation
-              std::pair<double, double> binEdges = m_gtScales->getMUScales().phiBins.at(phiIndex2);
-              phi2Phy = 0.5*(binEdges.second + binEdges.first);
-              binEdges = m_gtScales->getMUScales().etaBins.at(etaBin2);
-              eta2Phy = 0.5*(binEdges.second + binEdges.first);
-
-              LogDebug("L1TGlobal") << "Found all quantities for the muon 0" << std::endl;
-            }
-              break;
-
-            // Calorimeter Objects (EG, Jet, Tau)
-            case CondCalo: {
-
-              switch(cndObjTypeVec[2]) {
-
-                case gtEG: {
-                  lutObj2 = "EG";
-                  candCaloVec = m_uGtB->getCandL1EG();
-                  phiIndex2 =  (candCaloVec->at(cond2bx,obj2Index))->hwPhi();
-                  etaIndex2 =  (candCaloVec->at(cond2bx,obj2Index))->hwEta();
-                  if(etaBin2<0) etaBin2 = m_gtScales->getEGScales().etaBins.size() + etaBin2;
-                  //LogDebug("L1TGlobal") << "EG0 phi" << phiIndex2 << " eta " << etaIndex2 << " etaBin2 = " << etaBin2 << " et " << etIndex2 << std::endl;
-
-                  // Determine Floating Pt numbers for floating point caluclation
-                  std::pair<double, double> binEdges = m_gtScales->getEGScales().phiBins.at(phiIndex2);
-                  phi2Phy = 0.5*(binEdges.second + binEdges.first);
-                  binEdges = m_gtScales->getEGScales().etaBins.at(etaBin2);
-                  eta2Phy = 0.5*(binEdges.second + binEdges.first);
-
-                }
-                  break;
-                case gtJet: {
-                  lutObj2 = "JET";
-                  candCaloVec = m_uGtB->getCandL1Jet();
-                  phiIndex2 =  (candCaloVec->at(cond2bx,obj2Index))->hwPhi();
-                  etaIndex2 =  (candCaloVec->at(cond2bx,obj2Index))->hwEta();
-                  etaBin2 = etaIndex2;
-                  if(etaBin2<0) etaBin2 = m_gtScales->getJETScales().etaBins.size() + etaBin2;
-
-                  // Determine Floating Pt numbers for floating point caluclation
-                  std::pair<double, double> binEdges = m_gtScales->getJETScales().phiBins.at(phiIndex2);
-                  phi2Phy = 0.5*(binEdges.second + binEdges.first);
-                  binEdges = m_gtScales->getJETScales().etaBins.at(etaBin2);
-                  eta2Phy = 0.5*(binEdges.second + binEdges.first);
-
-                }
-                  break;
-                case gtTau: {
-
-                  candCaloVec = m_uGtB->getCandL1Tau();
-                  phiIndex2 =  (candCaloVec->at(cond2bx,obj2Index))->hwPhi();
-                  etaIndex2 =  (candCaloVec->at(cond2bx,obj2Index))->hwEta();
-                  if(etaBin2<0) etaBin2 = m_gtScales->getTAUScales().etaBins.size() + etaBin2;
-
-                  // Determine Floating Pt numbers for floating point caluclation
-                  std::pair<double, double> binEdges = m_gtScales->getTAUScales().phiBins.at(phiIndex2);
-                  phi2Phy = 0.5*(binEdges.second + binEdges.first);
-                  binEdges = m_gtScales->getTAUScales().etaBins.at(etaBin2);
-                  eta2Phy = 0.5*(binEdges.second + binEdges.first);
-                  lutObj2 = "TAU";
-                }
-                    break;
-                default: {
-                }
-                  break;
-
-              } //end switch on calo type.
-
-              //If needed convert calo scales to muon scales for comparison
-              if(convertCaloScales) {
-
-              	  std::string lutName = lutObj2;
-              	  lutName += "-MU";
-              	  long long tst = m_gtScales->getLUT_CalMuEta(lutName,etaBin2);
-              	  LogDebug("L1TGlobal") << lutName <<"  EtaCal = " << etaIndex2 << " etaBin2 = " << etaBin2 << " EtaMu = " << tst << std::endl;
-              	  etaIndex2 = tst;
-
-              	  tst = m_gtScales->getLUT_CalMuPhi(lutName,phiIndex2);
-              	  LogDebug("L1TGlobal") << lutName <<"  PhiCal = " << phiIndex2 << " PhiMu = " << tst << std::endl;
-              	  phiIndex2 = tst;
-
-              }
-
-            } // end case CondCalo
-              break;
-
-            // Energy Sums
-            case CondEnergySum: {
-
-              etSumCond = true;
-              //Stupid mapping between enum types for energy sums.
-              l1t::EtSum::EtSumType type;
-              switch( cndObjTypeVec[2] ){
-              case gtETM:
-                type = l1t::EtSum::EtSumType::kMissingEt;
-                lutObj2 = "ETM";
-                break;
-              case gtETT:
-                type = l1t::EtSum::EtSumType::kTotalEt;
-                lutObj2 = "ETT";
-                break;
-              case gtETTem:
-                type = l1t::EtSum::EtSumType::kTotalEtEm;
-                lutObj2 = "ETTem"; //should this be just ETT (share LUTs?) Can't be used for CorrCond anyway since now directional information
-                break;
-              case gtHTM:
-                type = l1t::EtSum::EtSumType::kMissingHt;
-                lutObj2 = "HTM";
-                break;
-              case gtHTT:
-                type = l1t::EtSum::EtSumType::kTotalHt;
-                lutObj2 = "HTT";
-                break;
-              case gtETMHF:
-                type = l1t::EtSum::EtSumType::kMissingEtHF;
-                lutObj2 = "ETMHF";
-                break;
-              case gtMinBiasHFP0:
-              case gtMinBiasHFM0:
-              case gtMinBiasHFP1:
-              case gtMinBiasHFM1:
-                type = l1t::EtSum::EtSumType::kMinBiasHFP0;
-                lutObj2 = "MinBias"; //??Fix?? Not a valid LUT type Can't be used for CorrCond anyway since now directional information
-                break;
-              default:
-                edm::LogError("L1TGlobal")
-                << "\n  Error: "
-                << "Unmatched object type from template to EtSumType, cndObjTypeVec[2] = "
-                << cndObjTypeVec[2]
-                << std::endl;
-                type = l1t::EtSum::EtSumType::kTotalEt;
-                break;
-              }
-
-              candEtSumVec = m_uGtB->getCandL1EtSum();
-
-              for( int iEtSum=0; iEtSum < (int)candEtSumVec->size(cond2bx); iEtSum++) {
-                if( (candEtSumVec->at(cond2bx,iEtSum))->getType() == type ) {
-                  phiIndex2 =  (candEtSumVec->at(cond2bx,iEtSum))->hwPhi();
-                  etaIndex2 =  (candEtSumVec->at(cond2bx,iEtSum))->hwEta();
-
-                  //  Get the floating point numbers
-                  if(cndObjTypeVec[2] == gtETM ) {
-                    std::pair<double, double> binEdges = m_gtScales->getETMScales().phiBins.at(phiIndex2);
-                    phi2Phy = 0.5*(binEdges.second + binEdges.first);
-                    eta2Phy = 0.; //No Eta for Energy Sums
-
-                  } else if (cndObjTypeVec[2] == gtHTM) {
-                    std::pair<double, double> binEdges = m_gtScales->getHTMScales().phiBins.at(phiIndex2);
-                    phi2Phy = 0.5*(binEdges.second + binEdges.first);
-                    eta2Phy = 0.; //No Eta for Energy Sums
-
-                  } else if (cndObjTypeVec[2] == gtETMHF) {
-                    std::pair<double, double> binEdges = m_gtScales->getETMHFScales().phiBins.at(phiIndex2);
-                    phi2Phy = 0.5*(binEdges.second + binEdges.first);
-                    eta2Phy = 0.; //No Eta for Energy Sums
-
-                  }
-
-                  //If needed convert calo scales to muon scales for comparison (only phi for energy sums)
-                  if(convertCaloScales) {
-
-                    std::string lutName = lutObj2;
-                    lutName += "-MU";
-                    long long tst = m_gtScales->getLUT_CalMuPhi(lutName,phiIndex2);
-                    LogDebug("L1TGlobal") << lutName <<"  PhiCal = " << phiIndex2 << " PhiMu = " << tst << std::endl;
-                    phiIndex2 = tst;
-
-                  }
-
-                } //check it is the EtSum we want
-              } // loop over Etsums
-
-            }
-              break;
-
-            default: {
-              // should not arrive here, there are no correlation conditions defined for this object
-              LogDebug("L1TGlobal") << "Error could not find the Cond Category for Leg 3" << std::endl;
-              return false;
-            }
-              break;
-          } //end switch on overlap-removal leg type
-
           LogDebug("L1TGlobal") << "lutObj2 = " << lutObj2 << std::endl;
 
           // /////////////////////////////////////////////////////////////////////////////////////////
@@ -1206,21 +1525,9 @@ const bool l1t::CorrWithOverlapRemovalCondition::evaluateCondition(const int bxE
             // ///////////////////////////////////////////////////////////////////////////////////////////
             // Now loop over the second leg to get its information
             // ///////////////////////////////////////////////////////////////////////////////////////////
-            for (std::vector<SingleCombInCond>::const_iterator it1Comb = cond1Comb.begin(); it1Comb != cond1Comb.end(); it1Comb++) {
+            for (unsigned int i1 = 0; i1 < m_leg1Objects.size(); ++i1) {
 
-              LogDebug("L1TGlobal") << "Looking at second Condition" << std::endl;
-              // Type1s: there is 1 object only, no need for a loop (*it1Comb)[0]
-              // ... but add protection to not crash
-              int obj1Index = -1;
-
-              if (!(*it1Comb).empty()) {
-                obj1Index = (*it1Comb)[0];
-              } else {
-                LogTrace("L1TGlobal")
-                << "\n  SingleCombInCond (*it1Comb).size() "
-                << ((*it1Comb).size()) << std::endl;
-                return false;
-              }
+              int obj1Index = m_leg1Objects.index[i1];
 
               //If we are dealing with the same object type avoid the two legs
               // either being the same object
@@ -1232,492 +1539,35 @@ const bool l1t::CorrWithOverlapRemovalCondition::evaluateCondition(const int bxE
                 continue;
               }
 
-            switch (cond1Categ) {
-              case CondMuon: {
-                lutObj1 = "MU";
-                candMuVec = m_uGtB->getCandL1Mu();
-                phiIndex1 =  (candMuVec->at(cond1bx,obj1Index))->hwPhi(); //(*candMuVec)[obj0Index]->phiIndex();
-                etaIndex1 =  (candMuVec->at(cond1bx,obj1Index))->hwEta();
-                etIndex1  =  (candMuVec->at(cond1bx,obj1Index))->hwPt();
-                chrg1     =  (candMuVec->at(cond1bx,obj1Index))->hwCharge();
-                etaBin1 = etaIndex1;
-                if(etaBin1<0) etaBin1 = m_gtScales->getMUScales().etaBins.size() + etaBin1;
-                //		   LogDebug("L1TGlobal") << "Muon phi" << phiIndex1 << " eta " << etaIndex1 << " etaBin1 = " << etaBin1  << " et " << etIndex1 << std::endl;
-                etBin1 = etIndex1;
-                int ssize = m_gtScales->getMUScales().etBins.size();
-
-                if (etBin1 >= ssize){
-                  LogTrace("L1TGlobal")
-                  << "muon2 hw et" << etBin1 << " out of scale range.  Setting to maximum.";
-                  etBin1 = ssize-1;
-                }
-
-                // Determine Floating Pt numbers for floating point caluclation
-                std::pair<double, double> binEdges = m_gtScales->getMUScales().phiBins.at(phiIndex1);
-                phi1Phy = 0.5*(binEdges.second + binEdges.first);
-                binEdges = m_gtScales->getMUScales().etaBins.at(etaBin1);
-                eta1Phy = 0.5*(binEdges.second + binEdges.first);
-                binEdges = m_gtScales->getMUScales().etBins.at(etBin1);
-                et1Phy = 0.5*(binEdges.second + binEdges.first);
-
-              }
-                break;
-
-              case CondCalo: {
-
-                switch(cndObjTypeVec[1]) {
-
-                  case gtEG: {
-
-                    candCaloVec = m_uGtB->getCandL1EG();
-                    phiIndex1 =  (candCaloVec->at(cond1bx,obj1Index))->hwPhi();
-                    etaIndex1 =  (candCaloVec->at(cond1bx,obj1Index))->hwEta();
-                    etIndex1  =  (candCaloVec->at(cond1bx,obj1Index))->hwPt();
-                    etaBin1   =   etaIndex1;
-                    if(etaBin1<0) etaBin1 = m_gtScales->getEGScales().etaBins.size() + etaBin1;
-
-                    etBin1 = etIndex1;
-                    int ssize = m_gtScales->getEGScales().etBins.size();
-                    if (etBin1 >= ssize){
-                      LogTrace("L1TGlobal")
-                      << "EG1 hw et" << etBin1 << " out of scale range.  Setting to maximum.";
-                      etBin1 = ssize-1;
-                    }
-
-                    // Determine Floating Pt numbers for floating point caluclation
-                    std::pair<double, double> binEdges = m_gtScales->getEGScales().phiBins.at(phiIndex1);
-                    phi1Phy = 0.5*(binEdges.second + binEdges.first);
-                    binEdges = m_gtScales->getEGScales().etaBins.at(etaBin1);
-                    eta1Phy = 0.5*(binEdges.second + binEdges.first);
-                    binEdges = m_gtScales->getEGScales().etBins.at(etBin1);
-                    et1Phy = 0.5*(binEdges.second + binEdges.first);
-                    lutObj1 = "EG";
-                  }
-                    break;
-
-                  case gtJet: {
-                    candCaloVec = m_uGtB->getCandL1Jet();
-                    phiIndex1 =  (candCaloVec->at(cond1bx,obj1Index))->hwPhi();
-                    etaIndex1 =  (candCaloVec->at(cond1bx,obj1Index))->hwEta();
-                    etIndex1  =  (candCaloVec->at(cond1bx,obj1Index))->hwPt();
-                    etaBin1 = etaIndex1;
-                    if(etaBin1<0) etaBin1 = m_gtScales->getJETScales().etaBins.size() + etaBin1;
-                    etBin1 = etIndex1;
-                    int ssize = m_gtScales->getJETScales().etBins.size();
-                    assert(ssize);
-                    if (etBin1 >= ssize){
-                      //edm::LogWarning("L1TGlobal")
-                      //<< "jet2 hw et" << etBin1 << " out of scale range.  Setting to maximum.";
-                      etBin1 = ssize-1;
-                    }
-
-                    // Determine Floating Pt numbers for floating point caluclation
-                    std::pair<double, double> binEdges = m_gtScales->getJETScales().phiBins.at(phiIndex1);
-                    phi1Phy = 0.5*(binEdges.second + binEdges.first);
-                    binEdges = m_gtScales->getJETScales().etaBins.at(etaBin1);
-                    eta1Phy = 0.5*(binEdges.second + binEdges.first);
-
-                    binEdges = m_gtScales->getJETScales().etBins.at(etBin1);
-                    et1Phy = 0.5*(binEdges.second + binEdges.first);
-                    lutObj1 = "JET";
-                  }
-                    break;
-
-                  case gtTau: {
-                    candCaloVec = m_uGtB->getCandL1Tau();
-                    phiIndex1 =  (candCaloVec->at(cond1bx,obj1Index))->hwPhi();
-                    etaIndex1 =  (candCaloVec->at(cond1bx,obj1Index))->hwEta();
-                    etIndex1  =  (candCaloVec->at(cond1bx,obj1Index))->hwPt();
-                    etaBin1 = etaIndex1;
-                    if(etaBin1<0) etaBin1 = m_gtScales->getTAUScales().etaBins.size() + etaBin1;
-                    etBin1 = etIndex1;
-                    int ssize = m_gtScales->getTAUScales().etBins.size();
-                    if (etBin1 >= ssize){
-                      LogTrace("L1TGlobal")
-                      << "tau2 hw et" << etBin1 << " out of scale range.  Setting to maximum.";
-                      etBin1 = ssize-1;
-                    }
-
-                    // Determine Floating Pt numbers for floating point caluclation
-                    std::pair<double, double> binEdges = m_gtScales->getTAUScales().phiBins.at(phiIndex1);
-                    phi1Phy = 0.5*(binEdges.second + binEdges.first);
-                    binEdges = m_gtScales->getTAUScales().etaBins.at(etaBin1);
-                    eta1Phy = 0.5*(binEdges.second + binEdges.first);
-                    binEdges = m_gtScales->getTAUScales().etBins.at(etBin1);
-                    et1Phy = 0.5*(binEdges.second + binEdges.first);
-                    lutObj1 = "TAU";
-                  }
-                    break;
-                  default: {
-                  }
-                    break;
-
-                } //end switch on calo type.
-
-
-                phiORIndex1 = phiIndex1;
-                etaORIndex1 = etaIndex1;
-
-                //If needed convert calo scales to muon scales for comparison
-                if(convertCaloScales) {
-
-                  std::string lutName = lutObj1;
-                  lutName += "-MU";
-                  long long tst = m_gtScales->getLUT_CalMuEta(lutName,etaBin1);
-                  LogDebug("L1TGlobal") << lutName <<"  EtaCal = " << etaIndex1 << " EtaMu = " << tst << std::endl;
-                  etaIndex1 = tst;
-                  tst = m_gtScales->getLUT_CalMuPhi(lutName,phiIndex1);
-                  LogDebug("L1TGlobal") << lutName <<"  PhiCal = " << phiIndex1 << " PhiMu = " << tst << std::endl;
-                  phiIndex1 = tst;
-
-                }
-
-                //If needed convert calo scales to muon scales for comparison
-                if(convertCaloScalesForOverlapRemovalFromLeg1) {
-                  phiORIndex1 = phiIndex1;
-                  etaORIndex1 = etaIndex1;
-
-                }
-
-
-              }  // end case CondCalo
-                break;
-              case CondEnergySum: {
-
-                LogDebug("L1TGlobal") << "Looking at second Condition as Energy Sum: " << cndObjTypeVec[1] << std::endl;
-                etSumCond = true;
-
-                //Stupid mapping between enum types for energy sums.
-                l1t::EtSum::EtSumType type;
-
-                switch( cndObjTypeVec[1] ){
-                case gtETM:
-                  type = l1t::EtSum::EtSumType::kMissingEt;
-                  lutObj1 = "ETM";
-                  break;
-                case gtETT:
-                  type = l1t::EtSum::EtSumType::kTotalEt;
-                  lutObj1 = "ETT";
-                  break;
-                case gtETTem:
-                  type = l1t::EtSum::EtSumType::kTotalEtEm;
-                  lutObj1 = "ETTem";
-                  break;
-                case gtHTM:
-                  type = l1t::EtSum::EtSumType::kMissingHt;
-                  lutObj1 = "HTM";
-                  break;
-                case gtHTT:
-                  type = l1t::EtSum::EtSumType::kTotalHt;
-                  lutObj1 = "HTT";
-                  break;
-                case gtETMHF:
-                  type = l1t::EtSum::EtSumType::kMissingEtHF;
-                  lutObj1 = "ETMHF";
-                  break;
-                case gtMinBiasHFP0:
-                case gtMinBiasHFM0:
-                case gtMinBiasHFP1:
-                case gtMinBiasHFM1:
-                  type = l1t::EtSum::EtSumType::kMinBiasHFP0;
-                  lutObj1 = "MinBias";
-                  break;
-                default:
-                  edm::LogError("L1TGlobal")
-                    << "\n  Error: "
-                    << "Unmatched object type from template to EtSumType, cndObjTypeVec[1] = "
-                    << cndObjTypeVec[1]
-                    << std::endl;
-                  type = l1t::EtSum::EtSumType::kTotalEt;
-                  break;
-                }
-
-                candEtSumVec = m_uGtB->getCandL1EtSum();
-
-                LogDebug("L1TGlobal") << "obj " << lutObj1 << " Vector Size " << candEtSumVec->size(cond1bx) << std::endl;
-                for( int iEtSum=0; iEtSum < (int)candEtSumVec->size(cond1bx); iEtSum++) {
-                  if( (candEtSumVec->at(cond1bx,iEtSum))->getType() == type ) {
-                    phiIndex1 =  (candEtSumVec->at(cond1bx,iEtSum))->hwPhi();
-                    etaIndex1 =  (candEtSumVec->at(cond1bx,iEtSum))->hwEta();
-                    etIndex1  =  (candEtSumVec->at(cond1bx,iEtSum))->hwPt();
-
-                    // Determine Floating Pt numbers for floating point caluclation
-
-                    if(cndObjTypeVec[1] == gtETM) {
-                      std::pair<double, double> binEdges = m_gtScales->getETMScales().phiBins.at(phiIndex1);
-                      phi1Phy = 0.5*(binEdges.second + binEdges.first);
-                      eta1Phy = 0.; //No Eta for Energy Sums
-
-                      etBin1 = etIndex1;
-                      int ssize = m_gtScales->getETMScales().etBins.size();
-                      assert(ssize > 0);
-                      if (etBin1 >= ssize){ etBin1 = ssize-1; }
-
-                      binEdges = m_gtScales->getETMScales().etBins.at(etBin1);
-                      et1Phy = 0.5*(binEdges.second + binEdges.first);
-                    } else if(cndObjTypeVec[1] == gtHTM) {
-                      std::pair<double, double> binEdges = m_gtScales->getHTMScales().phiBins.at(phiIndex1);
-                      phi1Phy = 0.5*(binEdges.second + binEdges.first);
-                      eta1Phy = 0.; //No Eta for Energy Sums
-
-                      etBin1 = etIndex1;
-                      int ssize = m_gtScales->getHTMScales().etBins.size();
-                      assert(ssize > 0);
-                    if (etBin1 >= ssize){ etBin1 = ssize-1; }
-
-                      binEdges = m_gtScales->getHTMScales().etBins.at(etBin1);
-                      et1Phy = 0.5*(binEdges.second + binEdges.first);
-                    } else if(cndObjTypeVec[1] == gtETMHF) {
-                      std::pair<double, double> binEdges = m_gtScales->getETMHFScales().phiBins.at(phiIndex1);
-                      phi1Phy = 0.5*(binEdges.second + binEdges.first);
-                      eta1Phy = 0.; //No Eta for Energy Sums
-                      etBin1 = etIndex1;
-                      int ssize = m_gtScales->getETMHFScales().etBins.size();
-                      assert(ssize > 0);
-                      if (etBin1 >= ssize){ etBin1 = ssize-1; }
-                      binEdges = m_gtScales->getETMHFScales().etBins.at(etBin1);
-                      et1Phy = 0.5*(binEdges.second + binEdges.first);
-                    }
-
-                    phiORIndex1 = phiIndex1;
-                    etaORIndex1 = etaIndex1;
-
-                    //If needed convert calo scales to muon scales for comparison (only phi for energy sums)
-                    if(convertCaloScales) {
-
-                      std::string lutName = lutObj1;
-                      lutName += "-MU";
-                      long long tst = m_gtScales->getLUT_CalMuPhi(lutName,phiIndex1);
-                      LogDebug("L1TGlobal") << lutName <<"  PhiCal = " << phiIndex1 << " PhiMu = " << tst << std::endl;
-                      phiIndex1 = tst;
-
-                    }
-
-                    //If needed convert calo scales to muon scales for comparison (only phi for energy sums)
-                    if(convertCaloScalesForOverlapRemovalFromLeg1) {
-                      phiORIndex1 = phiIndex1;
-                    }
-
-                  } //check it is the EtSum we want
-                } // loop over Etsums
-
-              } // end case EnergySum
-                break;
-              default: {
-                // should not arrive here, there are no correlation conditions defined for this object
-                LogDebug("L1TGlobal") << "Error could not find the Cond Category for Leg 0" << std::endl;
-                return false;
-              }
-                break;
-            } //end switch on second leg
+            phiIndex1   = m_leg1Objects.phiIndex[i1];
+            etaIndex1   = m_leg1Objects.etaIndex[i1];
+            etIndex1    = m_leg1Objects.etIndex[i1];
+            chrg1       = m_leg1Objects.chrg[i1];
+            phiORIndex1 = m_leg1Objects.phiORIndex[i1];
+            etaORIndex1 = m_leg1Objects.etaORIndex[i1];
+            phi1Phy     = m_leg1Objects.phiPhy[i1];
+            eta1Phy     = m_leg1Objects.etaPhy[i1];
+            et1Phy      = m_leg1Objects.etPhy[i1];
+
+            if (cond1Categ == CondEnergySum) {
+              etSumCond = true;
+            }
 
             unsigned int overlapRemovalMatchLeg2 = 0x0;
 
             // ///////////////////////////////////////////////////////////////////////////////////////////
             // loop over overlap-removal leg combination which produced individually "true" as Type1s
             // ///////////////////////////////////////////////////////////////////////////////////////////
-            for (std::vector<SingleCombInCond>::const_iterator it2Comb = cond2Comb.begin(); it2Comb != cond2Comb.end() && overlapRemovalMatchLeg2 != 0x1; it2Comb++) {
-
-              // Type1s: there is 1 object only, no need for a loop, index 0 should be OK in (*it2Comb)[0]
-              // ... but add protection to not crash
-              int obj2Index = -1;
+            for (unsigned int i2 = 0; i2 < m_leg2Objects.size() && overlapRemovalMatchLeg2 != 0x1; ++i2) {
 
-              if (!(*it2Comb).empty()) {
-                  obj2Index = (*it2Comb)[0];
-              } else {
-                LogTrace("L1TGlobal")
-                << "\n  SingleCombInCond (*it2Comb).size() "
-                << ((*it2Comb).size()) << std::endl;
-                return false;
-              }
-
-              // Collect the information on the overlap-removal leg
-              switch (cond2Categ) {
-                case CondMuon: {
-                  lutObj2 = "MU";
-                  candMuVec = m_uGtB->getCandL1Mu();
-                  phiIndex2 =  (candMuVec->at(cond2bx,obj2Index))->hwPhi(); //(*candMuVec)[obj2Index]->phiIndex();
-                  etaIndex2 =  (candMuVec->at(cond2bx,obj2Index))->hwEta();
-                	int etaBin2 = etaIndex2;
-                	if(etaBin2<0) etaBin2 = m_gtScales->getMUScales().etaBins.size() + etaBin2; //twos complement
-                  //LogDebug("L1TGlobal") << "Muon phi" << phiIndex2 << " eta " << etaIndex2 << " etaBin2 = " << etaBin2  << " et " << etIndex2 << std::endl;
-
-                	// Determine Floating Pt numbers for floating point caluclation
-                	std::pair<double, double> binEdges = m_gtScales->getMUScales().phiBins.at(phiIndex2);
-                	phi2Phy = 0.5*(binEdges.second + binEdges.first);
-                	binEdges = m_gtScales->getMUScales().etaBins.at(etaBin2);
-                	eta2Phy = 0.5*(binEdges.second + binEdges.first);
-
-                	LogDebug("L1TGlobal") << "Found all quantities for the muon 0" << std::endl;
-                }
-                  break;
-
-                // Calorimeter Objects (EG, Jet, Tau)
-                case CondCalo: {
-
-                  switch(cndObjTypeVec[2]) {
-
-                    case gtEG: {
-                      lutObj2 = "EG";
-                      candCaloVec = m_uGtB->getCandL1EG();
-                      phiIndex2 =  (candCaloVec->at(cond2bx,obj2Index))->hwPhi();
-                      etaIndex2 =  (candCaloVec->at(cond2bx,obj2Index))->hwEta();
-                      if(etaBin2<0) etaBin2 = m_gtScales->getEGScales().etaBins.size() + etaBin2;
-                      //LogDebug("L1TGlobal") << "EG0 phi" << phiIndex2 << " eta " << etaIndex2 << " etaBin2 = " << etaBin2 << " et " << etIndex2 << std::endl;
-
-                      // Determine Floating Pt numbers for floating point caluclation
-                      std::pair<double, double> binEdges = m_gtScales->getEGScales().phiBins.at(phiIndex2);
-                      phi2Phy = 0.5*(binEdges.second + binEdges.first);
-                      binEdges = m_gtScales->getEGScales().etaBins.at(etaBin2);
-                      eta2Phy = 0.5*(binEdges.second + binEdges.first);
-                    }
-                      break;
-
-                    case gtJet: {
-                      lutObj2 = "JET";
-                      candCaloVec = m_uGtB->getCandL1Jet();
-                      phiIndex2 =  (candCaloVec->at(cond2bx,obj2Index))->hwPhi();
-                      etaIndex2 =  (candCaloVec->at(cond2bx,obj2Index))->hwEta();
-                      etaBin2 = etaIndex2;
-                      if(etaBin2<0) etaBin2 = m_gtScales->getJETScales().etaBins.size() + etaBin2;
-                      // Determine Floating Pt numbers for floating point caluclation
-                      std::pair<double, double> binEdges = m_gtScales->getJETScales().phiBins.at(phiIndex2);
-                      phi2Phy = 0.5*(binEdges.second + binEdges.first);
-                      binEdges = m_gtScales->getJETScales().etaBins.at(etaBin2);
-                      eta2Phy = 0.5*(binEdges.second + binEdges.first);
-                    }
-                      break;
-                    case gtTau: {
-                      candCaloVec = m_uGtB->getCandL1Tau();
-                      phiIndex2 =  (candCaloVec->at(cond2bx,obj2Index))->hwPhi();
-                      etaIndex2 =  (candCaloVec->at(cond2bx,obj2Index))->hwEta();
-                      if(etaBin2<0) etaBin2 = m_gtScales->getTAUScales().etaBins.size() + etaBin2;
-
-                      // Determine Floating Pt numbers for floating point caluclation
-                      std::pair<double, double> binEdges = m_gtScales->getTAUScales().phiBins.at(phiIndex2);
-                      phi2Phy = 0.5*(binEdges.second + binEdges.first);
-                      binEdges = m_gtScales->getTAUScales().etaBins.at(etaBin2);
-                      eta2Phy = 0.5*(binEdges.second + binEdges.first);
-                      lutObj2 = "TAU";
-                    }
-                     break;
-                    default: {
-                    }
-                      break;
-
-                  } //end switch on calo type.
-
-                  //If needed convert calo scales to muon scales for comparison
-                  if(convertCaloScales) {
-                    std::string lutName = lutObj2;
-                    lutName += "-MU";
-                    long long tst = m_gtScales->getLUT_CalMuEta(lutName,etaBin2);
-                    LogDebug("L1TGlobal") << lutName <<"  EtaCal = " << etaIndex2 << " etaBin2 = " << etaBin2 << " EtaMu = " << tst << std::endl;
-                    etaIndex2 = tst;
-
-                    tst = m_gtScales->getLUT_CalMuPhi(lutName,phiIndex2);
-                    LogDebug("L1TGlobal") << lutName <<"  PhiCal = " << phiIndex2 << " PhiMu = " << tst << std::endl;
-                    phiIndex2 = tst;
-
-                }
+              phiIndex2 = m_leg2Objects.phiIndex[i2];
+              etaIndex2 = m_leg2Objects.etaIndex[i2];
+              phi2Phy   = m_leg2Objects.phiPhy[i2];
+              eta2Phy   = m_leg2Objects.etaPhy[i2];
 
+              if (cond2Categ == CondEnergySum) {
+                etSumCond = true;
               }
-                break;
-
-              // Energy Sums
-              case CondEnergySum: {
-
-                  etSumCond = true;
-                	//Stupid mapping between enum types for energy sums.
-                	l1t::EtSum::EtSumType type;
-                	switch( cndObjTypeVec[2] ){
-                	case gtETM:
-                	  type = l1t::EtSum::EtSumType::kMissingEt;
-                	  lutObj2 = "ETM";
-                	  break;
-                	case gtETT:
-                	  type = l1t::EtSum::EtSumType::kTotalEt;
-                	  lutObj2 = "ETT";
-                	  break;
-                	case gtETTem:
-                	  type = l1t::EtSum::EtSumType::kTotalEtEm;
-                	  lutObj2 = "ETTem"; //should this be just ETT (share LUTs?) Can't be used for CorrCond anyway since now directional information
-                	  break;
-                	case gtHTM:
-                	  type = l1t::EtSum::EtSumType::kMissingHt;
-                	  lutObj2 = "HTM";
-                	  break;
-                	case gtHTT:
-                	  type = l1t::EtSum::EtSumType::kTotalHt;
-                	  lutObj2 = "HTT";
-                	  break;
-                	case gtETMHF:
-                	  type = l1t::EtSum::EtSumType::kMissingEtHF;
-                	  lutObj2 = "ETMHF";
-                	  break;
-                	case gtMinBiasHFP0:
-                	case gtMinBiasHFM0:
-                	case gtMinBiasHFP1:
-                	case gtMinBiasHFM1:
-                	  type = l1t::EtSum::EtSumType::kMinBiasHFP0;
-                	  lutObj2 = "MinBias"; //??Fix?? Not a valid LUT type Can't be used for CorrCond anyway since now directional information
-                	  break;
-                	default:
-                	  edm::LogError("L1TGlobal")
-                	    << "\n  Error: "
-                	    << "Unmatched object type from template to EtSumType, cndObjTypeVec[2] = "
-                	    << cndObjTypeVec[2]
-                	    << std::endl;
-                	  type = l1t::EtSum::EtSumType::kTotalEt;
-                	  break;
-                	}
-
-                  candEtSumVec = m_uGtB->getCandL1EtSum();
-
-                  for( int iEtSum=0; iEtSum < (int)candEtSumVec->size(cond2bx); iEtSum++) {
-                    if( (candEtSumVec->at(cond2bx,iEtSum))->getType() == type ) {
-                      phiIndex2 =  (candEtSumVec->at(cond2bx,iEtSum))->hwPhi();
-                      etaIndex2 =  (candEtSumVec->at(cond2bx,iEtSum))->hwEta();
-
-                      //  Get the floating point numbers
-                      if(cndObjTypeVec[2] == gtETM ) {
-                        std::pair<double, double> binEdges = m_gtScales->getETMScales().phiBins.at(phiIndex2);
-                        phi2Phy = 0.5*(binEdges.second + binEdges.first);
-                        eta2Phy = 0.; //No Eta for Energy Sums
-
-                      } else if (cndObjTypeVec[2] == gtHTM) {
-                        std::pair<double, double> binEdges = m_gtScales->getHTMScales().phiBins.at(phiIndex2);
-                        phi2Phy = 0.5*(binEdges.second + binEdges.first);
-                        eta2Phy = 0.; //No Eta for Energy Sums
-
-                      } else if (cndObjTypeVec[2] == gtETMHF) {
-                        std::pair<double, double> binEdges = m_gtScales->getETMHFScales().phiBins.at(phiIndex2);
-                        phi2Phy = 0.5*(binEdges.second + binEdges.first);
-                        eta2Phy = 0.; //No Eta for Energy Sums
-
-                      }
-
-                      //If needed convert calo scales to muon scales for comparison (only phi for energy sums)
-                      if(convertCaloScales) {
-                        std::string lutName = lutObj2;
-                        lutName += "-MU";
-                        long long tst = m_gtScales->getLUT_CalMuPhi(lutName,phiIndex2);
-                        LogDebug("L1TGlobal") << lutName <<"  PhiCal = " << phiIndex2 << " PhiMu = " << tst << std::endl;
-                        phiIndex2 = tst;
-                      }
-
-                    } //check it is the EtSum we want
-                  } // loop over Etsums
-
-                } // end case CondEnerySum
-                  break;
-                default: {
-                  // should not arrive here, there are no correlation conditions defined for this object
-                	LogDebug("L1TGlobal") << "Error could not find the Cond Category for Leg 3" << std::endl;
-                  return false;
-                }
-                    break;
-              } //end switch on overlap-removal leg type
 
               // /////////////////////////////////////////////////////////////////////////////////////////
               //
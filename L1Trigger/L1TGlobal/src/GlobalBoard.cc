@@ -21,6 +21,7 @@
 
 // system include files
 #include <ext/hash_map>
+#include <memory>
 
 // user include files
 #include "DataFormats/L1TGlobal/interface/GlobalObjectMap.h"
@@ -39,7 +40,7 @@
 
 
 #include "L1Trigger/L1TGlobal/interface/ConditionEvaluation.h"
-#include "L1Trigger/L1TGlobal/interface/AlgorithmEvaluation.h"
+#include "L1Trigger/L1TGlobal/interface/CompiledMenu.h"
 
 // Conditions for uGt
 #include "L1Trigger/L1TGlobal/interface/MuCondition.h"
@@ -458,13 +459,8 @@ void l1t::GlobalBoard::receiveExternalData(edm::Event& iEvent,
 }
 
 
-// run GTL
-void l1t::GlobalBoard::runGTL(
-        edm::Event& iEvent, const edm::EventSetup& evSetup, const TriggerMenu* m_l1GtMenu,
-        const bool produceL1GtObjectMapRecord,
-        const int iBxInEvent,
-        std::unique_ptr<GlobalObjectMapRecord>& gtObjectMapRecord,  
-        const unsigned int numberPhysTriggers,
+// compile the trigger menu
+void l1t::GlobalBoard::compileMenu(const TriggerMenu* m_l1GtMenu,
         const int nrL1Mu,
         const int nrL1EG,
 	const int nrL1Tau,
@@ -473,43 +469,26 @@ void l1t::GlobalBoard::runGTL(
     const std::vector<ConditionMap>& conditionMap = m_l1GtMenu->gtConditionMap();
     const AlgorithmMap& algorithmMap = m_l1GtMenu->gtAlgorithmMap();
     const GlobalScales& gtScales = m_l1GtMenu->gtScales();
-    const std::string scaleSetName = gtScales.getScalesName();
-    LogDebug("L1TGlobal") << " L1 Menu Scales -- Set Name: " << scaleSetName << std::endl;
 
-    // Reset AlgBlk for this bx
-     m_uGtAlgBlk.reset();
-     m_algInitialOr=false;
-     m_algPrescaledOr=false;
-     m_algIntermOr=false;
-     m_algFinalOr=false;
-     m_algFinalOrVeto=false;
-     
-    
     const std::vector<std::vector<MuonTemplate> >& corrMuon =
             m_l1GtMenu->corMuonTemplate();
 
-      // Comment out for now
     const std::vector<std::vector<CaloTemplate> >& corrCalo =
             m_l1GtMenu->corCaloTemplate();
 
     const std::vector<std::vector<EnergySumTemplate> >& corrEnergySum =
             m_l1GtMenu->corEnergySumTemplate();
 
-    LogDebug("L1TGlobal") << "Size corrMuon " << corrMuon.size() 
-                           << "\nSize corrCalo " << corrCalo.size() 
+    LogDebug("L1TGlobal") << "Size corrMuon " << corrMuon.size()
+                           << "\nSize corrCalo " << corrCalo.size()
 			   << "\nSize corrSums " << corrEnergySum.size() << std::endl;
-    
+
+    m_compiledMenu.reset(m_l1GtMenu);
 
     // loop over condition maps (one map per condition chip)
     // then loop over conditions in the map
-    // save the results in temporary maps
+    // the objects evaluating the conditions are kept in the compiled menu
 
-    // never happens in production but at first event...
-    if (m_conditionResultMaps.size() != conditionMap.size()) {
-        m_conditionResultMaps.clear();
-        m_conditionResultMaps.resize(conditionMap.size());
-    }
-    
     int iChip = -1;
 
     for (std::vector<ConditionMap>::const_iterator
@@ -517,37 +496,33 @@ void l1t::GlobalBoard::runGTL(
 
         iChip++;
 
-	AlgorithmEvaluation::ConditionEvaluationMap& cMapResults =
-               m_conditionResultMaps[iChip];
-
-
+        // sub-conditions of the correlation conditions
+        auto subCondition = [&](const GtConditionCategory condCateg, const int condInd) -> const GlobalCondition* {
+            switch (condCateg) {
+                case CondMuon:
+                    return &((corrMuon[iChip])[condInd]);
+                case CondCalo:
+                    return &((corrCalo[iChip])[condInd]);
+                case CondEnergySum:
+                    return &((corrEnergySum[iChip])[condInd]);
+                default:
+                    // do nothing, should not arrive here
+                    return nullptr;
+            }
+        };
 
         for (CItCond itCond = itCondOnChip->begin(); itCond != itCondOnChip->end(); itCond++) {
 
-            // evaluate condition
+            std::unique_ptr<ConditionEvaluation> condition;
+
             switch ((itCond->second)->condCategory()) {
                 case CondMuon: {
 
                     // BLW Not sure what to do with this for now
 		    const int ifMuEtaNumberBits = 0;
-		    
-                    MuCondition* muCondition = new MuCondition(itCond->second, this,
-                            nrL1Mu, ifMuEtaNumberBits);
-
-                    muCondition->setVerbosity(m_verbosity);
 
-                    muCondition->evaluateConditionStoreResult(iBxInEvent);
-
-                   // BLW COmment out for now 
-		    cMapResults[itCond->first] = muCondition;
-
-                    if (m_verbosity && m_isDebugEnabled) {
-                        std::ostringstream myCout;
-                        muCondition->print(myCout);
-
-                        LogTrace("L1TGlobal") << myCout.str() << std::endl;
-                    }		    
-                    //delete muCondition;
+                    condition = std::make_unique<MuCondition>(itCond->second, this,
+                            nrL1Mu, ifMuEtaNumberBits);
 
                 }
                     break;
@@ -556,149 +531,42 @@ void l1t::GlobalBoard::runGTL(
                     // BLW Not sure w hat to do with this for now
 		    const int ifCaloEtaNumberBits = 0;
 
-                    CaloCondition* caloCondition = new CaloCondition(
+                    condition = std::make_unique<CaloCondition>(
                             itCond->second, this,
                             nrL1EG,
                             nrL1Jet,
                             nrL1Tau,
                             ifCaloEtaNumberBits);
 
-                    caloCondition->setVerbosity(m_verbosity);
-
-                    caloCondition->evaluateConditionStoreResult(iBxInEvent);
-                    
-		   
-                    cMapResults[itCond->first] = caloCondition;
-
-                    if (m_verbosity && m_isDebugEnabled) {
-                        std::ostringstream myCout;
-                        caloCondition->print(myCout);
-
-                        LogTrace("L1TGlobal") << myCout.str() << std::endl;
-                    }
-                    //                    delete caloCondition;
-		    
                 }
                     break;
                 case CondEnergySum: {
 
-                    EnergySumCondition* eSumCondition = new EnergySumCondition(
-                            itCond->second, this);
-
-                    eSumCondition->setVerbosity(m_verbosity);
-                    eSumCondition->evaluateConditionStoreResult(iBxInEvent);
-
-                    cMapResults[itCond->first] = eSumCondition;
-
-                    if (m_verbosity && m_isDebugEnabled) {
-                        std::ostringstream myCout;
-                        eSumCondition->print(myCout);
-
-                        LogTrace("L1TGlobal") << myCout.str() << std::endl;
-                    }
-                    //                    delete eSumCondition;
+                    condition = std::make_unique<EnergySumCondition>(itCond->second, this);
 
                 }
                     break;
 
                 case CondExternal: {
 
-                    ExternalCondition* extCondition = new ExternalCondition(
-                            itCond->second, this);
-
-                    extCondition->setVerbosity(m_verbosity);
-                    extCondition->evaluateConditionStoreResult(iBxInEvent);
-
-                    cMapResults[itCond->first] = extCondition;
-
-                    if (m_verbosity && m_isDebugEnabled) {
-                        std::ostringstream myCout;
-                        extCondition->print(myCout);
-
-                        LogTrace("L1TGlobal") << myCout.str() << std::endl;
-                    }
-                    //                    delete extCondition;
-
+                    condition = std::make_unique<ExternalCondition>(itCond->second, this);
 
                 }
                     break;
                 case CondCorrelation: {
 
-
                     // get first the sub-conditions
                     const CorrelationTemplate* corrTemplate =
 	            static_cast<const CorrelationTemplate*>(itCond->second);
-		    const GtConditionCategory cond0Categ = corrTemplate->cond0Category();
-		    const GtConditionCategory cond1Categ = corrTemplate->cond1Category();
-		    const int cond0Ind = corrTemplate->cond0Index();
-		    const int cond1Ind = corrTemplate->cond1Index();
-
-		    const GlobalCondition* cond0Condition = nullptr;
-		    const GlobalCondition* cond1Condition = nullptr;
-
-		    // maximum number of objects received for evaluation of l1t::Type1s condition
-		    int cond0NrL1Objects = 0;
-		    int cond1NrL1Objects = 0;
-		     LogDebug("L1TGlobal") << " cond0NrL1Objects" << cond0NrL1Objects << "  cond1NrL1Objects  " << cond1NrL1Objects << std::endl;
-
-
-		    switch (cond0Categ) {
-			case CondMuon: {
-			    cond0Condition = &((corrMuon[iChip])[cond0Ind]);
-			}
-			    break;
-			case CondCalo: {
-                            cond0Condition = &((corrCalo[iChip])[cond0Ind]);
-			}
-			    break;
-			case CondEnergySum: {
-			    cond0Condition = &((corrEnergySum[iChip])[cond0Ind]);
-			}
-			    break;
-			default: {
-			    // do nothing, should not arrive here
-			}
-			    break;
-		    }
-
-		    switch (cond1Categ) {
-			case CondMuon: {
-			    cond1Condition = &((corrMuon[iChip])[cond1Ind]);
-			}
-			    break;
-			case CondCalo: {
-                            cond1Condition = &((corrCalo[iChip])[cond1Ind]);
-			}
-			    break;
-			case CondEnergySum: {
-			    cond1Condition = &((corrEnergySum[iChip])[cond1Ind]);
-			}
-			    break;
-			default: {
-			    // do nothing, should not arrive here
-			}
-			    break;
-		    }
-
-		    CorrCondition* correlationCond =
-			new CorrCondition(itCond->second, cond0Condition, cond1Condition, this);
-
-		    correlationCond->setVerbosity(m_verbosity);
-		    correlationCond->setScales(&gtScales);
-		    correlationCond->evaluateConditionStoreResult(iBxInEvent);
-
-		    cMapResults[itCond->first] = correlationCond;
-
-		    if (m_verbosity && m_isDebugEnabled) {
-			std::ostringstream myCout;
-			correlationCond->print(myCout);
 
-			LogTrace("L1TGlobal") << myCout.str() << std::endl;
-		    }
+		    auto correlationCond = std::make_unique<CorrCondition>(itCond->second,
+			subCondition(corrTemplate->cond0Category(), corrTemplate->cond0Index()),
+			subCondition(corrTemplate->cond1Category(), corrTemplate->cond1Index()),
+			this);
 
-		    //  		delete correlationCond;
+		    correlationCond->setScales(&gtScales);
+		    condition = std::move(correlationCond);
 
-                
                 }
                     break;
                 case CondCorrelationWithOverlapRemoval: {
@@ -706,104 +574,20 @@ void l1t::GlobalBoard::runGTL(
                     // get first the sub-conditions
                     const CorrelationWithOverlapRemovalTemplate* corrTemplate =
 	            static_cast<const CorrelationWithOverlapRemovalTemplate*>(itCond->second);
-		    const GtConditionCategory cond0Categ = corrTemplate->cond0Category();
-		    const GtConditionCategory cond1Categ = corrTemplate->cond1Category();
-		    const GtConditionCategory cond2Categ = corrTemplate->cond2Category();
-		    const int cond0Ind = corrTemplate->cond0Index();
-		    const int cond1Ind = corrTemplate->cond1Index();
-		    const int cond2Ind = corrTemplate->cond2Index();
-
-		    const GlobalCondition* cond0Condition = nullptr;
-		    const GlobalCondition* cond1Condition = nullptr;
-		    const GlobalCondition* cond2Condition = nullptr;
-
-		    // maximum number of objects received for evaluation of l1t::Type1s condition
-		    int cond0NrL1Objects = 0;
-		    int cond1NrL1Objects = 0;
-		    int cond2NrL1Objects = 0;
-		     LogDebug("L1TGlobal") << " cond0NrL1Objects" << cond0NrL1Objects << "  cond1NrL1Objects  " << cond1NrL1Objects << "  cond2NrL1Objects  " << cond2NrL1Objects << std::endl;
-
-
-		    switch (cond0Categ) {
-			case CondMuon: {
-			    cond0Condition = &((corrMuon[iChip])[cond0Ind]);
-			}
-			    break;
-			case CondCalo: {
-                            cond0Condition = &((corrCalo[iChip])[cond0Ind]);
-			}
-			    break;
-			case CondEnergySum: {
-			    cond0Condition = &((corrEnergySum[iChip])[cond0Ind]);
-			}
-			    break;
-			default: {
-			    // do nothing, should not arrive here
-			}
-			    break;
-		    }
-
-		    switch (cond1Categ) {
-			case CondMuon: {
-			    cond1Condition = &((corrMuon[iChip])[cond1Ind]);
-			}
-			    break;
-			case CondCalo: {
-                            cond1Condition = &((corrCalo[iChip])[cond1Ind]);
-			}
-			    break;
-			case CondEnergySum: {
-			    cond1Condition = &((corrEnergySum[iChip])[cond1Ind]);
-			}
-			    break;
-			default: {
-			    // do nothing, should not arrive here
-			}
-			    break;
-		    }
-
-		    switch (cond2Categ) {
-			case CondMuon: {
-			    cond2Condition = &((corrMuon[iChip])[cond2Ind]);
-			}
-			    break;
-			case CondCalo: {
-                            cond2Condition = &((corrCalo[iChip])[cond2Ind]);
-			}
-			    break;
-			case CondEnergySum: {
-			    cond2Condition = &((corrEnergySum[iChip])[cond2Ind]);
-			}
-			    break;
-			default: {
-			    // do nothing, should not arrive here
-			}
-			    break;
-		    }
-
-		    CorrWithOverlapRemovalCondition* correlationCondWOR =
-			new CorrWithOverlapRemovalCondition(itCond->second, cond0Condition, cond1Condition, cond2Condition, this);
-
-		    correlationCondWOR->setVerbosity(m_verbosity);
-		    correlationCondWOR->setScales(&gtScales);
-		    correlationCondWOR->evaluateConditionStoreResult(iBxInEvent);
-
-		    cMapResults[itCond->first] = correlationCondWOR;
-
-		    if (m_verbosity && m_isDebugEnabled) {
-			std::ostringstream myCout;
-			correlationCondWOR->print(myCout);
 
-			LogTrace("L1TGlobal") << myCout.str() << std::endl;
-		    }
+		    auto correlationCondWOR = std::make_unique<CorrWithOverlapRemovalCondition>(itCond->second,
+			subCondition(corrTemplate->cond0Category(), corrTemplate->cond0Index()),
+			subCondition(corrTemplate->cond1Category(), corrTemplate->cond1Index()),
+			subCondition(corrTemplate->cond2Category(), corrTemplate->cond2Index()),
+			this);
 
-		    //  		delete correlationCondWOR;
+		    correlationCondWOR->setScales(&gtScales);
+		    condition = std::move(correlationCondWOR);
 
-                
                 }
                     break;
                 case CondNull: {
-		  
+
                     // do nothing
 
                 }
@@ -815,24 +599,85 @@ void l1t::GlobalBoard::runGTL(
                     break;
             }
 
+            if (condition) {
+                condition->setVerbosity(m_verbosity);
+            }
+
+            m_compiledMenu.addCondition(iChip, itCond->first, std::move(condition));
+
         }
 
     }
 
-    // loop over algorithm map
+    // algorithms as RPN vectors of condition indices
+    m_compiledMenu.compileAlgorithms(algorithmMap, conditionMap);
+
+    if (m_verbosity && m_isDebugEnabled) {
+        std::ostringstream myCout;
+        m_compiledMenu.print(myCout);
+
+        LogTrace("L1TGlobal") << myCout.str() << std::endl;
+    }
+
+}
+
+
+// run GTL
+void l1t::GlobalBoard::runGTL(
+        edm::Event& iEvent, const edm::EventSetup& evSetup, const TriggerMenu* m_l1GtMenu,
+        const bool produceL1GtObjectMapRecord,
+        const int iBxInEvent,
+        std::unique_ptr<GlobalObjectMapRecord>& gtObjectMapRecord,  
+        const unsigned int numberPhysTriggers,
+        const int nrL1Mu,
+        const int nrL1EG,
+	const int nrL1Tau,
+	const int nrL1Jet ) {
+
+    const GlobalScales& gtScales = m_l1GtMenu->gtScales();
+    const std::string scaleSetName = gtScales.getScalesName();
+    LogDebug("L1TGlobal") << " L1 Menu Scales -- Set Name: " << scaleSetName << std::endl;
+
+    // Reset AlgBlk for this bx
+     m_uGtAlgBlk.reset();
+     m_algInitialOr=false;
+     m_algPrescaledOr=false;
+     m_algIntermOr=false;
+     m_algFinalOr=false;
+     m_algFinalOrVeto=false;
+     
+    // never happens in production (the menu is compiled when it changes) but at first event...
+    if (m_compiledMenu.menu() != m_l1GtMenu) {
+        compileMenu(m_l1GtMenu, nrL1Mu, nrL1EG, nrL1Tau, nrL1Jet);
+    }
+
+    // evaluate each condition once, the results are kept in a bit set
+    m_compiledMenu.evaluateConditions(iBxInEvent);
+
+    if (m_verbosity && m_isDebugEnabled) {
+        for (unsigned int iCond = 0; iCond < m_compiledMenu.numberOfConditions(); ++iCond) {
+            if (m_compiledMenu.conditionEvaluation(iCond)) {
+                std::ostringstream myCout;
+                m_compiledMenu.conditionEvaluation(iCond)->print(myCout);
+
+                LogTrace("L1TGlobal") << myCout.str() << std::endl;
+            }
+        }
+    }
+
+    // loop over the compiled algorithms
     /// DMP Start debugging here
     // empty vector for object maps - filled during loop
     std::vector<GlobalObjectMap> objMapVec;
     if (produceL1GtObjectMapRecord && (iBxInEvent == 0)) objMapVec.reserve(numberPhysTriggers);
 
-    for (CItAlgo itAlgo = algorithmMap.begin(); itAlgo != algorithmMap.end(); itAlgo++) {
-        AlgorithmEvaluation gtAlg(itAlgo->second);
-        gtAlg.evaluateAlgorithm((itAlgo->second).algoChipNumber(), m_conditionResultMaps);
+    for (std::vector<CompiledMenu::Algorithm>::const_iterator itAlgo = m_compiledMenu.algorithms().begin();
+            itAlgo != m_compiledMenu.algorithms().end(); itAlgo++) {
 
-        int algBitNumber = (itAlgo->second).algoBitNumber();
-        bool algResult = gtAlg.gtAlgoResult();
+        int algBitNumber = itAlgo->bitNumber;
+        bool algResult = m_compiledMenu.evaluateAlgorithm(*itAlgo);
 
-	LogDebug("L1TGlobal") << " ===> for iBxInEvent = " << iBxInEvent << ":\t algBitName = " << itAlgo->first << ",\t algBitNumber = " << algBitNumber << ",\t algResult = " << algResult << std::endl;
+	LogDebug("L1TGlobal") << " ===> for iBxInEvent = " << iBxInEvent << ":\t algBitName = " << itAlgo->name << ",\t algBitNumber = " << algBitNumber << ",\t algResult = " << algResult << std::endl;
 
         if (algResult) {
 //            m_gtlAlgorithmOR.set(algBitNumber);
@@ -842,8 +687,8 @@ void l1t::GlobalBoard::runGTL(
 
         if (m_verbosity && m_isDebugEnabled) {
             std::ostringstream myCout;
-            ( itAlgo->second ).print(myCout);
-            gtAlg.print(myCout);
+            (itAlgo->algorithm)->print(myCout);
+            myCout << "    Algorithm result:          " << algResult << std::endl;
 
             LogTrace("L1TGlobal") << myCout.str() << std::endl;
         }
@@ -852,43 +697,20 @@ void l1t::GlobalBoard::runGTL(
         // object maps only for BxInEvent = 0
         if (produceL1GtObjectMapRecord && (iBxInEvent == 0)) {
 
-	  std::vector<L1TObjectTypeInCond> otypes;	  
-	  for (auto iop = gtAlg.operandTokenVector().begin(); iop != gtAlg.operandTokenVector().end(); ++iop){
-	    //cout << "INFO:  operand name:  " << iop->tokenName << "\n";
-	    int myChip = -1;
-	    int found =0;
-	    L1TObjectTypeInCond otype;	      
-	    for (auto imap = conditionMap.begin(); imap != conditionMap.end(); imap++) {
-	      myChip++;
-	      auto match = imap->find(iop->tokenName);
-	      
-	      if (match != imap->end()){
-		found = 1;
-		//cout << "DEBUG: found match for " << iop->tokenName << " at " << match->first << "\n";
-				
-		otype = match->second->objectType();
-		
-		for (auto itype = otype.begin(); itype != otype.end() ; itype++){
-		  //cout << "type:  " << *itype << "\n";
-		}
-	      }	      
-	    }
-	    if (!found){
-	      edm::LogWarning("L1TGlobal") << "\n Failed to find match for operand token " << iop->tokenName << "\n";
-	    } else {
-	      otypes.push_back(otype);
-	    }
-	  }
+	  std::vector<GlobalLogicParser::OperandToken> operandTokenVector;
+	  std::vector<CombinationsInCond> combinationVector;
+	  m_compiledMenu.fillOperands(*itAlgo, operandTokenVector, combinationVector);
+
+	  std::vector<L1TObjectTypeInCond> otypes(itAlgo->operandObjectTypes);
 
 	  // set object map 
 	  GlobalObjectMap objMap;
 	  
-	  objMap.setAlgoName(itAlgo->first);
+	  objMap.setAlgoName(itAlgo->name);
 	  objMap.setAlgoBitNumber(algBitNumber);
 	  objMap.setAlgoGtlResult(algResult);
-	  objMap.swapOperandTokenVector(gtAlg.operandTokenVector());
-	  objMap.swapCombinationVector(gtAlg.gtAlgoCombinationVector());
-	  // gtAlg is empty now...
+	  objMap.swapOperandTokenVector(operandTokenVector);
+	  objMap.swapCombinationVector(combinationVector);
 	  objMap.swapObjectTypeVector(otypes);
 	  
 	  if (m_verbosity && m_isDebugEnabled) {
@@ -910,22 +732,6 @@ void l1t::GlobalBoard::runGTL(
         gtObjectMapRecord->swapGtObjectMap(objMapVec);
     }
 
-    // loop over condition maps (one map per condition chip)
-    // then loop over conditions in the map
-    // delete the conditions created with new, zero pointer, do not clear map, keep the vector as is...
-    for (std::vector<AlgorithmEvaluation::ConditionEvaluationMap>::iterator
-            itCondOnChip  = m_conditionResultMaps.begin();
-            itCondOnChip != m_conditionResultMaps.end(); itCondOnChip++) {
-
-        for (AlgorithmEvaluation::ItEvalMap
-                itCond  = itCondOnChip->begin();
-                itCond != itCondOnChip->end(); itCond++) {
-
-            delete itCond->second;
-            itCond->second = nullptr;
-        }
-    }
-
 }
 
 
@@ -0,0 +1,88 @@
+#!/usr/bin/env python
+#
+#  Timing of the uGT emulator on a full L1 menu: the uGT inputs unpacked from
+#  RAW data are re-emulated with simGtStage2Digis, and the FastTimerService
+#  reports the time spent per module.
+#
+#  cmsRun benchmarkGlobalEmulation.py inputFiles=file:raw.root menu=L1Menu_Collisions2016_v9.xml maxEvents=10000
+#
+import FWCore.ParameterSet.Config as cms
+
+import FWCore.ParameterSet.VarParsing as VarParsing
+options = VarParsing.VarParsing('analysis')
+options.register('menu',
+                 '',
+                 VarParsing.VarParsing.multiplicity.singleton,
+                 VarParsing.VarParsing.varType.string,
+                 "L1 menu XML file, menu from the GlobalTag if empty")
+options.register('globalTag',
+                 '90X_dataRun2_v0',
+                 VarParsing.VarParsing.multiplicity.singleton,
+                 VarParsing.VarParsing.varType.string,
+                 "GlobalTag")
+options.register('bxInEvent',
+                 1,
+                 VarParsing.VarParsing.multiplicity.singleton,
+                 VarParsing.VarParsing.varType.int,
+                 "Number of bunch crossings emulated per event")
+options.maxEvents = 1000
+options.parseArguments()
+
+from Configuration.StandardSequences.Eras import eras
+process = cms.Process('L1GTBENCHMARK',eras.Run2_2016)
+
+process.load('Configuration.StandardSequences.Services_cff')
+process.load('FWCore.MessageService.MessageLogger_cfi')
+process.load('Configuration/StandardSequences/FrontierConditions_GlobalTag_cff')
+process.load('Configuration.StandardSequences.GeometryRecoDB_cff')
+process.load('Configuration.StandardSequences.MagneticField_AutoFromDBCurrent_cff')
+process.load('Configuration.StandardSequences.RawToDigi_Data_cff')
+
+process.MessageLogger.cerr.FwkReport.reportEvery = 1000
+
+process.maxEvents = cms.untracked.PSet(
+    input = cms.untracked.int32(options.maxEvents)
+    )
+
+# Input source
+process.source = cms.Source("PoolSource",
+    fileNames = cms.untracked.vstring(options.inputFiles)
+    )
+
+process.options = cms.untracked.PSet(
+    numberOfThreads = cms.untracked.uint32(1),
+    numberOfStreams = cms.untracked.uint32(0)
+    )
+
+# Other statements
+from Configuration.AlCa.GlobalTag import GlobalTag
+process.GlobalTag = GlobalTag(process.GlobalTag, options.globalTag, '')
+
+## Load the L1 menu from the XML file
+if options.menu != '':
+    process.load('L1Trigger.L1TGlobal.TriggerMenu_cff')
+    process.TriggerMenu.L1TriggerMenuFile = cms.string(options.menu)
+    process.es_prefer_l1GtTriggerMenu = cms.ESPrefer('L1TUtmTriggerMenuESProducer','TriggerMenu')
+
+## Re-emulate the uGT from its unpacked inputs
+process.load('L1Trigger.L1TGlobal.simGtStage2Digis_cfi')
+process.simGtStage2Digis.MuonInputTag   = cms.InputTag("gtStage2Digis","Muon")
+process.simGtStage2Digis.EGammaInputTag = cms.InputTag("gtStage2Digis","EGamma")
+process.simGtStage2Digis.TauInputTag    = cms.InputTag("gtStage2Digis","Tau")
+process.simGtStage2Digis.JetInputTag    = cms.InputTag("gtStage2Digis","Jet")
+process.simGtStage2Digis.EtSumInputTag  = cms.InputTag("gtStage2Digis","EtSum")
+process.simGtStage2Digis.ExtInputTag    = cms.InputTag("gtStage2Digis")
+process.simGtStage2Digis.EmulateBxInEvent = cms.int32(options.bxInEvent)
+
+## Time per module
+process.FastTimerService = cms.Service("FastTimerService",
+    printEventSummary = cms.untracked.bool(False),
+    printRunSummary   = cms.untracked.bool(False),
+    printJobSummary   = cms.untracked.bool(True),
+    enableDQM         = cms.untracked.bool(False)
+    )
+
+process.raw2digi_step = cms.Path(process.gtStage2Digis)
+process.emulation_step = cms.Path(process.simGtStage2Digis)
+
+process.schedule = cms.Schedule(process.raw2digi_step,process.emulation_step)
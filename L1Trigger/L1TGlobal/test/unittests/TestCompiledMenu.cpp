@@ -0,0 +1,322 @@
+#include "Utilities/Testing/interface/CppUnit_testdriver.icpp"
+#include "cppunit/extensions/HelperMacros.h"
+
+#include "L1Trigger/L1TGlobal/interface/CompiledMenu.h"
+#include "L1Trigger/L1TGlobal/interface/ConditionEvaluation.h"
+#include "L1Trigger/L1TGlobal/interface/GlobalAlgorithm.h"
+#include "L1Trigger/L1TGlobal/interface/GlobalCondition.h"
+#include "L1Trigger/L1TGlobal/interface/TriggerMenuFwd.h"
+
+#include "FWCore/Utilities/interface/Exception.h"
+
+#include <map>
+#include <memory>
+#include <random>
+#include <stack>
+#include <string>
+#include <vector>
+
+
+class TestCompiledMenu: public CppUnit::TestFixture
+{
+  CPPUNIT_TEST_SUITE(TestCompiledMenu);
+  CPPUNIT_TEST(test_results);
+  CPPUNIT_TEST(test_combinations);
+  CPPUNIT_TEST(test_algorithms);
+  CPPUNIT_TEST(test_stackDepth);
+  CPPUNIT_TEST(test_invalid);
+  CPPUNIT_TEST_SUITE_END();
+
+public:
+  TestCompiledMenu() {}
+  ~TestCompiledMenu() {}
+  void setUp() {}
+  void tearDown() {}
+
+  void test_results();
+  void test_combinations();
+  void test_algorithms();
+  void test_stackDepth();
+  void test_invalid();
+
+private:
+  // condition passing in bx 0 with one combination, and failing in the other
+  // bx before touching the combinations, as the early returns of the
+  // conditions of the emulator do
+  class BxZeroCondition : public l1t::ConditionEvaluation {
+  public:
+    const bool evaluateCondition(const int bxEval) const override {
+      if (bxEval != 0)
+        return false;
+      combinationsInCond().clear();
+      combinationsInCond().push_back(SingleCombInCond(1, 0));
+      return true;
+    }
+  };
+
+  // condition with its result set by the test
+  class FixedCondition : public l1t::ConditionEvaluation {
+  public:
+    FixedCondition(const std::vector<char>& results, unsigned int index) :
+      m_results(results), m_index(index) {}
+    const bool evaluateCondition(const int bxEval) const override {
+      return m_results[m_index];
+    }
+  private:
+    const std::vector<char>& m_results;
+    const unsigned int m_index;
+  };
+
+  // menu of nConditions FixedConditions named cond0, cond1, ... on chip 0
+  struct TestMenu {
+    std::vector<char> results;
+    std::vector<std::unique_ptr<GlobalCondition> > conditions;
+    std::vector<l1t::ConditionMap> conditionMap;
+    l1t::CompiledMenu menu;
+
+    explicit TestMenu(unsigned int nConditions) : results(nConditions, 0), conditionMap(1) {
+      menu.reset(nullptr);
+      for (unsigned int i = 0; i < nConditions; ++i) {
+        const std::string name = "cond" + std::to_string(i);
+        menu.addCondition(0, name, std::make_unique<FixedCondition>(results, i));
+        conditions.push_back(std::make_unique<GlobalCondition>(name));
+        conditionMap[0][name] = conditions.back().get();
+      }
+    }
+  };
+
+  static GlobalAlgorithm makeAlgorithm(const std::string& name, const std::string& expression, int bit) {
+    GlobalAlgorithm algorithm(name, expression, bit);
+    algorithm.setAlgoChipNumber(0);
+    return algorithm;
+  }
+
+  // random logical expression on the conditions of the menu, with its value
+  // for the current condition results computed on the expression tree
+  static std::string randomExpression(std::mt19937& rng, const std::vector<char>& results,
+      unsigned int depth, bool& value);
+
+  // evaluation of the RPN vector with a stack of bools, as the evaluation of
+  // the algorithms by name before the menu was compiled (AlgorithmEvaluation)
+  static bool evaluateRpn(const GlobalAlgorithm& algorithm, const std::vector<char>& results);
+};
+
+CPPUNIT_TEST_SUITE_REGISTRATION(TestCompiledMenu);
+
+
+void TestCompiledMenu::test_results()
+{
+  l1t::CompiledMenu menu;
+  menu.reset(nullptr);
+
+  // more than 64 conditions, to use several words of the bit set
+  const unsigned int nConditions = 70;
+  for (unsigned int i = 0; i < nConditions; ++i) {
+    menu.addCondition(0, "cond" + std::to_string(i), std::make_unique<BxZeroCondition>());
+  }
+  menu.addCondition(0, "notEvaluated", nullptr);
+
+  menu.evaluateConditions(0);
+  for (unsigned int i = 0; i < nConditions; ++i)
+    CPPUNIT_ASSERT(menu.conditionResult(i));
+  CPPUNIT_ASSERT(!menu.conditionResult(nConditions));
+
+  menu.evaluateConditions(1);
+  for (unsigned int i = 0; i <= nConditions; ++i)
+    CPPUNIT_ASSERT(!menu.conditionResult(i));
+}
+
+void TestCompiledMenu::test_combinations()
+{
+  l1t::CompiledMenu menu;
+  menu.reset(nullptr);
+  const unsigned int iCond = menu.addCondition(0, "cond", std::make_unique<BxZeroCondition>());
+
+  menu.evaluateConditions(0);
+  CPPUNIT_ASSERT(menu.conditionResult(iCond));
+  CPPUNIT_ASSERT_EQUAL(size_t(1), menu.conditionEvaluation(iCond)->getCombinationsInCond().size());
+
+  // a failing evaluation after a passing one must not keep the combinations
+  // of the passing one, also in the following bx or event
+  menu.evaluateConditions(1);
+  CPPUNIT_ASSERT(!menu.conditionResult(iCond));
+  CPPUNIT_ASSERT(menu.conditionEvaluation(iCond)->getCombinationsInCond().empty());
+
+  menu.evaluateConditions(0);
+  CPPUNIT_ASSERT_EQUAL(size_t(1), menu.conditionEvaluation(iCond)->getCombinationsInCond().size());
+}
+
+std::string TestCompiledMenu::randomExpression(std::mt19937& rng, const std::vector<char>& results,
+    unsigned int depth, bool& value)
+{
+  std::uniform_int_distribution<unsigned int> node(0, depth == 0 ? 0 : 3);
+  std::uniform_int_distribution<unsigned int> condition(0, results.size() - 1);
+  switch (node(rng)) {
+    case 1: {
+      bool v;
+      const std::string e = randomExpression(rng, results, depth - 1, v);
+      value = !v;
+      return "NOT ( " + e + " )";
+    }
+    case 2: {
+      bool v1, v2;
+      const std::string e1 = randomExpression(rng, results, depth - 1, v1);
+      const std::string e2 = randomExpression(rng, results, depth - 1, v2);
+      value = v1 && v2;
+      return "( " + e1 + " ) AND ( " + e2 + " )";
+    }
+    case 3: {
+      bool v1, v2;
+      const std::string e1 = randomExpression(rng, results, depth - 1, v1);
+      const std::string e2 = randomExpression(rng, results, depth - 1, v2);
+      value = v1 || v2;
+      return "( " + e1 + " ) OR ( " + e2 + " )";
+    }
+    default: {
+      const unsigned int i = condition(rng);
+      value = results[i];
+      return "cond" + std::to_string(i);
+    }
+  }
+}
+
+bool TestCompiledMenu::evaluateRpn(const GlobalAlgorithm& algorithm, const std::vector<char>& results)
+{
+  std::stack<bool, std::vector<bool> > resultStack;
+  bool b1, b2;
+  for (auto const& token : algorithm.algoRpnVector()) {
+    switch (token.operation) {
+      case GlobalLogicParser::OP_OPERAND:
+        resultStack.push(results[std::stoi(token.operand.substr(4))]);
+        break;
+      case GlobalLogicParser::OP_NOT:
+        b1 = resultStack.top();
+        resultStack.pop();
+        resultStack.push(!b1);
+        break;
+      case GlobalLogicParser::OP_OR:
+        b1 = resultStack.top();
+        resultStack.pop();
+        b2 = resultStack.top();
+        resultStack.pop();
+        resultStack.push(b1 || b2);
+        break;
+      case GlobalLogicParser::OP_AND:
+        b1 = resultStack.top();
+        resultStack.pop();
+        b2 = resultStack.top();
+        resultStack.pop();
+        resultStack.push(b1 && b2);
+        break;
+      default:
+        break;
+    }
+  }
+  return resultStack.top();
+}
+
+void TestCompiledMenu::test_algorithms()
+{
+  // more than 64 conditions, to use several words of the bit set
+  const unsigned int nConditions = 70;
+  TestMenu test(nConditions);
+  std::mt19937 rng(12345);
+  std::bernoulli_distribution coin(0.5);
+
+  const unsigned int nAlgorithms = 500;
+  l1t::AlgorithmMap algorithmMap;
+  for (unsigned int iAlgo = 0; iAlgo < nAlgorithms; ++iAlgo) {
+    bool value;
+    const std::string name = "algo" + std::to_string(iAlgo);
+    algorithmMap[name] = makeAlgorithm(name, randomExpression(rng, test.results, 1 + iAlgo % 6, value), iAlgo);
+  }
+  test.menu.compileAlgorithms(algorithmMap, test.conditionMap);
+  CPPUNIT_ASSERT_EQUAL(size_t(nAlgorithms), test.menu.algorithms().size());
+
+  for (unsigned int iTrial = 0; iTrial < 50; ++iTrial) {
+    for (auto& result : test.results)
+      result = coin(rng);
+    test.menu.evaluateConditions(0);
+    for (auto const& algorithm : test.menu.algorithms()) {
+      CPPUNIT_ASSERT_EQUAL(evaluateRpn(*algorithm.algorithm, test.results), test.menu.evaluateAlgorithm(algorithm));
+    }
+  }
+
+  // the value computed on the expression tree, for new random expressions
+  for (unsigned int iTrial = 0; iTrial < 500; ++iTrial) {
+    for (auto& result : test.results)
+      result = coin(rng);
+    bool value;
+    l1t::AlgorithmMap single;
+    single["algo"] = makeAlgorithm("algo", randomExpression(rng, test.results, 8, value), 0);
+    test.menu.compileAlgorithms(single, test.conditionMap);
+    test.menu.evaluateConditions(0);
+    CPPUNIT_ASSERT_EQUAL(value, test.menu.evaluateAlgorithm(test.menu.algorithms().front()));
+  }
+}
+
+void TestCompiledMenu::test_stackDepth()
+{
+  const unsigned int maxDepth = l1t::CompiledMenu::maxStackDepth;
+  TestMenu test(maxDepth + 1);
+
+  // cond0 AND ( cond1 AND ( ... ) ): all the operands are on the stack
+  // before the first AND
+  auto nested = [](unsigned int n, const std::string& op) {
+    std::string expression = "cond" + std::to_string(n - 1);
+    for (int i = n - 2; i >= 0; --i)
+      expression = "cond" + std::to_string(i) + " " + op + " ( " + expression + " )";
+    return expression;
+  };
+
+  l1t::AlgorithmMap algorithmMap;
+  algorithmMap["deepAnd"] = makeAlgorithm("deepAnd", nested(maxDepth, "AND"), 0);
+  algorithmMap["deepOr"] = makeAlgorithm("deepOr", nested(maxDepth, "OR"), 1);
+  test.menu.compileAlgorithms(algorithmMap, test.conditionMap);
+
+  for (unsigned int iFalse = 0; iFalse <= maxDepth; ++iFalse) {
+    // all true but one (none for iFalse == maxDepth), in the first maxDepth conditions
+    std::fill(test.results.begin(), test.results.end(), 1);
+    if (iFalse < maxDepth)
+      test.results[iFalse] = 0;
+    test.menu.evaluateConditions(0);
+    for (auto const& algorithm : test.menu.algorithms()) {
+      const bool expected = (algorithm.name == "deepAnd") ? iFalse == maxDepth : true;
+      CPPUNIT_ASSERT_EQUAL(expected, test.menu.evaluateAlgorithm(algorithm));
+    }
+  }
+  std::fill(test.results.begin(), test.results.end(), 0);
+  test.results[0] = 1;
+  test.menu.evaluateConditions(0);
+  for (auto const& algorithm : test.menu.algorithms())
+    CPPUNIT_ASSERT_EQUAL(algorithm.name == "deepOr", test.menu.evaluateAlgorithm(algorithm));
+
+  // one operand more does not fit in the 64-bit stack
+  l1t::AlgorithmMap tooDeep;
+  tooDeep["tooDeep"] = makeAlgorithm("tooDeep", nested(maxDepth + 1, "AND"), 0);
+  CPPUNIT_ASSERT_THROW(test.menu.compileAlgorithms(tooDeep, test.conditionMap), cms::Exception);
+}
+
+void TestCompiledMenu::test_invalid()
+{
+  TestMenu test(2);
+
+  // no logical expression, empty RPN vector
+  l1t::AlgorithmMap empty;
+  GlobalAlgorithm noExpression("empty");
+  noExpression.setAlgoChipNumber(0);
+  empty["empty"] = noExpression;
+  CPPUNIT_ASSERT_THROW(test.menu.compileAlgorithms(empty, test.conditionMap), cms::Exception);
+
+  // condition not in the menu
+  l1t::AlgorithmMap unknown;
+  unknown["unknown"] = makeAlgorithm("unknown", "cond0 AND cond7", 0);
+  CPPUNIT_ASSERT_THROW(test.menu.compileAlgorithms(unknown, test.conditionMap), cms::Exception);
+
+  // condition on another chip
+  l1t::AlgorithmMap otherChip;
+  GlobalAlgorithm algorithm("otherChip", "cond0", 0);
+  algorithm.setAlgoChipNumber(1);
+  otherChip["otherChip"] = algorithm;
+  CPPUNIT_ASSERT_THROW(test.menu.compileAlgorithms(otherChip, test.conditionMap), cms::Exception);
+}
@@ -12,6 +12,7 @@
 #include "L1Trigger/L1TMuonEndCap/interface/PtAssignmentEngineAux.h"
 #include "L1Trigger/L1TMuonEndCap/interface/PtLUTReader.h"
 #include "L1Trigger/L1TMuonEndCap/interface/bdt/Forest.h"
+#include "L1Trigger/L1TMuonEndCap/interface/bdt/FlatForest.h"
 
 
 class PtAssignmentEngine {
@@ -53,6 +54,7 @@ public:
 protected:
   std::vector<int> allowedModes_;
   std::array<emtf::Forest, 16> forests_;
+  std::array<emtf::FlatForest, 16> flat_forests_;  // copies of forests_ used for the evaluation
   PtLUTReader ptlut_reader_;
 
   int verbose_;
@@ -52,6 +52,10 @@ public:
 
   void configure_by_fw_version(unsigned fw_version);
 
+  // The pT assignment engine is shared by all the sector processors, which
+  // only read it in process(): it is configured here, once per event
+  void configure_pt_assign_engine();
+
   void process(
       // Input
       EventNumber_t ievent,
@@ -38,12 +38,18 @@ private:
 
   emtf::sector_array<SectorProcessor> sector_processors_;
 
+  // Output of each sector processor, kept to reuse the memory
+  emtf::sector_array<EMTFHitCollection> sector_hits_;
+  emtf::sector_array<EMTFTrackCollection> sector_tracks_;
+
   const edm::ParameterSet config_;
 
   const edm::EDGetToken tokenCSC_, tokenRPC_, tokenGEM_;
 
   int verbose_, primConvLUT_;
 
+  bool parallelSectors_;
+
   bool fwConfig_, useCSC_, useRPC_, useGEM_;
 
   std::string era_;
@@ -0,0 +1,59 @@
+// FlatForest.h
+
+#ifndef L1Trigger_L1TMuonEndCap_emtf_FlatForest
+#define L1Trigger_L1TMuonEndCap_emtf_FlatForest
+
+#include <cstdint>
+#include <vector>
+
+namespace emtf {
+
+class Forest;
+
+// Read-only copy of a Forest for the evaluation: the nodes of all the trees
+// are stored in one array, the two daughters of a node next to each other.
+// predict() visits the same nodes and adds the same fit values in the same
+// order as Forest::predictEvent(), so that the results are bit-identical.
+class FlatForest
+{
+    public:
+
+        FlatForest() : boostWeight(0.) {}
+
+        // copy the trees of forest (non-const: the Forest accessors are not const)
+        void build(Forest& forest);
+        void clear();
+
+        bool empty() const { return roots.empty(); }
+        unsigned int size() const { return roots.size(); }
+
+        // prediction of the first numTrees trees for the variables data
+        double predict(const double* data, unsigned int numTrees) const;
+
+        // predictions for nEvents events of nVariables variables each, stored
+        // one after the other in data: the trees are visited one after the
+        // other for all the events
+        void predict(const double* data, unsigned int nVariables, unsigned int nEvents,
+                     unsigned int numTrees, double* out) const;
+
+    private:
+
+        struct FlatNode
+        {
+            double splitValue;
+            double fitValue;
+            int32_t splitVariable;
+            int32_t left;  // -1 for the terminal nodes, the right daughter is left+1
+        };
+
+        // index of the node of tree t where the event ends
+        uint32_t terminal(const double* data, uint32_t root) const;
+
+        std::vector<FlatNode> nodes;
+        std::vector<uint32_t> roots;
+        double boostWeight;
+};
+
+} // end of emtf namespace
+
+#endif
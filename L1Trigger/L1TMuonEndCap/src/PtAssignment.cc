@@ -20,11 +20,8 @@ void PtAssignment::configure(
   sector_  = sector;
   bx_      = bx;
 
-  pt_assign_engine_->configure(
-      verbose_,
-      readPtLUTFile, fixMode15HighPt,
-      bug9BitDPhi, bugMode7CLCT, bugNegPt
-  );
+  // The engine, shared by all the sector processors, is configured by
+  // SectorProcessor::configure_pt_assign_engine() before they run
 
   bugGMTPhi_    = bugGMTPhi;
   promoteMode7_ = promoteMode7;
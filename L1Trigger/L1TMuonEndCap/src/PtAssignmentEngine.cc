@@ -10,6 +10,7 @@
 PtAssignmentEngine::PtAssignmentEngine() :
     allowedModes_({3,5,9,6,10,12,7,11,13,14,15}),
     forests_(),
+    flat_forests_(),
     ptlut_reader_(),
     ptLUTVersion_(0xFFFFFFFF)
 {
@@ -39,6 +40,7 @@ void PtAssignmentEngine::read(int pt_lut_version, const std::string& xml_dir) {
     std::stringstream ss;
     ss << xml_dir_full << "/" << mode;
     forests_.at(mode).loadForestFromXML(ss.str().c_str(), xml_nTrees);
+    flat_forests_.at(mode).build(forests_.at(mode));
   }
 
   return;
@@ -62,6 +64,7 @@ void PtAssignmentEngine::load(int pt_lut_version, const L1TMuonEndCapForest *pay
     // std::cout << "Loaded forest for mode " << mode << " with boostWeight_ = " << boostWeight_ << std::endl;
     // std::cout << "  * ptLUTVersion_ = " << ptLUTVersion_ << std::endl;
     forests_.at(mode).getTree(0)->setBoostWeight( boostWeight_ );
+    flat_forests_.at(mode).build(forests_.at(mode));
 
     if (not(boostWeight_ == 0 || ptLUTVersion_ >= 6))  // Check that XMLs and pT LUT version are consistent
       { edm::LogError("L1T") << "boostWeight_ = " << boostWeight_ << ", ptLUTVersion_ = " << ptLUTVersion_; return; }
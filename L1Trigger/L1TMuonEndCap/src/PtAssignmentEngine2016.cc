@@ -665,15 +665,8 @@ float PtAssignmentEngine2016::calculate_pt_xml(const address_t& address) const {
     std::cout << std::endl;
   }
 
-  auto tree_event = std::make_unique<emtf::Event>();
-  tree_event->predictedValue = 0;  // must explicitly initialize
-  tree_event->data = tree_data;
-
-  // forests_.at(mode_inv).predictEvent(tree_event.get(), 64);
-  emtf::Forest &forest = const_cast<emtf::Forest&>(forests_.at(mode_inv));
-  forest.predictEvent(tree_event.get(), 64);
-
-  float tmp_pt = tree_event->predictedValue;  // is actually 1/pT
+  // Same result as forests_.at(mode_inv).predictEvent(), with the flattened forest
+  float tmp_pt = flat_forests_.at(mode_inv).predict(tree_data.data(), 64);  // is actually 1/pT
 
   if (verbose_ > 1) {
     std::cout << "mode_inv: " << mode_inv << " 1/pT: " << tmp_pt << std::endl;
@@ -358,6 +358,14 @@ void SectorProcessor::configure_by_fw_version(unsigned fw_version) {
 
 }
 
+void SectorProcessor::configure_pt_assign_engine() {
+  pt_assign_engine_->configure(
+      verbose_,
+      readPtLUTFile_, fixMode15HighPt_,
+      bug9BitDPhi_, bugMode7CLCT_, bugNegPt_
+  );
+}
+
 void SectorProcessor::process(
     EventNumber_t ievent,
     const TriggerPrimitiveCollection& muon_primitives,
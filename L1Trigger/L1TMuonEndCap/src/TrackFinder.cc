@@ -5,6 +5,8 @@
 
 #include "L1Trigger/L1TMuonEndCap/interface/EMTFSubsystemCollector.h"
 
+#include "tbb/parallel_for.h"
+
 
 TrackFinder::TrackFinder(const edm::ParameterSet& iConfig, edm::ConsumesCollector&& iConsumes) :
     geometry_translator_(),
@@ -12,11 +14,14 @@ TrackFinder::TrackFinder(const edm::ParameterSet& iConfig, edm::ConsumesCollecto
     sector_processor_lut_(),
     pt_assign_engine_(),
     sector_processors_(),
+    sector_hits_(),
+    sector_tracks_(),
     config_(iConfig),
     tokenCSC_(iConsumes.consumes<CSCTag::digi_collection>(iConfig.getParameter<edm::InputTag>("CSCInput"))),
     tokenRPC_(iConsumes.consumes<RPCTag::digi_collection>(iConfig.getParameter<edm::InputTag>("RPCInput"))),
     tokenGEM_(iConsumes.consumes<GEMTag::digi_collection>(iConfig.getParameter<edm::InputTag>("GEMInput"))),
     verbose_(iConfig.getUntrackedParameter<int>("verbosity")),
+    parallelSectors_(iConfig.getUntrackedParameter<bool>("ParallelSectors", true)),
     primConvLUT_(iConfig.getParameter<edm::ParameterSet>("spPCParams16").getParameter<int>("PrimConvLUT")),
     fwConfig_(iConfig.getParameter<bool>("FWConfig")),
     useCSC_(iConfig.getParameter<bool>("CSCEnable")),
@@ -154,26 +159,45 @@ void TrackFinder::process(
   // Reload pT LUT if necessary
   pt_assign_engine_->load(condition_helper_.get_pt_lut_version(), &(condition_helper_.getForest()));
 
-  // MIN/MAX ENDCAP and TRIGSECTOR set in interface/Common.h
-  for (int endcap = emtf::MIN_ENDCAP; endcap <= emtf::MAX_ENDCAP; ++endcap) {
-    for (int sector = emtf::MIN_TRIGSECTOR; sector <= emtf::MAX_TRIGSECTOR; ++sector) {
-      const int es = (endcap - emtf::MIN_ENDCAP) * (emtf::MAX_TRIGSECTOR - emtf::MIN_TRIGSECTOR + 1) + (sector - emtf::MIN_TRIGSECTOR);
+  // Run-dependent configure. This overwrites many of the configurables passed by the python config file.
+  if (iEvent.isRealData() && fwConfig_) {
+    for (auto& sp : sector_processors_) {
+      sp.configure_by_fw_version(condition_helper_.get_fw_version());
+    }
+  }
 
-      // Run-dependent configure. This overwrites many of the configurables passed by the python config file.
-      if (iEvent.isRealData() && fwConfig_) {
-        sector_processors_.at(es).configure_by_fw_version(condition_helper_.get_fw_version());
-      }
-
-      // Process
-      sector_processors_.at(es).process(
-          iEvent.id().event(),
-          muon_primitives,
-          out_hits,
-          out_tracks
-      );
+  // Same pT assignment configuration for all the sectors
+  sector_processors_.front().configure_pt_assign_engine();
+
+  // The sectors are independent: each one is processed into its own hits and
+  // tracks, which are then appended to the output in the order of the sectors
+  // (the same output as processing the sectors one after the other).
+  // With verbosity the sectors are processed in order, to keep the printout readable.
+  auto process_sector = [&](size_t es) {
+    sector_hits_.at(es).clear();
+    sector_tracks_.at(es).clear();
+    sector_processors_.at(es).process(
+        iEvent.id().event(),
+        muon_primitives,
+        sector_hits_.at(es),
+        sector_tracks_.at(es)
+    );
+  };
+
+  // MIN/MAX ENDCAP and TRIGSECTOR set in interface/Common.h
+  if (parallelSectors_ && verbose_ == 0) {
+    tbb::parallel_for(size_t(0), sector_processors_.size(), process_sector);
+  } else {
+    for (size_t es = 0; es < sector_processors_.size(); ++es) {
+      process_sector(es);
     }
   }
 
+  for (size_t es = 0; es < sector_processors_.size(); ++es) {
+    out_hits.insert(out_hits.end(), sector_hits_.at(es).begin(), sector_hits_.at(es).end());
+    out_tracks.insert(out_tracks.end(), sector_tracks_.at(es).begin(), sector_tracks_.at(es).end());
+  }
+
 
   // ___________________________________________________________________________
   // Check emulator input and output. They are printed in a way that is friendly
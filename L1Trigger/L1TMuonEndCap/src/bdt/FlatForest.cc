@@ -0,0 +1,79 @@
+#include "L1Trigger/L1TMuonEndCap/interface/bdt/FlatForest.h"
+#include "L1Trigger/L1TMuonEndCap/interface/bdt/Forest.h"
+
+#include <algorithm>
+
+using namespace emtf;
+
+void FlatForest::build(Forest& forest)
+{
+    clear();
+    if(forest.size() == 0) return;
+    boostWeight = forest.getTree(0)->getBoostWeight();
+
+    // breadth first in each tree, so that the daughters are allocated together
+    std::vector<std::pair<Node*, uint32_t> > queue;
+    for(unsigned int t=0; t < forest.size(); t++)
+    {
+        roots.push_back(nodes.size());
+        nodes.push_back(FlatNode());
+        queue.assign(1, std::make_pair(forest.getTree(t)->getRootNode(), roots.back()));
+        for(size_t i=0; i < queue.size(); i++)
+        {
+            Node* node = queue[i].first;
+            const uint32_t index = queue[i].second;
+            nodes[index].splitValue = node->getSplitValue();
+            nodes[index].fitValue = node->getFitValue();
+            nodes[index].splitVariable = node->getSplitVariable();
+            nodes[index].left = -1;
+            if(node->getLeftDaughter() != nullptr && node->getRightDaughter() != nullptr)
+            {
+                nodes[index].left = nodes.size();
+                nodes.push_back(FlatNode());
+                nodes.push_back(FlatNode());
+                queue.push_back(std::make_pair(node->getLeftDaughter(), nodes[index].left));
+                queue.push_back(std::make_pair(node->getRightDaughter(), nodes[index].left + 1));
+            }
+        }
+    }
+}
+
+void FlatForest::clear()
+{
+    nodes.clear();
+    roots.clear();
+    boostWeight = 0.;
+}
+
+uint32_t FlatForest::terminal(const double* data, uint32_t index) const
+{
+    // same comparisons as Node::filterEventToDaughter: an event which is neither
+    // below nor above the split value (NaN) stops at the node
+    while(nodes[index].left >= 0)
+    {
+        const double x = data[nodes[index].splitVariable];
+        if(x < nodes[index].splitValue) index = nodes[index].left;
+        else if(x >= nodes[index].splitValue) index = nodes[index].left + 1;
+        else break;
+    }
+    return index;
+}
+
+double FlatForest::predict(const double* data, unsigned int numTrees) const
+{
+    double value = 0.;
+    predict(data, 0, 1, numTrees, &value);
+    return value;
+}
+
+void FlatForest::predict(const double* data, unsigned int nVariables, unsigned int nEvents,
+                         unsigned int numTrees, double* out) const
+{
+    std::fill(out, out + nEvents, boostWeight);
+    numTrees = std::min<unsigned int>(numTrees, roots.size());
+    for(unsigned int t=0; t < numTrees; t++)
+    {
+        for(unsigned int e=0; e < nEvents; e++)
+            out[e] += nodes[terminal(data + e * nVariables, roots[t])].fitValue;
+    }
+}
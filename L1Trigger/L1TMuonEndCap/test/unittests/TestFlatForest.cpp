@@ -0,0 +1,124 @@
+#include "Utilities/Testing/interface/CppUnit_testdriver.icpp"
+#include "cppunit/extensions/HelperMacros.h"
+
+#include "L1Trigger/L1TMuonEndCap/interface/bdt/FlatForest.h"
+#include "L1Trigger/L1TMuonEndCap/interface/bdt/Forest.h"
+
+#include <cmath>
+#include <limits>
+#include <random>
+
+
+class TestFlatForest: public CppUnit::TestFixture
+{
+  CPPUNIT_TEST_SUITE(TestFlatForest);
+  CPPUNIT_TEST(test_predict);
+  CPPUNIT_TEST(test_predict_batch);
+  CPPUNIT_TEST(test_nan);
+  CPPUNIT_TEST_SUITE_END();
+
+public:
+  TestFlatForest() {}
+  ~TestFlatForest() {}
+  void setUp();
+  void tearDown() {}
+
+  void test_predict();
+  void test_predict_batch();
+  void test_nan();
+
+private:
+  // random tree of about nNodes nodes in the cond format
+  L1TMuonEndCapForest::DTree makeTree(int nNodes);
+
+  std::mt19937 gen_;
+  emtf::Forest forest_;
+  emtf::FlatForest flat_forest_;
+
+  static const int nVariables = 12;
+  static const unsigned int nTrees = 400;
+};
+
+///registration of the test so that the runner can find it
+CPPUNIT_TEST_SUITE_REGISTRATION(TestFlatForest);
+
+
+L1TMuonEndCapForest::DTree TestFlatForest::makeTree(int nNodes)
+{
+  std::uniform_int_distribution<int> var(0, nVariables-1);
+  std::uniform_real_distribution<double> val(-100., 100.);
+
+  L1TMuonEndCapForest::DTree tree(1);
+  std::vector<unsigned> leaves = {0};
+  while (static_cast<int>(tree.size()) + 2 <= nNodes) {
+    // split a random leaf
+    std::uniform_int_distribution<size_t> pick(0, leaves.size()-1);
+    size_t i = pick(gen_);
+    unsigned node = leaves[i];
+    leaves.erase(leaves.begin()+i);
+    tree[node].splitVar = var(gen_);
+    tree[node].splitVal = std::round(val(gen_));
+    tree[node].ileft = tree.size();
+    tree[node].iright = tree.size()+1;
+    tree.resize(tree.size()+2);
+    leaves.push_back(tree[node].ileft);
+    leaves.push_back(tree[node].iright);
+  }
+  for (auto& node : tree)
+    node.fitVal = val(gen_) * 1e-3;
+  return tree;
+}
+
+void TestFlatForest::setUp()
+{
+  gen_.seed(12345);
+  L1TMuonEndCapForest::DForest payload;
+  for (unsigned int t = 0; t < nTrees; ++t)
+    payload.push_back(makeTree(15));
+  forest_.loadFromCondPayload(payload);
+  forest_.getTree(0)->setBoostWeight(0.25);
+  flat_forest_.build(forest_);
+}
+
+void TestFlatForest::test_predict()
+{
+  CPPUNIT_ASSERT_EQUAL(nTrees, flat_forest_.size());
+
+  std::uniform_int_distribution<int> val(-110, 110);
+  for (int i = 0; i < 10000; ++i) {
+    std::vector<double> data(nVariables);
+    for (auto& x : data)
+      x = val(gen_);
+    for (unsigned int numTrees : {64u, 400u, 1000u}) {
+      emtf::Event event;
+      event.predictedValue = 0;
+      event.data = data;
+      forest_.predictEvent(&event, numTrees);
+      // bit-identical, not only close
+      CPPUNIT_ASSERT(event.predictedValue == flat_forest_.predict(data.data(), numTrees));
+    }
+  }
+}
+
+void TestFlatForest::test_predict_batch()
+{
+  const unsigned int nEvents = 100;
+  std::uniform_int_distribution<int> val(-110, 110);
+  std::vector<double> data(nEvents * nVariables);
+  for (auto& x : data)
+    x = val(gen_);
+  std::vector<double> out(nEvents);
+  flat_forest_.predict(data.data(), nVariables, nEvents, nTrees, out.data());
+  for (unsigned int e = 0; e < nEvents; ++e)
+    CPPUNIT_ASSERT(out[e] == flat_forest_.predict(data.data() + e * nVariables, nTrees));
+}
+
+void TestFlatForest::test_nan()
+{
+  std::vector<double> data(nVariables, std::numeric_limits<double>::quiet_NaN());
+  emtf::Event event;
+  event.predictedValue = 0;
+  event.data = data;
+  forest_.predictEvent(&event, nTrees);
+  CPPUNIT_ASSERT(event.predictedValue == flat_forest_.predict(data.data(), nTrees));
+}
@@ -53,6 +53,13 @@ class MagneticField
   virtual GlobalVector inTeslaUnchecked (const GlobalPoint& gp) const {
     return inTesla(gp);  // default dummy implementation
   }
+
+  /// Field values at n points, in Tesla. Derived classes can implement
+  /// these to evaluate several points at once (e.g. with SIMD); the
+  /// default implementations loop over inTesla/inTeslaUnchecked.
+  virtual void inTeslaBatch (const GlobalPoint* gp, GlobalVector* b, unsigned int n) const;
+
+  virtual void inTeslaUncheckedBatch (const GlobalPoint* gp, GlobalVector* b, unsigned int n) const;
   
   /// The nominal field value for this map in kGauss
   int nominalValue() const {  
@@ -19,6 +19,14 @@ MagneticField::MagneticField(const MagneticField& orig) : nominalValueCompiuted(
 
 MagneticField::~MagneticField(){}
 
+void MagneticField::inTeslaBatch(const GlobalPoint* gp, GlobalVector* b, unsigned int n) const {
+  for (unsigned int i=0; i<n; ++i) b[i] = inTesla(gp[i]);
+}
+
+void MagneticField::inTeslaUncheckedBatch(const GlobalPoint* gp, GlobalVector* b, unsigned int n) const {
+  for (unsigned int i=0; i<n; ++i) b[i] = inTeslaUnchecked(gp[i]);
+}
+
 int MagneticField::computeNominalValue() const {
   int tmp = int((inTesla(GlobalPoint(0.f,0.f,0.f))).z() * 10.f + 0.5f);
 
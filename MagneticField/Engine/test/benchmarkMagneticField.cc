@@ -0,0 +1,140 @@
+/** \file
+ *  Measure the number of field evaluations per second along helices from
+ *  the interaction region, as queried by a propagator stepping along tracks.
+ *  The same points are evaluated in a single thread and with the tracks
+ *  distributed over the TBB threads of the job, to show the effect of the
+ *  volume caching when several threads query the field at the same time.
+ *  The points of each track are also evaluated together with
+ *  MagneticField::inTeslaBatch.
+ */
+
+#include "FWCore/Framework/interface/Frameworkfwd.h"
+#include "FWCore/Framework/interface/EDAnalyzer.h"
+
+#include "FWCore/Framework/interface/Event.h"
+#include "FWCore/Framework/interface/MakerMacros.h"
+#include "FWCore/ParameterSet/interface/ParameterSet.h"
+
+#include "MagneticField/Engine/interface/MagneticField.h"
+#include "MagneticField/Records/interface/IdealMagneticFieldRecord.h"
+
+#include "FWCore/Framework/interface/ESHandle.h"
+#include "FWCore/Framework/interface/EventSetup.h"
+
+#include "DataFormats/GeometryVector/interface/Pi.h"
+
+#include "tbb/parallel_for.h"
+
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <iostream>
+#include <random>
+#include <vector>
+
+using namespace edm;
+using namespace std;
+
+class benchmarkMagneticField : public edm::EDAnalyzer {
+ public:
+  benchmarkMagneticField(const edm::ParameterSet& pset) {
+    numberOfTracks = pset.getUntrackedParameter<int>("numberOfTracks", 10000);
+    step = pset.getUntrackedParameter<double>("step", 2.);
+    repeat = pset.getUntrackedParameter<int>("repeat", 10);
+    maxR = pset.getUntrackedParameter<double>("maxR", 900.);
+    maxZ = pset.getUntrackedParameter<double>("maxZ", 1600.);
+  }
+
+  ~benchmarkMagneticField(){}
+
+  virtual void analyze(const edm::Event& event, const edm::EventSetup& setup) {
+    ESHandle<MagneticField> magfield;
+    setup.get<IdealMagneticFieldRecord>().get(magfield);
+    const MagneticField* field = magfield.product();
+
+    generateTracks();
+    unsigned long nPoints = 0;
+    for (const auto& track : tracks) nPoints += track.size();
+
+    // keep the results so that the evaluations are not optimized away
+    std::atomic<double> sum{0.};
+
+    auto start = std::chrono::steady_clock::now();
+    double sum1 = 0.;
+    for (int irep=0; irep<repeat; ++irep) {
+      for (const auto& track : tracks) {
+	for (const auto& gp : track) sum1 += field->inTesla(gp).z();
+      }
+    }
+    auto stop = std::chrono::steady_clock::now();
+    double time1 = std::chrono::duration<double>(stop-start).count();
+
+    start = std::chrono::steady_clock::now();
+    double sumB = 0.;
+    vector<GlobalVector> bfield;
+    for (int irep=0; irep<repeat; ++irep) {
+      for (const auto& track : tracks) {
+	bfield.resize(track.size());
+	field->inTeslaBatch(track.data(), bfield.data(), track.size());
+	for (const auto& b : bfield) sumB += b.z();
+      }
+    }
+    stop = std::chrono::steady_clock::now();
+    double timeB = std::chrono::duration<double>(stop-start).count();
+
+    start = std::chrono::steady_clock::now();
+    for (int irep=0; irep<repeat; ++irep) {
+      tbb::parallel_for(size_t(0), tracks.size(), [&](size_t itrack) {
+	  double s = 0.;
+	  for (const auto& gp : tracks[itrack]) s += field->inTesla(gp).z();
+	  double old = sum.load();
+	  while (!sum.compare_exchange_weak(old, old+s));
+	});
+    }
+    stop = std::chrono::steady_clock::now();
+    double timeN = std::chrono::duration<double>(stop-start).count();
+
+    double nEval = double(nPoints)*repeat;
+    cout << "Field evaluations along " << tracks.size() << " tracks, " << nPoints << " points, "
+	 << repeat << " times (checksum " << sum1 << " " << sum.load() << " " << sumB << ")" << endl
+	 << "  single thread: " << nEval/time1 << " evaluations/s" << endl
+	 << "  batch per track, single thread: " << nEval/timeB << " evaluations/s" << endl
+	 << "  all threads:   " << nEval/timeN << " evaluations/s" << endl;
+  }
+
+ private:
+  // helices from the origin with the curvature of a 3.8 T field, stepped until they leave the map
+  void generateTracks() {
+    std::mt19937 rng(1234);
+    std::uniform_real_distribution<double> flat(0.,1.);
+    tracks.clear();
+    tracks.resize(numberOfTracks);
+    for (auto& track : tracks) {
+      double pt = 0.5 + 20.*flat(rng)*flat(rng);
+      double eta = -3. + 6.*flat(rng);
+      double phi = Geom::twoPi()*flat(rng);
+      int charge = flat(rng)<0.5 ? -1 : 1;
+      double radius = pt/(0.0029979*3.8);  // cm
+      double tanLambda = std::sinh(eta);
+      double s = 0.;
+      while (s < 3000.) {
+	double alpha = charge*s/radius;
+	double x = radius*(std::sin(phi+alpha) - std::sin(phi))*charge;
+	double y = -radius*(std::cos(phi+alpha) - std::cos(phi))*charge;
+	double z = s*tanLambda;
+	if (std::abs(z)>maxZ || x*x+y*y>maxR*maxR) break;
+	track.emplace_back(x,y,z);
+	s += step;
+      }
+    }
+  }
+
+  int numberOfTracks;
+  double step;
+  int repeat;
+  double maxR;
+  double maxZ;
+  vector<vector<GlobalPoint> > tracks;
+};
+
+DEFINE_FWK_MODULE(benchmarkMagneticField);
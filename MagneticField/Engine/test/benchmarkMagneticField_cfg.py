@@ -0,0 +1,27 @@
+#
+# Field evaluations per second along tracks, in one and in several threads:
+#   cmsRun benchmarkMagneticField_cfg.py
+
+import FWCore.ParameterSet.Config as cms
+
+process = cms.Process("MAGNETICFIELDBENCHMARK")
+
+process.source = cms.Source("EmptySource")
+process.maxEvents = cms.untracked.PSet(
+    input = cms.untracked.int32(1)
+)
+process.options = cms.untracked.PSet(
+    numberOfThreads = cms.untracked.uint32(8)
+)
+
+process.load("MagneticField.Engine.volumeBasedMagneticField_160812_cfi")
+# the parametrization is used for the tracker region, switch it off to time the map only
+# process.VolumeBasedMagneticFieldESProducer.useParametrizedTrackerField = False
+
+process.benchmarkField = cms.EDAnalyzer("benchmarkMagneticField",
+    numberOfTracks = cms.untracked.int32(10000),
+    step = cms.untracked.double(2.),
+    repeat = cms.untracked.int32(10)
+)
+
+process.p1 = cms.Path(process.benchmarkField)
@@ -57,6 +57,12 @@ std::unique_ptr<MagneticField> VolumeBasedMagneticFieldESProducer::produce(const
   if (!conf.gridFiles.empty()) {
     builder.setGridFiles(conf.gridFiles);
   }
+
+  // Read the grid tables from a packed file, if given
+  std::string packedGridFile = pset.getUntrackedParameter<std::string>("packedGridFile", "");
+  if (!packedGridFile.empty()) {
+    builder.setPackedGridFile(packedGridFile);
+  }
   
   builder.build(*cpv);
 
@@ -129,6 +129,12 @@ std::unique_ptr<MagneticField> VolumeBasedMagneticFieldESProducerFromDB::produce
       builder.setGridFiles(conf->gridFiles);
     }
 
+    // Read the grid tables from a packed file, if given
+    std::string packedGridFile = pset.getUntrackedParameter<std::string>("packedGridFile", "");
+    if (!packedGridFile.empty()) {
+      builder.setPackedGridFile(packedGridFile);
+    }
+
     // Build the geomeytry (DDDCompactView) from the DB blob
     // (code taken from GeometryReaders/XMLIdealGeometryESSource/src/XMLIdealMagneticFieldGeometryESProducer.cc) 
     edm::ESTransientHandle<FileBlob> gdd;
@@ -28,6 +28,7 @@
 
 #include "MagneticField/Interpolation/interface/MagProviderInterpol.h"
 #include "MagneticField/Interpolation/interface/MFGridFactory.h"
+#include "MagneticField/Interpolation/interface/MFGridPackedFile.h"
 #include "MagneticField/Interpolation/interface/MFGrid.h"
 
 #include "MagneticField/VolumeGeometry/interface/MagVolume6Faces.h"
@@ -530,9 +531,13 @@ void MagGeoBuilderFromDDD::buildInterpolator(const volumeHandle * vol, map<strin
     return;
   }
 
+  // Tables in the packed file are stored with the name of the table set
+  const string packedName = tableSet+"/"+vol->magFile;
+  const bool packed = (thePackedGrids && thePackedGrids->find(packedName).first != nullptr);
+
   string fullPath;
 
-  try {
+  if (!packed) try {
     edm::FileInPath mydata("MagneticField/Interpolation/data/"+tableSet+"/"+vol->magFile);
     fullPath = mydata.fullPath();
   } catch (edm::Exception& exc) {
@@ -563,8 +568,13 @@ void MagGeoBuilderFromDDD::buildInterpolator(const volumeHandle * vol, map<strin
 	rf = GloballyPositioned<float>(GloballyPositioned<float>::PositionType(rot.multiplyInverse(vpos)), vol->placement()->rotation()*rot);
       }
 
-      interpolators[vol->magFile] =
-	MFGridFactory::build( fullPath, rf);
+      if (packed) {
+	interpolators[vol->magFile] =
+	  MFGridFactory::build( thePackedGrids, packedName, rf);
+      } else {
+	interpolators[vol->magFile] =
+	  MFGridFactory::build( fullPath, rf);
+      }
     }
   } catch (MagException& exc) {
     cout << exc.what() << endl;
@@ -703,3 +713,15 @@ void MagGeoBuilderFromDDD::setGridFiles(const TableFileMap& gridFiles){
 }
 
 
+void MagGeoBuilderFromDDD::setPackedGridFile(const string& name){
+  string fullPath = name;
+  if (name[0] != '/') fullPath = edm::FileInPath(name).fullPath();
+  try {
+    thePackedGrids = MFGridPackedFile::open(fullPath);
+  } catch (MagException& exc) {
+    throw cms::Exception("MagneticField") << exc.what();
+  }
+  if (debug) cout << "Using " << thePackedGrids->size() << " grid tables from " << fullPath << endl;
+}
+
+
@@ -23,6 +23,7 @@ class Surface;
 class MagBLayer;
 class MagESector;
 class MagVolume6Faces;
+class MFGridPackedFile;
 namespace magneticfield {
   class VolumeBasedMagneticFieldESProducer;
   class VolumeBasedMagneticFieldESProducerFromDB;
@@ -45,6 +46,12 @@ public:
 
   void setGridFiles(const magneticfield::TableFileMap& gridFiles);
 
+  /// Take the grid tables from a packed file (see MFGridPackedFile), mapped
+  /// in memory and shared with the other processes reading it. Tables missing
+  /// from it are read from their own files.
+  /// A relative name is looked up with FileInPath.
+  void setPackedGridFile(const std::string& name);
+
   /// Get barrel layers
   std::vector<MagBLayer*> barrelLayers() const;
 
@@ -130,6 +137,8 @@ private:
   std::map<int, double> theScalingFactors;
   const magneticfield::TableFileMap* theGridFiles; // Non-owned pointer assumed to be valid until build() is called 
 
+  std::shared_ptr<const MFGridPackedFile> thePackedGrids;
+
   static bool debug;
 
 };
@@ -8,8 +8,11 @@
  *  \author T. Todorov
  */
 
+#include <memory>
 #include <string>
 class MFGrid;
+class MFGridPackedFile;
+class binary_ifstream;
 template <class T> class GloballyPositioned;
 
 class MFGridFactory {
@@ -22,6 +25,15 @@ public:
   static MFGrid* build(const std::string& name, const GloballyPositioned<float>& vol,
 		       double phiMin, double phiMax);
 
+  /// Build interpolator for a grid file of a packed file, using the field
+  /// values in place; returns nullptr if the file is not in the pack
+  static MFGrid* build(const std::shared_ptr<const MFGridPackedFile>& pack,
+		       const std::string& name, const GloballyPositioned<float>& vol);
+
+private:
+
+  static MFGrid* build(binary_ifstream& inFile, const GloballyPositioned<float>& vol);
+
 };
 
 #endif
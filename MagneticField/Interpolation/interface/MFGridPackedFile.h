@@ -0,0 +1,52 @@
+#ifndef MFGridPackedFile_h
+#define MFGridPackedFile_h
+
+/** \class MFGridPackedFile
+ *
+ *  All the binary grid files of one or more table sets packed in a single
+ *  file, which is mapped read-only in memory. The field values of the grids
+ *  are used in place (see MFGridFactory::build), so that the processes running
+ *  on a node share one copy of the tables through the page cache instead of
+ *  reading them into their own memory.
+ *
+ *  Layout: "MFGRIDPK", version, number of files, then for each file the
+ *  length of its name, its name, the offset and size of its content; the
+ *  contents follow, unchanged, each starting at a multiple of 64 bytes.
+ */
+
+#include <map>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+class MFGridPackedFile {
+public:
+
+  /// Map the packed file; a file already mapped by this process is shared.
+  static std::shared_ptr<const MFGridPackedFile> open(const std::string& name);
+
+  /// Write a packed file with the given files of directory dir, stored under
+  /// their names relative to it (e.g. "grid_160812_3_8t/s01/grid.1.bin").
+  static void write(const std::string& name, const std::string& dir,
+		    const std::vector<std::string>& files);
+
+  ~MFGridPackedFile();
+
+  /// Content of a packed file, {nullptr, 0} if it is not there
+  std::pair<const char*, size_t> find(const std::string& name) const;
+
+  size_t size() const {return entries_.size();}
+
+  const std::string& name() const {return name_;}
+
+private:
+  explicit MFGridPackedFile(const std::string& name);
+
+  std::string name_;
+  const char* base_;
+  size_t length_;
+  std::map<std::string, std::pair<size_t, size_t> > entries_; // offset, size
+};
+
+#endif
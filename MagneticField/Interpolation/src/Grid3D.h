@@ -11,6 +11,7 @@
 #include "DataFormats/GeometryVector/interface/Basic3DVector.h"
 // #include "DataFormats/Math/interface/SIMDVec.h"
 #include "Grid1D.h"
+#include <memory>
 #include <vector>
 #include "FWCore/Utilities/interface/Visibility.h"
 
@@ -24,6 +25,8 @@ struct BStorageArray {
 
   float v[3];
 };
+// the values are used in place from the binary files mapped in memory
+static_assert(sizeof(BStorageArray)==3*sizeof(float), "BStorageArray must match the layout of the grid files");
 
 class dso_internal Grid3D {
 public:
@@ -37,16 +40,25 @@ public:
   //using BVector =  ValueType;
   using Container = std::vector<BVector>;
 
-  Grid3D() {}
+  Grid3D() : external_(nullptr) {}
 
   Grid3D( const Grid1D& ga, const Grid1D& gb, const Grid1D& gc,
 	  std::vector<BVector>& data) : 
-    grida_(ga), gridb_(gb), gridc_(gc) {
+    grida_(ga), gridb_(gb), gridc_(gc), external_(nullptr) {
      data_.swap(data);
      stride1_ = gridb_.nodes() * gridc_.nodes();
      stride2_ = gridc_.nodes();
   }
 
+  /// Grid on field values stored elsewhere, e.g. in a memory-mapped packed
+  /// file (see MFGridPackedFile); owner keeps them alive with the grid.
+  Grid3D( const Grid1D& ga, const Grid1D& gb, const Grid1D& gc,
+	  const BVector* data, std::shared_ptr<const void> owner) : 
+    grida_(ga), gridb_(gb), gridc_(gc), external_(data), owner_(std::move(owner)) {
+     stride1_ = gridb_.nodes() * gridc_.nodes();
+     stride2_ = gridc_.nodes();
+  }
+
 
   //  Grid3D( const Grid1D& ga, const Grid1D& gb, const Grid1D& gc,
   //	  std::vector<ValueType> const & data);
@@ -57,7 +69,8 @@ public:
   int stride2() const { return stride2_;}
   int stride3() const { return 1;}
   ValueType operator()(int i) const {
-    return ValueType(data_[i][0],data_[i][1],data_[i][2]);
+    const BVector& b = (external_ ? external_[i] : data_[i]);
+    return ValueType(b[0],b[1],b[2]);
   }
 
   ValueType operator()(int i, int j, int k) const {
@@ -68,7 +81,8 @@ public:
   const Grid1D& gridb() const {return gridb_;}
   const Grid1D& gridc() const {return gridc_;}
 
-  const Container & data() const {return data_;}
+  /// Number of field values
+  size_t size() const {return size_t(grida_.nodes())*gridb_.nodes()*gridc_.nodes();}
 
   void dump() const;
 
@@ -79,6 +93,8 @@ private:
   Grid1D gridc_;
 
   Container data_;
+  const BVector* external_; // used instead of data_ if set
+  std::shared_ptr<const void> owner_;
 
   int stride1_;
   int stride2_;
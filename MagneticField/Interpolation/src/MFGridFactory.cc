@@ -1,4 +1,5 @@
 #include "MagneticField/Interpolation/interface/MFGridFactory.h"
+#include "MagneticField/Interpolation/interface/MFGridPackedFile.h"
 #include "binary_ifstream.h"
 #include "DataFormats/GeometrySurface/interface/GloballyPositioned.h"
 
@@ -15,6 +16,21 @@ using namespace std;
 
 MFGrid* MFGridFactory::build(const string& name, const GloballyPositioned<float>& vol) {
   binary_ifstream inFile(name);
+  MFGrid* result = build(inFile, vol);
+  inFile.close();
+  return result;
+}
+
+MFGrid* MFGridFactory::build(const std::shared_ptr<const MFGridPackedFile>& pack,
+			     const string& name, const GloballyPositioned<float>& vol) {
+  auto content = pack->find(name);
+  if (content.first == nullptr) return nullptr;
+  // the grids keep the packed file mapped as long as they use its values
+  binary_ifstream inFile(content.first, content.second, pack);
+  return build(inFile, vol);
+}
+
+MFGrid* MFGridFactory::build(binary_ifstream& inFile, const GloballyPositioned<float>& vol) {
   int gridType;
   inFile >> gridType;
 
@@ -44,7 +60,6 @@ MFGrid* MFGridFactory::build(const string& name, const GloballyPositioned<float>
     result = nullptr;
     break;
   }
-  inFile.close();
   return result;
 }
 
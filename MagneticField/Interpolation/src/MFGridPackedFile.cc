@@ -0,0 +1,141 @@
+#include "MagneticField/Interpolation/interface/MFGridPackedFile.h"
+#include "MagneticField/VolumeGeometry/interface/MagExceptions.h"
+
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <mutex>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+using namespace std;
+
+namespace {
+  const char magic[8] = {'M','F','G','R','I','D','P','K'};
+  const uint32_t version = 1;
+  const size_t alignment = 64;
+
+  template <typename T> T readValue(const char* base, size_t length, size_t& pos) {
+    T value;
+    if (pos + sizeof(T) > length) throw MagException("MFGridPackedFile: truncated file index");
+    memcpy(&value, base + pos, sizeof(T));
+    pos += sizeof(T);
+    return value;
+  }
+
+  template <typename T> void writeValue(ofstream& out, T value) {
+    out.write(reinterpret_cast<const char*>(&value), sizeof(T));
+  }
+}
+
+
+shared_ptr<const MFGridPackedFile> MFGridPackedFile::open(const string& name) {
+  // files mapped by this process, so that all the maps built from the same
+  // file (e.g. for different currents) use the same mapping
+  static mutex mapsMutex;
+  static map<string, weak_ptr<const MFGridPackedFile> > maps;
+
+  lock_guard<mutex> guard(mapsMutex);
+  shared_ptr<const MFGridPackedFile> result = maps[name].lock();
+  if (!result) {
+    result.reset(new MFGridPackedFile(name));
+    maps[name] = result;
+  }
+  return result;
+}
+
+
+MFGridPackedFile::MFGridPackedFile(const string& name) :
+  name_(name), base_(nullptr), length_(0)
+{
+  int fd = ::open(name.c_str(), O_RDONLY);
+  if (fd < 0) throw MagException(("MFGridPackedFile: cannot open " + name).c_str());
+  struct stat st;
+  if (fstat(fd, &st) != 0 || st.st_size == 0) {
+    ::close(fd);
+    throw MagException(("MFGridPackedFile: cannot read " + name).c_str());
+  }
+  length_ = st.st_size;
+  void* p = mmap(nullptr, length_, PROT_READ, MAP_SHARED, fd, 0);
+  ::close(fd); // the mapping keeps the file open
+  if (p == MAP_FAILED) throw MagException(("MFGridPackedFile: cannot map " + name).c_str());
+  base_ = static_cast<const char*>(p);
+
+  if (length_ < sizeof(magic) || memcmp(base_, magic, sizeof(magic)) != 0) {
+    munmap(const_cast<char*>(base_), length_);
+    throw MagException(("MFGridPackedFile: " + name + " is not a packed grid file").c_str());
+  }
+  try {
+    size_t pos = sizeof(magic);
+    if (readValue<uint32_t>(base_, length_, pos) != version)
+      throw MagException(("MFGridPackedFile: unsupported version of " + name).c_str());
+    uint32_t nEntries = readValue<uint32_t>(base_, length_, pos);
+    for (uint32_t i = 0; i < nEntries; ++i) {
+      uint32_t nameLength = readValue<uint32_t>(base_, length_, pos);
+      if (pos + nameLength > length_) throw MagException("MFGridPackedFile: truncated file index");
+      string entry(base_ + pos, nameLength);
+      pos += nameLength;
+      uint64_t offset = readValue<uint64_t>(base_, length_, pos);
+      uint64_t size = readValue<uint64_t>(base_, length_, pos);
+      if (offset + size > length_) throw MagException(("MFGridPackedFile: truncated content of " + entry).c_str());
+      entries_[entry] = make_pair(size_t(offset), size_t(size));
+    }
+  } catch (...) {
+    munmap(const_cast<char*>(base_), length_);
+    throw;
+  }
+}
+
+
+MFGridPackedFile::~MFGridPackedFile() {
+  munmap(const_cast<char*>(base_), length_);
+}
+
+
+pair<const char*, size_t> MFGridPackedFile::find(const string& name) const {
+  auto entry = entries_.find(name);
+  if (entry == entries_.end()) return make_pair(nullptr, size_t(0));
+  return make_pair(base_ + entry->second.first, entry->second.second);
+}
+
+
+void MFGridPackedFile::write(const string& name, const string& dir, const vector<string>& files) {
+  // size of the header and index, to place the contents after it
+  size_t indexSize = sizeof(magic) + 2*sizeof(uint32_t);
+  vector<uint64_t> sizes;
+  for (const auto& file : files) {
+    indexSize += sizeof(uint32_t) + file.size() + 2*sizeof(uint64_t);
+    ifstream in(dir + "/" + file, ios::binary | ios::ate);
+    if (!in) throw MagException(("MFGridPackedFile: cannot read " + dir + "/" + file).c_str());
+    sizes.push_back(in.tellg());
+  }
+
+  vector<uint64_t> offsets;
+  uint64_t offset = indexSize;
+  for (auto size : sizes) {
+    offset = (offset + alignment - 1) / alignment * alignment;
+    offsets.push_back(offset);
+    offset += size;
+  }
+
+  ofstream out(name, ios::binary);
+  if (!out) throw MagException(("MFGridPackedFile: cannot write " + name).c_str());
+  out.write(magic, sizeof(magic));
+  writeValue<uint32_t>(out, version);
+  writeValue<uint32_t>(out, files.size());
+  for (size_t i = 0; i < files.size(); ++i) {
+    writeValue<uint32_t>(out, files[i].size());
+    out.write(files[i].data(), files[i].size());
+    writeValue<uint64_t>(out, offsets[i]);
+    writeValue<uint64_t>(out, sizes[i]);
+  }
+  for (size_t i = 0; i < files.size(); ++i) {
+    while (uint64_t(out.tellp()) < offsets[i]) out.put('\0');
+    ifstream in(dir + "/" + files[i], ios::binary);
+    out << in.rdbuf();
+  }
+  if (!out) throw MagException(("MFGridPackedFile: error writing " + name).c_str());
+}
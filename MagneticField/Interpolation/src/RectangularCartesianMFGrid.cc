@@ -35,12 +35,16 @@ RectangularCartesianMFGrid::RectangularCartesianMFGrid( binary_ifstream& inFile,
   inFile >> stepx    >> stepy    >> stepz;
 
   vector<BVector> fieldValues;
-  float Bx, By, Bz;
   int nLines = n1*n2*n3;
-  fieldValues.reserve(nLines);
-  for (int iLine=0; iLine<nLines; ++iLine){
-    inFile >> Bx >> By >> Bz;
-    fieldValues.push_back(BVector(Bx,By,Bz));
+  // use the values in place if the file is mapped in memory and they are aligned
+  const BVector* mappedValues = reinterpret_cast<const BVector*>(inFile.mapped(nLines*sizeof(BVector), alignof(BVector)));
+  if (mappedValues == nullptr) {
+    float Bx, By, Bz;
+    fieldValues.reserve(nLines);
+    for (int iLine=0; iLine<nLines; ++iLine){
+      inFile >> Bx >> By >> Bz;
+      fieldValues.push_back(BVector(Bx,By,Bz));
+    }
   }
   // check completeness
   string lastEntry;
@@ -55,7 +59,11 @@ RectangularCartesianMFGrid::RectangularCartesianMFGrid( binary_ifstream& inFile,
   Grid1D gridX( lrefp.x(), lrefp.x() + stepx*(n1-1), n1);
   Grid1D gridY( lrefp.y(), lrefp.y() + stepy*(n2-1), n2);
   Grid1D gridZ( lrefp.z(), lrefp.z() + stepz*(n3-1), n3);
-  grid_ = GridType( gridX, gridY, gridZ, fieldValues);
+  if (mappedValues != nullptr) {
+    grid_ = GridType( gridX, gridY, gridZ, mappedValues, inFile.owner());
+  } else {
+    grid_ = GridType( gridX, gridY, gridZ, fieldValues);
+  }
   
   // Activate/deactivate timers
 //   static SimpleConfigurable<bool> timerOn(false,"MFGrid:timing");
@@ -82,7 +90,7 @@ void RectangularCartesianMFGrid::dump() const
        << grid_.grida().step() << " " << grid_.gridb().step() << " " << grid_.gridc().step() << endl;
 
 
-  cout << "Dumping " << grid_.data().size() << " field values " << endl;
+  cout << "Dumping " << grid_.size() << " field values " << endl;
   // grid_.dump();
 }
 
@@ -62,18 +62,23 @@ TrapezoidalCartesianMFGrid::TrapezoidalCartesianMFGrid( binary_ifstream& inFile,
   inFile >> easya >> easyb >> easyc;
 
   vector<BVector> fieldValues;
-  float Bx, By, Bz;
   int nLines = n1*n2*n3;
-  fieldValues.reserve(nLines);
-  for (int iLine=0; iLine<nLines; ++iLine){
-    inFile >> Bx >> By >> Bz;
-    if (convertToLocal) {
-      // Preserve double precision!
-      Vector3DBase<double, LocalTag>  lB = frame().toLocal(Vector3DBase<double, GlobalTag>(Bx,By,Bz));
-      fieldValues.push_back(BVector(lB.x(), lB.y(), lB.z()));
-      
-    } else {
-      fieldValues.push_back(BVector(Bx,By,Bz));
+  // use the values in place if the file is mapped in memory, aligned and needs no conversion
+  const BVector* mappedValues = nullptr;
+  if (!convertToLocal) mappedValues = reinterpret_cast<const BVector*>(inFile.mapped(nLines*sizeof(BVector), alignof(BVector)));
+  if (mappedValues == nullptr) {
+    float Bx, By, Bz;
+    fieldValues.reserve(nLines);
+    for (int iLine=0; iLine<nLines; ++iLine){
+      inFile >> Bx >> By >> Bz;
+      if (convertToLocal) {
+        // Preserve double precision!
+        Vector3DBase<double, LocalTag>  lB = frame().toLocal(Vector3DBase<double, GlobalTag>(Bx,By,Bz));
+        fieldValues.push_back(BVector(lB.x(), lB.y(), lB.z()));
+        
+      } else {
+        fieldValues.push_back(BVector(Bx,By,Bz));
+      }
     }
   }
   // check completeness
@@ -169,7 +174,10 @@ TrapezoidalCartesianMFGrid::TrapezoidalCartesianMFGrid( binary_ifstream& inFile,
        << (frame().toGlobal(LocalPoint(0,0,gridZ.upper()))).z() << endl;
 #endif
 
-  if (increasingAlongX) {
+  if (mappedValues != nullptr) {
+    if (increasingAlongX) grid_ = GridType( gridX, gridY, gridZ, mappedValues, inFile.owner());
+    else                  grid_ = GridType( gridY, gridX, gridZ, mappedValues, inFile.owner());
+  } else if (increasingAlongX) {
     grid_ = GridType( gridX, gridY, gridZ, fieldValues);
   } else {
     // The reason why gridY and gridX have to be exchanged is because Grid3D::index(i,j,k)
@@ -205,7 +213,7 @@ void TrapezoidalCartesianMFGrid::dump() const
        << grid_.grida().step() << " " << grid_.gridb().step() << " " << grid_.gridc().step() << endl;
 
 
-  cout << "Dumping " << grid_.data().size() << " field values " << endl;
+  cout << "Dumping " << grid_.size() << " field values " << endl;
   // grid_.dump();
   
 
@@ -47,12 +47,16 @@ TrapezoidalCylindricalMFGrid::TrapezoidalCylindricalMFGrid( binary_ifstream& inF
   inFile >> easya >> easyb >> easyc;
 
   vector<BVector> fieldValues;
-  float Bx, By, Bz;
   int nLines = n1*n2*n3;
-  fieldValues.reserve(nLines);
-  for (int iLine=0; iLine<nLines; ++iLine){
-    inFile >> Bx >> By >> Bz;
-    fieldValues.push_back(BVector(Bx,By,Bz));
+  // use the values in place if the file is mapped in memory and they are aligned
+  const BVector* mappedValues = reinterpret_cast<const BVector*>(inFile.mapped(nLines*sizeof(BVector), alignof(BVector)));
+  if (mappedValues == nullptr) {
+    float Bx, By, Bz;
+    fieldValues.reserve(nLines);
+    for (int iLine=0; iLine<nLines; ++iLine){
+      inFile >> Bx >> By >> Bz;
+      fieldValues.push_back(BVector(Bx,By,Bz));
+    }
   }
   // check completeness
   string lastEntry;
@@ -121,7 +125,11 @@ TrapezoidalCylindricalMFGrid::TrapezoidalCylindricalMFGrid( binary_ifstream& inF
   Grid1D gridX( xrec, xrec + (a+b)/2., n1);
   Grid1D gridY( yref, yref + stepy*(n2-1), n2);
   Grid1D gridZ( yrec, yrec + h, n3);
-  grid_ = GridType( gridX, gridY, gridZ, fieldValues);
+  if (mappedValues != nullptr) {
+    grid_ = GridType( gridX, gridY, gridZ, mappedValues, inFile.owner());
+  } else {
+    grid_ = GridType( gridX, gridY, gridZ, fieldValues);
+  }
     
   // Activate/deactivate timers
 //   static SimpleConfigurable<bool> timerOn(false,"MFGrid:timing");
@@ -1,20 +1,28 @@
 #include "binary_ifstream.h"
 
+#include <cstdint>
 #include <cstdio>
+#include <cstring>
 #include <iostream>
 
 struct binary_ifstream_error {};
 
-binary_ifstream::binary_ifstream( const char* name) : file_(nullptr)
+binary_ifstream::binary_ifstream( const char* name) :
+    file_(nullptr), mem_(nullptr), size_(0), pos_(0), eof_(false)
 {
     init (name);
 }
 
-binary_ifstream::binary_ifstream( const std::string& name) : file_(nullptr)
+binary_ifstream::binary_ifstream( const std::string& name) :
+    file_(nullptr), mem_(nullptr), size_(0), pos_(0), eof_(false)
 {
     init (name.c_str());
 }
 
+binary_ifstream::binary_ifstream( const char* begin, size_t size, std::shared_ptr<const void> owner) :
+    file_(nullptr), mem_(begin), size_(size), pos_(0), eof_(false), owner_(std::move(owner))
+{}
+
 void binary_ifstream::init( const char* name)
 {
     file_ = fopen( name, "rb");
@@ -33,39 +41,60 @@ void binary_ifstream::close()
 {
     if (file_ != nullptr) fclose( file_);
     file_ = nullptr;
+    mem_ = nullptr;
+    owner_.reset();
 }
 
-binary_ifstream& binary_ifstream::operator>>( char& n) {
-    n = static_cast<char>(fgetc(file_));
-    return *this;
+size_t binary_ifstream::read( void* n, size_t nbytes)
+{
+    if (file_ != nullptr) return fread( n, 1, nbytes, file_);
+    if (mem_ == nullptr) return 0;
+    if (pos_ + nbytes > size_) {
+	nbytes = size_ - pos_;
+	eof_ = true;
+    }
+    memcpy( n, mem_ + pos_, nbytes);
+    pos_ += nbytes;
+    return nbytes;
 }
 
-binary_ifstream& binary_ifstream::operator>>( unsigned char& n) {
-    n = static_cast<unsigned char>(fgetc(file_));
-    return *this;
+const char* binary_ifstream::mapped( size_t nbytes, size_t alignment)
+{
+    if (mem_ == nullptr || pos_ + nbytes > size_) return nullptr;
+    const char* result = mem_ + pos_;
+    if (reinterpret_cast<uintptr_t>(result) % alignment != 0) return nullptr;
+    pos_ += nbytes;
+    return result;
 }
 
+binary_ifstream& binary_ifstream::operator>>( char& n) {
+    read( &n, 1); return *this;}
+binary_ifstream& binary_ifstream::operator>>( unsigned char& n) {
+    read( &n, 1); return *this;}
+
 binary_ifstream& binary_ifstream::operator>>( short& n) {
-    fread( &n, sizeof(n), 1, file_); return *this;}
+    read( &n, sizeof(n)); return *this;}
 binary_ifstream& binary_ifstream::operator>>( unsigned short& n) {
-    fread( &n, sizeof(n), 1, file_); return *this;}
+    read( &n, sizeof(n)); return *this;}
 binary_ifstream& binary_ifstream::operator>>( int& n) {
-    fread( &n, sizeof(n), 1, file_); return *this;}
+    read( &n, sizeof(n)); return *this;}
 binary_ifstream& binary_ifstream::operator>>( unsigned int& n) {
-    fread( &n, sizeof(n), 1, file_); return *this;}
+    read( &n, sizeof(n)); return *this;}
 
 binary_ifstream& binary_ifstream::operator>>( long& n) {
-    fread( &n, sizeof(n), 1, file_); return *this;}
+    read( &n, sizeof(n)); return *this;}
 binary_ifstream& binary_ifstream::operator>>( unsigned long& n) {
-    fread( &n, sizeof(n), 1, file_); return *this;}
+    read( &n, sizeof(n)); return *this;}
 
 binary_ifstream& binary_ifstream::operator>>( float& n) {
-    fread( &n, sizeof(n), 1, file_); return *this;}
+    read( &n, sizeof(n)); return *this;}
 binary_ifstream& binary_ifstream::operator>>( double& n) {
-    fread( &n, sizeof(n), 1, file_); return *this;}
+    read( &n, sizeof(n)); return *this;}
 
 binary_ifstream& binary_ifstream::operator>>( bool& n) {
-    n = static_cast<bool>(fgetc(file_));
+    char c = 0;
+    read( &c, 1);
+    n = static_cast<bool>(c);
     return *this;
 }
 
@@ -73,7 +102,7 @@ binary_ifstream& binary_ifstream::operator>>( std::string& n) {
   unsigned int nchar;
   (*this) >> nchar;  
   char* tmp = new char[nchar+1];
-  unsigned int nread = fread( tmp, 1, nchar, file_);
+  unsigned int nread = read( tmp, nchar);
   if (nread != nchar) std::cout << "binary_ifstream error: read less then expected " << std::endl;
   n.assign( tmp, nread);
   delete[] tmp;
@@ -87,11 +116,13 @@ bool binary_ifstream::good() const
 
 bool binary_ifstream::eof() const
 {
+    if (file_ == nullptr) return eof_;
     return feof( file_);
 }
 
 bool binary_ifstream::fail() const
 {
+    if (mem_ != nullptr) return false;
     return file_ == nullptr || ferror( file_) != 0;
 }
 
@@ -3,6 +3,7 @@
 
 #include <string>
 #include <cstdio>
+#include <memory>
 #include "FWCore/Utilities/interface/Visibility.h"
 
 class binary_ifstream {
@@ -11,6 +12,10 @@ public:
     explicit binary_ifstream( const char* name);
     explicit binary_ifstream( const std::string& name);
 
+    /// Read from memory, e.g. a file of a MFGridPackedFile; owner keeps the
+    /// memory alive and is handed over to whoever uses it in place
+    binary_ifstream( const char* begin, size_t size, std::shared_ptr<const void> owner);
+
     ~binary_ifstream();
 
     binary_ifstream& operator>>( char& n);
@@ -33,6 +38,13 @@ public:
 
     void close();
 
+    /// When reading from memory, return the address of the next nbytes and
+    /// skip them, so that they can be used in place; nullptr (and nothing
+    /// skipped) if not reading from memory or if the address is not a
+    /// multiple of alignment, in which case the caller must read a copy
+    const char* mapped( size_t nbytes, size_t alignment);
+    const std::shared_ptr<const void>& owner() const {return owner_;}
+
   /// stream state checking
     bool good() const;
     bool eof() const;
@@ -45,7 +57,14 @@ private:
 
     FILE* file_;
 
+    const char* mem_;
+    size_t size_;
+    size_t pos_;
+    bool eof_;
+    std::shared_ptr<const void> owner_;
+
     void init( const char* name);
+    size_t read( void* n, size_t nbytes);
 
 };
 
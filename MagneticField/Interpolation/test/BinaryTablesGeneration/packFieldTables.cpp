@@ -0,0 +1,49 @@
+// Pack the binary grid files of one or more table sets into a single file,
+// to be mapped in memory by the field map builder (see MFGridPackedFile):
+//
+//   packFieldTables <data directory> <output file> <table set> [<table set> ...]
+//
+// e.g. packFieldTables $CMSSW_RELEASE_BASE/external/$SCRAM_ARCH/data/MagneticField/Interpolation/data \
+//        grid_160812.pack grid_160812_3_8t grid_160812_3_5t grid_160812_3t
+
+#include "MagneticField/Interpolation/interface/MFGridPackedFile.h"
+
+#include <algorithm>
+#include <cstring>
+#include <ftw.h>
+#include <iostream>
+#include <string>
+#include <vector>
+
+using namespace std;
+
+namespace {
+  vector<string> files;
+  size_t prefixLength = 0;
+
+  int addFile(const char* path, const struct stat*, int type, struct FTW*) {
+    if (type == FTW_F) files.push_back(string(path + prefixLength));
+    return 0;
+  }
+}
+
+int main(int argc, char* argv[]) {
+  if (argc < 4) {
+    cout << "Usage: " << argv[0] << " <data directory> <output file> <table set> [<table set> ...]" << endl;
+    return 1;
+  }
+  string dir = argv[1];
+  prefixLength = dir.size() + 1;
+  for (int i = 3; i < argc; ++i) {
+    string tableSet = dir + "/" + argv[i];
+    if (nftw(tableSet.c_str(), addFile, 16, FTW_PHYS) != 0) {
+      cout << "Cannot read " << tableSet << endl;
+      return 1;
+    }
+  }
+  sort(files.begin(), files.end());
+
+  MFGridPackedFile::write(argv[2], dir, files);
+  cout << "Packed " << files.size() << " files in " << argv[2] << endl;
+  return 0;
+}
@@ -0,0 +1,81 @@
+// Check that a grid built from a packed file gives the same values as the
+// one built from the original grid file.
+
+#include "MagneticField/Interpolation/interface/MFGridFactory.h"
+#include "MagneticField/Interpolation/interface/MFGridPackedFile.h"
+#include "MagneticField/Interpolation/interface/MFGrid.h"
+#include "DataFormats/GeometrySurface/interface/GloballyPositioned.h"
+
+#include <cassert>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace {
+  template <typename T> void put(std::ofstream& out, T value) {
+    out.write(reinterpret_cast<const char*>(&value), sizeof(T));
+  }
+
+  // a RectangularCartesianMFGrid table in the format read by MFGridFactory
+  void writeGrid(const std::string& name, float scale) {
+    std::ofstream out(name, std::ios::binary);
+    const int n1 = 3, n2 = 4, n3 = 5;
+    put<int>(out, 1);
+    put<int>(out, n1); put<int>(out, n2); put<int>(out, n3);
+    put<double>(out, -10.); put<double>(out, -20.); put<double>(out, 0.);
+    put<double>(out, 10.); put<double>(out, 10.); put<double>(out, 5.);
+    for (int i = 0; i < n1*n2*n3; ++i) {
+      put<float>(out, scale*i); put<float>(out, -scale*i); put<float>(out, 3.8f);
+    }
+    std::string complete = "complete";
+    put<unsigned int>(out, complete.size());
+    out.write(complete.data(), complete.size());
+  }
+}
+
+int main() {
+  std::string dir = "MFGridPackedFile_t_" + std::to_string(getpid());
+  mkdir(dir.c_str(), 0755);
+  mkdir((dir + "/tables").c_str(), 0755);
+  writeGrid(dir + "/tables/grid.1.bin", 0.01f);
+  writeGrid(dir + "/tables/grid.2.bin", 0.02f);
+  MFGridPackedFile::write(dir + "/tables.pack", dir, {"tables/grid.1.bin", "tables/grid.2.bin"});
+
+  GloballyPositioned<float> frame(GloballyPositioned<float>::PositionType(0,0,0),
+				  GloballyPositioned<float>::RotationType());
+
+  bool ok = true;
+  {
+    std::shared_ptr<const MFGridPackedFile> pack = MFGridPackedFile::open(dir + "/tables.pack");
+    ok &= (pack->size() == 2);
+    ok &= (MFGridPackedFile::open(dir + "/tables.pack") == pack); // shared mapping
+    ok &= (MFGridFactory::build(pack, "tables/grid.3.bin", frame) == nullptr);
+
+    for (std::string name : {"tables/grid.1.bin", "tables/grid.2.bin"}) {
+      std::unique_ptr<MFGrid> fromFile(MFGridFactory::build(dir + "/" + name, frame));
+      std::unique_ptr<MFGrid> fromPack(MFGridFactory::build(pack, name, frame));
+      ok &= (fromFile && fromPack);
+      if (!ok) break;
+      Dimensions d = fromFile->dimensions();
+      for (int a = 0; a < d.w; ++a)
+	for (int b = 0; b < d.h; ++b)
+	  for (int c = 0; c < d.d; ++c)
+	    ok &= (fromFile->nodeValue(a,b,c) == fromPack->nodeValue(a,b,c));
+      MFGrid::LocalPoint p(-2.5, 3.3, 7.1);
+      ok &= (fromFile->valueInTesla(p) == fromPack->valueInTesla(p));
+    }
+    pack.reset();
+  }
+
+  for (std::string name : {"/tables/grid.1.bin", "/tables/grid.2.bin", "/tables.pack"}) unlink((dir + name).c_str());
+  rmdir((dir + "/tables").c_str());
+  rmdir(dir.c_str());
+
+  std::cout << "MFGridPackedFile_t " << (ok ? "OK" : "FAILED") << std::endl;
+  assert(ok);
+  return ok ? 0 : 1;
+}
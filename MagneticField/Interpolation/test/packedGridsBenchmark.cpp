@@ -0,0 +1,72 @@
+// Time the construction of the interpolators of a table set from the
+// individual grid files and from a packed file, and check that they give
+// the same field values at their nodes:
+//
+//   packedGridsBenchmark <data directory> <packed file> <table set>
+//
+// The grids are built in the reference frame of the tables (no rotation), as
+// for the master sector. Run it twice to see the effect of the page cache.
+
+#include "MagneticField/Interpolation/interface/MFGridFactory.h"
+#include "MagneticField/Interpolation/interface/MFGridPackedFile.h"
+#include "MagneticField/Interpolation/interface/MFGrid.h"
+#include "DataFormats/GeometrySurface/interface/GloballyPositioned.h"
+
+#include <chrono>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+using namespace std;
+
+int main(int argc, char* argv[]) {
+  if (argc != 4) {
+    cout << "Usage: " << argv[0] << " <data directory> <packed file> <table set>" << endl;
+    return 1;
+  }
+  string dir = argv[1];
+  string tableSet = argv[3];
+  GloballyPositioned<float> frame(GloballyPositioned<float>::PositionType(0,0,0),
+				  GloballyPositioned<float>::RotationType());
+
+  // the files of the table set in the pack
+  auto start = chrono::steady_clock::now();
+  shared_ptr<const MFGridPackedFile> pack = MFGridPackedFile::open(argv[2]);
+  vector<unique_ptr<MFGrid> > packedGrids;
+  vector<string> names;
+  for (int part = 1; part <= 2; ++part) {
+    for (int volume = 1; volume <= 464; ++volume) {
+      string name = tableSet + "/s01/grid." + to_string(volume + 1000*part) + ".bin";
+      MFGrid* grid = MFGridFactory::build(pack, name, frame);
+      if (grid == nullptr) continue;
+      packedGrids.emplace_back(grid);
+      names.push_back(name);
+    }
+  }
+  double packedTime = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+
+  start = chrono::steady_clock::now();
+  vector<unique_ptr<MFGrid> > fileGrids;
+  for (const auto& name : names) fileGrids.emplace_back(MFGridFactory::build(dir + "/" + name, frame));
+  double fileTime = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+
+  unsigned long nNodes = 0, nDifferent = 0;
+  for (size_t i = 0; i < names.size(); ++i) {
+    Dimensions d = fileGrids[i]->dimensions();
+    for (int a = 0; a < d.w; ++a) {
+      for (int b = 0; b < d.h; ++b) {
+	for (int c = 0; c < d.d; ++c) {
+	  ++nNodes;
+	  if (!(fileGrids[i]->nodeValue(a,b,c) == packedGrids[i]->nodeValue(a,b,c))) ++nDifferent;
+	}
+      }
+    }
+  }
+
+  cout << names.size() << " grids, " << nNodes << " nodes" << endl
+       << "  from the grid files:  " << fileTime << " s" << endl
+       << "  from the packed file: " << packedTime << " s" << endl
+       << "  nodes with different values: " << nDifferent << endl;
+  return nDifferent == 0 ? 0 : 1;
+}
@@ -76,7 +76,8 @@ namespace magfieldparam {
     
     
   // in meters and T  (Br needs to be multiplied by r)
-    void compute(T r2, T z, T& Br, T& Bz) const {
+  // always inlined, so that loops over points calling it can be vectorized
+    __attribute__((always_inline)) void compute(T r2, T z, T& Br, T& Bz) const {
       using namespace  bcylDetails;
       //  if (r<1.15&&fabs(z)<2.8) // NOTE: check omitted, is done already by the wrapper! (NA)
       z-=pars.prm[3];                    // max Bz point is shifted in z
@@ -1,5 +1,6 @@
 #include "BFit.h"
 #include <cstring>
+#include <algorithm>
 
 using namespace std;
 using namespace magfieldparam;
@@ -95,6 +96,12 @@ BFit::BFit()
    Br_base->SetOFF(0);                      //"0" term is ignored
    
    delete P_base;
+
+   Bz_nr = Bz_base->GetMaxRPow()+1;
+   Bz_nz = Bz_base->GetMaxZPow()+1;
+   Br_nr = Br_base->GetMaxRPow()+1;
+   Br_nz = Br_base->GetMaxZPow()+1;
+   FillTables();
 }
 
 //_______________________________________________________________________________
@@ -133,6 +140,29 @@ void BFit::SetField(double B)
       C[jj] = B*((C_4[jj]*B2 + C_2[jj])*B2 + C_0[jj]);
    }
 #endif
+   FillTables();
+}
+
+//_______________________________________________________________________________
+void BFit::FillTables()
+{
+//Fill the tables of coefficients used by the batch GetField from the
+//current expansion coefficients
+//
+   Bz_base->GetCoeffTable(C,   Bz_tab);
+   Br_base->GetCoeffTable(C+1, Br_tab);
+   Bz_tabf.assign(Bz_tab.begin(), Bz_tab.end());
+   Br_tabf.assign(Br_tab.begin(), Br_tab.end());
+
+   //number of coefficients up to the last non-zero one in each row
+   Bz_len.assign(Bz_nr, 0);
+   for (int ir = 0; ir < Bz_nr; ++ir) {
+      for (int iz = 0; iz < Bz_nz; ++iz) if (Bz_tab[ir*Bz_nz+iz] != 0.) Bz_len[ir] = iz+1;
+   }
+   Br_len.assign(Br_nr, 0);
+   for (int ir = 0; ir < Br_nr; ++ir) {
+      for (int iz = 0; iz < Br_nz; ++iz) if (Br_tab[ir*Br_nz+iz] != 0.) Br_len[ir] = iz+1;
+   }
 }
 
 //_______________________________________________________________________________
@@ -149,3 +179,60 @@ void BFit::GetField(double r,   double z,   double phi,
    Br   = Br_base->GetSVal(r, zc, C+1);
    Bphi = 0.;
 }
+
+//_______________________________________________________________________________
+namespace {
+   const unsigned NChunk = 64; //points evaluated together
+
+   //sum of tab[i*nz+j]*r^i*z^j for n <= NChunk points, Horner scheme.
+   //Only the first len[i] coefficients of the row i are used, the others
+   //are 0 (the tables are triangular and half of the rows are empty)
+   template <typename T>
+   void Horner2D(unsigned n, const T *r, const T *z,
+                 const T *tab, const int *len, int nr, int nz, T *rez)
+   {
+      T term[NChunk];
+      unsigned k;
+      for (k = 0; k < n; ++k) rez[k] = 0;
+      for (int ir = nr-1; ir >= 0; --ir) {
+         if (len[ir] == 0) {
+            for (k = 0; k < n; ++k) rez[k] *= r[k];
+            continue;
+         }
+         const T *c = tab + ir*nz;
+         for (k = 0; k < n; ++k) term[k] = c[len[ir]-1];
+         for (int iz = len[ir]-2; iz >= 0; --iz) {
+            const T cz = c[iz];
+            for (k = 0; k < n; ++k) term[k] = term[k]*z[k] + cz;
+         }
+         for (k = 0; k < n; ++k) rez[k] = rez[k]*r[k] + term[k];
+      }
+   }
+}
+
+//_______________________________________________________________________________
+template <typename T>
+void BFit::GetFieldBatch(unsigned n, const T *r, const T *z, T *Br, T *Bz,
+                         const std::vector<T> &bz_tab, const std::vector<T> &br_tab) const
+{
+   T zc[NChunk];
+   const T dz = dZ;
+   for (unsigned ibeg = 0; ibeg < n; ibeg += NChunk) {
+      const unsigned m = std::min(NChunk, n-ibeg);
+      for (unsigned k = 0; k < m; ++k) zc[k] = z[ibeg+k] + dz;
+      Horner2D(m, r+ibeg, zc, bz_tab.data(), Bz_len.data(), Bz_nr, Bz_nz, Bz+ibeg);
+      Horner2D(m, r+ibeg, zc, br_tab.data(), Br_len.data(), Br_nr, Br_nz, Br+ibeg);
+   }
+}
+
+//_______________________________________________________________________________
+void BFit::GetField(unsigned n, const double *r, const double *z, double *Br, double *Bz) const
+{
+   GetFieldBatch(n, r, z, Br, Bz, Bz_tab, Br_tab);
+}
+
+//_______________________________________________________________________________
+void BFit::GetField(unsigned n, const float *r, const float *z, float *Br, float *Bz) const
+{
+   GetFieldBatch(n, r, z, Br, Bz, Bz_tabf, Br_tabf);
+}
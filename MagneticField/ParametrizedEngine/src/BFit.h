@@ -10,6 +10,8 @@
 
 #include "rz_poly.h"
 
+#include <vector>
+
 
 
 //_______________________________________________________________________________
@@ -35,6 +37,19 @@ private:
 
    rz_poly *Bz_base;
    rz_poly *Br_base;
+
+   //Coefficients of r^i*z^j (index i*nz+j) in Bz and Br, filled by SetField
+   //for the batch evaluation
+   int Bz_nr, Bz_nz, Br_nr, Br_nz;
+   std::vector<double> Bz_tab, Br_tab;
+   std::vector<float>  Bz_tabf, Br_tabf;
+   std::vector<int>    Bz_len, Br_len; //used length of each row
+
+   void FillTables();
+
+   template <typename T>
+   void GetFieldBatch(unsigned n, const T *r, const T *z, T *Br, T *Bz,
+                      const std::vector<T> &bz_tab, const std::vector<T> &br_tab) const;
  
 public:
 
@@ -44,6 +59,16 @@ public:
    void SetField(double B);
    void GetField(double r,   double z,   double phi,
                  double &Br, double &Bz, double &Bphi) const;
+
+   //Field components in n points (r[k],z[k]), Bphi=0. The polynomials are
+   //evaluated with the Horner scheme over arrays of points, so that the loops
+   //are vectorized, and no state is modified (the single point GetField
+   //caches the powers of r and z in the rz_poly objects).
+   //The double version agrees with GetField to about 1e-14 T, the float one
+   //to better than 1e-6 T inside the validity region of the fit
+   //(r<1.9m, |z|<3.5m, |z|+2.5r<6.7m).
+   void GetField(unsigned n, const double *r, const double *z, double *Br, double *Bz) const;
+   void GetField(unsigned n, const float  *r, const float  *z, float  *Br, float  *Bz) const;
 };
 }
 
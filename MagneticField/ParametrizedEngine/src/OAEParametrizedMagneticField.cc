@@ -9,6 +9,8 @@
 
 #include "TkBfield.h"
 
+#include <algorithm>
+
 using namespace std;
 using namespace magfieldparam;
 
@@ -49,6 +51,34 @@ OAEParametrizedMagneticField::inTeslaUnchecked(const GlobalPoint& gp) const {
 }
 
 
+void
+OAEParametrizedMagneticField::inTeslaBatch(const GlobalPoint* gp, GlobalVector* b, unsigned int n) const {
+  inTeslaUncheckedBatch(gp, b, n);
+  for (unsigned int i=0; i<n; ++i) {
+    if (!isDefined(gp[i])) {
+      edm::LogWarning("MagneticField|FieldOutsideValidity") << " Point " << gp[i] << " is outside the validity region of OAEParametrizedMagneticField";
+      b[i] = GlobalVector();
+    }
+  }
+}
+
+void
+OAEParametrizedMagneticField::inTeslaUncheckedBatch(const GlobalPoint* gp, GlobalVector* b, unsigned int n) const {
+  constexpr unsigned int chunk = 64;
+  float x[chunk], y[chunk], z[chunk], bx[chunk], by[chunk], bz[chunk];
+  for (unsigned int ibeg=0; ibeg<n; ibeg+=chunk) {
+    const unsigned int m = std::min(chunk, n-ibeg);
+    for (unsigned int i=0; i<m; ++i) {
+      x[i] = gp[ibeg+i].x()*ooh;
+      y[i] = gp[ibeg+i].y()*ooh;
+      z[i] = gp[ibeg+i].z()*ooh;
+    }
+    theParam.getBxyz(m, x, y, z, bx, by, bz);
+    for (unsigned int i=0; i<m; ++i) b[ibeg+i] = GlobalVector(bx[i], by[i], bz[i]);
+  }
+}
+
+
 bool
 OAEParametrizedMagneticField::isDefined(const GlobalPoint& gp) const {
   return (gp.perp2()<(115.f*115.f) && fabs(gp.z())<280.f);
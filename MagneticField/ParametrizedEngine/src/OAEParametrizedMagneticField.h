@@ -38,6 +38,12 @@ class OAEParametrizedMagneticField : public MagneticField {
 
   bool isDefined(const GlobalPoint& gp) const override;
 
+  /// Batch versions, evaluating the parametrization over SoA arrays of
+  /// points with SIMD (same float computation as inTeslaUnchecked)
+  void inTeslaBatch (const GlobalPoint* gp, GlobalVector* b, unsigned int n) const override;
+
+  void inTeslaUncheckedBatch (const GlobalPoint* gp, GlobalVector* b, unsigned int n) const override;
+
  private:
   magfieldparam::TkBfield  theParam;
 };
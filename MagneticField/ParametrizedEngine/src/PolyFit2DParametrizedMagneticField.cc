@@ -9,18 +9,24 @@
 
 #include "BFit.h"
 
+#include <algorithm>
+
 
 using namespace std;
 using namespace magfieldparam;
 
-PolyFit2DParametrizedMagneticField::PolyFit2DParametrizedMagneticField(double bVal) : 
-  theParam(new BFit())
+PolyFit2DParametrizedMagneticField::PolyFit2DParametrizedMagneticField(double bVal, bool floatBatch) : 
+  theParam(new BFit()),
+  theFloatBatch(floatBatch)
 {
   theParam->SetField(bVal);
 }
 
 
-PolyFit2DParametrizedMagneticField::PolyFit2DParametrizedMagneticField(const edm::ParameterSet& parameters) : theParam(new BFit()) {
+PolyFit2DParametrizedMagneticField::PolyFit2DParametrizedMagneticField(const edm::ParameterSet& parameters) : 
+  theParam(new BFit()),
+  theFloatBatch(parameters.getUntrackedParameter<bool>("floatPrecision", false))
+{
   theParam->SetField(parameters.getParameter<double>("BValue"));
 }
 
@@ -63,3 +69,45 @@ PolyFit2DParametrizedMagneticField::isDefined(const GlobalPoint& gp) const {
   if (z>350. || r>190 || z+2.5*r>670.) return false;
   return true;
 }
+
+namespace {
+  // evaluate the points in chunks, in double or float precision
+  template <typename T>
+  void batchField(const BFit& fit, const GlobalPoint* gp, GlobalVector* b, unsigned int n) {
+    constexpr unsigned int chunk = 64;
+    T r[chunk], z[chunk], br[chunk], bz[chunk];
+    for (unsigned int ibeg=0; ibeg<n; ibeg+=chunk) {
+      const unsigned int m = std::min(chunk, n-ibeg);
+      for (unsigned int i=0; i<m; ++i) {
+	r[i] = gp[ibeg+i].perp()/100.;
+	z[i] = gp[ibeg+i].z()/100.;
+      }
+      fit.GetField(m, r, z, br, bz);
+      for (unsigned int i=0; i<m; ++i) {
+	// Bphi is always 0; at r=0 phi() is 0, as in inTeslaUnchecked
+	const GlobalPoint& p = gp[ibeg+i];
+	const double perp = p.perp();
+	const double cosphi = perp>0 ? p.x()/perp : 1.;
+	const double sinphi = perp>0 ? p.y()/perp : 0.;
+	b[ibeg+i] = GlobalVector(br[i]*cosphi, br[i]*sinphi, bz[i]);
+      }
+    }
+  }
+}
+
+void
+PolyFit2DParametrizedMagneticField::inTeslaBatch(const GlobalPoint* gp, GlobalVector* b, unsigned int n) const {
+  inTeslaUncheckedBatch(gp, b, n);
+  for (unsigned int i=0; i<n; ++i) {
+    if (!isDefined(gp[i])) {
+      edm::LogWarning("MagneticField|FieldOutsideValidity") << " Point " << gp[i] << " is outside the validity region of PolyFit2DParametrizedMagneticField";
+      b[i] = GlobalVector();
+    }
+  }
+}
+
+void
+PolyFit2DParametrizedMagneticField::inTeslaUncheckedBatch(const GlobalPoint* gp, GlobalVector* b, unsigned int n) const {
+  if (theFloatBatch) batchField<float>(*theParam, gp, b, n);
+  else batchField<double>(*theParam, gp, b, n);
+}
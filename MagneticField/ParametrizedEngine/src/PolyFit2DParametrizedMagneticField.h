@@ -19,9 +19,12 @@ class PolyFit2DParametrizedMagneticField : public MagneticField {
  public:
   /// Constructor. Fitted bVal for the nominal currents are:
   /// 2.0216; 3.5162;  3.8114; 4.01242188708911
-  PolyFit2DParametrizedMagneticField(double bVal = 3.8114);
+  /// If floatBatch is true, the batch methods evaluate the fit in float
+  /// precision (agreement with the double precision to better than 1e-6 T).
+  PolyFit2DParametrizedMagneticField(double bVal = 3.8114, bool floatBatch = false);
 
-  /// Constructor. Parameters taken from a PSet
+  /// Constructor. Parameters taken from a PSet ("BValue" and optional
+  /// untracked "floatPrecision")
   PolyFit2DParametrizedMagneticField(const edm::ParameterSet& parameters);
 
   /// Destructor
@@ -33,8 +36,13 @@ class PolyFit2DParametrizedMagneticField : public MagneticField {
 
   bool isDefined(const GlobalPoint& gp) const override;
 
+  void inTeslaBatch (const GlobalPoint* gp, GlobalVector* b, unsigned int n) const override;
+
+  void inTeslaUncheckedBatch (const GlobalPoint* gp, GlobalVector* b, unsigned int n) const override;
+
  private:
   magfieldparam::BFit* theParam;
+  bool theFloatBatch;
 };
 #endif
 
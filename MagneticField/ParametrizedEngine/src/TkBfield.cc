@@ -65,3 +65,14 @@ void TkBfield::getBxyz(float const  * __restrict__ x, float * __restrict__ Bxyz)
   Bxyz[2]=bz;
 }
 
+void TkBfield::getBxyz(int n, float const * __restrict__ x, float const * __restrict__ y, float const * __restrict__ z,
+		       float * __restrict__ Bx, float * __restrict__ By, float * __restrict__ Bz) const {
+  for (int i=0; i<n; ++i) {
+    float br; float bz;
+    float r2=x[i]*x[i]+y[i]*y[i];
+    bcyl.compute(r2, z[i], br, bz);
+    Bx[i]=br*x[i];
+    By[i]=br*y[i];
+    Bz[i]=bz;
+  }
+}
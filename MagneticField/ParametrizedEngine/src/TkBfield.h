@@ -37,6 +37,13 @@ namespace magfieldparam {
     /// B out in cylindrical
     void getBrfz(float const  * __restrict__ x, float * __restrict__ Brfz) const;
 
+    /// B out in cartesian for n points given as separate x,y,z arrays (m).
+    /// Same computation as getBxyz, written as a single loop over the points
+    /// so that it is vectorized: the results agree with getBxyz to a few ulps
+    /// (the compiler may contract multiply-adds differently in the two loops)
+    void getBxyz(int n, float const * __restrict__ x, float const * __restrict__ y, float const * __restrict__ z,
+		 float * __restrict__ Bx, float * __restrict__ By, float * __restrict__ Bz) const;
+
   private:
 
     BCycl<float> bcyl;
@@ -270,6 +270,24 @@ double rz_poly::GetSVal(double r, double z, const double *C) const
    return rez;
 }
 
+//_______________________________________________________________________________
+void rz_poly::GetCoeffTable(const double *C, std::vector<double> &tab) const
+{
+//Collect the terms of the polynomial, weighted as in GetSVal, by powers of
+//r and z. Terms that are switched off are ignored
+//
+   tab.assign(max_nr*max_nz, 0.);
+   if (r_pow == nullptr) return;
+
+   for (unsigned int ip = 0; ip < data.size(); ++ip) {
+      if (is_off[ip]) continue;
+      for (unsigned int it = 0; it < data[ip].size(); ++it) {
+         tab[data[ip][it].np[0]*max_nz + data[ip][it].np[1]] += *C * data[ip][it].coeff;
+      }
+      ++C;
+   }
+}
+
 //_______________________________________________________________________________
 double *rz_poly::GetVVal(double r, double z, double *rez_out)
 {
@@ -53,6 +53,10 @@ public:
    rz_poly& operator*=(double *C);
    
    double  GetSVal(double r, double z, const double *C) const;
+
+   //Fill tab[nr*(GetMaxZPow()+1)+nz] with the coefficient of r^nr*z^nz in
+   //the polynomial evaluated by GetSVal(r, z, C)
+   void GetCoeffTable(const double *C, std::vector<double> &tab) const;
    double *GetVVal(double r, double z, double *rez_out = nullptr);
    
    int GetMaxRPow() const {return max_nr-1;}
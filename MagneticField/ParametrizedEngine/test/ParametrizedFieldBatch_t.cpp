@@ -0,0 +1,102 @@
+// Check that the batch evaluation of the parametrized fields gives the same
+// values as the point by point evaluation, within the documented accuracy:
+// about 1e-14 T for the double precision fit and 1e-6 T for the float one.
+
+#include "MagneticField/ParametrizedEngine/src/OAEParametrizedMagneticField.h"
+#include "MagneticField/ParametrizedEngine/src/PolyFit2DParametrizedMagneticField.h"
+#include "MagneticField/ParametrizedEngine/src/BFit.h"
+
+#include <cassert>
+#include <cmath>
+#include <iostream>
+#include <random>
+#include <vector>
+
+namespace {
+  // largest difference between the batch and the point by point values
+  double compare(const MagneticField& field, const std::vector<GlobalPoint>& points, bool checked) {
+    std::vector<GlobalVector> batch(points.size());
+    if (checked) field.inTeslaBatch(points.data(), batch.data(), points.size());
+    else field.inTeslaUncheckedBatch(points.data(), batch.data(), points.size());
+    double maxDiff = 0.;
+    for (unsigned int i = 0; i < points.size(); ++i) {
+      GlobalVector b = checked ? field.inTesla(points[i]) : field.inTeslaUnchecked(points[i]);
+      maxDiff = std::max(maxDiff, double((b - batch[i]).mag()));
+    }
+    return maxDiff;
+  }
+
+  // n points inside r<rMax, |z|<zMax (cm), including the origin; n is chosen
+  // not to be a multiple of the chunks in which the batches are evaluated
+  std::vector<GlobalPoint> makePoints(const MagneticField& field, float rMax, float zMax, unsigned int n) {
+    std::mt19937 rng(4321);
+    std::uniform_real_distribution<float> flat(-1.f, 1.f);
+    std::vector<GlobalPoint> points{GlobalPoint(0.f, 0.f, 0.f)};
+    while (points.size() < n) {
+      GlobalPoint gp(rMax*flat(rng), rMax*flat(rng), zMax*flat(rng));
+      if (field.isDefined(gp)) points.push_back(gp);
+    }
+    return points;
+  }
+
+  // largest difference between the batch BFit and the double precision single
+  // point one, at the (r,z) of the points (m); both are compared in double,
+  // not through the float GlobalVector
+  template <typename T>
+  double compareFit(const magfieldparam::BFit& fit, const std::vector<GlobalPoint>& points) {
+    const unsigned int n = points.size();
+    std::vector<T> r(n), z(n), br(n), bz(n);
+    for (unsigned int i = 0; i < n; ++i) {
+      r[i] = points[i].perp()/100.;
+      z[i] = points[i].z()/100.;
+    }
+    fit.GetField(n, r.data(), z.data(), br.data(), bz.data());
+    double maxDiff = 0.;
+    for (unsigned int i = 0; i < n; ++i) {
+      double Br, Bz, Bphi;
+      fit.GetField(double(r[i]), double(z[i]), 0., Br, Bz, Bphi);
+      maxDiff = std::max(maxDiff, std::hypot(Br - double(br[i]), Bz - double(bz[i])));
+    }
+    return maxDiff;
+  }
+}
+
+int main() {
+  OAEParametrizedMagneticField oae(3.8f);
+  std::vector<GlobalPoint> oaePoints = makePoints(oae, 115.f, 280.f, 1001);
+  double diff = compare(oae, oaePoints, false);
+  std::cout << "OAE batch, max difference " << diff << " T" << std::endl;
+  assert(diff < 1e-6);
+
+  // points outside the validity region are set to 0 by the checked version
+  oaePoints.push_back(GlobalPoint(0.f, 200.f, 0.f));
+  oaePoints.push_back(GlobalPoint(10.f, 10.f, 10.f));
+  std::vector<GlobalVector> batch(oaePoints.size());
+  oae.inTeslaBatch(oaePoints.data(), batch.data(), oaePoints.size());
+  assert(batch[oaePoints.size()-2].mag() == 0.f);
+  assert(std::abs(batch.back().z() - 3.8f) < 0.1f);
+
+  for (bool floatBatch : {false, true}) {
+    PolyFit2DParametrizedMagneticField polyFit(3.81143026675623, floatBatch);
+    std::vector<GlobalPoint> polyPoints = makePoints(polyFit, 190.f, 350.f, 1001);
+    diff = compare(polyFit, polyPoints, true);
+    std::cout << "PolyFit2D " << (floatBatch ? "float" : "double") << " batch, max difference " << diff << " T" << std::endl;
+    // the batch and the single point values are both rounded to the float
+    // GlobalVector, so the double fit can only be checked to the float precision here
+    assert(diff < 1e-6);
+  }
+
+  magfieldparam::BFit fit;
+  fit.SetField(3.81143026675623);
+  PolyFit2DParametrizedMagneticField polyFit(3.81143026675623);
+  std::vector<GlobalPoint> fitPoints = makePoints(polyFit, 190.f, 350.f, 1001);
+  diff = compareFit<double>(fit, fitPoints);
+  std::cout << "BFit double batch, max difference " << diff << " T" << std::endl;
+  assert(diff < 1e-14);
+  diff = compareFit<float>(fit, fitPoints);
+  std::cout << "BFit float batch, max difference " << diff << " T" << std::endl;
+  assert(diff < 1e-6);
+
+  std::cout << "ParametrizedFieldBatch_t OK" << std::endl;
+  return 0;
+}
@@ -12,10 +12,11 @@
 #include "DetectorDescription/Core/interface/DDCompactView.h"
 
 #include <vector>
-#include <atomic>
+#include <memory>
 
 class MagBLayer;
 class MagESector;
+class MagVolumeIndex;
 class MagVolume;
 class MagVolume6Faces;
 template <class T> class PeriodicBinFinderInPhi;
@@ -26,15 +27,18 @@ public:
   typedef Surface::GlobalVector   GlobalVector;
   typedef Surface::GlobalPoint    GlobalPoint;
 
-  /// Constructor
+  /// Constructor. If rMax and zMax are given, the volumes found are indexed
+  /// in bins of (R, phi, Z) within that range to speed up the next searches.
   MagGeometry(int geomVersion, const std::vector<MagBLayer *>& ,
 			     const std::vector<MagESector *>& ,
 			     const std::vector<MagVolume6Faces*>& ,
-			     const std::vector<MagVolume6Faces*>& );
+			     const std::vector<MagVolume6Faces*>& ,
+			     float rMax=0., float zMax=0.);
   MagGeometry(int geomVersion, const std::vector<MagBLayer const*>& ,
 			     const std::vector<MagESector const*>& ,
 			     const std::vector<MagVolume6Faces const*>& ,
-			     const std::vector<MagVolume6Faces const*>& );
+			     const std::vector<MagVolume6Faces const*>& ,
+			     float rMax=0., float zMax=0.);
 
   /// Destructor
   ~MagGeometry();
@@ -59,10 +63,17 @@ private:
   // Linear search (for debug purposes only)
   MagVolume const* findVolume1(const GlobalPoint & gp, double tolerance=0.) const;
 
+  // Search in the barrel layers and endcap sectors
+  MagVolume const* findVolumeInLayers(const GlobalPoint & gp, double tolerance) const;
+
 
   bool inBarrel(const GlobalPoint& gp) const;
 
-  mutable std::atomic<MagVolume const*> lastVolume; // Cache last volume found
+  // The last volume found is cached per thread (see findVolume), tagged with
+  // the id of the geometry so that several field maps can be used in a job.
+  const unsigned long long theId;
+
+  std::unique_ptr<MagVolumeIndex const> theIndex;
 
   std::vector<MagBLayer const*> theBLayers;
   std::vector<MagESector const*> theESectors;
@@ -42,6 +42,12 @@ class VolumeBasedMagneticField : public MagneticField {
 
   GlobalVector inTeslaUnchecked ( const GlobalPoint& g) const override;
 
+  /// Runs of consecutive points inside the parametrized region are passed
+  /// to the batch evaluation of the parametrization
+  void inTeslaBatch (const GlobalPoint* gp, GlobalVector* b, unsigned int n) const override;
+
+  void inTeslaUncheckedBatch (const GlobalPoint* gp, GlobalVector* b, unsigned int n) const override;
+
   const MagVolume * findVolume(const GlobalPoint & gp) const;
 
   bool isDefined(const GlobalPoint& gp) const override;
@@ -50,6 +56,8 @@ class VolumeBasedMagneticField : public MagneticField {
 
 
  private:
+  void fieldInTeslaBatch(const GlobalPoint* gp, GlobalVector* b, unsigned int n, bool checkRange) const;
+
   const MagGeometry* field;
   float maxR;
   float maxZ;
@@ -5,6 +5,7 @@
  */
 
 #include "MagneticField/VolumeBasedEngine/interface/MagGeometry.h"
+#include "MagneticField/VolumeBasedEngine/src/MagVolumeIndex.h"
 #include "MagneticField/VolumeGeometry/interface/MagVolume.h"
 #include "MagneticField/VolumeGeometry/interface/MagVolume6Faces.h"
 #include "MagneticField/Layers/interface/MagBLayer.h"
@@ -17,22 +18,42 @@
 #include "MagneticField/Layers/interface/MagVerbosity.h"
 #include "FWCore/MessageLogger/interface/MessageLogger.h"
 
+#include <atomic>
+
 using namespace std;
 using namespace edm;
 
+namespace {
+  // Last volume found by this thread, in the geometry with the given id.
+  // Threads stepping along different tracks would otherwise keep
+  // overwriting a cache shared by all of them.
+  struct LastVolume {
+    unsigned long long geometry = 0;
+    MagVolume const* volume = nullptr;
+  };
+  thread_local LastVolume lastVolume;
+
+  std::atomic<unsigned long long> nGeometries{0};
+}
+
 MagGeometry::MagGeometry(int geomVersion, const std::vector<MagBLayer *>& tbl,
 			 const std::vector<MagESector *>& tes,
 			 const std::vector<MagVolume6Faces*>& tbv,
-			 const std::vector<MagVolume6Faces*>& tev) :
+			 const std::vector<MagVolume6Faces*>& tev,
+			 float rMax, float zMax) :
   MagGeometry(geomVersion, reinterpret_cast<std::vector<MagBLayer const*> const&>(tbl), reinterpret_cast<std::vector<MagESector const*> const&>(tes), 
-	      reinterpret_cast<std::vector<MagVolume6Faces const*> const&>(tbv), reinterpret_cast<std::vector<MagVolume6Faces const*> const&>(tev)) {}
+	      reinterpret_cast<std::vector<MagVolume6Faces const*> const&>(tbv), reinterpret_cast<std::vector<MagVolume6Faces const*> const&>(tev),
+	      rMax, zMax) {}
 
 MagGeometry::MagGeometry(int geomVersion, const std::vector<MagBLayer const*>& tbl,
 			 const std::vector<MagESector const*>& tes,
 			 const std::vector<MagVolume6Faces const*>& tbv,
-			 const std::vector<MagVolume6Faces const*>& tev) : 
-  lastVolume(nullptr), theBLayers(tbl), theESectors(tes), theBVolumes(tbv), theEVolumes(tev), cacheLastVolume(true), geometryVersion(geomVersion)
+			 const std::vector<MagVolume6Faces const*>& tev,
+			 float rMax, float zMax) : 
+  theId(++nGeometries), theBLayers(tbl), theESectors(tes), theBVolumes(tbv), theEVolumes(tev), cacheLastVolume(true), geometryVersion(geomVersion)
 {
+  if (rMax>0 && zMax>0) theIndex = std::make_unique<MagVolumeIndex>(rMax, zMax);
+
   vector<double> rBorders;
 
   for (vector<MagBLayer const*>::const_iterator ilay = theBLayers.begin();
@@ -132,15 +153,37 @@ MagGeometry::findVolume1(const GlobalPoint & gp, double tolerance) const {
   return found;
 }
 
-// Use hierarchical structure for fast lookup.
+// Check the volume cache of the thread and the candidates of the index bin,
+// then use the hierarchical structure.
 MagVolume const* 
 MagGeometry::findVolume(const GlobalPoint & gp, double tolerance) const{
   // Check volume cache
-  auto lastVolumeCheck = lastVolume.load(std::memory_order_acquire);
-  if (lastVolumeCheck!=nullptr && lastVolumeCheck->inside(gp)){
-    return lastVolumeCheck;
+  if (cacheLastVolume && lastVolume.geometry==theId &&
+      lastVolume.volume!=nullptr && lastVolume.volume->inside(gp)){
+    return lastVolume.volume;
   }
 
+  MagVolume const* result=nullptr;
+  int bin = (theIndex ? theIndex->bin(gp) : -1);
+  if (bin>=0) result = theIndex->find(bin, gp);
+
+  if (result==nullptr) {
+    result = findVolumeInLayers(gp, tolerance);
+    if (bin>=0 && result!=nullptr) theIndex->add(bin, result);
+  }
+
+  if (cacheLastVolume) {
+    lastVolume.geometry = theId;
+    lastVolume.volume = result;
+  }
+
+  return result;
+}
+
+
+// Use hierarchical structure for fast lookup.
+MagVolume const* 
+MagGeometry::findVolumeInLayers(const GlobalPoint & gp, double tolerance) const{
   MagVolume const* result=nullptr;
   if (inBarrel(gp)) { // Barrel
     double R = gp.perp();
@@ -172,15 +215,33 @@ MagGeometry::findVolume(const GlobalPoint & gp, double tolerance) const{
     // This is a hack for thin gaps on air-iron boundaries,
     // which will not be present anymore once surfaces are matched.
     if (verbose::debugOut) cout << "Increasing the tolerance to 0.03" <<endl;
-    result = findVolume(gp, 0.03);
+    result = findVolumeInLayers(gp, 0.03);
   }
 
-  if (cacheLastVolume) lastVolume.store(result,std::memory_order_release);
-
   return result;
 }
 
 
+MagVolume const* MagVolumeIndex::find(int bin, const GlobalPoint& gp) const {
+  for (unsigned int i=0; i<nCandidates; ++i) {
+    MagVolume const* v = theSlots[bin*nCandidates+i].load(std::memory_order_acquire);
+    if (v==nullptr) break; // slots are filled in order
+    if (v->inside(gp)) return v;
+  }
+  return nullptr;
+}
+
+
+void MagVolumeIndex::add(int bin, MagVolume const* v) const {
+  for (unsigned int i=0; i<nCandidates; ++i) {
+    MagVolume const* expected = nullptr;
+    if (theSlots[bin*nCandidates+i].compare_exchange_strong(expected, v, std::memory_order_acq_rel) ||
+	expected==v) return; // added, or already there
+  }
+  // bin full: this volume will always be found with the layered search
+}
+
+
 
 
 bool MagGeometry::inBarrel(const GlobalPoint& gp) const {
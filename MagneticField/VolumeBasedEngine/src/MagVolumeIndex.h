@@ -0,0 +1,68 @@
+#ifndef MagVolumeIndex_H
+#define MagVolumeIndex_H
+
+/** \class MagVolumeIndex
+ *  Uniform grid in (R, phi, Z) over the field map, each bin holding a few
+ *  volumes known to overlap it. The candidates are filled at run time with
+ *  the volumes found by the layered search of MagGeometry, so a point is
+ *  usually found by checking the few volumes of its bin; the slots are
+ *  atomic and are only filled once, so that the index can be shared by
+ *  all the threads.
+ */
+
+#include "DataFormats/GeometrySurface/interface/Surface.h"
+#include "DataFormats/GeometryVector/interface/Pi.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <memory>
+
+class MagVolume;
+
+class MagVolumeIndex {
+public:
+
+  typedef Surface::GlobalPoint GlobalPoint;
+
+  static constexpr unsigned int nCandidates = 4;
+
+  MagVolumeIndex(float rMax, float zMax, float rStep=25., float zStep=25., int nPhi=24) :
+    theRMax(rMax), theZMax(zMax),
+    theInvRStep(1.f/rStep), theInvZStep(1.f/zStep), theInvPhiStep(nPhi/Geom::ftwoPi()),
+    theNR(int(rMax/rStep)+1), theNZ(int(2.f*zMax/zStep)+1), theNPhi(nPhi),
+    theSlots(new std::atomic<MagVolume const*>[nCandidates*theNR*theNZ*theNPhi])
+  {
+    for (unsigned int i=0; i<nCandidates*theNR*theNZ*theNPhi; ++i) theSlots[i].store(nullptr,std::memory_order_relaxed);
+  }
+
+  /// Bin containing gp, -1 outside the grid
+  int bin(const GlobalPoint& gp) const {
+    float R = gp.perp();
+    float Z = gp.z();
+    if (!(R<theRMax && std::abs(Z)<theZMax)) return -1; // also rejects NaN
+    int ir = int(R*theInvRStep);
+    int iz = int((Z+theZMax)*theInvZStep);
+    int iphi = std::min(int((gp.barePhi()+Geom::fpi())*theInvPhiStep), theNPhi-1);
+    return (iz*theNR + ir)*theNPhi + iphi;
+  }
+
+  /// First candidate of the bin which contains gp, nullptr if none
+  MagVolume const* find(int bin, const GlobalPoint& gp) const;
+
+  /// Add v to the candidates of the bin, if not there and a slot is free
+  void add(int bin, MagVolume const* v) const;
+
+private:
+  const float theRMax;
+  const float theZMax;
+  const float theInvRStep;
+  const float theInvZStep;
+  const float theInvPhiStep;
+  const int theNR;
+  const int theNZ;
+  const int theNPhi;
+  std::unique_ptr<std::atomic<MagVolume const*>[]> theSlots;
+};
+
+#endif
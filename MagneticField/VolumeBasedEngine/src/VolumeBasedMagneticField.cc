@@ -9,7 +9,7 @@ VolumeBasedMagneticField::VolumeBasedMagneticField( int geomVersion,
 						    float rMax, float zMax, 
 						    const MagneticField* param,
 						    bool isParamFieldOwned) : 
-  field(new MagGeometry(geomVersion,theBLayers,theESectors,theBVolumes,theEVolumes)), 
+  field(new MagGeometry(geomVersion,theBLayers,theESectors,theBVolumes,theEVolumes,rMax,zMax)), 
   maxR(rMax),
   maxZ(zMax),
   paramField(param),
@@ -56,6 +56,30 @@ GlobalVector VolumeBasedMagneticField::inTeslaUnchecked(const GlobalPoint& gp) c
   return field->fieldInTesla(gp);
 }
 
+void VolumeBasedMagneticField::inTeslaBatch(const GlobalPoint* gp, GlobalVector* b, unsigned int n) const {
+  fieldInTeslaBatch(gp, b, n, true);
+}
+
+void VolumeBasedMagneticField::inTeslaUncheckedBatch(const GlobalPoint* gp, GlobalVector* b, unsigned int n) const {
+  fieldInTeslaBatch(gp, b, n, false);
+}
+
+void VolumeBasedMagneticField::fieldInTeslaBatch(const GlobalPoint* gp, GlobalVector* b, unsigned int n, bool checkRange) const {
+  unsigned int i = 0;
+  while (i < n) {
+    if (paramField && paramField->isDefined(gp[i])) {
+      // points along a track stay in the tracker region for many steps
+      unsigned int j = i + 1;
+      while (j < n && paramField->isDefined(gp[j])) ++j;
+      paramField->inTeslaUncheckedBatch(gp + i, b + i, j - i);
+      i = j;
+    } else {
+      b[i] = (checkRange && !isDefined(gp[i])) ? GlobalVector() : field->fieldInTesla(gp[i]);
+      ++i;
+    }
+  }
+}
+
 
 const MagVolume * VolumeBasedMagneticField::findVolume(const GlobalPoint & gp) const
 {
@@ -37,7 +37,7 @@ namespace edm {
     };
   }
 
-  class BMixingModule : public stream::EDProducer<GlobalCache<MixingCache::Config>> {
+  class BMixingModule : public stream::EDProducer<GlobalCache<MixingCache::Config>, ExternalWork> {
     public:
       /** standard constructor*/
       explicit BMixingModule(const edm::ParameterSet& ps, MixingCache::Config const* globalConf);
@@ -48,6 +48,9 @@ namespace edm {
       /**Cumulates the pileup events onto this event*/
       void produce(edm::Event& e1, const edm::EventSetup& c) override;
 
+      /**Nothing by default, see prefetchPileUp*/
+      void acquire(edm::Event const& e1, const edm::EventSetup& c, edm::WaitingTaskWithArenaHolder holder) override;
+
       virtual void initializeEvent(const edm::Event& event, const edm::EventSetup& setup) {}
 
       // edm::Event is non-const because digitizers put their products into the Event.
@@ -83,6 +86,10 @@ namespace edm {
 
   protected:
       void setupPileUpEvent(const edm::EventSetup& setup);
+      // for the modules with sources read concurrently (PileUp::concurrentReading):
+      // draws the pileup of source 0 and starts reading the events of all the
+      // crossings, the holder is released once they are read
+      void prefetchPileUp(edm::Event const& e, edm::WaitingTaskWithArenaHolder holder);
       void dropUnwantedBranches(std::vector<std::string> const& wantedBranches);
       void beginStream(edm::StreamID) override;
       void endStream() override;
@@ -108,6 +115,11 @@ namespace edm {
 
       void update(edm::EventSetup const&);
       edm::ESWatcher<MixingRcd> parameterWatcher_;
+
+      // pileup of source 0 drawn by prefetchPileUp for the current event
+      // (with TrueNumInteractions_), to be used by doPileUp
+      bool pileupPrefetched_;
+      std::vector<int> prefetchedPileupList_;
   };
 
 }//edm
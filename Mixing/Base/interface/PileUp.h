@@ -8,6 +8,7 @@
 #include "FWCore/Sources/interface/VectorInputSource.h"
 #include "DataFormats/Provenance/interface/EventID.h"
 #include "FWCore/Framework/interface/EventPrincipal.h"
+#include "FWCore/Concurrency/interface/WaitingTaskWithArenaHolder.h"
 #include "FWCore/MessageLogger/interface/MessageLogger.h"
 
 #include "TRandom.h"
@@ -27,6 +28,8 @@ namespace edm {
   class SecondaryEventProvider;
   class StreamID;
   class ProcessContext;
+  struct PileUpReader;
+  class PileUpEventCache;
 
   struct PileUpConfig {
     PileUpConfig(std::string sourcename, double averageNumber, std::unique_ptr<TH1F>& histo, const bool playback)
@@ -45,6 +48,27 @@ namespace edm {
     template<typename T>
       void readPileUp(edm::EventID const& signal, std::vector<edm::SecondaryEventIDAndFileInfo>& ids, T eventOperator, int const NumPU, StreamID const&);
 
+    /// Concurrent reading, enabled with the untracked parameter concurrentReaders:
+    /// the events of all the crossings are read by that many readers, each with
+    /// its own input files, in the acquire step of the module, before they are
+    /// mixed, so all of them are in memory until their crossing is mixed.
+    /// The events are selected with one random engine per crossing seeded from
+    /// the module engine, so they depend neither on the number of threads nor
+    /// on the number of readers.
+    bool concurrentReading() const {return !readers_.empty();}
+
+    /// Select the events of all the crossings of the current event and read them
+    /// asynchronously; numberOfEvents[i] is the number of events of crossing
+    /// minBunch+i. The holder is released once all the crossings are read, or
+    /// with the exception of the first read that failed.
+    void prefetchPileUp(std::vector<int> const& numberOfEvents, int minBunch, StreamID const&, WaitingTaskWithArenaHolder holder);
+
+    /// Same as readPileUp for the events of one crossing read by prefetchPileUp.
+    /// A crossing that was not prefetched, or with another number of events,
+    /// is read here as readPileUp does.
+    template<typename T>
+      void readPrefetchedPileUp(edm::EventID const& signal, int bunchCrossing, std::vector<edm::SecondaryEventIDAndFileInfo>& ids, T eventOperator, int const NumPU, StreamID const&);
+
     template<typename T>
       void playPileUp(std::vector<edm::SecondaryEventIDAndFileInfo>::const_iterator begin, std::vector<edm::SecondaryEventIDAndFileInfo>::const_iterator end, std::vector<edm::SecondaryEventIDAndFileInfo>& ids, T eventOperator);
 
@@ -61,9 +85,7 @@ namespace edm {
 	return ( BX >= minBunch_cosmics_ && BX <= maxBunch_cosmics_);
       }
     }
-    void dropUnwantedBranches(std::vector<std::string> const& wantedBranches) {
-      input_->dropUnwantedBranches(wantedBranches);
-    }
+    void dropUnwantedBranches(std::vector<std::string> const& wantedBranches);
     void beginStream(edm::StreamID);
     void endStream();
 
@@ -92,6 +114,22 @@ namespace edm {
     std::unique_ptr<CLHEP::RandPoisson> const& poissonDistr_OOT(StreamID const& streamID);
     CLHEP::HepRandomEngine* randomEngine(StreamID const& streamID);
 
+    // events of one crossing read by prefetchPileUp; crossing i is always read
+    // by reader i%N, its principals are made for the products of that reader
+    struct PrefetchedCrossing {
+      long seed;
+      int numberOfEvents;
+      int numberRead;
+      bool valid;
+      std::vector<size_t> fileNameHashes;
+      std::vector<std::unique_ptr<EventPrincipal> > events;
+    };
+
+    PrefetchedCrossing* prefetchedCrossing(int bunchCrossing, int numberOfEvents);
+    void readCrossings(unsigned int reader);
+    void readCrossing(PileUpReader& reader, PrefetchedCrossing& prefetched);
+    EventPrincipal const& sharedEvent(size_t fileNameHash);
+
     unsigned int  inputType_;
     std::string type_;
     std::string Source_type_;
@@ -140,6 +178,16 @@ namespace edm {
 
     // sequential reading
     bool sequential_;
+
+    // concurrent reading
+    std::vector<std::unique_ptr<PileUpReader> > readers_;
+    std::vector<PrefetchedCrossing> prefetched_;
+    int prefetchMinBunch_;
+
+    // events shared with the other streams through the PileUpEventCache service
+    PileUpEventCache* eventCache_;
+    size_t cachePartition_;
+    std::shared_ptr<EventPrincipal const> sharedEvent_;
   };
 
 
@@ -182,17 +230,57 @@ namespace edm {
     RecordEventID<T> recorder(ids,eventOperator);
     int read = 0;
     CLHEP::HepRandomEngine* engine = (sequential_ ? nullptr : randomEngine(streamID));
-    read = input_->loopOverEvents(*eventPrincipal_, fileNameHash_, pileEventCnt, recorder, engine, &signal);
+    if (eventCache_) {
+      // one event at a time, each read goes to a new principal if the event is cached
+      auto shared = [this, &recorder](EventPrincipal const&, size_t fileNameHash) {
+        recorder(sharedEvent(fileNameHash), fileNameHash);
+      };
+      while (read < pileEventCnt && input_->loopOverEvents(*eventPrincipal_, fileNameHash_, 1, shared, engine, &signal) == 1) {
+        ++read;
+      }
+    } else {
+      read = input_->loopOverEvents(*eventPrincipal_, fileNameHash_, pileEventCnt, recorder, engine, &signal);
+    }
     if (read != pileEventCnt)
       edm::LogWarning("PileUp") << "Could not read enough pileup events: only " << read << " out of " << pileEventCnt << " requested.";
   }
 
+  template<typename T>
+  void
+  PileUp::readPrefetchedPileUp(edm::EventID const& signal, int bunchCrossing, std::vector<edm::SecondaryEventIDAndFileInfo>& ids, T eventOperator,
+                               int const pileEventCnt, StreamID const& streamID) {
+    PrefetchedCrossing* prefetched = prefetchedCrossing(bunchCrossing, pileEventCnt);
+    if (prefetched == nullptr) {
+      readPileUp(signal, ids, eventOperator, pileEventCnt, streamID);
+      return;
+    }
+    ids.reserve(pileEventCnt);
+    RecordEventID<T> recorder(ids,eventOperator);
+    for (int i = 0; i < prefetched->numberRead; ++i) {
+      recorder(*prefetched->events[i], prefetched->fileNameHashes[i]);
+      // the products of the event are not needed any more
+      prefetched->events[i]->clearEventPrincipal();
+    }
+    prefetched->valid = false;
+    if (prefetched->numberRead != pileEventCnt)
+      edm::LogWarning("PileUp") << "Could not read enough pileup events: only " << prefetched->numberRead << " out of " << pileEventCnt << " requested.";
+  }
+
   template<typename T>
   void
   PileUp::playPileUp(std::vector<edm::SecondaryEventIDAndFileInfo>::const_iterator begin, std::vector<edm::SecondaryEventIDAndFileInfo>::const_iterator end, std::vector<edm::SecondaryEventIDAndFileInfo>& ids, T eventOperator) {
     //TrueNumInteractions.push_back( end - begin ) ;
     RecordEventID<T> recorder(ids, eventOperator);
-    input_->loopSpecified(*eventPrincipal_, fileNameHash_, begin, end, recorder);
+    if (eventCache_) {
+      auto shared = [this, &recorder](EventPrincipal const&, size_t fileNameHash) {
+        recorder(sharedEvent(fileNameHash), fileNameHash);
+      };
+      for (auto it = begin; it != end; ++it) {
+        input_->loopSpecified(*eventPrincipal_, fileNameHash_, it, it + 1, shared);
+      }
+    } else {
+      input_->loopSpecified(*eventPrincipal_, fileNameHash_, begin, end, recorder);
+    }
   }
 
   template<typename T>
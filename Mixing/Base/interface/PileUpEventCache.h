@@ -0,0 +1,99 @@
+#ifndef Mixing_Base_PileUpEventCache_h
+#define Mixing_Base_PileUpEventCache_h
+
+/** \class edm::PileUpEventCache
+ *
+ * Service holding the pileup events read and unpacked by the PileUp
+ * objects of all the streams, so that an event selected again, by the
+ * same or by another stream, is taken from memory instead of being read
+ * and deserialized once more. The cached events are fully read
+ * EventPrincipals, shared by reference counting: an event evicted while a
+ * stream is mixing it stays alive until the stream is done with it.
+ *
+ * The cache is bounded by a number of events and by an estimate of the
+ * memory they use (uncompressed size of an event in the input files),
+ * the least recently used events are evicted first. It is enabled for the
+ * mixing and premixing modules by adding the service to the configuration.
+ */
+
+#include "DataFormats/Provenance/interface/EventID.h"
+
+#include <cstddef>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+
+namespace edm {
+  class ActivityRegistry;
+  class ConfigurationDescriptions;
+  class EventPrincipal;
+  class ParameterSet;
+
+  class PileUpEventCache {
+  public:
+    /// The partition separates the events of inputs that are configured
+    /// differently (files, dropped branches) even if they have the same ids.
+    struct Key {
+      size_t partition;
+      size_t fileNameHash;
+      EventID id;
+      bool operator==(Key const& other) const {
+        return partition == other.partition && fileNameHash == other.fileNameHash && id == other.id;
+      }
+    };
+
+    PileUpEventCache(ParameterSet const& pset, ActivityRegistry& registry);
+    ~PileUpEventCache();
+
+    static void fillDescriptions(ConfigurationDescriptions& descriptions);
+
+    /// Event for key, or null if not in the cache; counts a hit or a miss.
+    std::shared_ptr<EventPrincipal const> find(Key const& key);
+
+    /// Add a fully read event of about size bytes and return the cached one,
+    /// which is a different event if another stream inserted it first.
+    std::shared_ptr<EventPrincipal const> insert(Key const& key, std::shared_ptr<EventPrincipal const> event, size_t size);
+
+    void clear();
+
+    // statistics
+    unsigned long long hits() const;
+    unsigned long long misses() const;
+    unsigned long long evictions() const;
+    double hitRate() const;
+    size_t numberOfEvents() const;
+    size_t memory() const;
+    size_t peakMemory() const;
+
+  private:
+    struct KeyHash {
+      size_t operator()(Key const& key) const;
+    };
+    struct Entry {
+      Key key;
+      std::shared_ptr<EventPrincipal const> event;
+      size_t size;
+    };
+    typedef std::list<Entry> EntryList;
+
+    void evict();
+    void postEndJob();
+
+    size_t const maxEvents_;
+    size_t const maxMemory_;
+    bool const printSummary_;
+
+    mutable std::mutex mutex_;
+    // most recently used first
+    EntryList entries_;
+    std::unordered_map<Key, EntryList::iterator, KeyHash> index_;
+    size_t memory_;
+    size_t peakMemory_;
+    unsigned long long hits_;
+    unsigned long long misses_;
+    unsigned long long evictions_;
+  };
+}
+
+#endif
@@ -170,7 +170,8 @@ namespace edm {
     mixProdStep1_(pset.getParameter<bool>("mixProdStep1")),
     mixProdStep2_(pset.getParameter<bool>("mixProdStep2")),
     readDB_(false),
-    playback_(globalConf->playback_)
+    playback_(globalConf->playback_),
+    pileupPrefetched_(false)
   {
     if (pset.exists("readDB"))      readDB_=pset.getParameter<bool>("readDB");
 
@@ -279,6 +280,41 @@ namespace edm {
     put(e,setup);
   }
 
+  void BMixingModule::acquire(edm::Event const& e, const edm::EventSetup& setup, edm::WaitingTaskWithArenaHolder holder) {
+  }
+
+  void BMixingModule::prefetchPileUp(edm::Event const& e, edm::WaitingTaskWithArenaHolder holder) {
+    pileupPrefetched_ = false;
+    if (playback_) return;
+    bool concurrentReading = false;
+    for (size_t readSrcIdx=0; readSrcIdx<maxNbSources_; ++readSrcIdx) {
+      if (inputSources_[readSrcIdx] && inputSources_[readSrcIdx]->concurrentReading()) concurrentReading = true;
+    }
+    if (!concurrentReading) return;
+
+    // the number of events of source 0 is needed to start reading them, so
+    // it is drawn here rather than in doPileUp
+    prefetchedPileupList_.clear();
+    TrueNumInteractions_.clear();
+    std::shared_ptr<PileUp> source0 = inputSources_[0];
+    if (source0 && source0->doPileUp(0)) {
+      source0->CalculatePileup(minBunch_, maxBunch_, prefetchedPileupList_, TrueNumInteractions_, e.streamID());
+    }
+    pileupPrefetched_ = true;
+
+    for (size_t readSrcIdx=0; readSrcIdx<maxNbSources_; ++readSrcIdx) {
+      std::shared_ptr<PileUp> source = inputSources_[readSrcIdx];
+      if (!source || !source->concurrentReading()) continue;
+      std::vector<int> numberOfEvents;
+      for (int bunchIdx = minBunch_; bunchIdx <= maxBunch_; ++bunchIdx) {
+        // non-minbias pileup only gets one event
+        if (!source->doPileUp(bunchIdx)) numberOfEvents.push_back(0);
+        else numberOfEvents.push_back(readSrcIdx == 0 ? prefetchedPileupList_[bunchIdx - minBunch_] : 1);
+      }
+      source->prefetchPileUp(numberOfEvents, minBunch_, e.streamID(), holder);
+    }
+  }
+
   void BMixingModule::setupPileUpEvent(const edm::EventSetup& setup) {
     for (size_t dropIdx=0; dropIdx<maxNbSources_; ++dropIdx) {
       if(inputSources_[dropIdx]) inputSources_[dropIdx]->setupPileUpEvent(setup);
@@ -1,4 +1,5 @@
 #include "Mixing/Base/interface/PileUp.h"
+#include "Mixing/Base/interface/PileUpEventCache.h"
 #include "DataFormats/Provenance/interface/BranchIDListHelper.h"
 #include "DataFormats/Provenance/interface/ModuleDescription.h"
 #include "DataFormats/Provenance/interface/ThinnedAssociationsHelper.h"
@@ -18,6 +19,7 @@
 #include "FWCore/Version/interface/GetReleaseVersion.h"
 
 #include "FWCore/ServiceRegistry/interface/Service.h"
+#include "FWCore/ServiceRegistry/interface/ServiceRegistry.h"
 #include "FWCore/Utilities/interface/RandomNumberGenerator.h"
 
 #include "FWCore/Framework/interface/ESHandle.h"
@@ -28,8 +30,15 @@
 
 #include "CLHEP/Random/RandPoissonQ.h"
 #include "CLHEP/Random/RandPoisson.h"
+#include "CLHEP/Random/RandFlat.h"
+#include "CLHEP/Random/JamesRandom.h"
+
+#include "FWCore/Concurrency/interface/FunctorTask.h"
+
+#include "tbb/task.h"
 
 #include <algorithm>
+#include <functional>
 #include <memory>
 #include "TMath.h"
 
@@ -63,6 +72,13 @@ static Double_t GetRandom(TH1* th1, CLHEP::HepRandomEngine* rng)
 ////////////////////////////////////////////////////////////////////////////////
 
 namespace edm {
+  // An input with its own files for the concurrent reading
+  struct PileUpReader {
+    std::shared_ptr<ProductRegistry> productRegistry_;
+    std::unique_ptr<VectorInputSource> input_;
+    ServiceToken serviceToken_;
+  };
+
   PileUp::PileUp(ParameterSet const& pset, const std::shared_ptr<PileUpConfig>& config) :
     type_(pset.getParameter<std::string>("type")),
     Source_type_(config->sourcename_),
@@ -88,7 +104,13 @@ namespace edm {
     PoissonDistr_OOT_(),
     randomEngine_(),
     playback_(config->playback_),
-    sequential_(pset.getUntrackedParameter<bool>("sequential", false)) {
+    sequential_(pset.getUntrackedParameter<bool>("sequential", false)),
+    readers_(),
+    prefetched_(),
+    prefetchMinBunch_(0),
+    eventCache_(nullptr),
+    cachePartition_(pset.id().smallHash()),
+    sharedEvent_() {
 
     // Use the empty parameter set for the parameter set ID of our "@MIXING" process.
     processConfiguration_->setParameterSetID(ParameterSet::emptyParameterSetID());
@@ -101,6 +123,22 @@ namespace edm {
 
     productRegistry_->setFrozen();
 
+    unsigned int concurrentReaders = pset.getUntrackedParameter<unsigned int>("concurrentReaders", 0U);
+    if(concurrentReaders > 0U && !playback_) {
+      if(provider_ || sequential_ || pset.getUntrackedParameter<bool>("sameLumiBlock", false)) {
+        throw cms::Exception("Configuration")
+          << "PileUp: concurrentReaders cannot be used together with 'producers', 'sequential' or 'sameLumiBlock'\n";
+      }
+      for(unsigned int i = 0; i < concurrentReaders; ++i) {
+        auto reader = std::make_unique<PileUpReader>();
+        reader->productRegistry_.reset(new SignallingProductRegistry);
+        reader->input_ = VectorInputSourceFactory::get()->makeVectorInputSource(pset, VectorInputSourceDescription(
+                                                                                  reader->productRegistry_, edm::PreallocationConfiguration()));
+        reader->productRegistry_->setFrozen();
+        readers_.push_back(std::move(reader));
+      }
+    }
+
     // A modified HistoryAppender must be used for unscheduled processing.
     eventPrincipal_.reset(new EventPrincipal(input_->productRegistry(),
                                        std::make_shared<BranchIDListHelper>(),
@@ -108,6 +146,12 @@ namespace edm {
                                        *processConfiguration_,
                                        nullptr));
 
+    // the events of the "producers" are made for this stream only
+    edm::Service<PileUpEventCache> eventCache;
+    if(eventCache.isAvailable() && !provider_) {
+      eventCache_ = &*eventCache;
+    }
+
     bool DB=type_=="readDB";
 
     if (pset.exists("nbPileupEvents")) {
@@ -179,6 +223,7 @@ namespace edm {
     auto iID = eventPrincipal_->streamID(); // each producer has its own workermanager, so use default streamid
     streamContext_.reset(new StreamContext(iID, processContext_.get()));
     input_->doBeginJob();
+    for (auto& reader : readers_) reader->input_->doBeginJob();
     if (provider_.get() != nullptr) {
       provider_->beginJob(*productRegistry_);
       provider_->beginStream(iID, *streamContext_);
@@ -191,6 +236,16 @@ namespace edm {
       provider_->endJob();
     }
     input_->doEndJob();
+    for (auto& reader : readers_) reader->input_->doEndJob();
+  }
+
+  void PileUp::dropUnwantedBranches(std::vector<std::string> const& wantedBranches) {
+    // events with different branches are not shared
+    for (auto const& branch : wantedBranches) {
+      cachePartition_ ^= std::hash<std::string>()(branch) + 0x9e3779b9 + (cachePartition_ << 6) + (cachePartition_ >> 2);
+    }
+    input_->dropUnwantedBranches(wantedBranches);
+    for (auto& reader : readers_) reader->input_->dropUnwantedBranches(wantedBranches);
   }
 
   void PileUp::beginRun(const edm::Run& run, const edm::EventSetup& setup) {
@@ -324,6 +379,90 @@ namespace edm {
   PileUp::~PileUp() {
   }
 
+  void PileUp::prefetchPileUp(std::vector<int> const& numberOfEvents, int minBunch, StreamID const& streamID, WaitingTaskWithArenaHolder holder) {
+    // one seed per crossing, drawn in order from the module engine
+    CLHEP::HepRandomEngine* engine = randomEngine(streamID);
+    prefetchMinBunch_ = minBunch;
+    prefetched_.resize(numberOfEvents.size());
+    for (size_t crossing = 0; crossing < numberOfEvents.size(); ++crossing) {
+      PrefetchedCrossing& prefetched = prefetched_[crossing];
+      prefetched.seed = CLHEP::RandFlat::shootInt(engine, 900000000L);
+      prefetched.numberOfEvents = numberOfEvents[crossing];
+      prefetched.numberRead = 0;
+      prefetched.valid = false;
+    }
+
+    // one task per reader, each holding the module until it is done
+    ServiceToken token = ServiceRegistry::instance().presentToken();
+    for (unsigned int reader = 0; reader < readers_.size(); ++reader) {
+      readers_[reader]->serviceToken_ = token;
+      tbb::task::spawn(*make_functor_task(tbb::task::allocate_root(), [this, reader, holder]() mutable {
+        try {
+          readCrossings(reader);
+        } catch (...) {
+          holder.doneWaiting(std::current_exception());
+        }
+      }));
+    }
+  }
+
+  PileUp::PrefetchedCrossing* PileUp::prefetchedCrossing(int bunchCrossing, int numberOfEvents) {
+    int crossing = bunchCrossing - prefetchMinBunch_;
+    if (crossing < 0 || crossing >= static_cast<int>(prefetched_.size())) return nullptr;
+    PrefetchedCrossing& prefetched = prefetched_[crossing];
+    if (!prefetched.valid || prefetched.numberOfEvents != numberOfEvents) return nullptr;
+    return &prefetched;
+  }
+
+  void PileUp::readCrossings(unsigned int reader) {
+    ServiceRegistry::Operate operate(readers_[reader]->serviceToken_);
+    for (size_t crossing = reader; crossing < prefetched_.size(); crossing += readers_.size()) {
+      readCrossing(*readers_[reader], prefetched_[crossing]);
+    }
+  }
+
+  void PileUp::readCrossing(PileUpReader& reader, PrefetchedCrossing& prefetched) {
+    CLHEP::HepJamesRandom engine(prefetched.seed);
+    prefetched.fileNameHashes.resize(prefetched.numberOfEvents);
+    while (prefetched.events.size() < prefetched.fileNameHashes.size()) {
+      prefetched.events.emplace_back(new EventPrincipal(reader.input_->productRegistry(),
+                                                        std::make_shared<BranchIDListHelper>(),
+                                                        std::make_shared<ThinnedAssociationsHelper>(),
+                                                        *processConfiguration_,
+                                                        nullptr));
+    }
+    for (int i = 0; i < prefetched.numberOfEvents; ++i) {
+      EventPrincipal& event = *prefetched.events[i];
+      // the events of a crossing are read one after the other from a random
+      // file and entry, as in the reading without readers
+      if (!reader.input_->readOneIndependentRandom(event, prefetched.fileNameHashes[i], &engine, i == 0)) break;
+      // read and unpack the products here rather than when the workers ask for them
+      event.readAllFromSourceAndMergeImmediately();
+      ++prefetched.numberRead;
+    }
+    prefetched.valid = true;
+  }
+
+  EventPrincipal const& PileUp::sharedEvent(size_t fileNameHash) {
+    PileUpEventCache::Key key{cachePartition_, fileNameHash, eventPrincipal_->id()};
+    sharedEvent_ = eventCache_->find(key);
+    if (!sharedEvent_) {
+      // Read and unpack the event once and hand it to the cache; only its
+      // products are used afterwards, the reader of the file is not.
+      // The input still refers to eventPrincipal_ until it returns, the
+      // principal stays alive in the cache or in sharedEvent_.
+      eventPrincipal_->readAllFromSourceAndMergeImmediately();
+      sharedEvent_ = std::shared_ptr<EventPrincipal const>(std::move(eventPrincipal_));
+      eventCache_->insert(key, sharedEvent_, input_->averageEventSize());
+      eventPrincipal_.reset(new EventPrincipal(input_->productRegistry(),
+                                               std::make_shared<BranchIDListHelper>(),
+                                               std::make_shared<ThinnedAssociationsHelper>(),
+                                               *processConfiguration_,
+                                               nullptr));
+    }
+    return *sharedEvent_;
+  }
+
   std::unique_ptr<CLHEP::RandPoissonQ> const& PileUp::poissonDistribution(StreamID const& streamID) {
     if(!PoissonDistribution_) {
       CLHEP::HepRandomEngine& engine = *randomEngine(streamID);
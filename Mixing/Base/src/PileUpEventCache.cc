@@ -0,0 +1,144 @@
+#include "Mixing/Base/interface/PileUpEventCache.h"
+
+#include "FWCore/Framework/interface/EventPrincipal.h"
+#include "FWCore/MessageLogger/interface/MessageLogger.h"
+#include "FWCore/ParameterSet/interface/ConfigurationDescriptions.h"
+#include "FWCore/ParameterSet/interface/ParameterSet.h"
+#include "FWCore/ParameterSet/interface/ParameterSetDescription.h"
+#include "FWCore/ServiceRegistry/interface/ActivityRegistry.h"
+
+#include <algorithm>
+#include <functional>
+
+namespace edm {
+
+  size_t PileUpEventCache::KeyHash::operator()(Key const& key) const {
+    size_t hash = key.partition;
+    for (unsigned long long value : {(unsigned long long)key.fileNameHash,
+                                     (unsigned long long)key.id.run(),
+                                     (unsigned long long)key.id.luminosityBlock(),
+                                     (unsigned long long)key.id.event()}) {
+      hash ^= std::hash<unsigned long long>()(value) + 0x9e3779b9 + (hash << 6) + (hash >> 2);
+    }
+    return hash;
+  }
+
+  PileUpEventCache::PileUpEventCache(ParameterSet const& pset, ActivityRegistry& registry) :
+    maxEvents_(pset.getUntrackedParameter<unsigned int>("maxEvents")),
+    maxMemory_(size_t(pset.getUntrackedParameter<double>("maxMemoryMB") * 1024. * 1024.)),
+    printSummary_(pset.getUntrackedParameter<bool>("printSummary")),
+    memory_(0),
+    peakMemory_(0),
+    hits_(0),
+    misses_(0),
+    evictions_(0) {
+    registry.watchPostEndJob(this, &PileUpEventCache::postEndJob);
+  }
+
+  PileUpEventCache::~PileUpEventCache() {
+  }
+
+  void PileUpEventCache::fillDescriptions(ConfigurationDescriptions& descriptions) {
+    ParameterSetDescription desc;
+    desc.addUntracked<unsigned int>("maxEvents", 2000)
+      ->setComment("Maximum number of pileup events kept in memory.");
+    desc.addUntracked<double>("maxMemoryMB", 4096.)
+      ->setComment("Maximum estimated memory, in MB, used by the pileup events kept in memory.");
+    desc.addUntracked<bool>("printSummary", true)
+      ->setComment("Print the hit rate and memory statistics at the end of the job.");
+    descriptions.add("PileUpEventCache", desc);
+  }
+
+  std::shared_ptr<EventPrincipal const> PileUpEventCache::find(Key const& key) {
+    std::lock_guard<std::mutex> guard(mutex_);
+    auto it = index_.find(key);
+    if (it == index_.end()) {
+      ++misses_;
+      return std::shared_ptr<EventPrincipal const>();
+    }
+    ++hits_;
+    entries_.splice(entries_.begin(), entries_, it->second);
+    return it->second->event;
+  }
+
+  std::shared_ptr<EventPrincipal const> PileUpEventCache::insert(Key const& key, std::shared_ptr<EventPrincipal const> event, size_t size) {
+    std::lock_guard<std::mutex> guard(mutex_);
+    auto it = index_.find(key);
+    if (it != index_.end()) {
+      // read concurrently by another stream
+      entries_.splice(entries_.begin(), entries_, it->second);
+      return it->second->event;
+    }
+    entries_.push_front(Entry{key, event, size});
+    index_.emplace(key, entries_.begin());
+    memory_ += size;
+    evict();
+    peakMemory_ = std::max(peakMemory_, memory_);
+    return event;
+  }
+
+  void PileUpEventCache::evict() {
+    // the event just inserted is kept even if it is above the limits alone
+    while (entries_.size() > 1 && (entries_.size() > maxEvents_ || memory_ > maxMemory_)) {
+      Entry const& entry = entries_.back();
+      memory_ -= entry.size;
+      index_.erase(entry.key);
+      entries_.pop_back();
+      ++evictions_;
+    }
+  }
+
+  void PileUpEventCache::clear() {
+    std::lock_guard<std::mutex> guard(mutex_);
+    index_.clear();
+    entries_.clear();
+    memory_ = 0;
+  }
+
+  unsigned long long PileUpEventCache::hits() const {
+    std::lock_guard<std::mutex> guard(mutex_);
+    return hits_;
+  }
+
+  unsigned long long PileUpEventCache::misses() const {
+    std::lock_guard<std::mutex> guard(mutex_);
+    return misses_;
+  }
+
+  unsigned long long PileUpEventCache::evictions() const {
+    std::lock_guard<std::mutex> guard(mutex_);
+    return evictions_;
+  }
+
+  double PileUpEventCache::hitRate() const {
+    std::lock_guard<std::mutex> guard(mutex_);
+    return hits_ + misses_ > 0 ? double(hits_) / double(hits_ + misses_) : 0.;
+  }
+
+  size_t PileUpEventCache::numberOfEvents() const {
+    std::lock_guard<std::mutex> guard(mutex_);
+    return entries_.size();
+  }
+
+  size_t PileUpEventCache::memory() const {
+    std::lock_guard<std::mutex> guard(mutex_);
+    return memory_;
+  }
+
+  size_t PileUpEventCache::peakMemory() const {
+    std::lock_guard<std::mutex> guard(mutex_);
+    return peakMemory_;
+  }
+
+  void PileUpEventCache::postEndJob() {
+    if (printSummary_) {
+      edm::LogAbsolute("PileUpEventCache")
+        << "PileUpEventCache: " << hits() << " hits, " << misses() << " misses, hit rate " << hitRate()
+        << ", " << evictions() << " evictions, " << numberOfEvents() << " events ("
+        << memory() / (1024. * 1024.) << " MB) in the cache at the end of the job, peak "
+        << peakMemory() / (1024. * 1024.) << " MB";
+    }
+    // the cached events refer to the inputs of the mixing modules
+    clear();
+  }
+}
@@ -0,0 +1,118 @@
+/*
+ * Cross-request batching of TensorFlow inference.
+ * Requests submitted from several threads (typically the acquire() methods of ExternalWork modules
+ * on different streams) are collected by a dedicated thread, concatenated along the first
+ * dimension, evaluated with a single Session::Run call on a shared session and split back into
+ * per-request outputs. A batch is run as soon as maxBatchSize rows are pending or the oldest
+ * pending request has waited for maxLatency, whichever comes first.
+ */
+
+#ifndef PHYSICSTOOLS_TENSORFLOW_BATCHSCHEDULER_H
+#define PHYSICSTOOLS_TENSORFLOW_BATCHSCHEDULER_H
+
+#include "PhysicsTools/TensorFlow/interface/TensorFlow.h"
+
+#include "FWCore/Concurrency/interface/WaitingTaskWithArenaHolder.h"
+
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+namespace tensorflow
+{
+
+class BatchScheduler
+{
+public:
+    typedef std::chrono::steady_clock Clock;
+    typedef std::function<void(std::exception_ptr)> Callback;
+
+    struct Stats
+    {
+        unsigned long long requests = 0;
+        unsigned long long rows = 0;
+        unsigned long long batches = 0;
+        // sum of the time requests spent waiting in the queue, in microseconds
+        unsigned long long queueTime = 0;
+        // sum of the time spent in Session::Run, in microseconds
+        unsigned long long runTime = 0;
+    };
+
+    // session is not owned and must outlive the scheduler; inputNames refer to tensors that are
+    // batched along their first dimension, constantInputs are passed unchanged with every batch
+    BatchScheduler(Session* session, const std::vector<std::string>& inputNames,
+        const std::vector<std::string>& outputNames, unsigned int maxBatchSize,
+        std::chrono::microseconds maxLatency, const NamedTensorList& constantInputs = {});
+
+    ~BatchScheduler();
+
+    BatchScheduler(const BatchScheduler&) = delete;
+    BatchScheduler& operator=(const BatchScheduler&) = delete;
+
+    void start();
+    // rethrows the first exception raised in the scheduler thread outside of a batch evaluation,
+    // e.g. by a callback, which could not be passed to any request
+    void stop();
+
+    // queue inputs (one tensor per input name, all with the same first dimension) for evaluation,
+    // outputs is filled with the corresponding rows of each output before callback is invoked from
+    // the scheduler thread; inputs and outputs must stay valid until then; exceptions raised while
+    // evaluating the batch are passed to callback, after a failure of the scheduler thread itself
+    // the exception is rethrown here
+    void runAsync(const std::vector<Tensor>& inputs, std::vector<Tensor>* outputs,
+        Callback callback);
+
+    // same, but resumes the waiting framework task once outputs are available
+    void runAsync(const std::vector<Tensor>& inputs, std::vector<Tensor>* outputs,
+        edm::WaitingTaskWithArenaHolder holder);
+
+    Stats stats() const;
+
+    const std::vector<std::string>& inputNames() const { return inputNames_; }
+    const std::vector<std::string>& outputNames() const { return outputNames_; }
+    unsigned int maxBatchSize() const { return maxBatchSize_; }
+    std::chrono::microseconds maxLatency() const { return maxLatency_; }
+
+private:
+    struct Request
+    {
+        const std::vector<Tensor>* inputs;
+        std::vector<Tensor>* outputs;
+        Callback callback;
+        int64 rows;
+        Clock::time_point submitted;
+    };
+
+    void serverDoWork();
+    void doWork();
+    void runBatch(std::vector<Request>& batch);
+    // calls the callback of the request, never throws
+    void notify(Request& request, std::exception_ptr exception);
+
+    Session* session_;
+    const std::vector<std::string> inputNames_;
+    const std::vector<std::string> outputNames_;
+    const unsigned int maxBatchSize_;
+    const std::chrono::microseconds maxLatency_;
+    const NamedTensorList constantInputs_;
+
+    mutable std::mutex mutex_;
+    std::condition_variable cond_;
+    std::deque<Request> pending_;
+    int64 pendingRows_;
+    bool shouldStop_;
+    std::unique_ptr<std::thread> thread_;
+    // first exception raised in the scheduler thread that could not be passed to a request
+    std::exception_ptr failure_;
+
+    Stats stats_;
+};
+
+} // namespace tensorflow
+
+#endif // PHYSICSTOOLS_TENSORFLOW_BATCHSCHEDULER_H
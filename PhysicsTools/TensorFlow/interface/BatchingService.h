@@ -0,0 +1,75 @@
+/*
+ * Framework service sharing one TensorFlow session per model between all streams and batching
+ * their inference requests with a BatchScheduler.
+ *
+ * Usage in an ExternalWork module:
+ *
+ *   acquire(...):  service->runAsync("DeepJet", inputs_, &outputs_, holder);
+ *   produce(...):  read outputs_
+ *
+ * Each model is configured in the service with the path of its constant graph, the names of the
+ * inputs batched along their first dimension, the output names, the maximum batch size and the
+ * maximum time in microseconds a request may wait for the batch to fill up.
+ */
+
+#ifndef PHYSICSTOOLS_TENSORFLOW_BATCHINGSERVICE_H
+#define PHYSICSTOOLS_TENSORFLOW_BATCHINGSERVICE_H
+
+#include "PhysicsTools/TensorFlow/interface/BatchScheduler.h"
+
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace edm
+{
+class ActivityRegistry;
+class ConfigurationDescriptions;
+class ParameterSet;
+}
+
+namespace tensorflow
+{
+
+class BatchingService
+{
+public:
+    BatchingService(const edm::ParameterSet& config, edm::ActivityRegistry& registry);
+    ~BatchingService();
+
+    static void fillDescriptions(edm::ConfigurationDescriptions& descriptions);
+
+    bool hasModel(const std::string& label) const;
+
+    // throws a cms exception for unknown labels
+    BatchScheduler& scheduler(const std::string& label);
+
+    void runAsync(const std::string& label, const std::vector<Tensor>& inputs,
+        std::vector<Tensor>* outputs, edm::WaitingTaskWithArenaHolder holder)
+    {
+        scheduler(label).runAsync(inputs, outputs, std::move(holder));
+    }
+
+private:
+    struct Model
+    {
+        std::unique_ptr<GraphDef> graphDef;
+        Session* session = nullptr;
+        std::unique_ptr<BatchScheduler> scheduler;
+    };
+
+    void postBeginJob();
+    void postEndJob();
+
+    // stops all the schedulers and closes their sessions, even if one of them fails; the first
+    // failure is rethrown at the end if rethrow is true, otherwise it is only logged
+    void stopModels(bool rethrow);
+
+    std::map<std::string, Model> models_;
+    const bool printSummary_;
+};
+
+} // namespace tensorflow
+
+#endif // PHYSICSTOOLS_TENSORFLOW_BATCHINGSERVICE_H
@@ -0,0 +1,6 @@
+#include "FWCore/ServiceRegistry/interface/ServiceMaker.h"
+
+// declare the TensorFlow BatchingService as a framework Service
+#include "PhysicsTools/TensorFlow/interface/BatchingService.h"
+using TFBatchingService = tensorflow::BatchingService;
+DEFINE_FWK_SERVICE(TFBatchingService);
@@ -0,0 +1,300 @@
+/*
+ * Cross-request batching of TensorFlow inference.
+ */
+
+#include "PhysicsTools/TensorFlow/interface/BatchScheduler.h"
+
+#include "tensorflow/core/framework/tensor_util.h"
+
+namespace tensorflow
+{
+
+BatchScheduler::BatchScheduler(Session* session, const std::vector<std::string>& inputNames,
+    const std::vector<std::string>& outputNames, unsigned int maxBatchSize,
+    std::chrono::microseconds maxLatency, const NamedTensorList& constantInputs)
+    : session_(session)
+    , inputNames_(inputNames)
+    , outputNames_(outputNames)
+    , maxBatchSize_(maxBatchSize)
+    , maxLatency_(maxLatency)
+    , constantInputs_(constantInputs)
+    , pendingRows_(0)
+    , shouldStop_(false)
+{
+    if (session_ == nullptr)
+    {
+        throw cms::Exception("InvalidSession") << "cannot batch requests for an empty session";
+    }
+    if (maxBatchSize_ == 0)
+    {
+        throw cms::Exception("InvalidBatchSize") << "the maximum batch size must be positive";
+    }
+}
+
+BatchScheduler::~BatchScheduler()
+{
+    try
+    {
+        stop();
+    }
+    catch (...)
+    {
+        // the failure was already reported to the requests, or by an explicit call to stop()
+    }
+}
+
+void BatchScheduler::start()
+{
+    std::lock_guard<std::mutex> guard(mutex_);
+    if (!thread_)
+    {
+        shouldStop_ = false;
+        thread_ = std::make_unique<std::thread>([this]() { serverDoWork(); });
+    }
+}
+
+void BatchScheduler::stop()
+{
+    {
+        std::lock_guard<std::mutex> guard(mutex_);
+        shouldStop_ = true;
+    }
+    cond_.notify_one();
+    // the scheduler thread drains all pending requests before it returns
+    if (thread_)
+    {
+        thread_->join();
+        thread_.reset();
+    }
+
+    std::exception_ptr failure;
+    {
+        std::lock_guard<std::mutex> guard(mutex_);
+        std::swap(failure, failure_);
+    }
+    if (failure)
+    {
+        std::rethrow_exception(failure);
+    }
+}
+
+void BatchScheduler::runAsync(const std::vector<Tensor>& inputs, std::vector<Tensor>* outputs,
+    Callback callback)
+{
+    if (inputs.size() != inputNames_.size())
+    {
+        throw cms::Exception("InvalidInput") << "numbers of input names and tensors not equal";
+    }
+    int64 rows = 0;
+    for (size_t i = 0; i < inputs.size(); i++)
+    {
+        if (inputs[i].dims() == 0 || (i > 0 && inputs[i].dim_size(0) != rows))
+        {
+            throw cms::Exception("InvalidInput")
+                << "input '" << inputNames_[i] << "' cannot be batched along its first dimension";
+        }
+        rows = inputs[i].dim_size(0);
+    }
+
+    {
+        std::lock_guard<std::mutex> guard(mutex_);
+        if (failure_)
+        {
+            std::rethrow_exception(failure_);
+        }
+        if (!thread_ || shouldStop_)
+        {
+            throw cms::Exception("InvalidState") << "the batch scheduler is not running";
+        }
+        pending_.push_back({ &inputs, outputs, std::move(callback), rows, Clock::now() });
+        pendingRows_ += rows;
+    }
+    cond_.notify_one();
+}
+
+void BatchScheduler::runAsync(const std::vector<Tensor>& inputs, std::vector<Tensor>* outputs,
+    edm::WaitingTaskWithArenaHolder holder)
+{
+    runAsync(inputs, outputs,
+        [holder](std::exception_ptr exception) mutable { holder.doneWaiting(exception); });
+}
+
+BatchScheduler::Stats BatchScheduler::stats() const
+{
+    std::lock_guard<std::mutex> guard(mutex_);
+    return stats_;
+}
+
+void BatchScheduler::serverDoWork()
+{
+    // an exception escaping the thread function would call std::terminate: any failure outside
+    // of runBatch is passed to all the requests still pending, and kept for runAsync and stop
+    try
+    {
+        doWork();
+    }
+    catch (...)
+    {
+        std::exception_ptr exception = std::current_exception();
+        std::deque<Request> pending;
+        {
+            std::lock_guard<std::mutex> guard(mutex_);
+            if (!failure_)
+            {
+                failure_ = exception;
+            }
+            pending.swap(pending_);
+            pendingRows_ = 0;
+            shouldStop_ = true;
+        }
+        for (Request& request : pending)
+        {
+            notify(request, exception);
+        }
+    }
+}
+
+void BatchScheduler::doWork()
+{
+    std::unique_lock<std::mutex> lk(mutex_);
+    while (true)
+    {
+        cond_.wait(lk, [this]() -> bool { return shouldStop_ || !pending_.empty(); });
+        if (pending_.empty())
+        {
+            break;
+        }
+
+        // wait for a full batch, but never make the oldest request wait longer than maxLatency
+        Clock::time_point deadline = pending_.front().submitted + maxLatency_;
+        cond_.wait_until(lk, deadline,
+            [this]() -> bool { return shouldStop_ || pendingRows_ >= int64(maxBatchSize_); });
+
+        // a single request larger than maxBatchSize is run on its own
+        // reserved up front, so that no request can be lost once it is taken from the queue
+        std::vector<Request> batch;
+        batch.reserve(pending_.size());
+        int64 rows = 0;
+        while (!pending_.empty()
+            && (batch.empty() || rows + pending_.front().rows <= int64(maxBatchSize_)))
+        {
+            rows += pending_.front().rows;
+            batch.push_back(std::move(pending_.front()));
+            pending_.pop_front();
+        }
+        pendingRows_ -= rows;
+
+        // let other streams queue requests while the batch is evaluated; runBatch never throws
+        lk.unlock();
+        runBatch(batch);
+        lk.lock();
+    }
+}
+
+void BatchScheduler::runBatch(std::vector<Request>& batch)
+{
+    Clock::time_point startTime = Clock::now();
+
+    std::exception_ptr exception;
+    try
+    {
+        NamedTensorList inputs(constantInputs_);
+        for (size_t i = 0; i < inputNames_.size(); i++)
+        {
+            if (batch.size() == 1)
+            {
+                inputs.push_back(NamedTensor(inputNames_[i], (*batch[0].inputs)[i]));
+                continue;
+            }
+            std::vector<Tensor> parts;
+            parts.reserve(batch.size());
+            for (const Request& request : batch)
+            {
+                parts.push_back((*request.inputs)[i]);
+            }
+            Tensor merged;
+            Status status = tensor::Concat(parts, &merged);
+            if (!status.ok())
+            {
+                throw cms::Exception("InvalidInput") << "error while batching input '"
+                    << inputNames_[i] << "': " << status.ToString();
+            }
+            inputs.push_back(NamedTensor(inputNames_[i], merged));
+        }
+
+        std::vector<Tensor> outputs;
+        run(session_, inputs, outputNames_, &outputs);
+
+        if (batch.size() == 1)
+        {
+            batch[0].outputs->swap(outputs);
+        }
+        else
+        {
+            std::vector<int64> sizes;
+            sizes.reserve(batch.size());
+            for (const Request& request : batch)
+            {
+                sizes.push_back(request.rows);
+                request.outputs->resize(outputNames_.size());
+            }
+            for (size_t j = 0; j < outputNames_.size(); j++)
+            {
+                // the split tensors share the buffer of the batched output
+                std::vector<Tensor> pieces;
+                Status status = tensor::Split(outputs[j], sizes, &pieces);
+                if (!status.ok())
+                {
+                    throw cms::Exception("InvalidOutput") << "error while splitting output '"
+                        << outputNames_[j] << "': " << status.ToString();
+                }
+                for (size_t k = 0; k < batch.size(); k++)
+                {
+                    (*batch[k].outputs)[j] = pieces[k];
+                }
+            }
+        }
+    }
+    catch (...)
+    {
+        exception = std::current_exception();
+    }
+
+    Clock::time_point endTime = Clock::now();
+    {
+        std::lock_guard<std::mutex> guard(mutex_);
+        stats_.batches++;
+        stats_.runTime +=
+            std::chrono::duration_cast<std::chrono::microseconds>(endTime - startTime).count();
+        for (const Request& request : batch)
+        {
+            stats_.requests++;
+            stats_.rows += request.rows;
+            stats_.queueTime += std::chrono::duration_cast<std::chrono::microseconds>(
+                startTime - request.submitted).count();
+        }
+    }
+
+    for (Request& request : batch)
+    {
+        notify(request, exception);
+    }
+}
+
+void BatchScheduler::notify(Request& request, std::exception_ptr exception)
+{
+    try
+    {
+        request.callback(exception);
+    }
+    catch (...)
+    {
+        std::lock_guard<std::mutex> guard(mutex_);
+        if (!failure_)
+        {
+            failure_ = std::current_exception();
+        }
+    }
+}
+
+} // namespace tensorflow
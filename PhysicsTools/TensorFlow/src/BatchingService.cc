@@ -0,0 +1,161 @@
+/*
+ * Framework service sharing TensorFlow sessions between streams and batching their requests.
+ */
+
+#include "PhysicsTools/TensorFlow/interface/BatchingService.h"
+
+#include "FWCore/MessageLogger/interface/MessageLogger.h"
+#include "FWCore/ParameterSet/interface/ConfigurationDescriptions.h"
+#include "FWCore/ParameterSet/interface/FileInPath.h"
+#include "FWCore/ParameterSet/interface/ParameterSet.h"
+#include "FWCore/ParameterSet/interface/ParameterSetDescription.h"
+#include "FWCore/ServiceRegistry/interface/ActivityRegistry.h"
+
+#include <exception>
+#include <iomanip>
+
+namespace tensorflow
+{
+
+BatchingService::BatchingService(const edm::ParameterSet& config, edm::ActivityRegistry& registry)
+    : printSummary_(config.getUntrackedParameter<bool>("printSummary"))
+{
+    for (const edm::ParameterSet& pset : config.getParameter<std::vector<edm::ParameterSet>>("models"))
+    {
+        const std::string label = pset.getParameter<std::string>("label");
+        if (models_.count(label) != 0)
+        {
+            throw cms::Exception("Configuration") << "model '" << label << "' defined twice";
+        }
+
+        Model& model = models_[label];
+        model.graphDef.reset(loadGraphDef(pset.getParameter<edm::FileInPath>("graphPath").fullPath()));
+        model.session = createSession(model.graphDef.get(), pset.getParameter<int>("nThreads"));
+        model.scheduler = std::make_unique<BatchScheduler>(model.session,
+            pset.getParameter<std::vector<std::string>>("inputNames"),
+            pset.getParameter<std::vector<std::string>>("outputNames"),
+            pset.getParameter<unsigned int>("maxBatchSize"),
+            std::chrono::microseconds(pset.getParameter<unsigned int>("maxLatency")));
+    }
+
+    registry.watchPostBeginJob(this, &BatchingService::postBeginJob);
+    registry.watchPostEndJob(this, &BatchingService::postEndJob);
+}
+
+BatchingService::~BatchingService()
+{
+    // stop the schedulers before their sessions go away, without throwing from the destructor
+    stopModels(false);
+}
+
+void BatchingService::fillDescriptions(edm::ConfigurationDescriptions& descriptions)
+{
+    edm::ParameterSetDescription model;
+    model.add<std::string>("label");
+    model.add<edm::FileInPath>("graphPath");
+    model.add<std::vector<std::string>>("inputNames");
+    model.add<std::vector<std::string>>("outputNames");
+    model.add<unsigned int>("maxBatchSize", 256);
+    model.add<unsigned int>("maxLatency", 1000); // us
+    model.add<int>("nThreads", 1);
+
+    edm::ParameterSetDescription desc;
+    desc.setComment("Shares one TensorFlow session per model between all streams and batches "
+        "their inference requests.");
+    desc.addVPSet("models", model, {});
+    desc.addUntracked<bool>("printSummary", false);
+    descriptions.add("TFBatchingService", desc);
+}
+
+bool BatchingService::hasModel(const std::string& label) const
+{
+    return models_.count(label) != 0;
+}
+
+BatchScheduler& BatchingService::scheduler(const std::string& label)
+{
+    auto it = models_.find(label);
+    if (it == models_.end())
+    {
+        throw cms::Exception("Configuration")
+            << "model '" << label << "' is not configured in the TFBatchingService";
+    }
+    return *it->second.scheduler;
+}
+
+void BatchingService::postBeginJob()
+{
+    for (auto& entry : models_)
+    {
+        entry.second.scheduler->start();
+    }
+}
+
+void BatchingService::postEndJob()
+{
+    stopModels(true);
+}
+
+void BatchingService::stopModels(bool rethrow)
+{
+    std::exception_ptr failure;
+    for (auto& entry : models_)
+    {
+        Model& model = entry.second;
+        if (!model.scheduler)
+        {
+            continue;
+        }
+        try
+        {
+            model.scheduler->stop();
+        }
+        catch (std::exception const& e)
+        {
+            if (!failure)
+            {
+                failure = std::current_exception();
+            }
+            if (!rethrow)
+            {
+                edm::LogError("TFBatchingService") << "model " << entry.first << ": " << e.what();
+            }
+        }
+        catch (...)
+        {
+            if (!failure)
+            {
+                failure = std::current_exception();
+            }
+            if (!rethrow)
+            {
+                edm::LogError("TFBatchingService") << "model " << entry.first << ": unknown exception";
+            }
+        }
+
+        if (printSummary_)
+        {
+            BatchScheduler::Stats stats = model.scheduler->stats();
+            edm::LogVerbatim out("TFBatchingService");
+            out << "model " << entry.first << ": " << stats.requests << " requests, "
+                << stats.rows << " rows in " << stats.batches << " batches";
+            if (stats.batches > 0)
+            {
+                out << std::fixed << std::setprecision(1) << ", "
+                    << double(stats.rows) / stats.batches << " rows/batch, "
+                    << double(stats.runTime) / stats.batches << " us/batch, "
+                    << double(stats.queueTime) / stats.requests << " us average queue time";
+            }
+        }
+
+        model.scheduler.reset();
+        closeSession(model.session);
+    }
+
+    if (failure && rethrow)
+    {
+        std::rethrow_exception(failure);
+    }
+}
+
+} // namespace tensorflow
@@ -0,0 +1,282 @@
+/*
+ * Tests and throughput/latency benchmark for the cross-request BatchScheduler.
+ * Several threads emulate streams that each evaluate a small graph for one event at a time,
+ * either calling Session::Run directly or going through a shared BatchScheduler.
+ */
+
+#include <boost/filesystem.hpp>
+#include <cppunit/extensions/HelperMacros.h>
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <future>
+#include <iostream>
+#include <stdexcept>
+#include <thread>
+
+#include "PhysicsTools/TensorFlow/interface/BatchScheduler.h"
+
+std::string cmsswPath(std::string path)
+{
+    if (path.size() > 0 && path.substr(0, 1) != "/")
+    {
+        path = "/" + path;
+    }
+
+    std::string base = std::string(std::getenv("CMSSW_BASE"));
+    std::string releaseBase = std::string(std::getenv("CMSSW_RELEASE_BASE"));
+
+    return (boost::filesystem::exists(base.c_str()) ? base : releaseBase) + path;
+}
+
+class testBatchScheduler : public CppUnit::TestFixture
+{
+    CPPUNIT_TEST_SUITE(testBatchScheduler);
+    CPPUNIT_TEST(checkAll);
+    CPPUNIT_TEST_SUITE_END();
+
+public:
+    std::string dataPath;
+
+    void setUp();
+    void tearDown();
+    void checkAll();
+
+};
+
+CPPUNIT_TEST_SUITE_REGISTRATION(testBatchScheduler);
+
+namespace
+{
+
+typedef std::chrono::steady_clock Clock;
+
+const unsigned int nStreams = 8;
+const unsigned int nEvents = 2000;
+const int64_t nRows = 4;
+
+tensorflow::Tensor makeInput(unsigned int stream, unsigned int event)
+{
+    tensorflow::Tensor input(tensorflow::DT_FLOAT, { nRows, 10 });
+    auto m = input.matrix<float>();
+    for (int64_t r = 0; r < nRows; r++)
+    {
+        for (int64_t c = 0; c < 10; c++)
+        {
+            m(r, c) = float((stream * 31 + event * 7 + r * 3 + c) % 17);
+        }
+    }
+    return input;
+}
+
+// expected value of the test graph, sum(input) + 1, with scale 1
+float expected(const tensorflow::Tensor& input, int64_t row)
+{
+    float sum = 1.;
+    for (int64_t c = 0; c < 10; c++)
+    {
+        sum += input.matrix<float>()(row, c);
+    }
+    return sum;
+}
+
+// runs nStreams threads each evaluating nEvents events with evaluate, returns the wall time in
+// seconds and accumulates per-call latencies in microseconds
+template <typename F>
+double runStreams(F evaluate, std::vector<double>& latencies, bool& allCorrect)
+{
+    std::vector<std::vector<double>> perStream(nStreams);
+    std::vector<int> correct(nStreams, 1);
+    std::vector<std::thread> threads;
+
+    Clock::time_point start = Clock::now();
+    for (unsigned int s = 0; s < nStreams; s++)
+    {
+        threads.emplace_back([&, s]() {
+            for (unsigned int e = 0; e < nEvents; e++)
+            {
+                tensorflow::Tensor input = makeInput(s, e);
+                std::vector<tensorflow::Tensor> outputs;
+                Clock::time_point t0 = Clock::now();
+                evaluate(input, outputs);
+                perStream[s].push_back(
+                    std::chrono::duration<double, std::micro>(Clock::now() - t0).count());
+                if (outputs.size() != 1 || outputs[0].dim_size(0) != nRows)
+                {
+                    correct[s] = 0;
+                    continue;
+                }
+                for (int64_t r = 0; r < nRows; r++)
+                {
+                    correct[s] &= outputs[0].matrix<float>()(r, 0) == expected(input, r);
+                }
+            }
+        });
+    }
+    for (auto& thread : threads)
+    {
+        thread.join();
+    }
+    double seconds = std::chrono::duration<double>(Clock::now() - start).count();
+
+    latencies.clear();
+    for (auto& v : perStream)
+    {
+        latencies.insert(latencies.end(), v.begin(), v.end());
+    }
+    std::sort(latencies.begin(), latencies.end());
+    allCorrect = std::all_of(correct.begin(), correct.end(), [](int c) { return c != 0; });
+    return seconds;
+}
+
+void report(const std::string& name, double seconds, const std::vector<double>& latencies)
+{
+    std::cout << name << ": " << nStreams * nEvents / seconds << " events/s, latency median "
+              << latencies[latencies.size() / 2] << " us, 99% "
+              << latencies[latencies.size() * 99 / 100] << " us" << std::endl;
+}
+
+} // namespace
+
+void testBatchScheduler::setUp()
+{
+    dataPath = cmsswPath("/test/" + std::string(getenv("SCRAM_ARCH"))
+        + "/" + boost::filesystem::unique_path().string());
+
+    // create the graph
+    std::string testPath = cmsswPath("/src/PhysicsTools/TensorFlow/test");
+    std::string cmd = "python " + testPath + "/createconstantgraph.py " + dataPath;
+    std::array<char, 128> buffer;
+    std::string result;
+    std::shared_ptr<FILE> pipe(popen(cmd.c_str(), "r"), pclose);
+    if (!pipe)
+    {
+        throw std::runtime_error("popen() failed!");
+    }
+    while (!feof(pipe.get()))
+    {
+        if (fgets(buffer.data(), 128, pipe.get()) != NULL)
+        {
+            result += buffer.data();
+        }
+    }
+    std::cout << std::endl
+              << result << std::endl;
+}
+
+void testBatchScheduler::tearDown()
+{
+    if (boost::filesystem::exists(dataPath))
+    {
+        boost::filesystem::remove_all(dataPath);
+    }
+}
+
+void testBatchScheduler::checkAll()
+{
+    std::string pbFile = dataPath + "/constantgraph.pb";
+
+    tensorflow::setLogging();
+    tensorflow::GraphDef* graphDef = tensorflow::loadGraphDef(pbFile);
+    CPPUNIT_ASSERT(graphDef != nullptr);
+
+    tensorflow::Tensor scale(tensorflow::DT_FLOAT, {});
+    scale.scalar<float>()() = 1.0;
+
+    std::vector<double> latencies;
+    bool correct = false;
+
+    // reference: one single-threaded session per stream, as done by most modules today
+    std::vector<tensorflow::Session*> sessions;
+    for (unsigned int s = 0; s < nStreams; s++)
+    {
+        sessions.push_back(tensorflow::createSession(graphDef));
+    }
+    std::atomic<unsigned int> nextSession(0);
+    thread_local tensorflow::Session* mySession = nullptr;
+    double seconds = runStreams(
+        [&](const tensorflow::Tensor& input, std::vector<tensorflow::Tensor>& outputs) {
+            if (mySession == nullptr)
+            {
+                mySession = sessions[nextSession++];
+            }
+            tensorflow::run(mySession, { { "input", input }, { "scale", scale } }, { "output" },
+                &outputs);
+        },
+        latencies, correct);
+    CPPUNIT_ASSERT(correct);
+    report("per-stream sessions", seconds, latencies);
+    for (auto session : sessions)
+    {
+        CPPUNIT_ASSERT(tensorflow::closeSession(session));
+    }
+
+    // batched: one shared session, requests from all streams are merged
+    tensorflow::Session* session = tensorflow::createSession(graphDef, 2);
+    for (unsigned int maxBatchSize : { 1u, 8u, 32u })
+    {
+        tensorflow::BatchScheduler scheduler(session, { "input" }, { "output" }, maxBatchSize,
+            std::chrono::microseconds(200), { { "scale", scale } });
+        scheduler.start();
+        seconds = runStreams(
+            [&](const tensorflow::Tensor& input, std::vector<tensorflow::Tensor>& outputs) {
+                std::promise<void> done;
+                std::vector<tensorflow::Tensor> inputs = { input };
+                scheduler.runAsync(inputs, &outputs, [&done](std::exception_ptr exception) {
+                    if (exception)
+                    {
+                        done.set_exception(exception);
+                    }
+                    else
+                    {
+                        done.set_value();
+                    }
+                });
+                done.get_future().get();
+            },
+            latencies, correct);
+        scheduler.stop();
+        CPPUNIT_ASSERT(correct);
+
+        tensorflow::BatchScheduler::Stats stats = scheduler.stats();
+        CPPUNIT_ASSERT(stats.requests == nStreams * nEvents);
+        CPPUNIT_ASSERT(stats.rows == nStreams * nEvents * nRows);
+        CPPUNIT_ASSERT(stats.batches >= stats.rows / std::max<int64_t>(maxBatchSize, nRows));
+        report("batched, max. " + std::to_string(maxBatchSize) + " rows ("
+                + std::to_string(double(stats.rows) / stats.batches) + " rows/batch)",
+            seconds, latencies);
+    }
+
+    // errors are propagated to the callers
+    {
+        tensorflow::BatchScheduler scheduler(session, { "foo" }, { "output" }, 8,
+            std::chrono::microseconds(100));
+        scheduler.start();
+        std::vector<tensorflow::Tensor> inputs = { makeInput(0, 0) };
+        std::vector<tensorflow::Tensor> outputs;
+        std::promise<void> done;
+        scheduler.runAsync(inputs, &outputs, [&done](std::exception_ptr exception) {
+            done.set_exception(exception);
+        });
+        CPPUNIT_ASSERT_THROW(done.get_future().get(), cms::Exception);
+    }
+
+    // an exception thrown by a callback does not terminate the job, it is rethrown by stop()
+    {
+        tensorflow::BatchScheduler scheduler(session, { "input" }, { "output" }, 8,
+            std::chrono::microseconds(100), { { "scale", scale } });
+        scheduler.start();
+        std::vector<tensorflow::Tensor> inputs = { makeInput(0, 0) };
+        std::vector<tensorflow::Tensor> outputs;
+        std::promise<void> done;
+        scheduler.runAsync(inputs, &outputs, [&done](std::exception_ptr exception) {
+            done.set_value();
+            throw std::runtime_error("callback failure");
+        });
+        done.get_future().get();
+        CPPUNIT_ASSERT_THROW(scheduler.stop(), std::runtime_error);
+    }
+
+    CPPUNIT_ASSERT(tensorflow::closeSession(session));
+    delete graphDef;
+}
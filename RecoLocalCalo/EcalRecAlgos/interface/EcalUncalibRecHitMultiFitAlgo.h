@@ -13,6 +13,7 @@
 #include "CondFormats/EcalObjects/interface/EcalPedestals.h"
 #include "CondFormats/EcalObjects/interface/EcalGainRatios.h"
 #include "RecoLocalCalo/EcalRecAlgos/interface/PulseChiSqSNNLS.h"
+#include "RecoLocalCalo/EcalRecAlgos/interface/PulseChiSqSNNLSBatch.h"
 
 
 #include "TMatrixDSym.h"
@@ -26,7 +27,7 @@ class EcalUncalibRecHitMultiFitAlgo
   EcalUncalibRecHitMultiFitAlgo();
   ~EcalUncalibRecHitMultiFitAlgo() { };
   EcalUncalibratedRecHit makeRecHit(const EcalDataFrame& dataFrame, const EcalPedestals::Item * aped, const EcalMGPAGainRatio * aGain, const SampleMatrixGainArray &noisecors, const FullSampleVector &fullpulse, const FullSampleMatrix &fullpulsecov, const BXVector &activeBX);
-  void disableErrorCalculation() { _computeErrors = false; }
+  void disableErrorCalculation() { _computeErrors = false; _pulsefuncBatch.disableErrorCalculation(); }
   void setDoPrefit(bool b) { _doPrefit = b; }
   void setPrefitMaxChiSq(double x) { _prefitMaxChiSq = x; }
   void setDynamicPedestals(bool b) { _dynamicPedestals = b; }
@@ -35,10 +36,23 @@ class EcalUncalibRecHitMultiFitAlgo
   void setAddPedestalUncertainty(double x) { _addPedestalUncertainty = x; }
   void setSimplifiedNoiseModelForGainSwitch(bool b) { _simplifiedNoiseModelForGainSwitch = b; }
   void setGainSwitchUseMaxSample(bool b) { _gainSwitchUseMaxSample = b; }
+
+  // Batched fit: channels without gain switch can be collected with addToBatch() and fitted
+  // together with fitBatch() when neither the prefit, nor dynamic pedestals, nor the additional
+  // pedestal uncertainty are used. The rechits are then retrieved in the order they were added.
+  bool canFitInBatch(const EcalDataFrame& dataFrame, const BXVector &activeBX) const;
+  void addToBatch(const EcalDataFrame& dataFrame, const EcalPedestals::Item * aped, const FullSampleVector &fullpulse, const FullSampleMatrix &fullpulsecov);
+  unsigned int batchSize() const { return _batchIds.size(); }
+  void fitBatch(const SampleMatrixGainArray &noisecors, const BXVector &activeBX);
+  EcalUncalibratedRecHit makeRecHitFromBatch(unsigned int ich, const BXVector &activeBX) const;
+  void clearBatch();
   
  private:
    PulseChiSqSNNLS _pulsefunc;
    PulseChiSqSNNLS _pulsefuncSingle;
+   PulseChiSqSNNLSBatch _pulsefuncBatch;
+   std::vector<DetId> _batchIds;
+   std::vector<double> _batchPedestals;
    bool _computeErrors;
    bool _doPrefit;
    double _prefitMaxChiSq;
@@ -0,0 +1,99 @@
+#ifndef PulseChiSqSNNLSBatch_h
+#define PulseChiSqSNNLSBatch_h
+
+/** \class PulseChiSqSNNLSBatch
+  *  Multi-pulse fit of a batch of channels with fixed-size matrices.
+  *
+  *  Same algorithm as PulseChiSqSNNLS::DoFit, restricted to the common case of static
+  *  pedestals, no saturated or slew-rate limited samples and between 2 and 10 pulses,
+  *  so that all the matrices are 10x10 and the active set is handled by permuting
+  *  columns inside them. The inputs and results are stored per field for all the
+  *  channels of the batch.
+  *
+  *  The noise covariance of a channel is its pedestal rms squared times the noise
+  *  correlation matrix shared by the whole batch (one subdetector and gain), so the
+  *  Cholesky decomposition of the correlation matrix is computed once per batch and
+  *  only rescaled for the iterations in which no pulse contributes to the covariance.
+  */
+
+#define EIGEN_NO_DEBUG // kill throws in eigen code
+#include "RecoLocalCalo/EcalRecAlgos/interface/EigenMatrixTypes.h"
+
+#include <Eigen/StdVector>
+#include <array>
+#include <vector>
+
+class PulseChiSqSNNLSBatch {
+  public:
+
+    PulseChiSqSNNLSBatch();
+
+    // add a channel with pedestal subtracted samples, returns its index in the batch
+    unsigned int add(const SampleVector &samples, double noiseRMS, const FullSampleVector &fullpulse, const FullSampleMatrix &fullpulsecov);
+
+    // fit all the channels added since the last clear()
+    void fit(const SampleMatrix &noisecor, const BXVector &bxs);
+
+    void clear();
+    unsigned int size() const { return _samples.size(); }
+
+    // results, with pulses in the order of the bxs given to fit()
+    double amplitude(unsigned int ich, unsigned int ipulse) const { return _amplitudes[ich].coeff(ipulse); }
+    double error(unsigned int ich) const { return _errors[ich]; } // in-time pulse only
+    double chiSq(unsigned int ich) const { return _chisq[ich]; }
+    bool status(unsigned int ich) const { return _status[ich]; }
+
+    void disableErrorCalculation() { _computeErrors = false; }
+    void setMaxIters(int n) { _maxiters = n; }
+
+    // the fixed-size fit can be used for these pulses
+    static bool supports(const BXVector &bxs) { return bxs.rows()>1 && bxs.rows()<=SampleVectorSize; }
+
+  private:
+
+    // state of the fit of one channel, pulses beyond npulse are zero and never activated
+    struct Work {
+      SampleVector sampvec;
+      SampleMatrix pulsemat;
+      SampleMatrix covL;
+      SampleMatrix aTamat;
+      SampleVector aTbvec;
+      SampleVector ampvec;
+      std::array<int,SampleVectorSize> bxs;
+      std::array<int,SampleVectorSize> index; // position of each pulse in the input bxs
+      unsigned int npulse;
+      unsigned int nP;
+      double chisq;
+    };
+
+    void fitChannel(unsigned int ich, Work &w);
+    bool minimize(unsigned int ich, Work &w) const;
+    void updateCov(unsigned int ich, Work &w) const;
+    bool nnls(Work &w) const;
+    double computeChiSq(const Work &w) const;
+    static void unconstrainParameter(Work &w, unsigned int idxp);
+    static void constrainParameter(Work &w, unsigned int minratioidx);
+
+    template <typename T> using AlignedVector = std::vector<T, Eigen::aligned_allocator<T> >;
+
+    // inputs
+    AlignedVector<SampleVector> _samples;
+    std::vector<double> _noiseRMS;
+    AlignedVector<FullSampleVector> _fullpulse;
+    AlignedVector<FullSampleMatrix> _fullpulsecov;
+
+    // shared by all the channels of the batch
+    SampleMatrix _noisecor;
+    SampleMatrix _noisecorL;
+
+    // results
+    AlignedVector<SampleVector> _amplitudes;
+    std::vector<double> _errors;
+    std::vector<double> _chisq;
+    std::vector<bool> _status;
+
+    bool _computeErrors;
+    int _maxiters;
+};
+
+#endif
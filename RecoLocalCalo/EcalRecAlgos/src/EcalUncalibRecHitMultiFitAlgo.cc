@@ -225,3 +225,77 @@ EcalUncalibratedRecHit EcalUncalibRecHitMultiFitAlgo::makeRecHit(const EcalDataF
   return rh;
 }
 
+
+bool EcalUncalibRecHitMultiFitAlgo::canFitInBatch(const EcalDataFrame& dataFrame, const BXVector &activeBX) const {
+
+  if (_doPrefit || _dynamicPedestals || _addPedestalUncertainty>0.) return false;
+  if (!PulseChiSqSNNLSBatch::supports(activeBX)) return false;
+
+  //all samples in gain 12: static pedestal, no bad sample mitigation and the gain 12 noise only
+  bool hasGainSwitch = dataFrame.isSaturated() || dataFrame.hasSwitchToGain6() || dataFrame.hasSwitchToGain1();
+  return !hasGainSwitch;
+
+}
+
+void EcalUncalibRecHitMultiFitAlgo::addToBatch(const EcalDataFrame& dataFrame, const EcalPedestals::Item * aped, const FullSampleVector &fullpulse, const FullSampleMatrix &fullpulsecov) {
+
+  SampleVector amplitudes;
+  for(unsigned int iSample = 0; iSample < EcalDataFrame::MAXSAMPLES; iSample++) {
+    amplitudes[iSample] = (double)(dataFrame.sample(iSample).adc()) - aped->mean_x12;
+  }
+
+  _pulsefuncBatch.add(amplitudes, aped->rms_x12, fullpulse, fullpulsecov);
+  _batchIds.push_back(dataFrame.id());
+  _batchPedestals.push_back(aped->mean_x12);
+
+}
+
+void EcalUncalibRecHitMultiFitAlgo::fitBatch(const SampleMatrixGainArray &noisecors, const BXVector &activeBX) {
+
+  if (batchSize()==0) return;
+  _pulsefuncBatch.fit(noisecors[0], activeBX);
+
+}
+
+EcalUncalibratedRecHit EcalUncalibRecHitMultiFitAlgo::makeRecHitFromBatch(unsigned int ich, const BXVector &activeBX) const {
+
+  bool status = _pulsefuncBatch.status(ich);
+  if (!status) {
+    edm::LogWarning("EcalUncalibRecHitMultiFitAlgo::makeRecHit") << "Failed Fit" << std::endl;
+  }
+
+  unsigned int ipulseintime = 0;
+  for (unsigned int ipulse=0; ipulse<activeBX.rows(); ++ipulse) {
+    if (activeBX.coeff(ipulse)==0) {
+      ipulseintime = ipulse;
+      break;
+    }
+  }
+
+  double amplitude = status ? _pulsefuncBatch.amplitude(ich, ipulseintime) : 0.;
+  double amperr = status ? _pulsefuncBatch.error(ich) : 0.;
+  double chisq = _pulsefuncBatch.chiSq(ich);
+  double jitter = 0.;
+  uint32_t flags = 0;
+
+  EcalUncalibratedRecHit rh( _batchIds[ich], amplitude , _batchPedestals[ich], jitter, chisq, flags );
+  rh.setAmplitudeError(amperr);
+
+  for (unsigned int ipulse=0; ipulse<activeBX.rows(); ++ipulse) {
+    int bx = activeBX.coeff(ipulse);
+    if (bx!=0 && std::abs(bx)<100) {
+      rh.setOutOfTimeAmplitude(bx+5, status ? _pulsefuncBatch.amplitude(ich, ipulse) : 0.);
+    }
+  }
+
+  return rh;
+
+}
+
+void EcalUncalibRecHitMultiFitAlgo::clearBatch() {
+
+  _pulsefuncBatch.clear();
+  _batchIds.clear();
+  _batchPedestals.clear();
+
+}
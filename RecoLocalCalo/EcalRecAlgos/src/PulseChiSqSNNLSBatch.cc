@@ -0,0 +1,383 @@
+#include "RecoLocalCalo/EcalRecAlgos/interface/PulseChiSqSNNLSBatch.h"
+#include <cmath>
+#include <limits>
+#include "FWCore/MessageLogger/interface/MessageLogger.h"
+#include "FWCore/Utilities/interface/Exception.h"
+
+namespace {
+
+  typedef SampleVector::Index Index;
+
+  template <int N>
+  void solveTopLeft(const SampleMatrix &mat, const SampleVector &invec, SampleVector &outvec) {
+    Eigen::Matrix<double,N,N> temp = mat.topLeftCorner<N,N>();
+    outvec.head<N>() = temp.ldlt().solve(invec.head<N>());
+  }
+
+  // same as eigen_solve_submatrix in PulseChiSqSNNLS, for the fixed-size matrices
+  void solveSubmatrix(const SampleMatrix &mat, const SampleVector &invec, SampleVector &outvec, unsigned int NP) {
+    switch( NP ) {
+    case 10: solveTopLeft<10>(mat, invec, outvec); break;
+    case 9:  solveTopLeft<9>(mat, invec, outvec);  break;
+    case 8:  solveTopLeft<8>(mat, invec, outvec);  break;
+    case 7:  solveTopLeft<7>(mat, invec, outvec);  break;
+    case 6:  solveTopLeft<6>(mat, invec, outvec);  break;
+    case 5:  solveTopLeft<5>(mat, invec, outvec);  break;
+    case 4:  solveTopLeft<4>(mat, invec, outvec);  break;
+    case 3:  solveTopLeft<3>(mat, invec, outvec);  break;
+    case 2:  solveTopLeft<2>(mat, invec, outvec);  break;
+    case 1:  solveTopLeft<1>(mat, invec, outvec);  break;
+    default:
+      throw cms::Exception("MultFitWeirdState")
+        << "Weird number of pulses encountered in batched multifit, module is configured incorrectly!";
+    }
+  }
+
+}
+
+PulseChiSqSNNLSBatch::PulseChiSqSNNLSBatch() :
+  _computeErrors(true),
+  _maxiters(50)
+{
+
+}
+
+unsigned int PulseChiSqSNNLSBatch::add(const SampleVector &samples, double noiseRMS, const FullSampleVector &fullpulse, const FullSampleMatrix &fullpulsecov) {
+
+  _samples.push_back(samples);
+  _noiseRMS.push_back(noiseRMS);
+  _fullpulse.push_back(fullpulse);
+  _fullpulsecov.push_back(fullpulsecov);
+  return _samples.size() - 1;
+
+}
+
+void PulseChiSqSNNLSBatch::clear() {
+
+  _samples.clear();
+  _noiseRMS.clear();
+  _fullpulse.clear();
+  _fullpulsecov.clear();
+
+}
+
+void PulseChiSqSNNLSBatch::fit(const SampleMatrix &noisecor, const BXVector &bxs) {
+
+  if (!supports(bxs)) {
+    throw cms::Exception("MultFitWeirdState")
+      << "Batched multifit needs between 2 and " << SampleVectorSize << " pulses, got " << bxs.rows();
+  }
+
+  // factorize the noise correlation once for all the channels
+  _noisecor = noisecor;
+  _noisecorL = SampleDecompLLT(noisecor).matrixL();
+
+  const unsigned int nch = size();
+  _amplitudes.resize(nch);
+  _errors.assign(nch, 0.);
+  _chisq.assign(nch, 0.);
+  _status.assign(nch, false);
+
+  Work w;
+  for (unsigned int ich=0; ich<nch; ++ich) {
+    w.npulse = bxs.rows();
+    w.nP = 0;
+    w.chisq = 0.;
+    w.sampvec = _samples[ich];
+    w.pulsemat.setZero();
+    w.ampvec.setZero();
+    for (int ipulse=0; ipulse<SampleVectorSize; ++ipulse) {
+      w.index[ipulse] = ipulse;
+      w.bxs[ipulse] = 0;
+    }
+    for (unsigned int ipulse=0; ipulse<w.npulse; ++ipulse) {
+      int bx = bxs.coeff(ipulse);
+      int offset = 7-3-bx;
+      w.bxs[ipulse] = bx;
+      w.pulsemat.col(ipulse) = _fullpulse[ich].segment<SampleVector::RowsAtCompileTime>(offset);
+    }
+
+    fitChannel(ich, w);
+  }
+
+}
+
+void PulseChiSqSNNLSBatch::fitChannel(unsigned int ich, Work &w) {
+
+  bool status = minimize(ich, w);
+
+  // store the amplitudes in the order of the input pulses
+  const SampleVector ampvecmin = w.ampvec;
+  SampleVector &amplitudes = _amplitudes[ich];
+  amplitudes.setZero();
+  for (unsigned int ipulse=0; ipulse<w.npulse; ++ipulse) {
+    amplitudes.coeffRef(w.index[ipulse]) = ampvecmin.coeff(ipulse);
+  }
+  _chisq[ich] = w.chisq;
+  _status[ich] = status;
+
+  if (!status) return;
+
+  if (!_computeErrors) return;
+
+  //compute MINOS-like uncertainties for in-time amplitude
+  bool foundintime = false;
+  unsigned int ipulseintime = 0;
+  for (unsigned int ipulse=0; ipulse<w.npulse; ++ipulse) {
+    if (w.bxs[ipulse]==0) {
+      ipulseintime = ipulse;
+      foundintime = true;
+      break;
+    }
+  }
+  if (!foundintime) return;
+
+  const auto covL = w.covL.triangularView<Eigen::Lower>();
+  double approxerr = 1./covL.solve(w.pulsemat.col(ipulseintime)).norm();
+  double chisq0 = w.chisq;
+  double x0 = ampvecmin[ipulseintime];
+
+  //move in time pulse first to active set if necessary
+  if (ipulseintime<w.nP) {
+    w.pulsemat.col(w.nP-1).swap(w.pulsemat.col(ipulseintime));
+    std::swap(w.ampvec.coeffRef(w.nP-1),w.ampvec.coeffRef(ipulseintime));
+    std::swap(w.bxs[w.nP-1],w.bxs[ipulseintime]);
+    std::swap(w.index[w.nP-1],w.index[ipulseintime]);
+    ipulseintime = w.nP - 1;
+    --w.nP;
+  }
+
+  SampleVector pulseintime = w.pulsemat.col(ipulseintime);
+  w.pulsemat.col(ipulseintime).setZero();
+
+  //two point interpolation for upper uncertainty when amplitude is away from boundary
+  double xplus100 = x0 + approxerr;
+  w.ampvec.coeffRef(ipulseintime) = xplus100;
+  w.sampvec = _samples[ich] - w.ampvec.coeff(ipulseintime)*pulseintime;
+  status &= minimize(ich, w);
+  _status[ich] = status;
+  if (!status) return;
+  double chisqplus100 = computeChiSq(w);
+
+  double sigmaplus = std::abs(xplus100-x0)/sqrt(chisqplus100-chisq0);
+
+  //if amplitude is sufficiently far from the boundary, compute also the lower uncertainty and average them
+  if ( (x0/sigmaplus) > 0.5 ) {
+    for (unsigned int ipulse=0; ipulse<w.npulse; ++ipulse) {
+      if (w.bxs[ipulse]==0) {
+        ipulseintime = ipulse;
+        break;
+      }
+    }
+    double xminus100 = std::max(0.,x0-approxerr);
+    w.ampvec.coeffRef(ipulseintime) = xminus100;
+    w.sampvec = _samples[ich] - w.ampvec.coeff(ipulseintime)*pulseintime;
+    status &= minimize(ich, w);
+    _status[ich] = status;
+    if (!status) return;
+    double chisqminus100 = computeChiSq(w);
+
+    double sigmaminus = std::abs(xminus100-x0)/sqrt(chisqminus100-chisq0);
+    _errors[ich] = 0.5*(sigmaplus + sigmaminus);
+
+  }
+  else {
+    _errors[ich] = sigmaplus;
+  }
+
+}
+
+bool PulseChiSqSNNLSBatch::minimize(unsigned int ich, Work &w) const {
+
+  int iter = 0;
+  bool status = false;
+  while (true) {
+
+    if (iter>=_maxiters) {
+      LogDebug("PulseChiSqSNNLSBatch::minimize") << "Max Iterations reached at iter " << iter;
+      break;
+    }
+
+    updateCov(ich, w);
+    status = nnls(w);
+    if (!status) break;
+
+    double chisqnow = computeChiSq(w);
+    double deltachisq = chisqnow-w.chisq;
+
+    w.chisq = chisqnow;
+    if (std::abs(deltachisq)<1e-3) {
+      break;
+    }
+    ++iter;
+  }
+
+  return status;
+
+}
+
+void PulseChiSqSNNLSBatch::updateCov(unsigned int ich, Work &w) const {
+
+  const unsigned int nsample = SampleVector::RowsAtCompileTime;
+  const FullSampleMatrix &fullpulsecov = _fullpulsecov[ich];
+  const double noiseRMS = _noiseRMS[ich];
+
+  bool pulseContribution = false;
+  SampleMatrix invcov;
+
+  for (unsigned int ipulse=0; ipulse<w.npulse; ++ipulse) {
+    if (w.ampvec.coeff(ipulse)==0.) continue;
+    if (!pulseContribution) {
+      invcov = noiseRMS*noiseRMS*_noisecor;
+      pulseContribution = true;
+    }
+    int bx = w.bxs[ipulse];
+
+    int firstsamplet = std::max(0,bx + 3);
+    int offset = 7-3-bx;
+
+    const double ampveccoef = w.ampvec.coeff(ipulse);
+    const double ampsq = ampveccoef*ampveccoef;
+
+    const unsigned int nsamplepulse = nsample-firstsamplet;
+    invcov.block(firstsamplet,firstsamplet,nsamplepulse,nsamplepulse) +=
+      ampsq*fullpulsecov.block(firstsamplet+offset,firstsamplet+offset,nsamplepulse,nsamplepulse);
+  }
+
+  if (pulseContribution) {
+    w.covL = SampleDecompLLT(invcov).matrixL();
+  }
+  else {
+    // noise only: rescale the factorization shared by the batch
+    w.covL = noiseRMS*_noisecorL;
+  }
+
+}
+
+double PulseChiSqSNNLSBatch::computeChiSq(const Work &w) const {
+
+  return w.covL.triangularView<Eigen::Lower>().solve(w.pulsemat*w.ampvec - w.sampvec).squaredNorm();
+
+}
+
+bool PulseChiSqSNNLSBatch::nnls(Work &w) const {
+
+  //Fast NNLS (fnnls) algorithm as per http://citeseerx.ist.psu.edu/viewdoc/download?doi=10.1.1.157.9203&rep=rep1&type=pdf
+
+  const unsigned int npulse = w.npulse;
+  constexpr unsigned int nsamples = SampleVector::RowsAtCompileTime;
+
+  const auto covL = w.covL.triangularView<Eigen::Lower>();
+  const SampleMatrix invcovp = covL.solve(w.pulsemat);
+  w.aTamat.noalias() = invcovp.transpose().lazyProduct(invcovp);
+  w.aTbvec.noalias() = invcovp.transpose().lazyProduct(covL.solve(w.sampvec));
+
+  SampleVector updatework;
+  SampleVector ampvecpermtest;
+
+  int iter = 0;
+  Index idxwmax = 0;
+  double wmax = 0.0;
+  double threshold = 1e-11;
+  while (true) {
+    //can only perform this step if solution is guaranteed viable
+    if (iter>0 || w.nP==0) {
+      if ( w.nP==std::min(npulse,nsamples) ) break;
+
+      const unsigned int nActive = npulse - w.nP;
+
+      updatework = w.aTbvec - w.aTamat*w.ampvec;
+      Index idxwmaxprev = idxwmax;
+      double wmaxprev = wmax;
+      wmax = updatework.segment(w.nP,nActive).maxCoeff(&idxwmax);
+
+      //convergence
+      if (wmax<threshold || (idxwmax==idxwmaxprev && wmax==wmaxprev)) break;
+
+      //worst case protection
+      if (iter>=500) {
+        LogDebug("PulseChiSqSNNLSBatch::nnls()") << "Max Iterations reached at iter " << iter;
+        break;
+      }
+
+      //unconstrain parameter
+      unconstrainParameter(w, w.nP + idxwmax);
+    }
+
+    while (true) {
+      if (w.nP==0) break;
+
+      ampvecpermtest = w.ampvec;
+
+      //solve for unconstrained parameters
+      solveSubmatrix(w.aTamat,w.aTbvec,ampvecpermtest,w.nP);
+
+      //check solution
+      bool positive = true;
+      for (unsigned int i = 0; i < w.nP; ++i)
+        positive &= (ampvecpermtest(i) > 0);
+      if (positive) {
+        w.ampvec.head(w.nP) = ampvecpermtest.head(w.nP);
+        break;
+      }
+
+      //update parameter vector
+      Index minratioidx=0;
+
+      double minratio = std::numeric_limits<double>::max();
+      for (unsigned int ipulse=0; ipulse<w.nP; ++ipulse) {
+        if (ampvecpermtest.coeff(ipulse)<=0.) {
+          const double c_ampvec = w.ampvec.coeff(ipulse);
+          const double ratio = c_ampvec/(c_ampvec-ampvecpermtest.coeff(ipulse));
+          if (ratio<minratio) {
+            minratio = ratio;
+            minratioidx = ipulse;
+          }
+        }
+      }
+
+      w.ampvec.head(w.nP) += minratio*(ampvecpermtest.head(w.nP) - w.ampvec.head(w.nP));
+
+      //avoid numerical problems with later ==0. check
+      w.ampvec.coeffRef(minratioidx) = 0.;
+
+      constrainParameter(w, minratioidx);
+    }
+    ++iter;
+
+    //adaptive convergence threshold to avoid infinite loops but still
+    //ensure best value is used
+    if (iter % 16 == 0) {
+      threshold *= 2;
+    }
+  }
+
+  return true;
+
+}
+
+void PulseChiSqSNNLSBatch::unconstrainParameter(Work &w, unsigned int idxp) {
+
+  w.aTamat.col(w.nP).swap(w.aTamat.col(idxp));
+  w.aTamat.row(w.nP).swap(w.aTamat.row(idxp));
+  w.pulsemat.col(w.nP).swap(w.pulsemat.col(idxp));
+  std::swap(w.aTbvec.coeffRef(w.nP),w.aTbvec.coeffRef(idxp));
+  std::swap(w.ampvec.coeffRef(w.nP),w.ampvec.coeffRef(idxp));
+  std::swap(w.bxs[w.nP],w.bxs[idxp]);
+  std::swap(w.index[w.nP],w.index[idxp]);
+  ++w.nP;
+
+}
+
+void PulseChiSqSNNLSBatch::constrainParameter(Work &w, unsigned int minratioidx) {
+
+  w.aTamat.col(w.nP-1).swap(w.aTamat.col(minratioidx));
+  w.aTamat.row(w.nP-1).swap(w.aTamat.row(minratioidx));
+  w.pulsemat.col(w.nP-1).swap(w.pulsemat.col(minratioidx));
+  std::swap(w.aTbvec.coeffRef(w.nP-1),w.aTbvec.coeffRef(minratioidx));
+  std::swap(w.ampvec.coeffRef(w.nP-1),w.ampvec.coeffRef(minratioidx));
+  std::swap(w.bxs[w.nP-1],w.bxs[minratioidx]);
+  std::swap(w.index[w.nP-1],w.index[minratioidx]);
+  --w.nP;
+
+}
@@ -0,0 +1,146 @@
+/* Unit test for PulseChiSqSNNLSBatch
+   Compares the batched fixed-size multifit with PulseChiSqSNNLS channel by channel
+   on toy pulses with out-of-time pileup.
+ */
+
+#include <cppunit/extensions/HelperMacros.h>
+#include "RecoLocalCalo/EcalRecAlgos/interface/PulseChiSqSNNLS.h"
+#include "RecoLocalCalo/EcalRecAlgos/interface/PulseChiSqSNNLSBatch.h"
+
+#include <cmath>
+#include <random>
+
+class testPulseChiSqSNNLSBatch: public CppUnit::TestFixture
+{
+  CPPUNIT_TEST_SUITE(testPulseChiSqSNNLSBatch);
+  CPPUNIT_TEST(testBX25);
+  CPPUNIT_TEST(testBX50);
+  CPPUNIT_TEST(testNoErrors);
+  CPPUNIT_TEST_SUITE_END();
+
+public:
+  void setUp();
+  void tearDown() {}
+
+  void testBX25();
+  void testBX50();
+  void testNoErrors();
+
+private:
+  void compare(const BXVector &bxs, bool computeErrors);
+
+  FullSampleVector fullpulse_;
+  FullSampleMatrix fullpulsecov_;
+  SampleMatrix noisecor_;
+};
+
+///registration of the test so that the runner can find it
+CPPUNIT_TEST_SUITE_REGISTRATION(testPulseChiSqSNNLSBatch);
+
+void testPulseChiSqSNNLSBatch::setUp()
+{
+  // alpha-beta pulse shape with the maximum in sample 9 of the full pulse
+  const double alpha = 1.138, beta = 1.652;
+  fullpulse_ = FullSampleVector::Zero();
+  for (int i=0; i<12; ++i) {
+    double dt = i - 2.;
+    double term = 1. + dt/(alpha*beta);
+    fullpulse_(i+7) = term>0. ? std::pow(term,alpha)*std::exp(-dt/beta) : 0.;
+  }
+
+  fullpulsecov_ = FullSampleMatrix::Zero();
+  for (int i=7; i<19; ++i) {
+    for (int j=7; j<19; ++j) {
+      fullpulsecov_(i,j) = 1e-5*fullpulse_(i)*fullpulse_(j)*std::exp(-0.5*std::abs(i-j));
+    }
+  }
+
+  for (int i=0; i<SampleVectorSize; ++i) {
+    for (int j=0; j<SampleVectorSize; ++j) {
+      noisecor_(i,j) = std::pow(0.6,std::abs(i-j));
+    }
+  }
+}
+
+void testPulseChiSqSNNLSBatch::compare(const BXVector &bxs, bool computeErrors)
+{
+  std::mt19937 rng(12345);
+  std::uniform_real_distribution<double> flat(0.,1.);
+  std::exponential_distribution<double> pileup(1./20.);
+  std::normal_distribution<double> gauss(0.,1.);
+
+  const SampleMatrix noiseL = SampleDecompLLT(noisecor_).matrixL();
+  const unsigned int nch = 500;
+
+  PulseChiSqSNNLS scalar;
+  PulseChiSqSNNLSBatch batch;
+  if (!computeErrors) {
+    scalar.disableErrorCalculation();
+    batch.disableErrorCalculation();
+  }
+
+  std::vector<SampleVector, Eigen::aligned_allocator<SampleVector> > samples(nch);
+  std::vector<double> rms(nch);
+  for (unsigned int ich=0; ich<nch; ++ich) {
+    // in-time amplitudes from noise level to a few GeV, out-of-time pileup in a third of the bxs
+    double amplitude = flat(rng)<0.5 ? 10.*flat(rng) : 2000.*flat(rng);
+    rms[ich] = 1. + flat(rng);
+    SampleVector noise;
+    for (int i=0; i<SampleVectorSize; ++i) noise(i) = gauss(rng);
+    samples[ich] = rms[ich]*noiseL*noise;
+    for (int bx=-5; bx<=4; ++bx) {
+      double a = bx==0 ? amplitude : (flat(rng)<0.3 ? pileup(rng) : 0.);
+      samples[ich] += a*fullpulse_.segment<SampleVectorSize>(4-bx);
+    }
+    CPPUNIT_ASSERT(batch.add(samples[ich], rms[ich], fullpulse_, fullpulsecov_)==ich);
+  }
+  CPPUNIT_ASSERT(batch.size()==nch);
+
+  batch.fit(noisecor_, bxs);
+
+  for (unsigned int ich=0; ich<nch; ++ich) {
+    SampleMatrix noisecov = rms[ich]*rms[ich]*noisecor_;
+    bool status = scalar.DoFit(samples[ich], noisecov, bxs, fullpulse_, fullpulsecov_);
+    CPPUNIT_ASSERT(status==batch.status(ich));
+    if (!status) continue;
+
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(scalar.ChiSq(), batch.chiSq(ich), 1e-6*std::max(1.,scalar.ChiSq()));
+    for (unsigned int ipulse=0; ipulse<scalar.BXs().rows(); ++ipulse) {
+      // the scalar fit permutes the pulses, find the input position from the bx
+      unsigned int jpulse = 0;
+      while (bxs.coeff(jpulse)!=scalar.BXs().coeff(ipulse)) ++jpulse;
+      double expected = scalar.X().coeff(ipulse);
+      CPPUNIT_ASSERT_DOUBLES_EQUAL(expected, batch.amplitude(ich,jpulse), 1e-6*std::max(1.,std::abs(expected)));
+      if (computeErrors && scalar.BXs().coeff(ipulse)==0) {
+        double error = scalar.Errors().coeff(ipulse);
+        // the error of a pulse fitted at the boundary can be undefined in both fits
+        CPPUNIT_ASSERT(std::isnan(error)==std::isnan(batch.error(ich)));
+        if (!std::isnan(error)) CPPUNIT_ASSERT_DOUBLES_EQUAL(error, batch.error(ich), 1e-6*std::max(1.,error));
+      }
+    }
+  }
+
+  batch.clear();
+  CPPUNIT_ASSERT(batch.size()==0);
+}
+
+void testPulseChiSqSNNLSBatch::testBX25()
+{
+  BXVector bxs(10);
+  bxs << -5,-4,-3,-2,-1,0,1,2,3,4;
+  compare(bxs, true);
+}
+
+void testPulseChiSqSNNLSBatch::testBX50()
+{
+  BXVector bxs(5);
+  bxs << -4,-2,0,2,4;
+  compare(bxs, true);
+}
+
+void testPulseChiSqSNNLSBatch::testNoErrors()
+{
+  BXVector bxs(10);
+  bxs << -5,-4,-3,-2,-1,0,1,2,3,4;
+  compare(bxs, false);
+}
@@ -61,6 +61,7 @@ EcalUncalibRecHitWorkerMultiFit::EcalUncalibRecHitWorkerMultiFit(const edm::Para
   addPedestalUncertaintyEB_ = ps.getParameter<double>("addPedestalUncertaintyEB");
   addPedestalUncertaintyEE_ = ps.getParameter<double>("addPedestalUncertaintyEE");
   simplifiedNoiseModelForGainSwitch_ = ps.getParameter<bool>("simplifiedNoiseModelForGainSwitch");
+  batchedFit_ = ps.getParameter<bool>("batchedFit");
   
   // algorithm to be used for timing
   auto const & timeAlgoName = ps.getParameter<std::string>("timealgo");
@@ -250,6 +251,66 @@ double EcalUncalibRecHitWorkerMultiFit::timeCorrection(
 }
 
 
+void
+EcalUncalibRecHitWorkerMultiFit::runBatchedFit( const EcalDigiCollection & digis, bool barrel,
+                std::vector<EcalUncalibratedRecHit> & hits, std::vector<int> & index )
+{
+    // the batch holds a copy of the pulse shape and covariance of each channel,
+    // so it is fitted and emptied every batchSize channels
+    constexpr unsigned int batchSize = 1024;
+
+    hits.clear();
+    hits.reserve(digis.size());
+    index.assign(digis.size(), -1);
+
+    const SampleMatrixGainArray &noisecors = noisecor(barrel);
+    FullSampleVector fullpulse(FullSampleVector::Zero());
+    FullSampleMatrix fullpulsecov(FullSampleMatrix::Zero());
+
+    auto flush = [&]() {
+        multiFitMethod_.fitBatch(noisecors, activeBX);
+        for (unsigned int ich=0; ich<multiFitMethod_.batchSize(); ++ich) {
+            hits.push_back(multiFitMethod_.makeRecHitFromBatch(ich, activeBX));
+        }
+        multiFitMethod_.clearBatch();
+    };
+
+    unsigned int idigi = 0;
+    for (auto itdg = digis.begin(); itdg != digis.end(); ++itdg, ++idigi)
+    {
+        if (!multiFitMethod_.canFitInBatch(*itdg, activeBX)) continue;
+
+        DetId detid(itdg->id());
+        const EcalPedestals::Item * aped = nullptr;
+        const EcalPulseShapes::Item * aPulse = nullptr;
+        const EcalPulseCovariances::Item * aPulseCov = nullptr;
+        if (barrel) {
+            unsigned int hashedIndex = EBDetId(detid).hashedIndex();
+            aped       = &peds->barrel(hashedIndex);
+            aPulse     = &pulseshapes->barrel(hashedIndex);
+            aPulseCov  = &pulsecovariances->barrel(hashedIndex);
+        } else {
+            unsigned int hashedIndex = EEDetId(detid).hashedIndex();
+            aped       = &peds->endcap(hashedIndex);
+            aPulse     = &pulseshapes->endcap(hashedIndex);
+            aPulseCov  = &pulsecovariances->endcap(hashedIndex);
+        }
+
+        for (int i=0; i<EcalPulseShape::TEMPLATESAMPLES; ++i)
+            fullpulse(i+7) = aPulse->pdfval[i];
+
+        for(int i=0; i<EcalPulseShape::TEMPLATESAMPLES;i++)
+        for(int j=0; j<EcalPulseShape::TEMPLATESAMPLES;j++)
+            fullpulsecov(i+7,j+7) = aPulseCov->covval[i][j];
+
+        index[idigi] = hits.size() + multiFitMethod_.batchSize();
+        multiFitMethod_.addToBatch(*itdg, aped, fullpulse, fullpulsecov);
+        if (multiFitMethod_.batchSize() == batchSize) flush();
+    }
+    flush();
+}
+
+
 void
 EcalUncalibRecHitWorkerMultiFit::run( const edm::Event & evt,
                 const EcalDigiCollection & digis,
@@ -281,11 +342,19 @@ EcalUncalibRecHitWorkerMultiFit::run( const edm::Event & evt,
         multiFitMethod_.setAddPedestalUncertainty(addPedestalUncertaintyEE_);
     }
         
+    // fit the channels without gain switch together first, the other ones go through makeRecHit below
+    std::vector<EcalUncalibratedRecHit> batchedHits;
+    std::vector<int> batchedIndex;
+    if (batchedFit_) {
+        runBatchedFit(digis, barrel, batchedHits, batchedIndex);
+    }
+
     FullSampleVector fullpulse(FullSampleVector::Zero());
     FullSampleMatrix fullpulsecov(FullSampleMatrix::Zero());
 
     result.reserve(result.size() + digis.size());
-    for (auto itdg = digis.begin(); itdg != digis.end(); ++itdg)
+    unsigned int idigi = 0;
+    for (auto itdg = digis.begin(); itdg != digis.end(); ++itdg, ++idigi)
     {
         DetId detid(itdg->id());
 
@@ -371,7 +440,11 @@ EcalUncalibRecHitWorkerMultiFit::run( const edm::Event & evt,
             // multifit
             const SampleMatrixGainArray &noisecors = noisecor(barrel);
             
-            result.push_back(multiFitMethod_.makeRecHit(*itdg, aped, aGain, noisecors, fullpulse, fullpulsecov, activeBX));
+            if (batchedFit_ && batchedIndex[idigi]>=0) {
+                result.push_back(batchedHits[batchedIndex[idigi]]);
+            } else {
+                result.push_back(multiFitMethod_.makeRecHit(*itdg, aped, aGain, noisecors, fullpulse, fullpulsecov, activeBX));
+            }
             auto & uncalibRecHit = result.back();
             
             // === time computation ===
@@ -568,6 +641,7 @@ EcalUncalibRecHitWorkerMultiFit::getAlgoDescription() {
 	      edm::ParameterDescription<double>("addPedestalUncertaintyEB", 0., true) and
 	      edm::ParameterDescription<double>("addPedestalUncertaintyEE", 0., true) and
 	      edm::ParameterDescription<bool>("simplifiedNoiseModelForGainSwitch", true, true) and
+	      edm::ParameterDescription<bool>("batchedFit", false, true) and
 	      edm::ParameterDescription<std::string>("timealgo", "RatioMethod", true) and
 	      edm::ParameterDescription<std::vector<double>>("EBtimeFitParameters", {-2.015452e+00, 3.130702e+00, -1.234730e+01, 4.188921e+01, -8.283944e+01, 9.101147e+01, -5.035761e+01, 1.105621e+01}, true) and
 	      edm::ParameterDescription<std::vector<double>>("EEtimeFitParameters", {-2.390548e+00, 3.553628e+00, -1.762341e+01, 6.767538e+01, -1.332130e+02, 1.407432e+02, -7.541106e+01, 1.620277e+01}, true) and
@@ -47,6 +47,9 @@ class EcalUncalibRecHitWorkerMultiFit final : public EcalUncalibRecHitWorkerBase
                 void set(const edm::EventSetup& es) override;
                 void set(const edm::Event& evt) override;
                 void run(const edm::Event& evt, const EcalDigiCollection & digis, EcalUncalibratedRecHitCollection & result) override;
+                // fit the channels eligible for the batched multifit, index gives the position of the
+                // rechit of each digi in hits or -1
+                void runBatchedFit(const EcalDigiCollection & digis, bool barrel, std::vector<EcalUncalibratedRecHit> & hits, std::vector<int> & index);
 	public:	
 		edm::ParameterSetDescription getAlgoDescription() override;
         private:
@@ -101,6 +104,7 @@ class EcalUncalibRecHitWorkerMultiFit final : public EcalUncalibRecHitWorkerBase
                 double addPedestalUncertaintyEB_;
                 double addPedestalUncertaintyEE_;
                 bool simplifiedNoiseModelForGainSwitch_;
+                bool batchedFit_;
 
                 // ratio method
                 std::vector<double> EBtimeFitParameters_; 
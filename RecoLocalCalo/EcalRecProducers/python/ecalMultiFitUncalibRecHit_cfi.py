@@ -31,6 +31,8 @@ ecalMultiFitUncalibRecHit = cms.EDProducer("EcalUncalibRecHitProducer",
       simplifiedNoiseModelForGainSwitch = cms.bool(True),
       addPedestalUncertaintyEB = cms.double(0.),
       addPedestalUncertaintyEE = cms.double(0.),
+      # fit the channels without gain switch together with fixed-size matrices
+      batchedFit = cms.bool(False),
   
       # decide which algorithm to be use to calculate the jitter
       timealgo = cms.string("RatioMethod"),
@@ -23,6 +23,7 @@
 #include <numeric>
 
 #include "KDTreeLinkerAlgoT.h"
+#include "RecoLocalCalo/HGCalRecAlgos/interface/HGCalLayerTiles.h"
 
 
 template <typename T>
@@ -126,6 +127,14 @@ void setVerbosity(VerbosityLevel the_verbosity)
         verbosity = the_verbosity;
 }
 
+// find the neighbours of the hits with a grid of tiles on each layer instead of
+// KD-trees, and the nearest hit with higher density by searching the tiles
+// around each hit instead of looping on all the denser hits of the layer
+void setUseTiles(bool useTiles)
+{
+        useTiles_ = useTiles;
+}
+
 void populate(const HGCRecHitCollection &hits);
 // this is the method that will start the clusterisation (it is possible to invoke this method more than once - but make sure it is with
 // different hit collections (or else use reset)
@@ -200,6 +209,9 @@ VerbosityLevel verbosity;
 // initialization bool
 bool initialized;
 
+// use the tiles instead of the KD-trees
+bool useTiles_ = false;
+
 struct Hexel {
 
         double x;
@@ -270,6 +282,23 @@ std::vector<std::vector<KDNode> > points;   //a vector of vectors of hexels, one
 std::vector<std::array<float,2> > minpos;
 std::vector<std::array<float,2> > maxpos;
 
+// the hits of a layer stored field by field for the clustering with tiles,
+// one per layer (and endcap) so that the layers can be processed in parallel
+struct CellsOnLayer {
+        std::vector<double> x;
+        std::vector<double> y;
+        std::vector<double> weight;
+        std::vector<float> sigmaNoise;
+        std::vector<double> rho;
+        std::vector<double> delta;
+        std::vector<int> nearestHigher;
+        std::vector<int> clusterIndex;
+        std::vector<unsigned int> rank;   // position in the list sorted by decreasing density
+        std::vector<unsigned char> isBorder;
+        HGCalLayerTiles tiles;
+};
+std::vector<CellsOnLayer> cells_;
+
 
 //these functions should be in a helper class.
 inline double distance2(const Hexel &pt1, const Hexel &pt2) const{   //distance squared
@@ -285,6 +314,18 @@ double calculateDistanceToHigher(std::vector<KDNode> &) const;
 int findAndAssignClusters(std::vector<KDNode> &, KDTree &, double, KDTreeBox &, const unsigned int, std::vector<std::vector<KDNode> >&) const;
 math::XYZPoint calculatePosition(std::vector<KDNode> &) const;
 
+// same steps using the tiles, the results are copied back to the KDNodes
+void makeClustersWithTiles(std::vector<KDNode> &, CellsOnLayer &, const std::array<float,2> &, const std::array<float,2> &,
+                           const unsigned int, std::vector<std::vector<KDNode> >&) const;
+double calculateLocalDensity(CellsOnLayer &, float) const;
+void calculateDistanceToHigher(CellsOnLayer &, const std::vector<size_t> &) const;
+unsigned int findAndAssignClusters(CellsOnLayer &, const std::vector<size_t> &, double, float) const;
+inline double distance2(const CellsOnLayer &cells, unsigned int i, unsigned int j) const {
+        const double dx = cells.x[i] - cells.x[j];
+        const double dy = cells.y[i] - cells.y[j];
+        return (dx*dx + dy*dy);
+}
+
 // attempt to find subclusters within a given set of hexels
 std::vector<unsigned> findLocalMaximaInCluster(const std::vector<KDNode>&);
 math::XYZPoint calculatePositionWithFraction(const std::vector<KDNode>&, const std::vector<double>&);
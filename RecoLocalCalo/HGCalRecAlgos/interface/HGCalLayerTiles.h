@@ -0,0 +1,82 @@
+#ifndef RecoLocalCalo_HGCalRecAlgos_HGCalLayerTiles_h
+#define RecoLocalCalo_HGCalRecAlgos_HGCalLayerTiles_h
+
+#include <algorithm>
+#include <array>
+#include <vector>
+
+// Fixed grid of square tiles covering the hits of one layer, used to find
+// the neighbours of a hit without building a KD-tree. The indices of the
+// hits are stored tile by tile in a single array (counting sort), so that
+// filling the grid is two passes over the hits and no memory is allocated
+// once the vectors have reached the size needed by the largest layer.
+class HGCalLayerTiles {
+public:
+  // upper limit on the number of tiles per dimension, so that a layer with
+  // a few hits spread over the whole endcap does not need a huge grid
+  static constexpr int maxTilesPerDim = 256;
+
+  HGCalLayerTiles() : nColumns_(0), nRows_(0), xmin_(0.), ymin_(0.), invTileSize_(0.) {}
+
+  // build the grid for the points (x[i],y[i]) inside [xmin,xmax]x[ymin,ymax]
+  // with tiles of (at least) tileSize
+  void fill(const std::vector<double>& x, const std::vector<double>& y,
+            double xmin, double xmax, double ymin, double ymax, double tileSize) {
+    const double size = std::max({tileSize, (xmax - xmin) / maxTilesPerDim, (ymax - ymin) / maxTilesPerDim, 1e-3});
+    invTileSize_ = 1. / size;
+    xmin_ = xmin;
+    ymin_ = ymin;
+    nColumns_ = std::min(maxTilesPerDim, int((xmax - xmin) * invTileSize_) + 1);
+    nRows_ = std::min(maxTilesPerDim, int((ymax - ymin) * invTileSize_) + 1);
+
+    const unsigned int nPoints = x.size();
+    tile_.resize(nPoints);
+    offsets_.assign(nColumns_ * nRows_ + 1, 0);
+    for (unsigned int i = 0; i < nPoints; ++i) {
+      tile_[i] = tileIndex(xBin(x[i]), yBin(y[i]));
+      ++offsets_[tile_[i] + 1];
+    }
+    for (unsigned int t = 1; t < offsets_.size(); ++t)
+      offsets_[t] += offsets_[t - 1];
+
+    indices_.resize(nPoints);
+    fillPosition_.assign(offsets_.begin(), offsets_.end() - 1);
+    for (unsigned int i = 0; i < nPoints; ++i)
+      indices_[fillPosition_[tile_[i]]++] = i;
+  }
+
+  int nColumns() const { return nColumns_; }
+  int nRows() const { return nRows_; }
+
+  // bins are clamped to the grid, points outside it end up in the border tiles
+  int xBin(double x) const { return std::min(std::max(int((x - xmin_) * invTileSize_), 0), nColumns_ - 1); }
+  int yBin(double y) const { return std::min(std::max(int((y - ymin_) * invTileSize_), 0), nRows_ - 1); }
+  int tileIndex(int xbin, int ybin) const { return ybin * nColumns_ + xbin; }
+
+  // tiles overlapping a search window: {xbinmin, xbinmax, ybinmin, ybinmax}
+  std::array<int, 4> searchBox(double xmin, double xmax, double ymin, double ymax) const {
+    return std::array<int, 4>{{xBin(xmin), xBin(xmax), yBin(ymin), yBin(ymax)}};
+  }
+
+  // indices of the points in one tile
+  const unsigned int* begin(int xbin, int ybin) const { return indices_.data() + offsets_[tileIndex(xbin, ybin)]; }
+  const unsigned int* end(int xbin, int ybin) const { return indices_.data() + offsets_[tileIndex(xbin, ybin) + 1]; }
+
+  // smallest distance between a point in tile (xbin,ybin) and any point in a
+  // tile at Chebyshev distance ring from it
+  double minDistanceToRing(int ring) const { return ring > 0 ? (ring - 1) / invTileSize_ : 0.; }
+
+private:
+  int nColumns_;
+  int nRows_;
+  double xmin_;
+  double ymin_;
+  double invTileSize_;
+
+  std::vector<unsigned int> tile_;
+  std::vector<unsigned int> offsets_;
+  std::vector<unsigned int> fillPosition_;
+  std::vector<unsigned int> indices_;
+};
+
+#endif
@@ -85,18 +85,26 @@ void HGCalImagingAlgo::populate(const HGCRecHitCollection &hits) {
 // input (reset should be called between events)
 void HGCalImagingAlgo::makeClusters() {
   layerClustersPerLayer.resize(2 * maxlayer + 2);
+  if (useTiles_)
+    cells_.resize(2 * maxlayer + 2);
   // assign all hits in each layer to a cluster core or halo
   tbb::this_task_arena::isolate([&] {
     tbb::parallel_for(size_t(0), size_t(2 * maxlayer + 2), [&](size_t i) {
-      KDTreeBox bounds(minpos[i][0], maxpos[i][0], minpos[i][1], maxpos[i][1]);
-      KDTree hit_kdtree;
-      hit_kdtree.build(points[i], bounds);
-
       unsigned int actualLayer =
           i > maxlayer
               ? (i - (maxlayer + 1))
               : i; // maps back from index used for KD trees to actual layer
 
+      if (useTiles_) {
+        makeClustersWithTiles(points[i], cells_[i], minpos[i], maxpos[i],
+                              actualLayer, layerClustersPerLayer[i]);
+        return;
+      }
+
+      KDTreeBox bounds(minpos[i][0], maxpos[i][0], minpos[i][1], maxpos[i][1]);
+      KDTree hit_kdtree;
+      hit_kdtree.build(points[i], bounds);
+
       double maxdensity = calculateLocalDensity(
           points[i], hit_kdtree, actualLayer); // also stores rho (energy
                                                // density) for each point (node)
@@ -457,6 +465,240 @@ int HGCalImagingAlgo::findAndAssignClusters(
   return nClustersOnLayer;
 }
 
+// Same clustering as above for one layer, with the hits copied to per-field
+// arrays and the neighbours found with a grid of tiles of size delta_c. The
+// results are copied back to the KDNodes, so that getClusters is the same for
+// both methods.
+void HGCalImagingAlgo::makeClustersWithTiles(
+    std::vector<KDNode> &nd, CellsOnLayer &cells,
+    const std::array<float, 2> &minp, const std::array<float, 2> &maxp,
+    const unsigned int layer,
+    std::vector<std::vector<KDNode>> &clustersOnLayer) const {
+
+  float delta_c; // critical distance
+  if (layer <= lastLayerEE)
+    delta_c = vecDeltas[0];
+  else if (layer <= lastLayerFH)
+    delta_c = vecDeltas[1];
+  else
+    delta_c = vecDeltas[2];
+
+  const unsigned int nd_size = nd.size();
+  cells.x.resize(nd_size);
+  cells.y.resize(nd_size);
+  cells.weight.resize(nd_size);
+  cells.sigmaNoise.resize(nd_size);
+  for (unsigned int i = 0; i < nd_size; ++i) {
+    // the coordinates of the Hexel, as used by distance() with the KD-trees
+    cells.x[i] = nd[i].data.x;
+    cells.y[i] = nd[i].data.y;
+    cells.weight[i] = nd[i].data.weight;
+    cells.sigmaNoise[i] = nd[i].data.sigmaNoise;
+  }
+  cells.rho.assign(nd_size, 0.);
+  cells.delta.assign(nd_size, 0.);
+  cells.nearestHigher.assign(nd_size, -1);
+  cells.clusterIndex.assign(nd_size, -1);
+  cells.rank.resize(nd_size);
+  cells.isBorder.assign(nd_size, 0);
+  if (nd_size == 0)
+    return;
+
+  cells.tiles.fill(cells.x, cells.y, minp[0], maxp[0], minp[1], maxp[1],
+                   delta_c);
+
+  double maxdensity = calculateLocalDensity(cells, delta_c);
+  std::vector<size_t> rs =
+      sorted_indices(cells.rho); // indices sorted by decreasing rho
+  calculateDistanceToHigher(cells, rs);
+  const unsigned int nClustersOnLayer =
+      findAndAssignClusters(cells, rs, maxdensity, delta_c);
+
+  // copy back the results and fill the cluster vector
+  clustersOnLayer.resize(nClustersOnLayer);
+  std::vector<double> rho_b(nClustersOnLayer, 0.);
+  for (unsigned int i = 0; i < nd_size; ++i) {
+    int ci = cells.clusterIndex[i];
+    if (cells.isBorder[i] && rho_b[ci] < cells.rho[i])
+      rho_b[ci] = cells.rho[i];
+  }
+  for (unsigned int i = 0; i < nd_size; ++i) {
+    Hexel &hit = nd[i].data;
+    hit.rho = cells.rho[i];
+    hit.delta = cells.delta[i];
+    hit.nearestHigher = cells.nearestHigher[i];
+    hit.clusterIndex = cells.clusterIndex[i];
+    hit.isBorder = cells.isBorder[i];
+    int ci = hit.clusterIndex;
+    if (ci != -1) {
+      if (hit.rho <= rho_b[ci])
+        hit.isHalo = true;
+      clustersOnLayer[ci].push_back(nd[i]);
+    }
+  }
+}
+
+double HGCalImagingAlgo::calculateLocalDensity(CellsOnLayer &cells,
+                                               float delta_c) const {
+
+  const HGCalLayerTiles &tiles = cells.tiles;
+  double maxdensity = 0.;
+  const unsigned int n = cells.x.size();
+  for (unsigned int i = 0; i < n; ++i) {
+    // only the tiles overlapping the +/- delta_c window
+    std::array<int, 4> box =
+        tiles.searchBox(cells.x[i] - delta_c, cells.x[i] + delta_c,
+                        cells.y[i] - delta_c, cells.y[i] + delta_c);
+    double rho = 0.;
+    for (int ybin = box[2]; ybin <= box[3]; ++ybin) {
+      for (int xbin = box[0]; xbin <= box[1]; ++xbin) {
+        for (const unsigned int *j = tiles.begin(xbin, ybin);
+             j != tiles.end(xbin, ybin); ++j) {
+          if (std::sqrt(distance2(cells, i, *j)) < delta_c)
+            rho += cells.weight[*j];
+        }
+      }
+    }
+    cells.rho[i] = rho;
+    maxdensity = std::max(maxdensity, rho);
+  }
+  return maxdensity;
+}
+
+void HGCalImagingAlgo::calculateDistanceToHigher(
+    CellsOnLayer &cells, const std::vector<size_t> &rs) const {
+
+  const HGCalLayerTiles &tiles = cells.tiles;
+  const unsigned int n = rs.size();
+  for (unsigned int oi = 0; oi < n; ++oi)
+    cells.rank[rs[oi]] = oi;
+
+  // the highest density hit gets the distance to the most distant hit, as
+  // with the KD-tree
+  double max_dist2 = 0.;
+  for (unsigned int j = 0; j < n; ++j)
+    max_dist2 = std::max(max_dist2, distance2(cells, rs[0], j));
+  cells.delta[rs[0]] = std::sqrt(max_dist2);
+  cells.nearestHigher[rs[0]] = -1;
+
+  // for the others, look at the tiles in rings of increasing size around the
+  // hit until the ring is further than the closest denser hit found so far
+  for (unsigned int oi = 1; oi < n; ++oi) {
+    const unsigned int i = rs[oi];
+    const int xc = tiles.xBin(cells.x[i]);
+    const int yc = tiles.yBin(cells.y[i]);
+    double dist2 = max_dist2;
+    int nearestHigher = -1;
+    for (int ring = 0;; ++ring) {
+      if (nearestHigher != -1) {
+        // small margin for the rounding in the tile bins
+        const double dmin = tiles.minDistanceToRing(ring) * (1. - 1e-5);
+        if (dmin * dmin > dist2)
+          break;
+      }
+      if (xc - ring < 0 && xc + ring >= tiles.nColumns() && yc - ring < 0 &&
+          yc + ring >= tiles.nRows())
+        break;
+      for (int ybin = std::max(yc - ring, 0);
+           ybin <= std::min(yc + ring, tiles.nRows() - 1); ++ybin) {
+        // inner rows of the ring only have the first and last column
+        const bool fullRow = (ybin == yc - ring || ybin == yc + ring);
+        const int xstep = fullRow ? 1 : 2 * ring;
+        for (int xbin = xc - ring; xbin <= xc + ring; xbin += xstep) {
+          if (xbin < 0 || xbin >= tiles.nColumns())
+            continue;
+          for (const unsigned int *j = tiles.begin(xbin, ybin);
+               j != tiles.end(xbin, ybin); ++j) {
+            if (cells.rank[*j] >= oi)
+              continue;
+            double tmp = distance2(cells, i, *j);
+            // among hits at the same distance keep the one that comes last
+            // in the density order, as the loop on the sorted hits does
+            if (tmp < dist2 ||
+                (tmp == dist2 && (nearestHigher == -1 ||
+                                  cells.rank[*j] > cells.rank[nearestHigher]))) {
+              dist2 = tmp;
+              nearestHigher = *j;
+            }
+          }
+        }
+      }
+    }
+    cells.delta[i] = std::sqrt(dist2);
+    cells.nearestHigher[i] = nearestHigher;
+  }
+}
+
+unsigned int HGCalImagingAlgo::findAndAssignClusters(
+    CellsOnLayer &cells, const std::vector<size_t> &rs, double maxdensity,
+    float delta_c) const {
+
+  const HGCalLayerTiles &tiles = cells.tiles;
+  const unsigned int n = rs.size();
+
+  // sort in decreasing distance to higher
+  std::vector<size_t> ds(n);
+  std::iota(ds.begin(), ds.end(), 0);
+  std::sort(ds.begin(), ds.end(), [&cells](size_t i1, size_t i2) {
+    return cells.delta[i1] > cells.delta[i2];
+  });
+
+  unsigned int nClustersOnLayer = 0;
+  for (unsigned int k = 0; k < n; ++k) {
+    const unsigned int i = ds[k];
+    if (cells.delta[i] < delta_c)
+      break; // no more cluster centers to be looked at
+    if (dependSensor) {
+      float rho_c = kappa * cells.sigmaNoise[i];
+      if (cells.rho[i] < rho_c)
+        continue; // set equal to kappa times noise threshold
+    } else if (cells.rho[i] * kappa < maxdensity)
+      continue;
+    cells.clusterIndex[i] = nClustersOnLayer++;
+  }
+  if (nClustersOnLayer == 0)
+    return nClustersOnLayer;
+
+  // assign remaining points to the cluster of their nearest higher
+  for (unsigned int oi = 1; oi < n; ++oi) {
+    const unsigned int i = rs[oi];
+    if (cells.clusterIndex[i] == -1)
+      cells.clusterIndex[i] = cells.clusterIndex[cells.nearestHigher[i]];
+  }
+
+  // flag as border the hits within delta_c of a hit of another cluster, or
+  // further than delta_c from all the other hits of their cluster
+  for (unsigned int i = 0; i < n; ++i) {
+    const int ci = cells.clusterIndex[i];
+    if (ci == -1)
+      continue;
+    bool flag_isolated = true;
+    bool border = false;
+    std::array<int, 4> box =
+        tiles.searchBox(cells.x[i] - delta_c, cells.x[i] + delta_c,
+                        cells.y[i] - delta_c, cells.y[i] + delta_c);
+    for (int ybin = box[2]; ybin <= box[3] && !border; ++ybin) {
+      for (int xbin = box[0]; xbin <= box[1] && !border; ++xbin) {
+        for (const unsigned int *j = tiles.begin(xbin, ybin);
+             j != tiles.end(xbin, ybin); ++j) {
+          const int cj = cells.clusterIndex[*j];
+          if (cj == -1)
+            continue;
+          float dist = std::sqrt(distance2(cells, i, *j));
+          if (dist < delta_c && cj != ci) {
+            border = true;
+            break;
+          }
+          if (dist < delta_c && dist != 0. && cj == ci)
+            flag_isolated = false;
+        }
+      }
+    }
+    cells.isBorder[i] = (border || flag_isolated);
+  }
+  return nClustersOnLayer;
+}
+
 // find local maxima within delta_c, marking the indices in the cluster
 std::vector<unsigned>
 HGCalImagingAlgo::findLocalMaximaInCluster(const std::vector<KDNode> &cluster) {
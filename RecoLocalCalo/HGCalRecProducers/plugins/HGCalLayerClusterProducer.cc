@@ -92,6 +92,7 @@ HGCalLayerClusterProducer::HGCalLayerClusterProducer(const edm::ParameterSet &ps
   }else{
     algo = std::make_unique<HGCalImagingAlgo>(vecDeltas, kappa, ecut, algoId, dependSensor, dEdXweights, thicknessCorrection, fcPerMip, fcPerEle, nonAgedNoises, noiseMip, verbosity);
   }
+  algo->setUseTiles(ps.getParameter<bool>("useTiles"));
 
 
   produces<std::vector<reco::BasicCluster> >();
@@ -113,6 +114,7 @@ void HGCalLayerClusterProducer::fillDescriptions(edm::ConfigurationDescriptions&
   desc.add<bool>("dependSensor", true);
   desc.add<double>("ecut", 3.0);
   desc.add<double>("kappa", 9.0);
+  desc.add<bool>("useTiles", false);
   desc.addUntracked<unsigned int>("verbosity", 3);
   desc.add<edm::InputTag>("HGCEEInput", edm::InputTag("HGCalRecHit","HGCEERecHits"));
   desc.add<edm::InputTag>("HGCFHInput", edm::InputTag("HGCalRecHit","HGCHEFRecHits"));
@@ -0,0 +1,163 @@
+// -*- C++ -*-
+//
+// Package:    RecoLocalCalo/HGCalRecProducers
+// Class:      HGCalLayerClusterComparison
+//
+/**\class HGCalLayerClusterComparison HGCalLayerClusterComparison.cc RecoLocalCalo/HGCalRecProducers/test/HGCalLayerClusterComparison.cc
+
+ Description: Compares two collections of HGCal layer clusters
+
+ Implementation:
+     Clusters are matched by their lists of hits, e.g. to validate the
+     clustering with tiles (useTiles = True) against the one with KD-trees.
+     The number of clusters without an identical partner in the other
+     collection and the largest energy and position differences of the
+     matched ones are printed at the end of the job.
+*/
+
+
+// system include files
+#include <algorithm>
+#include <cmath>
+#include <map>
+#include <vector>
+
+// user include files
+#include "FWCore/Framework/interface/Frameworkfwd.h"
+#include "FWCore/Framework/interface/one/EDAnalyzer.h"
+#include "FWCore/Framework/interface/Event.h"
+#include "FWCore/Framework/interface/MakerMacros.h"
+#include "FWCore/ParameterSet/interface/ParameterSet.h"
+#include "FWCore/MessageLogger/interface/MessageLogger.h"
+
+#include "DataFormats/EgammaReco/interface/BasicCluster.h"
+
+//
+// class declaration
+//
+
+class HGCalLayerClusterComparison : public edm::one::EDAnalyzer<>  {
+   public:
+      explicit HGCalLayerClusterComparison(const edm::ParameterSet&);
+      ~HGCalLayerClusterComparison() override;
+
+      static void fillDescriptions(edm::ConfigurationDescriptions& descriptions);
+
+   private:
+      void analyze(const edm::Event&, const edm::EventSetup&) override;
+      void endJob() override;
+
+      typedef std::vector<uint32_t> HitList;
+      static HitList hits(const reco::BasicCluster&);
+
+  // ----------member data ---------------------------
+
+  edm::EDGetTokenT<std::vector<reco::BasicCluster>> token_reference_;
+  edm::EDGetTokenT<std::vector<reco::BasicCluster>> token_test_;
+
+  unsigned long nEvents_;
+  unsigned long nReference_;
+  unsigned long nTest_;
+  unsigned long nUnmatchedReference_;
+  unsigned long nUnmatchedTest_;
+  double maxEnergyDiff_;
+  double maxPositionDiff_;
+};
+
+HGCalLayerClusterComparison::HGCalLayerClusterComparison(const edm::ParameterSet& iConfig)
+  : token_reference_(consumes<std::vector<reco::BasicCluster>>(iConfig.getParameter<edm::InputTag>("reference"))),
+    token_test_(consumes<std::vector<reco::BasicCluster>>(iConfig.getParameter<edm::InputTag>("test"))),
+    nEvents_(0),
+    nReference_(0),
+    nTest_(0),
+    nUnmatchedReference_(0),
+    nUnmatchedTest_(0),
+    maxEnergyDiff_(0.),
+    maxPositionDiff_(0.)
+{
+}
+
+
+HGCalLayerClusterComparison::~HGCalLayerClusterComparison()
+{
+}
+
+
+//
+// member functions
+//
+
+HGCalLayerClusterComparison::HitList
+HGCalLayerClusterComparison::hits(const reco::BasicCluster& cluster)
+{
+  HitList ids;
+  for (const auto& hf : cluster.hitsAndFractions()) ids.push_back(hf.first.rawId());
+  std::sort(ids.begin(), ids.end());
+  return ids;
+}
+
+// ------------ method called for each event  ------------
+void HGCalLayerClusterComparison::analyze(const edm::Event& iEvent, const edm::EventSetup& iSetup)
+{
+  edm::Handle<std::vector<reco::BasicCluster>> hReference;
+  iEvent.getByToken(token_reference_, hReference);
+  edm::Handle<std::vector<reco::BasicCluster>> hTest;
+  iEvent.getByToken(token_test_, hTest);
+
+  ++nEvents_;
+  nReference_ += hReference->size();
+  nTest_ += hTest->size();
+
+  // the order of the clusters depends on the order of the seeds, match them by their hits
+  std::multimap<HitList, const reco::BasicCluster*> reference;
+  for (const auto& cluster : *hReference) reference.emplace(hits(cluster), &cluster);
+
+  unsigned int nUnmatched = 0;
+  for (const auto& cluster : *hTest) {
+    auto match = reference.find(hits(cluster));
+    if (match == reference.end()) {
+      ++nUnmatched;
+      continue;
+    }
+    const reco::BasicCluster& expected = *match->second;
+    maxEnergyDiff_ = std::max(maxEnergyDiff_, std::abs(cluster.energy() - expected.energy()));
+    maxPositionDiff_ = std::max(maxPositionDiff_, (cluster.position() - expected.position()).R());
+    reference.erase(match);
+  }
+  nUnmatchedTest_ += nUnmatched;
+  nUnmatchedReference_ += reference.size();
+
+  if (nUnmatched || !reference.empty())
+    edm::LogWarning("HGCalLayerClusterComparison")
+      << "event " << iEvent.id() << ": " << reference.size() << " of " << hReference->size()
+      << " reference clusters and " << nUnmatched << " of " << hTest->size()
+      << " test clusters without an identical partner";
+}
+
+
+// ------------ method called once each job just after ending the event loop  ------------
+void
+HGCalLayerClusterComparison::endJob()
+{
+  edm::LogPrint("HGCalLayerClusterComparison")
+    << "Layer clusters compared in " << nEvents_ << " events\n"
+    << "  reference: " << nReference_ << " clusters, " << nUnmatchedReference_ << " without partner\n"
+    << "  test:      " << nTest_ << " clusters, " << nUnmatchedTest_ << " without partner\n"
+    << "  largest difference of matched clusters: " << maxEnergyDiff_ << " GeV, "
+    << maxPositionDiff_ << " cm";
+}
+
+
+// ------------ method fills 'descriptions' with the allowed parameters for the module  ------------
+void
+HGCalLayerClusterComparison::fillDescriptions(edm::ConfigurationDescriptions& descriptions) {
+  edm::ParameterSetDescription desc;
+
+  desc.add<edm::InputTag>("reference", edm::InputTag("hgcalLayerClusters"));
+  desc.add<edm::InputTag>("test", edm::InputTag("hgcalLayerClustersWithTiles"));
+
+  descriptions.addDefault(desc);
+}
+
+//define this as a plug-in
+DEFINE_FWK_MODULE(HGCalLayerClusterComparison);
@@ -0,0 +1,39 @@
+import FWCore.ParameterSet.Config as cms
+import FWCore.ParameterSet.VarParsing as VarParsing
+
+# rerun the layer clustering with KD-trees and with tiles on events with HGCal
+# rechits and compare the clusters, e.g.
+#   cmsRun hgcalLayerClusterComparison_cfg.py inputFiles=file:step3.root
+
+process = cms.Process("HGCalLayerClusterComparison")
+
+options = VarParsing.VarParsing('analysis')
+options.register ('globalTag',
+                  "auto:phase2_realistic",
+                  VarParsing.VarParsing.multiplicity.singleton,
+                  VarParsing.VarParsing.varType.string,
+                  "GlobalTag")
+options.parseArguments()
+
+process.maxEvents = cms.untracked.PSet( input = cms.untracked.int32(options.maxEvents) )
+process.source = cms.Source("PoolSource",
+    fileNames = cms.untracked.vstring(options.inputFiles)
+)
+
+process.load("FWCore.MessageLogger.MessageLogger_cfi")
+process.MessageLogger.cerr.FwkReport.reportEvery = 10
+process.load('Configuration.Geometry.GeometryExtended2023D17Reco_cff')
+process.load("Configuration.StandardSequences.FrontierConditions_GlobalTag_cff")
+from Configuration.AlCa.GlobalTag import GlobalTag
+process.GlobalTag = GlobalTag(process.GlobalTag, options.globalTag, '')
+
+process.load("RecoLocalCalo.HGCalRecProducers.hgcalLayerClusters_cff")
+process.hgcalLayerClustersWithTiles = process.hgcalLayerClusters.clone(useTiles = True)
+
+process.hgcalLayerClusterComparison = cms.EDAnalyzer('HGCalLayerClusterComparison',
+                                                     reference = cms.InputTag("hgcalLayerClusters"),
+                                                     test = cms.InputTag("hgcalLayerClustersWithTiles"))
+
+process.p = cms.Path(process.hgcalLayerClusters +
+                     process.hgcalLayerClustersWithTiles +
+                     process.hgcalLayerClusterComparison)
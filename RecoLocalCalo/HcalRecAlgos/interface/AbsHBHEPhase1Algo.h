@@ -1,6 +1,8 @@
 #ifndef RecoLocalCalo_HcalRecAlgos_AbsHBHEPhase1Algo_h_
 #define RecoLocalCalo_HcalRecAlgos_AbsHBHEPhase1Algo_h_
 
+#include <vector>
+
 #include "FWCore/Framework/interface/Frameworkfwd.h"
 #include "DataFormats/HcalRecHit/interface/HBHERecHit.h"
 #include "DataFormats/HcalRecHit/interface/HBHEChannelInfo.h"
@@ -51,6 +53,23 @@ public:
                                    const HcalRecoParam* params,
                                    const HcalCalibrations& calibs,
                                    bool isRealData) = 0;
+
+    // Reconstruct several channels at once, filling "rechits" in the
+    // order of "infos". Algorithms which profit from processing channels
+    // together override this method, the default implementation simply
+    // calls "reconstruct" for each channel. The three input vectors must
+    // have the same length, and the "params" pointers are allowed to be null.
+    inline virtual void reconstructBatch(const std::vector<const HBHEChannelInfo*>& infos,
+                                         const std::vector<const HcalRecoParam*>& params,
+                                         const std::vector<const HcalCalibrations*>& calibs,
+                                         const bool isRealData,
+                                         std::vector<HBHERecHit>& rechits)
+    {
+        rechits.clear();
+        rechits.reserve(infos.size());
+        for (unsigned i=0; i<infos.size(); ++i)
+            rechits.push_back(reconstruct(*infos[i], params[i], *calibs[i], isRealData));
+    }
 };
 
 #endif // RecoLocalCalo_HcalRecAlgos_AbsHBHEPhase1Algo_h_
@@ -14,6 +14,9 @@
 
 #include <Math/Functor.h>
 
+#include <array>
+#include <vector>
+
 struct MahiNnlsWorkspace {
 
   unsigned int nPulseTot;
@@ -79,6 +82,53 @@ struct MahiNnlsWorkspace {
 
 };
 
+//pulse shape, derivative and covariance of a pulse with charge below the
+//time slew threshold, identical for all the channels of a batch
+struct MahiLowChargePulse {
+
+  bool valid;
+  int maxoffset;
+  int bxOffset;
+
+  FullSampleVector pulseShape;
+  FullSampleVector pulseDeriv;
+  FullSampleMatrix pulseCov;
+
+};
+
+//inputs of the fits of a batch, stored time slice by time slice
+//so that they are computed for all the channels at once
+struct MahiBatchWorkspace {
+
+  unsigned int nChannels;
+
+  std::vector<double> charge;
+  std::vector<double> pedestal;
+  std::vector<double> pedestalWidth;
+  std::vector<double> dfcPerADC;
+  std::vector<double> fcByPE;
+  std::vector<double> gain;
+
+  std::vector<double> amplitudes;
+  std::vector<double> noiseTerms;
+  std::vector<float> pedConstraint;
+  std::vector<double> tsTOT;
+  std::vector<double> tstrig;
+
+  //one entry for the single pulse pre-fit and one for the configured BXs
+  std::array<MahiLowChargePulse, 2> lowChargePulse;
+
+};
+
+struct MahiFitResult {
+
+  float energy = 0.f;
+  float time = 0.f;
+  float chi2 = -1.f;
+  bool useTriple = false;
+
+};
+
 struct MahiDebugInfo {
 
   int   nSamples;
@@ -133,6 +183,19 @@ class MahiFit
 		   bool& useTriple,
 		   float& chi2) const;
 
+  // Fit a batch of channels with the same pulse shape template, set before
+  // with setPulseShapeTemplate, and with the same number of time slices, SOI
+  // and time information (see sameBatch). The inputs of the fits are prepared
+  // for all the channels together and the pulse shapes of the pulses below
+  // the time slew threshold are computed once per batch. The results are
+  // the same as calling phase1Apply for each channel.
+  void phase1ApplyBatch(const std::vector<const HBHEChannelInfo*>& channels,
+			std::vector<MahiFitResult>& results) const;
+
+  // Ordering of the channels grouping the ones which can be fitted in the same batch
+  static bool batchOrder(const HBHEChannelInfo& a, const HBHEChannelInfo& b);
+  static bool sameBatch(const HBHEChannelInfo& a, const HBHEChannelInfo& b);
+
   void phase1Debug(const HBHEChannelInfo& channelData,
 		   MahiDebugInfo& mdi) const;
 
@@ -147,6 +210,12 @@ class MahiFit
 
  private:
 
+  void fitWorkspace(double tstrig, double tsTOT, double gain,
+		    float& reconstructedEnergy,
+		    float& reconstructedTime,
+		    bool& useTriple,
+		    float& chi2) const;
+
   double minimize() const;
   void onePulseMinimize() const;
   void updateCov() const;
@@ -165,6 +234,10 @@ class MahiFit
   void solveSubmatrix(PulseMatrix& mat, PulseVector& invec, PulseVector& outvec, unsigned nP) const;
 
   mutable MahiNnlsWorkspace nnlsWork_;
+  mutable MahiBatchWorkspace batchWork_;
+
+  // set while fitting a batch, enables the low charge pulse shape cache
+  mutable bool inBatch_ = false;
 
   //hard coded in initializer
   const unsigned int fullTSSize_;
@@ -61,6 +61,15 @@ public:
                                    const HcalRecoParam* params,
                                    const HcalCalibrations& calibs,
                                    bool isRealData) override;
+
+    // Mahi is run on the groups of channels sharing the pulse shape
+    // and the number of time slices (see MahiFit::phase1ApplyBatch)
+    void reconstructBatch(const std::vector<const HBHEChannelInfo*>& infos,
+                          const std::vector<const HcalRecoParam*>& params,
+                          const std::vector<const HcalCalibrations*>& calibs,
+                          bool isRealData,
+                          std::vector<HBHERecHit>& rechits) override;
+
     // Basic accessors
     inline int getFirstSampleShift() const {return firstSampleShift_;}
     inline int getSamplesToAdd() const {return samplesToAdd_;}
@@ -90,6 +99,13 @@ protected:
                  const HcalCalibrations& calibs,
                  int nSamplesToExamine) const;
 private:
+    // Everything but Mahi, which is passed already fitted if enabled
+    HBHERecHit makeRecHit(const HBHEChannelInfo& info,
+                          const HcalRecoParam* params,
+                          const HcalCalibrations& calibs,
+                          bool isRealData,
+                          const MahiFitResult* mahiResult);
+
     HcalPulseContainmentManager pulseCorr_;
 
     int firstSampleShift_;
@@ -108,6 +124,12 @@ private:
     // Mahi algorithm
     std::unique_ptr<MahiFit> mahiOOTpuCorr_;
 
+    // Work vectors for reconstructBatch
+    std::vector<unsigned> batchOrder_;
+    std::vector<const HBHEChannelInfo*> batchInfos_;
+    std::vector<MahiFitResult> batchGroupResults_;
+    std::vector<MahiFitResult> batchResults_;
+
     HcalPulseShapes theHcalPulseShapes_;
 };
 
@@ -66,8 +66,6 @@ void MahiFit::phase1Apply(const HBHEChannelInfo& channelData,
   nnlsWork_.amplitudes.resize(nnlsWork_.tsSize);
   nnlsWork_.noiseTerms.resize(nnlsWork_.tsSize);
 
-  std::array<float,3> reconstructedVals {{ 0.0, -9999, -9999 }};
-  
   double tsTOT = 0, tstrig = 0; // in GeV
   for(unsigned int iTS=0; iTS<nnlsWork_.tsSize; ++iTS){
     double charge = channelData.tsRawCharge(iTS);
@@ -96,6 +94,19 @@ void MahiFit::phase1Apply(const HBHEChannelInfo& channelData,
     }
   }
 
+  fitWorkspace(tstrig, tsTOT, channelData.tsGain(0),
+	       reconstructedEnergy, reconstructedTime, useTriple, chi2);
+
+}
+
+void MahiFit::fitWorkspace(double tstrig, double tsTOT, double gain,
+			   float& reconstructedEnergy,
+			   float& reconstructedTime,
+			   bool& useTriple,
+			   float& chi2) const {
+
+  std::array<float,3> reconstructedVals {{ 0.0, -9999, -9999 }};
+
   if(tstrig >= ts4Thresh_ && tsTOT > 0) {
 
     useTriple=false;
@@ -119,12 +130,139 @@ void MahiFit::phase1Apply(const HBHEChannelInfo& channelData,
     reconstructedVals.at(2) = -9999.; //chi2
   }
   
-  reconstructedEnergy = reconstructedVals[0]*channelData.tsGain(0);
+  reconstructedEnergy = reconstructedVals[0]*gain;
   reconstructedTime = reconstructedVals[1];
   chi2 = reconstructedVals[2];
 
 }
 
+bool MahiFit::batchOrder(const HBHEChannelInfo& a, const HBHEChannelInfo& b) {
+  if (a.recoShape()!=b.recoShape()) return a.recoShape()<b.recoShape();
+  if (a.nSamples()!=b.nSamples()) return a.nSamples()<b.nSamples();
+  if (a.soi()!=b.soi()) return a.soi()<b.soi();
+  return a.hasTimeInfo()<b.hasTimeInfo();
+}
+
+bool MahiFit::sameBatch(const HBHEChannelInfo& a, const HBHEChannelInfo& b) {
+  return a.recoShape()==b.recoShape() && a.nSamples()==b.nSamples() &&
+    a.soi()==b.soi() && a.hasTimeInfo()==b.hasTimeInfo();
+}
+
+void MahiFit::phase1ApplyBatch(const std::vector<const HBHEChannelInfo*>& channels,
+			       std::vector<MahiFitResult>& results) const {
+
+  const unsigned int nCh = channels.size();
+  results.assign(nCh, MahiFitResult());
+  if (nCh==0) return;
+
+  const HBHEChannelInfo& first = *channels[0];
+  assert(first.nSamples()==8||first.nSamples()==10);
+  for (unsigned int iCh=1; iCh<nCh; ++iCh) {
+    if (!sameBatch(first, *channels[iCh])) {
+      throw cms::Exception("HcalMahiWeirdState")
+	<< "Channels with different pulse shapes or time slices in the same Mahi batch";
+    }
+  }
+
+  const unsigned int tsSize = first.nSamples();
+  MahiBatchWorkspace& bw = batchWork_;
+  bw.nChannels = nCh;
+
+  // gather the inputs time slice by time slice (index iTS*nCh+iCh)
+  bw.charge.resize(tsSize*nCh);
+  bw.pedestal.resize(tsSize*nCh);
+  bw.pedestalWidth.resize(tsSize*nCh);
+  bw.dfcPerADC.resize(tsSize*nCh);
+  bw.fcByPE.resize(nCh);
+  bw.gain.resize(nCh);
+  bw.pedConstraint.resize(nCh);
+
+  for (unsigned int iCh=0; iCh<nCh; ++iCh) {
+    const HBHEChannelInfo& channelData = *channels[iCh];
+    for (unsigned int iTS=0; iTS<tsSize; ++iTS) {
+      bw.charge[iTS*nCh+iCh] = channelData.tsRawCharge(iTS);
+      bw.pedestal[iTS*nCh+iCh] = channelData.tsPedestal(iTS);
+      bw.pedestalWidth[iTS*nCh+iCh] = channelData.tsPedestalWidth(iTS);
+      bw.dfcPerADC[iTS*nCh+iCh] = channelData.tsDFcPerADC(iTS);
+    }
+    bw.fcByPE[iCh] = channelData.fcByPE();
+    bw.gain[iCh] = channelData.tsGain(0);
+
+    bw.pedConstraint[iCh] = 0.25*( channelData.tsPedestalWidth(0)*channelData.tsPedestalWidth(0)+
+				   channelData.tsPedestalWidth(1)*channelData.tsPedestalWidth(1)+
+				   channelData.tsPedestalWidth(2)*channelData.tsPedestalWidth(2)+
+				   channelData.tsPedestalWidth(3)*channelData.tsPedestalWidth(3) );
+  }
+
+  // amplitudes and noise terms of all the channels, same expressions as in phase1Apply
+  bw.amplitudes.resize(tsSize*nCh);
+  bw.noiseTerms.resize(tsSize*nCh);
+  bw.tsTOT.assign(nCh, 0.);
+  bw.tstrig.assign(nCh, 0.);
+
+  const unsigned int tsOffset = first.soi();
+  for (unsigned int iTS=0; iTS<tsSize; ++iTS) {
+    const double* charge = &bw.charge[iTS*nCh];
+    const double* ped = &bw.pedestal[iTS*nCh];
+    const double* pedWidth = &bw.pedestalWidth[iTS*nCh];
+    const double* dfc = &bw.dfcPerADC[iTS*nCh];
+    double* amplitudes = &bw.amplitudes[iTS*nCh];
+    double* noiseTerms = &bw.noiseTerms[iTS*nCh];
+
+    for (unsigned int iCh=0; iCh<nCh; ++iCh) {
+      const double amplitude = charge[iCh] - ped[iCh];
+      amplitudes[iCh] = amplitude;
+
+      const double noiseADC = (1./sqrt(12))*dfc[iCh];
+      const double noisePhoto = amplitude>pedWidth[iCh] ? sqrt(amplitude*bw.fcByPE[iCh]) : 0.;
+      noiseTerms[iCh] = noiseADC*noiseADC + noisePhoto*noisePhoto + pedWidth[iCh]*pedWidth[iCh];
+
+      bw.tsTOT[iCh] += amplitude*bw.gain[iCh];
+    }
+    if (iTS==tsOffset) {
+      for (unsigned int iCh=0; iCh<nCh; ++iCh) {
+	bw.tstrig[iCh] += amplitudes[iCh]*bw.gain[iCh];
+      }
+    }
+  }
+
+  // the low charge pulse shapes are filled by the first channel which needs them
+  for (auto& lcp : bw.lowChargePulse) lcp.valid = false;
+  inBatch_ = true;
+
+  try {
+    for (unsigned int iCh=0; iCh<nCh; ++iCh) {
+
+      resetWorkspace();
+
+      nnlsWork_.tsSize = tsSize;
+      nnlsWork_.tsOffset = tsOffset;
+      nnlsWork_.fullTSOffset = fullTSofInterest_ - nnlsWork_.tsOffset;
+
+      if (first.hasTimeInfo()) nnlsWork_.dt=timeSigmaSiPM_;
+      else nnlsWork_.dt=timeSigmaHPD_;
+
+      nnlsWork_.pedConstraint.setConstant(nnlsWork_.tsSize, nnlsWork_.tsSize, bw.pedConstraint[iCh]);
+      nnlsWork_.amplitudes.resize(nnlsWork_.tsSize);
+      nnlsWork_.noiseTerms.resize(nnlsWork_.tsSize);
+      for (unsigned int iTS=0; iTS<tsSize; ++iTS) {
+	nnlsWork_.amplitudes.coeffRef(iTS) = bw.amplitudes[iTS*nCh+iCh];
+	nnlsWork_.noiseTerms.coeffRef(iTS) = bw.noiseTerms[iTS*nCh+iCh];
+      }
+
+      MahiFitResult& result = results[iCh];
+      fitWorkspace(bw.tstrig[iCh], bw.tsTOT[iCh], bw.gain[iCh],
+		   result.energy, result.time, result.useTriple, result.chi2);
+    }
+  }
+  catch (...) {
+    inBatch_ = false;
+    throw;
+  }
+  inBatch_ = false;
+
+}
+
 void MahiFit::doFit(std::array<float,3> &correctedOutput, int nbx) const {
 
   unsigned int bxSize=1;
@@ -249,6 +387,20 @@ double MahiFit::minimize() const {
 void MahiFit::updatePulseShape(double itQ, FullSampleVector &pulseShape, FullSampleVector &pulseDeriv,
 			       FullSampleMatrix &pulseCov) const {
   
+  // below the time slew threshold the pulse only depends on the batch
+  MahiLowChargePulse* lowChargePulse = nullptr;
+  if (inBatch_ && (!applyTimeSlew_ || itQ<=1.0)) {
+    for (auto& lcp : batchWork_.lowChargePulse) {
+      if (lcp.valid && lcp.maxoffset==nnlsWork_.maxoffset && lcp.bxOffset==nnlsWork_.bxOffset) {
+	pulseShape = lcp.pulseShape;
+	pulseDeriv = lcp.pulseDeriv;
+	pulseCov = lcp.pulseCov;
+	return;
+      }
+      if (!lowChargePulse && !lcp.valid) lowChargePulse = &lcp;
+    }
+  }
+
   float t0=meanTime_;
 
   if(applyTimeSlew_) {
@@ -297,6 +449,15 @@ void MahiFit::updatePulseShape(double itQ, FullSampleVector &pulseShape, FullSam
       
     }
   }
+
+  if (lowChargePulse) {
+    lowChargePulse->valid = true;
+    lowChargePulse->maxoffset = nnlsWork_.maxoffset;
+    lowChargePulse->bxOffset = nnlsWork_.bxOffset;
+    lowChargePulse->pulseShape = pulseShape;
+    lowChargePulse->pulseDeriv = pulseDeriv;
+    lowChargePulse->pulseCov = pulseCov;
+  }
   
 }
 
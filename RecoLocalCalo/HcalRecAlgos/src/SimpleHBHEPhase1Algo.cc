@@ -60,6 +60,73 @@ HBHERecHit SimpleHBHEPhase1Algo::reconstruct(const HBHEChannelInfo& info,
                                              const HcalRecoParam* params,
                                              const HcalCalibrations& calibs,
                                              const bool isData)
+{
+    // Run Mahi
+    MahiFitResult m4;
+    const MahiFit* mahi = mahiOOTpuCorr_.get();
+    if (mahi)
+    {
+        mahiOOTpuCorr_->setPulseShapeTemplate(theHcalPulseShapes_.getShape(info.recoShape()),hcalTimeSlew_delay_);
+        mahi->phase1Apply(info,m4.energy,m4.time,m4.useTriple,m4.chi2);
+    }
+
+    return makeRecHit(info, params, calibs, isData, mahi ? &m4 : nullptr);
+}
+
+void SimpleHBHEPhase1Algo::reconstructBatch(const std::vector<const HBHEChannelInfo*>& infos,
+                                            const std::vector<const HcalRecoParam*>& params,
+                                            const std::vector<const HcalCalibrations*>& calibs,
+                                            const bool isData,
+                                            std::vector<HBHERecHit>& rechits)
+{
+    const MahiFit* mahi = mahiOOTpuCorr_.get();
+    if (!mahi)
+    {
+        AbsHBHEPhase1Algo::reconstructBatch(infos, params, calibs, isData, rechits);
+        return;
+    }
+
+    // Group the channels which can be fitted together. Sorting also
+    // avoids switching the Mahi pulse shape template back and forth.
+    const unsigned nChannels = infos.size();
+    batchOrder_.resize(nChannels);
+    for (unsigned i=0; i<nChannels; ++i)
+        batchOrder_[i] = i;
+    std::stable_sort(batchOrder_.begin(), batchOrder_.end(),
+                     [&infos](const unsigned a, const unsigned b)
+                     {return MahiFit::batchOrder(*infos[a], *infos[b]);});
+
+    batchResults_.resize(nChannels);
+    for (unsigned ibeg=0; ibeg<nChannels; )
+    {
+        const HBHEChannelInfo& first = *infos[batchOrder_[ibeg]];
+        unsigned iend = ibeg + 1;
+        while (iend < nChannels && MahiFit::sameBatch(first, *infos[batchOrder_[iend]]))
+            ++iend;
+
+        batchInfos_.clear();
+        for (unsigned i=ibeg; i<iend; ++i)
+            batchInfos_.push_back(infos[batchOrder_[i]]);
+
+        mahiOOTpuCorr_->setPulseShapeTemplate(theHcalPulseShapes_.getShape(first.recoShape()),hcalTimeSlew_delay_);
+        mahi->phase1ApplyBatch(batchInfos_, batchGroupResults_);
+
+        for (unsigned i=ibeg; i<iend; ++i)
+            batchResults_[batchOrder_[i]] = batchGroupResults_[i - ibeg];
+        ibeg = iend;
+    }
+
+    rechits.clear();
+    rechits.reserve(nChannels);
+    for (unsigned i=0; i<nChannels; ++i)
+        rechits.push_back(makeRecHit(*infos[i], params[i], *calibs[i], isData, &batchResults_[i]));
+}
+
+HBHERecHit SimpleHBHEPhase1Algo::makeRecHit(const HBHEChannelInfo& info,
+                                            const HcalRecoParam* params,
+                                            const HcalCalibrations& calibs,
+                                            const bool isData,
+                                            const MahiFitResult* mahiResult)
 {
     HBHERecHit rh;
 
@@ -104,16 +171,16 @@ HBHERecHit SimpleHBHEPhase1Algo::reconstruct(const HBHEChannelInfo& info,
         m3E *= hbminusCorrectionFactor(channelId, m3E, isData);
     }
 
-    // Run Mahi
+    // Mahi results
     float m4E = 0.f, m4chi2 = -1.f;
     float m4T = 0.f;
     bool m4UseTriple=false;
 
-    const MahiFit* mahi = mahiOOTpuCorr_.get();
-
-    if (mahi) {
-      mahiOOTpuCorr_->setPulseShapeTemplate(theHcalPulseShapes_.getShape(info.recoShape()),hcalTimeSlew_delay_);
-      mahi->phase1Apply(info,m4E,m4T,m4UseTriple,m4chi2);
+    if (mahiResult) {
+      m4E = mahiResult->energy;
+      m4T = mahiResult->time;
+      m4UseTriple = mahiResult->useTriple;
+      m4chi2 = mahiResult->chi2;
       m4E *= hbminusCorrectionFactor(channelId, m4E, isData);
     }
 
@@ -121,7 +188,7 @@ HBHERecHit SimpleHBHEPhase1Algo::reconstruct(const HBHEChannelInfo& info,
     float rhE = m0E;
     float rht = m0t;
     float rhX = -1.f;
-    if (mahi) 
+    if (mahiResult) 
     {
       rhE = m4E;
       rht = m4T;
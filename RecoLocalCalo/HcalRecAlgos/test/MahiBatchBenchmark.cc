@@ -0,0 +1,224 @@
+// -*- C++ -*-
+//
+// Package:    RecoLocalCalo/HcalRecAlgos
+// Class:      MahiBatchBenchmark
+//
+/**\class MahiBatchBenchmark MahiBatchBenchmark.cc RecoLocalCalo/HcalRecAlgos/test/MahiBatchBenchmark.cc
+
+ Description: Microbenchmark of the Mahi fit run channel by channel and in batches
+
+ Implementation:
+     Reads the HBHEChannelInfo collections stored by the HBHE reconstruction
+     (saveInfos = True) and fits all the channels of the event "repeat" times
+     with MahiFit::phase1Apply and with MahiFit::phase1ApplyBatch, on channels
+     grouped as in SimpleHBHEPhase1Algo::reconstructBatch. The time spent in
+     each mode and the number of channels with different results are printed
+     at the end of the job.
+*/
+
+
+// system include files
+#include <algorithm>
+#include <chrono>
+#include <memory>
+#include <vector>
+
+// user include files
+#include "FWCore/Framework/interface/Frameworkfwd.h"
+#include "FWCore/Framework/interface/one/EDAnalyzer.h"
+#include "FWCore/Framework/interface/Event.h"
+#include "FWCore/Framework/interface/EventSetup.h"
+#include "FWCore/Framework/interface/ESHandle.h"
+#include "FWCore/Framework/interface/MakerMacros.h"
+#include "FWCore/ParameterSet/interface/ParameterSet.h"
+#include "FWCore/MessageLogger/interface/MessageLogger.h"
+
+#include "DataFormats/HcalRecHit/interface/HcalRecHitCollections.h"
+#include "CondFormats/DataRecord/interface/HcalTimeSlewRecord.h"
+#include "CalibCalorimetry/HcalAlgos/interface/HcalPulseShapes.h"
+#include "CalibCalorimetry/HcalAlgos/interface/HcalTimeSlew.h"
+
+#include "RecoLocalCalo/HcalRecAlgos/interface/MahiFit.h"
+
+//
+// class declaration
+//
+
+class MahiBatchBenchmark : public edm::one::EDAnalyzer<>  {
+   public:
+      explicit MahiBatchBenchmark(const edm::ParameterSet&);
+      ~MahiBatchBenchmark() override;
+
+      static void fillDescriptions(edm::ConfigurationDescriptions& descriptions);
+
+   private:
+      void analyze(const edm::Event&, const edm::EventSetup&) override;
+      void endJob() override;
+
+  // ----------member data ---------------------------
+
+  edm::EDGetTokenT<HBHEChannelInfoCollection> token_ChannelInfo_;
+  unsigned int repeat_;
+
+  HcalPulseShapes theHcalPulseShapes_;
+  std::unique_ptr<MahiFit> scalarMahi_;
+  std::unique_ptr<MahiFit> batchMahi_;
+
+  std::vector<unsigned int> order_;
+  std::vector<const HBHEChannelInfo*> group_;
+  std::vector<MahiFitResult> scalarResults_;
+  std::vector<MahiFitResult> groupResults_;
+
+  unsigned long nEvents_;
+  unsigned long nChannels_;
+  unsigned long nGroups_;
+  unsigned long nMismatches_;
+  double scalarTime_;
+  double batchTime_;
+};
+
+MahiBatchBenchmark::MahiBatchBenchmark(const edm::ParameterSet& iConfig)
+  : token_ChannelInfo_(consumes<HBHEChannelInfoCollection>(iConfig.getParameter<edm::InputTag>("src"))),
+    repeat_(iConfig.getParameter<unsigned int>("repeat")),
+    nEvents_(0),
+    nChannels_(0),
+    nGroups_(0),
+    nMismatches_(0),
+    scalarTime_(0.),
+    batchTime_(0.)
+{
+  for (auto mahi : {&scalarMahi_, &batchMahi_}) {
+    *mahi = std::make_unique<MahiFit>();
+    (*mahi)->setParameters(iConfig.getParameter<bool>("dynamicPed"),
+			   iConfig.getParameter<double>("ts4Thresh"),
+			   iConfig.getParameter<double>("chiSqSwitch"),
+			   iConfig.getParameter<bool>("applyTimeSlew"),
+			   HcalTimeSlew::Medium,
+			   iConfig.getParameter<double>("meanTime"),
+			   iConfig.getParameter<double>("timeSigmaHPD"),
+			   iConfig.getParameter<double>("timeSigmaSiPM"),
+			   iConfig.getParameter<std::vector<int>>("activeBXs"),
+			   iConfig.getParameter<int>("nMaxItersMin"),
+			   iConfig.getParameter<int>("nMaxItersNNLS"),
+			   iConfig.getParameter<double>("deltaChiSqThresh"),
+			   iConfig.getParameter<double>("nnlsThresh"));
+  }
+}
+
+
+MahiBatchBenchmark::~MahiBatchBenchmark()
+{
+}
+
+
+//
+// member functions
+//
+
+// ------------ method called for each event  ------------
+void MahiBatchBenchmark::analyze(const edm::Event& iEvent, const edm::EventSetup& iSetup)
+{
+  edm::ESHandle<HcalTimeSlew> delay;
+  iSetup.get<HcalTimeSlewRecord>().get("HBHE", delay);
+  const HcalTimeSlew* hcalTimeSlewDelay = &*delay;
+
+  edm::Handle<HBHEChannelInfoCollection> hChannelInfo;
+  iEvent.getByToken(token_ChannelInfo_, hChannelInfo);
+
+  const unsigned int nCh = hChannelInfo->size();
+  ++nEvents_;
+  nChannels_ += nCh;
+
+  // channel by channel, as in SimpleHBHEPhase1Algo::reconstruct
+  scalarResults_.resize(nCh);
+  auto start = std::chrono::steady_clock::now();
+  for (unsigned int irep=0; irep<repeat_; ++irep) {
+    for (unsigned int iCh=0; iCh<nCh; ++iCh) {
+      const HBHEChannelInfo& hci = (*hChannelInfo)[iCh];
+      MahiFitResult& result = scalarResults_[iCh];
+      result = MahiFitResult();
+      scalarMahi_->setPulseShapeTemplate(theHcalPulseShapes_.getShape(hci.recoShape()), hcalTimeSlewDelay);
+      scalarMahi_->phase1Apply(hci, result.energy, result.time, result.useTriple, result.chi2);
+    }
+  }
+  auto stop = std::chrono::steady_clock::now();
+  scalarTime_ += std::chrono::duration<double>(stop - start).count();
+
+  // in batches, as in SimpleHBHEPhase1Algo::reconstructBatch (sorting included)
+  start = std::chrono::steady_clock::now();
+  for (unsigned int irep=0; irep<repeat_; ++irep) {
+    order_.resize(nCh);
+    for (unsigned int iCh=0; iCh<nCh; ++iCh) order_[iCh] = iCh;
+    std::stable_sort(order_.begin(), order_.end(),
+		     [&hChannelInfo](unsigned int a, unsigned int b)
+		     {return MahiFit::batchOrder((*hChannelInfo)[a], (*hChannelInfo)[b]);});
+
+    for (unsigned int ibeg=0; ibeg<nCh; ) {
+      const HBHEChannelInfo& first = (*hChannelInfo)[order_[ibeg]];
+      unsigned int iend = ibeg + 1;
+      while (iend<nCh && MahiFit::sameBatch(first, (*hChannelInfo)[order_[iend]])) ++iend;
+      group_.clear();
+      for (unsigned int i=ibeg; i<iend; ++i) group_.push_back(&(*hChannelInfo)[order_[i]]);
+
+      batchMahi_->setPulseShapeTemplate(theHcalPulseShapes_.getShape(group_[0]->recoShape()), hcalTimeSlewDelay);
+      batchMahi_->phase1ApplyBatch(group_, groupResults_);
+
+      // compare with the channel by channel results once
+      if (irep==0) {
+	++nGroups_;
+	for (unsigned int i=0; i<group_.size(); ++i) {
+	  const MahiFitResult& expected = scalarResults_[order_[ibeg + i]];
+	  const MahiFitResult& result = groupResults_[i];
+	  if (result.energy!=expected.energy || result.time!=expected.time ||
+	      result.chi2!=expected.chi2 || result.useTriple!=expected.useTriple)
+	    ++nMismatches_;
+	}
+      }
+      ibeg = iend;
+    }
+  }
+  stop = std::chrono::steady_clock::now();
+  batchTime_ += std::chrono::duration<double>(stop - start).count();
+}
+
+
+// ------------ method called once each job just after ending the event loop  ------------
+void
+MahiBatchBenchmark::endJob()
+{
+  const double nFits = std::max(1., double(nChannels_)*repeat_);
+  edm::LogPrint("MahiBatchBenchmark")
+    << "Mahi fits of " << nChannels_ << " channels in " << nEvents_ << " events, "
+    << repeat_ << " times each\n"
+    << "  channel by channel: " << scalarTime_ << " s, " << 1e6*scalarTime_/nFits << " us per channel\n"
+    << "  in batches:         " << batchTime_ << " s, " << 1e6*batchTime_/nFits << " us per channel, "
+    << double(nChannels_)/std::max(1UL, nGroups_) << " channels per batch\n"
+    << "  channels with different results: " << nMismatches_;
+}
+
+
+// ------------ method fills 'descriptions' with the allowed parameters for the module  ------------
+void
+MahiBatchBenchmark::fillDescriptions(edm::ConfigurationDescriptions& descriptions) {
+  edm::ParameterSetDescription desc;
+
+  desc.add<edm::InputTag>("src", edm::InputTag("hbheprereco"));
+  desc.add<unsigned int>("repeat", 10);
+  desc.add<bool>  ("dynamicPed");
+  desc.add<double>("ts4Thresh");
+  desc.add<double>("chiSqSwitch");
+  desc.add<bool>  ("applyTimeSlew");
+  desc.add<double>("meanTime");
+  desc.add<double>("timeSigmaHPD");
+  desc.add<double>("timeSigmaSiPM");
+  desc.add<std::vector<int>>("activeBXs");
+  desc.add<int>   ("nMaxItersMin");
+  desc.add<int>   ("nMaxItersNNLS");
+  desc.add<double>("deltaChiSqThresh");
+  desc.add<double>("nnlsThresh");
+
+  descriptions.addDefault(desc);
+}
+
+//define this as a plug-in
+DEFINE_FWK_MODULE(MahiBatchBenchmark);
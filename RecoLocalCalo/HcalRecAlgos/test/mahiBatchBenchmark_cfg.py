@@ -0,0 +1,46 @@
+import FWCore.ParameterSet.Config as cms
+import FWCore.ParameterSet.VarParsing as VarParsing
+import RecoLocalCalo.HcalRecProducers.HBHEMethod2Parameters_cfi as method2
+import RecoLocalCalo.HcalRecProducers.HBHEMahiParameters_cfi as mahi
+
+# time the Mahi fit channel by channel and in batches on recorded HBHEChannelInfo
+# collections, e.g. from a reconstruction run with hbheprereco.saveInfos = True:
+#   cmsRun mahiBatchBenchmark_cfg.py inputFiles=file:hbheinfos.root globalTag=auto:run2_data
+
+process = cms.Process("MahiBatchBenchmark")
+
+options = VarParsing.VarParsing('analysis')
+options.register ('globalTag',
+                  "auto:run2_data",
+                  VarParsing.VarParsing.multiplicity.singleton,
+                  VarParsing.VarParsing.varType.string,
+                  "GlobalTag")
+options.register ('repeat',
+                  10,
+                  VarParsing.VarParsing.multiplicity.singleton,
+                  VarParsing.VarParsing.varType.int,
+                  "number of times each event is fitted")
+options.parseArguments()
+
+process.maxEvents = cms.untracked.PSet( input = cms.untracked.int32(options.maxEvents) )
+process.source = cms.Source("PoolSource",
+    fileNames = cms.untracked.vstring(options.inputFiles)
+)
+
+process.load("FWCore.MessageLogger.MessageLogger_cfi")
+process.MessageLogger.cerr.FwkReport.reportEvery = 100
+process.load("Configuration.StandardSequences.FrontierConditions_GlobalTag_cff")
+from Configuration.AlCa.GlobalTag import GlobalTag
+process.GlobalTag = GlobalTag(process.GlobalTag, options.globalTag, '')
+process.load("CalibCalorimetry.HcalPlugins.HcalTimeSlew_cff")
+
+process.mahiBatchBenchmark = cms.EDAnalyzer('MahiBatchBenchmark',
+                                            cms.PSet( applyTimeSlew = method2.m2Parameters.applyTimeSlew,
+                                                      meanTime = method2.m2Parameters.meanTime,
+                                                      timeSigmaHPD = method2.m2Parameters.timeSigmaHPD,
+                                                      timeSigmaSiPM = method2.m2Parameters.timeSigmaSiPM),
+                                            mahi.mahiParameters,
+                                            src = cms.InputTag("hbheprereco"),
+                                            repeat = cms.uint32(options.repeat))
+
+process.p = cms.Path(process.mahiBatchBenchmark)
@@ -51,6 +51,10 @@ hbheprereco = cms.EDProducer(
     sipmQTSShift = cms.int32(0),
     sipmQNTStoSum = cms.int32(3),
 
+    # Pass the channels to the reconstruction algorithm in batches
+    # (Mahi fits together the channels sharing the pulse shape)
+    reconstructInBatches = cms.bool(False),
+
     # Configure the reconstruction algorithm
     algorithm = cms.PSet(
         # Parameters for "Method 3" (non-keyword arguments have to go first)
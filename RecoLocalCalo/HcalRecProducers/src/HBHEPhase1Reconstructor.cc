@@ -303,6 +303,7 @@ private:
     bool saveEffectivePedestal_;
     int sipmQTSShift_;
     int sipmQNTStoSum_;
+    bool reconstructInBatches_;
 
     // Parameters for turning status bit setters on/off
     bool setNegativeFlagsQIE8_;
@@ -326,6 +327,14 @@ private:
     std::unique_ptr<HBHEPulseShapeFlagSetter> hbhePulseShapeFlagSetterQIE8_;
     std::unique_ptr<HBHEPulseShapeFlagSetter> hbhePulseShapeFlagSetterQIE11_;
 
+    // Channels waiting to be reconstructed together, see processData
+    static constexpr unsigned batchSize_ = 1024;
+    std::vector<HBHEChannelInfo> batchInfos_;
+    std::vector<const HBHEChannelInfo*> batchInfoPtrs_;
+    std::vector<const HcalRecoParam*> batchParams_;
+    std::vector<const HcalCalibrations*> batchCalibs_;
+    std::vector<HBHERecHit> batchRechits_;
+
     // For the function below, arguments "infoColl" and/or "rechits"
     // are allowed to be null.
     template<class DataFrame, class Collection>
@@ -367,6 +376,7 @@ HBHEPhase1Reconstructor::HBHEPhase1Reconstructor(const edm::ParameterSet& conf)
       saveEffectivePedestal_(conf.getParameter<bool>("saveEffectivePedestal")),
       sipmQTSShift_(conf.getParameter<int>("sipmQTSShift")),
       sipmQNTStoSum_(conf.getParameter<int>("sipmQNTStoSum")),
+      reconstructInBatches_(conf.getParameter<bool>("reconstructInBatches")),
       setNegativeFlagsQIE8_(conf.getParameter<bool>("setNegativeFlagsQIE8")),
       setNegativeFlagsQIE11_(conf.getParameter<bool>("setNegativeFlagsQIE11")),
       setNoiseFlagsQIE8_(conf.getParameter<bool>("setNoiseFlagsQIE8")),
@@ -444,6 +454,42 @@ void HBHEPhase1Reconstructor::processData(const Collection& coll,
     // not going to be constructed from such channels.
     const bool skipDroppedChannels = !(infos && saveDroppedInfos_);
 
+    // With "reconstructInBatches_", the channels are collected and passed
+    // to the algorithm batchSize_ at a time. The status bits which need
+    // the data frame are set afterwards, in the original channel order.
+    std::vector<typename Collection::const_iterator> batchFrames;
+    auto reconstructBatch = [&]()
+    {
+        if (batchInfos_.empty())
+            return;
+        batchInfoPtrs_.clear();
+        for (const HBHEChannelInfo& batchInfo : batchInfos_)
+            batchInfoPtrs_.push_back(&batchInfo);
+        reco_->reconstructBatch(batchInfoPtrs_, batchParams_, batchCalibs_,
+                                isRealData, batchRechits_);
+
+        for (unsigned i=0; i<batchRechits_.size(); ++i)
+        {
+            HBHERecHit& rh = batchRechits_[i];
+            if (rh.id().rawId())
+            {
+                const DFrame& frame(*batchFrames[i]);
+                const HcalDetId cell(frame.id());
+                const HcalQIECoder* channelCoder = cond.getHcalCoder(cell);
+                const HcalQIEShape* shape = cond.getHcalShape(channelCoder);
+                const HcalCoderDb coder(*channelCoder, *shape);
+                setAsicSpecificBits(frame, coder, batchInfos_[i], *batchCalibs_[i], &rh);
+                setCommonStatusBits(batchInfos_[i], *batchCalibs_[i], &rh);
+                rechits->push_back(rh);
+            }
+        }
+
+        batchFrames.clear();
+        batchInfos_.clear();
+        batchParams_.clear();
+        batchCalibs_.clear();
+    };
+
     // Iterate over the input collection
     for (typename Collection::const_iterator it = coll.begin();
          it != coll.end(); ++it)
@@ -544,15 +590,28 @@ void HBHEPhase1Reconstructor::processData(const Collection& coll,
             const HcalRecoParam* pptr = nullptr;
             if (recoParamsFromDB_)
                 pptr = param_ts;
-            HBHERecHit rh = reco_->reconstruct(*channelInfo, pptr, calib, isRealData);
-            if (rh.id().rawId())
+            if (reconstructInBatches_)
             {
-                setAsicSpecificBits(frame, coder, *channelInfo, calib, &rh);
-                setCommonStatusBits(*channelInfo, calib, &rh);
-                rechits->push_back(rh);
+                batchFrames.push_back(it);
+                batchInfos_.push_back(*channelInfo);
+                batchParams_.push_back(pptr);
+                batchCalibs_.push_back(&calib);
+                if (batchInfos_.size() == batchSize_)
+                    reconstructBatch();
+            }
+            else
+            {
+                HBHERecHit rh = reco_->reconstruct(*channelInfo, pptr, calib, isRealData);
+                if (rh.id().rawId())
+                {
+                    setAsicSpecificBits(frame, coder, *channelInfo, calib, &rh);
+                    setCommonStatusBits(*channelInfo, calib, &rh);
+                    rechits->push_back(rh);
+                }
             }
         }
     }
+    reconstructBatch();
 }
 
 void HBHEPhase1Reconstructor::setCommonStatusBits(
@@ -767,6 +826,7 @@ HBHEPhase1Reconstructor::fillDescriptions(edm::ConfigurationDescriptions& descri
     desc.add<bool>("saveEffectivePedestal", false);
     desc.add<int>("sipmQTSShift", 0);
     desc.add<int>("sipmQNTStoSum", 3);
+    desc.add<bool>("reconstructInBatches", false);
     desc.add<bool>("setNegativeFlagsQIE8");
     desc.add<bool>("setNegativeFlagsQIE11");
     desc.add<bool>("setNoiseFlagsQIE8");
@@ -7,7 +7,9 @@
 
 #include "vdt/vdtMath.h"
 
+#include <algorithm>
 #include <iterator>
+#include <unordered_map>
 
 #ifdef PFLOW_DEBUG
 #define LOGVERB(x) edm::LogVerbatim(x)
@@ -21,6 +23,20 @@
 #define LOGDRESSED(x) LogDebug(x)
 #endif
 
+namespace {
+  // square of the optional maxSharingDistance, 0 if disabled
+  double maxSharingDist2(const edm::ParameterSet& conf) {
+    if( !conf.exists("maxSharingDistance") ) return 0.;
+    const double maxSharingDistance = conf.getParameter<double>("maxSharingDistance");
+    // cells closer than 10 sigma are kept even with zero fraction, see growPFClusters
+    if( maxSharingDistance > 0. && maxSharingDistance < 10. ) {
+      throw cms::Exception("InvalidConfiguration")
+	<< "maxSharingDistance must be 0 (disabled) or at least 10 showerSigma";
+    }
+    return maxSharingDistance*maxSharingDistance;
+  }
+}
+
 Basic2DGenericPFlowClusterizer::
 Basic2DGenericPFlowClusterizer(const edm::ParameterSet& conf) :
     PFClusterBuilderBase(conf),
@@ -39,7 +55,8 @@ Basic2DGenericPFlowClusterizer(const edm::ParameterSet& conf) :
 		{"HCAL_BARREL2_RING1",100*(int)PFLayer::HCAL_BARREL2},
 	        {"HCAL_ENDCAP",(int)PFLayer::HCAL_ENDCAP},
 	        {"HF_EM",(int)PFLayer::HF_EM},
-		{"HF_HAD",(int)PFLayer::HF_HAD} }) { 
+		{"HF_HAD",(int)PFLayer::HF_HAD} }),
+    _maxSharingDist2(maxSharingDist2(conf)) { 
   const std::vector<edm::ParameterSet>& thresholds =
     conf.getParameterSetVector("recHitEnergyNorms");
   for( const auto& pset : thresholds ) {
@@ -173,8 +190,23 @@ growPFClusters(const reco::PFCluster& topo,
     }
     cluster.resetHitsAndFractions();
   }
+  // with a sharing radius, index the clusters by x so that each rechit
+  // only looks at the clusters within that radius (plus its own seed)
+  const bool restrictSharing = _maxSharingDist2 > 0. && clusters.size() > 1;
+  const double maxSharingDistance = std::sqrt(_maxSharingDist2*_showerSigma2);
+  std::vector<std::pair<double,unsigned> > clustersByX;
+  std::unordered_map<unsigned,unsigned> clusterBySeed;
+  if( restrictSharing ) {
+    clustersByX.reserve(clusters.size());
+    for( unsigned i = 0; i < clusters.size(); ++i ) {
+      clustersByX.emplace_back(clusters[i].position().x(),i);
+      clusterBySeed.emplace(clusters[i].seed().rawId(),i);
+    }
+    std::sort(clustersByX.begin(),clustersByX.end());
+  }
   // loop over topo cluster and grow current PFCluster hypothesis 
   std::vector<double> dist2, frac;
+  std::vector<unsigned> candidates;
   double fractot = 0;
   for( const reco::PFRecHitFraction& rhf : topo.recHitFractions() ) {
     const reco::PFRecHitRef& refhit = rhf.recHitRef();
@@ -187,6 +219,25 @@ growPFClusters(const reco::PFCluster& topo,
     math::XYZPoint topocellpos_xyz(refhit->position());
     dist2.clear(); frac.clear(); fractot = 0;
 
+    candidates.clear();
+    if( restrictSharing ) {
+      auto first = std::lower_bound(clustersByX.begin(),clustersByX.end(),
+				    std::make_pair(topocellpos_xyz.x()-maxSharingDistance,0u));
+      for( auto it = first; it != clustersByX.end() && 
+	     it->first <= topocellpos_xyz.x()+maxSharingDistance; ++it ) {
+	candidates.push_back(it->second);
+      }
+      auto seedcluster = clusterBySeed.find(refhit->detId());
+      if( seedcluster != clusterBySeed.end() && 
+	  std::find(candidates.begin(),candidates.end(),seedcluster->second) == candidates.end() ) {
+	candidates.push_back(seedcluster->second);
+      }
+      // keep the cluster order so that the fractions are summed as without the index
+      std::sort(candidates.begin(),candidates.end());
+    } else {
+      for( unsigned i = 0; i < clusters.size(); ++i ) candidates.push_back(i);
+    }
+
     double recHitEnergyNorm=0.;
     auto const& recHitEnergyNormDepthPair = _recHitEnergyNorms.find(cell_layer)->second;
 
@@ -200,7 +251,8 @@ growPFClusters(const reco::PFCluster& topo,
     }
 
     // add rechits to clusters, calculating fraction based on distance
-    for( auto& cluster : clusters ) {      
+    for( auto icluster : candidates ) {      
+      const auto& cluster = clusters[icluster];
       const math::XYZPoint& clusterpos_xyz = cluster.position();
       const math::XYZVector deltav = clusterpos_xyz - topocellpos_xyz;
       const double d2 = deltav.Mag2()/_showerSigma2;
@@ -217,16 +269,19 @@ growPFClusters(const reco::PFCluster& topo,
 	fraction = 1.0;	
       } else if ( seedable[refhit.key()] && _excludeOtherSeeds ) {
 	fraction = 0.0;
+      } else if ( restrictSharing && d2 > _maxSharingDist2 ) {
+	fraction = 0.0;
       } else {
 	fraction = cluster.energy()/recHitEnergyNorm * vdt::fast_expf( -0.5*d2 );
       }      
       fractot += fraction;
       frac.emplace_back(fraction);
     }
-    for( unsigned i = 0; i < clusters.size(); ++i ) {      
+    for( unsigned ic = 0; ic < candidates.size(); ++ic ) {      
+      const unsigned i = candidates[ic];
       if( fractot > _minFracTot || 
 	  ( refhit->detId() == clusters[i].seed() && fractot > 0.0 ) ) {
-	frac[i]/=fractot;
+	frac[ic]/=fractot;
       } else {
 	continue;
       }
@@ -241,8 +296,8 @@ growPFClusters(const reco::PFCluster& topo,
       // (about 1% of the clusters) need to be studied, as 
       // they create fake photons, in general.
       // (PJ, 16/09/08) 
-      if( dist2[i] < 100.0 || frac[i] > 0.9999 ) {	
-	clusters[i].addRecHitFraction(reco::PFRecHitFraction(refhit,frac[i]));
+      if( dist2[ic] < 100.0 || frac[ic] > 0.9999 ) {	
+	clusters[i].addRecHitFraction(reco::PFRecHitFraction(refhit,frac[ic]));
       }
     }
   }
@@ -32,6 +32,9 @@ class Basic2DGenericPFlowClusterizer : public PFClusterBuilderBase {
   const bool _excludeOtherSeeds;
   const double _minFracTot;
   const std::unordered_map<std::string,int> _layerMap;
+  // if positive, rechits only share energy with clusters closer than
+  // this distance (in units of showerSigma), found with a sorted index
+  const double _maxSharingDist2;
 
   std::unordered_map<int,std::pair<std::vector<int>,std::vector<double> > > _recHitEnergyNorms;
   std::unique_ptr<PFCPositionCalculatorBase> _allCellsPosCalc;
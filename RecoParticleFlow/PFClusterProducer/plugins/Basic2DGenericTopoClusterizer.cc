@@ -1,6 +1,10 @@
 #include "Basic2DGenericTopoClusterizer.h"
 #include "FWCore/MessageLogger/interface/MessageLogger.h"
 
+#include "tbb/parallel_for.h"
+
+#include <atomic>
+
 #ifdef PFLOW_DEBUG
 #define LOGVERB(x) edm::LogVerbatim(x)
 #define LOGWARN(x) edm::LogWarning(x)
@@ -13,41 +17,108 @@
 #define LOGDRESSED(x) LogDebug(x)
 #endif
 
+namespace {
+  // lock-free union-find: roots are only ever linked towards the lower index,
+  // so concurrent unions cannot create cycles and the final labels do not
+  // depend on the order in which the tasks ran
+  unsigned int findRoot(std::vector<std::atomic<unsigned int> >& parent,
+                        unsigned int i) {
+    while( true ) {
+      unsigned int p = parent[i].load(std::memory_order_relaxed);
+      if( p == i ) return i;
+      unsigned int gp = parent[p].load(std::memory_order_relaxed);
+      if( p != gp ) parent[i].compare_exchange_weak(p,gp,std::memory_order_relaxed);
+      i = gp;
+    }
+  }
+
+  void unite(std::vector<std::atomic<unsigned int> >& parent,
+             unsigned int i, unsigned int j) {
+    while( true ) {
+      i = findRoot(parent,i);
+      j = findRoot(parent,j);
+      if( i == j ) return;
+      if( i < j ) std::swap(i,j);
+      if( parent[i].compare_exchange_strong(i,j,std::memory_order_relaxed) ) return;
+    }
+  }
+}
+
 void Basic2DGenericTopoClusterizer::
 buildClusters(const edm::Handle<reco::PFRecHitCollection>& input,
 	      const std::vector<bool>& rechitMask,
 	      const std::vector<bool>& seedable,
 	      reco::PFClusterCollection& output) {
   auto const & hits = *input;  
-  std::vector<bool> used(hits.size(),false);
-  std::vector<unsigned int> seeds;
-  
+  const unsigned int nhits = hits.size();
+
+  // a rechit can join a topocluster if it is not masked and passes the
+  // thresholds; the decision only depends on the rechit itself
+  std::vector<unsigned char> valid(nhits,0);
+  tbb::parallel_for(0u, nhits, [&](unsigned int i) {
+      valid[i] = ( rechitMask[i] && passesThreshold(hits[i]) ) ? 1 : 0;
+    });
+
+  // connected components of the valid rechits, with the links taken in both
+  // directions; a directed walk from any seed never leaves its component
+  std::vector<std::atomic<unsigned int> > parent(nhits);
+  for( unsigned int i = 0; i < nhits; ++i ) {
+    parent[i].store(i,std::memory_order_relaxed);
+  }
+  tbb::parallel_for(0u, nhits, [&](unsigned int i) {
+      if( !valid[i] ) return;
+      auto const & neighbours = 
+        ( _useCornerCells ? hits[i].neighbours8() : hits[i].neighbours4() );
+      for( auto nb : neighbours ) {
+        if( valid[nb] ) unite(parent,i,nb);
+      }
+    });
+
   // get the seeds and sort them descending in energy
-  seeds.reserve(hits.size());  
-  for( unsigned int i = 0; i < hits.size(); ++i ) {
-    if( !rechitMask[i] || !seedable[i] || used[i] ) continue;
+  std::vector<unsigned int> seeds;
+  seeds.reserve(nhits);  
+  for( unsigned int i = 0; i < nhits; ++i ) {
+    if( !rechitMask[i] || !seedable[i] ) continue;
     seeds.emplace_back(i);
   }
   // maxHeap would be better
   std::sort(seeds.begin(),seeds.end(),
             [&](unsigned int i, unsigned int j) { return hits[i].energy()>hits[j].energy();});  
-  
-  reco::PFCluster temp;
-  for( auto seed : seeds ) {    
-    if( !rechitMask[seed] || !seedable[seed] || used[seed] ) continue;    
-    temp.reset();
-    buildTopoCluster(input,rechitMask,seed,used,temp);
-    if( !temp.recHitFractions().empty() ) output.push_back(temp);
+
+  // group the seeds by component, keeping the energy ordering inside each
+  // group; seeds that fail the thresholds never start a topocluster
+  std::vector<unsigned int> componentIndex(nhits,0);
+  std::vector<std::vector<unsigned int> > componentSeeds;
+  for( unsigned int is = 0; is < seeds.size(); ++is ) {
+    if( !valid[seeds[is]] ) continue;
+    const unsigned int root = findRoot(parent,seeds[is]);
+    if( componentIndex[root] == 0 ) {
+      componentSeeds.emplace_back();
+      componentIndex[root] = componentSeeds.size();
+    }
+    componentSeeds[componentIndex[root]-1].push_back(is);
+  }
+
+  // the components are disjoint, so each one is walked by its own task; the
+  // seeds of a component are taken in energy order exactly as in a single
+  // pass over all seeds, and the clusters are stored by seed rank
+  std::vector<unsigned char> used(nhits,0);
+  std::vector<reco::PFCluster> clusters(seeds.size());
+  tbb::parallel_for(size_t(0), componentSeeds.size(), [&](size_t ic) {
+      std::vector<unsigned int> stack;
+      for( auto is : componentSeeds[ic] ) {
+        if( used[seeds[is]] ) continue;
+        buildTopoCluster(input,valid,seeds[is],used,stack,clusters[is]);
+      }
+    });
+
+  for( auto& cluster : clusters ) {
+    if( !cluster.recHitFractions().empty() ) output.push_back(std::move(cluster));
   }
 }
 
-void Basic2DGenericTopoClusterizer::
-buildTopoCluster(const edm::Handle<reco::PFRecHitCollection>& input,
-		 const std::vector<bool>& rechitMask,
-		 unsigned int kcell,
-		 std::vector<bool>& used,		 
-		 reco::PFCluster& topocluster) {
-  auto const & cell = (*input)[kcell];
+bool Basic2DGenericTopoClusterizer::
+passesThreshold(const reco::PFRecHit& cell) const {
   int cell_layer = (int)cell.layer();
   if( cell_layer == PFLayer::HCAL_BARREL2 && 
       std::abs(cell.positionREP().eta()) > 0.34 ) {
@@ -73,29 +144,48 @@ buildTopoCluster(const edm::Handle<reco::PFRecHitCollection>& input,
     LOGDRESSED("GenericTopoCluster::buildTopoCluster()")
       << "RecHit " << cell.detId() << " with enegy "
       << cell.energy() << " GeV was rejected!." << std::endl;
-    return;
+    return false;
   }
+  return true;
+}
 
-
-  auto k = kcell;
-  used[k] = true;
-  auto ref = makeRefhit(input,k);
-  topocluster.addRecHitFraction(reco::PFRecHitFraction(ref, 1.0));
-  
-  auto const & neighbours = 
-    ( _useCornerCells ? cell.neighbours8() : cell.neighbours4() );
-  
-  for( auto nb : neighbours ) {
-    if( used[nb] || !rechitMask[nb] ) {
+void Basic2DGenericTopoClusterizer::
+buildTopoCluster(const edm::Handle<reco::PFRecHitCollection>& input,
+		 const std::vector<unsigned char>& valid,
+		 unsigned int kcell,
+		 std::vector<unsigned char>& used,		 
+		 std::vector<unsigned int>& stack,
+		 reco::PFCluster& topocluster) const {
+  // depth-first walk with an explicit stack instead of recursion, so that
+  // large topological clusters (HGCal, high pileup) cannot exhaust the call
+  // stack; neighbours are pushed in reverse order and the used/valid checks
+  // are done when popping, which visits the rechits in the same order as
+  // the recursive walk and gives identical topoclusters
+  stack.clear();
+  stack.push_back(kcell);
+  while( !stack.empty() ) {
+    auto k = stack.back();
+    stack.pop_back();
+    if( used[k] || !valid[k] ) {
       LOGDRESSED("GenericTopoCluster::buildTopoCluster()")
-      	<< "  RecHit " << cell.detId() << "\'s" 
-	<< " neighbor RecHit " << input->at(nb).detId() 
+	<< "  neighbor RecHit " << input->at(k).detId() 
 	<< " with enegy " 
-	<< input->at(nb).energy() << " GeV was rejected!" 
-	<< " Reasons : " << used[nb] << " (used) " 
-	<< !rechitMask[nb] << " (masked)." << std::endl;
+	<< input->at(k).energy() << " GeV was rejected!" 
+	<< " Reasons : " << bool(used[k]) << " (used) " 
+	<< !valid[k] << " (masked or below threshold)." << std::endl;
       continue;
     }
-    buildTopoCluster(input,rechitMask,nb,used,topocluster);
+
+    auto const & cell = (*input)[k];
+    used[k] = 1;
+    auto ref = makeRefhit(input,k);
+    topocluster.addRecHitFraction(reco::PFRecHitFraction(ref, 1.0));
+  
+    auto const & neighbours = 
+      ( _useCornerCells ? cell.neighbours8() : cell.neighbours4() );
+    for( auto nb = neighbours.end(); nb != neighbours.begin(); ) {
+      --nb;
+      if( !used[*nb] ) stack.push_back(*nb);
+    }
   }
 }
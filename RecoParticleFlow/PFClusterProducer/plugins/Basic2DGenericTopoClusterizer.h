@@ -22,11 +22,13 @@ class Basic2DGenericTopoClusterizer : public InitialClusteringStepBase {
   
  private:  
   const bool _useCornerCells;
+  bool passesThreshold(const reco::PFRecHit&) const;
   void buildTopoCluster(const edm::Handle<reco::PFRecHitCollection>&,
-			const std::vector<bool>&, // masked rechits
+			const std::vector<unsigned char>&, // unmasked and above threshold
 			unsigned int, //present rechit
-			std::vector<bool>&, // hit usage state
-			reco::PFCluster&); // the topocluster
+			std::vector<unsigned char>&, // hit usage state
+			std::vector<unsigned int>&, // work stack
+			reco::PFCluster&) const; // the topocluster
   
 };
 
@@ -21,8 +21,9 @@ class KDTreeLinkerAlgo
   
   // Here we search in the KDTree for all points that would be 
   // contained in the given searchbox. The founded points are stored in resRecHitList.
+  // The tree is not modified, so several searches may run concurrently.
   void search(const KDTreeBox			&searchBox,
-	      std::vector<KDTreeNodeInfo>	&resRecHitList);
+	      std::vector<KDTreeNodeInfo>	&resRecHitList) const;
   
   // This method clears all allocated structures.
   void clear();
@@ -59,11 +60,11 @@ class KDTreeLinkerAlgo
   // Recursif kdtree search. Is called by search()
   void recSearch(const KDTreeNode		*current,
 		 const KDTreeBox		&trackBox,
-		 std::vector<KDTreeNodeInfo>	&recHits);    
+		 std::vector<KDTreeNodeInfo>	&recHits) const;
 
   // Add all elements of an subtree to the closest elements. Used during the recSearch().
   void addSubtree(const KDTreeNode		*current, 
-		  std::vector<KDTreeNodeInfo>	&recHits);
+		  std::vector<KDTreeNodeInfo>	&recHits) const;
 
   // This method frees the KDTree.     
   void clearTree();
@@ -3,6 +3,8 @@
 #include "DataFormats/ParticleFlowReco/interface/PFCluster.h"
 #include "TMath.h"
 
+#include "tbb/parallel_for.h"
+
 // the text name is different so that we can easily
 // construct it when calling the factory
 DEFINE_EDM_PLUGIN(KDTreeLinkerFactory, 
@@ -100,107 +102,119 @@ KDTreeLinkerPSEcal::buildTree(const RecHitSet	&rechitsSet,
 
 void
 KDTreeLinkerPSEcal::searchLinks()
+{
+  // The PS clusters are independent: each one is searched in its own task with its own set
+  // of linked clusters, and the sets are merged afterwards in the order of targetSet_.
+  const std::vector<reco::PFBlockElement*> targets(targetSet_.begin(), targetSet_.end());
+  std::vector<BlockEltSet> linkedClusters(targets.size());
+
+  tbb::parallel_for(size_t(0), targets.size(), [&](size_t i) {
+      searchLinks(targets[i], linkedClusters[i]);
+    });
+
+  for(size_t i = 0; i < targets.size(); ++i) {
+    if (!linkedClusters[i].empty())
+      target2ClusterLinks_[targets[i]].swap(linkedClusters[i]);
+  }
+}
+
+void
+KDTreeLinkerPSEcal::searchLinks(reco::PFBlockElement *psCluster, BlockEltSet &linkedClusters) const
 {
   // Must of the code has been taken from LinkByRecHit.cc
 
-  // We iterate over the PS clusters.
-  for(BlockEltSet::iterator it = targetSet_.begin(); 
-      it != targetSet_.end(); it++) {
+  psCluster->setIsValidMultilinks(true);
 
-    (*it)->setIsValidMultilinks(true);
-	
-    reco::PFClusterRef clusterPSRef = (*it)->clusterRef();
-    const reco::PFCluster& clusterPS = *clusterPSRef;
+  reco::PFClusterRef clusterPSRef = psCluster->clusterRef();
+  const reco::PFCluster& clusterPS = *clusterPSRef;
 
-    // PS cluster position, extrapolated to ECAL
-    double zPS = clusterPS.position().Z();
-    double xPS = clusterPS.position().X();
-    double yPS = clusterPS.position().Y();
+  // PS cluster position, extrapolated to ECAL
+  double zPS = clusterPS.position().Z();
+  double xPS = clusterPS.position().X();
+  double yPS = clusterPS.position().Y();
 
-    double etaPS = fabs(clusterPS.positionREP().eta());
-    double deltaX = 0.;
-    double deltaY = 0.;
-    double xPSonEcal = xPS;
-    double yPSonEcal = yPS;
+  double etaPS = fabs(clusterPS.positionREP().eta());
+  double deltaX = 0.;
+  double deltaY = 0.;
+  double xPSonEcal = xPS;
+  double yPSonEcal = yPS;
 
-    if (clusterPS.layer() == PFLayer::PS1) { // PS1
+  if (clusterPS.layer() == PFLayer::PS1) { // PS1
 
-      // vertical strips, measure x with pitch precision
-      deltaX = resPSpitch_;
-      deltaY = resPSlength_;
-      xPSonEcal *= ps1ToEcal_;
-      yPSonEcal *= ps1ToEcal_;
+    // vertical strips, measure x with pitch precision
+    deltaX = resPSpitch_;
+    deltaY = resPSlength_;
+    xPSonEcal *= ps1ToEcal_;
+    yPSonEcal *= ps1ToEcal_;
 
-    } else { // PS2
+  } else { // PS2
 
-      // horizontal strips, measure y with pitch precision
-      deltaY = resPSpitch_;
-      deltaX = resPSlength_;
-      xPSonEcal *= ps2ToEcal_;
-      yPSonEcal *= ps2ToEcal_;
+    // horizontal strips, measure y with pitch precision
+    deltaY = resPSpitch_;
+    deltaX = resPSlength_;
+    xPSonEcal *= ps2ToEcal_;
+    yPSonEcal *= ps2ToEcal_;
 
-    }
- 
-    
-    // Estimate the maximal envelope in phi/eta that will be used to find rechit candidates.
-    // Same envelope for cap et barrel rechits.
-    
-    
-    double maxEcalRadius = getCristalXYMaxSize() / 2.;
+  }
 
-    // The inflation factor includes the approximate projection from Preshower to ECAL
-    double inflation = 2.4 - (etaPS-1.6);
-    double rangeX = maxEcalRadius * (1 + (0.05 + 1.0 / maxEcalRadius * deltaX / 2.)) * inflation; 
-    double rangeY = maxEcalRadius * (1 + (0.05 + 1.0 / maxEcalRadius * deltaY / 2.)) * inflation; 
-    
-    // We search for all candidate recHits, ie all recHits contained in the maximal size envelope.
-    std::vector<KDTreeNodeInfo> recHits;
-    KDTreeBox trackBox(xPSonEcal - rangeX, xPSonEcal + rangeX, 
-		  yPSonEcal - rangeY, yPSonEcal + rangeY);
 
-    if (zPS < 0)
-      treeNeg_.search(trackBox, recHits);
-    else
-      treePos_.search(trackBox, recHits);
+  // Estimate the maximal envelope in phi/eta that will be used to find rechit candidates.
+  // Same envelope for cap et barrel rechits.
 
 
-    for(std::vector<KDTreeNodeInfo>::const_iterator rhit = recHits.begin(); 
-	rhit != recHits.end(); ++rhit) {
-           
-      const auto & corners = rhit->ptr->getCornersXYZ();
+  double maxEcalRadius = getCristalXYMaxSize() / 2.;
 
-      // Find all clusters associated to given rechit
-      RecHit2BlockEltMap::iterator ret = rechit2ClusterLinks_.find(rhit->ptr);
-      
-      for(BlockEltSet::const_iterator clusterIt = ret->second.begin(); 
-	  clusterIt != ret->second.end(); clusterIt++) {
-	
-	reco::PFClusterRef clusterref = (*clusterIt)->clusterRef();
-	double clusterz = clusterref->position().z();
-
-	const auto & posxyz = rhit->ptr->position() * zPS / clusterz;
-
-	double x[5];
-	double y[5];
-	for ( unsigned jc=0; jc<4; ++jc ) {
-	  auto cornerpos = corners[jc].basicVector() * zPS / clusterz;
-	  x[3-jc] = cornerpos.x() + (cornerpos.x()-posxyz.x()) * (0.05 +1.0/fabs((cornerpos.x()-posxyz.x()))*deltaX/2.);
-	  y[3-jc] = cornerpos.y() + (cornerpos.y()-posxyz.y()) * (0.05 +1.0/fabs((cornerpos.y()-posxyz.y()))*deltaY/2.);
-	}
-
-	x[4] = x[0];
-	y[4] = y[0];
-	
-	bool isinside = TMath::IsInside(xPS,
-					yPS,
-					5,x,y);
-	
-	// Check if the track and the cluster are linked
-	if( isinside )
-	  target2ClusterLinks_[*it].insert(*clusterIt);	
+  // The inflation factor includes the approximate projection from Preshower to ECAL
+  double inflation = 2.4 - (etaPS-1.6);
+  double rangeX = maxEcalRadius * (1 + (0.05 + 1.0 / maxEcalRadius * deltaX / 2.)) * inflation;
+  double rangeY = maxEcalRadius * (1 + (0.05 + 1.0 / maxEcalRadius * deltaY / 2.)) * inflation;
+
+  // We search for all candidate recHits, ie all recHits contained in the maximal size envelope.
+  std::vector<KDTreeNodeInfo> recHits;
+  KDTreeBox trackBox(xPSonEcal - rangeX, xPSonEcal + rangeX,
+		yPSonEcal - rangeY, yPSonEcal + rangeY);
+
+  if (zPS < 0)
+    treeNeg_.search(trackBox, recHits);
+  else
+    treePos_.search(trackBox, recHits);
+
+
+  for(std::vector<KDTreeNodeInfo>::const_iterator rhit = recHits.begin();
+      rhit != recHits.end(); ++rhit) {
+
+    const auto & corners = rhit->ptr->getCornersXYZ();
+
+    // Find all clusters associated to given rechit
+    RecHit2BlockEltMap::const_iterator ret = rechit2ClusterLinks_.find(rhit->ptr);
+
+    for(BlockEltSet::const_iterator clusterIt = ret->second.begin();
+	clusterIt != ret->second.end(); clusterIt++) {
+
+      reco::PFClusterRef clusterref = (*clusterIt)->clusterRef();
+      double clusterz = clusterref->position().z();
+
+      const auto & posxyz = rhit->ptr->position() * zPS / clusterz;
+
+      double x[5];
+      double y[5];
+      for ( unsigned jc=0; jc<4; ++jc ) {
+	auto cornerpos = corners[jc].basicVector() * zPS / clusterz;
+	x[3-jc] = cornerpos.x() + (cornerpos.x()-posxyz.x()) * (0.05 +1.0/fabs((cornerpos.x()-posxyz.x()))*deltaX/2.);
+	y[3-jc] = cornerpos.y() + (cornerpos.y()-posxyz.y()) * (0.05 +1.0/fabs((cornerpos.y()-posxyz.y()))*deltaY/2.);
       }
+
+      x[4] = x[0];
+      y[4] = y[0];
+
+      bool isinside = TMath::IsInside(xPS,
+				      yPS,
+				      5,x,y);
+
+      // Check if the track and the cluster are linked
+      if( isinside )
+	linkedClusters.insert(*clusterIt);
     }
-    
   }
 }
 
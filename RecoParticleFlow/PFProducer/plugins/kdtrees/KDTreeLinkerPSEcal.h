@@ -44,6 +44,10 @@ class KDTreeLinkerPSEcal : public KDTreeLinkerBase
   void buildTree(const RecHitSet	&rechitsSet,
 		   KDTreeLinkerAlgo	&tree);
 
+  // Search the ECAL clusters linked to one PS cluster. It only reads the KDTrees and the
+  // rechit/cluster map, so it is called concurrently for all the PS clusters.
+  void searchLinks(reco::PFBlockElement *psCluster, BlockEltSet &linkedClusters) const;
+
  private:
   // Some const values. 
   const double	resPSpitch_;
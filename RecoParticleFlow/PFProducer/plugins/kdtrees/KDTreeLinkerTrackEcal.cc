@@ -3,6 +3,8 @@
 #include "DataFormats/ParticleFlowReco/interface/PFCluster.h"
 #include "TMath.h"
 
+#include "tbb/parallel_for.h"
+
 // the text name is different so that we can easily
 // construct it when calling the factory
 DEFINE_EDM_PLUGIN(KDTreeLinkerFactory, 
@@ -102,110 +104,123 @@ KDTreeLinkerTrackEcal::buildTree()
 
 void
 KDTreeLinkerTrackEcal::searchLinks()
+{
+  // The tracks are independent: each one is searched in its own task with its own set
+  // of linked clusters, and the sets are merged afterwards in the order of targetSet_.
+  const std::vector<reco::PFBlockElement*> targets(targetSet_.begin(), targetSet_.end());
+  std::vector<BlockEltSet> linkedClusters(targets.size());
+
+  tbb::parallel_for(size_t(0), targets.size(), [&](size_t i) {
+      searchLinks(targets[i], linkedClusters[i]);
+    });
+
+  for(size_t i = 0; i < targets.size(); ++i) {
+    if (!linkedClusters[i].empty())
+      target2ClusterLinks_[targets[i]].swap(linkedClusters[i]);
+  }
+}
+
+void
+KDTreeLinkerTrackEcal::searchLinks(reco::PFBlockElement *track, BlockEltSet &linkedClusters) const
 {
   // Must of the code has been taken from LinkByRecHit.cc
 
-  // We iterate over the tracks.
-  for(BlockEltSet::iterator it = targetSet_.begin(); 
-      it != targetSet_.end(); it++) {
-	
-    reco::PFRecTrackRef trackref = (*it)->trackRefPF();
+  reco::PFRecTrackRef trackref = track->trackRefPF();
 
-    // We set the multilinks flag of the track to true. It will allow us to 
-    // use in an optimized way our algo results in the recursive linking algo.
-    (*it)->setIsValidMultilinks(true);
+  // We set the multilinks flag of the track to true. It will allow us to
+  // use in an optimized way our algo results in the recursive linking algo.
+  track->setIsValidMultilinks(true);
 
-    const reco::PFTrajectoryPoint& atECAL = 
-      trackref->extrapolatedPoint(reco::PFTrajectoryPoint::ECALShowerMax);
+  const reco::PFTrajectoryPoint& atECAL =
+    trackref->extrapolatedPoint(reco::PFTrajectoryPoint::ECALShowerMax);
 
-    // The track didn't reach ecal
-    if( ! atECAL.isValid() ) continue;
-    
-    const reco::PFTrajectoryPoint& atVertex = 
-      trackref->extrapolatedPoint( reco::PFTrajectoryPoint::ClosestApproach );
-    
-    double trackPt = sqrt(atVertex.momentum().Vect().Perp2());
-    double tracketa = atECAL.positionREP().eta();
-    double trackphi = atECAL.positionREP().phi();
-    double trackx = atECAL.position().X();
-    double tracky = atECAL.position().Y();
-    double trackz = atECAL.position().Z();
-    
-    // Estimate the maximal envelope in phi/eta that will be used to find rechit candidates.
-    // Same envelope for cap et barrel rechits.
-    double range = getCristalPhiEtaMaxSize() * (2.0 + 1.0 / std::min(1., trackPt / 2.)); 
-
-    // We search for all candidate recHits, ie all recHits contained in the maximal size envelope.
-    std::vector<KDTreeNodeInfo> recHits;
-    KDTreeBox trackBox(tracketa-range, tracketa+range, trackphi-range, trackphi+range);
-    tree_.search(trackBox, recHits);
-    
-    // Here we check all rechit candidates using the non-approximated method.
-    for(std::vector<KDTreeNodeInfo>::const_iterator rhit = recHits.begin(); 
-	rhit != recHits.end(); ++rhit) {
-           
-      const auto & cornersxyz      = rhit->ptr->getCornersXYZ();
-      const auto & posxyz			   = rhit->ptr->position();
-      const auto &rhrep		   = rhit->ptr->positionREP();
-      const auto & corners = rhit->ptr->getCornersREP();
-      
-      double rhsizeeta = fabs(corners[3].eta() - corners[1].eta());
-      double rhsizephi = fabs(corners[3].phi() - corners[1].phi());
-      if ( rhsizephi > M_PI ) rhsizephi = 2.*M_PI - rhsizephi;
-      
-      double deta = fabs(rhrep.eta() - tracketa);
-      double dphi = fabs(rhrep.phi() - trackphi);
-      if ( dphi > M_PI ) dphi = 2.*M_PI - dphi;
-      
-      // Find all clusters associated to given rechit
-      RecHit2BlockEltMap::iterator ret = rechit2ClusterLinks_.find(rhit->ptr);
-      
-      for(BlockEltSet::const_iterator clusterIt = ret->second.begin(); 
-	  clusterIt != ret->second.end(); clusterIt++) {
-	
-	reco::PFClusterRef clusterref = (*clusterIt)->clusterRef();
-	double clusterz = clusterref->position().z();
-	int fracsNbr = clusterref->recHitFractions().size();
-
-	if (clusterref->layer() == PFLayer::ECAL_BARREL){ // BARREL
-	  // Check if the track is in the barrel
-	  if (fabs(trackz) > 300.) continue;
-
-	  double _rhsizeeta = rhsizeeta * (2.00 + 1.0 / (fracsNbr * std::min(1.,trackPt/2.)));
-	  double _rhsizephi = rhsizephi * (2.00 + 1.0 / (fracsNbr * std::min(1.,trackPt/2.)));
-	  
-	  // Check if the track and the cluster are linked
-	  if(deta < (_rhsizeeta / 2.) && dphi < (_rhsizephi / 2.))
-	    target2ClusterLinks_[*it].insert(*clusterIt);
-
-	  
-	} else { // ENDCAP
-
-	  // Check if the track is in the cap
-	  if (fabs(trackz) < 300.) continue;
-	  if (trackz * clusterz < 0.) continue;
-	  
-	  double x[5];
-	  double y[5];
-	  for ( unsigned jc=0; jc<4; ++jc ) {
-	    auto cornerposxyz = cornersxyz[jc];
-	    x[3-jc] = cornerposxyz.x() + (cornerposxyz.x()-posxyz.x())
-	      * (1.00+0.50/fracsNbr /std::min(1.,trackPt/2.));
-	    y[3-jc] = cornerposxyz.y() + (cornerposxyz.y()-posxyz.y())
-	      * (1.00+0.50/fracsNbr /std::min(1.,trackPt/2.));
-	  }
-	  
-	  x[4] = x[0];
-	  y[4] = y[0];
-	  
-	  bool isinside = TMath::IsInside(trackx,
-					  tracky,
-					  5,x,y);
-	  
-	  // Check if the track and the cluster are linked
-	  if( isinside )
-	    target2ClusterLinks_[*it].insert(*clusterIt);
+  // The track didn't reach ecal
+  if( ! atECAL.isValid() ) return;
+
+  const reco::PFTrajectoryPoint& atVertex =
+    trackref->extrapolatedPoint( reco::PFTrajectoryPoint::ClosestApproach );
+
+  double trackPt = sqrt(atVertex.momentum().Vect().Perp2());
+  double tracketa = atECAL.positionREP().eta();
+  double trackphi = atECAL.positionREP().phi();
+  double trackx = atECAL.position().X();
+  double tracky = atECAL.position().Y();
+  double trackz = atECAL.position().Z();
+
+  // Estimate the maximal envelope in phi/eta that will be used to find rechit candidates.
+  // Same envelope for cap et barrel rechits.
+  double range = getCristalPhiEtaMaxSize() * (2.0 + 1.0 / std::min(1., trackPt / 2.));
+
+  // We search for all candidate recHits, ie all recHits contained in the maximal size envelope.
+  std::vector<KDTreeNodeInfo> recHits;
+  KDTreeBox trackBox(tracketa-range, tracketa+range, trackphi-range, trackphi+range);
+  tree_.search(trackBox, recHits);
+
+  // Here we check all rechit candidates using the non-approximated method.
+  for(std::vector<KDTreeNodeInfo>::const_iterator rhit = recHits.begin();
+      rhit != recHits.end(); ++rhit) {
+
+    const auto & cornersxyz      = rhit->ptr->getCornersXYZ();
+    const auto & posxyz			   = rhit->ptr->position();
+    const auto &rhrep		   = rhit->ptr->positionREP();
+    const auto & corners = rhit->ptr->getCornersREP();
+
+    double rhsizeeta = fabs(corners[3].eta() - corners[1].eta());
+    double rhsizephi = fabs(corners[3].phi() - corners[1].phi());
+    if ( rhsizephi > M_PI ) rhsizephi = 2.*M_PI - rhsizephi;
+
+    double deta = fabs(rhrep.eta() - tracketa);
+    double dphi = fabs(rhrep.phi() - trackphi);
+    if ( dphi > M_PI ) dphi = 2.*M_PI - dphi;
+
+    // Find all clusters associated to given rechit
+    RecHit2BlockEltMap::const_iterator ret = rechit2ClusterLinks_.find(rhit->ptr);
+
+    for(BlockEltSet::const_iterator clusterIt = ret->second.begin();
+	clusterIt != ret->second.end(); clusterIt++) {
+
+      reco::PFClusterRef clusterref = (*clusterIt)->clusterRef();
+      double clusterz = clusterref->position().z();
+      int fracsNbr = clusterref->recHitFractions().size();
+
+      if (clusterref->layer() == PFLayer::ECAL_BARREL){ // BARREL
+	// Check if the track is in the barrel
+	if (fabs(trackz) > 300.) continue;
+
+	double _rhsizeeta = rhsizeeta * (2.00 + 1.0 / (fracsNbr * std::min(1.,trackPt/2.)));
+	double _rhsizephi = rhsizephi * (2.00 + 1.0 / (fracsNbr * std::min(1.,trackPt/2.)));
+
+	// Check if the track and the cluster are linked
+	if(deta < (_rhsizeeta / 2.) && dphi < (_rhsizephi / 2.))
+	  linkedClusters.insert(*clusterIt);
+
+
+      } else { // ENDCAP
+
+	// Check if the track is in the cap
+	if (fabs(trackz) < 300.) continue;
+	if (trackz * clusterz < 0.) continue;
+
+	double x[5];
+	double y[5];
+	for ( unsigned jc=0; jc<4; ++jc ) {
+	  auto cornerposxyz = cornersxyz[jc];
+	  x[3-jc] = cornerposxyz.x() + (cornerposxyz.x()-posxyz.x())
+	    * (1.00+0.50/fracsNbr /std::min(1.,trackPt/2.));
+	  y[3-jc] = cornerposxyz.y() + (cornerposxyz.y()-posxyz.y())
+	    * (1.00+0.50/fracsNbr /std::min(1.,trackPt/2.));
 	}
+
+	x[4] = x[0];
+	y[4] = y[0];
+
+	bool isinside = TMath::IsInside(trackx,
+					tracky,
+					5,x,y);
+
+	// Check if the track and the cluster are linked
+	if( isinside )
+	  linkedClusters.insert(*clusterIt);
       }
     }
   }
@@ -3,6 +3,8 @@
 #include "DataFormats/ParticleFlowReco/interface/PFCluster.h"
 #include "TMath.h"
 
+#include "tbb/parallel_for.h"
+
 // the text name is different so that we can easily
 // construct it when calling the factory
 DEFINE_EDM_PLUGIN(KDTreeLinkerFactory, 
@@ -105,77 +107,91 @@ KDTreeLinkerTrackHcal::buildTree()
 
 void
 KDTreeLinkerTrackHcal::searchLinks()
+{
+  // The tracks are independent: each one is searched in its own task with its own set
+  // of linked clusters, and the sets are merged afterwards in the order of targetSet_.
+  const std::vector<reco::PFBlockElement*> targets(targetSet_.begin(), targetSet_.end());
+  std::vector<BlockEltSet> linkedClusters(targets.size());
+
+  tbb::parallel_for(size_t(0), targets.size(), [&](size_t i) {
+      searchLinks(targets[i], linkedClusters[i]);
+    });
+
+  for(size_t i = 0; i < targets.size(); ++i) {
+    for(BlockEltSet::iterator clusterIt = linkedClusters[i].begin();
+	clusterIt != linkedClusters[i].end(); clusterIt++)
+      cluster2TargetLinks_[*clusterIt].insert(targets[i]);
+  }
+}
+
+void
+KDTreeLinkerTrackHcal::searchLinks(reco::PFBlockElement *track, BlockEltSet &linkedClusters) const
 {
   // Must of the code has been taken from LinkByRecHit.cc
 
-  // We iterate over the tracks.
-  for(BlockEltSet::iterator it = targetSet_.begin(); 
-      it != targetSet_.end(); it++) {
-	
-    reco::PFRecTrackRef trackref = (*it)->trackRefPF();
+  reco::PFRecTrackRef trackref = track->trackRefPF();
 
-    const reco::PFTrajectoryPoint& atHCAL = 
-      trackref->extrapolatedPoint(reco::PFTrajectoryPoint::HCALEntrance);
-    const reco::PFTrajectoryPoint& atHCALExit = 
-      trackref->extrapolatedPoint(reco::PFTrajectoryPoint::HCALExit);
-    
-    // The track didn't reach hcal
-    if( ! atHCAL.isValid()) continue;
-    
-    double dHeta = atHCALExit.positionREP().eta() - atHCAL.positionREP().eta();
-    double dHphi = atHCALExit.positionREP().phi() - atHCAL.positionREP().phi(); 
-    if ( dHphi > M_PI ) dHphi = dHphi - 2. * M_PI;
-    else if ( dHphi < -M_PI ) dHphi = dHphi + 2. * M_PI; 
-    
-    double tracketa = atHCAL.positionREP().eta() + 0.1 * dHeta;
-    double trackphi = atHCAL.positionREP().phi() + 0.1 * dHphi;
-    
-    if (trackphi > M_PI) trackphi -= 2 * M_PI;
-    else if (trackphi < -M_PI) trackphi += 2 * M_PI;
-
-    // Estimate the maximal envelope in phi/eta that will be used to find rechit candidates.
-    // Same envelope for cap et barrel rechits.
-    double inflation = 1.;
-    double rangeeta = (getCristalPhiEtaMaxSize() * (1.5 + 0.5) + 0.2 * fabs(dHeta)) * inflation; 
-    double rangephi = (getCristalPhiEtaMaxSize() * (1.5 + 0.5) + 0.2 * fabs(dHphi)) * inflation; 
-
-    // We search for all candidate recHits, ie all recHits contained in the maximal size envelope.
-    std::vector<KDTreeNodeInfo> recHits;
-    KDTreeBox trackBox(tracketa - rangeeta, tracketa + rangeeta, 
-		       trackphi - rangephi, trackphi + rangephi);
-    tree_.search(trackBox, recHits);
-    
-    // Here we check all rechit candidates using the non-approximated method.
-    for(std::vector<KDTreeNodeInfo>::const_iterator rhit = recHits.begin(); 
-	rhit != recHits.end(); ++rhit) {
+  const reco::PFTrajectoryPoint& atHCAL =
+    trackref->extrapolatedPoint(reco::PFTrajectoryPoint::HCALEntrance);
+  const reco::PFTrajectoryPoint& atHCALExit =
+    trackref->extrapolatedPoint(reco::PFTrajectoryPoint::HCALExit);
 
-      const auto &rhrep		   = rhit->ptr->positionREP();
-      const auto & corners = rhit->ptr->getCornersREP();
-      
-      double rhsizeeta = fabs(corners[3].eta() - corners[1].eta());
-      double rhsizephi = fabs(corners[3].phi() - corners[1].phi());
-      if ( rhsizephi > M_PI ) rhsizephi = 2.*M_PI - rhsizephi;
-      
-      double deta = fabs(rhrep.eta() - tracketa);
-      double dphi = fabs(rhrep.phi() - trackphi);
-      if ( dphi > M_PI ) dphi = 2.*M_PI - dphi;
-      
-      // Find all clusters associated to given rechit
-      RecHit2BlockEltMap::iterator ret = rechit2ClusterLinks_.find(rhit->ptr);
-      
-      for(BlockEltSet::iterator clusterIt = ret->second.begin(); 
-	  clusterIt != ret->second.end(); clusterIt++) {
-	
-	const reco::PFClusterRef clusterref = (*clusterIt)->clusterRef();
-	int fracsNbr = clusterref->recHitFractions().size();
-	
-	double _rhsizeeta = rhsizeeta * (1.5 + 0.5 / fracsNbr) + 0.2 * fabs(dHeta);
-	double _rhsizephi = rhsizephi * (1.5 + 0.5 / fracsNbr) + 0.2 * fabs(dHphi);
-	
-	// Check if the track and the cluster are linked
-	if(deta < (_rhsizeeta / 2.) && dphi < (_rhsizephi / 2.))
-	  cluster2TargetLinks_[*clusterIt].insert(*it);
-      }
+  // The track didn't reach hcal
+  if( ! atHCAL.isValid()) return;
+
+  double dHeta = atHCALExit.positionREP().eta() - atHCAL.positionREP().eta();
+  double dHphi = atHCALExit.positionREP().phi() - atHCAL.positionREP().phi();
+  if ( dHphi > M_PI ) dHphi = dHphi - 2. * M_PI;
+  else if ( dHphi < -M_PI ) dHphi = dHphi + 2. * M_PI;
+
+  double tracketa = atHCAL.positionREP().eta() + 0.1 * dHeta;
+  double trackphi = atHCAL.positionREP().phi() + 0.1 * dHphi;
+
+  if (trackphi > M_PI) trackphi -= 2 * M_PI;
+  else if (trackphi < -M_PI) trackphi += 2 * M_PI;
+
+  // Estimate the maximal envelope in phi/eta that will be used to find rechit candidates.
+  // Same envelope for cap et barrel rechits.
+  double inflation = 1.;
+  double rangeeta = (getCristalPhiEtaMaxSize() * (1.5 + 0.5) + 0.2 * fabs(dHeta)) * inflation;
+  double rangephi = (getCristalPhiEtaMaxSize() * (1.5 + 0.5) + 0.2 * fabs(dHphi)) * inflation;
+
+  // We search for all candidate recHits, ie all recHits contained in the maximal size envelope.
+  std::vector<KDTreeNodeInfo> recHits;
+  KDTreeBox trackBox(tracketa - rangeeta, tracketa + rangeeta,
+		     trackphi - rangephi, trackphi + rangephi);
+  tree_.search(trackBox, recHits);
+
+  // Here we check all rechit candidates using the non-approximated method.
+  for(std::vector<KDTreeNodeInfo>::const_iterator rhit = recHits.begin();
+      rhit != recHits.end(); ++rhit) {
+
+    const auto &rhrep		   = rhit->ptr->positionREP();
+    const auto & corners = rhit->ptr->getCornersREP();
+
+    double rhsizeeta = fabs(corners[3].eta() - corners[1].eta());
+    double rhsizephi = fabs(corners[3].phi() - corners[1].phi());
+    if ( rhsizephi > M_PI ) rhsizephi = 2.*M_PI - rhsizephi;
+
+    double deta = fabs(rhrep.eta() - tracketa);
+    double dphi = fabs(rhrep.phi() - trackphi);
+    if ( dphi > M_PI ) dphi = 2.*M_PI - dphi;
+
+    // Find all clusters associated to given rechit
+    RecHit2BlockEltMap::const_iterator ret = rechit2ClusterLinks_.find(rhit->ptr);
+
+    for(BlockEltSet::const_iterator clusterIt = ret->second.begin();
+	clusterIt != ret->second.end(); clusterIt++) {
+
+      const reco::PFClusterRef clusterref = (*clusterIt)->clusterRef();
+      int fracsNbr = clusterref->recHitFractions().size();
+
+      double _rhsizeeta = rhsizeeta * (1.5 + 0.5 / fracsNbr) + 0.2 * fabs(dHeta);
+      double _rhsizephi = rhsizephi * (1.5 + 0.5 / fracsNbr) + 0.2 * fabs(dHphi);
+
+      // Check if the track and the cluster are linked
+      if(deta < (_rhsizeeta / 2.) && dphi < (_rhsizephi / 2.))
+	linkedClusters.insert(*clusterIt);
     }
   }
 }
@@ -40,6 +40,10 @@ class KDTreeLinkerTrackHcal : public KDTreeLinkerBase
   void clear() override;
  
  private:
+  // Search the clusters linked to one track. It only reads the KDTree and the
+  // rechit/cluster map, so it is called concurrently for all the tracks.
+  void searchLinks(reco::PFBlockElement *track, BlockEltSet &linkedClusters) const;
+
   // Data used by the KDTree algorithm : sets of Tracks and HCAL clusters.
   BlockEltSet		targetSet_;
   BlockEltSet		fieldClusterSet_;
@@ -144,7 +144,7 @@ KDTreeLinkerAlgo::swap(KDTreeNodeInfo	&e1,
 
 void
 KDTreeLinkerAlgo::search(const KDTreeBox		&trackBox,
-			 std::vector<KDTreeNodeInfo>	&recHits)
+			 std::vector<KDTreeNodeInfo>	&recHits) const
 {
   if (root_)
     recSearch(root_, trackBox, recHits);
@@ -153,7 +153,7 @@ KDTreeLinkerAlgo::search(const KDTreeBox		&trackBox,
 void 
 KDTreeLinkerAlgo::recSearch(const KDTreeNode		*current,
 			    const KDTreeBox		&trackBox,
-			    std::vector<KDTreeNodeInfo>	&recHits)
+			    std::vector<KDTreeNodeInfo>	&recHits) const
 {
   // By construction, current can't be null
   assert(current != nullptr);
@@ -207,7 +207,7 @@ KDTreeLinkerAlgo::recSearch(const KDTreeNode		*current,
 
 void
 KDTreeLinkerAlgo::addSubtree(const KDTreeNode		*current, 
-		   std::vector<KDTreeNodeInfo>	&recHits)
+		   std::vector<KDTreeNodeInfo>	&recHits) const
 {
   // By construction, current can't be null
   assert(current != nullptr);
@@ -500,6 +500,10 @@ void PFAlgo::reconstructParticles( const reco::PFBlockCollection& blocks ) {
 
   // loop on blocks that are not single ecal, 
   // and not single hcal.
+  // The blocks are processed one after the other: processBlock appends to
+  // pfCandidates_ and edits the candidates it has just added by index, and
+  // the electron, photon and muon algorithms keep per-event state across
+  // blocks. Only the block building in PFBlockAlgo runs concurrently.
 
   unsigned nblcks = 0;
   for( IBR io = otherBlockRefs.begin(); io!=otherBlockRefs.end(); ++io) {
@@ -11,6 +11,8 @@
 #include <algorithm>
 #include "TMath.h"
 
+#include "tbb/parallel_for.h"
+
 using namespace std;
 using namespace reco;
 
@@ -198,36 +200,38 @@ void PFBlockAlgo::findBlocks() {
     blocksmap.emplace(key,i);
   }
 
-  PFBlockLink::Type linktype = PFBlockLink::NONE;
-  PFBlock::LinkTest linktest = PFBlock::LINKTEST_RECHIT;
-  for( auto key : keys ) {
-    blocks_->push_back( reco::PFBlock() );
-    auto range = blocksmap.equal_range(key);
-    auto& the_block = blocks_->back();
-    ElementList::value_type::pointer p1(bare_elements_[range.first->second]);
-    the_block.addElement(p1);
-    const unsigned block_size = blocksmap.count(key) + 1;
-    //reserve up to 1M or 8MB; pay rehash cost for more
-    std::unordered_map<std::pair<unsigned int,unsigned int>, PFBlockLink > links(min(1000000u,block_size*block_size));
-    auto itr = range.first;
-    ++itr;
-    for( ; itr != range.second; ++itr ) {
-      ElementList::value_type::pointer p2(bare_elements_[itr->second]);
-      const PFBlockElement::Type type1 = p1->type();
-      const PFBlockElement::Type type2 = p2->type();        
-      the_block.addElement(p2);
-      linktest = PFBlock::LINKTEST_RECHIT; //rechit by default 
-      linktype = static_cast<PFBlockLink::Type>(1<<(type1-1)|1<<(type2-1));
-      const unsigned index = linkTestSquare_[type1][type2];
-      if( nullptr != linkTests_[index] ) {
-        const double dist = linkTests_[index]->testLink(p1,p2);
-        links.emplace( std::make_pair(p1->index(), p2->index()) ,
-                       PFBlockLink( linktype, linktest, dist,
-                                    p1->index(), p2->index() ) );
+  // the blocks are independent and the link tests are const: fill the
+  // blocks concurrently, each task builds the links of its block, packs
+  // them and frees them, so that only the links of the blocks being built
+  // are in memory at any time
+  blocks_->resize(keys.size());
+  tbb::parallel_for(size_t(0), keys.size(), [&](size_t ib) {
+      auto range = blocksmap.equal_range(keys[ib]);
+      auto& the_block = (*blocks_)[ib];
+      ElementList::value_type::pointer p1(bare_elements_[range.first->second]);
+      the_block.addElement(p1);
+      const unsigned block_size = blocksmap.count(keys[ib]) + 1;
+      //reserve up to 1M or 8MB; pay rehash cost for more
+      std::unordered_map<std::pair<unsigned int,unsigned int>, PFBlockLink> links(min(1000000u,block_size*block_size));
+      auto itr = range.first;
+      ++itr;
+      for( ; itr != range.second; ++itr ) {
+        ElementList::value_type::pointer p2(bare_elements_[itr->second]);
+        const PFBlockElement::Type type1 = p1->type();
+        const PFBlockElement::Type type2 = p2->type();        
+        the_block.addElement(p2);
+        const PFBlock::LinkTest linktest = PFBlock::LINKTEST_RECHIT; //rechit by default 
+        const PFBlockLink::Type linktype = static_cast<PFBlockLink::Type>(1<<(type1-1)|1<<(type2-1));
+        const unsigned index = linkTestSquare_[type1][type2];
+        if( nullptr != linkTests_[index] ) {
+          const double dist = linkTests_[index]->testLink(p1,p2);
+          links.emplace( std::make_pair(p1->index(), p2->index()) ,
+                         PFBlockLink( linktype, linktest, dist,
+                                      p1->index(), p2->index() ) );
+        }
       }
-    }
-    packLinks( the_block, links );    
-  }
+      packLinks( the_block, links );
+    });
   
   bare_elements_.clear();
   elements_.clear();
@@ -177,6 +177,15 @@ public:
 	   const int verbosity = 0) const ;
   
   track_t	fill(const std::vector<reco::TransientTrack> & tracks) const;
+
+  // full annealing of tks into the prototypes y, returns the final beta and rho0
+  void anneal(track_t & tks, vertex_t & y, double & beta, double & rho0) const;
+
+  // anneal z-ordered blocks of tracks concurrently and combine their prototypes
+  vertex_t anneal_in_blocks(track_t & tks, double & beta, double & rho0) const;
+
+  std::vector<TransientVertex>
+  fill_vertices(double beta, double rho0, track_t & tks, vertex_t & y) const;
   
   double update(double beta, track_t & gtracks,
 		vertex_t & gvertices, bool useRho0, const double & rho0) const;
@@ -211,6 +220,10 @@ private:
   double zmerge_;
   double betapurge_;
 
+  bool runInBlocks_;
+  unsigned int block_size_;
+  double overlap_frac_;
+
 };
 
 
@@ -10,6 +10,8 @@
 #include "FWCore/Utilities/interface/isFinite.h"
 #include "vdt/vdtMath.h"
 
+#include "tbb/parallel_for.h"
+
 using namespace std;
 
 DAClusterizerInZ_vect::DAClusterizerInZ_vect(const edm::ParameterSet& conf) {
@@ -39,6 +41,10 @@ DAClusterizerInZ_vect::DAClusterizerInZ_vect(const edm::ParameterSet& conf) {
   dzCutOff_ = conf.getParameter<double> ("dzCutOff");
   uniquetrkweight_ = conf.getParameter<double>("uniquetrkweight");
   zmerge_ = conf.getParameter<double>("zmerge");
+  // optional, annealing of track blocks is off unless configured
+  runInBlocks_ = conf.exists("runInBlocks") ? conf.getParameter<bool>("runInBlocks") : false;
+  block_size_ = conf.exists("block_size") ? conf.getParameter<unsigned int>("block_size") : 512;
+  overlap_frac_ = conf.exists("overlap_frac") ? conf.getParameter<double>("overlap_frac") : 0.5;
 
   if(verbose_){
     std::cout << "DAClusterizerinZ_vect: mintrkweight = " << mintrkweight_ << std::endl;
@@ -51,6 +57,9 @@ DAClusterizerInZ_vect::DAClusterizerInZ_vect(const edm::ParameterSet& conf) {
     std::cout << "DAClusterizerinZ_vect: coolingFactor = " << coolingFactor_ << std::endl;
     std::cout << "DAClusterizerinZ_vect: d0CutOff = " << d0CutOff_ << std::endl;
     std::cout << "DAClusterizerinZ_vect: dzCutOff = " << dzCutOff_ << std::endl;
+    std::cout << "DAClusterizerinZ_vect: runInBlocks = " << runInBlocks_ << std::endl;
+    std::cout << "DAClusterizerinZ_vect: block_size = " << block_size_ << std::endl;
+    std::cout << "DAClusterizerinZ_vect: overlap_frac = " << overlap_frac_ << std::endl;
   }
 
 
@@ -76,6 +85,12 @@ DAClusterizerInZ_vect::DAClusterizerInZ_vect(const edm::ParameterSet& conf) {
     Tstop = max(1., Tpurge) ;
   }
   betastop_ = 1./Tstop;
+
+  if ((block_size_ < 2) || (overlap_frac_ < 0) || (overlap_frac_ >= 1)) {
+    edm::LogWarning("DAClusterizerinZ_vectorized") << "DAClusterizerInZ: invalid block_size " << block_size_
+						   << " or overlap_frac " << overlap_frac_ << ", running without blocks";
+    runInBlocks_ = false;
+  }
   
 }
 
@@ -568,19 +583,12 @@ void DAClusterizerInZ_vect::splitAll( vertex_t & y) const {
 
 
 
-vector<TransientVertex> 
-DAClusterizerInZ_vect::vertices(const vector<reco::TransientTrack> & tracks, const int verbosity) const {
-  track_t && tks = fill(tracks);
-  tks.ExtractRaw();
-  
-  unsigned int nt = tks.GetSize();
-  double rho0 = 0.0; // start with no outlier rejection
-  
-  vector<TransientVertex> clusters;
-  if (tks.GetSize() == 0) return clusters;
-  
-  vertex_t y; // the vertex prototypes
-  
+void
+DAClusterizerInZ_vect::anneal(track_t & tks, vertex_t & y, double & beta, double & rho0) const {
+
+  const unsigned int nt = tks.GetSize();
+  rho0 = 0.0; // start with no outlier rejection
+
   // initialize:single vertex at infinite temperature
   y.AddItem( 0, 1.0);
   
@@ -588,7 +596,7 @@ DAClusterizerInZ_vect::vertices(const vector<reco::TransientTrack> & tracks, con
   
   
   // estimate first critical temperature
-  double beta = beta0(betamax_, tks, y);
+  beta = beta0(betamax_, tks, y);
   if ( verbose_) std::cout << "Beta0 is " << beta << std::endl;
   
   niter = 0;
@@ -701,6 +709,15 @@ DAClusterizerInZ_vect::vertices(const vector<reco::TransientTrack> & tracks, con
     std::cout  << "Final result, rho0=" << std::scientific << rho0 << endl;
     dump(beta, y, tks, 2);
   }
+}
+
+
+
+vector<TransientVertex>
+DAClusterizerInZ_vect::fill_vertices(double beta, double rho0, track_t & tks, vertex_t & y) const {
+
+  const unsigned int nt = tks.GetSize();
+  vector<TransientVertex> clusters;
 
   // select significant tracks and use a TransientVertex as a container
   GlobalError dummyError(0.01, 0, 0.01, 0., 0., 0.01);
@@ -743,6 +760,104 @@ DAClusterizerInZ_vect::vertices(const vector<reco::TransientTrack> & tracks, con
 
 }
 
+DAClusterizerInZ_vect::vertex_t
+DAClusterizerInZ_vect::anneal_in_blocks(track_t & tks, double & beta, double & rho0) const {
+
+  // split the z-ordered tracks into blocks of block_size_ tracks, consecutive blocks share
+  // a fraction overlap_frac_ of their tracks, and anneal the blocks concurrently
+  const unsigned int nt = tks.GetSize();
+  vector<unsigned int> order(nt);
+  for (unsigned int i = 0; i < nt; i++) order[i] = i;
+  std::stable_sort(order.begin(), order.end(), [&tks](unsigned int a, unsigned int b){ return tks._z[a] < tks._z[b]; });
+
+  const unsigned int step = std::max(1u, (unsigned int) (block_size_ * (1. - overlap_frac_)));
+  vector<unsigned int> starts;
+  for (unsigned int first = 0; ; first += step) {
+    starts.push_back(first);
+    if (first + block_size_ >= nt) break;
+  }
+  const unsigned int nb = starts.size();
+
+  vector<vertex_t> yb(nb);
+  vector<double> betab(nb), rho0b(nb);
+  vector<unsigned int> ntb(nb);
+  tbb::parallel_for(0u, nb, [&](unsigned int b) {
+    track_t btks;
+    const unsigned int last = std::min(starts[b] + block_size_, nt);
+    for (unsigned int j = starts[b]; j < last; j++) {
+      unsigned int i = order[j];
+      btks.AddItem(tks.z[i], tks.dz2[i], tks.tt[i], tks.pi[i]);
+    }
+    btks.ExtractRaw();
+    ntb[b] = btks.GetSize();
+    anneal(btks, yb[b], betab[b], rho0b[b]);
+  });
+
+  // each block contributes the vertices of its core, i.e. up to the middle of the overlap with
+  // its neighbours, widened by zmerge_ so that a vertex sitting on a boundary is not lost;
+  // duplicates from the two sides are merged below. pk is renormalized to all tracks.
+  vector<std::pair<double, double> > prototypes;
+  for (unsigned int b = 0; b < nb; b++) {
+    const double zlow = (b == 0) ? -std::numeric_limits<double>::max() :
+      0.5 * (tks._z[order[starts[b]]] + tks._z[order[std::min(starts[b-1] + block_size_, nt) - 1]]) - zmerge_;
+    const double zhigh = (b + 1 == nb) ? std::numeric_limits<double>::max() :
+      0.5 * (tks._z[order[starts[b+1]]] + tks._z[order[std::min(starts[b] + block_size_, nt) - 1]]) + zmerge_;
+    const double scale = double(ntb[b]) / nt;
+    for (unsigned int k = 0; k < yb[b].GetSize(); k++) {
+      if ((yb[b]._z[k] >= zlow) && (yb[b]._z[k] < zhigh)) {
+        prototypes.emplace_back(yb[b]._z[k], yb[b]._pk[k] * scale);
+      }
+    }
+  }
+  std::stable_sort(prototypes.begin(), prototypes.end());
+
+  vertex_t y;
+  if (prototypes.empty()) {
+    anneal(tks, y, beta, rho0);
+    return y;
+  }
+  for (auto const & proto : prototypes) y.AddItem(proto.first, proto.second);
+
+  beta = *std::max_element(betab.begin(), betab.end());
+  rho0 = (dzCutOff_ > 0) ? 1. / nt : 0.;
+
+  // bring the combined prototypes into equilibrium with all tracks and remove duplicates
+  int niter = 0;
+  while ((update(beta, tks, y, true, rho0) > 1.e-8) && (niter++ < maxIterations_)) {}
+  while (merge(y, beta)) { update(beta, tks, y, true, rho0); }
+  niter = 0;
+  while ((update(beta, tks, y, true, rho0) > 1.e-8) && (niter++ < maxIterations_)) {}
+
+  if (verbose_) {
+    std::cout << "Final result after annealing " << nb << " blocks, rho0=" << std::scientific << rho0 << endl;
+    dump(beta, y, tks, 2);
+  }
+
+  return y;
+}
+
+
+
+vector<TransientVertex>
+DAClusterizerInZ_vect::vertices(const vector<reco::TransientTrack> & tracks, const int verbosity) const {
+  track_t && tks = fill(tracks);
+  tks.ExtractRaw();
+
+  if (tks.GetSize() == 0) return vector<TransientVertex>();
+
+  double beta = 0;
+  double rho0 = 0;
+  if (runInBlocks_ && (tks.GetSize() > block_size_)) {
+    vertex_t && y = anneal_in_blocks(tks, beta, rho0);
+    y.ExtractRaw();
+    return fill_vertices(beta, rho0, tks, y);
+  } else {
+    vertex_t y;
+    anneal(tks, y, beta, rho0);
+    return fill_vertices(beta, rho0, tks, y);
+  }
+}
+
 vector<vector<reco::TransientTrack> > DAClusterizerInZ_vect::clusterize(
 		const vector<reco::TransientTrack> & tracks) const {
   
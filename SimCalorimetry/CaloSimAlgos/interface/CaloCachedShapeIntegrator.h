@@ -18,6 +18,7 @@ class CaloCachedShapeIntegrator: public CaloVShape
       ~CaloCachedShapeIntegrator() override ;
 
       double operator () ( double startTime ) const override ;
+      void evaluate( double t0, double dt, unsigned int n, double* values ) const override ;
       double timeToRise()                     const override ;
 
    private:
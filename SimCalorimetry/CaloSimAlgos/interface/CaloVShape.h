@@ -18,6 +18,19 @@ class CaloVShape
   virtual double       operator () (double) const = 0 ;
   virtual double       timeToRise()         const = 0 ;
 
+  // values at the n times t0, t0+dt, t0+dt+dt, ... (accumulated as in the
+  // sample loops of the hit responses), tabulated shapes override it with
+  // a loop without virtual calls
+  virtual void evaluate( double t0, double dt, unsigned int n, double* values ) const
+  {
+    double time = t0;
+    for( unsigned int i = 0; i < n; ++i )
+    {
+      values[i] = (*this)(time);
+      time += dt;
+    }
+  }
+
  protected:
 
  private:
@@ -1,5 +1,7 @@
 #include "SimCalorimetry/CaloSimAlgos/interface/CaloCachedShapeIntegrator.h"
 
+#include <algorithm>
+
 const int NBINS = 281; // 256, plus 25 before 
 
 CaloCachedShapeIntegrator::CaloCachedShapeIntegrator( const CaloVShape* aShape ) :
@@ -35,4 +37,15 @@ CaloCachedShapeIntegrator::operator() ( double startTime ) const
   return (ibin<0 || ibin >= NBINS) ? 0. : v_[ibin];
 }
 
-
+void
+CaloCachedShapeIntegrator::evaluate( double t0, double dt, unsigned int n, double* values ) const
+{
+  double time = t0;
+  for(unsigned int i = 0; i < n; ++i)
+  {
+    // same bin as operator(), the clamp only keeps the conversion defined
+    int ibin = static_cast<int>(std::min(std::max(time+25.0, -1.0), double(NBINS)));
+    values[i] = (ibin<0 || ibin >= NBINS) ? 0. : v_[ibin];
+    time += dt;
+  }
+}
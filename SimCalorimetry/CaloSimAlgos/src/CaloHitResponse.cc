@@ -147,6 +147,13 @@ CaloSamples CaloHitResponse::makeAnalogSignal(const PCaloHit & hit, CLHEP::HepRa
       binTime += 1.0;
     }
   }
+  else if(result.size() <= CaloSamples::MAXSAMPLES) {
+    double pulse[CaloSamples::MAXSAMPLES];
+    shape->evaluate(binTime, BUNCHSPACE, result.size(), pulse);
+    for(int bin = 0; bin < result.size(); bin++) {
+      result[bin] += pulse[bin]* signal;
+    }
+  }
   else {
     for(int bin = 0; bin < result.size(); bin++) {
       result[bin] += (*shape)(binTime)* signal;
@@ -64,6 +64,16 @@ class EcalHitResponse
 
       virtual void add( const PCaloHit&  hit, CLHEP::HepRandomEngine* ) ;
 
+      // add the hits of one bunch crossing; with batch accumulation the
+      // amplitudes and times are computed hit by hit, in the same order and
+      // with the same random numbers, and the pulses are added afterwards
+      // crystal by crystal
+      void add( const std::vector<PCaloHit>& hits, CLHEP::HepRandomEngine* ) ;
+
+      // only for responses whose output does not depend on the order in
+      // which the cells are first hit (not ES, which digitizes in that order)
+      void setBatchAccumulation( bool batch ) ;
+
       virtual void add( const CaloSamples&  hit ) ;
 
       virtual void initializeHits() ;
@@ -106,6 +116,8 @@ class EcalHitResponse
 
       void blankOutUsedSamples() ;
 
+      void accumulateBatch() ;
+
       const CaloSimParameters* params( const DetId& detId ) const ;
 
       const CaloVShape* shape() const ;
@@ -141,6 +153,15 @@ class EcalHitResponse
       CalibCache                     m_laserCalibCache;
 
       VecInd m_index ;
+
+      // signals collected by putAnalogSignal for accumulateBatch
+      bool                 m_batchAccumulation ;
+      bool                 m_collectBatch ;
+      VecInd               m_batchCell ;
+      std::vector<double>  m_batchSignal ;
+      std::vector<double>  m_batchTZero ;
+      VecInd               m_batchOrder ;
+      std::vector<double>  m_batchPulse ;
 };
 
 #endif
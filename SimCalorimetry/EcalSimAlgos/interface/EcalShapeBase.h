@@ -21,6 +21,8 @@ class EcalShapeBase : public CaloVShape
 
       double operator() ( double aTime ) const override ;
 
+      void evaluate( double t0, double dt, unsigned int n, double* values ) const override ;
+
       double         timeOfThr()  const ;
       double         timeOfMax()  const ;
       double timeToRise() const override ;
@@ -33,7 +35,8 @@ class EcalShapeBase : public CaloVShape
 	     kNBinsPerNSec        = 10 , // granularity of internal array
 	     k1NSecBins           = kReadoutTimeInterval*kNBinsPerNSec ,
 	     k1NSecBinsTotal      = 2*k1NSecBins ,
-	     kNBinsStored         = k1NSecBinsTotal*kNBinsPerNSec
+	     kNBinsStored         = k1NSecBinsTotal*kNBinsPerNSec ,
+	     kMaxSamples          = 16   // times converted at once by evaluate()
       } ;
 
       static const double qNSecPerBin ;
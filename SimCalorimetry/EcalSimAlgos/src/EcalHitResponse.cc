@@ -15,6 +15,7 @@
 
 #include "CLHEP/Units/GlobalPhysicalConstants.h"
 #include "CLHEP/Units/GlobalSystemOfUnits.h" 
+#include <algorithm>
 #include <iostream>
 
 
@@ -32,7 +33,9 @@ EcalHitResponse::EcalHitResponse( const CaloVSimParameterMap* parameterMap ,
    m_maxBunch        (  10          ) ,
    m_phaseShift      ( 1            ) ,
    m_iTime           ( 0            ) ,
-   m_useLCcorrection ( false            )  
+   m_useLCcorrection ( false            ) ,
+   m_batchAccumulation ( false ) ,
+   m_collectBatch    ( false            )
 {
 }
 
@@ -141,6 +144,62 @@ EcalHitResponse::add( const PCaloHit& hit, CLHEP::HepRandomEngine* engine )
   }
 }
 
+void
+EcalHitResponse::setBatchAccumulation( bool batch )
+{
+   m_batchAccumulation = batch ;
+}
+
+void
+EcalHitResponse::add( const std::vector<PCaloHit>& hits, CLHEP::HepRandomEngine* engine )
+{
+   m_collectBatch = m_batchAccumulation ;
+   m_batchCell.clear() ;
+   m_batchSignal.clear() ;
+   m_batchTZero.clear() ;
+
+   for( std::vector<PCaloHit>::const_iterator it ( hits.begin() ) ; it != hits.end() ; ++it )
+   {
+      add( *it, engine ) ;
+   }
+
+   if( m_collectBatch )
+   {
+      m_collectBatch = false ;
+      accumulateBatch() ;
+   }
+}
+
+void
+EcalHitResponse::accumulateBatch()
+{
+   // crystal by crystal, keeping the order of the hits of each crystal so
+   // that the float sums are the same as when adding them one by one
+   const unsigned int nHits ( m_batchCell.size() ) ;
+   m_batchOrder.resize( nHits ) ;
+   for( unsigned int i ( 0 ) ; i != nHits ; ++i ) m_batchOrder[ i ] = i ;
+   std::stable_sort( m_batchOrder.begin(), m_batchOrder.end(),
+		     [this]( unsigned int a, unsigned int b ) { return m_batchCell[ a ] < m_batchCell[ b ] ; } ) ;
+
+   for( unsigned int k ( 0 ) ; k != nHits ; ++k )
+   {
+      const unsigned int ihit ( m_batchOrder[ k ] ) ;
+      const unsigned int di ( m_batchCell[ ihit ] ) ;
+      EcalSamples& result ( *vSamAll( di ) ) ;
+      if( result.zero() ) m_index.push_back( di ) ;
+
+      const unsigned int rsize ( result.size() ) ;
+      if( m_batchPulse.size() < rsize ) m_batchPulse.resize( rsize ) ;
+      shape()->evaluate( m_batchTZero[ ihit ], BUNCHSPACE, rsize, m_batchPulse.data() ) ;
+
+      const double signal ( m_batchSignal[ ihit ] ) ;
+      for( unsigned int bin ( 0 ) ; bin != rsize ; ++bin )
+      {
+	 result[ bin ] += m_batchPulse[ bin ]*signal ;
+      }
+   }
+}
+
 void 
 EcalHitResponse::add( const CaloSamples& hit ) 
 {
@@ -172,6 +231,7 @@ EcalHitResponse::withinBunchRange(int bunchCrossing) const
 void
 EcalHitResponse::initializeHits()
 {
+   m_collectBatch = false ;
    blankOutUsedSamples() ;
 }
 
@@ -220,6 +280,14 @@ EcalHitResponse::putAnalogSignal( const PCaloHit& hit, CLHEP::HepRandomEngine* e
 			  - jitter 
 			  - BUNCHSPACE*( parameters->binOfMaximum()
 					 - m_phaseShift             ) ) ;
+   if( m_collectBatch )
+   {
+      m_batchCell.push_back( CaloGenericDetId( detId ).denseIndex() ) ;
+      m_batchSignal.push_back( signal ) ;
+      m_batchTZero.push_back( tzero ) ;
+      return ;
+   }
+
    double binTime ( tzero ) ;
 
    EcalSamples& result ( *findSignal( detId ) ) ;
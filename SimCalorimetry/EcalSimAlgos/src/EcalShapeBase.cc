@@ -145,6 +145,37 @@ EcalShapeBase::operator() ( double aTime ) const
    return ( kNBinsStored == index ? 0 : m_shape[ index ] ) ;
 }
 
+void
+EcalShapeBase::evaluate( double t0, double dt, unsigned int n, double* values ) const
+{
+   // same table entries as operator(), without the calls: the times are
+   // accumulated first, then converted to indices and looked up in a loop
+   // without branches that the compiler can vectorize
+   double times[ kMaxSamples ] ;
+   for( unsigned int i0 ( 0 ) ; i0 < n ; i0 += kMaxSamples )
+   {
+      const unsigned int m ( std::min( n - i0, (unsigned int) kMaxSamples ) ) ;
+      for( unsigned int i ( 0 ) ; i != m ; ++i )
+      {
+	 times[ i ] = t0 ;
+	 t0 += dt ;
+      }
+      const int first ( m_firstIndexOverThreshold ) ;
+      const double* shape ( m_shape.data() ) ;
+      double* out ( values + i0 ) ;
+      for( unsigned int i ( 0 ) ; i != m ; ++i )
+      {
+	 // the clamp keeps the conversion defined, times before the first
+	 // bin over threshold or after the table give 0 as in timeIndex
+	 const double x ( std::min( std::max( times[ i ]*kNBinsPerNSec + 0.5, -1. ), (double) kNBinsStored ) ) ;
+	 const int offset ( (int) x ) ;
+	 const int index ( first + offset ) ;
+	 const bool good ( 0 <= offset && index < (int) kNBinsStored ) ;
+	 out[ i ] = good ? shape[ good ? index : 0 ] : 0. ;
+      }
+   }
+}
+
 double 
 EcalShapeBase::derivative( double aTime ) const
 {
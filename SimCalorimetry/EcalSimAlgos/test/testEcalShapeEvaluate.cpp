@@ -0,0 +1,53 @@
+// Checks that the batch evaluation of the tabulated pulse shapes used by
+// the batch hit accumulation gives exactly the values of operator()
+
+#include "SimCalorimetry/EcalSimAlgos/interface/APDShape.h"
+#include "SimCalorimetry/EcalSimAlgos/interface/EBShape.h"
+#include "SimCalorimetry/EcalSimAlgos/interface/EEShape.h"
+#include "SimCalorimetry/CaloSimAlgos/interface/CaloCachedShapeIntegrator.h"
+
+#include <iostream>
+#include <random>
+#include <vector>
+
+namespace {
+   unsigned int compare( const char* name, const CaloVShape& shape, double tmin, double tmax, double dt, unsigned int n )
+   {
+      std::mt19937 rng( 4357 ) ;
+      std::uniform_real_distribution<double> flat( tmin, tmax ) ;
+      std::vector<double> values( n ) ;
+      unsigned int mismatches ( 0 ) ;
+      for( unsigned int itry ( 0 ) ; itry != 100000 ; ++itry )
+      {
+	 // also exactly on the bin edges of the tables
+	 const double t0 ( itry%10 == 0 ? 0.1*int( 10*flat( rng ) ) : flat( rng ) ) ;
+	 shape.evaluate( t0, dt, n, values.data() ) ;
+	 double time ( t0 ) ;
+	 for( unsigned int i ( 0 ) ; i != n ; ++i )
+	 {
+	    if( values[i] != shape( time ) ) ++mismatches ;
+	    time += dt ;
+	 }
+      }
+      std::cout << name << ": " << mismatches << " mismatches" << std::endl ;
+      return mismatches ;
+   }
+}
+
+int main()
+{
+   const APDShape theAPDShape( 74.5, 40.5 ) ;
+   const EBShape theEBShape ;
+   const EEShape theEEShape ;
+   const CaloCachedShapeIntegrator theIntegrator( &theEBShape ) ;
+
+   unsigned int mismatches ( 0 ) ;
+   // ten samples 25 ns apart, starting from before the pulse to after the table
+   mismatches += compare( "EB", theEBShape, -300., 300., 25., 10 ) ;
+   mismatches += compare( "EE", theEEShape, -300., 300., 25., 10 ) ;
+   mismatches += compare( "APD", theAPDShape, -300., 300., 25., 10 ) ;
+   mismatches += compare( "EB 1 ns", theEBShape, -50., 50., 1., 250 ) ;
+   mismatches += compare( "integrated EB", theIntegrator, -300., 300., 25., 10 ) ;
+
+   return 0 == mismatches ? 0 : 1 ;
+}
@@ -188,6 +188,13 @@ EcalDigiProducer::EcalDigiProducer( const edm::ParameterSet& params,  edm::Consu
 
 //++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
 
+   // barrel and endcap pulses added crystal by crystal after each bunch
+   // crossing, with the same digis as hit by hit
+   const bool batchHits ( params.getUntrackedParameter<bool>("batchHitAccumulation", true) ) ;
+   if( nullptr != m_APDResponse ) m_APDResponse->setBatchAccumulation( batchHits ) ;
+   m_EBResponse->setBatchAccumulation( batchHits ) ;
+   m_EEResponse->setBatchAccumulation( batchHits ) ;
+
    // further phase for cosmics studies
    if( cosmicsPhase ) 
    {
@@ -102,7 +102,12 @@ g4SimHits = cms.EDProducer("OscarMTProducer",
                 )
             )
         ),
-        delta = cms.double(1.0)
+        delta = cms.double(1.0),
+        ## points of the per-thread cache of field values (1 = last point only)
+        FieldCacheSize = cms.untracked.uint32(1),
+        ## volumes with a uniform field, the CMS field at Point (in cm), e.g.
+        ## cms.PSet(Volume = cms.string('MUON'), Point = cms.vdouble(0.,0.,0.))
+        UniformFieldVolumes = cms.untracked.VPSet()
     ),
     Physics = cms.PSet(
         common_maximum_time,
@@ -56,10 +56,13 @@
 #include "G4TransportationManager.hh"
 
 #include <atomic>
+#include <fstream>
 #include <thread>
 #include <sstream>
 #include <vector>
 
+#include <unistd.h>
+
 // from https://hypernews.cern.ch/HyperNews/CMS/get/edmFramework/3302/2.html
 namespace {
   std::atomic<int> thread_counter{ 0 };
@@ -72,6 +75,15 @@ namespace {
 
   int getThreadIndex() { return s_thread_index; }
 
+  // resident and virtual memory of the process in MB, from /proc/self/statm
+  std::pair<double, double> processMemory() {
+    unsigned long vsize = 0, rss = 0;
+    std::ifstream statm("/proc/self/statm");
+    statm >> vsize >> rss;
+    const double pageMB = sysconf(_SC_PAGESIZE)/(1024.*1024.);
+    return std::make_pair(rss*pageMB, vsize*pageMB);
+  }
+
   void createWatchers(const edm::ParameterSet& iP,
                       SimActivityRegistry& iReg,
                       std::vector<std::shared_ptr<SimWatcher> >& oWatchers,
@@ -180,6 +192,7 @@ void RunManagerMTWorker::initializeThread(RunManagerMT& runManagerMaster, const
   initializeTLS();
 
   int thisID = getThreadIndex();
+  const std::pair<double, double> memoryBefore = processMemory();
 
   edm::LogInfo("SimG4CoreApplication")
     << "RunManagerMTWorker::initializeThread " << thisID;
@@ -291,8 +304,13 @@ void RunManagerMTWorker::initializeThread(RunManagerMT& runManagerMaster, const
   }
   initializeUserActions();
 
+  // memory used by the thread local geometry, physics tables, field and
+  // sensitive detectors; approximate when threads are initialized concurrently
+  const std::pair<double, double> memoryAfter = processMemory();
   edm::LogInfo("SimG4CoreApplication")
-    << "RunManagerMTWorker::initializeThread done for the thread " << thisID;
+    << "RunManagerMTWorker::initializeThread done for the thread " << thisID
+    << ", memory increase RSS " << memoryAfter.first - memoryBefore.first
+    << " MB, VSIZE " << memoryAfter.second - memoryBefore.second << " MB";
 
   for(const std::string& command: runManagerMaster.G4Commands()) {
     edm::LogInfo("SimG4CoreApplication") << "RunManagerMTWorker:: Requests UI: "
@@ -0,0 +1,19 @@
+#!/bin/sh
+# Events/s and memory of the simulation from 1 to 64 threads; the number of
+# events grows with the number of threads so that each thread simulates
+# about the same number of events after the initialization
+#   runG4ThreadScaling.sh [events per thread] [field cache size] [uniform field volume]
+
+EVENTS=${1:-50}
+CACHE=${2:-1}
+UNIFORM=${3:-}
+CFG=${CMSSW_BASE}/src/SimG4Core/Application/test/runG4ThreadScaling_cfg.py
+
+printf "%8s %12s %12s\n" threads "events/s" "VSIZE(MB)"
+for THREADS in 1 2 4 8 16 32 64; do
+  LOG=g4ThreadScaling_${THREADS}.log
+  cmsRun ${CFG} threads=${THREADS} events=$((EVENTS*THREADS)) fieldCacheSize=${CACHE} ${UNIFORM:+uniformFieldVolume=${UNIFORM}} > ${LOG} 2>&1 || { echo "failed with ${THREADS} threads, see ${LOG}"; exit 1; }
+  RATE=$(grep "Event Throughput" ${LOG} | awk '{print $3}')
+  VSIZE=$(grep "Peak virtual size" ${LOG} | awk '{print $5}')
+  printf "%8d %12s %12s\n" ${THREADS} "${RATE}" "${VSIZE}"
+done
@@ -0,0 +1,80 @@
+#
+# Simulation throughput of ttbar events with a given number of threads:
+#   cmsRun runG4ThreadScaling_cfg.py threads=8 events=400
+# with uniformFieldVolume=Tracker the tracker volume gets a uniform field, the
+# CMS field at uniformFieldPoint, and its value is printed by FieldBuilder
+# (SimG4CoreMagneticField category) when each worker is initialized;
+# the per-thread memory is printed by RunManagerMTWorker (SimG4CoreApplication
+# category), the events/s by the Timing service and the peak memory by the
+# SimpleMemoryCheck service at the end of the job;
+# runG4ThreadScaling.sh runs it from 1 to 64 threads
+
+import FWCore.ParameterSet.Config as cms
+from FWCore.ParameterSet.VarParsing import VarParsing
+from Configuration.StandardSequences.Eras import eras
+
+options = VarParsing('analysis')
+options.register('threads', 1, VarParsing.multiplicity.singleton, VarParsing.varType.int,
+                 "number of threads and streams")
+options.register('events', 200, VarParsing.multiplicity.singleton, VarParsing.varType.int,
+                 "number of events")
+options.register('fieldCacheSize', 1, VarParsing.multiplicity.singleton, VarParsing.varType.int,
+                 "number of points in the per-thread magnetic field cache")
+options.register('uniformFieldVolume', '', VarParsing.multiplicity.singleton, VarParsing.varType.string,
+                 "logical volume with a uniform magnetic field, e.g. Tracker")
+options.register('uniformFieldPoint', '0.,0.,0.', VarParsing.multiplicity.singleton, VarParsing.varType.string,
+                 "point (in cm) where the CMS field of the uniform field volume is taken")
+options.parseArguments()
+
+process = cms.Process("G4ThreadScaling",eras.Run2_2018)
+
+process.load("FWCore.MessageService.MessageLogger_cfi")
+process.load("Configuration.Geometry.GeometryExtended2018_cff")
+process.load("Configuration.StandardSequences.MagneticField_cff")
+process.load("Configuration.StandardSequences.Generator_cff")
+process.load("Configuration.StandardSequences.VtxSmearedNoSmear_cff")
+process.load("Configuration.StandardSequences.SimIdeal_cff")
+process.load("Configuration.Generator.TTbar_13TeV_TuneCUETP8M1_cfi")
+process.load("Configuration.StandardSequences.FrontierConditions_GlobalTag_cff")
+from Configuration.AlCa.autoCond import autoCond
+process.GlobalTag.globaltag = autoCond['run2_mc']
+
+process.load("IOMC.RandomEngine.IOMC_cff")
+
+process.MessageLogger.categories.append('SimG4CoreApplication')
+process.MessageLogger.cerr.INFO.limit = 0
+process.MessageLogger.cerr.SimG4CoreApplication = cms.untracked.PSet(limit = cms.untracked.int32(-1))
+process.MessageLogger.categories.append('SimG4CoreMagneticField')
+process.MessageLogger.cerr.SimG4CoreMagneticField = cms.untracked.PSet(limit = cms.untracked.int32(-1))
+process.MessageLogger.cerr.TimeReport = cms.untracked.PSet(limit = cms.untracked.int32(-1))
+process.MessageLogger.cerr.threshold = 'INFO'
+
+process.Timing = cms.Service("Timing",
+    summaryOnly = cms.untracked.bool(True)
+)
+
+process.SimpleMemoryCheck = cms.Service("SimpleMemoryCheck",
+    ignoreTotal = cms.untracked.int32(1)
+)
+
+process.source = cms.Source("EmptySource")
+process.maxEvents = cms.untracked.PSet(
+    input = cms.untracked.int32(options.events)
+)
+process.options = cms.untracked.PSet(
+    numberOfThreads = cms.untracked.uint32(options.threads),
+    numberOfStreams = cms.untracked.uint32(0)
+)
+
+process.g4SimHits.MagneticField.FieldCacheSize = cms.untracked.uint32(options.fieldCacheSize)
+if options.uniformFieldVolume:
+    process.g4SimHits.MagneticField.UniformFieldVolumes = cms.untracked.VPSet(
+        cms.PSet(
+            Volume = cms.string(options.uniformFieldVolume),
+            Point = cms.vdouble([float(x) for x in options.uniformFieldPoint.split(',')])
+        )
+    )
+
+process.generation_step = cms.Path(process.pgen)
+process.simulation_step = cms.Path(process.psim)
+process.schedule = cms.Schedule(process.generation_step, process.simulation_step)
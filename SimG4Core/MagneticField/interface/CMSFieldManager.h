@@ -10,8 +10,14 @@
 
 #include "G4FieldManager.hh"
 
+#include <memory>
+#include <vector>
+
 class G4Track;
 class G4ChordFinder;
+class G4MagneticField;
+class G4EquationOfMotion;
+class G4MagIntegratorStepper;
 namespace sim { class Field; }
 
 class CMSFieldManager : public G4FieldManager
@@ -30,6 +36,11 @@ public:
 
   void SetMonopoleTracking(G4bool);
 
+  // field manager of a volume with a local field, and the objects it uses,
+  // all owned by this worker
+  void AddLocalFieldManager(G4FieldManager*, G4ChordFinder*, G4MagIntegratorStepper*,
+                            G4EquationOfMotion*, G4MagneticField*);
+
 private:
 
   CMSFieldManager(const CMSFieldManager&) = delete;
@@ -37,6 +48,17 @@ private:
 
   std::unique_ptr<sim::Field> theField;
 
+  // members in the order of construction, so that the field manager is
+  // deleted first and the field last
+  struct LocalField {
+    std::unique_ptr<G4MagneticField> field;
+    std::unique_ptr<G4EquationOfMotion> equation;
+    std::unique_ptr<G4MagIntegratorStepper> stepper;
+    std::unique_ptr<G4ChordFinder> chordFinder;
+    std::unique_ptr<G4FieldManager> fieldManager;
+  };
+  std::vector<LocalField> localFields;
+
   G4ChordFinder* currChordFinder;
   G4ChordFinder* chordFinder;
   G4ChordFinder* chordFinderMonopole;
@@ -48,5 +70,9 @@ private:
   double dChordSimple;
   double dOneStepSimple;
   double dIntersectionSimple;
+
+  // the accuracy parameters are changed only when the mode changes
+  enum TrackingMode { kUndefined, kSimple, kFull };
+  TrackingMode currMode;
 };
 #endif
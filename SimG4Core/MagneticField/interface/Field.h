@@ -9,16 +9,25 @@ namespace sim {
    class Field : public G4MagneticField
    {
       public:
-	 Field(const MagneticField * f, double d);
+         // the field is taken from the last cacheSize points at which it was
+         // computed if the new point is closer than d in each coordinate;
+         // the integration steps of a track come back to the same points
+         // (stepper substeps, chord finder retries), so a few entries are
+         // enough to avoid most of the calls to the CMS field
+	 Field(const MagneticField * f, double d, unsigned int cacheSize = 1);
 	 ~Field() override;
 	 void GetFieldValue(const G4double p[4], G4double b[3]) const override;
 
+         static const unsigned int maxCacheSize = 8;
+
       private:
 	 const MagneticField* theCMSMagneticField;
          double theDelta;
+         unsigned int theCacheSize;
 
-         mutable double oldx[3];
-         mutable double oldb[3];
+         mutable double oldx[maxCacheSize][3];
+         mutable double oldb[maxCacheSize][3];
+         mutable unsigned int theNext;
    };
 };
 #endif
@@ -29,6 +29,10 @@ namespace sim {
 
   private:
 
+    // a uniform field replaces the CMS field in a volume given by name
+    void configureUniformVolume(const edm::ParameterSet& p,
+                                CMSFieldManager * fM, double minStep);
+
     Field* theField;
     G4Mag_UsualEqRhs *theFieldEquation;
     G4LogicalVolume  *theTopVolume;	 
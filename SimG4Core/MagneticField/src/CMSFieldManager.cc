@@ -3,14 +3,19 @@
 #include "SimG4Core/MagneticField/interface/Field.h"
 
 #include "G4ChordFinder.hh"
+#include "G4EquationOfMotion.hh"
+#include "G4MagIntegratorStepper.hh"
+#include "G4MagneticField.hh"
 #include "G4Track.hh"
 #include "CLHEP/Units/GlobalSystemOfUnits.h"
 
+#include <utility>
+
 CMSFieldManager::CMSFieldManager() 
   : G4FieldManager(), currChordFinder(nullptr), chordFinder(nullptr),
     chordFinderMonopole(nullptr), dChord(0.001), dOneStep(0.001),
     dIntersection(0.0001), energyThreshold(0.0), dChordSimple(0.1),
-    dOneStepSimple(0.1), dIntersectionSimple(0.01)
+    dOneStepSimple(0.1), dIntersectionSimple(0.01), currMode(kUndefined)
 {}
 
 CMSFieldManager::~CMSFieldManager()
@@ -66,19 +71,24 @@ void CMSFieldManager::InitialiseForVolume(const edm::ParameterSet& p, sim::Field
   SetMaximumEpsilonStep(maxEpsStep);
 
   SetMonopoleTracking(false);
+  currMode = kUndefined;
 }
 
 void CMSFieldManager::ConfigureForTrack(const G4Track* track)
 {
   // run time parameters per track
   if(track->GetKineticEnergy() <= energyThreshold && track->GetParentID() > 0) {
-    chordFinder->SetDeltaChord(dChordSimple);
-    SetDeltaOneStep(dOneStepSimple);
-    SetDeltaIntersection(dIntersectionSimple);
-  } else {
+    if(currMode != kSimple) {
+      chordFinder->SetDeltaChord(dChordSimple);
+      SetDeltaOneStep(dOneStepSimple);
+      SetDeltaIntersection(dIntersectionSimple);
+      currMode = kSimple;
+    }
+  } else if(currMode != kFull) {
     chordFinder->SetDeltaChord(dChord);
     SetDeltaOneStep(dOneStep);
     SetDeltaIntersection(dIntersection);
+    currMode = kFull;
   }
 } 
 
@@ -93,3 +103,17 @@ void CMSFieldManager::SetMonopoleTracking(G4bool flag)
   }
   SetChordFinder(currChordFinder);
 }
+
+void CMSFieldManager::AddLocalFieldManager(G4FieldManager* fm, G4ChordFinder* cf,
+                                           G4MagIntegratorStepper* stepper,
+                                           G4EquationOfMotion* equation,
+                                           G4MagneticField* field)
+{
+  LocalField local;
+  local.field.reset(field);
+  local.equation.reset(equation);
+  local.stepper.reset(stepper);
+  local.chordFinder.reset(cf);
+  local.fieldManager.reset(fm);
+  localFields.push_back(std::move(local));
+}
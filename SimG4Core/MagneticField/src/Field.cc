@@ -8,12 +8,16 @@
 
 using namespace sim;
 
-Field::Field(const MagneticField * f, double d) 
-  : G4MagneticField(), theCMSMagneticField(f), theDelta(d)
+Field::Field(const MagneticField * f, double d, unsigned int cacheSize) 
+  : G4MagneticField(), theCMSMagneticField(f), theDelta(d),
+    theCacheSize(cacheSize < 1 ? 1 : (cacheSize > maxCacheSize ? maxCacheSize : cacheSize)),
+    theNext(0)
 {
-  for(int i=0; i<3; ++i) {
-    oldx[i] = 1.0e12;
-    oldb[i] = 0.0;
+  for(unsigned int j=0; j<maxCacheSize; ++j) {
+    for(int i=0; i<3; ++i) {
+      oldx[j][i] = 1.0e12;
+      oldb[j][i] = 0.0;
+    }
   }
 }
 
@@ -21,25 +25,33 @@ Field::~Field() {}
 
 void Field::GetFieldValue(const G4double xyz[4], G4double bfield[3]) const 
 { 
-  if (std::abs(oldx[0]-xyz[0])>theDelta ||
-      std::abs(oldx[1]-xyz[1])>theDelta ||
-      std::abs(oldx[2]-xyz[2])>theDelta) 
+  unsigned int k = 0;
+  for(; k<theCacheSize; ++k) {
+    if (std::abs(oldx[k][0]-xyz[0])<=theDelta &&
+        std::abs(oldx[k][1]-xyz[1])<=theDelta &&
+        std::abs(oldx[k][2]-xyz[2])<=theDelta) { break; }
+  }
+
+  if (k == theCacheSize) 
     {
+      // replace the oldest entry
+      k = theNext;
+      theNext = (theNext+1 < theCacheSize) ? theNext+1 : 0;
+
       static const float lunit = (float)(1.0/CLHEP::cm);
       GlobalPoint ggg((float)(xyz[0])*lunit,(float)(xyz[1])*lunit,(float)(xyz[2])*lunit);
       GlobalVector v = theCMSMagneticField->inTesla(ggg);
       
       static const float btesla = (float)CLHEP::tesla;
-      oldb[0] = (G4double)(v.x()*btesla);
-      oldb[1] = (G4double)(v.y()*btesla);
-      oldb[2] = (G4double)(v.z()*btesla);
-      oldx[0] = xyz[0];
-      oldx[1] = xyz[1];
-      oldx[2] = xyz[2];
+      oldb[k][0] = (G4double)(v.x()*btesla);
+      oldb[k][1] = (G4double)(v.y()*btesla);
+      oldb[k][2] = (G4double)(v.z()*btesla);
+      oldx[k][0] = xyz[0];
+      oldx[k][1] = xyz[1];
+      oldx[k][2] = xyz[2];
     }
 
-  bfield[0] = oldb[0]; 
-  bfield[1] = oldb[1]; 
-  bfield[2] = oldb[2];
+  bfield[0] = oldb[k][0]; 
+  bfield[1] = oldb[k][1]; 
+  bfield[2] = oldb[k][2];
 }
-
@@ -3,6 +3,7 @@
 
 #include "FWCore/Framework/interface/ESHandle.h"
 #include "FWCore/MessageLogger/interface/MessageLogger.h"
+#include "FWCore/Utilities/interface/Exception.h"
 
 #include "SimG4Core/MagneticField/interface/FieldBuilder.h"
 #include "SimG4Core/MagneticField/interface/CMSFieldManager.h"
@@ -12,6 +13,7 @@
 
 #include "G4Mag_UsualEqRhs.hh"
 #include "G4ClassicalRK4.hh"
+#include "G4HelixExplicitEuler.hh"
 #include "G4PropagatorInField.hh"
 #include "G4FieldManager.hh"
 #include "G4TransportationManager.hh"
@@ -26,7 +28,7 @@ FieldBuilder::FieldBuilder(const MagneticField * f, const edm::ParameterSet & p)
   : theTopVolume(nullptr),thePSet(p) 
 {
   delta = p.getParameter<double>("delta")*CLHEP::mm;
-  theField = new Field(f, delta);
+  theField = new Field(f, delta, p.getUntrackedParameter<unsigned int>("FieldCacheSize",1));
   theFieldEquation = new G4Mag_UsualEqRhs(theField);
 }
 
@@ -47,6 +49,66 @@ void FieldBuilder::build( CMSFieldManager* fM, G4PropagatorInField* fP)
 
   edm::LogInfo("SimG4CoreMagneticField") 
     << " FieldBuilder::build: Global magnetic field is used";
+
+  std::vector<edm::ParameterSet> uniformPSets =
+    thePSet.getUntrackedParameter<std::vector<edm::ParameterSet> >("UniformFieldVolumes",
+                                                                     std::vector<edm::ParameterSet>());
+  double minStep = volPSet.getParameter<edm::ParameterSet>("StepperParam").getParameter<double>("MinStep");
+  for (auto const& uniformPSet : uniformPSets) {
+    configureUniformVolume(uniformPSet, fM, minStep);
+  }
+}
+
+void FieldBuilder::configureUniformVolume(const edm::ParameterSet& p,
+                                          CMSFieldManager* fM, double minStep)
+{
+  std::string volName = p.getParameter<std::string>("Volume");
+  std::vector<double> point = p.getParameter<std::vector<double> >("Point");
+  if(point.size() != 3) {
+    throw cms::Exception("Configuration")
+      << "FieldBuilder: Point of the uniform field volume " << volName
+      << " has " << point.size() << " coordinates instead of 3";
+  }
+
+  G4LogicalVolume* volume = nullptr;
+  G4LogicalVolumeStore* theStore = G4LogicalVolumeStore::GetInstance();
+  for (auto vol : *theStore) {
+    if ( (std::string)vol->GetName() == volName ) {
+      volume = vol;
+      break;
+    }
+  }
+  if(!volume) {
+    throw cms::Exception("Configuration")
+      << "FieldBuilder: uniform field volume " << volName << " is not in the geometry";
+  }
+
+  // the field in the volume is the CMS field at the reference point (in cm)
+  const G4double xyz[4] = {point[0]*CLHEP::cm, point[1]*CLHEP::cm, point[2]*CLHEP::cm, 0.};
+  G4double b[3];
+  theField->GetFieldValue(xyz, b);
+
+  // a helix is exact in a uniform field
+  G4UniformMagField* field = new G4UniformMagField(G4ThreeVector(b[0], b[1], b[2]));
+  G4Mag_UsualEqRhs* equation = new G4Mag_UsualEqRhs(field);
+  G4HelixExplicitEuler* stepper = new G4HelixExplicitEuler(equation);
+  G4ChordFinder* cf = new G4ChordFinder(field, minStep, stepper);
+  G4FieldManager* fm = new G4FieldManager(field, cf);
+  cf->SetDeltaChord(fM->GetChordFinder()->GetDeltaChord());
+  fm->SetDeltaOneStep(fM->GetDeltaOneStep());
+  fm->SetDeltaIntersection(fM->GetDeltaIntersection());
+  fm->SetMinimumEpsilonStep(fM->GetMinimumEpsilonStep());
+  fm->SetMaximumEpsilonStep(fM->GetMaximumEpsilonStep());
+
+  // the field manager of a logical volume is thread local; it is deleted with
+  // its field, equation, stepper and chord finder by the CMSFieldManager of
+  // this worker, none of them is deleted by Geant4
+  volume->SetFieldManager(fm, true);
+  fM->AddLocalFieldManager(fm, cf, stepper, equation, field);
+
+  edm::LogInfo("SimG4CoreMagneticField") 
+    << " FieldBuilder: uniform field (" << b[0]/CLHEP::tesla << ", " << b[1]/CLHEP::tesla
+    << ", " << b[2]/CLHEP::tesla << ") T in the volume " << volName;
 }
 
 void FieldBuilder::configureForVolume( const std::string& volName,
@@ -348,6 +348,10 @@ namespace edm {
     }
   }
 
+  void MixingModule::acquire(edm::Event const& e, edm::EventSetup const& setup, edm::WaitingTaskWithArenaHolder holder) {
+    prefetchPileUp(e, std::move(holder));
+  }
+
   void MixingModule::doPileUp(edm::Event &e, const edm::EventSetup& setup) {
     using namespace std::placeholders;
 
@@ -377,11 +381,16 @@ namespace edm {
 
     std::vector<int> PileupList;
     PileupList.clear();
-    TrueNumInteractions_.clear();
+    if(pileupPrefetched_) {
+      // drawn in acquire, for the sources read concurrently
+      PileupList.swap(prefetchedPileupList_);
+    } else {
+      TrueNumInteractions_.clear();
+    }
 
     std::shared_ptr<PileUp> source0 = inputSources_[0];
 
-    if((source0 && source0->doPileUp(0) ) && !playback_) {
+    if(!pileupPrefetched_ && (source0 && source0->doPileUp(0) ) && !playback_) {
       //    if((!inputSources_[0] || !inputSources_[0]->doPileUp()) && !playback_ )
 
       // Pre-calculate all pileup distributions before we go fishing for events
@@ -486,9 +495,15 @@ namespace edm {
            // non-minbias pileup only gets one event for now. Fix later if desired.
           int numberOfEvents = (readSrcIdx == 0 ? PileupList[bunchIdx - minBunch_] : 1);
           sizes.push_back(numberOfEvents);
-          inputSources_[readSrcIdx]->readPileUp(e.id(), recordEventID,
-                                                std::bind(&MixingModule::pileAllWorkers, std::ref(*this), _1, mcc, bunchIdx,
-                                                            _2, vertexOffset, std::ref(setup), e.streamID()), numberOfEvents, e.streamID());
+          if (source->concurrentReading()) {
+            source->readPrefetchedPileUp(e.id(), bunchIdx, recordEventID,
+                                         std::bind(&MixingModule::pileAllWorkers, std::ref(*this), _1, mcc, bunchIdx,
+                                                   _2, vertexOffset, std::ref(setup), e.streamID()), numberOfEvents, e.streamID());
+          } else {
+            inputSources_[readSrcIdx]->readPileUp(e.id(), recordEventID,
+                                                  std::bind(&MixingModule::pileAllWorkers, std::ref(*this), _1, mcc, bunchIdx,
+                                                              _2, vertexOffset, std::ref(setup), e.streamID()), numberOfEvents, e.streamID());
+          }
         } else if(oldFormatPlayback) {
           std::vector<edm::EventID> const& playEventID = oldFormatPlaybackInfo_H->getStartEventId(readSrcIdx, bunchIdx);
           size_t numberOfEvents = playEventID.size();
@@ -66,6 +66,8 @@ namespace edm {
 
       void endLuminosityBlock(LuminosityBlock const& l1, EventSetup const& c) override;
 
+      void acquire(Event const& event, EventSetup const& setup, WaitingTaskWithArenaHolder holder) override;
+
       void initializeEvent(Event const& event, EventSetup const& setup) override;
 
       void accumulateEvent(Event const& event, EventSetup const& setup);
@@ -2,6 +2,9 @@
 #include "FWCore/PluginManager/interface/PluginManager.h"
 
 #include "FWCore/Framework/interface/MakerMacros.h"
+#include "FWCore/ServiceRegistry/interface/ServiceMaker.h"
+
+#include "Mixing/Base/interface/PileUpEventCache.h"
 
 #include "MixingModule.h"
 #include "TestMix.h"
@@ -17,6 +20,7 @@
   using edm::InputAnalyzer;
   using edm::SecSourceAnalyzer;
   using edm::TestMixedSource;
+  using edm::PileUpEventCache;
   
 
 DEFINE_FWK_MODULE(MixingModule);
@@ -26,3 +30,5 @@ DEFINE_FWK_MODULE(InputAnalyzer);
 DEFINE_FWK_MODULE(SecSourceAnalyzer);
 DEFINE_FWK_MODULE(TestMixedSource);
 DEFINE_FWK_MODULE(Mixing2DB);
+
+DEFINE_FWK_SERVICE(PileUpEventCache);
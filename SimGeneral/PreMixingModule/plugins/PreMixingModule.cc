@@ -37,6 +37,7 @@ namespace edm {
 
     ~PreMixingModule() override = default;
 
+    void acquire(edm::Event const& e, edm::EventSetup const& ES, edm::WaitingTaskWithArenaHolder holder) override;
     void checkSignal(const edm::Event &e) override {}; 
     void createnewEDProduct() override {}
     void addSignals(const edm::Event &e, const edm::EventSetup& ES) override; 
@@ -157,13 +158,22 @@ namespace edm {
     }
   }
   
+  void PreMixingModule::acquire(edm::Event const& e, edm::EventSetup const& ES, edm::WaitingTaskWithArenaHolder holder) {
+    prefetchPileUp(e, std::move(holder));
+  }
+
   void PreMixingModule::doPileUp(edm::Event &e, const edm::EventSetup& ES)
   {
     using namespace std::placeholders;
 
     std::vector<edm::SecondaryEventIDAndFileInfo> recordEventID;
     std::vector<int> PileupList;
-    TrueNumInteractions_.clear();
+    if (pileupPrefetched_) {
+      // drawn in acquire, for the sources read concurrently
+      PileupList.swap(prefetchedPileupList_);
+    } else {
+      TrueNumInteractions_.clear();
+    }
 
     ModuleCallingContext const* mcc = e.moduleCallingContext();
 
@@ -173,7 +183,7 @@ namespace edm {
         if (!source || !(source->doPileUp(bunchCrossing))) 
           continue;
 
-	if (isource==0) 
+	if (isource==0 && !pileupPrefetched_)
           source->CalculatePileup(minBunch_, maxBunch_, PileupList, TrueNumInteractions_, e.streamID());
 
 	int NumPU_Events = 0;
@@ -188,7 +198,18 @@ namespace edm {
           w->initializeBunchCrossing(e, ES, bunchCrossing);
         }
 
-        source->readPileUp(
+        if (source->concurrentReading()) {
+          source->readPrefetchedPileUp(
+                e.id(),
+                bunchCrossing,
+                recordEventID,
+                std::bind(&PreMixingModule::pileWorker, std::ref(*this),
+			  _1, bunchCrossing, _2, std::cref(ES), mcc),
+		NumPU_Events,
+                e.streamID()
+			   );
+        } else {
+          source->readPileUp(
                 e.id(),
                 recordEventID,
                 std::bind(&PreMixingModule::pileWorker, std::ref(*this),
@@ -196,6 +217,7 @@ namespace edm {
 		NumPU_Events,
                 e.streamID()
 			   );
+        }
 
         for(auto& w: workers_) {
           w->finalizeBunchCrossing(e, ES, bunchCrossing);
@@ -0,0 +1,84 @@
+import FWCore.ParameterSet.Config as cms
+import FWCore.ParameterSet.VarParsing as VarParsing
+
+# compare the DA_vect vertex clustering run over the full track list with the
+# version annealing z-ordered blocks of tracks concurrently (runInBlocks):
+# - vertex finding efficiency, fake rate and resolution from PrimaryVertexAnalyzer4PUSlimmed
+#   (DQM folders Vertexing/PrimaryVertexV/offlinePrimaryVertices{,Blocks})
+# - per-module timing from the FastTimerService
+# run on samples with different pileup to get the timing as a function of pileup, e.g.
+#   cmsRun compareDABlocks_cfg.py inputFiles=file:step3_PU200.root globalTag=auto:phase2_realistic numberOfThreads=8
+# the input must contain generalTracks, the beamspot and the mix MergedTrackTruth
+
+process = cms.Process("DABlocks")
+
+options = VarParsing.VarParsing('analysis')
+options.register ('globalTag',
+                  "auto:run2_mc",
+                  VarParsing.VarParsing.multiplicity.singleton,
+                  VarParsing.VarParsing.varType.string,
+                  "GlobalTag")
+options.register ('numberOfThreads',
+                  1,
+                  VarParsing.VarParsing.multiplicity.singleton,
+                  VarParsing.VarParsing.varType.int,
+                  "number of threads")
+options.register ('blockSize',
+                  512,
+                  VarParsing.VarParsing.multiplicity.singleton,
+                  VarParsing.VarParsing.varType.int,
+                  "number of tracks per block")
+options.register ('overlapFraction',
+                  0.5,
+                  VarParsing.VarParsing.multiplicity.singleton,
+                  VarParsing.VarParsing.varType.float,
+                  "fraction of tracks shared by consecutive blocks")
+options.parseArguments()
+
+process.options = cms.untracked.PSet(
+    numberOfThreads = cms.untracked.uint32(options.numberOfThreads),
+    numberOfStreams = cms.untracked.uint32(0)
+)
+process.maxEvents = cms.untracked.PSet( input = cms.untracked.int32(options.maxEvents) )
+process.source = cms.Source("PoolSource",
+    fileNames = cms.untracked.vstring(options.inputFiles)
+)
+
+process.load("FWCore.MessageLogger.MessageLogger_cfi")
+process.MessageLogger.cerr.FwkReport.reportEvery = 100
+process.load("Configuration.StandardSequences.GeometryRecoDB_cff")
+process.load("Configuration.StandardSequences.MagneticField_cff")
+process.load("Configuration.StandardSequences.FrontierConditions_GlobalTag_cff")
+from Configuration.AlCa.GlobalTag import GlobalTag
+process.GlobalTag = GlobalTag(process.GlobalTag, options.globalTag, '')
+
+# vertex reconstruction, reference and block mode
+from RecoVertex.PrimaryVertexProducer.OfflinePrimaryVertices_cfi import offlinePrimaryVertices
+process.offlinePrimaryVertices = offlinePrimaryVertices.clone()
+process.offlinePrimaryVerticesBlocks = offlinePrimaryVertices.clone()
+process.offlinePrimaryVerticesBlocks.TkClusParameters.TkDAClusParameters.runInBlocks = True
+process.offlinePrimaryVerticesBlocks.TkClusParameters.TkDAClusParameters.block_size = options.blockSize
+process.offlinePrimaryVerticesBlocks.TkClusParameters.TkDAClusParameters.overlap_frac = options.overlapFraction
+
+# validation
+process.load("Validation.RecoTrack.TrackValidation_cff")
+process.load("Validation.RecoVertex.PrimaryVertexAnalyzer4PUSlimmed_cfi")
+process.vertexAnalysis.vertexRecoCollections = cms.VInputTag("offlinePrimaryVertices",
+                                                             "offlinePrimaryVerticesBlocks")
+
+process.load("DQMServices.Core.DQMStore_cfi")
+process.load("DQMServices.Components.DQMEnvironment_cfi")
+process.dqmSaver.workflow = "/DABlocks/PU/VALIDATION"
+
+# timing
+process.load("HLTrigger.Timer.FastTimerService_cfi")
+process.FastTimerService.printEventSummary = False
+process.FastTimerService.printRunSummary = False
+process.FastTimerService.printJobSummary = True
+process.FastTimerService.enableDQM = False
+
+process.p = cms.Path(process.offlinePrimaryVertices
+                     + process.offlinePrimaryVerticesBlocks
+                     + process.tracksValidationTruth
+                     + process.vertexAnalysis)
+process.e = cms.EndPath(process.dqmSaver)